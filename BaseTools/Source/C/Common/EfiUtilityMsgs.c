@@ -557,6 +557,24 @@ GetUtilityStatus (
   return mStatus;
 }
 
+/**
+  Reset the status, the message counts and the print level to the values
+  they have when the utility starts. This lets a utility that is linked into
+  a library run more than once in the same process.
+**/
+VOID
+ResetUtilityStatus (
+  VOID
+  )
+{
+  mStatus               = STATUS_SUCCESS;
+  mPrintLogLevel        = INFO_LOG_LEVEL;
+  mSourceFileName       = NULL;
+  mSourceFileLineNum    = 0;
+  mErrorCount           = 0;
+  mWarningCount         = 0;
+}
+
 /**
   Set the printing message Level. This is used by the PrintMsg() function
   to determine when/if a message should be printed.
@@ -0,0 +1,100 @@
+/** @file
+Runs GenSec and GenFfs in the process that loads the FvTools library.
+
+GenFv is not part of the library. It keeps state in globals that are only
+initialized when the process starts, and it only runs once per FV anyway.
+
+Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <stdio.h>
+#include <Common/UefiBaseTypes.h>
+#include "EfiUtilityMsgs.h"
+#include "FvTools.h"
+
+int
+GenSecMain (
+  int   argc,
+  char  *argv[]
+  );
+
+int
+GenFfsMain (
+  int   argc,
+  char  *argv[]
+  );
+
+typedef
+int
+(*FV_TOOLS_MAIN) (
+  int   argc,
+  char  *argv[]
+  );
+
+/**
+  Run the main function of a tool like the tool would run as a process.
+
+  @param Main  The main function of the tool.
+  @param Argc  Number of arguments, including the name of the tool.
+  @param Argv  The arguments.
+
+  @return The exit code of the tool.
+**/
+STATIC
+int
+RunTool (
+  FV_TOOLS_MAIN  Main,
+  int            Argc,
+  char           **Argv
+  )
+{
+  int  Status;
+
+  if ((Argc < 1) || (Argv == NULL)) {
+    return STATUS_ERROR;
+  }
+
+  //
+  // The tools report errors through the status of the messages module, which
+  // otherwise keeps the errors of the previous call.
+  //
+  ResetUtilityStatus ();
+  Status = Main (Argc, Argv);
+
+  //
+  // The caller reads what the tool printed from the same streams it reads
+  // the output of an external tool from.
+  //
+  fflush (stdout);
+  fflush (stderr);
+
+  return Status;
+}
+
+int
+FvToolsGetApiVersion (
+  void
+  )
+{
+  return FV_TOOLS_API_VERSION;
+}
+
+int
+FvToolsGenSec (
+  int   Argc,
+  char  **Argv
+  )
+{
+  return RunTool (GenSecMain, Argc, Argv);
+}
+
+int
+FvToolsGenFfs (
+  int   Argc,
+  char  **Argv
+  )
+{
+  return RunTool (GenFfsMain, Argc, Argv);
+}
@@ -0,0 +1,83 @@
+/** @file
+Public interface of the FvTools library.
+
+The library runs GenSec and GenFfs in the process that loads it, which saves
+starting one process per section and per FFS file. The functions take the
+same arguments as the tools and return what the tools would exit with, so a
+caller can switch between the library and the tools without other changes.
+
+The interface only uses C types, so that it can be called through ctypes.
+
+Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef _FV_TOOLS_H_
+#define _FV_TOOLS_H_
+
+//
+// Changes when a function is added or when one changes incompatibly.
+//
+#define FV_TOOLS_API_VERSION  1
+
+#if defined (_MSC_VER)
+#define FV_TOOLS_API  __declspec(dllexport)
+#else
+#define FV_TOOLS_API  __attribute__((visibility ("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+  Return the version of the interface, see FV_TOOLS_API_VERSION.
+
+  @return The version of the interface the library implements.
+**/
+FV_TOOLS_API
+int
+FvToolsGetApiVersion (
+  void
+  );
+
+/**
+  Run GenSec.
+
+  The calls are not thread safe, the caller must serialize them.
+
+  @param Argc  Number of arguments, including the name of the tool.
+  @param Argv  The arguments, as they would be passed to GenSec.
+
+  @return The exit code of GenSec.
+**/
+FV_TOOLS_API
+int
+FvToolsGenSec (
+  int   Argc,
+  char  **Argv
+  );
+
+/**
+  Run GenFfs.
+
+  The calls are not thread safe, the caller must serialize them.
+
+  @param Argc  Number of arguments, including the name of the tool.
+  @param Argv  The arguments, as they would be passed to GenFfs.
+
+  @return The exit code of GenFfs.
+**/
+FV_TOOLS_API
+int
+FvToolsGenFfs (
+  int   Argc,
+  char  **Argv
+  );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
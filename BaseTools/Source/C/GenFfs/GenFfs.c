@@ -448,6 +448,13 @@ Returns:
   }
 }
 
+#ifdef FV_TOOLS_LIBRARY
+//
+// The FvTools library calls the tool through FvToolsGenFfs().
+//
+#define main  GenFfsMain
+#endif
+
 int
 main (
   int   argc,
@@ -1123,6 +1123,13 @@ Returns:
   return EFI_SUCCESS;
 }
 
+#ifdef FV_TOOLS_LIBRARY
+//
+// The FvTools library calls the tool through FvToolsGenSec().
+//
+#define main  GenSecMain
+#endif
+
 int
 main (
   int  argc,
@@ -29,6 +29,16 @@
 
 #define LZMA_HEADER_SIZE (LZMA_PROPS_SIZE + 8)
 
+//
+// Chunked container, see MdeModulePkg/Include/Guid/LzmaDecompress.h:
+// 'LZMC' signature, decoded size, chunk size, chunk count, ChunkCount + 1
+// chunk offsets relative to the end of the offset table, then one standard
+// LZMA stream per chunk.
+//
+#define LZMA_CHUNKED_SIGNATURE      0x434D5A4C
+#define LZMA_CHUNKED_HEADER_SIZE    16
+#define LZMA_DEFAULT_CHUNK_SIZE     (1 << 20)
+
 typedef enum {
   NoConverter,
   X86Converter,
@@ -43,9 +53,11 @@ const char *kInvalidParamValMessage = "Invalid parameter value";
 
 static BoolInt mQuietMode = False;
 static CONVERTER_TYPE mConType = NoConverter;
+static BoolInt mChunked = False;
 
 UINT64 mDictionarySize = 28;
 UINT64 mCompressionMode = 2;
+UINT64 mChunkSize = LZMA_DEFAULT_CHUNK_SIZE;
 
 #define UTILITY_NAME "LzmaCompress"
 #define UTILITY_MAJOR_VERSION 0
@@ -62,6 +74,9 @@ void PrintHelp(char *buffer)
              "  -d: decode file\n"
              "  -o FileName, --output FileName: specify the output filename\n"
              "  --f86: enable converter for x86 code\n"
+             "  --chunked: split the data into independently compressed chunks\n"
+             "  --chunk-size Size: set the chunk size in bytes, implies --chunked,\n"
+             "                     default: 1048576 (1MB)\n"
              "  -v, --verbose: increase output messages\n"
              "  -q, --quiet: reduce output messages\n"
              "  --debug [0-9]: set debug level\n"
@@ -176,6 +191,210 @@ Done:
   return res;
 }
 
+static void WriteUInt32(Byte *buffer, UInt32 value)
+{
+  buffer[0] = (Byte)value;
+  buffer[1] = (Byte)(value >> 8);
+  buffer[2] = (Byte)(value >> 16);
+  buffer[3] = (Byte)(value >> 24);
+}
+
+static UInt32 ReadUInt32(const Byte *buffer)
+{
+  return (UInt32)buffer[0] | ((UInt32)buffer[1] << 8) |
+    ((UInt32)buffer[2] << 16) | ((UInt32)buffer[3] << 24);
+}
+
+static size_t ChunkOutputBound(size_t inSize)
+{
+  // we allocate 105% of original size + 64KB for each chunk like Encode does
+  return LZMA_HEADER_SIZE + inSize / 20 * 21 + (1 << 16);
+}
+
+static SRes EncodeChunked(ISeqOutStream *outStream, ISeqInStream *inStream, UInt64 fileSize, CLzmaEncProps *props)
+{
+  SRes res;
+  size_t inSize = (size_t)fileSize;
+  size_t chunkSize = (size_t)mChunkSize;
+  UInt32 chunkCount;
+  UInt32 index;
+  size_t tableSize;
+  size_t dataOffset;
+  Byte *inBuffer = 0;
+  Byte *outBuffer = 0;
+  size_t outSize;
+
+  if (inSize == 0)
+    return SZ_ERROR_INPUT_EOF;
+  if (fileSize > 0xFFFFFFFF)
+    return SZ_ERROR_UNSUPPORTED;
+
+  chunkCount = (UInt32)((inSize + chunkSize - 1) / chunkSize);
+  tableSize = LZMA_CHUNKED_HEADER_SIZE + ((size_t)chunkCount + 1) * sizeof(UInt32);
+
+  inBuffer = (Byte *)MyAlloc(inSize);
+  if (inBuffer == 0)
+    return SZ_ERROR_MEM;
+
+  if (SeqInStream_Read(inStream, inBuffer, inSize) != SZ_OK) {
+    res = SZ_ERROR_READ;
+    goto Done;
+  }
+
+  outSize = tableSize + (size_t)(chunkCount - 1) * ChunkOutputBound(chunkSize) +
+    ChunkOutputBound(inSize - (size_t)(chunkCount - 1) * chunkSize);
+  outBuffer = (Byte *)MyAlloc(outSize);
+  if (outBuffer == 0) {
+    res = SZ_ERROR_MEM;
+    goto Done;
+  }
+
+  WriteUInt32(outBuffer, LZMA_CHUNKED_SIGNATURE);
+  WriteUInt32(outBuffer + 4, (UInt32)inSize);
+  WriteUInt32(outBuffer + 8, (UInt32)chunkSize);
+  WriteUInt32(outBuffer + 12, chunkCount);
+
+  res = SZ_OK;
+  dataOffset = 0;
+  for (index = 0; index < chunkCount; index++) {
+    const Byte *chunk = inBuffer + (size_t)index * chunkSize;
+    size_t chunkLength = inSize - (size_t)index * chunkSize;
+    Byte *chunkOut = outBuffer + tableSize + dataOffset;
+    size_t outSizeProcessed;
+    size_t outPropsSize = LZMA_PROPS_SIZE;
+    CLzmaEncProps chunkProps;
+    int i;
+
+    if (chunkLength > chunkSize)
+      chunkLength = chunkSize;
+
+    WriteUInt32(outBuffer + LZMA_CHUNKED_HEADER_SIZE + index * sizeof(UInt32), (UInt32)dataOffset);
+
+    for (i = 0; i < 8; i++)
+      chunkOut[i + LZMA_PROPS_SIZE] = (Byte)((UInt64)chunkLength >> (8 * i));
+
+    //
+    // Let the encoder shrink the dictionary to the chunk, a larger one is
+    // never used because every chunk is decoded on its own.
+    //
+    chunkProps = *props;
+    chunkProps.reduceSize = chunkLength;
+
+    outSizeProcessed = outSize - tableSize - dataOffset - LZMA_HEADER_SIZE;
+    res = LzmaEncode(chunkOut + LZMA_HEADER_SIZE, &outSizeProcessed,
+        chunk, chunkLength, &chunkProps, chunkOut, &outPropsSize, 0,
+        NULL, &g_Alloc, &g_Alloc);
+    if (res != SZ_OK)
+      goto Done;
+
+    dataOffset += LZMA_HEADER_SIZE + outSizeProcessed;
+  }
+
+  WriteUInt32(outBuffer + LZMA_CHUNKED_HEADER_SIZE + chunkCount * sizeof(UInt32), (UInt32)dataOffset);
+
+  outSize = tableSize + dataOffset;
+  if (outStream->Write(outStream, outBuffer, outSize) != outSize)
+    res = SZ_ERROR_WRITE;
+
+Done:
+  MyFree(outBuffer);
+  MyFree(inBuffer);
+
+  return res;
+}
+
+static SRes DecodeChunked(ISeqOutStream *outStream, ISeqInStream *inStream, UInt64 fileSize)
+{
+  SRes res;
+  size_t inSize = (size_t)fileSize;
+  Byte *inBuffer = 0;
+  Byte *outBuffer = 0;
+  UInt32 decodedSize;
+  UInt32 chunkSize;
+  UInt32 chunkCount;
+  UInt32 index;
+  size_t tableSize;
+  const Byte *data;
+  size_t dataSize;
+
+  if (inSize < LZMA_CHUNKED_HEADER_SIZE + sizeof(UInt32))
+    return SZ_ERROR_INPUT_EOF;
+
+  inBuffer = (Byte *)MyAlloc(inSize);
+  if (inBuffer == 0)
+    return SZ_ERROR_MEM;
+
+  if (SeqInStream_Read(inStream, inBuffer, inSize) != SZ_OK) {
+    res = SZ_ERROR_READ;
+    goto Done;
+  }
+
+  res = SZ_ERROR_DATA;
+  decodedSize = ReadUInt32(inBuffer + 4);
+  chunkSize = ReadUInt32(inBuffer + 8);
+  chunkCount = ReadUInt32(inBuffer + 12);
+  if (ReadUInt32(inBuffer) != LZMA_CHUNKED_SIGNATURE || chunkSize == 0 ||
+      chunkCount != (UInt32)(((UInt64)decodedSize + chunkSize - 1) / chunkSize) ||
+      chunkCount > (inSize - LZMA_CHUNKED_HEADER_SIZE) / sizeof(UInt32) - 1)
+    goto Done;
+
+  tableSize = LZMA_CHUNKED_HEADER_SIZE + ((size_t)chunkCount + 1) * sizeof(UInt32);
+  data = inBuffer + tableSize;
+  dataSize = inSize - tableSize;
+
+  if (decodedSize != 0) {
+    outBuffer = (Byte *)MyAlloc(decodedSize);
+    if (outBuffer == 0) {
+      res = SZ_ERROR_MEM;
+      goto Done;
+    }
+  }
+
+  for (index = 0; index < chunkCount; index++) {
+    size_t start = ReadUInt32(inBuffer + LZMA_CHUNKED_HEADER_SIZE + index * sizeof(UInt32));
+    size_t end = ReadUInt32(inBuffer + LZMA_CHUNKED_HEADER_SIZE + (index + 1) * sizeof(UInt32));
+    size_t chunkLength = decodedSize - (size_t)index * chunkSize;
+    size_t outSize;
+    size_t inSizePure;
+    UInt64 outSize64 = 0;
+    ELzmaStatus status;
+    int i;
+
+    if (chunkLength > chunkSize)
+      chunkLength = chunkSize;
+
+    if (start > end || end > dataSize || end - start < LZMA_HEADER_SIZE) {
+      res = SZ_ERROR_DATA;
+      goto Done;
+    }
+
+    for (i = 0; i < 8; i++)
+      outSize64 += ((UInt64)data[start + LZMA_PROPS_SIZE + i]) << (i * 8);
+    if (outSize64 != chunkLength) {
+      res = SZ_ERROR_DATA;
+      goto Done;
+    }
+
+    outSize = chunkLength;
+    inSizePure = end - start - LZMA_HEADER_SIZE;
+    res = LzmaDecode(outBuffer + (size_t)index * chunkSize, &outSize,
+        data + start + LZMA_HEADER_SIZE, &inSizePure,
+        data + start, LZMA_PROPS_SIZE, LZMA_FINISH_END, &status, &g_Alloc);
+    if (res != SZ_OK)
+      goto Done;
+  }
+
+  res = SZ_OK;
+  if (decodedSize != 0 && outStream->Write(outStream, outBuffer, decodedSize) != decodedSize)
+    res = SZ_ERROR_WRITE;
+
+Done:
+  MyFree(outBuffer);
+  MyFree(inBuffer);
+
+  return res;
+}
+
 static SRes Decode(ISeqOutStream *outStream, ISeqInStream *inStream, UInt64 fileSize)
 {
   SRes res;
@@ -274,6 +493,17 @@ int main2(int numArgs, const char *args[], char *rs)
       modeWasSet = True;
     } else if (strcmp(args[param], "--f86") == 0) {
       mConType = X86Converter;
+    } else if (strcmp(args[param], "--chunked") == 0) {
+      mChunked = True;
+    } else if (strcmp(args[param], "--chunk-size") == 0) {
+      if (numArgs < (param + 2)) {
+        return PrintUserError(rs);
+      }
+      if ((AsciiStringToUint64(args[++param], FALSE, &mChunkSize) != EFI_SUCCESS) ||
+          (mChunkSize == 0) || (mChunkSize > 0x80000000)) {
+        return PrintError(rs, kInvalidParamValMessage);
+      }
+      mChunked = True;
     } else if (strcmp(args[param], "-o") == 0 ||
                strcmp(args[param], "--output") == 0) {
       if (numArgs < (param + 2)) {
@@ -344,6 +574,14 @@ int main2(int numArgs, const char *args[], char *rs)
     return PrintUserError(rs);
   }
 
+  //
+  // The x86 converter runs over the whole image, which does not fit a format
+  // whose chunks are decoded independently.
+  //
+  if (mChunked && (mConType != NoConverter)) {
+    return PrintUserError(rs);
+  }
+
   {
     size_t t4 = sizeof(UInt32);
     size_t t8 = sizeof(UInt64);
@@ -366,14 +604,22 @@ int main2(int numArgs, const char *args[], char *rs)
     if (!mQuietMode) {
       printf("Encoding\n");
     }
-    res = Encode(&outStream.vt, &inStream.vt, fileSize, &props);
+    if (mChunked) {
+      res = EncodeChunked(&outStream.vt, &inStream.vt, fileSize, &props);
+    } else {
+      res = Encode(&outStream.vt, &inStream.vt, fileSize, &props);
+    }
   }
   else
   {
     if (!mQuietMode) {
       printf("Decoding\n");
     }
-    res = Decode(&outStream.vt, &inStream.vt, fileSize);
+    if (mChunked) {
+      res = DecodeChunked(&outStream.vt, &inStream.vt, fileSize);
+    } else {
+      res = Decode(&outStream.vt, &inStream.vt, fileSize);
+    }
   }
 
   File_Close(&outStream.file);
@@ -899,6 +899,9 @@ class WorkspaceAutoGen(AutoGen):
             FdsCommandDict["quiet"] = True
 
         FdsCommandDict["GenfdsMultiThread"] = GlobalData.gEnableGenfdsMultiThread
+        FdsCommandDict["GenfdsJobs"] = GlobalData.gGenfdsJobs
+        FdsCommandDict["GenfdsCacheDir"] = GlobalData.gGenfdsCacheDir
+        FdsCommandDict["GenfdsInProcess"] = GlobalData.gGenfdsInProcess
         if GlobalData.gIgnoreSource:
             FdsCommandDict["IgnoreSources"] = True
 
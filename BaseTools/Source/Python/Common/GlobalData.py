@@ -79,6 +79,11 @@ gBuildDirectory = ''
 #
 gDatabasePath = ".cache/build.db"
 
+#
+# The directory of the parsed INF and DEC file cache, None when it is disabled
+#
+gMetaFileCacheDir = None
+
 #
 # Build flag for binary build
 #
@@ -119,6 +124,9 @@ gModuleAllCacheStatus = None
 gModuleCacheHit = None
 
 gEnableGenfdsMultiThread = True
+gGenfdsJobs = None
+gGenfdsCacheDir = None
+gGenfdsInProcess = False
 gSikpAutoGenCache = set()
 # Common lock for the file access in multiple process AutoGens
 file_lock = None
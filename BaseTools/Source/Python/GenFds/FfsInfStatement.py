@@ -46,6 +46,7 @@ from .DepexSection import DepexSection
 from Common.Misc import SaveFileOnChange
 from Common.Expression import *
 from Common.DataType import *
+from copy import deepcopy
 
 ## generate FFS from INF
 #
@@ -547,7 +548,9 @@ class FfsInfStatement(FfsInfStatementClassObject):
 
     ## __GetRule__() method
     #
-    #   Get correct rule for generating FFS for this INF
+    #   Get correct rule for generating FFS for this INF. The sections keep
+    #   per module state while they are generated, and several modules that share
+    #   a rule may be generated at the same time, so every module gets its own copy.
     #
     #   @param  self        The object pointer
     #   @retval Rule        Rule object
@@ -573,7 +576,7 @@ class FfsInfStatement(FfsInfStatementClassObject):
             Rule = GenFdsGlobalVariable.FdfParser.Profile.RuleDict.get(RuleName)
             if Rule is not None:
                 GenFdsGlobalVariable.VerboseLogger ("Want To Find Rule Name is : " + RuleName)
-                return Rule
+                return deepcopy(Rule)
 
         RuleName = 'RULE'      + \
                    '.'         + \
@@ -591,7 +594,7 @@ class FfsInfStatement(FfsInfStatementClassObject):
         Rule = GenFdsGlobalVariable.FdfParser.Profile.RuleDict.get(RuleName)
         if Rule is not None:
             GenFdsGlobalVariable.VerboseLogger ("Want To Find Rule Name is : " + RuleName)
-            return Rule
+            return deepcopy(Rule)
 
         if Rule is None :
             EdkLogger.error("GenFds", GENFDS_ERROR, 'Don\'t Find common rule %s for INF %s' \
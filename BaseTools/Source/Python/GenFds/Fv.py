@@ -12,6 +12,7 @@
 from __future__ import absolute_import
 import Common.LongFilePathOs as os
 import subprocess
+from concurrent.futures import ThreadPoolExecutor
 from io import BytesIO
 from struct import *
 from . import FfsFileStatement
@@ -118,13 +119,15 @@ class FV (object):
                                             TAB_LINE_BREAK)
 
         # Process Modules in FfsList
+        FfsGenList = []
         for FfsFile in self.FfsList:
             if Flag:
                 if isinstance(FfsFile, FfsFileStatement.FileStatement):
                     continue
             if GenFdsGlobalVariable.EnableGenfdsMultiThread and GenFdsGlobalVariable.ModuleFile and GenFdsGlobalVariable.ModuleFile.Path.find(os.path.normpath(FfsFile.InfFileName)) == -1:
                 continue
-            FileName = FfsFile.GenFfs(MacroDict, FvParentAddr=BaseAddress, IsMakefile=Flag, FvName=self.UiFvName)
+            FfsGenList.append(FfsFile)
+        for FileName in self._GenerateFfsFiles(FfsGenList, MacroDict, BaseAddress, Flag):
             FfsFileList.append(FileName)
             if not Flag:
                 self.FvInfFile.append("EFI_FILE_NAME = " + \
@@ -233,6 +236,42 @@ class FV (object):
                 GenFdsGlobalVariable.ErrorLogger("Failed to generate %s FV file." %self.UiFvName)
         return FvOutputFile
 
+    ## _GenerateFfsFiles()
+    #
+    #   Generate the FFS files of the FV. With more than one FFS job the files are
+    #   generated by a pool of worker threads. A worker holds FfsWorkerLock while it
+    #   runs and CallExternalTool releases it while the tool runs, so the GenSec,
+    #   GenFfs and compression tools of the files overlap while the FDF objects
+    #   and the global variables are still only used by one thread at a time.
+    #
+    #   The makefile mode of --genfds-multi-thread already runs the FFS commands
+    #   in parallel through make, the workers are only used without it.
+    #
+    #   @param  self        The object pointer
+    #   @param  FfsGenList  The FFS statements to generate
+    #   @param  MacroDict   macro value pair
+    #   @param  BaseAddress base address of FV
+    #   @param  Flag        Generate makefile commands instead of the files
+    #   @retval list        The generated FFS file names, in the order of FfsGenList
+    #
+    def _GenerateFfsFiles(self, FfsGenList, MacroDict, BaseAddress, Flag):
+        Jobs = GenFdsGlobalVariable.FfsJobs
+        if Flag or Jobs <= 1 or len(FfsGenList) <= 1 or GenFdsGlobalVariable.EnableGenfdsMultiThread or \
+           getattr(GenFdsGlobalVariable.FfsWorkerState, 'FvDepth', None) is not None:
+            return [FfsFile.GenFfs(MacroDict, FvParentAddr=BaseAddress, IsMakefile=Flag, FvName=self.UiFvName) for FfsFile in FfsGenList]
+
+        def GenFfsInWorker(FfsFile):
+            with GenFdsGlobalVariable.FfsWorkerLock:
+                GenFdsGlobalVariable.FfsWorkerState.FvDepth = len(GenFdsGlobalVariable.LargeFileInFvFlags)
+                try:
+                    return FfsFile.GenFfs(MacroDict, FvParentAddr=BaseAddress, IsMakefile=Flag, FvName=self.UiFvName)
+                finally:
+                    GenFdsGlobalVariable.FfsWorkerState.FvDepth = None
+
+        with ThreadPoolExecutor(max_workers=min(Jobs, len(FfsGenList))) as Executor:
+            Futures = [Executor.submit(GenFfsInWorker, FfsFile) for FfsFile in FfsGenList]
+            return [Future.result() for Future in Futures]
+
     ## _GetBlockSize()
     #
     #   Calculate FV's block size
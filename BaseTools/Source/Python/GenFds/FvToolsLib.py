@@ -0,0 +1,128 @@
+## @file
+# Python binding of the FvTools library, which runs GenSec and GenFfs in process
+#
+# Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+# SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+
+##
+# Import Modules
+#
+from __future__ import absolute_import
+import Common.LongFilePathOs as os
+import sys
+import shutil
+import ctypes
+import threading
+
+from Common import EdkLogger
+
+## Version of the C interface this binding was written for, see FvTools.h
+FV_TOOLS_API_VERSION = 1
+
+## Tools the library can run, with the name of their function
+_TOOL_FUNCTIONS_ = {
+    'GenSec' : 'FvToolsGenSec',
+    'GenFfs' : 'FvToolsGenFfs',
+}
+
+if sys.platform == 'win32':
+    _LIBRARY_NAME_ = 'FvTools.dll'
+elif sys.platform == 'darwin':
+    _LIBRARY_NAME_ = 'libFvTools.dylib'
+else:
+    _LIBRARY_NAME_ = 'libFvTools.so'
+
+## Runs GenSec and GenFfs through the FvTools library
+#
+#   The library is searched next to the GenSec binary and in the places the
+# BaseTools wrapper scripts run the C tools from. It is loaded once per process,
+# and the calls are serialized because the tools use global state.
+#
+class FvToolsLib(object):
+    _Lock = threading.Lock()
+    _Library = None
+    _Loaded = False
+
+    ## Directories that may hold the library, in order
+    @staticmethod
+    def _SearchPaths():
+        Paths = []
+        Tool = shutil.which('GenSec')
+        if Tool:
+            Paths.append(os.path.dirname(os.path.realpath(Tool)))
+        WorkSpace = os.environ.get('WORKSPACE')
+        if WorkSpace:
+            Paths.append(os.path.join(WorkSpace, 'Conf', 'BaseToolsCBinaries'))
+        ToolsPath = os.environ.get('EDK_TOOLS_PATH')
+        if ToolsPath:
+            Paths.append(os.path.join(ToolsPath, 'Source', 'C', 'bin'))
+        return Paths
+
+    @staticmethod
+    def _Load():
+        for Directory in FvToolsLib._SearchPaths():
+            LibraryPath = os.path.join(Directory, _LIBRARY_NAME_)
+            if not os.path.isfile(LibraryPath):
+                continue
+            try:
+                Library = ctypes.CDLL(LibraryPath)
+                Library.FvToolsGetApiVersion.restype = ctypes.c_int
+                Version = Library.FvToolsGetApiVersion()
+            except (OSError, AttributeError) as X:
+                EdkLogger.debug(EdkLogger.DEBUG_5, "Failed to load %s: %s" % (LibraryPath, X))
+                continue
+            if Version != FV_TOOLS_API_VERSION:
+                EdkLogger.debug(EdkLogger.DEBUG_5, "Ignore %s with interface version %d" % (LibraryPath, Version))
+                continue
+            for Function in _TOOL_FUNCTIONS_.values():
+                getattr(Library, Function).argtypes = [ctypes.c_int, ctypes.POINTER(ctypes.c_char_p)]
+                getattr(Library, Function).restype = ctypes.c_int
+            EdkLogger.verbose("Run GenSec and GenFfs through %s" % LibraryPath)
+            return Library
+        return None
+
+    ## Check whether a tool can run in process
+    #
+    #   @param  Tool        The name or path of the tool
+    #
+    #   @retval True        The library is available and runs the tool
+    #   @retval False       The tool has to run as a process
+    #
+    @staticmethod
+    def Supports(Tool):
+        if os.path.splitext(os.path.basename(Tool))[0] not in _TOOL_FUNCTIONS_:
+            return False
+        with FvToolsLib._Lock:
+            if not FvToolsLib._Loaded:
+                FvToolsLib._Library = FvToolsLib._Load()
+                FvToolsLib._Loaded = True
+        return FvToolsLib._Library is not None
+
+    ## Run a tool in process
+    #
+    #   The tool prints its messages to the standard output and error of the
+    # process, as it is not possible to capture them per call.
+    #
+    #   @param  Cmd         The command line, as passed to CallExternalTool
+    #
+    #   @retval int         The exit code of the tool
+    #
+    @staticmethod
+    def Run(Cmd):
+        Function = _TOOL_FUNCTIONS_[os.path.splitext(os.path.basename(Cmd[0]))[0]]
+        #
+        # The command line of the external tool goes through the shell, which
+        # removes the quotes around the arguments that have them.
+        #
+        Arguments = []
+        for Argument in Cmd:
+            Argument = str(Argument)
+            if len(Argument) >= 2 and Argument[0] == Argument[-1] == '"':
+                Argument = Argument[1:-1]
+            Arguments.append(Argument.encode(sys.getfilesystemencoding()))
+        Argv = (ctypes.c_char_p * (len(Arguments) + 1))(*Arguments)
+        with FvToolsLib._Lock:
+            sys.stdout.flush()
+            sys.stderr.flush()
+            return getattr(FvToolsLib._Library, Function)(len(Arguments), Argv)
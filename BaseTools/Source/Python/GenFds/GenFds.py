@@ -18,6 +18,7 @@ from glob import glob
 from struct import unpack
 from linecache import getlines
 from io import BytesIO
+import multiprocessing
 
 import Common.LongFilePathOs as os
 from Common.TargetTxtClassObject import TargetTxtDict,gDefaultTargetTxtFile
@@ -26,10 +27,10 @@ import Common.GlobalData as GlobalData
 from Common import EdkLogger
 from Common.StringUtils import NormPath
 from Common.Misc import DirCache, PathClass, GuidStructureStringToGuidString
-from Common.Misc import SaveFileOnChange, ClearDuplicatedInf
+from Common.Misc import SaveFileOnChange, ClearDuplicatedInf, CreateDirectory
 from Common.BuildVersion import gBUILD_VERSION
 from Common.MultipleWorkspace import MultipleWorkspace as mws
-from Common.BuildToolError import FatalError, GENFDS_ERROR, CODE_ERROR, FORMAT_INVALID, RESOURCE_NOT_AVAILABLE, FILE_NOT_FOUND, OPTION_MISSING, FORMAT_NOT_SUPPORTED, OPTION_VALUE_INVALID, PARAMETER_INVALID
+from Common.BuildToolError import FatalError, GENFDS_ERROR, CODE_ERROR, FORMAT_INVALID, RESOURCE_NOT_AVAILABLE, FILE_NOT_FOUND, OPTION_MISSING, FORMAT_NOT_SUPPORTED, OPTION_VALUE_INVALID, PARAMETER_INVALID, FILE_CREATE_FAILURE
 from Workspace.WorkspaceDatabase import WorkspaceDatabase
 
 from .FdfParser import FdfParser, Warning
@@ -94,6 +95,9 @@ def resetFdsGlobalVariable():
     GenFdsGlobalVariable.CopyList   = []
     GenFdsGlobalVariable.ModuleFile = ''
     GenFdsGlobalVariable.EnableGenfdsMultiThread = True
+    GenFdsGlobalVariable.FfsJobs = 1
+    GenFdsGlobalVariable.SectionCacheDir = ''
+    GenFdsGlobalVariable.FvToolsInProcess = False
 
     GenFdsGlobalVariable.LargeFileInFvFlags = []
     GenFdsGlobalVariable.EFI_FIRMWARE_FILE_SYSTEM3_GUID = '5473C07A-3DCB-4dca-BD6F-1E9689E7349A'
@@ -144,6 +148,24 @@ def GenFdsApi(FdsCommandDict, WorkSpaceDataBase=None):
                 GenFdsGlobalVariable.EnableGenfdsMultiThread = False
         os.chdir(GenFdsGlobalVariable.WorkSpaceDir)
 
+        if FdsCommandDict.get("GenfdsJobs") is not None:
+            GenFdsGlobalVariable.FfsJobs = FdsCommandDict.get("GenfdsJobs")
+            if GenFdsGlobalVariable.FfsJobs < 0:
+                EdkLogger.error("GenFds", OPTION_VALUE_INVALID, ExtraData="The number of GenFds jobs must not be negative.")
+            if GenFdsGlobalVariable.FfsJobs == 0:
+                GenFdsGlobalVariable.FfsJobs = multiprocessing.cpu_count()
+
+        if FdsCommandDict.get("GenfdsCacheDir"):
+            SectionCacheDir = os.path.normpath(FdsCommandDict.get("GenfdsCacheDir"))
+            if not os.path.isabs(SectionCacheDir):
+                SectionCacheDir = os.path.join(GenFdsGlobalVariable.WorkSpaceDir, SectionCacheDir)
+            if not CreateDirectory(SectionCacheDir):
+                EdkLogger.error("GenFds", FILE_CREATE_FAILURE, "Could not create section cache directory %s" % SectionCacheDir)
+            GenFdsGlobalVariable.SectionCacheDir = SectionCacheDir
+
+        if FdsCommandDict.get("GenfdsInProcess"):
+            GenFdsGlobalVariable.FvToolsInProcess = True
+
         # set multiple workspace
         PackagesPath = os.getenv("PACKAGES_PATH")
         mws.setWs(GenFdsGlobalVariable.WorkSpaceDir, PackagesPath)
@@ -407,6 +429,9 @@ def OptionsToCommandDict(Options):
     FdsCommandDict["debug"] = Options.debug
     FdsCommandDict["Workspace"] = Options.Workspace
     FdsCommandDict["GenfdsMultiThread"] = not Options.NoGenfdsMultiThread
+    FdsCommandDict["GenfdsJobs"] = Options.GenfdsJobs
+    FdsCommandDict["GenfdsCacheDir"] = Options.GenfdsCacheDir
+    FdsCommandDict["GenfdsInProcess"] = Options.GenfdsInProcess
     FdsCommandDict["fdf_file"] = [PathClass(Options.filename)] if Options.filename else []
     FdsCommandDict["build_target"] = Options.BuildTarget
     FdsCommandDict["toolchain_tag"] = Options.ToolChain
@@ -465,6 +490,9 @@ def myOptionParser():
     Parser.add_option("--pcd", action="append", dest="OptionPcd", help="Set PCD value by command line. Format: \"PcdName=Value\" ")
     Parser.add_option("--genfds-multi-thread", action="store_true", dest="GenfdsMultiThread", default=True, help="Enable GenFds multi thread to generate ffs file.")
     Parser.add_option("--no-genfds-multi-thread", action="store_true", dest="NoGenfdsMultiThread", default=False, help="Disable GenFds multi thread to generate ffs file.")
+    Parser.add_option("--genfds-jobs", action="store", type="int", dest="GenfdsJobs", default=None, help="Generate the FFS files of each FV with this many jobs when GenFds multi thread is disabled. 0 uses one job per processor.")
+    Parser.add_option("--genfds-cache", action="store", type="string", dest="GenfdsCacheDir", help="Cache compressed and GUIDed sections in the specified directory.")
+    Parser.add_option("--genfds-in-process", action="store_true", dest="GenfdsInProcess", default=False, help="Run GenSec and GenFfs in the GenFds process through the FvTools library when it is available and GenFds multi thread is disabled.")
 
     Options, _ = Parser.parse_args()
     return Options
@@ -14,6 +14,9 @@ from __future__ import absolute_import
 
 import Common.LongFilePathOs as os
 import sys
+import hashlib
+import shutil
+import threading
 from sys import stdout
 from subprocess import PIPE,Popen
 from struct import Struct
@@ -29,10 +32,12 @@ from AutoGen.BuildEngine import ToolBuildRule
 import Common.DataType as DataType
 from Common.Misc import PathClass,CreateDirectory
 from Common.LongFilePathSupport import OpenLongFilePath as open
+from Common.LongFilePathSupport import CopyLongFilePath
 from Common.MultipleWorkspace import MultipleWorkspace as mws
 import Common.GlobalData as GlobalData
 from Common.BuildToolError import *
 from AutoGen.AutoGen import CalculatePriorityValue
+from .FvToolsLib import FvToolsLib
 
 ## Global variables
 #
@@ -74,6 +79,25 @@ class GenFdsGlobalVariable:
     ModuleFile = ''
     EnableGenfdsMultiThread = True
 
+    #
+    # Number of FFS files of one FV generated at the same time, see FV._GenerateFfsFiles.
+    # An FFS worker holds FfsWorkerLock while it runs and only releases it while an
+    # external tool runs, FfsWorkerState.FvDepth is set in the worker threads.
+    #
+    FfsJobs = 1
+    FfsWorkerLock = threading.Lock()
+    FfsWorkerState = threading.local()
+
+    #
+    # Directory of the compressed and GUIDed section cache, empty when it is disabled.
+    #
+    SectionCacheDir = ''
+
+    #
+    # Run GenSec and GenFfs through the FvTools library when it is available.
+    #
+    FvToolsInProcess = False
+
     #
     # The list whose element are flags to indicate if large FFS or SECTION files exist in FV.
     # At the beginning of each generation of FV, false flag is appended to the list,
@@ -432,6 +456,79 @@ class GenFdsGlobalVariable:
                 return True
         return False
 
+    ## SectionCacheKey()
+    #
+    #   Compute the section cache key of a tool invocation. The key covers the tool
+    #   and its time stamp, its options and the content of the input files, but not
+    #   the path of the output file, so that the same section of another FV or build
+    #   still hits.
+    #
+    #   @param  Tool        The command line of the tool without output and input files
+    #   @param  Input       The list of input files
+    #   @retval string      The key, or None if the cache is disabled or an input is missing
+    #
+    @staticmethod
+    def SectionCacheKey(Tool, Input):
+        if not GenFdsGlobalVariable.SectionCacheDir or not Input:
+            return None
+        Hash = hashlib.sha256()
+        Hash.update(' '.join(Tool).encode('utf-8'))
+        ToolFile = shutil.which(Tool[0])
+        if ToolFile:
+            Hash.update(('%d %d' % (os.path.getsize(ToolFile), os.path.getmtime(ToolFile))).encode('utf-8'))
+        for File in Input:
+            if not os.path.isfile(File):
+                return None
+            Hash.update(b'\0')
+            with open(File, 'rb') as Fd:
+                for Chunk in iter(lambda: Fd.read(0x100000), b''):
+                    Hash.update(Chunk)
+        return Hash.hexdigest()
+
+    @staticmethod
+    def _SectionCacheFile(Key):
+        return os.path.join(GenFdsGlobalVariable.SectionCacheDir, Key[:2], Key)
+
+    ## RestoreCachedSection()
+    #
+    #   @param  Key         The key returned by SectionCacheKey
+    #   @param  Output      The file to restore the cached section to
+    #   @retval True        if the section was found in the cache and restored
+    #   @retval False       if the section has to be generated
+    #
+    @staticmethod
+    def RestoreCachedSection(Key, Output):
+        if Key is None:
+            return False
+        CachedFile = GenFdsGlobalVariable._SectionCacheFile(Key)
+        if not os.path.isfile(CachedFile):
+            return False
+        CreateDirectory(os.path.dirname(Output))
+        CopyLongFilePath(CachedFile, Output)
+        GenFdsGlobalVariable.DebugLogger(EdkLogger.DEBUG_5, "%s restored from section cache %s" % (Output, CachedFile))
+        return True
+
+    ## SaveCachedSection()
+    #
+    #   Store a generated section in the cache. The file is renamed into place, so that
+    #   several builds can share the same cache directory.
+    #
+    #   @param  Key         The key returned by SectionCacheKey
+    #   @param  Output      The generated section
+    #
+    @staticmethod
+    def SaveCachedSection(Key, Output):
+        if Key is None or not os.path.isfile(Output):
+            return
+        CachedFile = GenFdsGlobalVariable._SectionCacheFile(Key)
+        TempFile = '%s.%d.%d' % (CachedFile, os.getpid(), threading.current_thread().ident)
+        try:
+            CreateDirectory(os.path.dirname(CachedFile))
+            CopyLongFilePath(Output, TempFile)
+            os.replace(TempFile, CachedFile)
+        except OSError as X:
+            GenFdsGlobalVariable.VerboseLogger("Failed to cache section %s: %s" % (Output, X))
+
     @staticmethod
     def GenerateSection(Output, Input, Type=None, CompressionType=None, Guid=None,
                         GuidHdrLen=None, GuidAttr=[], Ui=None, Ver=None, InputAlign=[], BuildNumber=None, DummyFile=None, IsMakefile=False):
@@ -516,7 +613,21 @@ class GenFdsGlobalVariable:
                     GenFdsGlobalVariable.SecCmdList.append(' '.join(Cmd).strip())
             elif GenFdsGlobalVariable.NeedsUpdate(Output, list(Input) + [CommandFile]):
                 GenFdsGlobalVariable.DebugLogger(EdkLogger.DEBUG_5, "%s needs update because of newer %s" % (Output, Input))
-                GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to generate section")
+                #
+                # Only compressed and GUIDed sections are worth caching
+                #
+                # GenSec compares the input with the content of the dummy file to find
+                # the GUIDed section header, so that content is part of the key too.
+                #
+                CacheKey = None
+                if CompressionType or Guid:
+                    CacheInput = list(Input)
+                    if DummyFile:
+                        CacheInput.append(DummyFile)
+                    CacheKey = GenFdsGlobalVariable.SectionCacheKey(Cmd[:Cmd.index("-o")], CacheInput)
+                if not GenFdsGlobalVariable.RestoreCachedSection(CacheKey, Output):
+                    GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to generate section")
+                    GenFdsGlobalVariable.SaveCachedSection(CacheKey, Output)
                 if (os.path.getsize(Output) >= GenFdsGlobalVariable.LARGE_FILE_SIZE and
                     GenFdsGlobalVariable.LargeFileInFvFlags):
                     GenFdsGlobalVariable.LargeFileInFvFlags[-1] = True
@@ -677,13 +788,21 @@ class GenFdsGlobalVariable:
 
         Cmd = [ToolPath, ]
         Cmd += Options.split(' ')
+        CacheKey = None
+        if not IsMakefile:
+            CacheKey = GenFdsGlobalVariable.SectionCacheKey(Cmd, Input)
         Cmd += ("-o", Output)
         Cmd += Input
         if IsMakefile:
             if " ".join(Cmd).strip() not in GenFdsGlobalVariable.SecCmdList:
                 GenFdsGlobalVariable.SecCmdList.append(" ".join(Cmd).strip())
+        elif GenFdsGlobalVariable.RestoreCachedSection(CacheKey, Output):
+            if returnValue != []:
+                returnValue[0] = 0
         else:
             GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to call " + ToolPath, returnValue)
+            if returnValue == [] or returnValue[0] == 0:
+                GenFdsGlobalVariable.SaveCachedSection(CacheKey, Output)
 
     @staticmethod
     def CallExternalTool (cmd, errorMess, returnValue=[]):
@@ -705,11 +824,37 @@ class GenFdsGlobalVariable:
             if GenFdsGlobalVariable.SharpCounter % GenFdsGlobalVariable.SharpNumberPerLine == 0:
                 stdout.write('\n')
 
+        #
+        # Let the other FFS workers run while the tool runs, unless the tool belongs
+        # to an FV nested in the FFS file of this worker: the FV stack is shared.
+        #
+        ReleaseLock = getattr(GenFdsGlobalVariable.FfsWorkerState, 'FvDepth', None) == len(GenFdsGlobalVariable.LargeFileInFvFlags)
+        #
+        # A caller that asks for the return value expects the tool to fail quietly,
+        # which only an external tool does.
+        #
+        InProcess = GenFdsGlobalVariable.FvToolsInProcess and returnValue == [] and FvToolsLib.Supports(cmd[0])
+        if ReleaseLock:
+            GenFdsGlobalVariable.FfsWorkerLock.release()
         try:
-            PopenObject = Popen(' '.join(cmd), stdout=PIPE, stderr=PIPE, shell=True)
-        except Exception as X:
-            EdkLogger.error("GenFds", COMMAND_FAILURE, ExtraData="%s: %s" % (str(X), cmd[0]))
-        (out, error) = PopenObject.communicate()
+            if InProcess:
+                ReturnCode = FvToolsLib.Run(cmd)
+            else:
+                try:
+                    PopenObject = Popen(' '.join(cmd), stdout=PIPE, stderr=PIPE, shell=True)
+                except Exception as X:
+                    EdkLogger.error("GenFds", COMMAND_FAILURE, ExtraData="%s: %s" % (str(X), cmd[0]))
+                (out, error) = PopenObject.communicate()
+        finally:
+            if ReleaseLock:
+                GenFdsGlobalVariable.FfsWorkerLock.acquire()
+
+        if InProcess:
+            if ReturnCode != 0:
+                GenFdsGlobalVariable.InfLogger ("Return Value = %d" % ReturnCode)
+                print("###", cmd)
+                EdkLogger.error("GenFds", COMMAND_FAILURE, errorMess)
+            return
 
         while PopenObject.returncode is None:
             PopenObject.wait()
@@ -0,0 +1,183 @@
+## @file
+# This file is used to keep the parsed content of INF and DEC files across builds
+#
+# Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+# SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+
+##
+# Import Modules
+#
+from __future__ import absolute_import
+import Common.LongFilePathOs as os
+import pickle
+from hashlib import sha1, sha256
+
+import Common.EdkLogger as EdkLogger
+import Common.GlobalData as GlobalData
+from Common.LongFilePathSupport import OpenLongFilePath as open
+
+## Persistent cache of meta file tables
+#
+#   The raw table of an INF or DEC file only depends on the content of the file,
+# so the next build can reuse it as long as the file does not change. Every file
+# has its own cache entry, named after the hash of its path, and the entry is only
+# read when the parser of the file is first queried.
+#
+#   An entry is valid when the size and the time stamp of the file did not change,
+# or when they did but the hash of the content is still the same. The entry is
+# also bound to the version of the parser, see _ParserStamp().
+#
+class MetaFileCache(object):
+    # Change when the layout of the tables changes
+    _VERSION_ = 1
+
+    # The ID column and the BelongsToItem column of the INF and DEC tables
+    _ID_ = 0
+    _BELONGS_TO_ITEM_ = 7
+
+    # The parser and the modules it takes its parsing code and constants from,
+    # relative to BaseTools/Source/Python
+    _PARSER_MODULES_ = (
+        'Workspace/MetaFileParser.py',
+        'Workspace/MetaFileTable.py',
+        'Workspace/MetaFileCommentParser.py',
+        'Workspace/MetaFileCache.py',
+        'Common/StringUtils.py',
+        'Common/Expression.py',
+        'Common/DataType.py',
+        'Common/Misc.py',
+        'CommonDataClass/DataClass.py',
+        'CommonDataClass/Exceptions.py',
+        )
+
+    _Stamp = None
+
+    ## Identify the parser and the options the raw tables depend on
+    @staticmethod
+    def _ParserStamp():
+        if MetaFileCache._Stamp is None:
+            Stamp = [MetaFileCache._VERSION_]
+            Directory = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+            for Name in MetaFileCache._PARSER_MODULES_:
+                try:
+                    Stat = os.stat(os.path.join(Directory, Name))
+                    Stamp.append((Name, Stat.st_size, Stat.st_mtime))
+                except OSError:
+                    Stamp.append((Name, None))
+            MetaFileCache._Stamp = tuple(Stamp)
+        CheckUsage = bool(GlobalData.gOptions and GlobalData.gOptions.CheckUsage)
+        return MetaFileCache._Stamp + (CheckUsage,)
+
+    @staticmethod
+    def _EntryPath(MetaFile):
+        Name = sha1(os.path.normcase(MetaFile.Path).encode('utf-8')).hexdigest()
+        return os.path.join(GlobalData.gMetaFileCacheDir, Name[:2], Name)
+
+    @staticmethod
+    def _FileHash(MetaFile):
+        with open(MetaFile.Path, 'rb') as File:
+            return sha256(File.read()).hexdigest()
+
+    @staticmethod
+    def _Write(EntryPath, Entry):
+        TempPath = '%s.%d' % (EntryPath, os.getpid())
+        try:
+            if not os.path.exists(os.path.dirname(EntryPath)):
+                os.makedirs(os.path.dirname(EntryPath))
+            with open(TempPath, 'wb') as File:
+                pickle.dump(Entry, File, pickle.HIGHEST_PROTOCOL)
+            os.replace(TempPath, EntryPath)
+        except (OSError, IOError, pickle.PicklingError) as X:
+            EdkLogger.debug(EdkLogger.DEBUG_5, "Failed to save meta file cache %s: %s" % (EntryPath, X))
+
+    ## Fill a table with the cached content of its meta file
+    #
+    #   @param  Table       The ModuleTable or PackageTable of the meta file
+    #
+    #   @retval True        The table holds the cached content, with its end flag
+    #   @retval False       The meta file has to be parsed
+    #
+    @staticmethod
+    def Load(Table):
+        if not GlobalData.gMetaFileCacheDir:
+            return False
+        MetaFile = Table.MetaFile
+        EntryPath = MetaFileCache._EntryPath(MetaFile)
+        try:
+            with open(EntryPath, 'rb') as File:
+                Entry = pickle.load(File)
+            Stat = os.stat(MetaFile.Path)
+        except Exception:
+            return False
+        if Entry.get('Stamp') != MetaFileCache._ParserStamp() or Entry.get('File') != MetaFile.Path:
+            return False
+        TimeStamp = (Stat.st_size, Stat.st_mtime)
+        if Entry['TimeStamp'] != TimeStamp:
+            try:
+                if MetaFileCache._FileHash(MetaFile) != Entry['Hash']:
+                    return False
+            except IOError:
+                return False
+            #
+            # Touched but not changed, save the new time stamp so that the next
+            # build does not hash the file again.
+            #
+            Entry['TimeStamp'] = TimeStamp
+            MetaFileCache._Write(EntryPath, Entry)
+
+        #
+        # The IDs depend on the order in which the files were opened, give the
+        # records the IDs they would have got from parsing the file now.
+        #
+        Rows = Entry['Rows']
+        IdMap = {}
+        for Row in Rows:
+            if Row[MetaFileCache._ID_] >= 0:
+                IdMap[Row[MetaFileCache._ID_]] = Table.NextId()
+        for Row in Rows:
+            if Row[MetaFileCache._ID_] >= 0:
+                Row[MetaFileCache._ID_] = IdMap[Row[MetaFileCache._ID_]]
+            if Row[MetaFileCache._BELONGS_TO_ITEM_] >= 0:
+                Row[MetaFileCache._BELONGS_TO_ITEM_] = IdMap.get(Row[MetaFileCache._BELONGS_TO_ITEM_], -1)
+        Table.CurrentContent = Rows
+        EdkLogger.debug(EdkLogger.DEBUG_5, "Loaded %s from meta file cache" % MetaFile.Path)
+        return True
+
+    ## Save the parsed content of a table
+    #
+    #   @param  Table       The ModuleTable or PackageTable of the meta file
+    #   @param  TimeStamp   The size and time stamp of the meta file before it was parsed
+    #
+    @staticmethod
+    def Save(Table, TimeStamp):
+        if not GlobalData.gMetaFileCacheDir or TimeStamp is None or not Table.IsIntegrity():
+            return
+        #
+        # Do not save a file that changed while it was parsed
+        #
+        if MetaFileCache.GetTimeStamp(Table.MetaFile) != TimeStamp:
+            return
+        try:
+            Hash = MetaFileCache._FileHash(Table.MetaFile)
+        except IOError:
+            return
+        Entry = {
+            'Stamp'     : MetaFileCache._ParserStamp(),
+            'File'      : Table.MetaFile.Path,
+            'TimeStamp' : TimeStamp,
+            'Hash'      : Hash,
+            'Rows'      : Table.CurrentContent,
+        }
+        MetaFileCache._Write(MetaFileCache._EntryPath(Table.MetaFile), Entry)
+
+    ## Get the size and time stamp of a meta file, see Save()
+    @staticmethod
+    def GetTimeStamp(MetaFile):
+        if not GlobalData.gMetaFileCacheDir:
+            return None
+        try:
+            Stat = os.stat(MetaFile.Path)
+        except OSError:
+            return None
+        return (Stat.st_size, Stat.st_mtime)
@@ -29,6 +29,7 @@ from CommonDataClass.Exceptions import *
 from Common.LongFilePathSupport import OpenLongFilePath as open
 from collections import defaultdict
 from .MetaFileTable import MetaFileStorage
+from .MetaFileCache import MetaFileCache
 from .MetaFileCommentParser import CheckInfComment
 from Common.DataType import TAB_COMMENT_EDK_START, TAB_COMMENT_EDK_END
 
@@ -122,6 +123,9 @@ class MetaFileParser(object):
     # Parser objects used to implement singleton
     MetaFiles = {}
 
+    # The raw table only depends on the file content and can be kept across builds
+    CacheRawTable = False
+
     ## Factory method
     #
     # One file, one parser object. This factory method makes sure that there's
@@ -258,7 +262,12 @@ class MetaFileParser(object):
             else:
                 self._Table = self._RawTable
                 self._PostProcessed = False
+                if self.CacheRawTable and MetaFileCache.Load(self._RawTable):
+                    self._Finished = True
+                    return
+                TimeStamp = MetaFileCache.GetTimeStamp(self.MetaFile) if self.CacheRawTable else None
                 self.Start()
+                MetaFileCache.Save(self._RawTable, TimeStamp)
     ## Data parser for the common format in different type of file
     #
     #   The common format in the meatfile is like
@@ -558,6 +567,8 @@ class InfParser(MetaFileParser):
         TAB_USER_EXTENSIONS.upper() : MODEL_META_DATA_USER_EXTENSION
     }
 
+    CacheRawTable = True
+
     ## Constructor of InfParser
     #
     #  Initialize object of InfParser
@@ -1770,6 +1781,8 @@ class DecParser(MetaFileParser):
         TAB_USER_EXTENSIONS.upper()                 :   MODEL_META_DATA_USER_EXTENSION,
     }
 
+    CacheRawTable = True
+
     ## Constructor of DecParser
     #
     #  Initialize object of DecParser
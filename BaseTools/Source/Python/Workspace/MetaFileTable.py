@@ -61,6 +61,11 @@ class MetaFileTable():
     def SetEndFlag(self):
         self.CurrentContent.append(self._DUMMY_)
 
+    ## Allocate the ID of a new record
+    def NextId(self):
+        self.ID = self.ID + self._ID_STEP_
+        return self.ID
+
     def GetAll(self):
         return [item for item in self.CurrentContent if item[0] >= 0 and item[-1]>=0]
 
@@ -88,6 +93,13 @@ class ModuleTable(MetaFileTable):
     def __init__(self, Db, MetaFile, Temporary):
         MetaFileTable.__init__(self, Db, MetaFile, MODEL_FILE_INF, Temporary)
 
+    ## Allocate the ID of a new record
+    def NextId(self):
+        self.ID = self.ID + self._ID_STEP_
+        if self.ID >= (MODEL_FILE_INF + self._ID_MAX_):
+            self.ID = MODEL_FILE_INF + self._ID_STEP_
+        return self.ID
+
     ## Insert a record into table Inf
     #
     # @param Model:          Model of a Inf item
@@ -107,9 +119,7 @@ class ModuleTable(MetaFileTable):
                BelongsToItem=-1, StartLine=-1, StartColumn=-1, EndLine=-1, EndColumn=-1, Enabled=0):
 
         (Value1, Value2, Value3, Scope1, Scope2) = (Value1.strip(), Value2.strip(), Value3.strip(), Scope1.strip(), Scope2.strip())
-        self.ID = self.ID + self._ID_STEP_
-        if self.ID >= (MODEL_FILE_INF + self._ID_MAX_):
-            self.ID = MODEL_FILE_INF + self._ID_STEP_
+        self.NextId()
 
         row = [ self.ID,
                 Model,
@@ -201,7 +211,7 @@ class PackageTable(MetaFileTable):
     def Insert(self, Model, Value1, Value2, Value3, Scope1=TAB_ARCH_COMMON, Scope2=TAB_COMMON,
                BelongsToItem=-1, StartLine=-1, StartColumn=-1, EndLine=-1, EndColumn=-1, Enabled=0):
         (Value1, Value2, Value3, Scope1, Scope2) = (Value1.strip(), Value2.strip(), Value3.strip(), Scope1.strip(), Scope2.strip())
-        self.ID = self.ID + self._ID_STEP_
+        self.NextId()
 
         row = [ self.ID,
                 Model,
@@ -765,6 +765,9 @@ class Build():
         GlobalData.gBinCacheDest   = BuildOptions.BinCacheDest
         GlobalData.gBinCacheSource = BuildOptions.BinCacheSource
         GlobalData.gEnableGenfdsMultiThread = not BuildOptions.NoGenfdsMultiThread
+        GlobalData.gGenfdsJobs = BuildOptions.GenfdsJobs
+        GlobalData.gGenfdsCacheDir = BuildOptions.GenfdsCacheDir
+        GlobalData.gGenfdsInProcess = BuildOptions.GenfdsInProcess
         GlobalData.gDisableIncludePathCheck = BuildOptions.DisableIncludePathCheck
 
         if GlobalData.gBinCacheDest and not GlobalData.gUseHashCache:
@@ -797,6 +800,8 @@ class Build():
         GlobalData.gDatabasePath = os.path.normpath(os.path.join(GlobalData.gConfDirectory, GlobalData.gDatabasePath))
         if not os.path.exists(os.path.join(GlobalData.gConfDirectory, '.cache')):
             os.makedirs(os.path.join(GlobalData.gConfDirectory, '.cache'))
+        if not BuildOptions.DisableMetaFileCache:
+            GlobalData.gMetaFileCacheDir = os.path.join(os.path.dirname(GlobalData.gDatabasePath), 'MetaFile')
         self.Db = BuildDB
         self.BuildDatabase = self.Db.BuildObject
         self.Platform = None
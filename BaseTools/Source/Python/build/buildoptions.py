@@ -102,5 +102,9 @@ class MyOptionParser():
         Parser.add_option("--binary-source", action="store", type="string", dest="BinCacheSource", help="Consume a cache of binary files from the specified directory.")
         Parser.add_option("--genfds-multi-thread", action="store_true", dest="GenfdsMultiThread", default=True, help="Enable GenFds multi thread to generate ffs file.")
         Parser.add_option("--no-genfds-multi-thread", action="store_true", dest="NoGenfdsMultiThread", default=False, help="Disable GenFds multi thread to generate ffs file.")
+        Parser.add_option("--genfds-jobs", action="store", type="int", dest="GenfdsJobs", default=None, help="Generate the FFS files of each FV with this many jobs when GenFds multi thread is disabled. 0 uses one job per processor.")
+        Parser.add_option("--genfds-cache", action="store", type="string", dest="GenfdsCacheDir", help="Cache compressed and GUIDed sections in the specified directory.")
+        Parser.add_option("--genfds-in-process", action="store_true", dest="GenfdsInProcess", default=False, help="Run GenSec and GenFfs in the GenFds process through the FvTools library when it is available and GenFds multi thread is disabled.")
+        Parser.add_option("--disable-metafile-cache", action="store_true", dest="DisableMetaFileCache", default=False, help="Always parse the INF and DEC files instead of reusing the results of the previous build.")
         Parser.add_option("--disable-include-path-check", action="store_true", dest="DisableIncludePathCheck", default=False, help="Disable the include path check for outside of package.")
         self.BuildOption, self.BuildTarget = Parser.parse_args()
@@ -1016,6 +1016,40 @@ CryptoServiceSha256HashAll (
   return CALL_BASECRYPTLIB (Sha256.Services.HashAll, Sha256HashAll, (Data, DataSize, HashValue), FALSE);
 }
 
+/**
+  Computes the SHA-256 message digests of several independent input data buffers.
+
+  This function performs the SHA-256 message digest of each of the DataCount
+  buffers, and places the digest of Data[Index] at offset Index * 32 of
+  HashValues. Where the CPU provides it, several buffers are hashed at the same
+  time, which is faster than calling Sha256HashAll() once per buffer.
+
+  If this interface is not supported, then return FALSE.
+
+  @param[in]   Data        Array of DataCount pointers to the buffers containing
+                           the data to be hashed.
+  @param[in]   DataSize    Array of DataCount sizes of the Data buffers in bytes.
+  @param[in]   DataCount   Number of buffers to hash.
+  @param[out]  HashValues  Pointer to a buffer that receives the DataCount SHA-256
+                           digest values (32 bytes each).
+
+  @retval TRUE   SHA-256 digest computation succeeded.
+  @retval FALSE  SHA-256 digest computation failed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+CryptoServiceSha256HashAllMultiBuffer (
+  IN   CONST VOID   *CONST  *Data,
+  IN   CONST UINTN          *DataSize,
+  IN   UINTN                DataCount,
+  OUT  UINT8                *HashValues
+  )
+{
+  return CALL_BASECRYPTLIB (Sha256.Services.HashAllMultiBuffer, Sha256HashAllMultiBuffer, (Data, DataSize, DataCount, HashValues), FALSE);
+}
+
 /**
   Retrieves the size, in bytes, of the context buffer required for SHA-384 hash operations.
 
@@ -1165,6 +1199,40 @@ CryptoServiceSha384HashAll (
   return CALL_BASECRYPTLIB (Sha384.Services.HashAll, Sha384HashAll, (Data, DataSize, HashValue), FALSE);
 }
 
+/**
+  Computes the SHA-384 message digests of several independent input data buffers.
+
+  This function performs the SHA-384 message digest of each of the DataCount
+  buffers, and places the digest of Data[Index] at offset Index * 48 of
+  HashValues. Where the CPU provides it, several buffers are hashed at the same
+  time, which is faster than calling Sha384HashAll() once per buffer.
+
+  If this interface is not supported, then return FALSE.
+
+  @param[in]   Data        Array of DataCount pointers to the buffers containing
+                           the data to be hashed.
+  @param[in]   DataSize    Array of DataCount sizes of the Data buffers in bytes.
+  @param[in]   DataCount   Number of buffers to hash.
+  @param[out]  HashValues  Pointer to a buffer that receives the DataCount SHA-384
+                           digest values (48 bytes each).
+
+  @retval TRUE   SHA-384 digest computation succeeded.
+  @retval FALSE  SHA-384 digest computation failed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+CryptoServiceSha384HashAllMultiBuffer (
+  IN   CONST VOID   *CONST  *Data,
+  IN   CONST UINTN          *DataSize,
+  IN   UINTN                DataCount,
+  OUT  UINT8                *HashValues
+  )
+{
+  return CALL_BASECRYPTLIB (Sha384.Services.HashAllMultiBuffer, Sha384HashAllMultiBuffer, (Data, DataSize, DataCount, HashValues), FALSE);
+}
+
 /**
   Retrieves the size, in bytes, of the context buffer required for SHA-512 hash operations.
 
@@ -5509,6 +5577,65 @@ CryptoServiceTlsGetExportKey (
            );
 }
 
+/**
+  Sets the state of a previous TLS/SSL session to be resumed during TLS/SSL connect.
+
+  This function restores a session state returned by TlsGetResumptionData()
+  for an earlier connection to the same server, so that the handshake resumes
+  that session instead of negotiating new keys. It must be called before the
+  handshake starts.
+
+  @param[in]  Tls             Pointer to the TLS object.
+  @param[in]  Data            Session state returned by TlsGetResumptionData().
+  @param[in]  DataSize        Size of Data in bytes.
+
+  @retval  EFI_SUCCESS           The session state was set successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_ABORTED           The session state could not be restored.
+
+**/
+EFI_STATUS
+EFIAPI
+CryptoServiceTlsSetResumptionData (
+  IN     VOID        *Tls,
+  IN     CONST VOID  *Data,
+  IN     UINTN       DataSize
+  )
+{
+  return CALL_BASECRYPTLIB (TlsSet.Services.ResumptionData, TlsSetResumptionData, (Tls, Data, DataSize), EFI_UNSUPPORTED);
+}
+
+/**
+  Gets the state of the TLS/SSL session used by the specified TLS connection.
+
+  This function returns the session state of the connection, so that a later
+  connection to the same server can resume the session with
+  TlsSetResumptionData().
+
+  @param[in]      Tls             Pointer to the TLS object.
+  @param[out]     Data            Buffer to contain the returned session state.
+  @param[in,out]  DataSize        On input, the size of Data in bytes. On output,
+                                  the size of the session state in bytes.
+
+  @retval  EFI_SUCCESS           The session state was returned successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_NOT_FOUND         The session cannot be resumed.
+  @retval  EFI_BUFFER_TOO_SMALL  The Data is too small to hold the session state.
+                                 DataSize is updated with the required size.
+  @retval  EFI_ABORTED           The session state could not be returned.
+
+**/
+EFI_STATUS
+EFIAPI
+CryptoServiceTlsGetResumptionData (
+  IN     VOID   *Tls,
+  OUT    VOID   *Data,
+  IN OUT UINTN  *DataSize
+  )
+{
+  return CALL_BASECRYPTLIB (TlsGet.Services.ResumptionData, TlsGetResumptionData, (Tls, Data, DataSize), EFI_UNSUPPORTED);
+}
+
 /**
   Carries out the RSA-SSA signature generation with EMSA-PSS encoding scheme.
 
@@ -7116,4 +7243,10 @@ const EDKII_CRYPTO_PROTOCOL  mEdkiiCrypto = {
   CryptoServicePkcs1v2Decrypt,
   CryptoServiceRsaOaepEncrypt,
   CryptoServiceRsaOaepDecrypt,
+  /// Multi-buffer SHA-256 and SHA-384
+  CryptoServiceSha256HashAllMultiBuffer,
+  CryptoServiceSha384HashAllMultiBuffer,
+  /// TLS session resumption
+  CryptoServiceTlsSetResumptionData,
+  CryptoServiceTlsGetResumptionData,
 };
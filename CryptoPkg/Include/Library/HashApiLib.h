@@ -107,4 +107,28 @@ HashApiHashAll (
   OUT UINT8       *Digest
   );
 
+/**
+  Computes hash message digests of several independent input data buffers.
+
+  The digest of DataToHash[Index] is placed at offset Index times the digest
+  size of the policy algorithm in Digests. For SHA-256 and SHA-384 several
+  buffers are hashed at the same time where the CPU allows it.
+
+  @param[in]  DataToHash     Array of DataCount pointers to the data to be hashed.
+  @param[in]  DataToHashLen  Array of DataCount data sizes.
+  @param[in]  DataCount      Number of buffers to hash.
+  @param[out] Digests        Hash Digests, one after another.
+
+  @retval TRUE   Hash digest computation succeeded.
+  @retval FALSE  Hash digest computation failed.
+**/
+BOOLEAN
+EFIAPI
+HashApiHashAllMultiBuffer (
+  IN  CONST VOID   *CONST  *DataToHash,
+  IN  CONST UINTN          *DataToHashLen,
+  IN  UINTN                DataCount,
+  OUT UINT8                *Digests
+  );
+
 #endif
@@ -178,23 +178,25 @@ typedef struct {
   } Sha1;
   union {
     struct {
-      UINT8    GetContextSize : 1;
-      UINT8    Init           : 1;
-      UINT8    Duplicate      : 1;
-      UINT8    Update         : 1;
-      UINT8    Final          : 1;
-      UINT8    HashAll        : 1;
+      UINT8    GetContextSize     : 1;
+      UINT8    Init               : 1;
+      UINT8    Duplicate          : 1;
+      UINT8    Update             : 1;
+      UINT8    Final              : 1;
+      UINT8    HashAll            : 1;
+      UINT8    HashAllMultiBuffer : 1;
     } Services;
     UINT32    Family;
   } Sha256;
   union {
     struct {
-      UINT8    GetContextSize : 1;
-      UINT8    Init           : 1;
-      UINT8    Duplicate      : 1;
-      UINT8    Update         : 1;
-      UINT8    Final          : 1;
-      UINT8    HashAll        : 1;
+      UINT8    GetContextSize     : 1;
+      UINT8    Init               : 1;
+      UINT8    Duplicate          : 1;
+      UINT8    Update             : 1;
+      UINT8    Final              : 1;
+      UINT8    HashAll            : 1;
+      UINT8    HashAllMultiBuffer : 1;
     } Services;
     UINT32    Family;
   } Sha384;
@@ -327,6 +329,7 @@ typedef struct {
       UINT8    HostPrivateKeyEx   : 1;
       UINT8    SignatureAlgoList  : 1;
       UINT8    EcCurve            : 1;
+      UINT8    ResumptionData     : 1;
     } Services;
     UINT32    Family;
   } TlsSet;
@@ -346,6 +349,7 @@ typedef struct {
       UINT8    HostPrivateKey       : 1;
       UINT8    CertRevocationList   : 1;
       UINT8    ExportKey            : 1;
+      UINT8    ResumptionData       : 1;
     } Services;
     UINT32    Family;
   } TlsGet;
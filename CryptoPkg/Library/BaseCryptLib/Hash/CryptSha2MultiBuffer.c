@@ -0,0 +1,500 @@
+/** @file
+  Multi-buffer SHA-256 and SHA-384 Digest Implementation.
+
+  Every lane of a kernel hashes one message. A message is split into its whole
+  blocks, hashed in place, and one or two padding blocks that are built in the
+  lane. Each kernel call runs all lanes over as many blocks as the lane with
+  the fewest blocks left in its current part has, so lanes never need to be
+  compressed one by one. A lane that finishes its message writes the digest
+  and picks up the next message, and lanes without a message recompute the
+  blocks of a busy lane into their own, ignored, state.
+
+  When the CPU cannot run any lane kernel the messages are hashed one by one
+  with Sha256HashAll() or Sha384HashAll().
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "CryptSha2MultiBuffer.h"
+
+typedef struct {
+  UINTN                        BlockSize;
+  ///
+  /// Size of a state word, 4 for SHA-256 and 8 for SHA-512.
+  ///
+  UINTN                        WordSize;
+  UINTN                        DigestSize;
+  CONST VOID                   *InitialState;
+  ///
+  /// The kernel that matches WordSize, the other one is NULL.
+  ///
+  SHA256_MULTI_BLOCK_KERNEL    Sha256Kernel;
+  SHA512_MULTI_BLOCK_KERNEL    Sha512Kernel;
+  UINTN                        Lanes;
+  BOOLEAN                      Wide;
+} SHA2_MULTI_BUFFER_ALGORITHM;
+
+typedef struct {
+  ///
+  /// Next block of the part of the message that is being hashed.
+  ///
+  CONST UINT8    *Data;
+  ///
+  /// Blocks left in the part of the message that is being hashed.
+  ///
+  UINTN          BlockCount;
+  ///
+  /// Index of the message, valid if Busy is TRUE.
+  ///
+  UINTN          Message;
+  BOOLEAN        Busy;
+  ///
+  /// TRUE once the whole blocks are done and the padding blocks are hashed.
+  ///
+  BOOLEAN        Padding;
+  UINT8          *PadBlocks;
+  UINTN          PadBlockCount;
+} SHA2_MULTI_BUFFER_LANE;
+
+typedef struct {
+  CONST SHA2_MULTI_BUFFER_ALGORITHM    *Algorithm;
+  CONST VOID *CONST                    *Data;
+  CONST UINTN                          *DataSize;
+  UINTN                                DataCount;
+  UINT8                                *HashValues;
+  UINTN                                NextMessage;
+  SHA2_MULTI_BUFFER_LANE               Lanes[SHA2_MULTI_BUFFER_MAX_LANES];
+  ///
+  /// Eight state words of every lane, lane after lane.
+  ///
+  UINT64                               State[SHA2_MULTI_BUFFER_MAX_LANES * 8];
+  ///
+  /// Room for two padding blocks of every lane.
+  ///
+  UINT8                                PadBlocks[2 * SHA2_MULTI_BUFFER_MAX_LANE_BYTES];
+} SHA2_MULTI_BUFFER_CONTEXT;
+
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT32  mSha256InitialState[8] = {
+  0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+  0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT64  mSha384InitialState[8] = {
+  0xcbbb9d5dc1059ed8ULL, 0x629a292a367cd507ULL, 0x9159015a3070dd17ULL, 0x152fecd8f70e5939ULL,
+  0x67332667ffc00b31ULL, 0x8eb44a8768581511ULL, 0xdb0c2e0d64f98fa7ULL, 0x47b5481dbefa4fa4ULL
+};
+
+/**
+  Check the parameters of a multi-buffer hash call.
+
+  @param[in]  Data        Array of DataCount pointers to the buffers.
+  @param[in]  DataSize    Array of DataCount sizes of the buffers.
+  @param[in]  DataCount   Number of buffers.
+  @param[in]  HashValues  Buffer that receives the digests.
+
+  @retval TRUE   The parameters are valid.
+  @retval FALSE  The parameters are not valid.
+**/
+STATIC
+BOOLEAN
+Sha2MultiBufferCheckParameters (
+  IN CONST VOID   *CONST  *Data,
+  IN CONST UINTN          *DataSize,
+  IN UINTN                DataCount,
+  IN UINT8                *HashValues
+  )
+{
+  UINTN  Index;
+
+  if (HashValues == NULL) {
+    return FALSE;
+  }
+
+  if (DataCount == 0) {
+    return TRUE;
+  }
+
+  if ((Data == NULL) || (DataSize == NULL)) {
+    return FALSE;
+  }
+
+  for (Index = 0; Index < DataCount; Index++) {
+    if ((Data[Index] == NULL) && (DataSize[Index] != 0)) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Build the padding blocks of a message in its lane.
+
+  @param[in]  Algorithm  The algorithm.
+  @param[in]  Data       The message.
+  @param[in]  DataSize   The size of the message in bytes.
+  @param[out] Lane       The lane. PadBlocks must point to room for two blocks.
+**/
+STATIC
+VOID
+Sha2MultiBufferBuildPadding (
+  IN     CONST SHA2_MULTI_BUFFER_ALGORITHM  *Algorithm,
+  IN     CONST UINT8                        *Data,
+  IN     UINTN                              DataSize,
+  IN OUT SHA2_MULTI_BUFFER_LANE             *Lane
+  )
+{
+  UINTN   Tail;
+  UINTN   LengthSize;
+  UINTN   PadSize;
+  UINT64  BitCount;
+  UINTN   Index;
+
+  //
+  // The message length in bits is stored big endian in the last 8 bytes for
+  // SHA-256 and the last 16 bytes for SHA-512. Only the low 64 bits and the
+  // 3 bits shifted out of them can be non-zero.
+  //
+  LengthSize = 2 * Algorithm->WordSize;
+  Tail       = DataSize % Algorithm->BlockSize;
+  if (Tail + 1 + LengthSize <= Algorithm->BlockSize) {
+    Lane->PadBlockCount = 1;
+  } else {
+    Lane->PadBlockCount = 2;
+  }
+
+  PadSize = Lane->PadBlockCount * Algorithm->BlockSize;
+  if (Tail != 0) {
+    CopyMem (Lane->PadBlocks, Data + DataSize - Tail, Tail);
+  }
+
+  ZeroMem (Lane->PadBlocks + Tail, PadSize - Tail);
+  Lane->PadBlocks[Tail] = 0x80;
+
+  BitCount = LShiftU64 ((UINT64)DataSize, 3);
+  for (Index = 0; Index < sizeof (UINT64); Index++) {
+    Lane->PadBlocks[PadSize - 1 - Index] = (UINT8)RShiftU64 (BitCount, 8 * Index);
+  }
+
+  if (LengthSize > sizeof (UINT64)) {
+    Lane->PadBlocks[PadSize - 1 - sizeof (UINT64)] = (UINT8)RShiftU64 ((UINT64)DataSize, 61);
+  }
+}
+
+/**
+  Start the next message that no lane has taken yet on a lane.
+
+  @param[in,out] Context  The multi-buffer context.
+  @param[in]     Index    The index of the lane.
+**/
+STATIC
+VOID
+Sha2MultiBufferStartLane (
+  IN OUT SHA2_MULTI_BUFFER_CONTEXT  *Context,
+  IN     UINTN                      Index
+  )
+{
+  CONST SHA2_MULTI_BUFFER_ALGORITHM  *Algorithm;
+  SHA2_MULTI_BUFFER_LANE             *Lane;
+  CONST UINT8                        *Data;
+  UINTN                              DataSize;
+
+  Algorithm = Context->Algorithm;
+  Lane      = &Context->Lanes[Index];
+
+  if (Context->NextMessage == Context->DataCount) {
+    Lane->Busy = FALSE;
+    return;
+  }
+
+  Lane->Message = Context->NextMessage++;
+  Lane->Busy    = TRUE;
+  Data          = Context->Data[Lane->Message];
+  DataSize      = Context->DataSize[Lane->Message];
+
+  CopyMem (
+    (UINT8 *)Context->State + Index * 8 * Algorithm->WordSize,
+    Algorithm->InitialState,
+    8 * Algorithm->WordSize
+    );
+  Sha2MultiBufferBuildPadding (Algorithm, Data, DataSize, Lane);
+
+  Lane->Data       = Data;
+  Lane->BlockCount = DataSize / Algorithm->BlockSize;
+  Lane->Padding    = FALSE;
+  if (Lane->BlockCount == 0) {
+    Lane->Data       = Lane->PadBlocks;
+    Lane->BlockCount = Lane->PadBlockCount;
+    Lane->Padding    = TRUE;
+  }
+}
+
+/**
+  Write the digest of the message of a lane in big endian order.
+
+  @param[in] Context  The multi-buffer context.
+  @param[in] Index    The index of the lane.
+**/
+STATIC
+VOID
+Sha2MultiBufferWriteDigest (
+  IN CONST SHA2_MULTI_BUFFER_CONTEXT  *Context,
+  IN UINTN                            Index
+  )
+{
+  CONST SHA2_MULTI_BUFFER_ALGORITHM  *Algorithm;
+  UINT8                              *Digest;
+  UINTN                              Word;
+
+  Algorithm = Context->Algorithm;
+  Digest    = Context->HashValues + Context->Lanes[Index].Message * Algorithm->DigestSize;
+
+  for (Word = 0; Word < Algorithm->DigestSize / Algorithm->WordSize; Word++) {
+    if (Algorithm->WordSize == sizeof (UINT32)) {
+      WriteUnaligned32 (
+        (UINT32 *)Digest + Word,
+        SwapBytes32 (((CONST UINT32 *)Context->State)[Index * 8 + Word])
+        );
+    } else {
+      WriteUnaligned64 (
+        (UINT64 *)Digest + Word,
+        SwapBytes64 (Context->State[Index * 8 + Word])
+        );
+    }
+  }
+}
+
+/**
+  Hash messages with a lane kernel.
+
+  @param[in]  Algorithm   The algorithm and its kernel.
+  @param[in]  Data        Array of DataCount pointers to the buffers.
+  @param[in]  DataSize    Array of DataCount sizes of the buffers.
+  @param[in]  DataCount   Number of buffers.
+  @param[out] HashValues  Buffer that receives the digests.
+**/
+STATIC
+VOID
+Sha2MultiBufferRun (
+  IN  CONST SHA2_MULTI_BUFFER_ALGORITHM  *Algorithm,
+  IN  CONST VOID   *CONST                *Data,
+  IN  CONST UINTN                        *DataSize,
+  IN  UINTN                              DataCount,
+  OUT UINT8                              *HashValues
+  )
+{
+  SHA2_MULTI_BUFFER_CONTEXT  *Context;
+  SHA2_MULTI_BUFFER_CONTEXT  LocalContext;
+  SHA2_MULTI_BUFFER_LANE     *Lane;
+  CONST UINT8                *Blocks[SHA2_MULTI_BUFFER_MAX_LANES];
+  CONST UINT8                *BusyData;
+  UINTN                      BlockCount;
+  UINTN                      Index;
+  BOOLEAN                    InterruptState;
+
+  ASSERT (Algorithm->Lanes <= SHA2_MULTI_BUFFER_MAX_LANES);
+  ASSERT (Algorithm->Lanes * Algorithm->BlockSize <= SHA2_MULTI_BUFFER_MAX_LANE_BYTES);
+
+  InterruptState       = FALSE;
+  Context              = &LocalContext;
+  Context->Algorithm   = Algorithm;
+  Context->Data        = Data;
+  Context->DataSize    = DataSize;
+  Context->DataCount   = DataCount;
+  Context->HashValues  = HashValues;
+  Context->NextMessage = 0;
+
+  for (Index = 0; Index < Algorithm->Lanes; Index++) {
+    Context->Lanes[Index].PadBlocks = Context->PadBlocks + Index * 2 * Algorithm->BlockSize;
+    Sha2MultiBufferStartLane (Context, Index);
+  }
+
+  while (TRUE) {
+    BlockCount = SHA2_MULTI_BUFFER_MAX_BLOCKS;
+    BusyData   = NULL;
+    for (Index = 0; Index < Algorithm->Lanes; Index++) {
+      Lane = &Context->Lanes[Index];
+      if (Lane->Busy) {
+        BlockCount = MIN (BlockCount, Lane->BlockCount);
+        BusyData   = Lane->Data;
+      }
+    }
+
+    if (BusyData == NULL) {
+      break;
+    }
+
+    for (Index = 0; Index < Algorithm->Lanes; Index++) {
+      Lane          = &Context->Lanes[Index];
+      Blocks[Index] = Lane->Busy ? Lane->Data : BusyData;
+    }
+
+    if (Algorithm->Wide) {
+      InterruptState = SaveAndDisableInterrupts ();
+    }
+
+    if (Algorithm->Sha256Kernel != NULL) {
+      Algorithm->Sha256Kernel ((UINT32 *)Context->State, Blocks, BlockCount);
+    } else {
+      Algorithm->Sha512Kernel (Context->State, Blocks, BlockCount);
+    }
+
+    if (Algorithm->Wide) {
+      SetInterruptState (InterruptState);
+    }
+
+    for (Index = 0; Index < Algorithm->Lanes; Index++) {
+      Lane = &Context->Lanes[Index];
+      if (!Lane->Busy) {
+        continue;
+      }
+
+      Lane->Data       += BlockCount * Algorithm->BlockSize;
+      Lane->BlockCount -= BlockCount;
+      if (Lane->BlockCount != 0) {
+        continue;
+      }
+
+      if (!Lane->Padding) {
+        Lane->Data       = Lane->PadBlocks;
+        Lane->BlockCount = Lane->PadBlockCount;
+        Lane->Padding    = TRUE;
+        continue;
+      }
+
+      Sha2MultiBufferWriteDigest (Context, Index);
+      Sha2MultiBufferStartLane (Context, Index);
+    }
+  }
+
+  //
+  // Do not leave message data behind on the stack.
+  //
+  ZeroMem (Context, sizeof (*Context));
+}
+
+/**
+  Computes the SHA-256 message digests of several independent input data buffers.
+
+  This function performs the SHA-256 message digest of each of the DataCount
+  buffers, and places the digest of Data[Index] at offset Index * 32 of
+  HashValues. Where the CPU provides it, several buffers are hashed at the same
+  time, which is faster than calling Sha256HashAll() once per buffer.
+
+  If this interface is not supported, then return FALSE.
+
+  @param[in]   Data        Array of DataCount pointers to the buffers containing
+                           the data to be hashed.
+  @param[in]   DataSize    Array of DataCount sizes of the Data buffers in bytes.
+  @param[in]   DataCount   Number of buffers to hash.
+  @param[out]  HashValues  Pointer to a buffer that receives the DataCount SHA-256
+                           digest values (32 bytes each).
+
+  @retval TRUE   SHA-256 digest computation succeeded.
+  @retval FALSE  SHA-256 digest computation failed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+Sha256HashAllMultiBuffer (
+  IN   CONST VOID   *CONST  *Data,
+  IN   CONST UINTN          *DataSize,
+  IN   UINTN                DataCount,
+  OUT  UINT8                *HashValues
+  )
+{
+  SHA2_MULTI_BUFFER_KERNELS    Kernels;
+  SHA2_MULTI_BUFFER_ALGORITHM  Algorithm;
+  UINTN                        Index;
+
+  if (!Sha2MultiBufferCheckParameters (Data, DataSize, DataCount, HashValues)) {
+    return FALSE;
+  }
+
+  Sha2MultiBufferGetKernels (&Kernels);
+  if ((Kernels.Sha256Kernel == NULL) || (DataCount < 2)) {
+    for (Index = 0; Index < DataCount; Index++) {
+      if (!Sha256HashAll (Data[Index], DataSize[Index], HashValues + Index * SHA256_DIGEST_SIZE)) {
+        return FALSE;
+      }
+    }
+
+    return TRUE;
+  }
+
+  Algorithm.BlockSize    = 64;
+  Algorithm.WordSize     = sizeof (UINT32);
+  Algorithm.DigestSize   = SHA256_DIGEST_SIZE;
+  Algorithm.InitialState = mSha256InitialState;
+  Algorithm.Sha256Kernel = Kernels.Sha256Kernel;
+  Algorithm.Sha512Kernel = NULL;
+  Algorithm.Lanes        = Kernels.Sha256Lanes;
+  Algorithm.Wide         = Kernels.Sha256Wide;
+  Sha2MultiBufferRun (&Algorithm, Data, DataSize, DataCount, HashValues);
+  return TRUE;
+}
+
+/**
+  Computes the SHA-384 message digests of several independent input data buffers.
+
+  This function performs the SHA-384 message digest of each of the DataCount
+  buffers, and places the digest of Data[Index] at offset Index * 48 of
+  HashValues. Where the CPU provides it, several buffers are hashed at the same
+  time, which is faster than calling Sha384HashAll() once per buffer.
+
+  If this interface is not supported, then return FALSE.
+
+  @param[in]   Data        Array of DataCount pointers to the buffers containing
+                           the data to be hashed.
+  @param[in]   DataSize    Array of DataCount sizes of the Data buffers in bytes.
+  @param[in]   DataCount   Number of buffers to hash.
+  @param[out]  HashValues  Pointer to a buffer that receives the DataCount SHA-384
+                           digest values (48 bytes each).
+
+  @retval TRUE   SHA-384 digest computation succeeded.
+  @retval FALSE  SHA-384 digest computation failed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+Sha384HashAllMultiBuffer (
+  IN   CONST VOID   *CONST  *Data,
+  IN   CONST UINTN          *DataSize,
+  IN   UINTN                DataCount,
+  OUT  UINT8                *HashValues
+  )
+{
+  SHA2_MULTI_BUFFER_KERNELS    Kernels;
+  SHA2_MULTI_BUFFER_ALGORITHM  Algorithm;
+  UINTN                        Index;
+
+  if (!Sha2MultiBufferCheckParameters (Data, DataSize, DataCount, HashValues)) {
+    return FALSE;
+  }
+
+  Sha2MultiBufferGetKernels (&Kernels);
+  if ((Kernels.Sha512Kernel == NULL) || (DataCount < 2)) {
+    for (Index = 0; Index < DataCount; Index++) {
+      if (!Sha384HashAll (Data[Index], DataSize[Index], HashValues + Index * SHA384_DIGEST_SIZE)) {
+        return FALSE;
+      }
+    }
+
+    return TRUE;
+  }
+
+  Algorithm.BlockSize    = 128;
+  Algorithm.WordSize     = sizeof (UINT64);
+  Algorithm.DigestSize   = SHA384_DIGEST_SIZE;
+  Algorithm.InitialState = mSha384InitialState;
+  Algorithm.Sha256Kernel = NULL;
+  Algorithm.Sha512Kernel = Kernels.Sha512Kernel;
+  Algorithm.Lanes        = Kernels.Sha512Lanes;
+  Algorithm.Wide         = Kernels.Sha512Wide;
+  Sha2MultiBufferRun (&Algorithm, Data, DataSize, DataCount, HashValues);
+  return TRUE;
+}
@@ -0,0 +1,113 @@
+/** @file
+  Internal definitions of the multi-buffer SHA-256 and SHA-384 implementation.
+
+  A lane kernel runs the SHA-256 or SHA-512 compression function over the same
+  number of blocks of several independent messages at once. The architecture
+  specific part of the library reports which kernels the CPU can run, the
+  common part schedules the messages over the lanes and does the padding.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef CRYPT_SHA2_MULTI_BUFFER_H_
+#define CRYPT_SHA2_MULTI_BUFFER_H_
+
+#include "InternalCryptLib.h"
+
+///
+/// Largest number of lanes of any kernel.
+///
+#define SHA2_MULTI_BUFFER_MAX_LANES  8
+
+///
+/// Largest product of the number of lanes and the block size of any kernel.
+///
+#define SHA2_MULTI_BUFFER_MAX_LANE_BYTES  512
+
+///
+/// Largest number of blocks passed to one kernel call. Kernels that use YMM
+/// registers run with interrupts disabled, this bounds the time they do.
+///
+#define SHA2_MULTI_BUFFER_MAX_BLOCKS  64
+
+/**
+  Run the SHA-256 compression function over the blocks of every lane.
+
+  @param[in,out] State       The eight state words of each lane, lane after lane.
+  @param[in]     Blocks      The address of the first 64-byte block of each lane.
+  @param[in]     BlockCount  The number of blocks of each lane, must not be 0.
+**/
+typedef
+VOID
+(EFIAPI *SHA256_MULTI_BLOCK_KERNEL)(
+  IN OUT UINT32       *State,
+  IN     CONST UINT8  **Blocks,
+  IN     UINTN        BlockCount
+  );
+
+/**
+  Run the SHA-512 compression function over the blocks of every lane.
+
+  @param[in,out] State       The eight state words of each lane, lane after lane.
+  @param[in]     Blocks      The address of the first 128-byte block of each lane.
+  @param[in]     BlockCount  The number of blocks of each lane, must not be 0.
+**/
+typedef
+VOID
+(EFIAPI *SHA512_MULTI_BLOCK_KERNEL)(
+  IN OUT UINT64       *State,
+  IN     CONST UINT8  **Blocks,
+  IN     UINTN        BlockCount
+  );
+
+typedef struct {
+  ///
+  /// NULL if the CPU cannot run any SHA-256 lane kernel.
+  ///
+  SHA256_MULTI_BLOCK_KERNEL    Sha256Kernel;
+  UINTN                        Sha256Lanes;
+  ///
+  /// TRUE if Sha256Kernel uses YMM registers.
+  ///
+  BOOLEAN                      Sha256Wide;
+  ///
+  /// NULL if the CPU cannot run any SHA-512 lane kernel.
+  ///
+  SHA512_MULTI_BLOCK_KERNEL    Sha512Kernel;
+  UINTN                        Sha512Lanes;
+  BOOLEAN                      Sha512Wide;
+} SHA2_MULTI_BUFFER_KERNELS;
+
+///
+/// CPU features reported by Sha2MultiBufferGetCpuFeatures().
+///
+#define SHA2_MULTI_BUFFER_CPU_SHA_NI  BIT0
+#define SHA2_MULTI_BUFFER_CPU_AVX2    BIT1
+
+/**
+  Return the CPU features that the lane kernels can use.
+
+  AVX2 is only reported when the OS, or the firmware, has enabled the YMM
+  register state in XCR0.
+
+  @return A combination of SHA2_MULTI_BUFFER_CPU_* bits.
+**/
+UINT32
+Sha2MultiBufferGetCpuFeatures (
+  VOID
+  );
+
+/**
+  Return the lane kernels that the CPU can run.
+
+  @param[out] Kernels  The kernels. A kernel is NULL when the CPU cannot run
+                       any kernel of that kind.
+**/
+VOID
+Sha2MultiBufferGetKernels (
+  OUT SHA2_MULTI_BUFFER_KERNELS  *Kernels
+  );
+
+#endif
@@ -0,0 +1,24 @@
+/** @file
+  Lane kernel selection of the multi-buffer SHA-256 and SHA-384 implementation
+  for architectures and module types without lane kernels.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "CryptSha2MultiBuffer.h"
+
+/**
+  Return the lane kernels that the CPU can run.
+
+  @param[out] Kernels  The kernels. A kernel is NULL when the CPU cannot run
+                       any kernel of that kind.
+**/
+VOID
+Sha2MultiBufferGetKernels (
+  OUT SHA2_MULTI_BUFFER_KERNELS  *Kernels
+  )
+{
+  ZeroMem (Kernels, sizeof (*Kernels));
+}
@@ -0,0 +1,64 @@
+/** @file
+  CPU feature detection of the multi-buffer SHA-256 and SHA-384 implementation
+  for X64.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "../CryptSha2MultiBuffer.h"
+
+#include <Register/Intel/Cpuid.h>
+
+///
+/// XCR0 bits of the SSE and AVX state.
+///
+#define SHA2_MULTI_BUFFER_XCR0_AVX  (BIT1 | BIT2)
+
+/**
+  Return the CPU features that the lane kernels can use.
+
+  AVX2 is only reported when the OS, or the firmware, has enabled the YMM
+  register state in XCR0.
+
+  @return A combination of SHA2_MULTI_BUFFER_CPU_* bits.
+**/
+UINT32
+Sha2MultiBufferGetCpuFeatures (
+  VOID
+  )
+{
+  UINT32                                       MaxLeaf;
+  CPUID_VERSION_INFO_ECX                       VersionEcx;
+  CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS_EBX  ExtendedEbx;
+  UINT32                                       Features;
+
+  AsmCpuid (CPUID_SIGNATURE, &MaxLeaf, NULL, NULL, NULL);
+  if (MaxLeaf < CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS) {
+    return 0;
+  }
+
+  AsmCpuid (CPUID_VERSION_INFO, NULL, NULL, &VersionEcx.Uint32, NULL);
+  AsmCpuidEx (
+    CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS,
+    CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS_SUB_LEAF_INFO,
+    NULL,
+    &ExtendedEbx.Uint32,
+    NULL,
+    NULL
+    );
+
+  Features = 0;
+  if ((ExtendedEbx.Bits.SHA != 0) && (VersionEcx.Bits.SSSE3 != 0) && (VersionEcx.Bits.SSE4_1 != 0)) {
+    Features |= SHA2_MULTI_BUFFER_CPU_SHA_NI;
+  }
+
+  if ((VersionEcx.Bits.OSXSAVE != 0) && (VersionEcx.Bits.AVX != 0) && (ExtendedEbx.Bits.AVX2 != 0)) {
+    if ((AsmXGetBv (0) & SHA2_MULTI_BUFFER_XCR0_AVX) == SHA2_MULTI_BUFFER_XCR0_AVX) {
+      Features |= SHA2_MULTI_BUFFER_CPU_AVX2;
+    }
+  }
+
+  return Features;
+}
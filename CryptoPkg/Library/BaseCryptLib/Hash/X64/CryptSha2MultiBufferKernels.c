@@ -0,0 +1,97 @@
+/** @file
+  Lane kernel selection of the multi-buffer SHA-256 and SHA-384 implementation
+  for X64.
+
+  SHA-256 prefers the two-lane SHA-NI kernel, which is faster per message than
+  eight AVX2 lanes on CPUs that have both. SHA-512 has no SHA-NI counterpart
+  here and uses the four-lane AVX2 kernel.
+
+  Interrupt and exception handlers in firmware only save the FXSAVE state, so
+  the AVX2 kernels are reported as wide and run with interrupts disabled.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "../CryptSha2MultiBuffer.h"
+
+/**
+  Run the SHA-256 compression function over the blocks of two lanes with the
+  SHA extensions.
+
+  @param[in,out] State       The eight state words of each lane, lane after lane.
+  @param[in]     Blocks      The address of the first 64-byte block of each lane.
+  @param[in]     BlockCount  The number of blocks of each lane, must not be 0.
+**/
+VOID
+EFIAPI
+InternalSha256MultiBlockShaNi (
+  IN OUT UINT32       *State,
+  IN     CONST UINT8  **Blocks,
+  IN     UINTN        BlockCount
+  );
+
+/**
+  Run the SHA-256 compression function over the blocks of eight lanes with
+  AVX2.
+
+  @param[in,out] State       The eight state words of each lane, lane after lane.
+  @param[in]     Blocks      The address of the first 64-byte block of each lane.
+  @param[in]     BlockCount  The number of blocks of each lane, must not be 0.
+**/
+VOID
+EFIAPI
+InternalSha256MultiBlockAvx2 (
+  IN OUT UINT32       *State,
+  IN     CONST UINT8  **Blocks,
+  IN     UINTN        BlockCount
+  );
+
+/**
+  Run the SHA-512 compression function over the blocks of four lanes with
+  AVX2.
+
+  @param[in,out] State       The eight state words of each lane, lane after lane.
+  @param[in]     Blocks      The address of the first 128-byte block of each lane.
+  @param[in]     BlockCount  The number of blocks of each lane, must not be 0.
+**/
+VOID
+EFIAPI
+InternalSha512MultiBlockAvx2 (
+  IN OUT UINT64       *State,
+  IN     CONST UINT8  **Blocks,
+  IN     UINTN        BlockCount
+  );
+
+/**
+  Return the lane kernels that the CPU can run.
+
+  @param[out] Kernels  The kernels. A kernel is NULL when the CPU cannot run
+                       any kernel of that kind.
+**/
+VOID
+Sha2MultiBufferGetKernels (
+  OUT SHA2_MULTI_BUFFER_KERNELS  *Kernels
+  )
+{
+  UINT32  Features;
+
+  ZeroMem (Kernels, sizeof (*Kernels));
+  Features = Sha2MultiBufferGetCpuFeatures ();
+
+  if ((Features & SHA2_MULTI_BUFFER_CPU_SHA_NI) != 0) {
+    Kernels->Sha256Kernel = InternalSha256MultiBlockShaNi;
+    Kernels->Sha256Lanes  = 2;
+  } else if ((Features & SHA2_MULTI_BUFFER_CPU_AVX2) != 0) {
+    Kernels->Sha256Kernel = InternalSha256MultiBlockAvx2;
+    Kernels->Sha256Lanes  = 8;
+    Kernels->Sha256Wide   = TRUE;
+  }
+
+  if ((Features & SHA2_MULTI_BUFFER_CPU_AVX2) != 0) {
+    Kernels->Sha512Kernel = InternalSha512MultiBlockAvx2;
+    Kernels->Sha512Lanes  = 4;
+    Kernels->Sha512Wide   = TRUE;
+  }
+}
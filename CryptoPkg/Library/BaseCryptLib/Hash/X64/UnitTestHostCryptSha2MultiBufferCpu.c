@@ -0,0 +1,121 @@
+/** @file
+  CPU feature detection of the multi-buffer SHA-256 and SHA-384 implementation
+  for host based unit tests on X64.
+
+  The CPUID and XGETBV functions of the host BaseLib do not report the features
+  of the host, so the compiler intrinsics are used instead. This keeps the lane
+  kernels covered by the host tests. The tests can also hide features to force
+  the other kernels, or none, on hosts that have them.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#if defined (_MSC_VER)
+  #include <intrin.h>
+#else
+  #include <cpuid.h>
+#endif
+
+#include "../CryptSha2MultiBuffer.h"
+
+#include <Register/Intel/Cpuid.h>
+
+#define SHA2_MULTI_BUFFER_XCR0_AVX  (BIT1 | BIT2)
+
+///
+/// The SHA2_MULTI_BUFFER_CPU_* bits that Sha2MultiBufferGetCpuFeatures() may
+/// report. Host based unit tests clear bits to hide features of the host.
+///
+UINT32  gSha2MultiBufferHostCpuFeatureMask = MAX_UINT32;
+
+/**
+  Execute CPUID on the host.
+
+  @param[in]  Leaf       The CPUID leaf.
+  @param[in]  SubLeaf    The CPUID sub-leaf.
+  @param[out] Registers  EAX, EBX, ECX and EDX returned by CPUID.
+**/
+STATIC
+VOID
+HostCpuid (
+  IN  UINT32  Leaf,
+  IN  UINT32  SubLeaf,
+  OUT UINT32  Registers[4]
+  )
+{
+ #if defined (_MSC_VER)
+  __cpuidex ((int *)Registers, (int)Leaf, (int)SubLeaf);
+ #else
+  __cpuid_count (Leaf, SubLeaf, Registers[0], Registers[1], Registers[2], Registers[3]);
+ #endif
+}
+
+/**
+  Read XCR0 on the host. Must only be called when OSXSAVE is reported.
+
+  @return The value of XCR0.
+**/
+STATIC
+UINT64
+HostReadXcr0 (
+  VOID
+  )
+{
+ #if defined (_MSC_VER)
+  return _xgetbv (0);
+ #else
+  UINT32  Low;
+  UINT32  High;
+
+  __asm__ __volatile__ ("xgetbv" : "=a" (Low), "=d" (High) : "c" (0));
+  return LShiftU64 (High, 32) | Low;
+ #endif
+}
+
+/**
+  Return the CPU features that the lane kernels can use.
+
+  AVX2 is only reported when the OS has enabled the YMM register state in
+  XCR0. Features cleared in gSha2MultiBufferHostCpuFeatureMask are not reported.
+
+  @return A combination of SHA2_MULTI_BUFFER_CPU_* bits.
+**/
+UINT32
+Sha2MultiBufferGetCpuFeatures (
+  VOID
+  )
+{
+  UINT32                                       Registers[4];
+  CPUID_VERSION_INFO_ECX                       VersionEcx;
+  CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS_EBX  ExtendedEbx;
+  UINT32                                       Features;
+
+  HostCpuid (CPUID_SIGNATURE, 0, Registers);
+  if (Registers[0] < CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS) {
+    return 0;
+  }
+
+  HostCpuid (CPUID_VERSION_INFO, 0, Registers);
+  VersionEcx.Uint32 = Registers[2];
+  HostCpuid (
+    CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS,
+    CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS_SUB_LEAF_INFO,
+    Registers
+    );
+  ExtendedEbx.Uint32 = Registers[1];
+
+  Features = 0;
+  if ((ExtendedEbx.Bits.SHA != 0) && (VersionEcx.Bits.SSSE3 != 0) && (VersionEcx.Bits.SSE4_1 != 0)) {
+    Features |= SHA2_MULTI_BUFFER_CPU_SHA_NI;
+  }
+
+  if ((VersionEcx.Bits.OSXSAVE != 0) && (VersionEcx.Bits.AVX != 0) && (ExtendedEbx.Bits.AVX2 != 0)) {
+    if ((HostReadXcr0 () & SHA2_MULTI_BUFFER_XCR0_AVX) == SHA2_MULTI_BUFFER_XCR0_AVX) {
+      Features |= SHA2_MULTI_BUFFER_CPU_AVX2;
+    }
+  }
+
+  return Features & gSha2MultiBufferHostCpuFeatureMask;
+}
@@ -0,0 +1,79 @@
+/** @file
+  Multi-buffer SHA-256 and SHA-384 Digest Null Implementation.
+
+Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "InternalCryptLib.h"
+
+/**
+  Computes the SHA-256 message digests of several independent input data buffers.
+
+  This function performs the SHA-256 message digest of each of the DataCount
+  buffers, and places the digest of Data[Index] at offset Index * 32 of
+  HashValues. Where the CPU provides it, several buffers are hashed at the same
+  time, which is faster than calling Sha256HashAll() once per buffer.
+
+  If this interface is not supported, then return FALSE.
+
+  @param[in]   Data        Array of DataCount pointers to the buffers containing
+                           the data to be hashed.
+  @param[in]   DataSize    Array of DataCount sizes of the Data buffers in bytes.
+  @param[in]   DataCount   Number of buffers to hash.
+  @param[out]  HashValues  Pointer to a buffer that receives the DataCount SHA-256
+                           digest values (32 bytes each).
+
+  @retval TRUE   SHA-256 digest computation succeeded.
+  @retval FALSE  SHA-256 digest computation failed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+Sha256HashAllMultiBuffer (
+  IN   CONST VOID   *CONST  *Data,
+  IN   CONST UINTN          *DataSize,
+  IN   UINTN                DataCount,
+  OUT  UINT8                *HashValues
+  )
+{
+  ASSERT (FALSE);
+  return FALSE;
+}
+
+/**
+  Computes the SHA-384 message digests of several independent input data buffers.
+
+  This function performs the SHA-384 message digest of each of the DataCount
+  buffers, and places the digest of Data[Index] at offset Index * 48 of
+  HashValues. Where the CPU provides it, several buffers are hashed at the same
+  time, which is faster than calling Sha384HashAll() once per buffer.
+
+  If this interface is not supported, then return FALSE.
+
+  @param[in]   Data        Array of DataCount pointers to the buffers containing
+                           the data to be hashed.
+  @param[in]   DataSize    Array of DataCount sizes of the Data buffers in bytes.
+  @param[in]   DataCount   Number of buffers to hash.
+  @param[out]  HashValues  Pointer to a buffer that receives the DataCount SHA-384
+                           digest values (48 bytes each).
+
+  @retval TRUE   SHA-384 digest computation succeeded.
+  @retval FALSE  SHA-384 digest computation failed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+Sha384HashAllMultiBuffer (
+  IN   CONST VOID   *CONST  *Data,
+  IN   CONST UINTN          *DataSize,
+  IN   UINTN                DataCount,
+  OUT  UINT8                *HashValues
+  )
+{
+  ASSERT (FALSE);
+  return FALSE;
+}
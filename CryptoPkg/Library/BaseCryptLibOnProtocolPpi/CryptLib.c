@@ -572,6 +572,40 @@ Sha256HashAll (
   CALL_CRYPTO_SERVICE (Sha256HashAll, (Data, DataSize, HashValue), FALSE);
 }
 
+/**
+  Computes the SHA-256 message digests of several independent input data buffers.
+
+  This function performs the SHA-256 message digest of each of the DataCount
+  buffers, and places the digest of Data[Index] at offset Index * 32 of
+  HashValues. Where the CPU provides it, several buffers are hashed at the same
+  time, which is faster than calling Sha256HashAll() once per buffer.
+
+  If this interface is not supported, then return FALSE.
+
+  @param[in]   Data        Array of DataCount pointers to the buffers containing
+                           the data to be hashed.
+  @param[in]   DataSize    Array of DataCount sizes of the Data buffers in bytes.
+  @param[in]   DataCount   Number of buffers to hash.
+  @param[out]  HashValues  Pointer to a buffer that receives the DataCount SHA-256
+                           digest values (32 bytes each).
+
+  @retval TRUE   SHA-256 digest computation succeeded.
+  @retval FALSE  SHA-256 digest computation failed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+Sha256HashAllMultiBuffer (
+  IN   CONST VOID   *CONST  *Data,
+  IN   CONST UINTN          *DataSize,
+  IN   UINTN                DataCount,
+  OUT  UINT8                *HashValues
+  )
+{
+  CALL_CRYPTO_SERVICE (Sha256HashAllMultiBuffer, (Data, DataSize, DataCount, HashValues), FALSE);
+}
+
 /**
   Retrieves the size, in bytes, of the context buffer required for SHA-384 hash operations.
 
@@ -721,6 +755,40 @@ Sha384HashAll (
   CALL_CRYPTO_SERVICE (Sha384HashAll, (Data, DataSize, HashValue), FALSE);
 }
 
+/**
+  Computes the SHA-384 message digests of several independent input data buffers.
+
+  This function performs the SHA-384 message digest of each of the DataCount
+  buffers, and places the digest of Data[Index] at offset Index * 48 of
+  HashValues. Where the CPU provides it, several buffers are hashed at the same
+  time, which is faster than calling Sha384HashAll() once per buffer.
+
+  If this interface is not supported, then return FALSE.
+
+  @param[in]   Data        Array of DataCount pointers to the buffers containing
+                           the data to be hashed.
+  @param[in]   DataSize    Array of DataCount sizes of the Data buffers in bytes.
+  @param[in]   DataCount   Number of buffers to hash.
+  @param[out]  HashValues  Pointer to a buffer that receives the DataCount SHA-384
+                           digest values (48 bytes each).
+
+  @retval TRUE   SHA-384 digest computation succeeded.
+  @retval FALSE  SHA-384 digest computation failed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+Sha384HashAllMultiBuffer (
+  IN   CONST VOID   *CONST  *Data,
+  IN   CONST UINTN          *DataSize,
+  IN   UINTN                DataCount,
+  OUT  UINT8                *HashValues
+  )
+{
+  CALL_CRYPTO_SERVICE (Sha384HashAllMultiBuffer, (Data, DataSize, DataCount, HashValues), FALSE);
+}
+
 /**
   Retrieves the size, in bytes, of the context buffer required for SHA-512 hash operations.
 
@@ -4733,6 +4801,65 @@ TlsGetExportKey (
     );
 }
 
+/**
+  Sets the state of a previous TLS/SSL session to be resumed during TLS/SSL connect.
+
+  This function restores a session state returned by TlsGetResumptionData()
+  for an earlier connection to the same server, so that the handshake resumes
+  that session instead of negotiating new keys. It must be called before the
+  handshake starts.
+
+  @param[in]  Tls             Pointer to the TLS object.
+  @param[in]  Data            Session state returned by TlsGetResumptionData().
+  @param[in]  DataSize        Size of Data in bytes.
+
+  @retval  EFI_SUCCESS           The session state was set successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_ABORTED           The session state could not be restored.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsSetResumptionData (
+  IN     VOID        *Tls,
+  IN     CONST VOID  *Data,
+  IN     UINTN       DataSize
+  )
+{
+  CALL_CRYPTO_SERVICE (TlsSetResumptionData, (Tls, Data, DataSize), EFI_UNSUPPORTED);
+}
+
+/**
+  Gets the state of the TLS/SSL session used by the specified TLS connection.
+
+  This function returns the session state of the connection, so that a later
+  connection to the same server can resume the session with
+  TlsSetResumptionData().
+
+  @param[in]      Tls             Pointer to the TLS object.
+  @param[out]     Data            Buffer to contain the returned session state.
+  @param[in,out]  DataSize        On input, the size of Data in bytes. On output,
+                                  the size of the session state in bytes.
+
+  @retval  EFI_SUCCESS           The session state was returned successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_NOT_FOUND         The session cannot be resumed.
+  @retval  EFI_BUFFER_TOO_SMALL  The Data is too small to hold the session state.
+                                 DataSize is updated with the required size.
+  @retval  EFI_ABORTED           The session state could not be returned.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsGetResumptionData (
+  IN     VOID   *Tls,
+  OUT    VOID   *Data,
+  IN OUT UINTN  *DataSize
+  )
+{
+  CALL_CRYPTO_SERVICE (TlsGetResumptionData, (Tls, Data, DataSize), EFI_UNSUPPORTED);
+}
+
 // =====================================================================================
 //    Big number primitive
 // =====================================================================================
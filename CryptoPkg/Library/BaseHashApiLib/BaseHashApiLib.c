@@ -293,3 +293,74 @@ HashApiHashAll (
       break;
   }
 }
+
+/**
+  Computes hash message digests of several independent input data buffers.
+
+  The digest of DataToHash[Index] is placed at offset Index times the digest
+  size of the policy algorithm in Digests. For SHA-256 and SHA-384 several
+  buffers are hashed at the same time where the CPU allows it.
+
+  @param[in]  DataToHash     Array of DataCount pointers to the data to be hashed.
+  @param[in]  DataToHashLen  Array of DataCount data sizes.
+  @param[in]  DataCount      Number of buffers to hash.
+  @param[out] Digests        Hash Digests, one after another.
+
+  @retval TRUE   Hash digest computation succeeded.
+  @retval FALSE  Hash digest computation failed.
+**/
+BOOLEAN
+EFIAPI
+HashApiHashAllMultiBuffer (
+  IN  CONST VOID   *CONST  *DataToHash,
+  IN  CONST UINTN          *DataToHashLen,
+  IN  UINTN                DataCount,
+  OUT UINT8                *Digests
+  )
+{
+  UINTN  Index;
+  UINTN  DigestSize;
+
+  if ((DataToHash == NULL) || (DataToHashLen == NULL) || (Digests == NULL)) {
+    return FALSE;
+  }
+
+  switch (PcdGet32 (PcdHashApiLibPolicy)) {
+    case HASH_ALG_SHA256:
+      return Sha256HashAllMultiBuffer (DataToHash, DataToHashLen, DataCount, Digests);
+      break;
+
+    case HASH_ALG_SHA384:
+      return Sha384HashAllMultiBuffer (DataToHash, DataToHashLen, DataCount, Digests);
+      break;
+
+ #ifndef DISABLE_SHA1_DEPRECATED_INTERFACES
+    case HASH_ALG_SHA1:
+      DigestSize = SHA1_DIGEST_SIZE;
+      break;
+ #endif
+
+    case HASH_ALG_SHA512:
+      DigestSize = SHA512_DIGEST_SIZE;
+      break;
+
+    case HASH_ALG_SM3_256:
+      DigestSize = SM3_256_DIGEST_SIZE;
+      break;
+
+    default:
+      ASSERT (FALSE);
+      return FALSE;
+      break;
+  }
+
+  for (Index = 0; Index < DataCount; Index++) {
+    if (!HashApiHashAll (DataToHash[Index], DataToHashLen[Index], Digests)) {
+      return FALSE;
+    }
+
+    Digests += DigestSize;
+  }
+
+  return TRUE;
+}
@@ -577,6 +577,57 @@ TlsSetSessionId (
   return EFI_SUCCESS;
 }
 
+/**
+  Sets the state of a previous TLS/SSL session to be resumed during TLS/SSL connect.
+
+  This function restores a session state returned by TlsGetResumptionData()
+  for an earlier connection to the same server, so that the handshake resumes
+  that session instead of negotiating new keys. It must be called before the
+  handshake starts.
+
+  @param[in]  Tls             Pointer to the TLS object.
+  @param[in]  Data            Session state returned by TlsGetResumptionData().
+  @param[in]  DataSize        Size of Data in bytes.
+
+  @retval  EFI_SUCCESS           The session state was set successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_ABORTED           The session state could not be restored.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsSetResumptionData (
+  IN     VOID        *Tls,
+  IN     CONST VOID  *Data,
+  IN     UINTN       DataSize
+  )
+{
+  TLS_CONNECTION       *TlsConn;
+  SSL_SESSION          *Session;
+  CONST unsigned char  *Buffer;
+  INTN                 Ret;
+
+  TlsConn = (TLS_CONNECTION *)Tls;
+
+  if ((TlsConn == NULL) || (TlsConn->Ssl == NULL) || (Data == NULL) || (DataSize == 0) || (DataSize > MAX_INT32)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Buffer  = (CONST unsigned char *)Data;
+  Session = d2i_SSL_SESSION (NULL, &Buffer, (long)DataSize);
+  if (Session == NULL) {
+    return EFI_ABORTED;
+  }
+
+  //
+  // SSL_set_session() takes its own reference on the session.
+  //
+  Ret = SSL_set_session (TlsConn->Ssl, Session);
+  SSL_SESSION_free (Session);
+
+  return (Ret == 1) ? EFI_SUCCESS : EFI_ABORTED;
+}
+
 /**
   Adds the CA to the cert store when requesting Server or Client authentication.
 
@@ -1290,6 +1341,70 @@ TlsGetSessionId (
   return EFI_SUCCESS;
 }
 
+/**
+  Gets the state of the TLS/SSL session used by the specified TLS connection.
+
+  This function returns the session state of the connection, so that a later
+  connection to the same server can resume the session with
+  TlsSetResumptionData().
+
+  @param[in]      Tls             Pointer to the TLS object.
+  @param[out]     Data            Buffer to contain the returned session state.
+  @param[in,out]  DataSize        On input, the size of Data in bytes. On output,
+                                  the size of the session state in bytes.
+
+  @retval  EFI_SUCCESS           The session state was returned successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_NOT_FOUND         The session cannot be resumed.
+  @retval  EFI_BUFFER_TOO_SMALL  The Data is too small to hold the session state.
+                                 DataSize is updated with the required size.
+  @retval  EFI_ABORTED           The session state could not be returned.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsGetResumptionData (
+  IN     VOID   *Tls,
+  OUT    VOID   *Data,
+  IN OUT UINTN  *DataSize
+  )
+{
+  TLS_CONNECTION  *TlsConn;
+  SSL_SESSION     *Session;
+  unsigned char   *Buffer;
+  INTN            Length;
+
+  TlsConn = (TLS_CONNECTION *)Tls;
+
+  if ((TlsConn == NULL) || (TlsConn->Ssl == NULL) || (DataSize == NULL) || ((Data == NULL) && (*DataSize != 0))) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  //
+  // With TLS 1.3 this is the session of the last ticket received from the
+  // server, which is only known after the handshake.
+  //
+  Session = SSL_get_session (TlsConn->Ssl);
+  if ((Session == NULL) || (SSL_SESSION_is_resumable (Session) != 1)) {
+    return EFI_NOT_FOUND;
+  }
+
+  Length = i2d_SSL_SESSION (Session, NULL);
+  if (Length <= 0) {
+    return EFI_ABORTED;
+  }
+
+  if (*DataSize < (UINTN)Length) {
+    *DataSize = (UINTN)Length;
+    return EFI_BUFFER_TOO_SMALL;
+  }
+
+  Buffer    = (unsigned char *)Data;
+  *DataSize = (UINTN)i2d_SSL_SESSION (Session, &Buffer);
+
+  return EFI_SUCCESS;
+}
+
 /**
   Gets the client random data used in the specified TLS connection.
 
@@ -181,6 +181,35 @@ TlsSetSessionId (
   return EFI_UNSUPPORTED;
 }
 
+/**
+  Sets the state of a previous TLS/SSL session to be resumed during TLS/SSL connect.
+
+  This function restores a session state returned by TlsGetResumptionData()
+  for an earlier connection to the same server, so that the handshake resumes
+  that session instead of negotiating new keys. It must be called before the
+  handshake starts.
+
+  @param[in]  Tls             Pointer to the TLS object.
+  @param[in]  Data            Session state returned by TlsGetResumptionData().
+  @param[in]  DataSize        Size of Data in bytes.
+
+  @retval  EFI_SUCCESS           The session state was set successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_ABORTED           The session state could not be restored.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsSetResumptionData (
+  IN     VOID        *Tls,
+  IN     CONST VOID  *Data,
+  IN     UINTN       DataSize
+  )
+{
+  ASSERT (FALSE);
+  return EFI_UNSUPPORTED;
+}
+
 /**
   Adds the CA to the cert store when requesting Server or Client authentication.
 
@@ -526,6 +555,38 @@ TlsGetSessionId (
   return EFI_UNSUPPORTED;
 }
 
+/**
+  Gets the state of the TLS/SSL session used by the specified TLS connection.
+
+  This function returns the session state of the connection, so that a later
+  connection to the same server can resume the session with
+  TlsSetResumptionData().
+
+  @param[in]      Tls             Pointer to the TLS object.
+  @param[out]     Data            Buffer to contain the returned session state.
+  @param[in,out]  DataSize        On input, the size of Data in bytes. On output,
+                                  the size of the session state in bytes.
+
+  @retval  EFI_SUCCESS           The session state was returned successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_NOT_FOUND         The session cannot be resumed.
+  @retval  EFI_BUFFER_TOO_SMALL  The Data is too small to hold the session state.
+                                 DataSize is updated with the required size.
+  @retval  EFI_ABORTED           The session state could not be returned.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsGetResumptionData (
+  IN     VOID   *Tls,
+  OUT    VOID   *Data,
+  IN OUT UINTN  *DataSize
+  )
+{
+  ASSERT (FALSE);
+  return EFI_UNSUPPORTED;
+}
+
 /**
   Gets the client random data used in the specified TLS connection.
 
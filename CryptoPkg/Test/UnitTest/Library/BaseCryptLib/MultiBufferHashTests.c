@@ -0,0 +1,378 @@
+/** @file
+  Application for Multi-Buffer Hash Validation and Benchmark.
+
+  The digests of Sha256HashAllMultiBuffer() and Sha384HashAllMultiBuffer() are
+  compared with the ones of Sha256HashAll() and Sha384HashAll() for message
+  sizes around the padding boundaries and for more messages than lanes, so that
+  lanes finish and pick up new messages at different blocks.
+
+  The benchmark hashes the same messages with the multi-buffer function and
+  with one HashAll() call per message and logs both times in TSC ticks.
+
+  The host based tests on X64 also force every lane kernel the host can run,
+  and none, so that a kernel is not left untested because a faster one is
+  preferred on the host.
+
+Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "TestBaseCryptLib.h"
+
+#define MULTI_BUFFER_MAX_DIGEST_SIZE  SHA384_DIGEST_SIZE
+
+//
+// Largest number of messages of one call. More than the lanes of any kernel.
+//
+#define MULTI_BUFFER_MAX_MESSAGES  19
+
+//
+// Size of the messages of the benchmark, and their number.
+//
+#define MULTI_BUFFER_BENCHMARK_SIZE      SIZE_4KB
+#define MULTI_BUFFER_BENCHMARK_MESSAGES  64
+
+typedef
+BOOLEAN
+(EFIAPI *EFI_HASH_ALL)(
+  IN   CONST VOID  *Data,
+  IN   UINTN       DataSize,
+  OUT  UINT8       *HashValue
+  );
+
+typedef
+BOOLEAN
+(EFIAPI *EFI_HASH_ALL_MULTI_BUFFER)(
+  IN   CONST VOID   *CONST  *Data,
+  IN   CONST UINTN          *DataSize,
+  IN   UINTN                DataCount,
+  OUT  UINT8                *HashValues
+  );
+
+typedef struct {
+  CHAR8                        *Name;
+  UINTN                        DigestSize;
+  EFI_HASH_ALL                 HashAll;
+  EFI_HASH_ALL_MULTI_BUFFER    HashAllMultiBuffer;
+} MULTI_BUFFER_TEST_CONTEXT;
+
+MULTI_BUFFER_TEST_CONTEXT  mSha256MultiBufferTestCtx = { "SHA-256", SHA256_DIGEST_SIZE, Sha256HashAll, Sha256HashAllMultiBuffer };
+MULTI_BUFFER_TEST_CONTEXT  mSha384MultiBufferTestCtx = { "SHA-384", SHA384_DIGEST_SIZE, Sha384HashAll, Sha384HashAllMultiBuffer };
+
+#if defined (SHA2_MULTI_BUFFER_HOST_TEST)
+
+//
+// The lane kernel selection of the host BaseCryptLib, see
+// CryptoPkg/Library/BaseCryptLib/Hash/CryptSha2MultiBuffer.h.
+//
+#define SHA2_MULTI_BUFFER_CPU_SHA_NI  BIT0
+#define SHA2_MULTI_BUFFER_CPU_AVX2    BIT1
+
+extern UINT32  gSha2MultiBufferHostCpuFeatureMask;
+
+UINT32
+Sha2MultiBufferGetCpuFeatures (
+  VOID
+  );
+
+typedef struct {
+  CHAR8     *Name;
+  ///
+  /// The only CPU features the kernel selection sees.
+  ///
+  UINT32    Features;
+} MULTI_BUFFER_KERNEL_TEST_CONTEXT;
+
+//
+// SHA-256 prefers SHA-NI, so the AVX2 kernel only runs when SHA-NI is hidden.
+// SHA-384 has no SHA-NI kernel and hashes one message after the other then.
+//
+MULTI_BUFFER_KERNEL_TEST_CONTEXT  mMultiBufferShaNiKernelTestCtx  = { "SHA-NI", SHA2_MULTI_BUFFER_CPU_SHA_NI };
+MULTI_BUFFER_KERNEL_TEST_CONTEXT  mMultiBufferAvx2KernelTestCtx   = { "AVX2", SHA2_MULTI_BUFFER_CPU_AVX2 };
+MULTI_BUFFER_KERNEL_TEST_CONTEXT  mMultiBufferScalarKernelTestCtx = { "scalar", 0 };
+
+#endif
+
+//
+// Message sizes around the block and padding boundaries of SHA-256 (64-byte
+// blocks, 8-byte length) and SHA-512 (128-byte blocks, 16-byte length).
+//
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINTN  mMultiBufferSizes[] = {
+  0, 1, 3, 55, 56, 63, 64, 65, 111, 112, 119, 120, 127, 128, 129, 191, 255, 256, 1000, 4096, 12345
+};
+
+/**
+  Fill a buffer with a pseudo-random pattern.
+
+  @param[out] Buffer  The buffer.
+  @param[in]  Size    The size of the buffer.
+  @param[in]  Seed    The seed of the pattern.
+**/
+STATIC
+VOID
+MultiBufferFill (
+  OUT UINT8   *Buffer,
+  IN  UINTN   Size,
+  IN  UINT32  Seed
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < Size; Index++) {
+    Seed          = Seed * 1103515245 + 12345;
+    Buffer[Index] = (UINT8)(Seed >> 16);
+  }
+}
+
+/**
+  Hash messages with the multi-buffer function and compare every digest with
+  the one of the single buffer function.
+
+  @param[in] TestContext  The algorithm.
+  @param[in] Data         The messages.
+  @param[in] DataSize     The sizes of the messages.
+  @param[in] DataCount    The number of messages.
+
+  @retval TRUE   All digests match.
+  @retval FALSE  A digest does not match or a function failed.
+**/
+STATIC
+BOOLEAN
+MultiBufferCheck (
+  IN CONST MULTI_BUFFER_TEST_CONTEXT  *TestContext,
+  IN CONST VOID   *CONST              *Data,
+  IN CONST UINTN                      *DataSize,
+  IN UINTN                            DataCount
+  )
+{
+  UINT8  Digests[MULTI_BUFFER_MAX_MESSAGES * MULTI_BUFFER_MAX_DIGEST_SIZE];
+  UINT8  Digest[MULTI_BUFFER_MAX_DIGEST_SIZE];
+  UINTN  Index;
+
+  SetMem (Digests, sizeof (Digests), 0xAA);
+  if (!TestContext->HashAllMultiBuffer (Data, DataSize, DataCount, Digests)) {
+    return FALSE;
+  }
+
+  for (Index = 0; Index < DataCount; Index++) {
+    if (!TestContext->HashAll (Data[Index], DataSize[Index], Digest)) {
+      return FALSE;
+    }
+
+    if (CompareMem (Digest, Digests + Index * TestContext->DigestSize, TestContext->DigestSize) != 0) {
+      UT_LOG_ERROR ("%a digest %d of %d (%d bytes) mismatch\n", TestContext->Name, (UINT32)Index, (UINT32)DataCount, (UINT32)DataSize[Index]);
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+UNIT_TEST_STATUS
+EFIAPI
+TestVerifyMultiBufferHash (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  MULTI_BUFFER_TEST_CONTEXT  *TestContext;
+  UINT8                      *Pool;
+  CONST VOID                 *Data[MULTI_BUFFER_MAX_MESSAGES];
+  UINTN                      DataSize[MULTI_BUFFER_MAX_MESSAGES];
+  UINTN                      MaxSize;
+  UINTN                      Count;
+  UINTN                      Index;
+  UINTN                      Offset;
+
+  TestContext = Context;
+  MaxSize     = mMultiBufferSizes[ARRAY_SIZE (mMultiBufferSizes) - 1];
+
+  Pool = AllocatePool (MULTI_BUFFER_MAX_MESSAGES * MaxSize);
+  UT_ASSERT_NOT_NULL (Pool);
+  MultiBufferFill (Pool, MULTI_BUFFER_MAX_MESSAGES * MaxSize, 0x5eed);
+
+  //
+  // All messages of the same size.
+  //
+  for (Index = 0; Index < ARRAY_SIZE (mMultiBufferSizes); Index++) {
+    for (Count = 0; Count < MULTI_BUFFER_MAX_MESSAGES; Count++) {
+      Data[Count]     = Pool + Count * MaxSize;
+      DataSize[Count] = mMultiBufferSizes[Index];
+    }
+
+    UT_ASSERT_TRUE (MultiBufferCheck (TestContext, Data, DataSize, MULTI_BUFFER_MAX_MESSAGES));
+  }
+
+  //
+  // Every number of messages with mixed sizes and unaligned buffers.
+  //
+  for (Count = 1; Count <= MULTI_BUFFER_MAX_MESSAGES; Count++) {
+    for (Index = 0; Index < Count; Index++) {
+      Offset          = (Index * 7 + Count) % 16;
+      DataSize[Index] = mMultiBufferSizes[(Index * 5 + Count) % ARRAY_SIZE (mMultiBufferSizes)];
+      DataSize[Index] = MIN (DataSize[Index], MaxSize - Offset);
+      Data[Index]     = Pool + Index * MaxSize + Offset;
+    }
+
+    UT_ASSERT_TRUE (MultiBufferCheck (TestContext, Data, DataSize, Count));
+  }
+
+  FreePool (Pool);
+  return UNIT_TEST_PASSED;
+}
+
+UNIT_TEST_STATUS
+EFIAPI
+TestVerifyMultiBufferHashParameters (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  MULTI_BUFFER_TEST_CONTEXT  *TestContext;
+  CONST VOID                 *Data[2];
+  UINTN                      DataSize[2];
+  UINT8                      Digests[2 * MULTI_BUFFER_MAX_DIGEST_SIZE];
+  UINT8                      Digest[MULTI_BUFFER_MAX_DIGEST_SIZE];
+
+  TestContext = Context;
+  Data[0]     = "abc";
+  DataSize[0] = 3;
+  Data[1]     = NULL;
+  DataSize[1] = 0;
+
+  UT_ASSERT_TRUE (TestContext->HashAllMultiBuffer (Data, DataSize, 0, Digests));
+  UT_ASSERT_FALSE (TestContext->HashAllMultiBuffer (Data, DataSize, 2, NULL));
+  UT_ASSERT_FALSE (TestContext->HashAllMultiBuffer (NULL, DataSize, 2, Digests));
+  UT_ASSERT_FALSE (TestContext->HashAllMultiBuffer (Data, NULL, 2, Digests));
+
+  //
+  // A NULL buffer is only valid with a size of 0.
+  //
+  UT_ASSERT_TRUE (TestContext->HashAllMultiBuffer (Data, DataSize, 2, Digests));
+  UT_ASSERT_TRUE (TestContext->HashAll ("abc", 3, Digest));
+  UT_ASSERT_MEM_EQUAL (Digests, Digest, TestContext->DigestSize);
+  UT_ASSERT_TRUE (TestContext->HashAll (NULL, 0, Digest));
+  UT_ASSERT_MEM_EQUAL (Digests + TestContext->DigestSize, Digest, TestContext->DigestSize);
+
+  DataSize[1] = 1;
+  UT_ASSERT_FALSE (TestContext->HashAllMultiBuffer (Data, DataSize, 2, Digests));
+
+  return UNIT_TEST_PASSED;
+}
+
+UNIT_TEST_STATUS
+EFIAPI
+TestBenchmarkMultiBufferHash (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+ #if defined (MDE_CPU_IA32) || defined (MDE_CPU_X64)
+  MULTI_BUFFER_TEST_CONTEXT  *TestContext;
+  UINT8                      *Pool;
+  UINT8                      *Digests;
+  CONST VOID                 **Data;
+  UINTN                      *DataSize;
+  UINTN                      Index;
+  UINT64                     Start;
+  UINT64                     MultiBufferTicks;
+  UINT64                     SingleBufferTicks;
+
+  TestContext = Context;
+  Pool        = AllocatePool (MULTI_BUFFER_BENCHMARK_MESSAGES * MULTI_BUFFER_BENCHMARK_SIZE);
+  Digests     = AllocatePool (MULTI_BUFFER_BENCHMARK_MESSAGES * MULTI_BUFFER_MAX_DIGEST_SIZE);
+  Data        = AllocatePool (MULTI_BUFFER_BENCHMARK_MESSAGES * sizeof (*Data));
+  DataSize    = AllocatePool (MULTI_BUFFER_BENCHMARK_MESSAGES * sizeof (*DataSize));
+  UT_ASSERT_NOT_NULL (Pool);
+  UT_ASSERT_NOT_NULL (Digests);
+  UT_ASSERT_NOT_NULL (Data);
+  UT_ASSERT_NOT_NULL (DataSize);
+
+  MultiBufferFill (Pool, MULTI_BUFFER_BENCHMARK_MESSAGES * MULTI_BUFFER_BENCHMARK_SIZE, 0xbe4c);
+  for (Index = 0; Index < MULTI_BUFFER_BENCHMARK_MESSAGES; Index++) {
+    Data[Index]     = Pool + Index * MULTI_BUFFER_BENCHMARK_SIZE;
+    DataSize[Index] = MULTI_BUFFER_BENCHMARK_SIZE;
+  }
+
+  Start = AsmReadTsc ();
+  UT_ASSERT_TRUE (TestContext->HashAllMultiBuffer (Data, DataSize, MULTI_BUFFER_BENCHMARK_MESSAGES, Digests));
+  MultiBufferTicks = AsmReadTsc () - Start;
+
+  Start = AsmReadTsc ();
+  for (Index = 0; Index < MULTI_BUFFER_BENCHMARK_MESSAGES; Index++) {
+    UT_ASSERT_TRUE (TestContext->HashAll (Data[Index], DataSize[Index], Digests + Index * TestContext->DigestSize));
+  }
+
+  SingleBufferTicks = AsmReadTsc () - Start;
+
+  UT_LOG_INFO (
+    "%a %d x %d bytes: multi-buffer %ld ticks, single buffer %ld ticks\n",
+    TestContext->Name,
+    MULTI_BUFFER_BENCHMARK_MESSAGES,
+    MULTI_BUFFER_BENCHMARK_SIZE,
+    MultiBufferTicks,
+    SingleBufferTicks
+    );
+
+  FreePool (DataSize);
+  FreePool (Data);
+  FreePool (Digests);
+  FreePool (Pool);
+ #endif
+  return UNIT_TEST_PASSED;
+}
+
+#if defined (SHA2_MULTI_BUFFER_HOST_TEST)
+
+UNIT_TEST_STATUS
+EFIAPI
+TestVerifyMultiBufferHashKernel (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  MULTI_BUFFER_KERNEL_TEST_CONTEXT  *TestContext;
+  UNIT_TEST_STATUS                  Status;
+
+  TestContext = Context;
+  if ((Sha2MultiBufferGetCpuFeatures () & TestContext->Features) != TestContext->Features) {
+    UT_LOG_WARNING ("The host cannot run the %a kernels\n", TestContext->Name);
+    return UNIT_TEST_SKIPPED;
+  }
+
+  gSha2MultiBufferHostCpuFeatureMask = TestContext->Features;
+
+  Status = TestVerifyMultiBufferHash (&mSha256MultiBufferTestCtx);
+  if (Status != UNIT_TEST_PASSED) {
+    return Status;
+  }
+
+  return TestVerifyMultiBufferHash (&mSha384MultiBufferTestCtx);
+}
+
+VOID
+EFIAPI
+TestMultiBufferHashKernelCleanUp (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  gSha2MultiBufferHostCpuFeatureMask = MAX_UINT32;
+}
+
+#endif
+
+TEST_DESC  mMultiBufferHashTest[] = {
+  //
+  // -----Description--------------------------------Class------------------------------------Function------------------------------Pre---Post--Context
+  //
+  { "TestVerifySha256HashAllMultiBuffer()",           "CryptoPkg.BaseCryptLib.MultiBufferHash", TestVerifyMultiBufferHash,           NULL, NULL, &mSha256MultiBufferTestCtx },
+  { "TestVerifySha384HashAllMultiBuffer()",           "CryptoPkg.BaseCryptLib.MultiBufferHash", TestVerifyMultiBufferHash,           NULL, NULL, &mSha384MultiBufferTestCtx },
+  { "TestVerifySha256HashAllMultiBufferParameters()", "CryptoPkg.BaseCryptLib.MultiBufferHash", TestVerifyMultiBufferHashParameters, NULL, NULL, &mSha256MultiBufferTestCtx },
+  { "TestVerifySha384HashAllMultiBufferParameters()", "CryptoPkg.BaseCryptLib.MultiBufferHash", TestVerifyMultiBufferHashParameters, NULL, NULL, &mSha384MultiBufferTestCtx },
+  { "TestBenchmarkSha256HashAllMultiBuffer()",        "CryptoPkg.BaseCryptLib.MultiBufferHash", TestBenchmarkMultiBufferHash,        NULL, NULL, &mSha256MultiBufferTestCtx },
+  { "TestBenchmarkSha384HashAllMultiBuffer()",        "CryptoPkg.BaseCryptLib.MultiBufferHash", TestBenchmarkMultiBufferHash,        NULL, NULL, &mSha384MultiBufferTestCtx },
+ #if defined (SHA2_MULTI_BUFFER_HOST_TEST)
+  { "TestVerifyMultiBufferHashShaNiKernel()",          "CryptoPkg.BaseCryptLib.MultiBufferHash", TestVerifyMultiBufferHashKernel,     NULL, TestMultiBufferHashKernelCleanUp, &mMultiBufferShaNiKernelTestCtx  },
+  { "TestVerifyMultiBufferHashAvx2Kernel()",           "CryptoPkg.BaseCryptLib.MultiBufferHash", TestVerifyMultiBufferHashKernel,     NULL, TestMultiBufferHashKernelCleanUp, &mMultiBufferAvx2KernelTestCtx   },
+  { "TestVerifyMultiBufferHashScalarKernel()",         "CryptoPkg.BaseCryptLib.MultiBufferHash", TestVerifyMultiBufferHashKernel,     NULL, TestMultiBufferHashKernelCleanUp, &mMultiBufferScalarKernelTestCtx },
+ #endif
+};
+
+UINTN  mMultiBufferHashTestNum = ARRAY_SIZE (mMultiBufferHashTest);
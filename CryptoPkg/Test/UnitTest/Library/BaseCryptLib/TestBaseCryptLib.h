@@ -50,6 +50,9 @@ extern TEST_DESC  mPkcs7EkuTest[];
 extern UINTN      mHashTestNum;
 extern TEST_DESC  mHashTest[];
 
+extern UINTN      mMultiBufferHashTestNum;
+extern TEST_DESC  mMultiBufferHashTest[];
+
 extern UINTN      mHmacTestNum;
 extern TEST_DESC  mHmacTest[];
 
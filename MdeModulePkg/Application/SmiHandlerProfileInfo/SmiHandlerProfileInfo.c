@@ -334,6 +334,34 @@ GetImageFromRef (
   return NULL;
 }
 
+/**
+  Get image structure from an address inside the image.
+
+  @param Address   the address inside the image
+
+  @return image structure
+**/
+SMM_CORE_IMAGE_DATABASE_STRUCTURE *
+GetImageFromAddress (
+  IN UINT64  Address
+  )
+{
+  SMM_CORE_IMAGE_DATABASE_STRUCTURE  *ImageStruct;
+
+  ImageStruct = (VOID *)mSmiHandlerProfileDatabase;
+  while ((UINTN)ImageStruct < (UINTN)mSmiHandlerProfileDatabase + mSmiHandlerProfileDatabaseSize) {
+    if (ImageStruct->Header.Signature == SMM_CORE_IMAGE_DATABASE_SIGNATURE) {
+      if ((Address >= ImageStruct->ImageBase) && (Address < ImageStruct->ImageBase + ImageStruct->ImageSize)) {
+        return ImageStruct;
+      }
+    }
+
+    ImageStruct = (VOID *)((UINTN)ImageStruct + ImageStruct->Header.Length);
+  }
+
+  return NULL;
+}
+
 /**
   Dump SMM loaded image information.
 **/
@@ -642,6 +670,86 @@ DumpSmiHandler (
   return;
 }
 
+/**
+  Check whether the SMI handler profile database carries dispatch statistics.
+
+  @retval TRUE   Dispatch statistics are present.
+  @retval FALSE  Dispatch statistics are not present.
+**/
+BOOLEAN
+HasSmiHandlerStatistics (
+  VOID
+  )
+{
+  SMM_CORE_SMI_STATISTICS_DATABASE_STRUCTURE  *SmiStruct;
+
+  SmiStruct = (VOID *)mSmiHandlerProfileDatabase;
+  while ((UINTN)SmiStruct < (UINTN)mSmiHandlerProfileDatabase + mSmiHandlerProfileDatabaseSize) {
+    if (SmiStruct->Header.Signature == SMM_CORE_SMI_STATISTICS_DATABASE_SIGNATURE) {
+      return TRUE;
+    }
+
+    SmiStruct = (VOID *)((UINTN)SmiStruct + SmiStruct->Header.Length);
+  }
+
+  return FALSE;
+}
+
+/**
+  Dump SMI handler dispatch statistics in HandlerCategory.
+
+  @param HandlerCategory  SMI handler category
+**/
+VOID
+DumpSmiHandlerStatistics (
+  IN UINT32  HandlerCategory
+  )
+{
+  SMM_CORE_SMI_STATISTICS_DATABASE_STRUCTURE  *SmiStruct;
+  SMM_CORE_SMI_HANDLER_STATISTICS_STRUCTURE   *SmiHandlerStruct;
+  UINTN                                       Index;
+  UINTN                                       Bucket;
+  SMM_CORE_IMAGE_DATABASE_STRUCTURE           *ImageStruct;
+
+  SmiStruct = (VOID *)mSmiHandlerProfileDatabase;
+  while ((UINTN)SmiStruct < (UINTN)mSmiHandlerProfileDatabase + mSmiHandlerProfileDatabaseSize) {
+    if ((SmiStruct->Header.Signature == SMM_CORE_SMI_STATISTICS_DATABASE_SIGNATURE) && (SmiStruct->HandlerCategory == HandlerCategory)) {
+      SmiHandlerStruct = (VOID *)(SmiStruct + 1);
+      Print (L"  <SmiEntry");
+      if (!IsZeroGuid (&SmiStruct->HandlerType)) {
+        Print (L" HandlerType=\"%g\"", &SmiStruct->HandlerType);
+      }
+
+      Print (L">\n");
+      for (Index = 0; Index < SmiStruct->HandlerCount; Index++) {
+        ImageStruct = GetImageFromAddress (SmiHandlerStruct->Handler);
+        Print (L"    <SmiHandler Address=\"0x%lx\" Module=\"%a\">\n", SmiHandlerStruct->Handler, GetDriverNameString (ImageStruct));
+        Print (L"      <Dispatch Count=\"%ld\" TotalCycles=\"%ld\" MaxCycles=\"%ld\"", SmiHandlerStruct->DispatchCount, SmiHandlerStruct->TotalCycles, SmiHandlerStruct->MaxCycles);
+        if (SmiHandlerStruct->DispatchCount != 0) {
+          Print (L" AverageCycles=\"%ld\"", DivU64x64Remainder (SmiHandlerStruct->TotalCycles, SmiHandlerStruct->DispatchCount, NULL));
+        }
+
+        Print (L"/>\n");
+        Print (L"      <!-- Bucket N counts dispatches of [2^N, 2^(N+1)) cycles -->\n");
+        for (Bucket = 0; Bucket < SMI_HANDLER_PROFILE_HISTOGRAM_BUCKET_COUNT; Bucket++) {
+          if (SmiHandlerStruct->Histogram[Bucket] != 0) {
+            Print (L"      <Bucket Index=\"%d\" Count=\"%d\"/>\n", Bucket, SmiHandlerStruct->Histogram[Bucket]);
+          }
+        }
+
+        Print (L"    </SmiHandler>\n");
+        SmiHandlerStruct++;
+      }
+
+      Print (L"  </SmiEntry>\n");
+    }
+
+    SmiStruct = (VOID *)((UINTN)SmiStruct + SmiStruct->Header.Length);
+  }
+
+  return;
+}
+
 /**
   The Entry Point for SMI handler profile info application.
 
@@ -695,6 +803,24 @@ SmiHandlerProfileInfoEntrypoint (
   Print (L"  </SmiHandlerCategory>\n\n");
 
   Print (L"</SmiHandlerDatabase>\n");
+
+  //
+  // Dump SMI Handler dispatch statistics
+  //
+  if (HasSmiHandlerStatistics ()) {
+    Print (L"\n<SmiHandlerStatistics>\n");
+    Print (L"  <!-- SMI Handler dispatch time in TSC cycles -->\n\n");
+    Print (L"  <SmiHandlerCategory Name=\"RootSmi\">\n");
+    DumpSmiHandlerStatistics (SmmCoreSmiHandlerCategoryRootHandler);
+    Print (L"  </SmiHandlerCategory>\n\n");
+
+    Print (L"  <SmiHandlerCategory Name=\"GuidSmi\">\n");
+    DumpSmiHandlerStatistics (SmmCoreSmiHandlerCategoryGuidHandler);
+    Print (L"  </SmiHandlerCategory>\n\n");
+
+    Print (L"</SmiHandlerStatistics>\n");
+  }
+
   Print (L"</SmiHandlerProfile>\n");
 
   if (mSmiHandlerProfileDatabase != NULL) {
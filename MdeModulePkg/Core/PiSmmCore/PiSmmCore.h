@@ -76,14 +76,27 @@ typedef struct {
 
 #define SMI_ENTRY_SIGNATURE  SIGNATURE_32('s','m','i','e')
 
+//
+// Number of buckets of the SMI entry hash table, must be a power of two.
+//
+#define SMI_ENTRY_HASH_BUCKET_COUNT  64
+
 typedef struct {
   UINTN         Signature;
   LIST_ENTRY    AllEntries; // All entries
+  LIST_ENTRY    HashLink;   // Link on the SMI entry hash bucket
 
   EFI_GUID      HandlerType; // Type of interrupt
   LIST_ENTRY    SmiHandlers; // All handlers
 } SMI_ENTRY;
 
+typedef struct {
+  UINT64    DispatchCount;
+  UINT64    TotalCycles;
+  UINT64    MaxCycles;
+  UINT32    Histogram[SMI_HANDLER_PROFILE_HISTOGRAM_BUCKET_COUNT];
+} SMI_HANDLER_STATISTICS;
+
 #define SMI_HANDLER_SIGNATURE  SIGNATURE_32('s','m','i','h')
 
 typedef struct {
@@ -95,6 +108,7 @@ typedef struct {
   VOID                            *Context;    // for profile
   UINTN                           ContextSize; // for profile
   BOOLEAN                         ToRemove;    // To remove this SMI_HANDLER later
+  SMI_HANDLER_STATISTICS          Statistics;  // for profile
 } SMI_HANDLER;
 
 //
@@ -1154,6 +1168,18 @@ SmmCoreInitializeSmiHandlerProfile (
   VOID
   );
 
+/**
+  Record the dispatch time of a root or GUID SMI handler.
+
+  @param SmiHandler  The dispatched SMI handler.
+  @param Cycles      The number of TSC cycles the dispatch took.
+**/
+VOID
+SmiHandlerProfileRecordDispatch (
+  IN OUT SMI_HANDLER  *SmiHandler,
+  IN     UINT64       Cycles
+  );
+
 /**
   This function is called by SmmChildDispatcher module to report
   a new SMI handler is registered, to SmmCore.
@@ -1215,6 +1241,8 @@ SmiHandlerProfileUnregisterHandler (
 extern UINTN                 mFullSmramRangeCount;
 extern EFI_SMRAM_DESCRIPTOR  *mFullSmramRanges;
 
+extern BOOLEAN  mSmiHandlerStatisticsEnabled;
+
 extern EFI_SMM_DRIVER_ENTRY  *mSmmCoreDriverEntry;
 
 extern EFI_LOADED_IMAGE_PROTOCOL  *mSmmCoreLoadedImage;
@@ -15,13 +15,59 @@ UINTN  mSmiManageCallingDepth = 0;
 
 LIST_ENTRY  mSmiEntryList = INITIALIZE_LIST_HEAD_VARIABLE (mSmiEntryList);
 
+//
+// mSmiEntryHashTable holds the SMI entries of mSmiEntryList hashed by handler
+// type, so SmiManage() does not have to walk all entries on every SMI.
+//
+LIST_ENTRY  mSmiEntryHashTable[SMI_ENTRY_HASH_BUCKET_COUNT];
+BOOLEAN     mSmiEntryHashTableInitialized = FALSE;
+
 SMI_ENTRY  mRootSmiEntry = {
   SMI_ENTRY_SIGNATURE,
   INITIALIZE_LIST_HEAD_VARIABLE (mRootSmiEntry.AllEntries),
+  INITIALIZE_LIST_HEAD_VARIABLE (mRootSmiEntry.HashLink),
   { 0 },
   INITIALIZE_LIST_HEAD_VARIABLE (mRootSmiEntry.SmiHandlers),
 };
 
+/**
+  Returns the SMI entry hash bucket for a handler type.
+
+  @param  HandlerType            The type of the interrupt
+
+  @return The head of the SMI entry hash bucket.
+
+**/
+LIST_ENTRY *
+SmiEntryHashBucket (
+  IN CONST EFI_GUID  *HandlerType
+  )
+{
+  UINT32  Hash;
+  UINTN   Index;
+
+  if (!mSmiEntryHashTableInitialized) {
+    for (Index = 0; Index < SMI_ENTRY_HASH_BUCKET_COUNT; Index++) {
+      InitializeListHead (&mSmiEntryHashTable[Index]);
+    }
+
+    mSmiEntryHashTableInitialized = TRUE;
+  }
+
+  //
+  // Fold the GUID into the bucket index. The pointer may come from a
+  // communication buffer, so do not assume alignment.
+  //
+  Hash  = ReadUnaligned32 ((CONST UINT32 *)HandlerType);
+  Hash ^= ReadUnaligned32 ((CONST UINT32 *)HandlerType + 1);
+  Hash ^= ReadUnaligned32 ((CONST UINT32 *)HandlerType + 2);
+  Hash ^= ReadUnaligned32 ((CONST UINT32 *)HandlerType + 3);
+  Hash ^= Hash >> 16;
+  Hash ^= Hash >> 8;
+
+  return &mSmiEntryHashTable[Hash & (SMI_ENTRY_HASH_BUCKET_COUNT - 1)];
+}
+
 /**
   Finds the SMI entry for the requested handler type.
 
@@ -38,19 +84,21 @@ SmmCoreFindSmiEntry (
   IN BOOLEAN   Create
   )
 {
+  LIST_ENTRY  *Bucket;
   LIST_ENTRY  *Link;
   SMI_ENTRY   *Item;
   SMI_ENTRY   *SmiEntry;
 
   //
-  // Search the SMI entry list for the matching GUID
+  // Search the SMI entry hash bucket for the matching GUID
   //
   SmiEntry = NULL;
-  for (Link = mSmiEntryList.ForwardLink;
-       Link != &mSmiEntryList;
+  Bucket   = SmiEntryHashBucket (HandlerType);
+  for (Link = Bucket->ForwardLink;
+       Link != Bucket;
        Link = Link->ForwardLink)
   {
-    Item = CR (Link, SMI_ENTRY, AllEntries, SMI_ENTRY_SIGNATURE);
+    Item = CR (Link, SMI_ENTRY, HashLink, SMI_ENTRY_SIGNATURE);
     if (CompareGuid (&Item->HandlerType, HandlerType)) {
       //
       // This is the SMI entry
@@ -75,9 +123,10 @@ SmmCoreFindSmiEntry (
       InitializeListHead (&SmiEntry->SmiHandlers);
 
       //
-      // Add it to SMI entry list
+      // Add it to SMI entry list and hash bucket
       //
       InsertTailList (&mSmiEntryList, &SmiEntry->AllEntries);
+      InsertTailList (Bucket, &SmiEntry->HashLink);
     }
   }
 
@@ -110,6 +159,7 @@ RemoveSmiHandler (
   if (SmiEntry != NULL) {
     if (IsListEmpty (&SmiEntry->SmiHandlers)) {
       RemoveEntryList (&SmiEntry->AllEntries);
+      RemoveEntryList (&SmiEntry->HashLink);
       FreePool (SmiEntry);
       return TRUE;
     }
@@ -149,11 +199,14 @@ SmiManage (
   EFI_STATUS   ReturnStatus;
   BOOLEAN      WillReturn;
   EFI_STATUS   Status;
+  UINT64       StartCycles;
 
   PERF_FUNCTION_BEGIN ();
   mSmiManageCallingDepth++;
   Status       = EFI_NOT_FOUND;
   ReturnStatus = Status;
+  WillReturn   = FALSE;
+  StartCycles  = 0;
   if (HandlerType == NULL) {
     //
     // Root SMI handler
@@ -178,6 +231,10 @@ SmiManage (
   for (Link = Head->ForwardLink; Link != Head; Link = Link->ForwardLink) {
     SmiHandler = CR (Link, SMI_HANDLER, Link, SMI_HANDLER_SIGNATURE);
 
+    if (mSmiHandlerStatisticsEnabled) {
+      StartCycles = AsmReadTsc ();
+    }
+
     Status = SmiHandler->Handler (
                            (EFI_HANDLE)SmiHandler,
                            Context,
@@ -185,6 +242,10 @@ SmiManage (
                            CommBufferSize
                            );
 
+    if (mSmiHandlerStatisticsEnabled) {
+      SmiHandlerProfileRecordDispatch (SmiHandler, AsmReadTsc () - StartCycles);
+    }
+
     switch (Status) {
       case EFI_INTERRUPT_PENDING:
         //
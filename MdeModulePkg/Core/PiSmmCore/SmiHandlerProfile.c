@@ -97,6 +97,11 @@ GLOBAL_REMOVE_IF_UNREFERENCED UINTN  mSmmHardwareSmiDatabaseSize;
 
 GLOBAL_REMOVE_IF_UNREFERENCED BOOLEAN  mSmiHandlerProfileRecordingStatus;
 
+GLOBAL_REMOVE_IF_UNREFERENCED VOID   *mSmiHandlerStatisticsDatabase;
+GLOBAL_REMOVE_IF_UNREFERENCED UINTN  mSmiHandlerStatisticsDatabaseSize;
+
+BOOLEAN  mSmiHandlerStatisticsEnabled = FALSE;
+
 GLOBAL_REMOVE_IF_UNREFERENCED SMI_HANDLER_PROFILE_PROTOCOL  mSmiHandlerProfile = {
   SmiHandlerProfileRegisterHandler,
   SmiHandlerProfileUnregisterHandler,
@@ -872,6 +877,172 @@ BuildSmiHandlerProfileDatabase (
   }
 }
 
+/**
+  Record the dispatch time of a root or GUID SMI handler.
+
+  @param SmiHandler  The dispatched SMI handler.
+  @param Cycles      The number of TSC cycles the dispatch took.
+**/
+VOID
+SmiHandlerProfileRecordDispatch (
+  IN OUT SMI_HANDLER  *SmiHandler,
+  IN     UINT64       Cycles
+  )
+{
+  SMI_HANDLER_STATISTICS  *Statistics;
+  UINTN                   Bucket;
+
+  Statistics = &SmiHandler->Statistics;
+  Statistics->DispatchCount++;
+  Statistics->TotalCycles += Cycles;
+  if (Cycles > Statistics->MaxCycles) {
+    Statistics->MaxCycles = Cycles;
+  }
+
+  Bucket = 0;
+  if (Cycles != 0) {
+    Bucket = MIN ((UINTN)HighBitSet64 (Cycles), SMI_HANDLER_PROFILE_HISTOGRAM_BUCKET_COUNT - 1);
+  }
+
+  Statistics->Histogram[Bucket]++;
+}
+
+/**
+  return SMI handler statistics database size on the SMI entry list.
+
+  @param SmiEntryList a list of SMI entry.
+
+  @return SMI handler statistics database size on the SMI entry list.
+**/
+UINTN
+GetSmmSmiStatisticsDatabaseSize (
+  IN LIST_ENTRY  *SmiEntryList
+  )
+{
+  LIST_ENTRY  *ListEntry;
+  LIST_ENTRY  *HandlerEntry;
+  SMI_ENTRY   *SmiEntry;
+  UINTN       Size;
+
+  Size = 0;
+  for (ListEntry = SmiEntryList->ForwardLink;
+       ListEntry != SmiEntryList;
+       ListEntry = ListEntry->ForwardLink)
+  {
+    SmiEntry = CR (ListEntry, SMI_ENTRY, AllEntries, SMI_ENTRY_SIGNATURE);
+    Size    += sizeof (SMM_CORE_SMI_STATISTICS_DATABASE_STRUCTURE);
+    for (HandlerEntry = SmiEntry->SmiHandlers.ForwardLink;
+         HandlerEntry != &SmiEntry->SmiHandlers;
+         HandlerEntry = HandlerEntry->ForwardLink)
+    {
+      Size += sizeof (SMM_CORE_SMI_HANDLER_STATISTICS_STRUCTURE);
+    }
+  }
+
+  return Size;
+}
+
+/**
+  get SMI handler statistics database on the SMI entry list.
+
+  @param SmiEntryList     a list of SMI entry.
+  @param HandlerCategory  The handler category
+  @param Data             The buffer to hold SMI handler statistics database
+
+  @return SMI handler statistics database size on the SMI entry list.
+**/
+UINTN
+GetSmmSmiStatisticsDatabaseData (
+  IN     LIST_ENTRY  *SmiEntryList,
+  IN     UINT32      HandlerCategory,
+  IN OUT VOID        *Data
+  )
+{
+  SMM_CORE_SMI_STATISTICS_DATABASE_STRUCTURE  *SmiStruct;
+  SMM_CORE_SMI_HANDLER_STATISTICS_STRUCTURE   *SmiHandlerStruct;
+  LIST_ENTRY                                  *ListEntry;
+  LIST_ENTRY                                  *HandlerEntry;
+  SMI_ENTRY                                   *SmiEntry;
+  SMI_HANDLER                                 *SmiHandler;
+  UINTN                                       Size;
+
+  SmiStruct = Data;
+  Size      = 0;
+  for (ListEntry = SmiEntryList->ForwardLink;
+       ListEntry != SmiEntryList;
+       ListEntry = ListEntry->ForwardLink)
+  {
+    SmiEntry = CR (ListEntry, SMI_ENTRY, AllEntries, SMI_ENTRY_SIGNATURE);
+
+    SmiStruct->Header.Signature = SMM_CORE_SMI_STATISTICS_DATABASE_SIGNATURE;
+    SmiStruct->Header.Length    = sizeof (SMM_CORE_SMI_STATISTICS_DATABASE_STRUCTURE);
+    SmiStruct->Header.Revision  = SMM_CORE_SMI_STATISTICS_DATABASE_REVISION;
+    SmiStruct->HandlerCategory  = HandlerCategory;
+    SmiStruct->HandlerCount     = 0;
+    CopyGuid (&SmiStruct->HandlerType, &SmiEntry->HandlerType);
+
+    SmiHandlerStruct = (SMM_CORE_SMI_HANDLER_STATISTICS_STRUCTURE *)(SmiStruct + 1);
+    for (HandlerEntry = SmiEntry->SmiHandlers.ForwardLink;
+         HandlerEntry != &SmiEntry->SmiHandlers;
+         HandlerEntry = HandlerEntry->ForwardLink)
+    {
+      SmiHandler                      = CR (HandlerEntry, SMI_HANDLER, Link, SMI_HANDLER_SIGNATURE);
+      SmiHandlerStruct->CallerAddr    = (UINTN)SmiHandler->CallerAddr;
+      SmiHandlerStruct->Handler       = (UINTN)SmiHandler->Handler;
+      SmiHandlerStruct->DispatchCount = SmiHandler->Statistics.DispatchCount;
+      SmiHandlerStruct->TotalCycles   = SmiHandler->Statistics.TotalCycles;
+      SmiHandlerStruct->MaxCycles     = SmiHandler->Statistics.MaxCycles;
+      CopyMem (SmiHandlerStruct->Histogram, SmiHandler->Statistics.Histogram, sizeof (SmiHandlerStruct->Histogram));
+
+      SmiStruct->Header.Length += sizeof (SMM_CORE_SMI_HANDLER_STATISTICS_STRUCTURE);
+      SmiStruct->HandlerCount++;
+      SmiHandlerStruct++;
+    }
+
+    Size     += SmiStruct->Header.Length;
+    SmiStruct = (VOID *)((UINTN)SmiStruct + SmiStruct->Header.Length);
+  }
+
+  return Size;
+}
+
+/**
+  Take a snapshot of the dispatch statistics of all root and GUID SMI handlers.
+
+  The snapshot is returned after the SMI handler profile database by
+  SMI_HANDLER_PROFILE_COMMAND_GET_DATA_BY_OFFSET.
+**/
+VOID
+BuildSmiHandlerStatisticsDatabase (
+  VOID
+  )
+{
+  UINTN  RootSmiSize;
+  UINTN  Size;
+
+  if (mSmiHandlerStatisticsDatabase != NULL) {
+    FreePool (mSmiHandlerStatisticsDatabase);
+    mSmiHandlerStatisticsDatabase     = NULL;
+    mSmiHandlerStatisticsDatabaseSize = 0;
+  }
+
+  if (!mSmiHandlerStatisticsEnabled) {
+    return;
+  }
+
+  RootSmiSize = GetSmmSmiStatisticsDatabaseSize (mSmmCoreRootSmiEntryList);
+  Size        = RootSmiSize + GetSmmSmiStatisticsDatabaseSize (mSmmCoreSmiEntryList);
+
+  mSmiHandlerStatisticsDatabase = AllocatePool (Size);
+  if (mSmiHandlerStatisticsDatabase == NULL) {
+    return;
+  }
+
+  GetSmmSmiStatisticsDatabaseData (mSmmCoreRootSmiEntryList, SmmCoreSmiHandlerCategoryRootHandler, mSmiHandlerStatisticsDatabase);
+  GetSmmSmiStatisticsDatabaseData (mSmmCoreSmiEntryList, SmmCoreSmiHandlerCategoryGuidHandler, (UINT8 *)mSmiHandlerStatisticsDatabase + RootSmiSize);
+  mSmiHandlerStatisticsDatabaseSize = Size;
+}
+
 /**
   Copy SMI handler profile data.
 
@@ -889,20 +1060,40 @@ SmiHandlerProfileCopyData (
   IN OUT UINT64  *DataOffset
   )
 {
-  if (*DataOffset >= mSmiHandlerProfileDatabaseSize) {
-    *DataOffset = mSmiHandlerProfileDatabaseSize;
+  UINTN  TotalSize;
+  UINTN  CopySize;
+
+  //
+  // The statistics snapshot, if any, directly follows the profile database.
+  //
+  TotalSize = mSmiHandlerProfileDatabaseSize + mSmiHandlerStatisticsDatabaseSize;
+  if (*DataOffset >= TotalSize) {
+    *DataOffset = TotalSize;
     return;
   }
 
-  if (mSmiHandlerProfileDatabaseSize - *DataOffset < *DataSize) {
-    *DataSize = mSmiHandlerProfileDatabaseSize - *DataOffset;
+  if (TotalSize - *DataOffset < *DataSize) {
+    *DataSize = TotalSize - *DataOffset;
+  }
+
+  CopySize = 0;
+  if (*DataOffset < mSmiHandlerProfileDatabaseSize) {
+    CopySize = MIN ((UINTN)*DataSize, mSmiHandlerProfileDatabaseSize - (UINTN)*DataOffset);
+    CopyMem (
+      DataBuffer,
+      (UINT8 *)mSmiHandlerProfileDatabase + *DataOffset,
+      CopySize
+      );
+  }
+
+  if (CopySize < *DataSize) {
+    CopyMem (
+      (UINT8 *)DataBuffer + CopySize,
+      (UINT8 *)mSmiHandlerStatisticsDatabase + (UINTN)*DataOffset + CopySize - mSmiHandlerProfileDatabaseSize,
+      (UINTN)*DataSize - CopySize
+      );
   }
 
-  CopyMem (
-    DataBuffer,
-    (UINT8 *)mSmiHandlerProfileDatabase + *DataOffset,
-    (UINTN)*DataSize
-    );
   *DataOffset = *DataOffset + *DataSize;
 }
 
@@ -922,7 +1113,9 @@ SmiHandlerProfileHandlerGetInfo (
   SmiHandlerProfileRecordingStatus  = mSmiHandlerProfileRecordingStatus;
   mSmiHandlerProfileRecordingStatus = FALSE;
 
-  SmiHandlerProfileParameterGetInfo->DataSize            = mSmiHandlerProfileDatabaseSize;
+  BuildSmiHandlerStatisticsDatabase ();
+
+  SmiHandlerProfileParameterGetInfo->DataSize            = mSmiHandlerProfileDatabaseSize + mSmiHandlerStatisticsDatabaseSize;
   SmiHandlerProfileParameterGetInfo->Header.ReturnStatus = 0;
 
   mSmiHandlerProfileRecordingStatus = SmiHandlerProfileRecordingStatus;
@@ -1117,6 +1310,7 @@ SmmCoreFindHardwareSmiEntry (
       SmiEntry->Signature = SMI_ENTRY_SIGNATURE;
       CopyGuid ((VOID *)&SmiEntry->HandlerType, HandlerType);
       InitializeListHead (&SmiEntry->SmiHandlers);
+      InitializeListHead (&SmiEntry->HashLink);
 
       //
       // Add it to SMI entry list
@@ -1390,6 +1584,8 @@ SmmCoreInitializeSmiHandlerProfile (
   if ((PcdGet8 (PcdSmiHandlerProfilePropertyMask) & 0x1) != 0) {
     InsertTailList (&mRootSmiEntryList, &mRootSmiEntry.AllEntries);
 
+    mSmiHandlerStatisticsEnabled = (PcdGet8 (PcdSmiHandlerProfilePropertyMask) & 0x2) != 0;
+
     Status = gSmst->SmmRegisterProtocolNotify (
                       &gEfiSmmReadyToLockProtocolGuid,
                       SmmReadyToLockInSmiHandlerProfile,
@@ -23,7 +23,35 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define LZMAF86_CUSTOM_DECOMPRESS_GUID  \
   { 0xD42AE6BD, 0x1352, 0x4bfb, { 0x90, 0x9A, 0xCA, 0x72, 0xA6, 0xEA, 0xE8, 0x89 } }
 
+///
+/// The Global ID used to identify a section of an FFS file of type
+/// EFI_SECTION_GUID_DEFINED, whose contents have been split into chunks that
+/// were compressed using LZMA independently of each other.
+///
+#define LZMA_CHUNKED_CUSTOM_DECOMPRESS_GUID  \
+  { 0x20C0E64F, 0x499D, 0x41FD, { 0xA6, 0x6F, 0x96, 0xF5, 0x0C, 0x01, 0xF8, 0xE2 } }
+
+#define LZMA_CHUNKED_SIGNATURE  SIGNATURE_32 ('L', 'Z', 'M', 'C')
+
+///
+/// Header of the data of a section compressed with LZMA_CHUNKED_CUSTOM_DECOMPRESS_GUID.
+///
+/// The header is followed by ChunkCount + 1 UINT32 chunk offsets, relative to
+/// the end of the offset table. Chunk N occupies the bytes from ChunkOffset[N]
+/// up to ChunkOffset[N + 1] and is a standard LZMA stream that decodes to
+/// ChunkSize bytes at offset N * ChunkSize of the output, except for the last
+/// chunk, which decodes to the remainder.
+///
+typedef struct {
+  UINT32    Signature;
+  UINT32    DecodedSize;
+  UINT32    ChunkSize;
+  UINT32    ChunkCount;
+  // UINT32 ChunkOffset[ChunkCount + 1];
+} LZMA_CHUNKED_HEADER;
+
 extern GUID  gLzmaCustomDecompressGuid;
 extern GUID  gLzmaF86CustomDecompressGuid;
+extern GUID  gLzmaChunkedCustomDecompressGuid;
 
 #endif
@@ -96,13 +96,46 @@ typedef struct {
   // SMM_CORE_SMI_HANDLER_STRUCTURE      Handler[HandlerCount];
 } SMM_CORE_SMI_DATABASE_STRUCTURE;
 
+#define SMM_CORE_SMI_STATISTICS_DATABASE_SIGNATURE  SIGNATURE_32 ('S','C','S','S')
+#define SMM_CORE_SMI_STATISTICS_DATABASE_REVISION   0x0001
+
+//
+// Dispatch time histogram bucket N counts the dispatches that took
+// [2^N, 2^(N+1)) TSC cycles. The last bucket also counts all longer ones.
+//
+#define SMI_HANDLER_PROFILE_HISTOGRAM_BUCKET_COUNT  32
+
+typedef struct {
+  PHYSICAL_ADDRESS    CallerAddr;
+  PHYSICAL_ADDRESS    Handler;
+  UINT64              DispatchCount;
+  UINT64              TotalCycles;
+  UINT64              MaxCycles;
+  UINT32              Histogram[SMI_HANDLER_PROFILE_HISTOGRAM_BUCKET_COUNT];
+} SMM_CORE_SMI_HANDLER_STATISTICS_STRUCTURE;
+
+//
+// Dispatch statistics of the root and GUID SMI handlers, only present when
+// BIT1 of PcdSmiHandlerProfilePropertyMask is set. They are collected when
+// SMI_HANDLER_PROFILE_COMMAND_GET_INFO is handled.
+//
+typedef struct {
+  SMM_CORE_DATABASE_COMMON_HEADER    Header;
+  EFI_GUID                           HandlerType;
+  UINT32                             HandlerCategory;
+  UINT32                             HandlerCount;
+  // SMM_CORE_SMI_HANDLER_STATISTICS_STRUCTURE  Handler[HandlerCount];
+} SMM_CORE_SMI_STATISTICS_DATABASE_STRUCTURE;
+
 //
 // Layout:
-// +-------------------------------------+
-// | SMM_CORE_IMAGE_DATABASE_STRUCTURE   |
-// +-------------------------------------+
-// | SMM_CORE_SMI_DATABASE_STRUCTURE     |
-// +-------------------------------------+
+// +--------------------------------------------+
+// | SMM_CORE_IMAGE_DATABASE_STRUCTURE          |
+// +--------------------------------------------+
+// | SMM_CORE_SMI_DATABASE_STRUCTURE            |
+// +--------------------------------------------+
+// | SMM_CORE_SMI_STATISTICS_DATABASE_STRUCTURE | (optional)
+// +--------------------------------------------+
 //
 
 //
@@ -57,140 +57,216 @@ BrFree (
 }
 
 /**
-  Decompresses a Brotli compressed source buffer.
+  Get the size of the uncompressed buffer by parsing EncodeData header.
 
-  Extracts decompressed data to its original form.
-  If the compressed source data specified by Source is successfully decompressed
-  into Destination, then EFI_SUCCESS is returned. If the compressed source data
-  specified by Source is not in a valid compressed data format,
-  then EFI_INVALID_PARAMETER is returned.
+  @param EncodedData  Pointer to the compressed data.
+  @param StartOffset  Start offset of the compressed data.
+  @param EndOffset    End offset of the compressed data.
 
-  @param  Source      The source buffer containing the compressed data.
-  @param  SourceSize  The size of source buffer.
-  @param  Destination The destination buffer to store the decompressed data.
-  @param  DestSize    The destination buffer size.
-  @param  BuffInfo    The pointer to the BROTLI_BUFF instance.
+  @return The size of the uncompressed buffer.
+**/
+UINT64
+BrGetDecodedSizeOfBuf (
+  IN UINT8  *EncodedData,
+  IN UINT8  StartOffset,
+  IN UINT8  EndOffset
+  )
+{
+  UINT64  DecodedSize;
+  INTN    Index;
 
-  @retval EFI_SUCCESS Decompression completed successfully, and
-                      the uncompressed buffer is returned in Destination.
-  @retval EFI_INVALID_PARAMETER
-                      The source buffer specified by Source is corrupted
-                      (not in a valid compressed format).
+  /* Parse header */
+  DecodedSize = 0;
+  for (Index = EndOffset - 1; Index >= StartOffset; Index--) {
+    DecodedSize = LShiftU64 (DecodedSize, 8) + EncodedData[Index];
+  }
+
+  return DecodedSize;
+}
+
+/**
+  Get the size of the scratch buffer needed to decompress a source buffer.
+
+  The compression tool records the memory used by the decoder plus two file
+  buffers for staging the input and the output. The decoder reads from the
+  source buffer and writes to the destination buffer directly, so the memory
+  of the staging buffers is not reserved.
+
+  @param Source  The source buffer containing the compressed data.
+
+  @return The size of the scratch buffer.
+**/
+STATIC
+UINT64
+BrGetScratchSize (
+  IN CONST VOID  *Source
+  )
+{
+  UINT64  ScratchSize;
+
+  ScratchSize = BrGetDecodedSizeOfBuf ((UINT8 *)Source, BROTLI_SCRATCH_MAX - BROTLI_INFO_SIZE, BROTLI_SCRATCH_MAX);
+  if (ScratchSize > 2 * FILE_BUFFER_SIZE) {
+    ScratchSize -= 2 * FILE_BUFFER_SIZE;
+  }
+
+  return ScratchSize;
+}
+
+/**
+  Start an incremental decompression of a Brotli compressed source buffer.
+
+  @param[in]  Source       The source buffer containing the compressed data
+                           including the BROTLI_SCRATCH_MAX byte header.
+  @param[in]  SourceSize   The size of source buffer.
+  @param[in]  Scratch      The scratch buffer of the size returned by
+                           BrotliUefiDecompressGetInfo(). It must stay valid
+                           until BrotliUefiDecompressStreamClose().
+  @param[out] Stream       The stream to initialize.
+
+  @retval EFI_SUCCESS            The stream is ready.
+  @retval EFI_INVALID_PARAMETER  The source buffer is too small or the decoder
+                                 does not fit into the scratch buffer.
 **/
 EFI_STATUS
-BrotliDecompress (
-  IN CONST VOID  *Source,
-  IN UINTN       SourceSize,
-  IN OUT VOID    *Destination,
-  IN OUT UINTN   *DestSize,
-  IN VOID        *BuffInfo
+BrotliUefiDecompressStreamOpen (
+  IN  CONST VOID                *Source,
+  IN  UINTN                     SourceSize,
+  IN  VOID                      *Scratch,
+  OUT BROTLI_DECOMPRESS_STREAM  *Stream
   )
 {
-  UINT8                *Input;
-  UINT8                *Output;
-  const UINT8          *NextIn;
-  UINT8                *NextOut;
-  size_t               TotalOut;
-  size_t               AvailableIn;
-  size_t               AvailableOut;
-  VOID                 *Temp;
-  BrotliDecoderResult  Result;
-  BrotliDecoderState   *BroState;
-
-  TotalOut     = 0;
-  AvailableOut = FILE_BUFFER_SIZE;
-  Result       = BROTLI_DECODER_RESULT_ERROR;
-  BroState     = BrotliDecoderCreateInstance (BrAlloc, BrFree, BuffInfo);
-  Temp         = Destination;
-
-  if (BroState == NULL) {
+  ZeroMem (Stream, sizeof (*Stream));
+  if (SourceSize < BROTLI_SCRATCH_MAX) {
     return EFI_INVALID_PARAMETER;
   }
 
-  Input  = (UINT8 *)BrAlloc (BuffInfo, FILE_BUFFER_SIZE);
-  Output = (UINT8 *)BrAlloc (BuffInfo, FILE_BUFFER_SIZE);
-  if ((Input == NULL) || (Output == NULL)) {
-    BrFree (BuffInfo, Input);
-    BrFree (BuffInfo, Output);
-    BrotliDecoderDestroyInstance (BroState);
+  Stream->Buff.Buff     = Scratch;
+  Stream->Buff.BuffSize = (UINTN)BrGetScratchSize (Source);
+  Stream->NextIn        = (CONST UINT8 *)Source + BROTLI_SCRATCH_MAX;
+  Stream->AvailableIn   = SourceSize - BROTLI_SCRATCH_MAX;
+  Stream->Result        = BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT;
+  Stream->DecodedSize   = BrGetDecodedSizeOfBuf (
+                            (UINT8 *)Source,
+                            BROTLI_DECODE_MAX - BROTLI_INFO_SIZE,
+                            BROTLI_DECODE_MAX
+                            );
+
+  Stream->State = BrotliDecoderCreateInstance (BrAlloc, BrFree, &Stream->Buff);
+  if (Stream->State == NULL) {
     return EFI_INVALID_PARAMETER;
   }
 
-  NextOut = Output;
-  Result  = BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT;
-  while (1) {
-    if (Result == BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT) {
-      if (SourceSize == 0) {
-        break;
-      }
-
-      if (SourceSize >= FILE_BUFFER_SIZE) {
-        AvailableIn = FILE_BUFFER_SIZE;
-      } else {
-        AvailableIn = SourceSize;
-      }
-
-      CopyMem (Input, Source, AvailableIn);
-      Source      = (VOID *)((UINT8 *)Source + AvailableIn);
-      SourceSize -= AvailableIn;
-      NextIn      = Input;
-    } else if (Result == BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT) {
-      CopyMem (Temp, Output, FILE_BUFFER_SIZE);
-      AvailableOut = FILE_BUFFER_SIZE;
-      Temp         = (VOID *)((UINT8 *)Temp +FILE_BUFFER_SIZE);
-      NextOut      = Output;
-    } else {
-      break; /* Error or success. */
-    }
+  return EFI_SUCCESS;
+}
+
+/**
+  Decompress the next bytes of a stream into a caller buffer.
+
+  @param[in,out] Stream      The stream.
+  @param[out]    Buffer      The buffer that receives the decompressed bytes.
+  @param[in,out] BufferSize  On input, the size of Buffer. On output, the
+                             number of bytes written to Buffer.
+
+  @retval EFI_SUCCESS            Buffer was filled, or the stream ended after
+                                 *BufferSize bytes.
+  @retval EFI_END_OF_FILE        The stream had already ended, nothing was
+                                 written.
+  @retval EFI_INVALID_PARAMETER  The source buffer is corrupted, or decodes to
+                                 more or less than its header says.
+**/
+EFI_STATUS
+BrotliUefiDecompressStreamRead (
+  IN OUT BROTLI_DECOMPRESS_STREAM  *Stream,
+  OUT    VOID                      *Buffer,
+  IN OUT UINTN                     *BufferSize
+  )
+{
+  UINT8   *NextOut;
+  size_t  AvailableOut;
+
+  if (Stream->Result == BROTLI_DECODER_RESULT_SUCCESS) {
+    *BufferSize = 0;
+    return EFI_END_OF_FILE;
+  }
+
+  if (Stream->Result != BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT) {
+    *BufferSize = 0;
+    return EFI_INVALID_PARAMETER;
+  }
 
-    Result = BrotliDecoderDecompressStream (
-               BroState,
-               &AvailableIn,
-               &NextIn,
-               &AvailableOut,
-               &NextOut,
-               &TotalOut
-               );
+  //
+  // Never let the decoder write past the size recorded in the header.
+  //
+  AvailableOut = *BufferSize;
+  if (AvailableOut > Stream->DecodedSize - Stream->TotalOut) {
+    AvailableOut = (size_t)(Stream->DecodedSize - Stream->TotalOut);
   }
 
-  if (NextOut != Output) {
-    CopyMem (Temp, Output, (size_t)(NextOut - Output));
+  NextOut        = Buffer;
+  Stream->Result = BrotliDecoderDecompressStream (
+                     Stream->State,
+                     &Stream->AvailableIn,
+                     &Stream->NextIn,
+                     &AvailableOut,
+                     &NextOut,
+                     NULL
+                     );
+  if ((Stream->Result == BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT) &&
+      (Stream->TotalOut + (UINTN)(NextOut - (UINT8 *)Buffer) == Stream->DecodedSize))
+  {
+    //
+    // All the bytes the header announces were produced. Let the decoder
+    // finish the stream, which must not produce any more output.
+    //
+    AvailableOut   = 0;
+    Stream->Result = BrotliDecoderDecompressStream (
+                       Stream->State,
+                       &Stream->AvailableIn,
+                       &Stream->NextIn,
+                       &AvailableOut,
+                       &NextOut,
+                       NULL
+                       );
+    if (Stream->Result == BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT) {
+      Stream->Result = BROTLI_DECODER_RESULT_ERROR;
+    }
   }
 
-  *DestSize = TotalOut;
+  *BufferSize       = (UINTN)(NextOut - (UINT8 *)Buffer);
+  Stream->TotalOut += *BufferSize;
 
-  BrFree (BuffInfo, Input);
-  BrFree (BuffInfo, Output);
-  BrotliDecoderDestroyInstance (BroState);
-  return (Result == BROTLI_DECODER_RESULT_SUCCESS) ? EFI_SUCCESS : EFI_INVALID_PARAMETER;
+  if ((Stream->Result == BROTLI_DECODER_RESULT_SUCCESS) && (Stream->TotalOut != Stream->DecodedSize)) {
+    Stream->Result = BROTLI_DECODER_RESULT_ERROR;
+  }
+
+  //
+  // The whole source is handed to the decoder at once, so asking for more
+  // input means that the source is truncated.
+  //
+  if ((Stream->Result == BROTLI_DECODER_RESULT_ERROR) ||
+      (Stream->Result == BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT))
+  {
+    Stream->Result = BROTLI_DECODER_RESULT_ERROR;
+    return EFI_INVALID_PARAMETER;
+  }
+
+  return EFI_SUCCESS;
 }
 
 /**
-  Get the size of the uncompressed buffer by parsing EncodeData header.
+  Release the decoder of a stream.
 
-  @param EncodedData  Pointer to the compressed data.
-  @param StartOffset  Start offset of the compressed data.
-  @param EndOffset    End offset of the compressed data.
-
-  @return The size of the uncompressed buffer.
+  @param[in,out] Stream  The stream.
 **/
-UINT64
-BrGetDecodedSizeOfBuf (
-  IN UINT8  *EncodedData,
-  IN UINT8  StartOffset,
-  IN UINT8  EndOffset
+VOID
+BrotliUefiDecompressStreamClose (
+  IN OUT BROTLI_DECOMPRESS_STREAM  *Stream
   )
 {
-  UINT64  DecodedSize;
-  INTN    Index;
-
-  /* Parse header */
-  DecodedSize = 0;
-  for (Index = EndOffset - 1; Index >= StartOffset; Index--) {
-    DecodedSize = LShiftU64 (DecodedSize, 8) + EncodedData[Index];
+  if (Stream->State != NULL) {
+    BrotliDecoderDestroyInstance (Stream->State);
+    Stream->State = NULL;
   }
-
-  return DecodedSize;
 }
 
 /**
@@ -239,8 +315,7 @@ BrotliUefiDecompressGetInfo (
   MaxOffset        = BROTLI_DECODE_MAX;
   GetSize          = BrGetDecodedSizeOfBuf ((UINT8 *)Source, MaxOffset - BROTLI_INFO_SIZE, MaxOffset);
   *DestinationSize = (UINT32)GetSize;
-  MaxOffset        = BROTLI_SCRATCH_MAX;
-  GetSize          = BrGetDecodedSizeOfBuf ((UINT8 *)Source, MaxOffset - BROTLI_INFO_SIZE, MaxOffset);
+  GetSize          = BrGetScratchSize (Source);
   *ScratchSize     = (UINT32)GetSize;
   return EFI_SUCCESS;
 }
@@ -276,25 +351,25 @@ BrotliUefiDecompress (
   IN OUT VOID    *Scratch
   )
 {
-  UINTN        DestSize = 0;
-  EFI_STATUS   Status;
-  BROTLI_BUFF  BroBuff;
-  UINT64       GetSize;
-  UINT8        MaxOffset;
-
-  MaxOffset = BROTLI_SCRATCH_MAX;
-  GetSize   = BrGetDecodedSizeOfBuf ((UINT8 *)Source, MaxOffset - BROTLI_INFO_SIZE, MaxOffset);
-
-  BroBuff.Buff     = Scratch;
-  BroBuff.BuffSize = (UINTN)GetSize;
-
-  Status = BrotliDecompress (
-             (VOID *)((UINT8 *)Source + BROTLI_SCRATCH_MAX),
-             SourceSize - BROTLI_SCRATCH_MAX,
-             Destination,
-             &DestSize,
-             (VOID *)(&BroBuff)
-             );
+  EFI_STATUS                Status;
+  BROTLI_DECOMPRESS_STREAM  Stream;
+  UINTN                     DestSize;
+
+  Status = BrotliUefiDecompressStreamOpen (Source, SourceSize, Scratch, &Stream);
+  if (EFI_ERROR (Status)) {
+    BrotliUefiDecompressStreamClose (&Stream);
+    return Status;
+  }
+
+  //
+  // Decode the whole stream in one go, straight into Destination.
+  //
+  DestSize = (UINTN)Stream.DecodedSize;
+  Status   = BrotliUefiDecompressStreamRead (&Stream, Destination, &DestSize);
+  if (!EFI_ERROR (Status) && (Stream.Result != BROTLI_DECODER_RESULT_SUCCESS)) {
+    Status = EFI_INVALID_PARAMETER;
+  }
 
+  BrotliUefiDecompressStreamClose (&Stream);
   return Status;
 }
@@ -26,6 +26,76 @@ typedef struct {
 #define BROTLI_DECODE_MAX   8
 #define BROTLI_SCRATCH_MAX  16
 
+///
+/// State of an incremental decompression. The decoder writes straight into
+/// the buffers passed to BrotliUefiDecompressStreamRead() and reads straight
+/// from the source buffer, so no staging copies are made.
+///
+typedef struct {
+  BrotliDecoderState     *State;
+  BROTLI_BUFF            Buff;
+  CONST UINT8            *NextIn;
+  size_t                 AvailableIn;
+  BrotliDecoderResult    Result;
+  UINT64                 DecodedSize;
+  UINT64                 TotalOut;
+} BROTLI_DECOMPRESS_STREAM;
+
+/**
+  Start an incremental decompression of a Brotli compressed source buffer.
+
+  @param[in]  Source       The source buffer containing the compressed data
+                           including the BROTLI_SCRATCH_MAX byte header.
+  @param[in]  SourceSize   The size of source buffer.
+  @param[in]  Scratch      The scratch buffer of the size returned by
+                           BrotliUefiDecompressGetInfo(). It must stay valid
+                           until BrotliUefiDecompressStreamClose().
+  @param[out] Stream       The stream to initialize.
+
+  @retval EFI_SUCCESS            The stream is ready.
+  @retval EFI_INVALID_PARAMETER  The source buffer is too small or the decoder
+                                 does not fit into the scratch buffer.
+**/
+EFI_STATUS
+BrotliUefiDecompressStreamOpen (
+  IN  CONST VOID                *Source,
+  IN  UINTN                     SourceSize,
+  IN  VOID                      *Scratch,
+  OUT BROTLI_DECOMPRESS_STREAM  *Stream
+  );
+
+/**
+  Decompress the next bytes of a stream into a caller buffer.
+
+  @param[in,out] Stream      The stream.
+  @param[out]    Buffer      The buffer that receives the decompressed bytes.
+  @param[in,out] BufferSize  On input, the size of Buffer. On output, the
+                             number of bytes written to Buffer.
+
+  @retval EFI_SUCCESS            Buffer was filled, or the stream ended after
+                                 *BufferSize bytes.
+  @retval EFI_END_OF_FILE        The stream had already ended, nothing was
+                                 written.
+  @retval EFI_INVALID_PARAMETER  The source buffer is corrupted, or decodes to
+                                 more or less than its header says.
+**/
+EFI_STATUS
+BrotliUefiDecompressStreamRead (
+  IN OUT BROTLI_DECOMPRESS_STREAM  *Stream,
+  OUT    VOID                      *Buffer,
+  IN OUT UINTN                     *BufferSize
+  );
+
+/**
+  Release the decoder of a stream.
+
+  @param[in,out] Stream  The stream.
+**/
+VOID
+BrotliUefiDecompressStreamClose (
+  IN OUT BROTLI_DECOMPRESS_STREAM  *Stream
+  );
+
 EFI_STATUS
 EFIAPI
 BrotliUefiDecompressGetInfo (
@@ -0,0 +1,555 @@
+/** @file
+  Unit tests and benchmark of the Brotli decompression.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <BrotliDecompressLibInternal.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UnitTestLib.h>
+
+#define UNIT_TEST_APP_NAME     "BrotliDecompress Unit Tests"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+#define TEST_DECODED_SIZE       SIZE_512KB
+#define TEST_STREAM_PIECE_SIZE  1000
+#define TEST_BENCHMARK_PIECE    SIZE_4KB
+#define TEST_BENCHMARK_ROUNDS   32
+#define TEST_GUARD_SIZE         16
+#define TEST_GUARD_BYTE         0xA5
+
+///
+/// TEST_DECODED_SIZE bytes produced by TestPattern(), compressed at quality
+/// 9 with the header of the BrotliCompress tool: the decoded size and the
+/// scratch size, which includes two 512KB staging buffers.
+///
+STATIC CONST UINT8  mTestSource[] = {
+  0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x77, 0x76, 0x18, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x5b, 0xff, 0xff, 0x07, 0x40, 0xec, 0x70, 0x14,
+  0x2b, 0x67, 0x98, 0xf8, 0x43, 0xa5, 0x0b, 0x8b, 0x73, 0x63, 0x62, 0x8a,
+  0xd7, 0xd9, 0x4a, 0x49, 0x47, 0x28, 0x4a, 0x6e, 0xa6, 0x7d, 0xc0, 0xda,
+  0x7f, 0xe8, 0x7f, 0x26, 0x1a, 0x23, 0x5d, 0x96, 0xbb, 0x21, 0xa1, 0x7e,
+  0x92, 0xbf, 0xc7, 0x22, 0x98, 0xd4, 0xdd, 0x9f, 0xe8, 0xdf, 0x88, 0x47,
+  0x18, 0xc9, 0xe8, 0x8d, 0x74, 0x64, 0x23, 0x1f, 0xfd, 0x51, 0x8c, 0x72,
+  0x54, 0xa3, 0x1e, 0xcd, 0x68, 0x47, 0x97, 0xa6, 0x19, 0x5c, 0xb7, 0x2d,
+  0xf7, 0x79, 0x99, 0xc9, 0x92, 0x25, 0x4b, 0x96, 0x2c, 0x59, 0xb2, 0x64,
+  0xc9, 0x92, 0x25, 0x4b, 0x96, 0x2c, 0xc7, 0x7c, 0x49, 0x34, 0x64, 0x50,
+  0xdf, 0x1a, 0x78, 0x77, 0x8e, 0xa0, 0x31, 0x46, 0x20, 0x10, 0x08, 0x04,
+  0x9a, 0xe3, 0xe8, 0x18, 0x49, 0xcc, 0x0c, 0xe6, 0x36, 0x54, 0xe3, 0x50,
+  0x8d, 0x44, 0x35, 0x1e, 0x81, 0x40, 0xe7, 0x08, 0x04, 0xa2, 0xf4, 0x19,
+  0x84, 0x80, 0x03, 0x0b, 0xc7, 0x90, 0x3a, 0x87, 0x55, 0xd4, 0x63, 0x58,
+  0xad, 0x21, 0xb1, 0x98, 0x01, 0x76, 0x48, 0xd5, 0xe1, 0x54, 0x54, 0x87,
+  0x55, 0x1d, 0x3a, 0x28, 0x6b, 0xe0, 0x0b, 0xd4, 0xae, 0xa2, 0xa2, 0x12,
+  0x9d, 0x19, 0xa8, 0x0e, 0xd3, 0x31, 0x6b, 0x80, 0xb1, 0xd4, 0xae, 0xaf,
+  0x41, 0x8e, 0x86, 0x1c, 0x13, 0x81, 0x40, 0x8e, 0x8a, 0x40, 0x20, 0xa2,
+  0x21, 0x83, 0xfa, 0x3a, 0x58, 0x2a, 0xd5, 0x80, 0x8e, 0x6b, 0xf3, 0x35,
+  0xaa, 0xc3, 0xa9, 0x0e, 0xa9, 0x3a, 0xac, 0x4a, 0xe9, 0x33, 0x08, 0x81,
+  0x1a, 0xd8, 0xf0, 0x6b, 0x90, 0xb1, 0xd0, 0x4e, 0xd7, 0x3f, 0x83, 0x58,
+  0xcd, 0x96, 0x0a, 0xad, 0x99, 0x3f, 0x83, 0x1d, 0x1d, 0xa8, 0xef, 0xa1,
+  0xee, 0x83, 0x9a, 0xa1, 0x3a, 0x86, 0x69, 0x9a, 0xc1, 0xfb, 0x1c, 0x52,
+  0x75, 0x38, 0x15, 0xd5, 0x61, 0x55, 0x87, 0x6e, 0xfd, 0x0c, 0xea, 0x5b,
+  0x03, 0xef, 0x66, 0x8c, 0xc6, 0x08, 0x8d, 0x31, 0x9a, 0x23, 0x68, 0x8e,
+  0xa1, 0x39, 0x8a, 0xe6, 0xb8, 0xba, 0x86, 0x97, 0x98, 0x19, 0xcc, 0x6d,
+  0xea, 0x35, 0x1e, 0xaa, 0x91, 0xa8, 0xc6, 0xa2, 0x1a, 0x8d, 0x3a, 0x3a,
+  0x47, 0xa0, 0x73, 0x4c, 0xe9, 0x33, 0x50, 0x1d, 0x42, 0x75, 0x18, 0xd5,
+  0xa1, 0x54, 0x87, 0x6b, 0x82, 0x0c, 0x1a, 0xae, 0x06, 0xc4, 0x12, 0xe5,
+  0x75, 0xe0, 0xa0, 0xac, 0x81, 0x61, 0xb6, 0x06, 0xdd, 0x3a, 0xbd, 0x74,
+  0x0e, 0x94, 0xa6, 0x5c, 0xf7, 0x19, 0x39, 0x22, 0x72, 0x3c, 0x04, 0x02,
+  0x81, 0x1c, 0x17, 0x81, 0x88, 0x86, 0x0c, 0x54, 0x87, 0x51, 0x1d, 0x4a,
+  0x45, 0x85, 0x67, 0x90, 0x4a, 0x35, 0xa0, 0xe3, 0x98, 0x5d, 0x75, 0x38,
+  0xd5, 0x21, 0x55, 0x87, 0x55, 0x29, 0x7d, 0x06, 0x2a, 0x6a, 0x57, 0x51,
+  0x69, 0x82, 0x0c, 0x0a, 0xbe, 0x06, 0x17, 0x8b, 0x9c, 0x6e, 0xdc, 0x83,
+  0xa6, 0x75, 0x1d, 0xb0, 0x51, 0xc8, 0xe0, 0x7b, 0x30, 0xd6, 0x20, 0x83,
+  0xad, 0x43, 0x0d, 0x7a, 0x45, 0x2a, 0x5e, 0x83, 0xbc, 0xa0, 0xbe, 0x18,
+  0x6b, 0x50, 0x4f, 0xee, 0x5c, 0x83, 0xfe, 0xd4, 0x3e, 0xb7, 0xa1, 0x1a,
+  0x87, 0x6a, 0x24, 0xaa, 0xf1, 0x08, 0x04, 0x3a, 0x47, 0x20, 0x10, 0xa5,
+  0xcf, 0x20, 0x04, 0x1c, 0x58, 0x98, 0xc3, 0xea, 0x31, 0xa4, 0x1e, 0xc3,
+  0x2a, 0x2a, 0xb1, 0x98, 0xc1, 0xe9, 0xee, 0x3d, 0x68, 0x82, 0xb2, 0x06,
+  0x66, 0xf0, 0x3d, 0x18, 0x6b, 0xd0, 0x55, 0x87, 0xa9, 0xd8, 0x1a, 0x5c,
+  0x2c, 0xb6, 0xeb, 0xcf, 0x8c, 0x1c, 0x11, 0x39, 0x1e, 0x02, 0x81, 0x40,
+  0x8e, 0x8b, 0x40, 0x44, 0x43, 0x06, 0xf5, 0x75, 0xc0, 0x54, 0xaa, 0x01,
+  0x1d, 0xd7, 0xe6, 0x6b, 0x54, 0x87, 0x54, 0x1d, 0x4e, 0x45, 0x75, 0xd8,
+  0xd2, 0x67, 0x10, 0x02, 0x35, 0xb0, 0xe1, 0xd6, 0x00, 0x63, 0xa9, 0x9d,
+  0xae, 0x7c, 0x06, 0x50, 0x75, 0x08, 0xd5, 0x61, 0x54, 0x87, 0x52, 0x1d,
+  0x2e, 0x28, 0x32, 0x08, 0xea, 0xef, 0x20, 0xfa, 0xeb, 0xa1, 0xbe, 0x87,
+  0xba, 0x0f, 0x6a, 0x86, 0xea, 0x18, 0xa6, 0x69, 0x06, 0xef, 0x73, 0x48,
+  0xd5, 0xe1, 0x54, 0x54, 0x87, 0x55, 0x1d, 0xba, 0xf5, 0x33, 0xa8, 0x6f,
+  0x0d, 0xbc, 0x3b, 0xc6, 0x68, 0x8e, 0xa0, 0x39, 0x86, 0xc6, 0x08, 0x75,
+  0xd4, 0x51, 0x57, 0xd7, 0xf0, 0x12, 0x33, 0x83, 0xb9, 0x0d, 0xd5, 0x48,
+  0x54, 0x63, 0x51, 0x8d, 0x46, 0x35, 0x5e, 0xbd, 0xc6, 0x44, 0x0d, 0xb5,
+  0xd2, 0x67, 0xa0, 0x3a, 0x8c, 0xea, 0x50, 0x2a, 0x2a, 0x4d, 0x90, 0x41,
+  0xc3, 0xd5, 0x80, 0x58, 0xa2, 0xbc, 0x0e, 0x1c, 0x94, 0x35, 0x30, 0x83,
+  0x7f, 0x07, 0xa3, 0x1a, 0xf4, 0x8a, 0xaf, 0xc1, 0xc5, 0x22, 0x39, 0xd9,
+  0x55, 0x87, 0x51, 0x1d, 0xea, 0xf7, 0x6b, 0xa9, 0x54, 0x03, 0x3a, 0x2e,
+  0x83, 0xb9, 0xcf, 0xaa, 0x43, 0xaa, 0x0e, 0xa7, 0xa2, 0x3a, 0x6c, 0xe9,
+  0x33, 0x50, 0x51, 0xbb, 0x8a, 0x4a, 0x13, 0x64, 0xd0, 0x70, 0x6b, 0x80,
+  0xb1, 0xc4, 0xe9, 0xea, 0x3d, 0x68, 0x5a, 0xd7, 0x01, 0x1b, 0x85, 0x8d,
+  0xc2, 0x77, 0x20, 0xdd, 0x71, 0x64, 0x90, 0x4a, 0xd7, 0x00, 0x1d, 0xf7,
+  0x1d, 0x80, 0x3b, 0x6e, 0x0d, 0x30, 0x95, 0xfa, 0xdc, 0x86, 0x6a, 0x1c,
+  0xaa, 0x91, 0xa8, 0xc6, 0x23, 0x10, 0xe8, 0x1c, 0x81, 0x40, 0x94, 0x3e,
+  0x83, 0x10, 0x70, 0x60, 0xe1, 0x18, 0x52, 0xe7, 0xb0, 0x8a, 0x7a, 0x0c,
+  0xab, 0x35, 0x24, 0x16, 0x33, 0x38, 0x5d, 0xdc, 0x83, 0x26, 0x28, 0x6b,
+  0xe0, 0x46, 0xe1, 0x77, 0x20, 0xc5, 0x5d, 0x75, 0x98, 0x8e, 0x59, 0x03,
+  0x8c, 0xa5, 0x76, 0x7d, 0x0d, 0x72, 0x34, 0xe4, 0x98, 0x08, 0x04, 0x72,
+  0x54, 0x04, 0x02, 0x11, 0x0d, 0x19, 0xd4, 0xd7, 0xc1, 0x52, 0xa9, 0x06,
+  0x74, 0x5c, 0x9b, 0xaf, 0x51, 0x1d, 0x4e, 0x75, 0x48, 0xd5, 0x61, 0x55,
+  0x4a, 0x9f, 0x41, 0x08, 0xd4, 0xc0, 0x86, 0x5f, 0x83, 0x8c, 0x85, 0x76,
+  0xba, 0xf7, 0x19, 0xc4, 0x6a, 0xb6, 0x54, 0x68, 0x1b, 0x85, 0xef, 0x40,
+  0x8a, 0x51, 0xdf, 0x43, 0xdd, 0x07, 0x35, 0x43, 0x75, 0x0c, 0xd3, 0x34,
+  0x83, 0xf7, 0x39, 0xa4, 0xea, 0x70, 0x2a, 0xaa, 0xc3, 0xaa, 0x0e, 0xdd,
+  0xfa, 0x19, 0xd4, 0xb7, 0x06, 0xde, 0xcd, 0x18, 0x8d, 0x11, 0x1a, 0x63,
+  0x34, 0x47, 0xd0, 0x1c, 0x43, 0x73, 0x14, 0xcd, 0x71, 0x75, 0x0d, 0x2f,
+  0x31, 0x33, 0x98, 0xdb, 0xd4, 0x6b, 0x3c, 0x54, 0x23, 0x51, 0x8d, 0x45,
+  0x35, 0x1a, 0x75, 0x74, 0x8e, 0x40, 0xe7, 0x98, 0xd2, 0x67, 0xa0, 0x3a,
+  0x84, 0xea, 0x30, 0xaa, 0x43, 0xa9, 0x0e, 0xd7, 0x04, 0x19, 0x34, 0x5c,
+  0x0d, 0x88, 0x25, 0x1e, 0x01, 0xfd, 0x0c, 0x40, 0x33, 0x80, 0x8d, 0xc2,
+  0xef, 0x40, 0x8a, 0x09, 0x81, 0x9e, 0x01, 0x5c, 0xf7, 0x19, 0x39, 0x22,
+  0x72, 0x3c, 0x04, 0x02, 0x81, 0x1c, 0x17, 0x81, 0x88, 0x86, 0x0c, 0x54,
+  0x87, 0x51, 0x1d, 0x4a, 0x45, 0x85, 0x67, 0x90, 0x4a, 0x35, 0xa0, 0xe3,
+  0x98, 0x5d, 0x75, 0x38, 0xd5, 0x21, 0x55, 0x87, 0x55, 0x29, 0x7d, 0x06,
+  0x2a, 0x6a, 0x57, 0x51, 0x69, 0x82, 0x0c, 0x0a, 0xbe, 0x06, 0x17, 0x8b,
+  0x3c, 0x02, 0xf8, 0x19, 0x80, 0x66, 0x00, 0x7b, 0x80, 0x67, 0x40, 0xfa,
+  0x19, 0x6c, 0x1d, 0x6a, 0xd0, 0x2b, 0x52, 0xf1, 0x1a, 0xa4, 0xe2, 0xdf,
+  0x01, 0xd8, 0x58, 0x83, 0xfa, 0x47, 0x01, 0x9e, 0x81, 0xcb, 0xdc, 0x86,
+  0x6a, 0x1c, 0xaa, 0x91, 0xa8, 0xc6, 0x23, 0x10, 0xe8, 0x1c, 0x81, 0x40,
+  0x94, 0x3e, 0x83, 0x10, 0x70, 0x60, 0x61, 0x0e, 0xab, 0xc7, 0x90, 0x7a,
+  0x0c, 0xab, 0xa8, 0xc4, 0x62, 0x06, 0xa7, 0x6b, 0xf7, 0xa0, 0x09, 0xca,
+  0x1a, 0xb8, 0x07, 0x78, 0x06, 0xa4, 0x9f, 0xd1, 0x55, 0x87, 0xa9, 0xd8,
+  0x1a, 0x5c, 0x2c, 0xb6, 0xeb, 0xcf, 0x8c, 0x1c, 0x11, 0x39, 0x1e, 0x02,
+  0x81, 0x40, 0x8e, 0x8b, 0x40, 0x44, 0x43, 0x06, 0xf5, 0x75, 0xc0, 0x54,
+  0xaa, 0x01, 0x1d, 0xd7, 0xe6, 0x6b, 0x54, 0x87, 0x54, 0x1d, 0x4e, 0x45,
+  0x75, 0xd8, 0xd2, 0x67, 0x10, 0x02, 0x35, 0xb0, 0xe1, 0xd6, 0x00, 0x63,
+  0xa9, 0x9d, 0x6e, 0x7d, 0x06, 0x50, 0x75, 0x08, 0xd5, 0x61, 0x54, 0x87,
+  0x52, 0x1d, 0x2e, 0x28, 0x32, 0xd8, 0x28, 0xfc, 0x0d, 0xa4, 0x30, 0xea,
+  0x7b, 0xa8, 0xfb, 0xa0, 0x66, 0xa8, 0x8e, 0x61, 0x9a, 0x66, 0xf0, 0x3e,
+  0x87, 0x54, 0x1d, 0x4e, 0x45, 0x75, 0x58, 0xd5, 0xa1, 0x5b, 0x3f, 0x83,
+  0xfa, 0xd6, 0xc0, 0xbb, 0x63, 0x8c, 0xe6, 0x08, 0x9a, 0x63, 0x68, 0x8c,
+  0x50, 0x47, 0x1d, 0x75, 0x75, 0x0d, 0x2f, 0x31, 0x33, 0x98, 0xdb, 0x50,
+  0x8d, 0x44, 0x35, 0x16, 0xd5, 0x68, 0x54, 0xe3, 0xd5, 0x6b, 0x4c, 0xd4,
+  0x50, 0x2b, 0x7d, 0x06, 0xaa, 0xc3, 0xa8, 0x0e, 0xa5, 0xa2, 0xd2, 0x04,
+  0x19, 0x34, 0x5c, 0x0d, 0x88, 0x25, 0x1e, 0x01, 0xf4, 0x0c, 0x40, 0x33,
+  0x80, 0x3d, 0xc0, 0xdf, 0x80, 0xf4, 0x33, 0xa8, 0xf8, 0x1a, 0x5c, 0x2c,
+  0x92, 0x93, 0x5d, 0x75, 0x18, 0xd5, 0xa1, 0x54, 0x54, 0x78, 0x06, 0xa9,
+  0x54, 0x03, 0x3a, 0x8e, 0xb9, 0xcf, 0xaa, 0x43, 0xaa, 0x0e, 0xa7, 0xa2,
+  0x3a, 0x6c, 0xe9, 0x33, 0x50, 0x51, 0xbb, 0x8a, 0x4a, 0x13, 0x64, 0xd0,
+  0x70, 0x6b, 0x80, 0xb1, 0xc4, 0x23, 0x60, 0x9e, 0x01, 0x68, 0x06, 0xf0,
+  0xf7, 0x05, 0x00, 0xf0, 0x3b, 0xf8, 0x7f, 0x35, 0x39, 0xc5, 0x57, 0x53,
+  0xdf, 0x1a, 0x18, 0xe6, 0xed, 0xab, 0x5b, 0x0f, 0xf2, 0xd5, 0x84, 0x80,
+  0x03, 0x87, 0x79, 0xfb, 0xdf, 0x15, 0x5e, 0x20, 0xff, 0x07, 0x00, 0x00,
+};
+
+/**
+  Return the expected byte at a given offset of the decoded data.
+
+  @param[in] Index  The offset.
+
+  @return The byte.
+**/
+STATIC
+UINT8
+TestPattern (
+  IN UINTN  Index
+  )
+{
+  return (UINT8)"0123456789ABCDEF"[((Index >> 4) ^ (Index >> 11) ^ (Index * 7 >> 13)) & 15];
+}
+
+/**
+  Check a buffer against the test pattern.
+
+  @param[in] Buffer  The buffer.
+  @param[in] Offset  The offset of Buffer in the decoded data.
+  @param[in] Size    The size of Buffer.
+
+  @retval TRUE   The buffer matches.
+  @retval FALSE  The buffer differs.
+**/
+STATIC
+BOOLEAN
+TestMatchesPattern (
+  IN CONST UINT8  *Buffer,
+  IN UINTN        Offset,
+  IN UINTN        Size
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < Size; Index++) {
+    if (Buffer[Index] != TestPattern (Offset + Index)) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Decode a source into a buffer with guard bytes behind the size the header
+  announces.
+
+  @param[in]  Source       The source buffer.
+  @param[in]  SourceSize   The size of Source.
+  @param[out] GuardIntact  Whether the guard bytes are unchanged.
+
+  @return The status returned by BrotliUefiDecompress().
+**/
+STATIC
+EFI_STATUS
+TestDecodeGuarded (
+  IN  CONST VOID  *Source,
+  IN  UINTN       SourceSize,
+  OUT BOOLEAN     *GuardIntact
+  )
+{
+  EFI_STATUS  Status;
+  UINT32      DestinationSize;
+  UINT32      ScratchSize;
+  UINT8       *Destination;
+  VOID        *Scratch;
+  UINTN       Index;
+
+  BrotliUefiDecompressGetInfo (Source, (UINT32)SourceSize, &DestinationSize, &ScratchSize);
+
+  Destination = AllocatePool (DestinationSize + TEST_GUARD_SIZE);
+  Scratch     = AllocatePool (ScratchSize);
+  if ((Destination == NULL) || (Scratch == NULL)) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Done;
+  }
+
+  SetMem (Destination + DestinationSize, TEST_GUARD_SIZE, TEST_GUARD_BYTE);
+  Status = BrotliUefiDecompress (Source, SourceSize, Destination, Scratch);
+
+  *GuardIntact = TRUE;
+  for (Index = 0; Index < TEST_GUARD_SIZE; Index++) {
+    if (Destination[DestinationSize + Index] != TEST_GUARD_BYTE) {
+      *GuardIntact = FALSE;
+    }
+  }
+
+  if (!EFI_ERROR (Status) && !TestMatchesPattern (Destination, 0, DestinationSize)) {
+    Status = EFI_VOLUME_CORRUPTED;
+  }
+
+Done:
+  if (Destination != NULL) {
+    FreePool (Destination);
+  }
+
+  if (Scratch != NULL) {
+    FreePool (Scratch);
+  }
+
+  return Status;
+}
+
+/**
+  GetInfo reports the decoded size, and a scratch size without the staging
+  buffers of the compression tool.
+
+  @param[in] Context  Unused.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+GetInfoShouldReportSizes (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+  UINT32      DestinationSize;
+  UINT32      ScratchSize;
+
+  Status = BrotliUefiDecompressGetInfo (mTestSource, sizeof (mTestSource), &DestinationSize, &ScratchSize);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_EQUAL (DestinationSize, TEST_DECODED_SIZE);
+  UT_ASSERT_EQUAL (ScratchSize, ReadUnaligned64 ((CONST UINT64 *)(mTestSource + BROTLI_DECODE_MAX)) - 2 * FILE_BUFFER_SIZE);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  One-shot decoding produces the original data and stays within the buffer.
+
+  @param[in] Context  Unused.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+DecodeShouldMatchPattern (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  BOOLEAN  GuardIntact;
+
+  UT_ASSERT_NOT_EFI_ERROR (TestDecodeGuarded (mTestSource, sizeof (mTestSource), &GuardIntact));
+  UT_ASSERT_TRUE (GuardIntact);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Streaming decoding in small pieces produces the original data, then
+  reports the end of the stream.
+
+  @param[in] Context  Unused.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+StreamShouldMatchPattern (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS                Status;
+  BROTLI_DECOMPRESS_STREAM  Stream;
+  UINT32                    DestinationSize;
+  UINT32                    ScratchSize;
+  VOID                      *Scratch;
+  UINT8                     Piece[TEST_STREAM_PIECE_SIZE];
+  UINTN                     PieceSize;
+  UINTN                     Offset;
+
+  BrotliUefiDecompressGetInfo (mTestSource, sizeof (mTestSource), &DestinationSize, &ScratchSize);
+  Scratch = AllocatePool (ScratchSize);
+  UT_ASSERT_NOT_NULL (Scratch);
+
+  Status = BrotliUefiDecompressStreamOpen (mTestSource, sizeof (mTestSource), Scratch, &Stream);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  Offset = 0;
+  do {
+    PieceSize = sizeof (Piece);
+    Status    = BrotliUefiDecompressStreamRead (&Stream, Piece, &PieceSize);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+    UT_ASSERT_TRUE (TestMatchesPattern (Piece, Offset, PieceSize));
+    Offset += PieceSize;
+  } while (PieceSize == sizeof (Piece));
+
+  UT_ASSERT_EQUAL (Offset, DestinationSize);
+
+  PieceSize = sizeof (Piece);
+  Status    = BrotliUefiDecompressStreamRead (&Stream, Piece, &PieceSize);
+  UT_ASSERT_STATUS_EQUAL (Status, EFI_END_OF_FILE);
+  UT_ASSERT_EQUAL (PieceSize, 0);
+
+  BrotliUefiDecompressStreamClose (&Stream);
+  FreePool (Scratch);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Truncated sources and wrong decoded sizes are rejected without writing past
+  the destination buffer.
+
+  @param[in] Context  Unused.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+CorruptedSourceShouldFail (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINT8    *Copy;
+  BOOLEAN  GuardIntact;
+
+  Copy = AllocateCopyPool (sizeof (mTestSource), mTestSource);
+  UT_ASSERT_NOT_NULL (Copy);
+
+  UT_ASSERT_STATUS_EQUAL (TestDecodeGuarded (Copy, sizeof (mTestSource) - 8, &GuardIntact), EFI_INVALID_PARAMETER);
+  UT_ASSERT_TRUE (GuardIntact);
+
+  WriteUnaligned64 ((UINT64 *)Copy, TEST_DECODED_SIZE - 1);
+  UT_ASSERT_STATUS_EQUAL (TestDecodeGuarded (Copy, sizeof (mTestSource), &GuardIntact), EFI_INVALID_PARAMETER);
+  UT_ASSERT_TRUE (GuardIntact);
+
+  WriteUnaligned64 ((UINT64 *)Copy, TEST_DECODED_SIZE + 1);
+  UT_ASSERT_STATUS_EQUAL (TestDecodeGuarded (Copy, sizeof (mTestSource), &GuardIntact), EFI_INVALID_PARAMETER);
+  UT_ASSERT_TRUE (GuardIntact);
+
+  FreePool (Copy);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Log the scratch memory used by the decoder and the decoding throughput of
+  one-shot and streaming decoding.
+
+  @param[in] Context  Unused.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+DecodeBenchmark (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS                Status;
+  BROTLI_DECOMPRESS_STREAM  Stream;
+  UINT32                    DestinationSize;
+  UINT32                    ScratchSize;
+  UINT8                     *Destination;
+  VOID                      *Scratch;
+  UINTN                     PieceSize;
+  UINTN                     Offset;
+  UINTN                     Round;
+  UINT64                    Start;
+  UINT64                    OneShotTicks;
+  UINT64                    StreamTicks;
+
+  BrotliUefiDecompressGetInfo (mTestSource, sizeof (mTestSource), &DestinationSize, &ScratchSize);
+  Destination = AllocatePool (DestinationSize);
+  Scratch     = AllocatePool (ScratchSize);
+  UT_ASSERT_NOT_NULL (Destination);
+  UT_ASSERT_NOT_NULL (Scratch);
+
+  //
+  // The scratch buffer is carved by a bump allocator, so what is left of it
+  // after decoding tells the peak use.
+  //
+  Status = BrotliUefiDecompressStreamOpen (mTestSource, sizeof (mTestSource), Scratch, &Stream);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  PieceSize = DestinationSize;
+  Status    = BrotliUefiDecompressStreamRead (&Stream, Destination, &PieceSize);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_LOG_INFO (
+    "Scratch: header %lu, reserved %u, used %lu bytes\n",
+    ReadUnaligned64 ((CONST UINT64 *)(mTestSource + BROTLI_DECODE_MAX)),
+    ScratchSize,
+    (UINT64)(ScratchSize - Stream.Buff.BuffSize)
+    );
+  BrotliUefiDecompressStreamClose (&Stream);
+
+  Start = AsmReadTsc ();
+  for (Round = 0; Round < TEST_BENCHMARK_ROUNDS; Round++) {
+    Status = BrotliUefiDecompress (mTestSource, sizeof (mTestSource), Destination, Scratch);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+  }
+
+  OneShotTicks = AsmReadTsc () - Start;
+
+  Start = AsmReadTsc ();
+  for (Round = 0; Round < TEST_BENCHMARK_ROUNDS; Round++) {
+    Status = BrotliUefiDecompressStreamOpen (mTestSource, sizeof (mTestSource), Scratch, &Stream);
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+    for (Offset = 0; Offset < DestinationSize; Offset += PieceSize) {
+      PieceSize = MIN (TEST_BENCHMARK_PIECE, DestinationSize - Offset);
+      Status    = BrotliUefiDecompressStreamRead (&Stream, Destination + Offset, &PieceSize);
+      UT_ASSERT_NOT_EFI_ERROR (Status);
+    }
+
+    BrotliUefiDecompressStreamClose (&Stream);
+  }
+
+  StreamTicks = AsmReadTsc () - Start;
+
+  UT_ASSERT_TRUE (TestMatchesPattern (Destination, 0, DestinationSize));
+  UT_LOG_INFO (
+    "One-shot %lu ticks/KB, %u byte pieces %lu ticks/KB\n",
+    DivU64x64Remainder (OneShotTicks, (UINT64)TEST_BENCHMARK_ROUNDS * DestinationSize / SIZE_1KB, NULL),
+    TEST_BENCHMARK_PIECE,
+    DivU64x64Remainder (StreamTicks, (UINT64)TEST_BENCHMARK_ROUNDS * DestinationSize / SIZE_1KB, NULL)
+    );
+
+  FreePool (Destination);
+  FreePool (Scratch);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the Brotli
+  decompression and run the unit tests.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      BrotliTests;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  //
+  // Start setting up the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&BrotliTests, Framework, "Brotli Decompress Tests", "BrotliDecompress", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for Brotli Decompress Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  //
+  // --------------Suite--------Description------------Name--------------Function----------------Pre---Post---Context-----------
+  //
+  AddTestCase (BrotliTests, "GetInfo reports the sizes", "GetInfo", GetInfoShouldReportSizes, NULL, NULL, NULL);
+  AddTestCase (BrotliTests, "One-shot decoding", "Decode", DecodeShouldMatchPattern, NULL, NULL, NULL);
+  AddTestCase (BrotliTests, "Streaming decoding", "Stream", StreamShouldMatchPattern, NULL, NULL, NULL);
+  AddTestCase (BrotliTests, "Corrupted sources are rejected", "Corrupted", CorruptedSourceShouldFail, NULL, NULL, NULL);
+  AddTestCase (BrotliTests, "Scratch use and throughput", "Benchmark", DecodeBenchmark, NULL, NULL, NULL);
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+///
+/// Avoid ECC error for function name that starts with lower case letter
+///
+#define BrotliDecompressUnitTestMain  main
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+
+  @param[in] Argc  Number of arguments
+  @param[in] Argv  Array of pointers to arguments
+
+  @retval 0      Success
+  @retval other  Error
+**/
+INT32
+BrotliDecompressUnitTestMain (
+  IN INT32  Argc,
+  IN CHAR8  *Argv[]
+  )
+{
+  UnitTestingEntry ();
+  return 0;
+}
@@ -25,6 +25,9 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define STRING_SIZE                (FPDT_STRING_EVENT_RECORD_NAME_LENGTH * sizeof (CHAR8))
 #define FIRMWARE_RECORD_BUFFER     0x10000
 #define CACHE_HANDLE_GUID_COUNT    0x800
+#define CACHE_HANDLE_GUID_BUCKETS  0x100
+
+#define CACHE_HANDLE_GUID_BUCKET(Handle)  ((((UINTN)(Handle)) >> 4) % CACHE_HANDLE_GUID_BUCKETS)
 
 BOOT_PERFORMANCE_TABLE  *mAcpiBootPerformanceTable    = NULL;
 BOOT_PERFORMANCE_TABLE  mBootPerformanceTableTemplate = {
@@ -59,6 +62,13 @@ typedef struct {
 HANDLE_GUID_MAP  mCacheHandleGuidTable[CACHE_HANDLE_GUID_COUNT];
 UINTN            mCachePairCount = 0;
 
+//
+// Hash chains over mCacheHandleGuidTable, newest entry first. An entry holds
+// the index of a table entry plus one, 0 ends the chain.
+//
+UINT16  mCacheHandleGuidBucket[CACHE_HANDLE_GUID_BUCKETS];
+UINT16  mCacheHandleGuidNext[CACHE_HANDLE_GUID_COUNT];
+
 UINT32  mLoadImageCount       = 0;
 UINT32  mPerformanceLength    = 0;
 UINT32  mMaxPerformanceLength = 0;
@@ -71,12 +81,29 @@ BOOLEAN  mLackSpaceIsReported  = FALSE;
 CHAR8    *mPlatformLanguage    = NULL;
 UINT8    *mPerformancePointer  = NULL;
 UINT8    *mBootRecordBuffer    = NULL;
-BOOLEAN  mLockInsertRecord     = FALSE;
 CHAR8    *mDevicePathString    = NULL;
 UINTN    mSmmBootRecordOffset  = 0;
 
 EFI_DEVICE_PATH_TO_TEXT_PROTOCOL  *mDevicePathToText = NULL;
 
+//
+// Ring of performance measurements not yet converted to FPDT records. Slots
+// are reserved by advancing mRawRecordHead, and handed back by advancing
+// mRawRecordTail once the record has been converted.
+//
+PERF_RAW_RECORD  *mRawRecords       = NULL;
+UINT32           mRawRecordCount    = 0;
+volatile UINT32  mRawRecordHead     = 0;
+volatile UINT32  mRawRecordTail     = 0;
+volatile UINT32  mRawRecordDropped  = 0;
+BOOLEAN          mDeferFpdtRecords  = TRUE;
+
+//
+// Owned by whoever converts records, it protects the FPDT record buffers and
+// the handle cache.
+//
+SPIN_LOCK  mFpdtRecordLock;
+
 //
 // Interfaces for PerformanceMeasurement Protocol.
 //
@@ -443,6 +470,7 @@ AllocateBootPerformanceTable (
   If module guid can't be found, Zero Guid will return.
 
   @param    Handle        Image handle or Controller handle.
+  @param    HandleGuid    The GUID that Handle points to when it is neither, NULL if Handle is NULL.
   @param    NameString    The ascii string will be filled into it. If not found, null string will return.
   @param    BufferSize    Size of the input NameString buffer.
   @param    ModuleGuid    Point to the guid buffer to store the got module guid value.
@@ -453,10 +481,11 @@ AllocateBootPerformanceTable (
 **/
 EFI_STATUS
 GetModuleInfoFromHandle (
-  IN EFI_HANDLE  Handle,
-  OUT CHAR8      *NameString,
-  IN UINTN       BufferSize,
-  OUT EFI_GUID   *ModuleGuid OPTIONAL
+  IN EFI_HANDLE      Handle,
+  IN CONST EFI_GUID  *HandleGuid OPTIONAL,
+  OUT CHAR8          *NameString,
+  IN UINTN           BufferSize,
+  OUT EFI_GUID       *ModuleGuid OPTIONAL
   )
 {
   EFI_STATUS                         Status;
@@ -466,7 +495,7 @@ GetModuleInfoFromHandle (
   EFI_GUID                           *TempGuid;
   //UINTN                              StartIndex;
   UINTN                              Index;
-  INTN                               Count;
+  UINTN                              Bucket;
   BOOLEAN                            ModuleGuidIsGet;
   UINTN                              StringSize;
   CHAR16                             *StringPtr;
@@ -480,13 +509,12 @@ GetModuleInfoFromHandle (
   //
   // Try to get the ModuleGuid and name string form the caached array.
   //
-  if (mCachePairCount > 0) {
-    for (Count = mCachePairCount -1; Count >= 0; Count--) {
-      if (Handle == mCacheHandleGuidTable[Count].Handle) {
-        CopyGuid (ModuleGuid, &mCacheHandleGuidTable[Count].ModuleGuid);
-        AsciiStrCpyS (NameString, FPDT_STRING_EVENT_RECORD_NAME_LENGTH, mCacheHandleGuidTable[Count].NameString);
-        return EFI_SUCCESS;
-      }
+  Bucket = CACHE_HANDLE_GUID_BUCKET (Handle);
+  for (Index = mCacheHandleGuidBucket[Bucket]; Index != 0; Index = mCacheHandleGuidNext[Index - 1]) {
+    if (Handle == mCacheHandleGuidTable[Index - 1].Handle) {
+      CopyGuid (ModuleGuid, &mCacheHandleGuidTable[Index - 1].ModuleGuid);
+      AsciiStrCpyS (NameString, FPDT_STRING_EVENT_RECORD_NAME_LENGTH, mCacheHandleGuidTable[Index - 1].NameString);
+      return EFI_SUCCESS;
     }
   }
 
@@ -660,9 +688,9 @@ Done:
   //
   if (ModuleGuid != NULL) {
     CopyGuid (ModuleGuid, TempGuid);
-    if (IsZeroGuid (TempGuid) && (Handle != NULL) && !ModuleGuidIsGet) {
+    if (IsZeroGuid (TempGuid) && (HandleGuid != NULL) && !ModuleGuidIsGet) {
       // Handle is GUID
-      CopyGuid (ModuleGuid, (EFI_GUID *)Handle);
+      CopyGuid (ModuleGuid, HandleGuid);
     }
   }
 
@@ -673,6 +701,8 @@ Done:
     mCacheHandleGuidTable[mCachePairCount].Handle = Handle;
     CopyGuid (&mCacheHandleGuidTable[mCachePairCount].ModuleGuid, ModuleGuid);
     AsciiStrCpyS (mCacheHandleGuidTable[mCachePairCount].NameString, FPDT_STRING_EVENT_RECORD_NAME_LENGTH, NameString);
+    mCacheHandleGuidNext[mCachePairCount] = mCacheHandleGuidBucket[Bucket];
+    mCacheHandleGuidBucket[Bucket]        = (UINT16)(mCachePairCount + 1);
     mCachePairCount++;
   }
 
@@ -944,58 +974,38 @@ GetDeviceInfoFromHandleAndUpdateLength (
 }
 
 /**
-  Create performance record with event description and a timestamp.
+  Get the performance identifier of a measurement and check that an FPDT
+  record can be made of it.
 
   @param CallerIdentifier  - Image handle or pointer to caller ID GUID.
   @param Guid              - Pointer to a GUID.
   @param String            - Pointer to a string describing the measurement.
-  @param Ticker            - 64-bit time stamp.
-  @param Address           - Pointer to a location in memory relevant to the measurement.
-  @param PerfId            - Performance identifier describing the type of measurement.
-  @param Attribute         - The attribute of the measurement. According to attribute can create a start
-                             record for PERF_START/PERF_START_EX, or a end record for PERF_END/PERF_END_EX,
-                             or a general record for other Perf macros.
+  @param Attribute         - The attribute of the measurement.
+  @param PerfId            - On input, the performance identifier passed by the caller.
+                             On output, the performance identifier of the record.
 
-  @retval EFI_SUCCESS           - Successfully created performance record.
-  @retval EFI_OUT_OF_RESOURCES  - Ran out of space to store the records.
+  @retval EFI_SUCCESS           - An FPDT record can be made of the measurement.
   @retval EFI_INVALID_PARAMETER - Invalid parameter passed to function - NULL
                                   pointer or invalid PerfId.
 
-  @retval EFI_SUCCESS           - Successfully created performance record
-  @retval EFI_OUT_OF_RESOURCES  - Ran out of space to store the records
-  @retval EFI_INVALID_PARAMETER - Invalid parameter passed to function - NULL
-                                  pointer or invalid PerfId
-
 **/
 EFI_STATUS
-InsertFpdtRecord (
+GetFpdtRecordPerfId (
   IN CONST VOID                        *CallerIdentifier   OPTIONAL,
   IN CONST VOID                        *Guid     OPTIONAL,
   IN CONST CHAR8                       *String   OPTIONAL,
-  IN       UINT64                      Ticker,
-  IN       UINT64                      Address   OPTIONAL,
-  IN       UINT16                      PerfId,
-  IN       PERF_MEASUREMENT_ATTRIBUTE  Attribute
+  IN       PERF_MEASUREMENT_ATTRIBUTE  Attribute,
+  IN OUT   UINT16                      *PerfId
   )
 {
-  EFI_GUID         ModuleGuid;
-  CHAR8            ModuleName[FPDT_STRING_EVENT_RECORD_NAME_LENGTH];
-  FPDT_RECORD_PTR  FpdtRecordPtr;
-  FPDT_RECORD_PTR  CachedFpdtRecordPtr;
-  UINT64           TimeStamp;
-  CONST CHAR8      *StringPtr;
-  UINTN            DestMax;
-  UINTN            StringLen;
-  EFI_STATUS       Status;
-  UINT16           ProgressId;
+  EFI_STATUS  Status;
+  UINT16      ProgressId;
 
-  StringPtr  = NULL;
   ProgressId = 0;
-  ZeroMem (ModuleName, sizeof (ModuleName));
 
   //
-  // 1. Get the Perf Id for records from PERF_START/PERF_END, PERF_START_EX/PERF_END_EX.
-  //    notes: For other Perf macros (Attribute == PerfEntry), their Id is known.
+  // Get the Perf Id for records from PERF_START/PERF_END, PERF_START_EX/PERF_END_EX.
+  // notes: For other Perf macros (Attribute == PerfEntry), their Id is known.
   //
   if (Attribute != PerfEntry) {
     //
@@ -1007,15 +1017,15 @@ InsertFpdtRecord (
     // If it is end pref: the lower 4 bits of the ID should not be 0.
     // If input ID doesn't follow the rule, we will adjust it.
     //
-    if ((PerfId != 0) && (IsKnownID (PerfId)) && (!IsKnownTokens (String))) {
+    if ((*PerfId != 0) && (IsKnownID (*PerfId)) && (!IsKnownTokens (String))) {
       return EFI_INVALID_PARAMETER;
-    } else if ((PerfId != 0) && (!IsKnownID (PerfId)) && (!IsKnownTokens (String))) {
-      if ((Attribute == PerfStartEntry) && ((PerfId & 0x000F) != 0)) {
-        PerfId &= 0xFFF0;
-      } else if ((Attribute == PerfEndEntry) && ((PerfId & 0x000F) == 0)) {
-        PerfId += 1;
+    } else if ((*PerfId != 0) && (!IsKnownID (*PerfId)) && (!IsKnownTokens (String))) {
+      if ((Attribute == PerfStartEntry) && ((*PerfId & 0x000F) != 0)) {
+        *PerfId &= 0xFFF0;
+      } else if ((Attribute == PerfEndEntry) && ((*PerfId & 0x000F) == 0)) {
+        *PerfId += 1;
       }
-    } else if (PerfId == 0) {
+    } else if (*PerfId == 0) {
       //
       // Get ProgressID form the String Token.
       //
@@ -1024,12 +1034,105 @@ InsertFpdtRecord (
         return Status;
       }
 
-      PerfId = ProgressId;
+      *PerfId = ProgressId;
     }
   }
 
+  switch (*PerfId) {
+    case MODULE_START_ID:
+    case MODULE_END_ID:
+    case MODULE_LOADIMAGE_START_ID:
+    case MODULE_LOADIMAGE_END_ID:
+    case MODULE_DB_START_ID:
+    case MODULE_DB_END_ID:
+    case MODULE_DB_STOP_START_ID:
+    case MODULE_DB_STOP_END_ID:
+    case PERF_EVENT_ID:
+    case PERF_FUNCTION_START_ID:
+    case PERF_FUNCTION_END_ID:
+    case PERF_INMODULE_START_ID:
+    case PERF_INMODULE_END_ID:
+    case PERF_CROSSMODULE_START_ID:
+    case PERF_CROSSMODULE_END_ID:
+      break;
+
+    case MODULE_DB_SUPPORT_START_ID:
+    case MODULE_DB_SUPPORT_END_ID:
+      if (PcdGetBool (PcdEdkiiFpdtStringRecordEnableOnly)) {
+        return EFI_INVALID_PARAMETER;
+      }
+
+      break;
+
+    case PERF_EVENTSIGNAL_START_ID:
+    case PERF_EVENTSIGNAL_END_ID:
+    case PERF_CALLBACK_START_ID:
+    case PERF_CALLBACK_END_ID:
+      if ((CallerIdentifier == NULL) || (String == NULL) || (Guid == NULL)) {
+        return EFI_INVALID_PARAMETER;
+      }
+
+      break;
+
+    default:
+      if (Attribute == PerfEntry) {
+        return EFI_INVALID_PARAMETER;
+      }
+
+      break;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Create the FPDT record of a buffered performance measurement.
+
+  @param RawRecord         - The performance measurement.
+
+  @retval EFI_SUCCESS           - Successfully created performance record.
+  @retval EFI_OUT_OF_RESOURCES  - Ran out of space to store the records.
+  @retval EFI_INVALID_PARAMETER - Invalid parameter passed to function - NULL
+                                  pointer or invalid PerfId.
+
+**/
+EFI_STATUS
+InsertFpdtRecord (
+  IN CONST PERF_RAW_RECORD  *RawRecord
+  )
+{
+  CONST VOID                  *CallerIdentifier;
+  CONST EFI_GUID              *CallerGuid;
+  CONST VOID                  *Guid;
+  CONST CHAR8                 *String;
+  UINT64                      Ticker;
+  UINT64                      Address;
+  UINT16                      PerfId;
+  PERF_MEASUREMENT_ATTRIBUTE  Attribute;
+  EFI_GUID                    ModuleGuid;
+  CHAR8                       ModuleName[FPDT_STRING_EVENT_RECORD_NAME_LENGTH];
+  FPDT_RECORD_PTR             FpdtRecordPtr;
+  FPDT_RECORD_PTR             CachedFpdtRecordPtr;
+  UINT64                      TimeStamp;
+  CONST CHAR8                 *StringPtr;
+  UINTN                       DestMax;
+  UINTN                       StringLen;
+  EFI_STATUS                  Status;
+
+  CallerIdentifier = RawRecord->CallerIdentifier;
+  CallerGuid       = (CallerIdentifier != NULL) ? &RawRecord->CallerGuid : NULL;
+  Guid             = ((RawRecord->Flags & PERF_RAW_RECORD_GUID) != 0) ? &RawRecord->Guid : NULL;
+  String           = ((RawRecord->Flags & PERF_RAW_RECORD_STRING) != 0) ? RawRecord->String : NULL;
+  Ticker           = RawRecord->Ticker;
+  Address          = RawRecord->Address;
+  PerfId           = RawRecord->PerfId;
+  Attribute        = (PERF_MEASUREMENT_ATTRIBUTE)RawRecord->Attribute;
+
+  StringPtr = NULL;
+  ZeroMem (ModuleName, sizeof (ModuleName));
+
   //
-  // 2. Get the buffer to store the FPDT record.
+  // 1. Get the buffer to store the FPDT record.
   //
   Status = GetFpdtRecordPtr (FPDT_MAX_PERF_RECORD_SIZE, &FpdtRecordPtr);
   if (EFI_ERROR (Status)) {
@@ -1037,24 +1140,21 @@ InsertFpdtRecord (
   }
 
   //
-  // 3. Get the TimeStamp.
+  // 2. Get the TimeStamp. The ticker was read when the measurement was logged.
   //
-  if (Ticker == 0) {
-    Ticker    = GetPerformanceCounter ();
-    TimeStamp = GetTimeInNanoSecond (Ticker);
-  } else if (Ticker == 1) {
+  if (Ticker == 1) {
     TimeStamp = 0;
   } else {
     TimeStamp = GetTimeInNanoSecond (Ticker);
   }
 
   //
-  // 4. Fill in the FPDT record according to different Performance Identifier.
+  // 3. Fill in the FPDT record according to different Performance Identifier.
   //
   switch (PerfId) {
     case MODULE_START_ID:
     case MODULE_END_ID:
-      GetModuleInfoFromHandle ((EFI_HANDLE)CallerIdentifier, ModuleName, sizeof (ModuleName), &ModuleGuid);
+      GetModuleInfoFromHandle ((EFI_HANDLE)CallerIdentifier, CallerGuid, ModuleName, sizeof (ModuleName), &ModuleGuid);
       StringPtr = ModuleName;
       //
       // Cache the offset of start image start record and use to update the start image end record if needed.
@@ -1091,7 +1191,7 @@ InsertFpdtRecord (
 
     case MODULE_LOADIMAGE_START_ID:
     case MODULE_LOADIMAGE_END_ID:
-      GetModuleInfoFromHandle ((EFI_HANDLE)CallerIdentifier, ModuleName, sizeof (ModuleName), &ModuleGuid);
+      GetModuleInfoFromHandle ((EFI_HANDLE)CallerIdentifier, CallerGuid, ModuleName, sizeof (ModuleName), &ModuleGuid);
       StringPtr = ModuleName;
       if (PerfId == MODULE_LOADIMAGE_START_ID) {
         mLoadImageCount++;
@@ -1135,7 +1235,7 @@ InsertFpdtRecord (
     case MODULE_DB_SUPPORT_END_ID:
     case MODULE_DB_STOP_START_ID:
     case MODULE_DB_STOP_END_ID:
-      GetModuleInfoFromHandle ((EFI_HANDLE)CallerIdentifier, ModuleName, sizeof (ModuleName), &ModuleGuid);
+      GetModuleInfoFromHandle ((EFI_HANDLE)CallerIdentifier, CallerGuid, ModuleName, sizeof (ModuleName), &ModuleGuid);
       StringPtr = ModuleName;
       if (!PcdGetBool (PcdEdkiiFpdtStringRecordEnableOnly)) {
         FpdtRecordPtr.GuidQwordEvent->Header.Type     = FPDT_GUID_QWORD_EVENT_TYPE;
@@ -1151,7 +1251,7 @@ InsertFpdtRecord (
       break;
 
     case MODULE_DB_END_ID:
-      GetModuleInfoFromHandle ((EFI_HANDLE)CallerIdentifier, ModuleName, sizeof (ModuleName), &ModuleGuid);
+      GetModuleInfoFromHandle ((EFI_HANDLE)CallerIdentifier, CallerGuid, ModuleName, sizeof (ModuleName), &ModuleGuid);
       StringPtr = ModuleName;
       if (!PcdGetBool (PcdEdkiiFpdtStringRecordEnableOnly)) {
         FpdtRecordPtr.GuidQwordStringEvent->Header.Type     = FPDT_GUID_QWORD_STRING_EVENT_TYPE;
@@ -1189,7 +1289,7 @@ InsertFpdtRecord (
         FpdtRecordPtr.DualGuidStringEvent->ProgressID      = PerfId;
         FpdtRecordPtr.DualGuidStringEvent->Reserved        = 0;
         FpdtRecordPtr.DualGuidStringEvent->Timestamp       = TimeStamp;
-        CopyMem (&FpdtRecordPtr.DualGuidStringEvent->Guid1, CallerIdentifier, sizeof (FpdtRecordPtr.DualGuidStringEvent->Guid1));
+        CopyMem (&FpdtRecordPtr.DualGuidStringEvent->Guid1, CallerGuid, sizeof (FpdtRecordPtr.DualGuidStringEvent->Guid1));
         CopyMem (&FpdtRecordPtr.DualGuidStringEvent->Guid2, Guid, sizeof (FpdtRecordPtr.DualGuidStringEvent->Guid2));
         CopyStringIntoPerfRecordAndUpdateLength (FpdtRecordPtr.DualGuidStringEvent->String, StringPtr, &FpdtRecordPtr.DualGuidStringEvent->Header.Length);
       }
@@ -1203,7 +1303,7 @@ InsertFpdtRecord (
     case PERF_INMODULE_END_ID:
     case PERF_CROSSMODULE_START_ID:
     case PERF_CROSSMODULE_END_ID:
-      GetModuleInfoFromHandle ((EFI_HANDLE)CallerIdentifier, ModuleName, sizeof (ModuleName), &ModuleGuid);
+      GetModuleInfoFromHandle ((EFI_HANDLE)CallerIdentifier, CallerGuid, ModuleName, sizeof (ModuleName), &ModuleGuid);
       if (String != NULL) {
         StringPtr = String;
       } else {
@@ -1229,7 +1329,7 @@ InsertFpdtRecord (
 
     default:
       if (Attribute != PerfEntry) {
-        GetModuleInfoFromHandle ((EFI_HANDLE)CallerIdentifier, ModuleName, sizeof (ModuleName), &ModuleGuid);
+        GetModuleInfoFromHandle ((EFI_HANDLE)CallerIdentifier, CallerGuid, ModuleName, sizeof (ModuleName), &ModuleGuid);
         if (String != NULL) {
           StringPtr = String;
         } else {
@@ -1258,7 +1358,7 @@ InsertFpdtRecord (
   }
 
   //
-  // 4.2 When PcdEdkiiFpdtStringRecordEnableOnly==TRUE, create string record for all Perf entries.
+  // 3.2 When PcdEdkiiFpdtStringRecordEnableOnly==TRUE, create string record for all Perf entries.
   //
   if (PcdGetBool (PcdEdkiiFpdtStringRecordEnableOnly)) {
     if ((StringPtr == NULL) || (PerfId == MODULE_DB_SUPPORT_START_ID) || (PerfId == MODULE_DB_SUPPORT_END_ID)) {
@@ -1322,7 +1422,7 @@ InsertFpdtRecord (
   }
 
   //
-  // 5. Update the length of the used buffer after fill in the record.
+  // 4. Update the length of the used buffer after fill in the record.
   //
   if (mFpdtBufferIsReported) {
     mBootRecordSize                          += FpdtRecordPtr.RecordHeader->Length;
@@ -1334,6 +1434,91 @@ InsertFpdtRecord (
   return EFI_SUCCESS;
 }
 
+/**
+  Reserve a slot in the ring of buffered performance measurements.
+
+  The reservation does not take a lock, so a measurement logged at a higher
+  TPL, or by another processor, while a slot is being filled in is still kept.
+
+  @param Sequence          - On return, the sequence number of the slot.
+
+  @retval TRUE             - A slot was reserved.
+  @retval FALSE            - The ring is full.
+
+**/
+BOOLEAN
+ReserveRawRecord (
+  OUT UINT32  *Sequence
+  )
+{
+  UINT32  Head;
+
+  do {
+    Head = mRawRecordHead;
+    if (Head - mRawRecordTail >= mRawRecordCount) {
+      return FALSE;
+    }
+  } while (InterlockedCompareExchange32 (&mRawRecordHead, Head, Head + 1) != Head);
+
+  *Sequence = Head;
+  return TRUE;
+}
+
+/**
+  Try to become the owner of the FPDT record buffers.
+
+  Converting records looks up module names through boot services, so this
+  fails above TPL_NOTIFY, as well as when a caller interrupted by this one
+  owns the buffers.
+
+  @retval TRUE             - The caller owns mFpdtRecordLock.
+  @retval FALSE            - Records cannot be converted now.
+
+**/
+BOOLEAN
+AcquireFpdtRecordLock (
+  VOID
+  )
+{
+  if (EfiGetCurrentTpl () > TPL_NOTIFY) {
+    return FALSE;
+  }
+
+  return AcquireSpinLockOrFail (&mFpdtRecordLock);
+}
+
+/**
+  Convert the buffered performance measurements to FPDT records, oldest first.
+
+  The caller must own mFpdtRecordLock. A slot that an interrupted caller is
+  still filling in stops the conversion. It and the slots after it are
+  converted the next time.
+
+**/
+VOID
+ConvertRawRecords (
+  VOID
+  )
+{
+  UINT32           Tail;
+  PERF_RAW_RECORD  *RawRecord;
+
+  for (Tail = mRawRecordTail; Tail != mRawRecordHead; Tail++) {
+    RawRecord = &mRawRecords[Tail % mRawRecordCount];
+    if (RawRecord->Sequence != Tail + 1) {
+      break;
+    }
+
+    InsertFpdtRecord (RawRecord);
+
+    //
+    // Hand the slot back only after it has been read.
+    //
+    MemoryFence ();
+    mRawRecordTail = Tail + 1;
+  }
+}
+
 /**
   Dumps all the PEI performance.
 
@@ -1406,6 +1591,15 @@ ReportFpdtRecordBuffer (
   UINT64      BPDTAddr;
 
   if (!mFpdtBufferIsReported) {
+    //
+    // Convert the measurements logged so far, so that the boot performance
+    // table is allocated large enough to hold them.
+    //
+    if (AcquireFpdtRecordLock ()) {
+      ConvertRawRecords ();
+      ReleaseSpinLock (&mFpdtRecordLock);
+    }
+
     Status = AllocateBootPerformanceTable ();
     if (!EFI_ERROR (Status)) {
       BPDTAddr = (UINT64)(UINTN)mAcpiBootPerformanceTable;
@@ -1450,6 +1644,22 @@ UpdateBootPerformanceTable (
 
   SmmBootRecordDataSize = 0;
 
+  //
+  // Append the measurements logged since EndOfDxe. From now on every
+  // measurement is converted when it is logged, since the OS loader may
+  // run at any time.
+  //
+  if (AcquireFpdtRecordLock ()) {
+    ConvertRawRecords ();
+    ReleaseSpinLock (&mFpdtRecordLock);
+  }
+
+  mDeferFpdtRecords = FALSE;
+
+  if (mRawRecordDropped != 0) {
+    DEBUG ((DEBUG_INFO, "DxeCorePerformanceLib: %u performance records were lost, increase PcdEdkiiFpdtRawRecordCount\n", mRawRecordDropped));
+  }
+
   //
   // Get SMM performance data.
   //
@@ -1511,6 +1721,19 @@ DxeCorePerformanceLibConstructor (
   //
   InternalGetPeiPerformance (GetHobList ());
 
+  //
+  // Allocate the ring that holds measurements until they are converted to FPDT
+  // records. Without it every measurement is converted when it is logged.
+  //
+  InitializeSpinLock (&mFpdtRecordLock);
+  mRawRecordCount = PcdGet32 (PcdEdkiiFpdtRawRecordCount);
+  if (mRawRecordCount != 0) {
+    mRawRecords = AllocatePool (mRawRecordCount * sizeof (PERF_RAW_RECORD));
+    if (mRawRecords == NULL) {
+      mRawRecordCount = 0;
+    }
+  }
+
   //
   // Install the protocol interfaces for DXE performance library instance.
   //
@@ -1597,19 +1820,86 @@ CreatePerformanceMeasurement (
   IN       PERF_MEASUREMENT_ATTRIBUTE  Attribute
   )
 {
-  EFI_STATUS  Status;
+  EFI_STATUS       Status;
+  UINT16           PerfId;
+  UINT32           Sequence;
+  PERF_RAW_RECORD  *RawRecord;
+  PERF_RAW_RECORD  LocalRecord;
 
-  Status = EFI_SUCCESS;
+  PerfId = (UINT16)Identifier;
+  Status = GetFpdtRecordPerfId (CallerIdentifier, Guid, String, Attribute, &PerfId);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
 
-  if (mLockInsertRecord) {
-    return EFI_INVALID_PARAMETER;
+  if (TimeStamp == 0) {
+    TimeStamp = GetPerformanceCounter ();
   }
 
-  mLockInsertRecord = TRUE;
+  //
+  // When the ring is full, or there is none, the measurement is converted
+  // right away, after the buffered ones.
+  //
+  if (ReserveRawRecord (&Sequence)) {
+    RawRecord = &mRawRecords[Sequence % mRawRecordCount];
+  } else {
+    RawRecord = &LocalRecord;
+  }
 
-  Status = InsertFpdtRecord (CallerIdentifier, Guid, String, TimeStamp, Address, (UINT16)Identifier, Attribute);
+  RawRecord->PerfId           = PerfId;
+  RawRecord->Attribute        = (UINT8)Attribute;
+  RawRecord->Flags            = 0;
+  RawRecord->Ticker           = TimeStamp;
+  RawRecord->Address          = Address;
+  RawRecord->CallerIdentifier = CallerIdentifier;
+  if (CallerIdentifier != NULL) {
+    //
+    // CallerIdentifier may point to the caller ID GUID of an image that is
+    // gone by the time the record is converted.
+    //
+    CopyGuid (&RawRecord->CallerGuid, CallerIdentifier);
+  }
+
+  if (Guid != NULL) {
+    CopyGuid (&RawRecord->Guid, Guid);
+    RawRecord->Flags |= PERF_RAW_RECORD_GUID;
+  }
+
+  if (String != NULL) {
+    AsciiStrnCpyS (RawRecord->String, sizeof (RawRecord->String), String, sizeof (RawRecord->String) - 1);
+    RawRecord->Flags |= PERF_RAW_RECORD_STRING;
+  }
+
+  if (RawRecord != &LocalRecord) {
+    MemoryFence ();
+    RawRecord->Sequence = Sequence + 1;
+
+    //
+    // Until ReadyToBoot, measurements are converted in batches. The batch is
+    // converted when an image is loaded or started though, because an image
+    // that fails to start is unloaded, and its handle cannot be resolved to a
+    // name afterwards.
+    //
+    if (mDeferFpdtRecords && (PerfId != MODULE_START_ID) && (PerfId != MODULE_LOADIMAGE_END_ID)) {
+      return EFI_SUCCESS;
+    }
+  }
+
+  if (!AcquireFpdtRecordLock ()) {
+    if (RawRecord == &LocalRecord) {
+      InterlockedIncrement (&mRawRecordDropped);
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    return EFI_SUCCESS;
+  }
+
+  ConvertRawRecords ();
+  if (RawRecord == &LocalRecord) {
+    Status = InsertFpdtRecord (&LocalRecord);
+  }
 
-  mLockInsertRecord = FALSE;
+  ReleaseSpinLock (&mFpdtRecordLock);
 
   return Status;
 }
@@ -33,6 +33,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/HobLib.h>
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
+#include <Library/SynchronizationLib.h>
 #include <Library/TimerLib.h>
 #include <Library/PcdLib.h>
 #include <Library/DevicePathLib.h>
@@ -43,6 +44,33 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/ReportStatusCodeLib.h>
 #include <Library/DxeServicesLib.h>
 
+///
+/// A performance measurement as it was logged. Turning it into an FPDT record
+/// needs the name of the module, which is slow to look up, so measurements are
+/// kept in this form and converted in batches.
+///
+typedef struct {
+  ///
+  /// Sequence number of the record plus one, written once the record is complete.
+  ///
+  volatile UINT32    Sequence;
+  UINT16             PerfId;
+  UINT8              Attribute;
+  UINT8              Flags;
+  UINT64             Ticker;
+  UINT64             Address;
+  CONST VOID         *CallerIdentifier;
+  ///
+  /// Copy of the GUID CallerIdentifier points to, if it is not an image handle.
+  ///
+  EFI_GUID           CallerGuid;
+  EFI_GUID           Guid;
+  CHAR8              String[FPDT_STRING_EVENT_RECORD_NAME_LENGTH];
+} PERF_RAW_RECORD;
+
+#define PERF_RAW_RECORD_GUID    BIT0
+#define PERF_RAW_RECORD_STRING  BIT1
+
 /**
   Create performance record with event description and a timestamp.
 
@@ -0,0 +1,163 @@
+/** @file
+  Chunked LZMA Decompress GUIDed Section Extraction Library.
+  It wraps the chunked Lzma decompress interfaces to GUIDed Section Extraction
+  interfaces and registers them into GUIDed handler table.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "LzmaChunkedDecompressInternal.h"
+
+/**
+  Locate the data of a chunked LZMA GUIDed section.
+
+  @param[in]  InputSection      A pointer to a GUIDed section of an FFS formatted file.
+  @param[out] Data              The data of the section.
+  @param[out] DataSize          The size, in bytes, of the data of the section.
+  @param[out] SectionAttribute  The attributes of the GUIDed section. Optional.
+
+  @retval TRUE   The section is a chunked LZMA GUIDed section.
+  @retval FALSE  The section has a different GUID or is malformed.
+**/
+STATIC
+BOOLEAN
+LzmaChunkedGetSectionData (
+  IN  CONST VOID  *InputSection,
+  OUT CONST VOID  **Data,
+  OUT UINT32      *DataSize,
+  OUT UINT16      *SectionAttribute OPTIONAL
+  )
+{
+  CONST EFI_GUID  *SectionGuid;
+  UINT32          SectionSize;
+  UINT16          DataOffset;
+  UINT16          Attributes;
+
+  if (IS_SECTION2 (InputSection)) {
+    SectionGuid = &((EFI_GUID_DEFINED_SECTION2 *)InputSection)->SectionDefinitionGuid;
+    SectionSize = SECTION2_SIZE (InputSection);
+    DataOffset  = ((EFI_GUID_DEFINED_SECTION2 *)InputSection)->DataOffset;
+    Attributes  = ((EFI_GUID_DEFINED_SECTION2 *)InputSection)->Attributes;
+  } else {
+    SectionGuid = &((EFI_GUID_DEFINED_SECTION *)InputSection)->SectionDefinitionGuid;
+    SectionSize = SECTION_SIZE (InputSection);
+    DataOffset  = ((EFI_GUID_DEFINED_SECTION *)InputSection)->DataOffset;
+    Attributes  = ((EFI_GUID_DEFINED_SECTION *)InputSection)->Attributes;
+  }
+
+  if (!CompareGuid (&gLzmaChunkedCustomDecompressGuid, SectionGuid) || (DataOffset > SectionSize)) {
+    return FALSE;
+  }
+
+  *Data     = (CONST UINT8 *)InputSection + DataOffset;
+  *DataSize = SectionSize - DataOffset;
+  if (SectionAttribute != NULL) {
+    *SectionAttribute = Attributes;
+  }
+
+  return TRUE;
+}
+
+/**
+  Examines a GUIDed section and returns the size of the decoded buffer and the
+  size of an scratch buffer required to actually decode the data in a GUIDed section.
+
+  @param[in]  InputSection       A pointer to a GUIDed section of an FFS formatted file.
+  @param[out] OutputBufferSize   A pointer to the size, in bytes, of an output buffer required
+                                 if the buffer specified by InputSection were decoded.
+  @param[out] ScratchBufferSize  A pointer to the size, in bytes, required as scratch space
+                                 if the buffer specified by InputSection were decoded.
+  @param[out] SectionAttribute   A pointer to the attributes of the GUIDed section. See the Attributes
+                                 field of EFI_GUID_DEFINED_SECTION in the PI Specification.
+
+  @retval  RETURN_SUCCESS            The information about InputSection was returned.
+  @retval  RETURN_INVALID_PARAMETER  The information can not be retrieved from the section specified by InputSection.
+
+**/
+RETURN_STATUS
+EFIAPI
+LzmaChunkedGuidedSectionGetInfo (
+  IN  CONST VOID  *InputSection,
+  OUT UINT32      *OutputBufferSize,
+  OUT UINT32      *ScratchBufferSize,
+  OUT UINT16      *SectionAttribute
+  )
+{
+  CONST VOID  *Data;
+  UINT32      DataSize;
+
+  ASSERT (InputSection != NULL);
+  ASSERT (OutputBufferSize != NULL);
+  ASSERT (ScratchBufferSize != NULL);
+  ASSERT (SectionAttribute != NULL);
+
+  if (!LzmaChunkedGetSectionData (InputSection, &Data, &DataSize, SectionAttribute)) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  return LzmaChunkedDecompressGetInfo (Data, DataSize, OutputBufferSize, ScratchBufferSize);
+}
+
+/**
+  Decompress a chunked LZMA compressed GUIDed section into a caller allocated output buffer.
+
+  @param[in]  InputSection  A pointer to a GUIDed section of an FFS formatted file.
+  @param[out] OutputBuffer  A pointer to a buffer that contains the result of a decode operation.
+  @param[out] ScratchBuffer A caller allocated buffer that may be required by this function
+                            as a scratch buffer to perform the decode operation.
+  @param[out] AuthenticationStatus
+                            A pointer to the authentication status of the decoded output buffer.
+                            See the definition of authentication status in the EFI_PEI_GUIDED_SECTION_EXTRACTION_PPI
+                            section of the PI Specification. EFI_AUTH_STATUS_PLATFORM_OVERRIDE must
+                            never be set by this handler.
+
+  @retval  RETURN_SUCCESS            The buffer specified by InputSection was decoded.
+  @retval  RETURN_INVALID_PARAMETER  The section specified by InputSection can not be decoded.
+
+**/
+RETURN_STATUS
+EFIAPI
+LzmaChunkedGuidedSectionExtraction (
+  IN CONST  VOID    *InputSection,
+  OUT       VOID    **OutputBuffer,
+  OUT       VOID    *ScratchBuffer         OPTIONAL,
+  OUT       UINT32  *AuthenticationStatus
+  )
+{
+  CONST VOID  *Data;
+  UINT32      DataSize;
+
+  ASSERT (OutputBuffer != NULL);
+  ASSERT (InputSection != NULL);
+
+  if (!LzmaChunkedGetSectionData (InputSection, &Data, &DataSize, NULL)) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  //
+  // Authentication is set to Zero, which may be ignored.
+  //
+  *AuthenticationStatus = 0;
+
+  return LzmaChunkedDecompress (Data, DataSize, *OutputBuffer, ScratchBuffer);
+}
+
+/**
+  Register the chunked LZMA GUIDed section handlers with gLzmaChunkedCustomDecompressGuid.
+
+  @retval  RETURN_SUCCESS            Register successfully.
+  @retval  RETURN_OUT_OF_RESOURCES   No enough memory to store this handler.
+**/
+RETURN_STATUS
+LzmaChunkedRegisterHandlers (
+  VOID
+  )
+{
+  return ExtractGuidedSectionRegisterHandlers (
+           &gLzmaChunkedCustomDecompressGuid,
+           LzmaChunkedGuidedSectionGetInfo,
+           LzmaChunkedGuidedSectionExtraction
+           );
+}
@@ -0,0 +1,119 @@
+/** @file
+  DXE part of the chunked LZMA GUIDed section extraction library. The chunks
+  are spread over the APs through the MP services protocol, while the BSP
+  decodes chunks as well.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <PiDxe.h>
+#include "LzmaChunkedDecompressInternal.h"
+#include <Protocol/MpService.h>
+#include <Library/UefiBootServicesTableLib.h>
+
+/**
+  Run ApProcedure on all enabled APs and BspProcedure on the BSP, and return
+  once all of them have finished.
+
+  If no MP service is available or no AP could be started, only BspProcedure
+  runs. Both procedures must tolerate running while the other one is still
+  running or has not started yet.
+
+  @param[in] ApProcedure   The procedure to run on the APs.
+  @param[in] BspProcedure  The procedure to run on the BSP.
+  @param[in] Argument      The parameter passed into both procedures.
+**/
+VOID
+LzmaChunkedRunWorkers (
+  IN EFI_AP_PROCEDURE  ApProcedure,
+  IN EFI_AP_PROCEDURE  BspProcedure,
+  IN VOID              *Argument
+  )
+{
+  EFI_STATUS                Status;
+  EFI_MP_SERVICES_PROTOCOL  *MpServices;
+  EFI_TPL                   OldTpl;
+  EFI_EVENT                 WaitEvent;
+
+  Status = gBS->LocateProtocol (&gEfiMpServiceProtocolGuid, NULL, (VOID **)&MpServices);
+  if (EFI_ERROR (Status)) {
+    BspProcedure (Argument);
+    return;
+  }
+
+  //
+  // The MP service signals the event of a non-blocking StartupAllAPs() from a
+  // timer callback, so waiting for it above TPL_CALLBACK would never end. Use
+  // the blocking mode there, and let the BSP decode what the APs left.
+  //
+  WaitEvent = NULL;
+  OldTpl    = gBS->RaiseTPL (TPL_HIGH_LEVEL);
+  gBS->RestoreTPL (OldTpl);
+  if (OldTpl <= TPL_CALLBACK) {
+    Status = gBS->CreateEvent (0, TPL_CALLBACK, NULL, NULL, &WaitEvent);
+    if (EFI_ERROR (Status)) {
+      WaitEvent = NULL;
+    }
+  }
+
+  Status = MpServices->StartupAllAPs (
+                         MpServices,
+                         ApProcedure,
+                         FALSE,
+                         WaitEvent,
+                         0,
+                         Argument,
+                         NULL
+                         );
+  if ((Status == EFI_UNSUPPORTED) && (WaitEvent != NULL)) {
+    //
+    // The MP service does not support the non-blocking mode.
+    //
+    gBS->CloseEvent (WaitEvent);
+    WaitEvent = NULL;
+    Status    = MpServices->StartupAllAPs (
+                              MpServices,
+                              ApProcedure,
+                              FALSE,
+                              NULL,
+                              0,
+                              Argument,
+                              NULL
+                              );
+  }
+
+  DEBUG ((DEBUG_VERBOSE, "LzmaChunked: StartupAllAPs - %r\n", Status));
+
+  BspProcedure (Argument);
+
+  if (WaitEvent != NULL) {
+    if (!EFI_ERROR (Status)) {
+      while (gBS->CheckEvent (WaitEvent) == EFI_NOT_READY) {
+        CpuPause ();
+      }
+    }
+
+    gBS->CloseEvent (WaitEvent);
+  }
+}
+
+/**
+  Register the chunked LZMA GUIDed section handlers.
+
+  @param[in] ImageHandle  The firmware allocated handle for the EFI image.
+  @param[in] SystemTable  A pointer to the EFI System Table.
+
+  @retval  EFI_SUCCESS            Register successfully.
+  @retval  EFI_OUT_OF_RESOURCES   No enough memory to store this handler.
+**/
+EFI_STATUS
+EFIAPI
+DxeLzmaChunkedDecompressLibConstructor (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  return LzmaChunkedRegisterHandlers ();
+}
@@ -0,0 +1,313 @@
+/** @file
+  Chunked LZMA decompress interfaces.
+
+  A chunked LZMA container holds independently compressed LZMA streams and a
+  table of their offsets, see LZMA_CHUNKED_HEADER. Since the chunks do not
+  depend on each other, every enabled CPU takes chunks from a shared counter
+  and decodes them into their final place in the destination buffer.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "LzmaChunkedDecompressInternal.h"
+#include <Library/SynchronizationLib.h>
+#include "Sdk/C/7zTypes.h"
+#include "Sdk/C/LzmaDec.h"
+
+#define LZMA_CHUNK_HEADER_SIZE  (LZMA_PROPS_SIZE + 8)
+
+/**
+  Validate a chunked LZMA container and describe it in a context.
+
+  Every chunk is checked to lie within the source buffer and to decode to
+  exactly its share of the destination buffer, so that the workers can never
+  write outside of their chunk.
+
+  @param[in]  Source       The source buffer containing the compressed data.
+  @param[in]  SourceSize   The size, in bytes, of the source buffer.
+  @param[out] Context      The context to fill.
+  @param[out] DecodedSize  The size, in bytes, of the uncompressed data.
+
+  @retval RETURN_SUCCESS            The container is valid.
+  @retval RETURN_INVALID_PARAMETER  The container is corrupted.
+**/
+STATIC
+RETURN_STATUS
+LzmaChunkedParse (
+  IN  CONST VOID            *Source,
+  IN  UINT32                SourceSize,
+  OUT LZMA_CHUNKED_CONTEXT  *Context,
+  OUT UINT32                *DecodedSize
+  )
+{
+  CONST LZMA_CHUNKED_HEADER  *Header;
+  RETURN_STATUS              Status;
+  UINT32                     ChunkSize;
+  UINT32                     ChunkCount;
+  UINT32                     TableSize;
+  UINT32                     DataSize;
+  UINT32                     Index;
+  UINT32                     Start;
+  UINT32                     End;
+  UINT32                     ChunkDecodedSize;
+  UINT32                     ScratchSize;
+
+  if (SourceSize < sizeof (LZMA_CHUNKED_HEADER)) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  Header       = Source;
+  *DecodedSize = ReadUnaligned32 (&Header->DecodedSize);
+  ChunkSize    = ReadUnaligned32 (&Header->ChunkSize);
+  ChunkCount   = ReadUnaligned32 (&Header->ChunkCount);
+
+  if ((ReadUnaligned32 (&Header->Signature) != LZMA_CHUNKED_SIGNATURE) || (ChunkSize == 0)) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  if (ChunkCount != *DecodedSize / ChunkSize + ((*DecodedSize % ChunkSize) != 0 ? 1 : 0)) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  //
+  // The offset table has ChunkCount + 1 entries.
+  //
+  if (ChunkCount >= (SourceSize - sizeof (LZMA_CHUNKED_HEADER)) / sizeof (UINT32)) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  TableSize = sizeof (LZMA_CHUNKED_HEADER) + (ChunkCount + 1) * sizeof (UINT32);
+  DataSize  = SourceSize - TableSize;
+
+  ZeroMem (Context, sizeof (*Context));
+  Context->OffsetTable = (CONST UINT8 *)Source + sizeof (LZMA_CHUNKED_HEADER);
+  Context->Data        = (CONST UINT8 *)Source + TableSize;
+  Context->ChunkSize   = ChunkSize;
+  Context->ChunkCount  = ChunkCount;
+  Context->WorkerCount = MIN (ChunkCount, LZMA_CHUNKED_MAX_WORKERS);
+
+  for (Index = 0; Index < ChunkCount; Index++) {
+    Start = ReadUnaligned32 ((CONST UINT32 *)Context->OffsetTable + Index);
+    End   = ReadUnaligned32 ((CONST UINT32 *)Context->OffsetTable + Index + 1);
+    if ((Start > End) || (End > DataSize) || (End - Start < LZMA_CHUNK_HEADER_SIZE)) {
+      return RETURN_INVALID_PARAMETER;
+    }
+
+    Status = LzmaUefiDecompressGetInfo (
+               Context->Data + Start,
+               End - Start,
+               &ChunkDecodedSize,
+               &ScratchSize
+               );
+    if (RETURN_ERROR (Status) || (ChunkDecodedSize != MIN (ChunkSize, *DecodedSize - Index * ChunkSize))) {
+      return RETURN_INVALID_PARAMETER;
+    }
+
+    Context->ScratchSize = ScratchSize;
+  }
+
+  return RETURN_SUCCESS;
+}
+
+/**
+  Decode chunks on the calling CPU until no chunk is left.
+
+  @param[in,out] Context  The decompression context.
+  @param[in]     Slot     The scratch buffer slot owned by the calling CPU.
+
+  @return The number of chunks decoded by the calling CPU.
+**/
+STATIC
+UINT32
+LzmaChunkedDecodeChunks (
+  IN OUT LZMA_CHUNKED_CONTEXT  *Context,
+  IN     UINT32                Slot
+  )
+{
+  UINT8          *Scratch;
+  UINT32         Chunk;
+  UINT32         Start;
+  UINT32         End;
+  UINT32         Count;
+  RETURN_STATUS  Status;
+
+  Scratch = Context->Scratch + (UINTN)Slot * Context->ScratchSize;
+  Count   = 0;
+
+  //
+  // Do not touch the counter once it has run past the end, so that it stays
+  // within ChunkCount plus one failed claim per CPU.
+  //
+  while (Context->NextChunk < Context->ChunkCount) {
+    Chunk = InterlockedIncrement (&Context->NextChunk) - 1;
+    if (Chunk >= Context->ChunkCount) {
+      break;
+    }
+
+    Start  = ReadUnaligned32 ((CONST UINT32 *)Context->OffsetTable + Chunk);
+    End    = ReadUnaligned32 ((CONST UINT32 *)Context->OffsetTable + Chunk + 1);
+    Status = LzmaUefiDecompress (
+               Context->Data + Start,
+               End - Start,
+               Context->Destination + (UINTN)Chunk * Context->ChunkSize,
+               Scratch
+               );
+    if (RETURN_ERROR (Status)) {
+      InterlockedIncrement (&Context->FailedChunks);
+    }
+
+    Count++;
+  }
+
+  return Count;
+}
+
+/**
+  Decode chunks on an AP.
+
+  APs beyond LZMA_CHUNKED_MAX_WORKERS find no free scratch buffer and return
+  at once.
+
+  @param[in,out] Buffer  The decompression context.
+**/
+STATIC
+VOID
+EFIAPI
+LzmaChunkedApWorker (
+  IN OUT VOID  *Buffer
+  )
+{
+  LZMA_CHUNKED_CONTEXT  *Context;
+  UINT32                Slot;
+
+  Context = Buffer;
+  if (Context->NextWorker >= Context->WorkerCount) {
+    return;
+  }
+
+  Slot = InterlockedIncrement (&Context->NextWorker) - 1;
+  if (Slot < Context->WorkerCount) {
+    LzmaChunkedDecodeChunks (Context, Slot);
+  }
+}
+
+/**
+  Decode chunks on the BSP.
+
+  @param[in,out] Buffer  The decompression context.
+**/
+STATIC
+VOID
+EFIAPI
+LzmaChunkedBspWorker (
+  IN OUT VOID  *Buffer
+  )
+{
+  LZMA_CHUNKED_CONTEXT  *Context;
+  UINT32                Count;
+
+  Context = Buffer;
+  Count   = LzmaChunkedDecodeChunks (Context, 0);
+
+  DEBUG ((
+    DEBUG_VERBOSE,
+    "LzmaChunked: BSP decoded %u of %u chunks\n",
+    Count,
+    Context->ChunkCount
+    ));
+}
+
+/**
+  Given a chunked LZMA source buffer, retrieve the size of the uncompressed
+  buffer and the size of the scratch buffer required to decompress it.
+
+  @param[in]  Source           The source buffer containing the compressed data.
+  @param[in]  SourceSize       The size, in bytes, of the source buffer.
+  @param[out] DestinationSize  The size, in bytes, of the uncompressed buffer.
+  @param[out] ScratchSize      The size, in bytes, of the scratch buffer.
+
+  @retval RETURN_SUCCESS            The sizes were returned.
+  @retval RETURN_INVALID_PARAMETER  The source buffer is not a valid chunked
+                                    LZMA container.
+**/
+RETURN_STATUS
+EFIAPI
+LzmaChunkedDecompressGetInfo (
+  IN  CONST VOID  *Source,
+  IN  UINT32      SourceSize,
+  OUT UINT32      *DestinationSize,
+  OUT UINT32      *ScratchSize
+  )
+{
+  RETURN_STATUS         Status;
+  LZMA_CHUNKED_CONTEXT  Context;
+
+  ASSERT (Source != NULL);
+  ASSERT (DestinationSize != NULL);
+  ASSERT (ScratchSize != NULL);
+
+  Status = LzmaChunkedParse (Source, SourceSize, &Context, DestinationSize);
+  if (RETURN_ERROR (Status)) {
+    return Status;
+  }
+
+  *ScratchSize = Context.WorkerCount * Context.ScratchSize;
+  return RETURN_SUCCESS;
+}
+
+/**
+  Decompress a chunked LZMA source buffer, spreading the chunks over all
+  enabled CPUs.
+
+  @param[in]     Source       The source buffer containing the compressed data.
+  @param[in]     SourceSize   The size, in bytes, of the source buffer.
+  @param[in,out] Destination  The destination buffer of the size returned by
+                              LzmaChunkedDecompressGetInfo().
+  @param[in,out] Scratch      The scratch buffer of the size returned by
+                              LzmaChunkedDecompressGetInfo().
+
+  @retval RETURN_SUCCESS            Decompression completed successfully.
+  @retval RETURN_INVALID_PARAMETER  The source buffer is corrupted.
+**/
+RETURN_STATUS
+EFIAPI
+LzmaChunkedDecompress (
+  IN CONST VOID  *Source,
+  IN UINT32      SourceSize,
+  IN OUT VOID    *Destination,
+  IN OUT VOID    *Scratch
+  )
+{
+  RETURN_STATUS         Status;
+  LZMA_CHUNKED_CONTEXT  Context;
+  UINT32                DecodedSize;
+
+  ASSERT (Source != NULL);
+
+  Status = LzmaChunkedParse (Source, SourceSize, &Context, &DecodedSize);
+  if (RETURN_ERROR (Status)) {
+    return Status;
+  }
+
+  if (Context.ChunkCount == 0) {
+    return RETURN_SUCCESS;
+  }
+
+  ASSERT (Destination != NULL);
+  ASSERT (Scratch != NULL);
+
+  Context.Destination = Destination;
+  Context.Scratch     = Scratch;
+  Context.NextWorker  = 1;
+
+  LzmaChunkedRunWorkers (LzmaChunkedApWorker, LzmaChunkedBspWorker, &Context);
+
+  ASSERT (Context.NextChunk >= Context.ChunkCount);
+  if (Context.FailedChunks != 0) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  return RETURN_SUCCESS;
+}
@@ -0,0 +1,115 @@
+/** @file
+  Internal declarations of the chunked LZMA GUIDed section extraction library.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef LZMA_CHUNKED_DECOMPRESS_INTERNAL_H_
+#define LZMA_CHUNKED_DECOMPRESS_INTERNAL_H_
+
+#include "LzmaDecompressLibInternal.h"
+
+///
+/// Largest number of CPUs that decode chunks at the same time. Each of them
+/// needs its own LZMA scratch buffer, so this bounds the scratch size.
+///
+#define LZMA_CHUNKED_MAX_WORKERS  16
+
+typedef struct {
+  ///
+  /// The chunk offset table and the chunk data following it.
+  ///
+  CONST UINT8        *OffsetTable;
+  CONST UINT8        *Data;
+  UINT8              *Destination;
+  UINT8              *Scratch;
+  UINT32             ScratchSize;
+  UINT32             ChunkSize;
+  UINT32             ChunkCount;
+  ///
+  /// Number of scratch buffers. Slot 0 belongs to the BSP.
+  ///
+  UINT32             WorkerCount;
+  volatile UINT32    NextWorker;
+  volatile UINT32    NextChunk;
+  volatile UINT32    FailedChunks;
+} LZMA_CHUNKED_CONTEXT;
+
+/**
+  Run ApProcedure on all enabled APs and BspProcedure on the BSP, and return
+  once all of them have finished.
+
+  If no MP service is available or no AP could be started, only BspProcedure
+  runs. Both procedures must tolerate running while the other one is still
+  running or has not started yet.
+
+  @param[in] ApProcedure   The procedure to run on the APs.
+  @param[in] BspProcedure  The procedure to run on the BSP.
+  @param[in] Argument      The parameter passed into both procedures.
+**/
+VOID
+LzmaChunkedRunWorkers (
+  IN EFI_AP_PROCEDURE  ApProcedure,
+  IN EFI_AP_PROCEDURE  BspProcedure,
+  IN VOID              *Argument
+  );
+
+/**
+  Register the chunked LZMA GUIDed section handlers with gLzmaChunkedCustomDecompressGuid.
+
+  @retval  RETURN_SUCCESS            Register successfully.
+  @retval  RETURN_OUT_OF_RESOURCES   No enough memory to store this handler.
+**/
+RETURN_STATUS
+LzmaChunkedRegisterHandlers (
+  VOID
+  );
+
+/**
+  Given a chunked LZMA source buffer, retrieve the size of the uncompressed
+  buffer and the size of the scratch buffer required to decompress it.
+
+  @param[in]  Source           The source buffer containing the compressed data.
+  @param[in]  SourceSize       The size, in bytes, of the source buffer.
+  @param[out] DestinationSize  The size, in bytes, of the uncompressed buffer.
+  @param[out] ScratchSize      The size, in bytes, of the scratch buffer.
+
+  @retval RETURN_SUCCESS            The sizes were returned.
+  @retval RETURN_INVALID_PARAMETER  The source buffer is not a valid chunked
+                                    LZMA container.
+**/
+RETURN_STATUS
+EFIAPI
+LzmaChunkedDecompressGetInfo (
+  IN  CONST VOID  *Source,
+  IN  UINT32      SourceSize,
+  OUT UINT32      *DestinationSize,
+  OUT UINT32      *ScratchSize
+  );
+
+/**
+  Decompress a chunked LZMA source buffer, spreading the chunks over all
+  enabled CPUs.
+
+  @param[in]     Source       The source buffer containing the compressed data.
+  @param[in]     SourceSize   The size, in bytes, of the source buffer.
+  @param[in,out] Destination  The destination buffer of the size returned by
+                              LzmaChunkedDecompressGetInfo().
+  @param[in,out] Scratch      The scratch buffer of the size returned by
+                              LzmaChunkedDecompressGetInfo().
+
+  @retval RETURN_SUCCESS            Decompression completed successfully.
+  @retval RETURN_INVALID_PARAMETER  The source buffer is corrupted.
+**/
+RETURN_STATUS
+EFIAPI
+LzmaChunkedDecompress (
+  IN CONST VOID  *Source,
+  IN UINT32      SourceSize,
+  IN OUT VOID    *Destination,
+  IN OUT VOID    *Scratch
+  );
+
+#endif
@@ -0,0 +1,80 @@
+/** @file
+  PEI part of the chunked LZMA GUIDed section extraction library. The chunks
+  are spread over the APs through the MP services PPI.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "LzmaChunkedDecompressInternal.h"
+#include <Ppi/MpServices.h>
+#include <Library/PeiServicesLib.h>
+#include <Library/PeiServicesTablePointerLib.h>
+
+/**
+  Run ApProcedure on all enabled APs and BspProcedure on the BSP, and return
+  once all of them have finished.
+
+  If no MP service is available or no AP could be started, only BspProcedure
+  runs. Both procedures must tolerate running while the other one is still
+  running or has not started yet.
+
+  @param[in] ApProcedure   The procedure to run on the APs.
+  @param[in] BspProcedure  The procedure to run on the BSP.
+  @param[in] Argument      The parameter passed into both procedures.
+**/
+VOID
+LzmaChunkedRunWorkers (
+  IN EFI_AP_PROCEDURE  ApProcedure,
+  IN EFI_AP_PROCEDURE  BspProcedure,
+  IN VOID              *Argument
+  )
+{
+  EFI_STATUS               Status;
+  EFI_PEI_MP_SERVICES_PPI  *MpServices;
+
+  Status = PeiServicesLocatePpi (
+             &gEfiPeiMpServicesPpiGuid,
+             0,
+             NULL,
+             (VOID **)&MpServices
+             );
+  if (!EFI_ERROR (Status)) {
+    //
+    // The PPI only offers a blocking StartupAllAPs(), so the BSP waits for the
+    // APs and then decodes whatever they left. EFI_NOT_STARTED means that there
+    // are no enabled APs, and the BSP decodes everything.
+    //
+    Status = MpServices->StartupAllAPs (
+                           GetPeiServicesTablePointer (),
+                           MpServices,
+                           ApProcedure,
+                           FALSE,
+                           0,
+                           Argument
+                           );
+    DEBUG ((DEBUG_VERBOSE, "LzmaChunked: StartupAllAPs - %r\n", Status));
+  }
+
+  BspProcedure (Argument);
+}
+
+/**
+  Register the chunked LZMA GUIDed section handlers.
+
+  @param[in] FileHandle   The handle of FFS header the loaded driver.
+  @param[in] PeiServices  The pointer to the PEI services.
+
+  @retval  EFI_SUCCESS            Register successfully.
+  @retval  EFI_OUT_OF_RESOURCES   No enough memory to store this handler.
+**/
+EFI_STATUS
+EFIAPI
+PeiLzmaChunkedDecompressLibConstructor (
+  IN EFI_PEI_FILE_HANDLE     FileHandle,
+  IN CONST EFI_PEI_SERVICES  **PeiServices
+  )
+{
+  return LzmaChunkedRegisterHandlers ();
+}
@@ -0,0 +1,417 @@
+/** @file
+  Unit tests of the chunked LZMA decompression.
+
+  The MP services are replaced by a stub that runs the AP procedure a given
+  number of times on the calling thread before the BSP procedure, which is
+  how the blocking PEI path behaves.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include "../LzmaChunkedDecompressInternal.h"
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UnitTestLib.h>
+
+#define UNIT_TEST_APP_NAME     "LzmaChunkedDecompress Unit Tests"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+#define TEST_CHUNK_SIZE    4096
+#define TEST_CHUNK_COUNT   4
+#define TEST_DECODED_SIZE  (3 * TEST_CHUNK_SIZE + 1000)
+
+///
+/// TEST_DECODED_SIZE bytes produced by TestPattern(), compressed with
+/// "LzmaCompress -e --chunk-size 4096".
+///
+STATIC CONST UINT8  mTestContainer[] = {
+  0x4c, 0x5a, 0x4d, 0x43, 0xe8, 0x33, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00,
+  0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbd, 0x00, 0x00, 0x00,
+  0x7b, 0x01, 0x00, 0x00, 0x3b, 0x02, 0x00, 0x00, 0x8d, 0x02, 0x00, 0x00,
+  0x5d, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xea, 0x84, 0xe2, 0x03, 0xfb, 0x23, 0xf2, 0x16,
+  0x88, 0x40, 0xdf, 0x00, 0x91, 0xd1, 0xf4, 0x03, 0x95, 0x22, 0x19, 0xff,
+  0xa6, 0x5e, 0xc1, 0x34, 0x4a, 0x6a, 0x05, 0x12, 0x40, 0xcb, 0x97, 0x76,
+  0xf6, 0x21, 0x8a, 0xc3, 0xee, 0xc4, 0xf8, 0xb5, 0x13, 0x44, 0x6d, 0xd3,
+  0xe6, 0x56, 0xd9, 0x3f, 0x40, 0x60, 0x30, 0xdb, 0xf0, 0x8a, 0xbd, 0xa0,
+  0x89, 0x2c, 0x41, 0xb5, 0x7e, 0x0b, 0x62, 0x55, 0x72, 0xef, 0x75, 0xe8,
+  0x64, 0x3e, 0xc3, 0xce, 0xd8, 0x64, 0x07, 0xa4, 0x5b, 0x51, 0x0c, 0x7e,
+  0xcd, 0x60, 0x72, 0xe7, 0x4c, 0x08, 0x11, 0x3f, 0x64, 0x81, 0x39, 0xff,
+  0x85, 0x58, 0xef, 0x81, 0x5e, 0x0d, 0xd3, 0x88, 0xad, 0x68, 0xd0, 0xe0,
+  0x37, 0x9d, 0x12, 0x51, 0x0c, 0xaa, 0x46, 0x18, 0x6d, 0x57, 0x16, 0x90,
+  0x46, 0xb5, 0xea, 0xd4, 0x40, 0xa2, 0x8e, 0x3c, 0xd8, 0xef, 0x16, 0xbc,
+  0x6b, 0xed, 0x73, 0x05, 0x8f, 0xee, 0x3c, 0xce, 0x20, 0xd8, 0x47, 0x46,
+  0x8c, 0x7b, 0x62, 0x8a, 0xf9, 0x10, 0xca, 0x0e, 0x25, 0x7d, 0x25, 0x8e,
+  0x78, 0xe0, 0x9a, 0x59, 0x6b, 0x1d, 0xcc, 0xee, 0xf3, 0x73, 0xcf, 0x6e,
+  0x34, 0xbc, 0x02, 0xff, 0xe9, 0xb6, 0x9a, 0x6d, 0x00, 0x5d, 0x00, 0x10,
+  0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x16,
+  0x8c, 0x02, 0xb7, 0xfc, 0x22, 0xf4, 0xa7, 0x0c, 0x7e, 0x80, 0x73, 0x37,
+  0x25, 0x5a, 0xb2, 0x94, 0xfc, 0xdb, 0x92, 0xe6, 0xc5, 0x78, 0xf9, 0x7d,
+  0xde, 0x8f, 0xce, 0x22, 0x89, 0x44, 0x96, 0x4a, 0xb1, 0xdc, 0x66, 0xd4,
+  0xfd, 0x3f, 0x8c, 0xbf, 0xab, 0x70, 0x81, 0x0f, 0xa4, 0x73, 0x53, 0x68,
+  0x4f, 0xd7, 0x7b, 0xd1, 0x4c, 0x37, 0x8f, 0xd7, 0x53, 0x00, 0xca, 0xbd,
+  0x2c, 0xb8, 0x02, 0xb4, 0x6c, 0x72, 0x89, 0xfe, 0x56, 0x6d, 0x4b, 0x1e,
+  0x77, 0x83, 0x08, 0xff, 0x89, 0xa1, 0x2a, 0x12, 0x78, 0x53, 0xaa, 0x28,
+  0x23, 0x89, 0x8b, 0xe9, 0x93, 0x8c, 0x2d, 0x32, 0x16, 0x74, 0x3e, 0x5c,
+  0x69, 0x19, 0xb7, 0xb8, 0xc6, 0xce, 0xd6, 0x9f, 0x9c, 0xa1, 0x6e, 0xf0,
+  0x5c, 0xdf, 0x36, 0x8b, 0x79, 0xd7, 0xf2, 0x1e, 0x37, 0x51, 0x2e, 0xf9,
+  0x32, 0x47, 0xb3, 0x63, 0x5a, 0x47, 0xce, 0x38, 0x24, 0x77, 0xfb, 0x66,
+  0x32, 0x2e, 0x05, 0x01, 0x57, 0x24, 0x81, 0x29, 0xa9, 0x76, 0x95, 0x20,
+  0x51, 0x2c, 0x7d, 0xba, 0x08, 0x51, 0xd7, 0x45, 0x1a, 0x52, 0x24, 0x71,
+  0x02, 0x64, 0x7e, 0xa7, 0xf3, 0x22, 0x5a, 0x0b, 0xfa, 0xb2, 0xb7, 0xf1,
+  0xfb, 0x9e, 0x8c, 0xd1, 0xe0, 0x90, 0x00, 0x5d, 0x00, 0x10, 0x00, 0x00,
+  0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x2d, 0x17, 0x48,
+  0x67, 0x6b, 0x37, 0xcb, 0xa0, 0xac, 0x94, 0xa4, 0x23, 0x18, 0xc0, 0x77,
+  0xcb, 0xbe, 0xb9, 0x89, 0x60, 0x7b, 0x78, 0x5c, 0x3b, 0x46, 0xe8, 0xf2,
+  0x94, 0xff, 0xe7, 0x4c, 0xba, 0x89, 0x0d, 0xf5, 0xfd, 0x65, 0xfd, 0x8c,
+  0xba, 0x32, 0xa8, 0xc3, 0x7f, 0x17, 0x05, 0x46, 0x93, 0x7b, 0xf4, 0xc8,
+  0xdc, 0x9c, 0x87, 0x6a, 0xca, 0xf9, 0xac, 0xf1, 0x93, 0xb2, 0x76, 0x55,
+  0x62, 0x33, 0x15, 0xeb, 0x35, 0x85, 0x7a, 0xc3, 0x38, 0x14, 0xd3, 0xed,
+  0xa3, 0x28, 0x71, 0x64, 0x6e, 0x1b, 0x53, 0xee, 0x8b, 0x51, 0x87, 0x11,
+  0x63, 0xcb, 0x5d, 0x5e, 0x94, 0x76, 0x56, 0x27, 0x56, 0x9d, 0xe0, 0x40,
+  0x47, 0x4b, 0x41, 0x39, 0x1f, 0x66, 0x23, 0x45, 0x2a, 0x35, 0x14, 0x7d,
+  0x90, 0x8b, 0x2a, 0xe1, 0x21, 0xbe, 0x6d, 0xf9, 0x07, 0x74, 0x75, 0xc6,
+  0x3d, 0x43, 0x34, 0xa8, 0x1e, 0x2d, 0x72, 0x71, 0xe9, 0x8e, 0x32, 0x67,
+  0xa7, 0xed, 0x16, 0x4f, 0x77, 0xc5, 0x92, 0x39, 0xa7, 0xc1, 0xc9, 0x0f,
+  0x0d, 0x12, 0x95, 0xdc, 0xcf, 0x3b, 0xed, 0x03, 0xfd, 0x36, 0x56, 0xe3,
+  0xd6, 0xf8, 0xf1, 0xba, 0x28, 0xde, 0x7b, 0x5e, 0x40, 0xfe, 0xd4, 0xf6,
+  0x7c, 0x95, 0x66, 0x63, 0x81, 0xf6, 0x00, 0x5d, 0x00, 0x10, 0x00, 0x00,
+  0xe8, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x43, 0xa2, 0x8d,
+  0x60, 0x86, 0x43, 0x48, 0x1f, 0x6f, 0x36, 0x8a, 0x3d, 0x87, 0x10, 0x7d,
+  0xb1, 0xbf, 0x40, 0x93, 0xdc, 0xf4, 0xfd, 0x99, 0x99, 0xe6, 0xef, 0xb1,
+  0x9e, 0x51, 0x0a, 0xcf, 0x7a, 0x3b, 0x28, 0x0c, 0x0c, 0xa1, 0x8e, 0xea,
+  0xe1, 0x12, 0x77, 0xf2, 0xc0, 0x30, 0xe3, 0xf6, 0xe5, 0x68, 0x0b, 0xe8,
+  0x52, 0x6a, 0x28, 0x50, 0x9a, 0xf6, 0x59, 0x6c, 0x43, 0x18, 0xb4, 0x5f,
+  0xa4, 0xdd, 0x7b, 0x84, 0x00,
+};
+
+///
+/// Number of times the MP stub runs the AP procedure.
+///
+STATIC UINTN  mTestApCount;
+
+/**
+  Return the expected byte at a given offset of the decoded data.
+
+  @param[in] Index  The offset.
+
+  @return The byte.
+**/
+STATIC
+UINT8
+TestPattern (
+  IN UINTN  Index
+  )
+{
+  return (UINT8)((Index / 97) + (Index % 7) * 3);
+}
+
+/**
+  MP services stub, see LzmaChunkedRunWorkers() in the PEI and DXE instances.
+
+  @param[in] ApProcedure   The procedure to run on the APs.
+  @param[in] BspProcedure  The procedure to run on the BSP.
+  @param[in] Argument      The parameter passed into both procedures.
+**/
+VOID
+LzmaChunkedRunWorkers (
+  IN EFI_AP_PROCEDURE  ApProcedure,
+  IN EFI_AP_PROCEDURE  BspProcedure,
+  IN VOID              *Argument
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < mTestApCount; Index++) {
+    ApProcedure (Argument);
+  }
+
+  BspProcedure (Argument);
+}
+
+/**
+  Decode a container and compare the result with the test pattern.
+
+  @param[in] Source      The container.
+  @param[in] SourceSize  The size, in bytes, of the container.
+
+  @retval RETURN_SUCCESS  The container decoded to the test pattern.
+  @retval other           GetInfo or decoding failed, or the data differs.
+**/
+STATIC
+RETURN_STATUS
+TestDecode (
+  IN CONST VOID  *Source,
+  IN UINT32      SourceSize
+  )
+{
+  RETURN_STATUS  Status;
+  UINT32         DestinationSize;
+  UINT32         ScratchSize;
+  UINT8          *Destination;
+  VOID           *Scratch;
+  UINTN          Index;
+
+  Status = LzmaChunkedDecompressGetInfo (Source, SourceSize, &DestinationSize, &ScratchSize);
+  if (RETURN_ERROR (Status)) {
+    return Status;
+  }
+
+  Destination = AllocatePool (DestinationSize);
+  Scratch     = AllocatePool (ScratchSize);
+  if ((Destination == NULL) || (Scratch == NULL)) {
+    Status = RETURN_OUT_OF_RESOURCES;
+    goto Done;
+  }
+
+  Status = LzmaChunkedDecompress (Source, SourceSize, Destination, Scratch);
+  if (RETURN_ERROR (Status)) {
+    goto Done;
+  }
+
+  for (Index = 0; Index < DestinationSize; Index++) {
+    if (Destination[Index] != TestPattern (Index)) {
+      Status = RETURN_VOLUME_CORRUPTED;
+      break;
+    }
+  }
+
+Done:
+  if (Destination != NULL) {
+    FreePool (Destination);
+  }
+
+  if (Scratch != NULL) {
+    FreePool (Scratch);
+  }
+
+  return Status;
+}
+
+/**
+  GetInfo reports the decoded size and one scratch buffer per chunk.
+
+  @param[in] Context  Unused.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+GetInfoShouldReportSizes (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  RETURN_STATUS  Status;
+  UINT32         DestinationSize;
+  UINT32         ScratchSize;
+  UINT32         ChunkDestinationSize;
+  UINT32         ChunkScratchSize;
+
+  Status = LzmaChunkedDecompressGetInfo (mTestContainer, sizeof (mTestContainer), &DestinationSize, &ScratchSize);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_EQUAL (DestinationSize, TEST_DECODED_SIZE);
+
+  //
+  // The first chunk follows the header and the offset table.
+  //
+  Status = LzmaUefiDecompressGetInfo (
+             mTestContainer + sizeof (LZMA_CHUNKED_HEADER) + (TEST_CHUNK_COUNT + 1) * sizeof (UINT32),
+             sizeof (mTestContainer) - sizeof (LZMA_CHUNKED_HEADER) - (TEST_CHUNK_COUNT + 1) * sizeof (UINT32),
+             &ChunkDestinationSize,
+             &ChunkScratchSize
+             );
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_EQUAL (ChunkDestinationSize, TEST_CHUNK_SIZE);
+  UT_ASSERT_EQUAL (ScratchSize, TEST_CHUNK_COUNT * ChunkScratchSize);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Decode with the given number of APs.
+
+  @param[in] Context  The number of APs.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+DecodeShouldMatchPattern (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  mTestApCount = (UINTN)Context;
+  UT_ASSERT_NOT_EFI_ERROR (TestDecode (mTestContainer, sizeof (mTestContainer)));
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Corrupted headers, offset tables and chunks are rejected.
+
+  @param[in] Context  Unused.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+CorruptedContainerShouldFail (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINT8   *Copy;
+  UINT32  *Offsets;
+  UINT32  Size;
+
+  Size = sizeof (mTestContainer);
+  Copy = AllocateCopyPool (Size, mTestContainer);
+  UT_ASSERT_NOT_NULL (Copy);
+
+  Offsets      = (UINT32 *)(Copy + sizeof (LZMA_CHUNKED_HEADER));
+  mTestApCount = 2;
+
+  //
+  // Truncated header and offset table.
+  //
+  UT_ASSERT_STATUS_EQUAL (TestDecode (Copy, sizeof (LZMA_CHUNKED_HEADER) - 1), RETURN_INVALID_PARAMETER);
+  UT_ASSERT_STATUS_EQUAL (TestDecode (Copy, sizeof (LZMA_CHUNKED_HEADER) + TEST_CHUNK_COUNT * sizeof (UINT32)), RETURN_INVALID_PARAMETER);
+
+  //
+  // Truncated last chunk.
+  //
+  UT_ASSERT_STATUS_EQUAL (TestDecode (Copy, Size - 1), RETURN_INVALID_PARAMETER);
+
+  //
+  // Bad signature.
+  //
+  Copy[0] ^= 1;
+  UT_ASSERT_STATUS_EQUAL (TestDecode (Copy, Size), RETURN_INVALID_PARAMETER);
+  Copy[0] ^= 1;
+
+  //
+  // Chunk count that does not match the sizes.
+  //
+  ((LZMA_CHUNKED_HEADER *)Copy)->ChunkCount++;
+  UT_ASSERT_STATUS_EQUAL (TestDecode (Copy, Size), RETURN_INVALID_PARAMETER);
+  ((LZMA_CHUNKED_HEADER *)Copy)->ChunkCount--;
+
+  //
+  // Chunk size that makes the chunks decode past their share of the output.
+  //
+  ((LZMA_CHUNKED_HEADER *)Copy)->ChunkSize     /= 2;
+  ((LZMA_CHUNKED_HEADER *)Copy)->DecodedSize    = TEST_CHUNK_COUNT * TEST_CHUNK_SIZE / 2;
+  UT_ASSERT_STATUS_EQUAL (TestDecode (Copy, Size), RETURN_INVALID_PARAMETER);
+  ((LZMA_CHUNKED_HEADER *)Copy)->ChunkSize   = TEST_CHUNK_SIZE;
+  ((LZMA_CHUNKED_HEADER *)Copy)->DecodedSize = TEST_DECODED_SIZE;
+
+  //
+  // Offsets that go backwards.
+  //
+  Offsets[2] = Offsets[1] - 1;
+  UT_ASSERT_STATUS_EQUAL (TestDecode (Copy, Size), RETURN_INVALID_PARAMETER);
+  CopyMem (Copy, mTestContainer, Size);
+
+  //
+  // Invalid LZMA properties of the last chunk make it fail to decode.
+  //
+  Copy[sizeof (LZMA_CHUNKED_HEADER) + (TEST_CHUNK_COUNT + 1) * sizeof (UINT32) + Offsets[TEST_CHUNK_COUNT - 1]] = 0xFF;
+  UT_ASSERT_STATUS_EQUAL (TestDecode (Copy, Size), RETURN_INVALID_PARAMETER);
+
+  CopyMem (Copy, mTestContainer, Size);
+  UT_ASSERT_NOT_EFI_ERROR (TestDecode (Copy, Size));
+
+  FreePool (Copy);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the
+  chunked LZMA decompression and run the unit tests.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      ChunkedTests;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  //
+  // Start setting up the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&ChunkedTests, Framework, "Chunked LZMA Decompress Tests", "LzmaChunkedDecompress", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for Chunked LZMA Decompress Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  //
+  // --------------Suite--------Description------------Name--------------Function----------------Pre---Post---Context-----------
+  //
+  AddTestCase (ChunkedTests, "GetInfo reports the sizes", "GetInfo", GetInfoShouldReportSizes, NULL, NULL, NULL);
+  AddTestCase (ChunkedTests, "Decode without MP service", "DecodeBsp", DecodeShouldMatchPattern, NULL, NULL, (UNIT_TEST_CONTEXT)0);
+  AddTestCase (ChunkedTests, "Decode with one AP", "DecodeOneAp", DecodeShouldMatchPattern, NULL, NULL, (UNIT_TEST_CONTEXT)1);
+  AddTestCase (ChunkedTests, "Decode with more APs than workers", "DecodeManyAps", DecodeShouldMatchPattern, NULL, NULL, (UNIT_TEST_CONTEXT)(LZMA_CHUNKED_MAX_WORKERS + 4));
+  AddTestCase (ChunkedTests, "Corrupted containers are rejected", "Corrupted", CorruptedContainerShouldFail, NULL, NULL, NULL);
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+///
+/// Avoid ECC error for function name that starts with lower case letter
+///
+#define LzmaChunkedDecompressUnitTestMain  main
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+
+  @param[in] Argc  Number of arguments
+  @param[in] Argv  Array of pointers to arguments
+
+  @retval 0      Success
+  @retval other  Error
+**/
+INT32
+LzmaChunkedDecompressUnitTestMain (
+  IN INT32  Argc,
+  IN CHAR8  *Argv[]
+  )
+{
+  UnitTestingEntry ();
+  return 0;
+}
@@ -75,6 +75,20 @@
 ///
 #define HTTP_HEADER_ACCEPT_RANGES  "Accept-Ranges"
 
+///
+/// Range Request Header
+/// The Range request-header field asks the server to send only
+/// the given byte ranges of the representation.
+///
+#define HTTP_HEADER_RANGE  "Range"
+
+///
+/// Content-Range Response Header
+/// The Content-Range response-header field indicates where in the
+/// full representation a partial body belongs.
+///
+#define HTTP_HEADER_CONTENT_RANGE  "Content-Range"
+
 ///
 /// Accept-Encoding Request Header
 /// The Accept-Encoding request-header field is similar to Accept,
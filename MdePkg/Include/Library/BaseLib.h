@@ -3233,6 +3233,39 @@ QuickSort (
   OUT VOID                    *BufferOneElement
   );
 
+/**
+  Sort an array of elements by an unsigned 64-bit key stored in each element.
+
+  The sort is stable: elements with equal keys keep their relative order. It
+  does not call a comparison function, and already sorted input is detected in
+  a single pass.
+
+  if BufferToSort is NULL, then ASSERT.
+  if ScratchBuffer is NULL, then ASSERT.
+  if KeyOffset + sizeof (UINT64) is larger than ElementSize, then ASSERT.
+  if Count is larger than MAX_UINT32, then ASSERT.
+
+  if Count is < 2 then perform no action.
+
+  @param[in, out] BufferToSort   On call a buffer of (possibly sorted) elements,
+                                 on return a buffer of sorted elements.
+  @param[in]      Count          The number of elements in the buffer to sort.
+  @param[in]      ElementSize    Size of an element in bytes.
+  @param[in]      KeyOffset      Offset of the key in an element in bytes. The
+                                 key does not need to be aligned.
+  @param[out]     ScratchBuffer  Caller provided buffer of Count * ElementSize
+                                 bytes. Its content is undefined on return.
+**/
+VOID
+EFIAPI
+SortByUint64Key (
+  IN OUT VOID   *BufferToSort,
+  IN     UINTN  Count,
+  IN     UINTN  ElementSize,
+  IN     UINTN  KeyOffset,
+  OUT    VOID   *ScratchBuffer
+  );
+
 /**
   Shifts a 64-bit integer left between 0 and 63 bits. The low bits are filled
   with zeros. The shifted value is returned.
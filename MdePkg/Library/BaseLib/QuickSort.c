@@ -1,13 +1,422 @@
 /** @file
   Math worker functions.
 
+  QuickSort() is an introsort: a median-of-three quicksort that switches to
+  heapsort once the recursion gets deeper than 2 * log2 (Count), and to
+  insertion sort for short ranges. Input that is already sorted or reversed
+  is handled in a single pass. Any input takes O(n log n) time and the stack
+  depth is bounded by O(log n).
+
+  SortByUint64Key() is a stable LSD radix sort for elements ordered by an
+  unsigned 64-bit key.
+
   Copyright (c) 2021, Intel Corporation. All rights reserved.<BR>
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
   SPDX-License-Identifier: BSD-2-Clause-Patent
 
 **/
 
 #include "BaseLibInternals.h"
 
+///
+/// Ranges of at most this many elements are sorted with insertion sort.
+///
+#define QUICK_SORT_INSERTION_THRESHOLD  16
+
+///
+/// Ranges of more than this many elements take the pivot from nine samples.
+///
+#define QUICK_SORT_NINTHER_THRESHOLD  128
+
+typedef enum {
+  QuickSortSwapBytes,
+  QuickSortSwapUint32,
+  QuickSortSwapUint64,
+  QuickSortSwapUintn
+} QUICK_SORT_SWAP_TYPE;
+
+typedef struct {
+  UINTN                   ElementSize;
+  BASE_SORT_COMPARE       CompareFunction;
+  QUICK_SORT_SWAP_TYPE    SwapType;
+  VOID                    *BufferOneElement;
+} QUICK_SORT_CONTEXT;
+
+/**
+  Swap two elements.
+
+  The elements are swapped in place with the widest access the element size
+  and the buffer alignment allow for.
+
+  @param[in] Context   The sort context.
+  @param[in] Element1  The first element.
+  @param[in] Element2  The second element.
+**/
+STATIC
+VOID
+QuickSortSwap (
+  IN CONST QUICK_SORT_CONTEXT  *Context,
+  IN       UINT8               *Element1,
+  IN       UINT8               *Element2
+  )
+{
+  UINT64  Value64;
+  UINT32  Value32;
+  UINTN   ValueN;
+  UINT8   Value8;
+  UINTN   Index;
+
+  switch (Context->SwapType) {
+    case QuickSortSwapUint32:
+      Value32             = *(UINT32 *)Element1;
+      *(UINT32 *)Element1 = *(UINT32 *)Element2;
+      *(UINT32 *)Element2 = Value32;
+      break;
+
+    case QuickSortSwapUint64:
+      Value64             = *(UINT64 *)Element1;
+      *(UINT64 *)Element1 = *(UINT64 *)Element2;
+      *(UINT64 *)Element2 = Value64;
+      break;
+
+    case QuickSortSwapUintn:
+      for (Index = 0; Index < Context->ElementSize; Index += sizeof (UINTN)) {
+        ValueN                       = *(UINTN *)(Element1 + Index);
+        *(UINTN *)(Element1 + Index) = *(UINTN *)(Element2 + Index);
+        *(UINTN *)(Element2 + Index) = ValueN;
+      }
+
+      break;
+
+    default:
+      for (Index = 0; Index < Context->ElementSize; Index++) {
+        Value8          = Element1[Index];
+        Element1[Index] = Element2[Index];
+        Element2[Index] = Value8;
+      }
+
+      break;
+  }
+}
+
+/**
+  Sort a short range with insertion sort.
+
+  @param[in]      Context  The sort context.
+  @param[in, out] Base     The first element of the range.
+  @param[in]      Count    The number of elements in the range.
+**/
+STATIC
+VOID
+QuickSortInsertion (
+  IN CONST QUICK_SORT_CONTEXT  *Context,
+  IN OUT   UINT8               *Base,
+  IN       UINTN               Count
+  )
+{
+  UINTN  ElementSize;
+  UINTN  Index;
+  UINTN  Insert;
+
+  ElementSize = Context->ElementSize;
+
+  for (Index = 1; Index < Count; Index++) {
+    if (Context->CompareFunction (Base + (Index - 1) * ElementSize, Base + Index * ElementSize) <= 0) {
+      continue;
+    }
+
+    //
+    // Base[Index] goes before Base[Index - 1]. Find its slot, then move the
+    // elements in between up by one with a single copy.
+    //
+    CopyMem (Context->BufferOneElement, Base + Index * ElementSize, ElementSize);
+    Insert = Index - 1;
+    while (Insert > 0 &&
+           Context->CompareFunction (Base + (Insert - 1) * ElementSize, Context->BufferOneElement) > 0)
+    {
+      Insert--;
+    }
+
+    CopyMem (Base + (Insert + 1) * ElementSize, Base + Insert * ElementSize, (Index - Insert) * ElementSize);
+    CopyMem (Base + Insert * ElementSize, Context->BufferOneElement, ElementSize);
+  }
+}
+
+/**
+  Sift an element of a max-heap down to its place.
+
+  @param[in]      Context  The sort context.
+  @param[in, out] Base     The first element of the heap.
+  @param[in]      Root     The index of the element to sift down.
+  @param[in]      Count    The number of elements in the heap.
+**/
+STATIC
+VOID
+QuickSortSiftDown (
+  IN CONST QUICK_SORT_CONTEXT  *Context,
+  IN OUT   UINT8               *Base,
+  IN       UINTN               Root,
+  IN       UINTN               Count
+  )
+{
+  UINTN  ElementSize;
+  UINTN  Child;
+
+  ElementSize = Context->ElementSize;
+
+  while (Root < Count / 2) {
+    Child = 2 * Root + 1;
+    if ((Child + 1 < Count) &&
+        (Context->CompareFunction (Base + Child * ElementSize, Base + (Child + 1) * ElementSize) < 0))
+    {
+      Child++;
+    }
+
+    if (Context->CompareFunction (Base + Root * ElementSize, Base + Child * ElementSize) >= 0) {
+      return;
+    }
+
+    QuickSortSwap (Context, Base + Root * ElementSize, Base + Child * ElementSize);
+    Root = Child;
+  }
+}
+
+/**
+  Sort a range with heapsort.
+
+  @param[in]      Context  The sort context.
+  @param[in, out] Base     The first element of the range.
+  @param[in]      Count    The number of elements in the range.
+**/
+STATIC
+VOID
+QuickSortHeap (
+  IN CONST QUICK_SORT_CONTEXT  *Context,
+  IN OUT   UINT8               *Base,
+  IN       UINTN               Count
+  )
+{
+  UINTN  Index;
+
+  for (Index = Count / 2; Index > 0; Index--) {
+    QuickSortSiftDown (Context, Base, Index - 1, Count);
+  }
+
+  for (Index = Count - 1; Index > 0; Index--) {
+    QuickSortSwap (Context, Base, Base + Index * Context->ElementSize);
+    QuickSortSiftDown (Context, Base, 0, Index);
+  }
+}
+
+/**
+  Return the median of three elements.
+
+  @param[in] Context   The sort context.
+  @param[in] Element1  The first element.
+  @param[in] Element2  The second element.
+  @param[in] Element3  The third element.
+
+  @return The element that compares neither less nor greater than both others.
+**/
+STATIC
+UINT8 *
+QuickSortMedian3 (
+  IN CONST QUICK_SORT_CONTEXT  *Context,
+  IN       UINT8               *Element1,
+  IN       UINT8               *Element2,
+  IN       UINT8               *Element3
+  )
+{
+  if (Context->CompareFunction (Element1, Element2) < 0) {
+    if (Context->CompareFunction (Element2, Element3) < 0) {
+      return Element2;
+    }
+
+    return (Context->CompareFunction (Element1, Element3) < 0) ? Element3 : Element1;
+  }
+
+  if (Context->CompareFunction (Element1, Element3) < 0) {
+    return Element1;
+  }
+
+  return (Context->CompareFunction (Element2, Element3) < 0) ? Element3 : Element2;
+}
+
+/**
+  Partition a range around a pivot.
+
+  The pivot is the median of the first, middle and last element, or for long
+  ranges the median of three such medians of nine evenly spaced elements.
+
+  @param[in]      Context  The sort context.
+  @param[in, out] Base     The first element of the range.
+  @param[in]      Count    The number of elements in the range, at least 3.
+
+  @return The index of the pivot. Elements before it compare less than or
+          equal to it, elements after it compare greater than or equal to it.
+**/
+STATIC
+UINTN
+QuickSortPartition (
+  IN CONST QUICK_SORT_CONTEXT  *Context,
+  IN OUT   UINT8               *Base,
+  IN       UINTN               Count
+  )
+{
+  UINTN  ElementSize;
+  UINT8  *First;
+  UINT8  *Middle;
+  UINT8  *Last;
+  UINT8  *Pivot;
+  UINTN  Step;
+  UINTN  Left;
+  UINTN  Right;
+
+  ElementSize = Context->ElementSize;
+  First       = Base;
+  Middle      = Base + (Count / 2) * ElementSize;
+  Last        = Base + (Count - 1) * ElementSize;
+
+  if (Count > QUICK_SORT_NINTHER_THRESHOLD) {
+    Step  = (Count / 8) * ElementSize;
+    Pivot = QuickSortMedian3 (
+              Context,
+              QuickSortMedian3 (Context, First, First + Step, First + 2 * Step),
+              QuickSortMedian3 (Context, Middle - Step, Middle, Middle + Step),
+              QuickSortMedian3 (Context, Last - 2 * Step, Last - Step, Last)
+              );
+  } else {
+    Pivot = QuickSortMedian3 (Context, First, Middle, Last);
+  }
+
+  //
+  // Move the pivot to the front where it stays while the rest of the range is
+  // partitioned.
+  //
+  if (Pivot != First) {
+    QuickSortSwap (Context, First, Pivot);
+  }
+
+  //
+  // Both scans stop on elements equal to the pivot, so ranges with many equal
+  // elements are still split in the middle.
+  //
+  Left  = 0;
+  Right = Count;
+  while (TRUE) {
+    do {
+      Left++;
+    } while (Left < Count && Context->CompareFunction (Base + Left * ElementSize, First) < 0);
+
+    do {
+      Right--;
+    } while (Context->CompareFunction (Base + Right * ElementSize, First) > 0);
+
+    if (Left >= Right) {
+      break;
+    }
+
+    QuickSortSwap (Context, Base + Left * ElementSize, Base + Right * ElementSize);
+  }
+
+  QuickSortSwap (Context, First, Base + Right * ElementSize);
+  return Right;
+}
+
+/**
+  Handle input that is already in ascending or strictly descending order.
+
+  Such input is common, for example for memory maps and address lists, and it
+  is detected with one pass that stops at the first element out of order.
+
+  @param[in]      Context  The sort context.
+  @param[in, out] Base     The first element of the range.
+  @param[in]      Count    The number of elements in the range, at least 2.
+
+  @retval TRUE   The range was in order, or in reverse order and was reversed.
+  @retval FALSE  The range is neither and still has to be sorted.
+**/
+STATIC
+BOOLEAN
+QuickSortPresorted (
+  IN CONST QUICK_SORT_CONTEXT  *Context,
+  IN OUT   UINT8               *Base,
+  IN       UINTN               Count
+  )
+{
+  UINTN    ElementSize;
+  UINTN    Index;
+  BOOLEAN  Descending;
+
+  ElementSize = Context->ElementSize;
+  Descending  = (BOOLEAN)(Context->CompareFunction (Base, Base + ElementSize) > 0);
+
+  for (Index = 2; Index < Count; Index++) {
+    if (Descending) {
+      if (Context->CompareFunction (Base + (Index - 1) * ElementSize, Base + Index * ElementSize) <= 0) {
+        return FALSE;
+      }
+    } else if (Context->CompareFunction (Base + (Index - 1) * ElementSize, Base + Index * ElementSize) > 0) {
+      return FALSE;
+    }
+  }
+
+  if (Descending) {
+    for (Index = 0; Index < Count / 2; Index++) {
+      QuickSortSwap (Context, Base + Index * ElementSize, Base + (Count - 1 - Index) * ElementSize);
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Sort a range with introsort.
+
+  Only the smaller partition is sorted recursively, so the recursion depth is
+  at most log2 (Count).
+
+  @param[in]      Context     The sort context.
+  @param[in, out] Base        The first element of the range.
+  @param[in]      Count       The number of elements in the range.
+  @param[in]      DepthLimit  The number of partitioning steps left before the
+                              range is sorted with heapsort.
+**/
+STATIC
+VOID
+QuickSortIntro (
+  IN CONST QUICK_SORT_CONTEXT  *Context,
+  IN OUT   UINT8               *Base,
+  IN       UINTN               Count,
+  IN       UINTN               DepthLimit
+  )
+{
+  UINTN  Pivot;
+  UINTN  RightCount;
+
+  while (Count > QUICK_SORT_INSERTION_THRESHOLD) {
+    if (DepthLimit == 0) {
+      QuickSortHeap (Context, Base, Count);
+      return;
+    }
+
+    DepthLimit--;
+
+    Pivot      = QuickSortPartition (Context, Base, Count);
+    RightCount = Count - Pivot - 1;
+    if (Pivot < RightCount) {
+      QuickSortIntro (Context, Base, Pivot, DepthLimit);
+      Base  += (Pivot + 1) * Context->ElementSize;
+      Count  = RightCount;
+    } else {
+      QuickSortIntro (Context, Base + (Pivot + 1) * Context->ElementSize, RightCount, DepthLimit);
+      Count = Pivot;
+    }
+  }
+
+  QuickSortInsertion (Context, Base, Count);
+}
+
 /**
   This function is identical to perform QuickSort,
   except that is uses the pre-allocated buffer so the in place sorting does not need to
@@ -41,9 +450,8 @@ QuickSort (
   OUT VOID                    *BufferOneElement
   )
 {
-  VOID   *Pivot;
-  UINTN  LoopCount;
-  UINTN  NextSwapLocation;
+  QUICK_SORT_CONTEXT  Context;
+  UINTN               Alignment;
 
   ASSERT (BufferToSort     != NULL);
   ASSERT (CompareFunction  != NULL);
@@ -54,64 +462,165 @@ QuickSort (
     return;
   }
 
-  NextSwapLocation = 0;
+  Context.ElementSize      = ElementSize;
+  Context.CompareFunction  = CompareFunction;
+  Context.BufferOneElement = BufferOneElement;
 
   //
-  // pick a pivot (we choose last element)
+  // Every element is aligned like the buffer when the element size is a
+  // multiple of the access size.
   //
-  Pivot = ((UINT8 *)BufferToSort + ((Count - 1) * ElementSize));
+  Alignment = (UINTN)BufferToSort;
+  if ((ElementSize == sizeof (UINT64)) && ((Alignment & (sizeof (UINT64) - 1)) == 0)) {
+    Context.SwapType = QuickSortSwapUint64;
+  } else if ((ElementSize == sizeof (UINT32)) && ((Alignment & (sizeof (UINT32) - 1)) == 0)) {
+    Context.SwapType = QuickSortSwapUint32;
+  } else if (((ElementSize & (sizeof (UINTN) - 1)) == 0) && ((Alignment & (sizeof (UINTN) - 1)) == 0)) {
+    Context.SwapType = QuickSortSwapUintn;
+  } else {
+    Context.SwapType = QuickSortSwapBytes;
+  }
+
+  if (QuickSortPresorted (&Context, BufferToSort, Count)) {
+    return;
+  }
+
+  QuickSortIntro (&Context, BufferToSort, Count, 2 * (UINTN)HighBitSet64 (Count));
+}
+
+/**
+  Read the key of an element.
+
+  @param[in] Element    The element.
+  @param[in] KeyOffset  The offset of the key in the element.
+
+  @return The key.
+**/
+STATIC
+UINT64
+SortReadKey (
+  IN CONST UINT8  *Element,
+  IN       UINTN  KeyOffset
+  )
+{
+  return ReadUnaligned64 ((CONST UINT64 *)(Element + KeyOffset));
+}
+
+/**
+  Sort an array of elements by an unsigned 64-bit key stored in each element.
+
+  The sort is stable: elements with equal keys keep their relative order. It
+  is a least significant digit radix sort on bytes of the key that does not
+  call a comparison function. Key bytes that are the same in all elements are
+  skipped, and already sorted input is detected with a single pass, so sorting
+  memory maps or address lists that are (nearly) in order is cheap.
+
+  if BufferToSort is NULL, then ASSERT.
+  if ScratchBuffer is NULL, then ASSERT.
+  if KeyOffset + sizeof (UINT64) is larger than ElementSize, then ASSERT.
+  if Count is larger than MAX_UINT32, then ASSERT.
+
+  if Count is < 2 then perform no action.
+
+  @param[in, out] BufferToSort   On call a buffer of (possibly sorted) elements,
+                                 on return a buffer of sorted elements.
+  @param[in]      Count          The number of elements in the buffer to sort.
+  @param[in]      ElementSize    Size of an element in bytes.
+  @param[in]      KeyOffset      Offset of the key in an element in bytes. The
+                                 key does not need to be aligned.
+  @param[out]     ScratchBuffer  Caller provided buffer of Count * ElementSize
+                                 bytes. Its content is undefined on return.
+**/
+VOID
+EFIAPI
+SortByUint64Key (
+  IN OUT VOID   *BufferToSort,
+  IN     UINTN  Count,
+  IN     UINTN  ElementSize,
+  IN     UINTN  KeyOffset,
+  OUT    VOID   *ScratchBuffer
+  )
+{
+  UINT32   Offsets[256];
+  UINT8    *Source;
+  UINT8    *Destination;
+  UINT8    *Swap;
+  UINT64   Key;
+  UINT64   PreviousKey;
+  UINT64   AllOr;
+  UINT64   AllAnd;
+  UINT64   Varying;
+  UINTN    Shift;
+  UINTN    Index;
+  UINT32   Sum;
+  UINT32   Bucket;
+  BOOLEAN  Sorted;
+
+  ASSERT (BufferToSort  != NULL);
+  ASSERT (ScratchBuffer != NULL);
+  ASSERT (ElementSize   >= sizeof (UINT64));
+  ASSERT (KeyOffset     <= ElementSize - sizeof (UINT64));
+  ASSERT (Count         <= MAX_UINT32);
+
+  if (Count < 2) {
+    return;
+  }
 
   //
-  // Now get the pivot such that all on "left" are below it
-  // and everything "right" are above it
+  // One pass finds out whether the input is already sorted and which key bytes
+  // differ between elements at all.
   //
-  for (LoopCount = 0; LoopCount < Count -1; LoopCount++) {
-    //
-    // if the element is less than or equal to the pivot
-    //
-    if (CompareFunction ((VOID *)((UINT8 *)BufferToSort + ((LoopCount) * ElementSize)), Pivot) <= 0) {
-      //
-      // swap
-      //
-      CopyMem (BufferOneElement, (UINT8 *)BufferToSort + (NextSwapLocation * ElementSize), ElementSize);
-      CopyMem ((UINT8 *)BufferToSort + (NextSwapLocation * ElementSize), (UINT8 *)BufferToSort + ((LoopCount) * ElementSize), ElementSize);
-      CopyMem ((UINT8 *)BufferToSort + ((LoopCount)*ElementSize), BufferOneElement, ElementSize);
-
-      //
-      // increment NextSwapLocation
-      //
-      NextSwapLocation++;
+  Source      = BufferToSort;
+  PreviousKey = SortReadKey (Source, KeyOffset);
+  AllOr       = PreviousKey;
+  AllAnd      = PreviousKey;
+  Sorted      = TRUE;
+  for (Index = 1; Index < Count; Index++) {
+    Key = SortReadKey (Source + Index * ElementSize, KeyOffset);
+    if (Key < PreviousKey) {
+      Sorted = FALSE;
     }
+
+    AllOr      |= Key;
+    AllAnd     &= Key;
+    PreviousKey = Key;
   }
 
-  //
-  // swap pivot to it's final position (NextSwapLocation)
-  //
-  CopyMem (BufferOneElement, Pivot, ElementSize);
-  CopyMem (Pivot, (UINT8 *)BufferToSort + (NextSwapLocation * ElementSize), ElementSize);
-  CopyMem ((UINT8 *)BufferToSort + (NextSwapLocation * ElementSize), BufferOneElement, ElementSize);
+  if (Sorted) {
+    return;
+  }
 
-  //
-  // Now recurse on 2 partial lists.  neither of these will have the 'pivot' element
-  // IE list is sorted left half, pivot element, sorted right half...
-  //
-  if (NextSwapLocation >= 2) {
-    QuickSort (
-      BufferToSort,
-      NextSwapLocation,
-      ElementSize,
-      CompareFunction,
-      BufferOneElement
-      );
-  }
-
-  if ((Count - NextSwapLocation - 1) >= 2) {
-    QuickSort (
-      (UINT8 *)BufferToSort + (NextSwapLocation + 1) * ElementSize,
-      Count - NextSwapLocation - 1,
-      ElementSize,
-      CompareFunction,
-      BufferOneElement
-      );
+  Varying     = AllOr ^ AllAnd;
+  Destination = ScratchBuffer;
+  for (Shift = 0; Shift < 64; Shift += 8) {
+    if (((RShiftU64 (Varying, Shift)) & 0xFF) == 0) {
+      continue;
+    }
+
+    ZeroMem (Offsets, sizeof (Offsets));
+    for (Index = 0; Index < Count; Index++) {
+      Bucket = (UINT32)RShiftU64 (SortReadKey (Source + Index * ElementSize, KeyOffset), Shift) & 0xFF;
+      Offsets[Bucket]++;
+    }
+
+    Sum = 0;
+    for (Bucket = 0; Bucket < ARRAY_SIZE (Offsets); Bucket++) {
+      Sum            += Offsets[Bucket];
+      Offsets[Bucket] = Sum - Offsets[Bucket];
+    }
+
+    for (Index = 0; Index < Count; Index++) {
+      Bucket = (UINT32)RShiftU64 (SortReadKey (Source + Index * ElementSize, KeyOffset), Shift) & 0xFF;
+      CopyMem (Destination + Offsets[Bucket] * ElementSize, Source + Index * ElementSize, ElementSize);
+      Offsets[Bucket]++;
+    }
+
+    Swap        = Source;
+    Source      = Destination;
+    Destination = Swap;
+  }
+
+  if (Source != BufferToSort) {
+    CopyMem (BufferToSort, Source, Count * ElementSize);
   }
 }
@@ -1495,6 +1495,28 @@ UnitTestHostBaseLibPatchInstructionX86 (
 {
 }
 
+/**
+  Executes a XGETBV instruction
+
+  Executes a XGETBV instruction. This function is only available on IA-32 and
+  x64.
+
+  @param[in] Index        Extended control register index
+
+  @return                 The current value of the extended control register
+**/
+UINT64
+EFIAPI
+UnitTestHostBaseLibAsmXGetBv (
+  IN UINT32  Index
+  )
+{
+  //
+  // Only the x87 state is enabled.
+  //
+  return (Index == 0) ? BIT0 : 0;
+}
+
 /**
   Retrieves CPUID information.
 
@@ -2901,6 +2923,25 @@ PatchInstructionX86 (
   gUnitTestHostBaseLib.X86->PatchInstructionX86 (InstructionEnd, PatchValue, ValueSize);
 }
 
+/**
+  Executes a XGETBV instruction
+
+  Executes a XGETBV instruction. This function is only available on IA-32 and
+  x64.
+
+  @param[in] Index        Extended control register index
+
+  @return                 The current value of the extended control register
+**/
+UINT64
+EFIAPI
+AsmXGetBv (
+  IN UINT32  Index
+  )
+{
+  return gUnitTestHostBaseLib.X86->AsmXGetBv (Index);
+}
+
 ///
 /// Common services
 ///
@@ -2974,7 +3015,8 @@ STATIC UNIT_TEST_HOST_BASE_LIB_X86  mUnitTestHostBaseLibX86 = {
   UnitTestHostBaseLibAsmPrepareAndThunk16,
   UnitTestHostBaseLibAsmWriteTr,
   UnitTestHostBaseLibAsmLfence,
-  UnitTestHostBaseLibPatchInstructionX86
+  UnitTestHostBaseLibPatchInstructionX86,
+  UnitTestHostBaseLibAsmXGetBv
 };
 
 ///
@@ -0,0 +1,524 @@
+/** @file
+  Runtime selection of the CopyMem(), SetMem(), ZeroMem() and CompareMem()
+  kernels.
+
+  The library constructor probes the CPU once and fills in mMemLibKernels.
+  Until it ran, for example when another library constructor uses this
+  library first, only kernels that need no more than SSE2 are used.
+
+  Buffers shorter than MEM_LIB_VECTOR_THRESHOLD are handled with XMM registers,
+  so that short calls do not pay for the dispatch. Longer buffers use AVX-512
+  or AVX2 kernels, REP MOVSB/STOSB from MEM_LIB_REP_THRESHOLD on when the CPU
+  supports ERMS, and non-temporal stores from about half of the largest cache
+  on, where the data would only evict the working set.
+
+  Interrupt and exception handlers in firmware only save the FXSAVE state, so
+  a handler that runs one of the AVX kernels would destroy the upper halves of
+  YMM and ZMM registers of the code it interrupted. The AVX kernels therefore
+  run with interrupts disabled, and this library instance must not be used by
+  modules that can run while an OS owns the extended register state. Long
+  buffers are processed in chunks of MEM_LIB_WIDE_CHUNK_SIZE, and pending
+  interrupts are taken between the chunks.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "MemLibInternals.h"
+
+#include <Register/Intel/Cpuid.h>
+
+///
+/// CPUID.(EAX=07H, ECX=0):EDX[4] reports fast short REP MOVSB.
+///
+#define MEM_LIB_CPUID_FSRM  BIT4
+
+///
+/// XCR0 bits of the SSE, AVX and AVX-512 (opmask, ZMM_Hi256, Hi16_ZMM) state.
+///
+#define MEM_LIB_XCR0_AVX     (BIT1 | BIT2)
+#define MEM_LIB_XCR0_AVX512  (BIT1 | BIT2 | BIT5 | BIT6 | BIT7)
+
+typedef struct {
+  MEM_LIB_COPY_KERNEL    Kernel;
+  ///
+  /// TRUE if Kernel uses YMM or ZMM registers.
+  ///
+  BOOLEAN                Wide;
+} MEM_LIB_COPY_PATH;
+
+typedef struct {
+  MEM_LIB_SET_KERNEL    Kernel;
+  BOOLEAN               Wide;
+} MEM_LIB_SET_PATH;
+
+typedef struct {
+  MEM_LIB_COMPARE_KERNEL    Kernel;
+  BOOLEAN                   Wide;
+} MEM_LIB_COMPARE_PATH;
+
+typedef struct {
+  ///
+  /// Buffers from MEM_LIB_VECTOR_THRESHOLD to RepThreshold.
+  ///
+  MEM_LIB_COPY_PATH       CopyVector;
+  MEM_LIB_SET_PATH        SetVector;
+  MEM_LIB_COMPARE_PATH    CompareVector;
+  ///
+  /// Buffers from RepThreshold to NonTemporalThreshold.
+  ///
+  MEM_LIB_COPY_PATH       CopyRep;
+  MEM_LIB_SET_PATH        SetRep;
+  ///
+  /// Buffers from NonTemporalThreshold on.
+  ///
+  MEM_LIB_COPY_PATH       CopyNonTemporal;
+  MEM_LIB_SET_PATH        SetNonTemporal;
+  UINTN                   RepThreshold;
+  UINTN                   NonTemporalThreshold;
+} MEM_LIB_KERNELS;
+
+STATIC MEM_LIB_KERNELS  mMemLibKernels = {
+  { InternalMemCopyMemSse,        FALSE },
+  { InternalMemSetMemSse,         FALSE },
+  { InternalMemCompareMemSse,     FALSE },
+  { InternalMemCopyMemSse,        FALSE },
+  { InternalMemSetMemRepStos,     FALSE },
+  { InternalMemCopyMemSse2,       FALSE },
+  { InternalMemSetMemRepStos,     FALSE },
+  MEM_LIB_REP_THRESHOLD,
+  MEM_LIB_DEFAULT_NON_TEMPORAL_THRESHOLD
+};
+
+/**
+  Return the CPU features that are usable by the memory kernels.
+
+  AVX2 and AVX-512 are only reported when the OS, or the firmware, has enabled
+  the matching register state in XCR0.
+
+  @return A combination of MEM_LIB_FEATURE_* bits.
+**/
+UINT32
+InternalMemLibGetCpuFeatures (
+  VOID
+  )
+{
+  UINT32                                       MaxLeaf;
+  CPUID_VERSION_INFO_ECX                       VersionEcx;
+  CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS_EBX  ExtendedEbx;
+  CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS_EDX  ExtendedEdx;
+  UINT64                                       Xcr0;
+  UINT32                                       Features;
+
+  AsmCpuid (CPUID_SIGNATURE, &MaxLeaf, NULL, NULL, NULL);
+  if (MaxLeaf < CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS) {
+    return 0;
+  }
+
+  AsmCpuid (CPUID_VERSION_INFO, NULL, NULL, &VersionEcx.Uint32, NULL);
+  AsmCpuidEx (
+    CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS,
+    CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS_SUB_LEAF_INFO,
+    NULL,
+    &ExtendedEbx.Uint32,
+    NULL,
+    &ExtendedEdx.Uint32
+    );
+
+  Features = 0;
+  if (ExtendedEbx.Bits.EnhancedRepMovsbStosb != 0) {
+    Features |= MEM_LIB_FEATURE_ERMS;
+  }
+
+  if ((ExtendedEdx.Uint32 & MEM_LIB_CPUID_FSRM) != 0) {
+    Features |= MEM_LIB_FEATURE_FSRM;
+  }
+
+  //
+  // XGETBV may only be executed when CR4.OSXSAVE is set.
+  //
+  if ((VersionEcx.Bits.OSXSAVE == 0) || (VersionEcx.Bits.AVX == 0)) {
+    return Features;
+  }
+
+  Xcr0 = AsmXGetBv (0);
+  if (((Xcr0 & MEM_LIB_XCR0_AVX) == MEM_LIB_XCR0_AVX) && (ExtendedEbx.Bits.AVX2 != 0)) {
+    Features |= MEM_LIB_FEATURE_AVX2;
+
+    if (((Xcr0 & MEM_LIB_XCR0_AVX512) == MEM_LIB_XCR0_AVX512) && (ExtendedEbx.Bits.AVX512F != 0)) {
+      Features |= MEM_LIB_FEATURE_AVX512;
+    }
+  }
+
+  return Features;
+}
+
+/**
+  Return the size from which buffers are written with non-temporal stores.
+
+  @return Half of the size of the largest cache, or
+          MEM_LIB_DEFAULT_NON_TEMPORAL_THRESHOLD if it cannot be determined.
+**/
+UINTN
+InternalMemLibGetNonTemporalThreshold (
+  VOID
+  )
+{
+  UINT32                  MaxLeaf;
+  UINT32                  Index;
+  CPUID_CACHE_PARAMS_EAX  CacheEax;
+  CPUID_CACHE_PARAMS_EBX  CacheEbx;
+  UINT32                  CacheEcx;
+  UINTN                   CacheSize;
+  UINTN                   LargestCacheSize;
+
+  AsmCpuid (CPUID_SIGNATURE, &MaxLeaf, NULL, NULL, NULL);
+  if (MaxLeaf < CPUID_CACHE_PARAMS) {
+    return MEM_LIB_DEFAULT_NON_TEMPORAL_THRESHOLD;
+  }
+
+  LargestCacheSize = 0;
+  for (Index = 0; Index < 8; Index++) {
+    AsmCpuidEx (CPUID_CACHE_PARAMS, Index, &CacheEax.Uint32, &CacheEbx.Uint32, &CacheEcx, NULL);
+    if (CacheEax.Bits.CacheType == CPUID_CACHE_PARAMS_CACHE_TYPE_NULL) {
+      break;
+    }
+
+    CacheSize = (UINTN)(CacheEbx.Bits.Ways + 1) * (CacheEbx.Bits.LinePartitions + 1) *
+                (CacheEbx.Bits.LineSize + 1) * ((UINTN)CacheEcx + 1);
+    LargestCacheSize = MAX (LargestCacheSize, CacheSize);
+  }
+
+  if (LargestCacheSize == 0) {
+    return MEM_LIB_DEFAULT_NON_TEMPORAL_THRESHOLD;
+  }
+
+  return MAX (LargestCacheSize / 2, MEM_LIB_REP_THRESHOLD);
+}
+
+/**
+  Select the memory kernels.
+
+  Until this function is called, only kernels that need no more than SSE2 are
+  used.
+
+  @param  Features              A combination of MEM_LIB_FEATURE_* bits. All of
+                                them must be supported by the CPU.
+  @param  NonTemporalThreshold  The size from which buffers are written with
+                                non-temporal stores.
+
+**/
+VOID
+InternalMemLibSelectKernels (
+  IN      UINT32  Features,
+  IN      UINTN   NonTemporalThreshold
+  )
+{
+  MEM_LIB_KERNELS  *Kernels;
+  BOOLEAN          Wide;
+  BOOLEAN          Rep;
+
+#if !MEM_LIB_AVX_KERNELS
+  Features &= ~(UINT32)(MEM_LIB_FEATURE_AVX2 | MEM_LIB_FEATURE_AVX512);
+#endif
+
+  Kernels = &mMemLibKernels;
+  Wide    = (BOOLEAN)((Features & (MEM_LIB_FEATURE_AVX2 | MEM_LIB_FEATURE_AVX512)) != 0);
+  Rep     = (BOOLEAN)((Features & (MEM_LIB_FEATURE_ERMS | MEM_LIB_FEATURE_FSRM)) != 0);
+
+  //
+  // Wide is always updated before Kernel, so that a wide kernel is never
+  // called with interrupts enabled.
+  //
+  Kernels->CopyVector.Wide      = Wide;
+  Kernels->SetVector.Wide       = Wide;
+  Kernels->CopyNonTemporal.Wide = Wide;
+  Kernels->SetNonTemporal.Wide  = Wide;
+  Kernels->CopyRep.Wide         = (BOOLEAN)(Wide && !Rep);
+  Kernels->SetRep.Wide          = (BOOLEAN)(Wide && !Rep);
+  Kernels->CompareVector.Wide   = (BOOLEAN)((Features & MEM_LIB_FEATURE_AVX2) != 0);
+
+#if MEM_LIB_AVX_KERNELS
+  if ((Features & MEM_LIB_FEATURE_AVX512) != 0) {
+    Kernels->CopyVector.Kernel      = InternalMemCopyMemAvx512;
+    Kernels->SetVector.Kernel       = InternalMemSetMemAvx512;
+    Kernels->CopyNonTemporal.Kernel = InternalMemCopyMemAvx512NonTemporal;
+    Kernels->SetNonTemporal.Kernel  = InternalMemSetMemAvx512NonTemporal;
+  } else if ((Features & MEM_LIB_FEATURE_AVX2) != 0) {
+    Kernels->CopyVector.Kernel      = InternalMemCopyMemAvx2;
+    Kernels->SetVector.Kernel       = InternalMemSetMemAvx2;
+    Kernels->CopyNonTemporal.Kernel = InternalMemCopyMemAvx2NonTemporal;
+    Kernels->SetNonTemporal.Kernel  = InternalMemSetMemAvx2NonTemporal;
+  } else
+#endif
+  {
+    Kernels->CopyVector.Kernel      = InternalMemCopyMemSse;
+    Kernels->SetVector.Kernel       = InternalMemSetMemSse;
+    Kernels->CopyNonTemporal.Kernel = InternalMemCopyMemSse2;
+    Kernels->SetNonTemporal.Kernel  = Rep ? InternalMemSetMemErms : InternalMemSetMemRepStos;
+  }
+
+  if (Rep) {
+    Kernels->CopyRep.Kernel = InternalMemCopyMemErms;
+    Kernels->SetRep.Kernel  = InternalMemSetMemErms;
+  } else if (Wide) {
+    Kernels->CopyRep.Kernel = Kernels->CopyVector.Kernel;
+    Kernels->SetRep.Kernel  = Kernels->SetVector.Kernel;
+  } else {
+    Kernels->CopyRep.Kernel = InternalMemCopyMemSse;
+    Kernels->SetRep.Kernel  = InternalMemSetMemRepStos;
+  }
+
+  //
+  // AVX-512 CPUs all support AVX2, and a wider compare would not help much as
+  // comparing is bound by the loads.
+  //
+#if MEM_LIB_AVX_KERNELS
+  if ((Features & MEM_LIB_FEATURE_AVX2) != 0) {
+    Kernels->CompareVector.Kernel = InternalMemCompareMemAvx2;
+  } else
+#endif
+  {
+    Kernels->CompareVector.Kernel = InternalMemCompareMemSse;
+  }
+
+  //
+  // With fast short REP MOVSB, REP MOVSB/STOSB beats the vector kernels for
+  // everything that is too long for the XMM path.
+  //
+  if ((Features & MEM_LIB_FEATURE_FSRM) != 0) {
+    Kernels->RepThreshold = MEM_LIB_VECTOR_THRESHOLD;
+  } else {
+    Kernels->RepThreshold = MEM_LIB_REP_THRESHOLD;
+  }
+
+  Kernels->NonTemporalThreshold = MAX (NonTemporalThreshold, Kernels->RepThreshold);
+}
+
+/**
+  Return the number of bytes that a wide kernel processes next.
+
+  The last chunk takes up what would otherwise be left over, so that every
+  chunk is at least MEM_LIB_VECTOR_THRESHOLD long.
+
+  @param  Length  The number of bytes left, at least MEM_LIB_VECTOR_THRESHOLD.
+
+  @return The length of the next chunk.
+**/
+STATIC
+UINTN
+InternalMemLibGetWideChunk (
+  IN      UINTN  Length
+  )
+{
+  if (Length < MEM_LIB_WIDE_CHUNK_SIZE + MEM_LIB_VECTOR_THRESHOLD) {
+    return Length;
+  }
+
+  return MEM_LIB_WIDE_CHUNK_SIZE;
+}
+
+/**
+  Probe the CPU and select the memory kernels.
+
+  @retval RETURN_SUCCESS  The kernels were selected.
+**/
+RETURN_STATUS
+EFIAPI
+BaseMemoryLibAvxConstructor (
+  VOID
+  )
+{
+  InternalMemLibSelectKernels (
+    InternalMemLibGetCpuFeatures (),
+    InternalMemLibGetNonTemporalThreshold ()
+    );
+  return RETURN_SUCCESS;
+}
+
+/**
+  Copy Length bytes from Source to Destination.
+
+  @param  DestinationBuffer The target of the copy request.
+  @param  SourceBuffer      The place to copy from.
+  @param  Length            The number of bytes to copy.
+
+  @return Destination.
+
+**/
+VOID *
+EFIAPI
+InternalMemCopyMem (
+  OUT     VOID        *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  )
+{
+  CONST MEM_LIB_COPY_PATH  *Path;
+  BOOLEAN                  InterruptState;
+  UINT8                    *Destination;
+  CONST UINT8              *Source;
+  UINTN                    Chunk;
+
+  //
+  // All kernels but InternalMemCopyMemSse2() copy forward, which would
+  // overwrite the end of Source before it is read.
+  //
+  if (((UINTN)DestinationBuffer - (UINTN)SourceBuffer) < Length) {
+    return InternalMemCopyMemSse2 (DestinationBuffer, SourceBuffer, Length);
+  }
+
+  if (Length < MEM_LIB_VECTOR_THRESHOLD) {
+    return InternalMemCopyMemSse (DestinationBuffer, SourceBuffer, Length);
+  }
+
+  if (Length < mMemLibKernels.RepThreshold) {
+    Path = &mMemLibKernels.CopyVector;
+  } else if ((Length < mMemLibKernels.NonTemporalThreshold) ||
+             (((UINTN)SourceBuffer - (UINTN)DestinationBuffer) < Length))
+  {
+    Path = &mMemLibKernels.CopyRep;
+  } else {
+    Path = &mMemLibKernels.CopyNonTemporal;
+  }
+
+  if (!Path->Wide) {
+    return Path->Kernel (DestinationBuffer, SourceBuffer, Length);
+  }
+
+  //
+  // Copying forward chunk by chunk never reads bytes that an earlier chunk
+  // wrote, as Destination does not overlap the end of Source.
+  //
+  Destination = DestinationBuffer;
+  Source      = SourceBuffer;
+  do {
+    Chunk          = InternalMemLibGetWideChunk (Length);
+    InterruptState = SaveAndDisableInterrupts ();
+    Path->Kernel (Destination, Source, Chunk);
+    SetInterruptState (InterruptState);
+    Destination += Chunk;
+    Source      += Chunk;
+    Length      -= Chunk;
+  } while (Length != 0);
+
+  return DestinationBuffer;
+}
+
+/**
+  Set Buffer to Value for Size bytes.
+
+  @param  Buffer   The memory to set.
+  @param  Length   The number of bytes to set.
+  @param  Value    The value of the set operation.
+
+  @return Buffer.
+
+**/
+VOID *
+EFIAPI
+InternalMemSetMem (
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length,
+  IN      UINT8  Value
+  )
+{
+  CONST MEM_LIB_SET_PATH  *Path;
+  BOOLEAN                 InterruptState;
+  UINT8                   *Destination;
+  UINTN                   Chunk;
+
+  if (Length < MEM_LIB_VECTOR_THRESHOLD) {
+    return InternalMemSetMemSse (Buffer, Length, Value);
+  }
+
+  if (Length < mMemLibKernels.RepThreshold) {
+    Path = &mMemLibKernels.SetVector;
+  } else if (Length < mMemLibKernels.NonTemporalThreshold) {
+    Path = &mMemLibKernels.SetRep;
+  } else {
+    Path = &mMemLibKernels.SetNonTemporal;
+  }
+
+  if (!Path->Wide) {
+    return Path->Kernel (Buffer, Length, Value);
+  }
+
+  Destination = Buffer;
+  do {
+    Chunk          = InternalMemLibGetWideChunk (Length);
+    InterruptState = SaveAndDisableInterrupts ();
+    Path->Kernel (Destination, Chunk, Value);
+    SetInterruptState (InterruptState);
+    Destination += Chunk;
+    Length      -= Chunk;
+  } while (Length != 0);
+
+  return Buffer;
+}
+
+/**
+  Set Buffer to 0 for Size bytes.
+
+  @param  Buffer The memory to set.
+  @param  Length The number of bytes to set.
+
+  @return Buffer.
+
+**/
+VOID *
+EFIAPI
+InternalMemZeroMem (
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length
+  )
+{
+  return InternalMemSetMem (Buffer, Length, 0);
+}
+
+/**
+  Compares two memory buffers of a given length.
+
+  @param  DestinationBuffer The first memory buffer.
+  @param  SourceBuffer      The second memory buffer.
+  @param  Length            The length of DestinationBuffer and SourceBuffer memory
+                            regions to compare. Must be non-zero.
+
+  @return 0                 All Length bytes of the two buffers are identical.
+  @retval Non-zero          The first mismatched byte in SourceBuffer subtracted from the first
+                            mismatched byte in DestinationBuffer.
+
+**/
+INTN
+EFIAPI
+InternalMemCompareMem (
+  IN      CONST VOID  *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  )
+{
+  BOOLEAN      InterruptState;
+  CONST UINT8  *Buffer1;
+  CONST UINT8  *Buffer2;
+  UINTN        Chunk;
+  INTN         Result;
+
+  if ((Length < MEM_LIB_VECTOR_THRESHOLD) || !mMemLibKernels.CompareVector.Wide) {
+    return InternalMemCompareMemSse (DestinationBuffer, SourceBuffer, Length);
+  }
+
+  Buffer1 = DestinationBuffer;
+  Buffer2 = SourceBuffer;
+  do {
+    Chunk          = InternalMemLibGetWideChunk (Length);
+    InterruptState = SaveAndDisableInterrupts ();
+    Result         = mMemLibKernels.CompareVector.Kernel (Buffer1, Buffer2, Chunk);
+    SetInterruptState (InterruptState);
+    Buffer1 += Chunk;
+    Buffer2 += Chunk;
+    Length  -= Chunk;
+  } while ((Result == 0) && (Length != 0));
+
+  return Result;
+}
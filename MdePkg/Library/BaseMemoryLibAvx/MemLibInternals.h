@@ -0,0 +1,496 @@
+/** @file
+  Declaration of internal functions for Base Memory Library.
+
+  Copyright (c) 2006 - 2016, Intel Corporation. All rights reserved.<BR>
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef __MEM_LIB_INTERNALS__
+#define __MEM_LIB_INTERNALS__
+
+#include <Base.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/BaseLib.h>
+#include <Library/DebugLib.h>
+
+/**
+  Copy Length bytes from Source to Destination.
+
+  @param  DestinationBuffer The target of the copy request.
+  @param  SourceBuffer      The place to copy from.
+  @param  Length            The number of bytes to copy.
+
+  @return Destination.
+
+**/
+VOID *
+EFIAPI
+InternalMemCopyMem (
+  OUT     VOID        *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  );
+
+/**
+  Set Buffer to Value for Size bytes.
+
+  @param  Buffer   The memory to set.
+  @param  Length   The number of bytes to set.
+  @param  Value    The value of the set operation.
+
+  @return Buffer
+
+**/
+VOID *
+EFIAPI
+InternalMemSetMem (
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length,
+  IN      UINT8  Value
+  );
+
+/**
+  Fills a target buffer with a 16-bit value, and returns the target buffer.
+
+  @param  Buffer  The pointer to the target buffer to fill.
+  @param  Length  The count of 16-bit value to fill.
+  @param  Value   The value with which to fill Length bytes of Buffer.
+
+  @return Buffer.
+
+**/
+VOID *
+EFIAPI
+InternalMemSetMem16 (
+  OUT     VOID    *Buffer,
+  IN      UINTN   Length,
+  IN      UINT16  Value
+  );
+
+/**
+  Fills a target buffer with a 32-bit value, and returns the target buffer.
+
+  @param  Buffer  The pointer to the target buffer to fill.
+  @param  Length  The count of 32-bit value to fill.
+  @param  Value   The value with which to fill Length bytes of Buffer.
+
+  @return Buffer.
+
+**/
+VOID *
+EFIAPI
+InternalMemSetMem32 (
+  OUT     VOID    *Buffer,
+  IN      UINTN   Length,
+  IN      UINT32  Value
+  );
+
+/**
+  Fills a target buffer with a 64-bit value, and returns the target buffer.
+
+  @param  Buffer  The pointer to the target buffer to fill.
+  @param  Length  The count of 64-bit value to fill.
+  @param  Value   The value with which to fill Length bytes of Buffer.
+
+  @return Buffer.
+
+**/
+VOID *
+EFIAPI
+InternalMemSetMem64 (
+  OUT     VOID    *Buffer,
+  IN      UINTN   Length,
+  IN      UINT64  Value
+  );
+
+/**
+  Set Buffer to 0 for Size bytes.
+
+  @param  Buffer The memory to set.
+  @param  Length The number of bytes to set
+
+  @return Buffer.
+
+**/
+VOID *
+EFIAPI
+InternalMemZeroMem (
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length
+  );
+
+/**
+  Compares two memory buffers of a given length.
+
+  @param  DestinationBuffer The first memory buffer.
+  @param  SourceBuffer      The second memory buffer.
+  @param  Length            The length of DestinationBuffer and SourceBuffer memory
+                            regions to compare. Must be non-zero.
+
+  @return 0                 All Length bytes of the two buffers are identical.
+  @retval Non-zero          The first mismatched byte in SourceBuffer subtracted from the first
+                            mismatched byte in DestinationBuffer.
+
+**/
+INTN
+EFIAPI
+InternalMemCompareMem (
+  IN      CONST VOID  *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  );
+
+/**
+  Scans a target buffer for an 8-bit value, and returns a pointer to the
+  matching 8-bit value in the target buffer.
+
+  @param  Buffer  The pointer to the target buffer to scan.
+  @param  Length  The count of 8-bit value to scan. Must be non-zero.
+  @param  Value   The value to search for in the target buffer.
+
+  @return The pointer to the first occurrence or NULL if not found.
+
+**/
+CONST VOID *
+EFIAPI
+InternalMemScanMem8 (
+  IN      CONST VOID  *Buffer,
+  IN      UINTN       Length,
+  IN      UINT8       Value
+  );
+
+/**
+  Scans a target buffer for a 16-bit value, and returns a pointer to the
+  matching 16-bit value in the target buffer.
+
+  @param  Buffer  The pointer to the target buffer to scan.
+  @param  Length  The count of 16-bit value to scan. Must be non-zero.
+  @param  Value   The value to search for in the target buffer.
+
+  @return The pointer to the first occurrence or NULL if not found.
+
+**/
+CONST VOID *
+EFIAPI
+InternalMemScanMem16 (
+  IN      CONST VOID  *Buffer,
+  IN      UINTN       Length,
+  IN      UINT16      Value
+  );
+
+/**
+  Scans a target buffer for a 32-bit value, and returns a pointer to the
+  matching 32-bit value in the target buffer.
+
+  @param  Buffer  The pointer to the target buffer to scan.
+  @param  Length  The count of 32-bit value to scan. Must be non-zero.
+  @param  Value   The value to search for in the target buffer.
+
+  @return The pointer to the first occurrence or NULL if not found.
+
+**/
+CONST VOID *
+EFIAPI
+InternalMemScanMem32 (
+  IN      CONST VOID  *Buffer,
+  IN      UINTN       Length,
+  IN      UINT32      Value
+  );
+
+/**
+  Scans a target buffer for a 64-bit value, and returns a pointer to the
+  matching 64-bit value in the target buffer.
+
+  @param  Buffer  The pointer to the target buffer to scan.
+  @param  Length  The count of 64-bit value to scan. Must be non-zero.
+  @param  Value   The value to search for in the target buffer.
+
+  @return The pointer to the first occurrence or NULL if not found.
+
+**/
+CONST VOID *
+EFIAPI
+InternalMemScanMem64 (
+  IN      CONST VOID  *Buffer,
+  IN      UINTN       Length,
+  IN      UINT64      Value
+  );
+
+/**
+  Checks whether the contents of a buffer are all zeros.
+
+  @param  Buffer  The pointer to the buffer to be checked.
+  @param  Length  The size of the buffer (in bytes) to be checked.
+
+  @retval TRUE    Contents of the buffer are all zeros.
+  @retval FALSE   Contents of the buffer are not all zeros.
+
+**/
+BOOLEAN
+EFIAPI
+InternalMemIsZeroBuffer (
+  IN CONST VOID  *Buffer,
+  IN UINTN       Length
+  );
+
+///
+/// CPU features that select the kernels of InternalMemCopyMem(),
+/// InternalMemSetMem(), InternalMemZeroMem() and InternalMemCompareMem().
+///
+#define MEM_LIB_FEATURE_ERMS    BIT0
+#define MEM_LIB_FEATURE_FSRM    BIT1
+#define MEM_LIB_FEATURE_AVX2    BIT2
+#define MEM_LIB_FEATURE_AVX512  BIT3
+
+///
+/// Buffers shorter than this are handled with XMM registers only.
+///
+#define MEM_LIB_VECTOR_THRESHOLD  512
+
+///
+/// Buffers of at least this size are handled with REP MOVSB/STOSB when the
+/// CPU supports ERMS, unless they reach the non-temporal threshold.
+///
+#define MEM_LIB_REP_THRESHOLD  SIZE_4KB
+
+///
+/// Non-temporal threshold used when the cache size cannot be determined.
+///
+#define MEM_LIB_DEFAULT_NON_TEMPORAL_THRESHOLD  SIZE_1MB
+
+///
+/// The AVX kernels process at most about this many bytes per call, so that
+/// interrupts are never disabled for long.
+///
+#define MEM_LIB_WIDE_CHUNK_SIZE  SIZE_64KB
+
+///
+/// The AVX kernels are GCC inline assembly in X64/GccInline.c.
+///
+#if defined (__GNUC__)
+#define MEM_LIB_AVX_KERNELS  1
+#else
+#define MEM_LIB_AVX_KERNELS  0
+#endif
+
+typedef
+VOID *
+(EFIAPI *MEM_LIB_COPY_KERNEL)(
+  OUT     VOID        *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  );
+
+typedef
+VOID *
+(EFIAPI *MEM_LIB_SET_KERNEL)(
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length,
+  IN      UINT8  Value
+  );
+
+typedef
+INTN
+(EFIAPI *MEM_LIB_COMPARE_KERNEL)(
+  IN      CONST VOID  *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  );
+
+/**
+  Return the CPU features that are usable by the memory kernels.
+
+  AVX2 and AVX-512 are only reported when the OS, or the firmware, has enabled
+  the matching register state in XCR0.
+
+  @return A combination of MEM_LIB_FEATURE_* bits.
+**/
+UINT32
+InternalMemLibGetCpuFeatures (
+  VOID
+  );
+
+/**
+  Return the size from which buffers are written with non-temporal stores.
+
+  @return Half of the size of the largest cache, or
+          MEM_LIB_DEFAULT_NON_TEMPORAL_THRESHOLD if it cannot be determined.
+**/
+UINTN
+InternalMemLibGetNonTemporalThreshold (
+  VOID
+  );
+
+/**
+  Select the memory kernels.
+
+  Until this function is called, only kernels that need no more than SSE2 are
+  used.
+
+  @param  Features              A combination of MEM_LIB_FEATURE_* bits. All of
+                                them must be supported by the CPU.
+  @param  NonTemporalThreshold  The size from which buffers are written with
+                                non-temporal stores.
+
+**/
+VOID
+InternalMemLibSelectKernels (
+  IN      UINT32  Features,
+  IN      UINTN   NonTemporalThreshold
+  );
+
+//
+// X64/CopyMem.nasm and X64/SetMem.nasm. Used when no better kernel is
+// available. InternalMemCopyMemSse2() is the only kernel that copies backward.
+//
+
+VOID *
+EFIAPI
+InternalMemCopyMemSse2 (
+  OUT     VOID        *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  );
+
+VOID *
+EFIAPI
+InternalMemSetMemRepStos (
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length,
+  IN      UINT8  Value
+  );
+
+//
+// X64/GccInline.c and X64/MemLibKernelsMsc.c. All kernels copy forward, so
+// Destination must not overlap the end of Source. The AVX kernels need Length
+// of at least MEM_LIB_VECTOR_THRESHOLD and are only built when
+// MEM_LIB_AVX_KERNELS is set.
+//
+
+VOID *
+EFIAPI
+InternalMemCopyMemSse (
+  OUT     VOID        *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  );
+
+VOID *
+EFIAPI
+InternalMemCopyMemErms (
+  OUT     VOID        *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  );
+
+VOID *
+EFIAPI
+InternalMemCopyMemAvx2 (
+  OUT     VOID        *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  );
+
+VOID *
+EFIAPI
+InternalMemCopyMemAvx2NonTemporal (
+  OUT     VOID        *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  );
+
+VOID *
+EFIAPI
+InternalMemCopyMemAvx512 (
+  OUT     VOID        *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  );
+
+VOID *
+EFIAPI
+InternalMemCopyMemAvx512NonTemporal (
+  OUT     VOID        *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  );
+
+//
+// X64/GccInline.c and X64/MemLibKernelsMsc.c. The AVX kernels need Length of
+// at least MEM_LIB_VECTOR_THRESHOLD and are only built when
+// MEM_LIB_AVX_KERNELS is set.
+//
+
+VOID *
+EFIAPI
+InternalMemSetMemSse (
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length,
+  IN      UINT8  Value
+  );
+
+VOID *
+EFIAPI
+InternalMemSetMemErms (
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length,
+  IN      UINT8  Value
+  );
+
+VOID *
+EFIAPI
+InternalMemSetMemAvx2 (
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length,
+  IN      UINT8  Value
+  );
+
+VOID *
+EFIAPI
+InternalMemSetMemAvx2NonTemporal (
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length,
+  IN      UINT8  Value
+  );
+
+VOID *
+EFIAPI
+InternalMemSetMemAvx512 (
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length,
+  IN      UINT8  Value
+  );
+
+VOID *
+EFIAPI
+InternalMemSetMemAvx512NonTemporal (
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length,
+  IN      UINT8  Value
+  );
+
+//
+// X64/GccInline.c and X64/MemLibKernelsMsc.c. InternalMemCompareMemAvx2()
+// needs Length of at least 32 and is only built when MEM_LIB_AVX_KERNELS is
+// set.
+//
+
+INTN
+EFIAPI
+InternalMemCompareMemSse (
+  IN      CONST VOID  *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  );
+
+INTN
+EFIAPI
+InternalMemCompareMemAvx2 (
+  IN      CONST VOID  *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  );
+
+#endif
@@ -0,0 +1,869 @@
+/** @file
+  Unit tests and benchmark of BaseMemoryLibAvx.
+
+  CopyMem(), SetMem(), ZeroMem() and CompareMem() are checked against simple
+  byte loops for every combination of the CPU features of the host, so that
+  each kernel is run for all sizes, alignments and overlaps it can be given.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UnitTestLib.h>
+#include <Library/UnitTestHostBaseLib.h>
+#include <Register/Intel/Cpuid.h>
+
+#include "../MemLibInternals.h"
+
+#define UNIT_TEST_APP_NAME     "BaseMemoryLibAvx Unit Test Application"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+///
+/// Size of the test buffers. Buffers from MEM_TEST_NON_TEMPORAL_THRESHOLD on
+/// are written with non-temporal stores.
+///
+#define MEM_TEST_BUFFER_SIZE             (SIZE_256KB + SIZE_4KB)
+#define MEM_TEST_NON_TEMPORAL_THRESHOLD  SIZE_64KB
+#define MEM_TEST_ITERATIONS              400
+#define MEM_TEST_BENCHMARK_BUFFER_SIZE   SIZE_4MB
+#define MEM_TEST_BENCHMARK_TOTAL_SIZE    SIZE_64MB
+
+UINT32  mMemTestRandomState;
+
+///
+/// CPUID and XCR0 values reported by the mocked instructions.
+///
+UINT32  mMemTestMaxLeaf;
+UINT32  mMemTestVersionEcx;
+UINT32  mMemTestExtendedEbx;
+UINT32  mMemTestExtendedEdx;
+UINT64  mMemTestXcr0;
+UINTN   mMemTestXGetBvCount;
+
+/**
+  Return a pseudo random number.
+
+  @return A 24-bit pseudo random number.
+**/
+STATIC
+UINT32
+MemTestRandom (
+  VOID
+  )
+{
+  mMemTestRandomState = mMemTestRandomState * 1103515245 + 12345;
+  return mMemTestRandomState >> 8;
+}
+
+/**
+  Return a random buffer length. Each size class of the library is picked with
+  the same probability.
+
+  @return A length of at most SIZE_256KB.
+**/
+STATIC
+UINTN
+MemTestRandomLength (
+  VOID
+  )
+{
+  switch (MemTestRandom () % 6) {
+    case 0:
+      return MemTestRandom () % 64;
+    case 1:
+      return MemTestRandom () % MEM_LIB_VECTOR_THRESHOLD;
+    case 2:
+      return MEM_LIB_VECTOR_THRESHOLD + MemTestRandom () % MEM_LIB_REP_THRESHOLD;
+    case 3:
+      return MEM_LIB_REP_THRESHOLD + MemTestRandom () % MEM_TEST_NON_TEMPORAL_THRESHOLD;
+    case 4:
+      //
+      // Around the end of the first chunk of the AVX kernels.
+      //
+      return MEM_LIB_WIDE_CHUNK_SIZE + MemTestRandom () % (2 * MEM_LIB_VECTOR_THRESHOLD);
+    default:
+      return MEM_TEST_NON_TEMPORAL_THRESHOLD + MemTestRandom () % (SIZE_256KB - MEM_TEST_NON_TEMPORAL_THRESHOLD);
+  }
+}
+
+/**
+  Fill a buffer with pseudo random bytes.
+
+  @param[out] Buffer  The buffer to fill.
+  @param[in]  Length  The size of Buffer in bytes.
+**/
+STATIC
+VOID
+MemTestFillRandom (
+  OUT UINT8  *Buffer,
+  IN  UINTN  Length
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < Length; Index++) {
+    Buffer[Index] = (UINT8)MemTestRandom ();
+  }
+}
+
+/**
+  Compare two buffers byte by byte.
+
+  @param[in] Buffer1  The first buffer.
+  @param[in] Buffer2  The second buffer.
+  @param[in] Length   The size of both buffers in bytes.
+
+  @retval TRUE   The buffers are equal.
+  @retval FALSE  The buffers differ.
+**/
+STATIC
+BOOLEAN
+MemTestIsEqual (
+  IN CONST UINT8  *Buffer1,
+  IN CONST UINT8  *Buffer2,
+  IN UINTN        Length
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < Length; Index++) {
+    if (Buffer1[Index] != Buffer2[Index]) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Return the memory features of the host CPU.
+
+  REP MOVSB and REP STOSB run on every CPU, so ERMS and FSRM are always
+  reported. They only change which kernel is picked.
+
+  @return A combination of MEM_LIB_FEATURE_* bits.
+**/
+STATIC
+UINT32
+MemTestGetHostFeatures (
+  VOID
+  )
+{
+  UINT32  Features;
+
+  Features = MEM_LIB_FEATURE_ERMS | MEM_LIB_FEATURE_FSRM;
+ #if defined (__GNUC__)
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx2")) {
+    Features |= MEM_LIB_FEATURE_AVX2;
+    if (__builtin_cpu_supports ("avx512f")) {
+      Features |= MEM_LIB_FEATURE_AVX512;
+    }
+  }
+
+ #endif
+  return Features;
+}
+
+/**
+  Check whether a combination of features can be selected.
+
+  @param[in] Features  A combination of MEM_LIB_FEATURE_* bits.
+
+  @retval TRUE   Features is valid.
+  @retval FALSE  Features reports AVX-512 without AVX2.
+**/
+STATIC
+BOOLEAN
+MemTestIsValidFeatures (
+  IN UINT32  Features
+  )
+{
+  return (BOOLEAN)(((Features & MEM_LIB_FEATURE_AVX512) == 0) || ((Features & MEM_LIB_FEATURE_AVX2) != 0));
+}
+
+/**
+  Check CopyMem() with random lengths, alignments and overlaps.
+
+  @param[in] Buffer     A buffer of 2 * MEM_TEST_BUFFER_SIZE bytes.
+  @param[in] Expected   A buffer of 2 * MEM_TEST_BUFFER_SIZE bytes.
+
+  @retval TRUE   All copies were correct.
+  @retval FALSE  A copy was wrong.
+**/
+STATIC
+BOOLEAN
+MemTestCopy (
+  IN UINT8  *Buffer,
+  IN UINT8  *Expected
+  )
+{
+  UINTN  Iteration;
+  UINTN  Length;
+  UINTN  Source;
+  UINTN  Destination;
+  UINTN  Distance;
+  UINTN  Index;
+
+  MemTestFillRandom (Buffer, 2 * MEM_TEST_BUFFER_SIZE);
+  for (Index = 0; Index < 2 * MEM_TEST_BUFFER_SIZE; Index++) {
+    Expected[Index] = Buffer[Index];
+  }
+
+  for (Iteration = 0; Iteration < MEM_TEST_ITERATIONS; Iteration++) {
+    Length   = MemTestRandomLength ();
+    Source   = MemTestRandom () % (2 * MEM_TEST_BUFFER_SIZE - Length);
+    Distance = MemTestRandom () % (Length + 1);
+    switch (MemTestRandom () % 3) {
+      case 0:
+        //
+        // Separate buffers with random alignment.
+        //
+        Source      = MemTestRandom () % (MEM_TEST_BUFFER_SIZE - Length);
+        Destination = MEM_TEST_BUFFER_SIZE + MemTestRandom () % (MEM_TEST_BUFFER_SIZE - Length);
+        break;
+      case 1:
+        //
+        // Destination below Source.
+        //
+        Destination = Source - MIN (Source, Distance);
+        break;
+      default:
+        //
+        // Destination above Source.
+        //
+        Destination = MIN (Source + Distance, 2 * MEM_TEST_BUFFER_SIZE - Length);
+        break;
+    }
+
+    if (Destination < Source) {
+      for (Index = 0; Index < Length; Index++) {
+        Expected[Destination + Index] = Expected[Source + Index];
+      }
+    } else {
+      for (Index = Length; Index > 0; Index--) {
+        Expected[Destination + Index - 1] = Expected[Source + Index - 1];
+      }
+    }
+
+    if (CopyMem (Buffer + Destination, Buffer + Source, Length) != Buffer + Destination) {
+      return FALSE;
+    }
+
+    //
+    // Also check the bytes around Destination, which must not be touched.
+    //
+    Index = Destination - MIN (Destination, 64);
+    if (!MemTestIsEqual (
+           Buffer + Index,
+           Expected + Index,
+           MIN (Destination + Length + 64, 2 * MEM_TEST_BUFFER_SIZE) - Index
+           ))
+    {
+      UT_LOG_ERROR ("CopyMem (+0x%lx, +0x%lx, 0x%lx) failed\n", (UINT64)Destination, (UINT64)Source, (UINT64)Length);
+      return FALSE;
+    }
+  }
+
+  return MemTestIsEqual (Buffer, Expected, 2 * MEM_TEST_BUFFER_SIZE);
+}
+
+/**
+  Check SetMem() and ZeroMem() with random lengths and alignments.
+
+  @param[in] Buffer     A buffer of MEM_TEST_BUFFER_SIZE bytes.
+  @param[in] Expected   A buffer of MEM_TEST_BUFFER_SIZE bytes.
+
+  @retval TRUE   All buffers were set correctly.
+  @retval FALSE  A buffer was set wrong.
+**/
+STATIC
+BOOLEAN
+MemTestSet (
+  IN UINT8  *Buffer,
+  IN UINT8  *Expected
+  )
+{
+  UINTN  Iteration;
+  UINTN  Length;
+  UINTN  Offset;
+  UINTN  Index;
+  UINT8  Value;
+
+  MemTestFillRandom (Buffer, MEM_TEST_BUFFER_SIZE);
+  for (Index = 0; Index < MEM_TEST_BUFFER_SIZE; Index++) {
+    Expected[Index] = Buffer[Index];
+  }
+
+  for (Iteration = 0; Iteration < MEM_TEST_ITERATIONS; Iteration++) {
+    Length = MemTestRandomLength ();
+    Offset = MemTestRandom () % (MEM_TEST_BUFFER_SIZE - Length);
+    Value  = (UINT8)MemTestRandom ();
+    if ((Iteration % 2) == 0) {
+      Value = 0;
+      if (ZeroMem (Buffer + Offset, Length) != Buffer + Offset) {
+        return FALSE;
+      }
+    } else if (SetMem (Buffer + Offset, Length, Value) != Buffer + Offset) {
+      return FALSE;
+    }
+
+    for (Index = 0; Index < Length; Index++) {
+      Expected[Offset + Index] = Value;
+    }
+
+    Index = Offset - MIN (Offset, 64);
+    if (!MemTestIsEqual (
+           Buffer + Index,
+           Expected + Index,
+           MIN (Offset + Length + 64, MEM_TEST_BUFFER_SIZE) - Index
+           ))
+    {
+      UT_LOG_ERROR ("SetMem (+0x%lx, 0x%lx, 0x%x) failed\n", (UINT64)Offset, (UINT64)Length, Value);
+      return FALSE;
+    }
+  }
+
+  return MemTestIsEqual (Buffer, Expected, MEM_TEST_BUFFER_SIZE);
+}
+
+/**
+  Check CompareMem() with random lengths, alignments and mismatches.
+
+  @param[in] Buffer     A buffer of MEM_TEST_BUFFER_SIZE bytes.
+  @param[in] Expected   A buffer of MEM_TEST_BUFFER_SIZE bytes.
+
+  @retval TRUE   All results were correct.
+  @retval FALSE  A result was wrong.
+**/
+STATIC
+BOOLEAN
+MemTestCompare (
+  IN UINT8  *Buffer,
+  IN UINT8  *Expected
+  )
+{
+  UINTN  Iteration;
+  UINTN  Length;
+  UINTN  Offset1;
+  UINTN  Offset2;
+  UINTN  Mismatch;
+  UINTN  Index;
+  INTN   Result;
+
+  MemTestFillRandom (Buffer, MEM_TEST_BUFFER_SIZE);
+
+  for (Iteration = 0; Iteration < MEM_TEST_ITERATIONS; Iteration++) {
+    Length  = MemTestRandomLength () + 1;
+    Offset1 = MemTestRandom () % (MEM_TEST_BUFFER_SIZE - Length);
+    Offset2 = MemTestRandom () % (MEM_TEST_BUFFER_SIZE - Length);
+    for (Index = 0; Index < Length; Index++) {
+      Expected[Offset2 + Index] = Buffer[Offset1 + Index];
+    }
+
+    Result = CompareMem (Buffer + Offset1, Expected + Offset2, Length);
+    if (Result != 0) {
+      UT_LOG_ERROR ("CompareMem (equal, 0x%lx) returned %ld\n", (UINT64)Length, (INT64)Result);
+      return FALSE;
+    }
+
+    //
+    // Add a mismatch, and sometimes a second one after it that must not be
+    // reported.
+    //
+    Mismatch                      = MemTestRandom () % Length;
+    Expected[Offset2 + Mismatch] ^= (UINT8)(MemTestRandom () % 255 + 1);
+    if ((Mismatch + 1 < Length) && ((Iteration % 2) == 0)) {
+      Expected[Offset2 + Length - 1] ^= 0x80;
+    }
+
+    Result = CompareMem (Buffer + Offset1, Expected + Offset2, Length);
+    if (Result != (INTN)Buffer[Offset1 + Mismatch] - (INTN)Expected[Offset2 + Mismatch]) {
+      UT_LOG_ERROR ("CompareMem (0x%lx) mismatch at 0x%lx returned %ld\n", (UINT64)Length, (UINT64)Mismatch, (INT64)Result);
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Run CopyMem(), SetMem(), ZeroMem() and CompareMem() against byte loops for
+  every combination of host features.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+MemKernelTest (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINT32  HostFeatures;
+  UINT32  Features;
+  UINT8   *Buffer;
+  UINT8   *Expected;
+
+  Buffer   = AllocatePool (2 * MEM_TEST_BUFFER_SIZE);
+  Expected = AllocatePool (2 * MEM_TEST_BUFFER_SIZE);
+  UT_ASSERT_NOT_NULL (Buffer);
+  UT_ASSERT_NOT_NULL (Expected);
+
+  HostFeatures = MemTestGetHostFeatures ();
+  UT_LOG_INFO ("Host features 0x%x\n", HostFeatures);
+
+  //
+  // Features walks all subsets of HostFeatures.
+  //
+  Features = 0;
+  do {
+    if (MemTestIsValidFeatures (Features)) {
+      mMemTestRandomState = 0x5EED + Features;
+      InternalMemLibSelectKernels (Features, MEM_TEST_NON_TEMPORAL_THRESHOLD);
+      UT_LOG_INFO ("Features 0x%x\n", Features);
+      UT_ASSERT_TRUE (MemTestCopy (Buffer, Expected));
+      UT_ASSERT_TRUE (MemTestSet (Buffer, Expected));
+      UT_ASSERT_TRUE (MemTestCompare (Buffer, Expected));
+    }
+
+    Features = (Features - HostFeatures) & HostFeatures;
+  } while (Features != 0);
+
+  InternalMemLibSelectKernels (HostFeatures, MEM_LIB_DEFAULT_NON_TEMPORAL_THRESHOLD);
+  FreePool (Buffer);
+  FreePool (Expected);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Mocked CPUID with sub-leaf.
+
+  @param  Index     The 32-bit value to load into EAX prior to invoking the
+                    CPUID instruction.
+  @param  SubIndex  The 32-bit value to load into ECX prior to invoking the
+                    CPUID instruction.
+  @param  Eax       The pointer to the 32-bit EAX value returned by the CPUID
+                    instruction. This is an optional parameter that may be
+                    NULL.
+  @param  Ebx       The pointer to the 32-bit EBX value returned by the CPUID
+                    instruction. This is an optional parameter that may be
+                    NULL.
+  @param  Ecx       The pointer to the 32-bit ECX value returned by the CPUID
+                    instruction. This is an optional parameter that may be
+                    NULL.
+  @param  Edx       The pointer to the 32-bit EDX value returned by the CPUID
+                    instruction. This is an optional parameter that may be
+                    NULL.
+
+  @return Index.
+**/
+STATIC
+UINT32
+EFIAPI
+MemTestAsmCpuidEx (
+  IN      UINT32  Index,
+  IN      UINT32  SubIndex,
+  OUT     UINT32  *Eax   OPTIONAL,
+  OUT     UINT32  *Ebx   OPTIONAL,
+  OUT     UINT32  *Ecx   OPTIONAL,
+  OUT     UINT32  *Edx   OPTIONAL
+  )
+{
+  UINT32                  Value[4];
+  CPUID_CACHE_PARAMS_EAX  CacheEax;
+  CPUID_CACHE_PARAMS_EBX  CacheEbx;
+
+  ZeroMem (Value, sizeof (Value));
+  if (Index <= mMemTestMaxLeaf) {
+    switch (Index) {
+      case CPUID_SIGNATURE:
+        Value[0] = mMemTestMaxLeaf;
+        break;
+      case CPUID_VERSION_INFO:
+        Value[2] = mMemTestVersionEcx;
+        break;
+      case CPUID_CACHE_PARAMS:
+        //
+        // A 32 KB L1 data cache and an 8 MB L3 cache.
+        //
+        CacheEax.Uint32 = 0;
+        CacheEbx.Uint32 = 0;
+        if (SubIndex == 0) {
+          CacheEax.Bits.CacheType = CPUID_CACHE_PARAMS_CACHE_TYPE_DATA;
+          CacheEbx.Bits.Ways      = 7;
+          CacheEbx.Bits.LineSize  = 63;
+          Value[2]                = 63;
+        } else if (SubIndex == 1) {
+          CacheEax.Bits.CacheType = CPUID_CACHE_PARAMS_CACHE_TYPE_UNIFIED;
+          CacheEbx.Bits.Ways      = 15;
+          CacheEbx.Bits.LineSize  = 63;
+          Value[2]                = 8191;
+        }
+
+        Value[0] = CacheEax.Uint32;
+        Value[1] = CacheEbx.Uint32;
+        break;
+      case CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS:
+        if (SubIndex == CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS_SUB_LEAF_INFO) {
+          Value[1] = mMemTestExtendedEbx;
+          Value[3] = mMemTestExtendedEdx;
+        }
+
+        break;
+      default:
+        break;
+    }
+  }
+
+  if (Eax != NULL) {
+    *Eax = Value[0];
+  }
+
+  if (Ebx != NULL) {
+    *Ebx = Value[1];
+  }
+
+  if (Ecx != NULL) {
+    *Ecx = Value[2];
+  }
+
+  if (Edx != NULL) {
+    *Edx = Value[3];
+  }
+
+  return Index;
+}
+
+/**
+  Mocked CPUID.
+
+  @param  Index The 32-bit value to load into EAX prior to invoking the CPUID
+                instruction.
+  @param  Eax   The pointer to the 32-bit EAX value returned by the CPUID
+                instruction. This is an optional parameter that may be NULL.
+  @param  Ebx   The pointer to the 32-bit EBX value returned by the CPUID
+                instruction. This is an optional parameter that may be NULL.
+  @param  Ecx   The pointer to the 32-bit ECX value returned by the CPUID
+                instruction. This is an optional parameter that may be NULL.
+  @param  Edx   The pointer to the 32-bit EDX value returned by the CPUID
+                instruction. This is an optional parameter that may be NULL.
+
+  @return Index.
+**/
+STATIC
+UINT32
+EFIAPI
+MemTestAsmCpuid (
+  IN      UINT32  Index,
+  OUT     UINT32  *Eax   OPTIONAL,
+  OUT     UINT32  *Ebx   OPTIONAL,
+  OUT     UINT32  *Ecx   OPTIONAL,
+  OUT     UINT32  *Edx   OPTIONAL
+  )
+{
+  return MemTestAsmCpuidEx (Index, 0, Eax, Ebx, Ecx, Edx);
+}
+
+/**
+  Mocked XGETBV.
+
+  @param[in] Index        Extended control register index
+
+  @return                 The current value of the extended control register
+**/
+STATIC
+UINT64
+EFIAPI
+MemTestAsmXGetBv (
+  IN UINT32  Index
+  )
+{
+  mMemTestXGetBvCount++;
+  return (Index == 0) ? mMemTestXcr0 : 0;
+}
+
+/**
+  Check that the CPU probe only reports AVX2 and AVX-512 when the OS enabled
+  their state in XCR0, and that the non-temporal threshold follows the largest
+  cache.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+MemProbeTest (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UNIT_TEST_HOST_BASE_LIB_ASM_CPUID     OriginalAsmCpuid;
+  UNIT_TEST_HOST_BASE_LIB_ASM_CPUID_EX  OriginalAsmCpuidEx;
+  UNIT_TEST_HOST_BASE_LIB_ASM_XGETBV    OriginalAsmXGetBv;
+  CPUID_VERSION_INFO_ECX                VersionEcx;
+  UINT32                                AllFeatures;
+
+  OriginalAsmCpuid   = gUnitTestHostBaseLib.X86->AsmCpuid;
+  OriginalAsmCpuidEx = gUnitTestHostBaseLib.X86->AsmCpuidEx;
+  OriginalAsmXGetBv  = gUnitTestHostBaseLib.X86->AsmXGetBv;
+
+  gUnitTestHostBaseLib.X86->AsmCpuid   = MemTestAsmCpuid;
+  gUnitTestHostBaseLib.X86->AsmCpuidEx = MemTestAsmCpuidEx;
+  gUnitTestHostBaseLib.X86->AsmXGetBv  = MemTestAsmXGetBv;
+
+  AllFeatures = MEM_LIB_FEATURE_ERMS | MEM_LIB_FEATURE_FSRM | MEM_LIB_FEATURE_AVX2 | MEM_LIB_FEATURE_AVX512;
+
+  VersionEcx.Uint32       = 0;
+  VersionEcx.Bits.OSXSAVE = 1;
+  VersionEcx.Bits.AVX     = 1;
+  mMemTestMaxLeaf         = CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS;
+  mMemTestVersionEcx      = VersionEcx.Uint32;
+  mMemTestExtendedEbx     = BIT5 | BIT9 | BIT16;  // AVX2, ERMS, AVX512F
+  mMemTestExtendedEdx     = BIT4;                 // FSRM
+
+  //
+  // All state enabled.
+  //
+  mMemTestXcr0 = BIT0 | BIT1 | BIT2 | BIT5 | BIT6 | BIT7;
+  UT_ASSERT_EQUAL (InternalMemLibGetCpuFeatures (), AllFeatures);
+  UT_ASSERT_EQUAL (InternalMemLibGetNonTemporalThreshold (), SIZE_4MB);
+
+  //
+  // AVX-512 state disabled.
+  //
+  mMemTestXcr0 = BIT0 | BIT1 | BIT2;
+  UT_ASSERT_EQUAL (InternalMemLibGetCpuFeatures (), AllFeatures & ~MEM_LIB_FEATURE_AVX512);
+
+  //
+  // AVX state disabled.
+  //
+  mMemTestXcr0 = BIT0 | BIT1;
+  UT_ASSERT_EQUAL (InternalMemLibGetCpuFeatures (), MEM_LIB_FEATURE_ERMS | MEM_LIB_FEATURE_FSRM);
+
+  //
+  // XGETBV must not be executed when CR4.OSXSAVE is clear.
+  //
+  VersionEcx.Bits.OSXSAVE = 0;
+  mMemTestVersionEcx      = VersionEcx.Uint32;
+  mMemTestXGetBvCount     = 0;
+  UT_ASSERT_EQUAL (InternalMemLibGetCpuFeatures (), MEM_LIB_FEATURE_ERMS | MEM_LIB_FEATURE_FSRM);
+  UT_ASSERT_EQUAL (mMemTestXGetBvCount, 0);
+
+  //
+  // No structured extended feature leaf.
+  //
+  mMemTestMaxLeaf = CPUID_VERSION_INFO;
+  UT_ASSERT_EQUAL (InternalMemLibGetCpuFeatures (), 0);
+  UT_ASSERT_EQUAL (InternalMemLibGetNonTemporalThreshold (), MEM_LIB_DEFAULT_NON_TEMPORAL_THRESHOLD);
+
+  gUnitTestHostBaseLib.X86->AsmCpuid   = OriginalAsmCpuid;
+  gUnitTestHostBaseLib.X86->AsmCpuidEx = OriginalAsmCpuidEx;
+  gUnitTestHostBaseLib.X86->AsmXGetBv  = OriginalAsmXGetBv;
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Return the average number of TSC ticks of CopyMem() or SetMem() calls.
+
+  @param[in] Destination  The buffer to write.
+  @param[in] Source       The buffer to read, or NULL to run SetMem().
+  @param[in] Length       The number of bytes of each call.
+
+  @return The average number of TSC ticks of one call.
+**/
+STATIC
+UINT64
+MemTestMeasure (
+  IN UINT8        *Destination,
+  IN CONST UINT8  *Source  OPTIONAL,
+  IN UINTN        Length
+  )
+{
+  UINTN   Count;
+  UINTN   Index;
+  UINT64  Start;
+
+  Count = MAX (MEM_TEST_BENCHMARK_TOTAL_SIZE / Length, 16);
+  Start = AsmReadTsc ();
+  for (Index = 0; Index < Count; Index++) {
+    if (Source != NULL) {
+      CopyMem (Destination, Source, Length);
+    } else {
+      SetMem (Destination, Length, (UINT8)Index);
+    }
+  }
+
+  return DivU64x64Remainder (AsmReadTsc () - Start, Count, NULL);
+}
+
+/**
+  Log the speed of CopyMem() and SetMem() with SSE2 only and with all host
+  features, for sizes from 64 bytes to MEM_TEST_BENCHMARK_BUFFER_SIZE.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+MemBenchmark (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINT32  HostFeatures;
+  UINT8   *Source;
+  UINT8   *Destination;
+  UINTN   Length;
+  UINT64  CopySse2;
+  UINT64  CopyHost;
+  UINT64  SetSse2;
+  UINT64  SetHost;
+
+  Source      = AllocatePool (MEM_TEST_BENCHMARK_BUFFER_SIZE);
+  Destination = AllocatePool (MEM_TEST_BENCHMARK_BUFFER_SIZE);
+  UT_ASSERT_NOT_NULL (Source);
+  UT_ASSERT_NOT_NULL (Destination);
+  SetMem (Source, MEM_TEST_BENCHMARK_BUFFER_SIZE, 0x5A);
+  SetMem (Destination, MEM_TEST_BENCHMARK_BUFFER_SIZE, 0xA5);
+
+  HostFeatures = MemTestGetHostFeatures ();
+  for (Length = 64; Length <= MEM_TEST_BENCHMARK_BUFFER_SIZE; Length *= 4) {
+    InternalMemLibSelectKernels (0, MEM_LIB_DEFAULT_NON_TEMPORAL_THRESHOLD);
+    CopySse2 = MemTestMeasure (Destination, Source, Length);
+    SetSse2  = MemTestMeasure (Destination, NULL, Length);
+    InternalMemLibSelectKernels (HostFeatures, MEM_LIB_DEFAULT_NON_TEMPORAL_THRESHOLD);
+    CopyHost = MemTestMeasure (Destination, Source, Length);
+    SetHost  = MemTestMeasure (Destination, NULL, Length);
+
+    UT_LOG_INFO (
+      "%8lu bytes: CopyMem %Lu/%Lu ticks, SetMem %Lu/%Lu ticks (SSE2/features 0x%x)\n",
+      (UINT64)Length,
+      CopySse2,
+      CopyHost,
+      SetSse2,
+      SetHost,
+      HostFeatures
+      );
+    DEBUG ((
+      DEBUG_INFO,
+      "%8lu bytes: CopyMem %Lu/%Lu ticks, SetMem %Lu/%Lu ticks (SSE2/features 0x%x)\n",
+      (UINT64)Length,
+      CopySse2,
+      CopyHost,
+      SetSse2,
+      SetHost,
+      HostFeatures
+      ));
+  }
+
+  FreePool (Source);
+  FreePool (Destination);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for
+  BaseMemoryLibAvx and run the unit tests.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Fw;
+  UNIT_TEST_SUITE_HANDLE      MemTests;
+
+  Fw = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  //
+  // Start setting up the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Fw, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  //
+  // Populate the BaseMemoryLibAvx Unit Test Suite.
+  //
+  Status = CreateUnitTestSuite (&MemTests, Fw, "BaseMemoryLibAvx", "BaseMemoryLibAvx", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for MemTests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  // --------------Suite-----------Description--------------Class Name----------Function--------Pre---Post-------------------Context-----------
+  AddTestCase (MemTests, "CPU features are probed correctly", "Probe", MemProbeTest, NULL, NULL, NULL);
+  AddTestCase (MemTests, "All kernels match byte loops", "Kernels", MemKernelTest, NULL, NULL, NULL);
+  AddTestCase (MemTests, "CopyMem and SetMem benchmark", "Benchmark", MemBenchmark, NULL, NULL, NULL);
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Fw);
+
+EXIT:
+  if (Fw) {
+    FreeUnitTestFramework (Fw);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+**/
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  return UnitTestingEntry ();
+}
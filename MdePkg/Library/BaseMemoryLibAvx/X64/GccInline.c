@@ -0,0 +1,1045 @@
+/** @file
+  GCC inline assembly of the SSE2, ERMS, AVX2 and AVX-512 memory kernels.
+
+  Each kernel is a single assembly block, so that the compiler never allocates
+  vector registers of its own in code that may run with YMM or ZMM state live.
+  The kernels that copy or set whole vectors load the first and last vector of
+  the buffer before anything is stored and write them last, so that the main
+  loop only has to handle whole, aligned vectors of the destination.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "../MemLibInternals.h"
+
+//
+// The copy kernels pass the original Destination as the in/out operand Start,
+// as GCC may otherwise give it the register of Destination.
+//
+// Toolchains that build with -mno-sse reject XMM clobbers. The compiler does
+// not use those registers then, so there is nothing to preserve.
+//
+#if defined (__SSE2__)
+#define MEM_LIB_CLOBBERS  "cc", "memory", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5"
+#else
+#define MEM_LIB_CLOBBERS  "cc", "memory"
+#endif
+
+/**
+  Copy Length bytes from Source to Destination with XMM registers.
+
+  @param  DestinationBuffer The target of the copy request.
+  @param  SourceBuffer      The place to copy from.
+  @param  Length            The number of bytes to copy.
+
+  @return Destination.
+
+**/
+VOID *
+EFIAPI
+InternalMemCopyMemSse (
+  OUT     VOID        *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  )
+{
+  UINTN  Destination;
+  UINTN  Source;
+  UINTN  Start;
+  UINTN  End;
+  UINTN  Scratch;
+
+  Destination = (UINTN)DestinationBuffer;
+  Source      = (UINTN)SourceBuffer;
+  Start       = Destination;
+
+  __asm__ __volatile__ (
+    "cmpq     $16, %[Length]                 \n\t"
+    "jb       7f                             \n\t"
+    "movdqu   (%[Source]), %%xmm0            \n\t" // xmm0 <- first 16 bytes of Source
+    "movdqu   -16(%[Source],%[Length]), %%xmm1 \n\t" // xmm1 <- last 16 bytes of Source
+    "cmpq     $32, %[Length]                 \n\t"
+    "jbe      6f                             \n\t"
+    "leaq     (%[Dest],%[Length]), %[End]    \n\t" // End <- end of Destination
+    "addq     $16, %[Dest]                   \n\t"
+    "andq     $-16, %[Dest]                  \n\t" // Dest <- first aligned vector after Destination
+    "movq     %[Dest], %[Scratch]            \n\t"
+    "subq     %[Start], %[Scratch]           \n\t"
+    "addq     %[Scratch], %[Source]          \n\t" // Source <- matching Source
+    "movq     %[End], %[Length]              \n\t"
+    "subq     %[Dest], %[Length]             \n\t" // Length <- bytes left from Dest
+    "cmpq     $64, %[Length]                 \n\t"
+    "jbe      3f                             \n\t"
+    "2:                                      \n\t"
+    "movdqu   (%[Source]), %%xmm2            \n\t"
+    "movdqu   16(%[Source]), %%xmm3          \n\t"
+    "movdqu   32(%[Source]), %%xmm4          \n\t"
+    "movdqu   48(%[Source]), %%xmm5          \n\t"
+    "movdqa   %%xmm2, (%[Dest])              \n\t"
+    "movdqa   %%xmm3, 16(%[Dest])            \n\t"
+    "movdqa   %%xmm4, 32(%[Dest])            \n\t"
+    "movdqa   %%xmm5, 48(%[Dest])            \n\t"
+    "addq     $64, %[Source]                 \n\t"
+    "addq     $64, %[Dest]                   \n\t"
+    "subq     $64, %[Length]                 \n\t"
+    "cmpq     $64, %[Length]                 \n\t"
+    "ja       2b                             \n\t"
+    "3:                                      \n\t"
+    "cmpq     $16, %[Length]                 \n\t"
+    "jbe      5f                             \n\t"
+    "4:                                      \n\t"
+    "movdqu   (%[Source]), %%xmm2            \n\t"
+    "movdqa   %%xmm2, (%[Dest])              \n\t"
+    "addq     $16, %[Source]                 \n\t"
+    "addq     $16, %[Dest]                   \n\t"
+    "subq     $16, %[Length]                 \n\t"
+    "cmpq     $16, %[Length]                 \n\t"
+    "ja       4b                             \n\t"
+    "5:                                      \n\t"
+    "movdqu   %%xmm1, -16(%[End])            \n\t" // the last vector covers what is left
+    "movdqu   %%xmm0, (%[Start])             \n\t"
+    "jmp      9f                             \n\t"
+    "6:                                      \n\t"
+    "movdqu   %%xmm0, (%[Dest])              \n\t"
+    "movdqu   %%xmm1, -16(%[Dest],%[Length]) \n\t"
+    "jmp      9f                             \n\t"
+    "7:                                      \n\t"
+    "cmpq     $8, %[Length]                  \n\t"
+    "jb       8f                             \n\t"
+    "movq     (%[Source]), %[Scratch]        \n\t"
+    "movq     -8(%[Source],%[Length]), %[End] \n\t"
+    "movq     %[Scratch], (%[Dest])          \n\t"
+    "movq     %[End], -8(%[Dest],%[Length])  \n\t"
+    "jmp      9f                             \n\t"
+    "8:                                      \n\t"
+    "cmpq     $4, %[Length]                  \n\t"
+    "jb       10f                            \n\t"
+    "movl     (%[Source]), %k[Scratch]       \n\t"
+    "movl     -4(%[Source],%[Length]), %k[End] \n\t"
+    "movl     %k[Scratch], (%[Dest])         \n\t"
+    "movl     %k[End], -4(%[Dest],%[Length]) \n\t"
+    "jmp      9f                             \n\t"
+    "10:                                     \n\t"
+    "testq    %[Length], %[Length]           \n\t"
+    "jz       9f                             \n\t"
+    "movzbl   (%[Source]), %k[Scratch]       \n\t"
+    "cmpq     $2, %[Length]                  \n\t"
+    "jb       11f                            \n\t"
+    "movzwl   -2(%[Source],%[Length]), %k[End] \n\t"
+    "movw     %w[End], -2(%[Dest],%[Length]) \n\t"
+    "11:                                     \n\t"
+    "movb     %b[Scratch], (%[Dest])         \n\t"
+    "9:                                      \n\t"
+    : [Dest] "+r" (Destination),
+    [Source] "+r" (Source),
+    [Length] "+r" (Length),
+    [End] "=&r" (End),
+    [Scratch] "=&q" (Scratch),
+    [Start] "+r" (Start)
+    :
+    : MEM_LIB_CLOBBERS
+    );
+
+  return DestinationBuffer;
+}
+
+/**
+  Copy Length bytes from Source to Destination with REP MOVSB.
+
+  @param  DestinationBuffer The target of the copy request.
+  @param  SourceBuffer      The place to copy from.
+  @param  Length            The number of bytes to copy.
+
+  @return Destination.
+
+**/
+VOID *
+EFIAPI
+InternalMemCopyMemErms (
+  OUT     VOID        *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  )
+{
+  VOID        *Destination;
+  CONST VOID  *Source;
+
+  Destination = DestinationBuffer;
+  Source      = SourceBuffer;
+
+  __asm__ __volatile__ (
+    "rep movsb"
+    : "+D" (Destination),
+    "+S" (Source),
+    "+c" (Length)
+    :
+    : "memory"
+    );
+
+  return DestinationBuffer;
+}
+
+/**
+  Copy Length bytes from Source to Destination with YMM registers.
+
+  @param  DestinationBuffer The target of the copy request.
+  @param  SourceBuffer      The place to copy from.
+  @param  Length            The number of bytes to copy, at least 256.
+
+  @return Destination.
+
+**/
+VOID *
+EFIAPI
+InternalMemCopyMemAvx2 (
+  OUT     VOID        *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  )
+{
+  UINTN  Destination;
+  UINTN  Source;
+  UINTN  Start;
+  UINTN  End;
+  UINTN  Scratch;
+
+  Destination = (UINTN)DestinationBuffer;
+  Source      = (UINTN)SourceBuffer;
+  Start       = Destination;
+
+  __asm__ __volatile__ (
+    "vmovdqu  (%[Source]), %%ymm0            \n\t" // ymm0 <- first 32 bytes of Source
+    "vmovdqu  -32(%[Source],%[Length]), %%ymm1 \n\t" // ymm1 <- last 32 bytes of Source
+    "leaq     (%[Dest],%[Length]), %[End]    \n\t" // End <- end of Destination
+    "addq     $32, %[Dest]                   \n\t"
+    "andq     $-32, %[Dest]                  \n\t" // Dest <- first aligned vector after Destination
+    "movq     %[Dest], %[Scratch]            \n\t"
+    "subq     %[Start], %[Scratch]           \n\t"
+    "addq     %[Scratch], %[Source]          \n\t" // Source <- matching Source
+    "movq     %[End], %[Length]              \n\t"
+    "subq     %[Dest], %[Length]             \n\t" // Length <- bytes left from Dest, more than 128
+    "1:                                      \n\t"
+    "vmovdqu  (%[Source]), %%ymm2            \n\t"
+    "vmovdqu  32(%[Source]), %%ymm3          \n\t"
+    "vmovdqu  64(%[Source]), %%ymm4          \n\t"
+    "vmovdqu  96(%[Source]), %%ymm5          \n\t"
+    "vmovdqa  %%ymm2, (%[Dest])              \n\t"
+    "vmovdqa  %%ymm3, 32(%[Dest])            \n\t"
+    "vmovdqa  %%ymm4, 64(%[Dest])            \n\t"
+    "vmovdqa  %%ymm5, 96(%[Dest])            \n\t"
+    "addq     $128, %[Source]                \n\t"
+    "addq     $128, %[Dest]                  \n\t"
+    "subq     $128, %[Length]                \n\t"
+    "cmpq     $128, %[Length]                \n\t"
+    "ja       1b                             \n\t"
+    "cmpq     $32, %[Length]                 \n\t"
+    "jbe      3f                             \n\t"
+    "2:                                      \n\t"
+    "vmovdqu  (%[Source]), %%ymm2            \n\t"
+    "vmovdqa  %%ymm2, (%[Dest])              \n\t"
+    "addq     $32, %[Source]                 \n\t"
+    "addq     $32, %[Dest]                   \n\t"
+    "subq     $32, %[Length]                 \n\t"
+    "cmpq     $32, %[Length]                 \n\t"
+    "ja       2b                             \n\t"
+    "3:                                      \n\t"
+    "vmovdqu  %%ymm1, -32(%[End])            \n\t" // the last vector covers what is left
+    "vmovdqu  %%ymm0, (%[Start])             \n\t"
+    "vzeroupper                              \n\t"
+    : [Dest] "+r" (Destination),
+    [Source] "+r" (Source),
+    [Length] "+r" (Length),
+    [End] "=&r" (End),
+    [Scratch] "=&r" (Scratch),
+    [Start] "+r" (Start)
+    :
+    : MEM_LIB_CLOBBERS
+    );
+
+  return DestinationBuffer;
+}
+
+/**
+  Copy Length bytes from Source to Destination with YMM registers and
+  non-temporal stores.
+
+  @param  DestinationBuffer The target of the copy request.
+  @param  SourceBuffer      The place to copy from.
+  @param  Length            The number of bytes to copy, at least 256.
+
+  @return Destination.
+
+**/
+VOID *
+EFIAPI
+InternalMemCopyMemAvx2NonTemporal (
+  OUT     VOID        *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  )
+{
+  UINTN  Destination;
+  UINTN  Source;
+  UINTN  Start;
+  UINTN  End;
+  UINTN  Scratch;
+
+  Destination = (UINTN)DestinationBuffer;
+  Source      = (UINTN)SourceBuffer;
+  Start       = Destination;
+
+  __asm__ __volatile__ (
+    "vmovdqu  (%[Source]), %%ymm0            \n\t" // ymm0 <- first 32 bytes of Source
+    "vmovdqu  -32(%[Source],%[Length]), %%ymm1 \n\t" // ymm1 <- last 32 bytes of Source
+    "leaq     (%[Dest],%[Length]), %[End]    \n\t" // End <- end of Destination
+    "addq     $32, %[Dest]                   \n\t"
+    "andq     $-32, %[Dest]                  \n\t" // Dest <- first aligned vector after Destination
+    "movq     %[Dest], %[Scratch]            \n\t"
+    "subq     %[Start], %[Scratch]           \n\t"
+    "addq     %[Scratch], %[Source]          \n\t" // Source <- matching Source
+    "movq     %[End], %[Length]              \n\t"
+    "subq     %[Dest], %[Length]             \n\t" // Length <- bytes left from Dest, more than 128
+    "1:                                      \n\t"
+    "vmovdqu  (%[Source]), %%ymm2            \n\t"
+    "vmovdqu  32(%[Source]), %%ymm3          \n\t"
+    "vmovdqu  64(%[Source]), %%ymm4          \n\t"
+    "vmovdqu  96(%[Source]), %%ymm5          \n\t"
+    "vmovntdq %%ymm2, (%[Dest])              \n\t"
+    "vmovntdq %%ymm3, 32(%[Dest])            \n\t"
+    "vmovntdq %%ymm4, 64(%[Dest])            \n\t"
+    "vmovntdq %%ymm5, 96(%[Dest])            \n\t"
+    "addq     $128, %[Source]                \n\t"
+    "addq     $128, %[Dest]                  \n\t"
+    "subq     $128, %[Length]                \n\t"
+    "cmpq     $128, %[Length]                \n\t"
+    "ja       1b                             \n\t"
+    "cmpq     $32, %[Length]                 \n\t"
+    "jbe      3f                             \n\t"
+    "2:                                      \n\t"
+    "vmovdqu  (%[Source]), %%ymm2            \n\t"
+    "vmovntdq %%ymm2, (%[Dest])              \n\t"
+    "addq     $32, %[Source]                 \n\t"
+    "addq     $32, %[Dest]                   \n\t"
+    "subq     $32, %[Length]                 \n\t"
+    "cmpq     $32, %[Length]                 \n\t"
+    "ja       2b                             \n\t"
+    "3:                                      \n\t"
+    "sfence                                  \n\t" // order the non-temporal stores
+    "vmovdqu  %%ymm1, -32(%[End])            \n\t" // the last vector covers what is left
+    "vmovdqu  %%ymm0, (%[Start])             \n\t"
+    "vzeroupper                              \n\t"
+    : [Dest] "+r" (Destination),
+    [Source] "+r" (Source),
+    [Length] "+r" (Length),
+    [End] "=&r" (End),
+    [Scratch] "=&r" (Scratch),
+    [Start] "+r" (Start)
+    :
+    : MEM_LIB_CLOBBERS
+    );
+
+  return DestinationBuffer;
+}
+
+/**
+  Copy Length bytes from Source to Destination with ZMM registers.
+
+  @param  DestinationBuffer The target of the copy request.
+  @param  SourceBuffer      The place to copy from.
+  @param  Length            The number of bytes to copy, at least 256.
+
+  @return Destination.
+
+**/
+VOID *
+EFIAPI
+InternalMemCopyMemAvx512 (
+  OUT     VOID        *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  )
+{
+  UINTN  Destination;
+  UINTN  Source;
+  UINTN  Start;
+  UINTN  End;
+  UINTN  Scratch;
+
+  Destination = (UINTN)DestinationBuffer;
+  Source      = (UINTN)SourceBuffer;
+  Start       = Destination;
+
+  __asm__ __volatile__ (
+    "vmovdqu64 (%[Source]), %%zmm0           \n\t" // zmm0 <- first 64 bytes of Source
+    "vmovdqu64 -64(%[Source],%[Length]), %%zmm1 \n\t" // zmm1 <- last 64 bytes of Source
+    "leaq     (%[Dest],%[Length]), %[End]    \n\t" // End <- end of Destination
+    "addq     $64, %[Dest]                   \n\t"
+    "andq     $-64, %[Dest]                  \n\t" // Dest <- first aligned vector after Destination
+    "movq     %[Dest], %[Scratch]            \n\t"
+    "subq     %[Start], %[Scratch]           \n\t"
+    "addq     %[Scratch], %[Source]          \n\t" // Source <- matching Source
+    "movq     %[End], %[Length]              \n\t"
+    "subq     %[Dest], %[Length]             \n\t" // Length <- bytes left from Dest, more than 128
+    "cmpq     $256, %[Length]                \n\t"
+    "jbe      2f                             \n\t"
+    "1:                                      \n\t"
+    "vmovdqu64 (%[Source]), %%zmm2           \n\t"
+    "vmovdqu64 64(%[Source]), %%zmm3         \n\t"
+    "vmovdqu64 128(%[Source]), %%zmm4        \n\t"
+    "vmovdqu64 192(%[Source]), %%zmm5        \n\t"
+    "vmovdqa64 %%zmm2, (%[Dest])             \n\t"
+    "vmovdqa64 %%zmm3, 64(%[Dest])           \n\t"
+    "vmovdqa64 %%zmm4, 128(%[Dest])          \n\t"
+    "vmovdqa64 %%zmm5, 192(%[Dest])          \n\t"
+    "addq     $256, %[Source]                \n\t"
+    "addq     $256, %[Dest]                  \n\t"
+    "subq     $256, %[Length]                \n\t"
+    "cmpq     $256, %[Length]                \n\t"
+    "ja       1b                             \n\t"
+    "2:                                      \n\t"
+    "cmpq     $64, %[Length]                 \n\t"
+    "jbe      4f                             \n\t"
+    "3:                                      \n\t"
+    "vmovdqu64 (%[Source]), %%zmm2           \n\t"
+    "vmovdqa64 %%zmm2, (%[Dest])             \n\t"
+    "addq     $64, %[Source]                 \n\t"
+    "addq     $64, %[Dest]                   \n\t"
+    "subq     $64, %[Length]                 \n\t"
+    "cmpq     $64, %[Length]                 \n\t"
+    "ja       3b                             \n\t"
+    "4:                                      \n\t"
+    "vmovdqu64 %%zmm1, -64(%[End])           \n\t" // the last vector covers what is left
+    "vmovdqu64 %%zmm0, (%[Start])            \n\t"
+    "vzeroupper                              \n\t"
+    : [Dest] "+r" (Destination),
+    [Source] "+r" (Source),
+    [Length] "+r" (Length),
+    [End] "=&r" (End),
+    [Scratch] "=&r" (Scratch),
+    [Start] "+r" (Start)
+    :
+    : MEM_LIB_CLOBBERS
+    );
+
+  return DestinationBuffer;
+}
+
+/**
+  Copy Length bytes from Source to Destination with ZMM registers and
+  non-temporal stores.
+
+  @param  DestinationBuffer The target of the copy request.
+  @param  SourceBuffer      The place to copy from.
+  @param  Length            The number of bytes to copy, at least 256.
+
+  @return Destination.
+
+**/
+VOID *
+EFIAPI
+InternalMemCopyMemAvx512NonTemporal (
+  OUT     VOID        *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  )
+{
+  UINTN  Destination;
+  UINTN  Source;
+  UINTN  Start;
+  UINTN  End;
+  UINTN  Scratch;
+
+  Destination = (UINTN)DestinationBuffer;
+  Source      = (UINTN)SourceBuffer;
+  Start       = Destination;
+
+  __asm__ __volatile__ (
+    "vmovdqu64 (%[Source]), %%zmm0           \n\t" // zmm0 <- first 64 bytes of Source
+    "vmovdqu64 -64(%[Source],%[Length]), %%zmm1 \n\t" // zmm1 <- last 64 bytes of Source
+    "leaq     (%[Dest],%[Length]), %[End]    \n\t" // End <- end of Destination
+    "addq     $64, %[Dest]                   \n\t"
+    "andq     $-64, %[Dest]                  \n\t" // Dest <- first aligned vector after Destination
+    "movq     %[Dest], %[Scratch]            \n\t"
+    "subq     %[Start], %[Scratch]           \n\t"
+    "addq     %[Scratch], %[Source]          \n\t" // Source <- matching Source
+    "movq     %[End], %[Length]              \n\t"
+    "subq     %[Dest], %[Length]             \n\t" // Length <- bytes left from Dest, more than 128
+    "cmpq     $256, %[Length]                \n\t"
+    "jbe      2f                             \n\t"
+    "1:                                      \n\t"
+    "vmovdqu64 (%[Source]), %%zmm2           \n\t"
+    "vmovdqu64 64(%[Source]), %%zmm3         \n\t"
+    "vmovdqu64 128(%[Source]), %%zmm4        \n\t"
+    "vmovdqu64 192(%[Source]), %%zmm5        \n\t"
+    "vmovntdq %%zmm2, (%[Dest])              \n\t"
+    "vmovntdq %%zmm3, 64(%[Dest])            \n\t"
+    "vmovntdq %%zmm4, 128(%[Dest])           \n\t"
+    "vmovntdq %%zmm5, 192(%[Dest])           \n\t"
+    "addq     $256, %[Source]                \n\t"
+    "addq     $256, %[Dest]                  \n\t"
+    "subq     $256, %[Length]                \n\t"
+    "cmpq     $256, %[Length]                \n\t"
+    "ja       1b                             \n\t"
+    "2:                                      \n\t"
+    "cmpq     $64, %[Length]                 \n\t"
+    "jbe      4f                             \n\t"
+    "3:                                      \n\t"
+    "vmovdqu64 (%[Source]), %%zmm2           \n\t"
+    "vmovntdq %%zmm2, (%[Dest])              \n\t"
+    "addq     $64, %[Source]                 \n\t"
+    "addq     $64, %[Dest]                   \n\t"
+    "subq     $64, %[Length]                 \n\t"
+    "cmpq     $64, %[Length]                 \n\t"
+    "ja       3b                             \n\t"
+    "4:                                      \n\t"
+    "sfence                                  \n\t" // order the non-temporal stores
+    "vmovdqu64 %%zmm1, -64(%[End])           \n\t" // the last vector covers what is left
+    "vmovdqu64 %%zmm0, (%[Start])            \n\t"
+    "vzeroupper                              \n\t"
+    : [Dest] "+r" (Destination),
+    [Source] "+r" (Source),
+    [Length] "+r" (Length),
+    [End] "=&r" (End),
+    [Scratch] "=&r" (Scratch),
+    [Start] "+r" (Start)
+    :
+    : MEM_LIB_CLOBBERS
+    );
+
+  return DestinationBuffer;
+}
+
+/**
+  Set Buffer to Value for Length bytes with XMM registers.
+
+  @param  Buffer   The memory to set.
+  @param  Length   The number of bytes to set.
+  @param  Value    The value of the set operation.
+
+  @return Buffer.
+
+**/
+VOID *
+EFIAPI
+InternalMemSetMemSse (
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length,
+  IN      UINT8  Value
+  )
+{
+  UINTN   Destination;
+  UINTN   End;
+  UINT64  Pattern;
+
+  Destination = (UINTN)Buffer;
+  Pattern     = 0x0101010101010101ULL * Value;
+
+  __asm__ __volatile__ (
+    "cmpq     $16, %[Length]                 \n\t"
+    "jb       5f                             \n\t"
+    "movq     %[Pattern], %%xmm0             \n\t"
+    "punpcklqdq %%xmm0, %%xmm0               \n\t" // xmm0 <- Value in every byte
+    "movdqu   %%xmm0, (%[Dest])              \n\t"
+    "movdqu   %%xmm0, -16(%[Dest],%[Length]) \n\t"
+    "cmpq     $32, %[Length]                 \n\t"
+    "jbe      9f                             \n\t"
+    "leaq     (%[Dest],%[Length]), %[End]    \n\t" // End <- end of Buffer
+    "addq     $16, %[Dest]                   \n\t"
+    "andq     $-16, %[Dest]                  \n\t" // Dest <- first aligned vector after Buffer
+    "movq     %[End], %[Length]              \n\t"
+    "subq     %[Dest], %[Length]             \n\t" // Length <- bytes left from Dest
+    "cmpq     $64, %[Length]                 \n\t"
+    "jbe      2f                             \n\t"
+    "1:                                      \n\t"
+    "movdqa   %%xmm0, (%[Dest])              \n\t"
+    "movdqa   %%xmm0, 16(%[Dest])            \n\t"
+    "movdqa   %%xmm0, 32(%[Dest])            \n\t"
+    "movdqa   %%xmm0, 48(%[Dest])            \n\t"
+    "addq     $64, %[Dest]                   \n\t"
+    "subq     $64, %[Length]                 \n\t"
+    "cmpq     $64, %[Length]                 \n\t"
+    "ja       1b                             \n\t"
+    "2:                                      \n\t"
+    "cmpq     $16, %[Length]                 \n\t"
+    "jbe      9f                             \n\t"
+    "3:                                      \n\t"
+    "movdqa   %%xmm0, (%[Dest])              \n\t"
+    "addq     $16, %[Dest]                   \n\t"
+    "subq     $16, %[Length]                 \n\t"
+    "cmpq     $16, %[Length]                 \n\t"
+    "ja       3b                             \n\t"
+    "jmp      9f                             \n\t"
+    "5:                                      \n\t"
+    "cmpq     $8, %[Length]                  \n\t"
+    "jb       6f                             \n\t"
+    "movq     %[Pattern], (%[Dest])          \n\t"
+    "movq     %[Pattern], -8(%[Dest],%[Length]) \n\t"
+    "jmp      9f                             \n\t"
+    "6:                                      \n\t"
+    "cmpq     $4, %[Length]                  \n\t"
+    "jb       7f                             \n\t"
+    "movl     %k[Pattern], (%[Dest])         \n\t"
+    "movl     %k[Pattern], -4(%[Dest],%[Length]) \n\t"
+    "jmp      9f                             \n\t"
+    "7:                                      \n\t"
+    "testq    %[Length], %[Length]           \n\t"
+    "jz       9f                             \n\t"
+    "movb     %b[Pattern], (%[Dest])         \n\t"
+    "cmpq     $2, %[Length]                  \n\t"
+    "jb       9f                             \n\t"
+    "movw     %w[Pattern], -2(%[Dest],%[Length]) \n\t"
+    "9:                                      \n\t"
+    : [Dest] "+r" (Destination),
+    [Length] "+r" (Length),
+    [End] "=&r" (End)
+    : [Pattern] "q" (Pattern)
+    : MEM_LIB_CLOBBERS
+    );
+
+  return Buffer;
+}
+
+/**
+  Set Buffer to Value for Length bytes with REP STOSB.
+
+  @param  Buffer   The memory to set.
+  @param  Length   The number of bytes to set.
+  @param  Value    The value of the set operation.
+
+  @return Buffer.
+
+**/
+VOID *
+EFIAPI
+InternalMemSetMemErms (
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length,
+  IN      UINT8  Value
+  )
+{
+  VOID  *Destination;
+
+  Destination = Buffer;
+
+  __asm__ __volatile__ (
+    "rep stosb"
+    : "+D" (Destination),
+    "+c" (Length)
+    : "a" (Value)
+    : "memory"
+    );
+
+  return Buffer;
+}
+
+/**
+  Set Buffer to Value for Length bytes with YMM registers.
+
+  @param  Buffer   The memory to set.
+  @param  Length   The number of bytes to set, at least 256.
+  @param  Value    The value of the set operation.
+
+  @return Buffer.
+
+**/
+VOID *
+EFIAPI
+InternalMemSetMemAvx2 (
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length,
+  IN      UINT8  Value
+  )
+{
+  UINTN   Destination;
+  UINTN   End;
+  UINT64  Pattern;
+
+  Destination = (UINTN)Buffer;
+  Pattern     = 0x0101010101010101ULL * Value;
+
+  __asm__ __volatile__ (
+    "vmovq    %[Pattern], %%xmm0             \n\t"
+    "vpbroadcastq %%xmm0, %%ymm0             \n\t" // ymm0 <- Value in every byte
+    "leaq     (%[Dest],%[Length]), %[End]    \n\t" // End <- end of Buffer
+    "vmovdqu  %%ymm0, (%[Dest])              \n\t"
+    "vmovdqu  %%ymm0, -32(%[End])            \n\t"
+    "addq     $32, %[Dest]                   \n\t"
+    "andq     $-32, %[Dest]                  \n\t" // Dest <- first aligned vector after Buffer
+    "movq     %[End], %[Length]              \n\t"
+    "subq     %[Dest], %[Length]             \n\t" // Length <- bytes left from Dest, more than 128
+    "1:                                      \n\t"
+    "vmovdqa  %%ymm0, (%[Dest])              \n\t"
+    "vmovdqa  %%ymm0, 32(%[Dest])            \n\t"
+    "vmovdqa  %%ymm0, 64(%[Dest])            \n\t"
+    "vmovdqa  %%ymm0, 96(%[Dest])            \n\t"
+    "addq     $128, %[Dest]                  \n\t"
+    "subq     $128, %[Length]                \n\t"
+    "cmpq     $128, %[Length]                \n\t"
+    "ja       1b                             \n\t"
+    "cmpq     $32, %[Length]                 \n\t"
+    "jbe      3f                             \n\t"
+    "2:                                      \n\t"
+    "vmovdqa  %%ymm0, (%[Dest])              \n\t"
+    "addq     $32, %[Dest]                   \n\t"
+    "subq     $32, %[Length]                 \n\t"
+    "cmpq     $32, %[Length]                 \n\t"
+    "ja       2b                             \n\t"
+    "3:                                      \n\t"
+    "vzeroupper                              \n\t"
+    : [Dest] "+r" (Destination),
+    [Length] "+r" (Length),
+    [End] "=&r" (End)
+    : [Pattern] "r" (Pattern)
+    : MEM_LIB_CLOBBERS
+    );
+
+  return Buffer;
+}
+
+/**
+  Set Buffer to Value for Length bytes with YMM registers and non-temporal
+  stores.
+
+  @param  Buffer   The memory to set.
+  @param  Length   The number of bytes to set, at least 256.
+  @param  Value    The value of the set operation.
+
+  @return Buffer.
+
+**/
+VOID *
+EFIAPI
+InternalMemSetMemAvx2NonTemporal (
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length,
+  IN      UINT8  Value
+  )
+{
+  UINTN   Destination;
+  UINTN   End;
+  UINT64  Pattern;
+
+  Destination = (UINTN)Buffer;
+  Pattern     = 0x0101010101010101ULL * Value;
+
+  __asm__ __volatile__ (
+    "vmovq    %[Pattern], %%xmm0             \n\t"
+    "vpbroadcastq %%xmm0, %%ymm0             \n\t" // ymm0 <- Value in every byte
+    "leaq     (%[Dest],%[Length]), %[End]    \n\t" // End <- end of Buffer
+    "vmovdqu  %%ymm0, (%[Dest])              \n\t"
+    "vmovdqu  %%ymm0, -32(%[End])            \n\t"
+    "addq     $32, %[Dest]                   \n\t"
+    "andq     $-32, %[Dest]                  \n\t" // Dest <- first aligned vector after Buffer
+    "movq     %[End], %[Length]              \n\t"
+    "subq     %[Dest], %[Length]             \n\t" // Length <- bytes left from Dest, more than 128
+    "1:                                      \n\t"
+    "vmovntdq %%ymm0, (%[Dest])              \n\t"
+    "vmovntdq %%ymm0, 32(%[Dest])            \n\t"
+    "vmovntdq %%ymm0, 64(%[Dest])            \n\t"
+    "vmovntdq %%ymm0, 96(%[Dest])            \n\t"
+    "addq     $128, %[Dest]                  \n\t"
+    "subq     $128, %[Length]                \n\t"
+    "cmpq     $128, %[Length]                \n\t"
+    "ja       1b                             \n\t"
+    "cmpq     $32, %[Length]                 \n\t"
+    "jbe      3f                             \n\t"
+    "2:                                      \n\t"
+    "vmovntdq %%ymm0, (%[Dest])              \n\t"
+    "addq     $32, %[Dest]                   \n\t"
+    "subq     $32, %[Length]                 \n\t"
+    "cmpq     $32, %[Length]                 \n\t"
+    "ja       2b                             \n\t"
+    "3:                                      \n\t"
+    "sfence                                  \n\t" // order the non-temporal stores
+    "vzeroupper                              \n\t"
+    : [Dest] "+r" (Destination),
+    [Length] "+r" (Length),
+    [End] "=&r" (End)
+    : [Pattern] "r" (Pattern)
+    : MEM_LIB_CLOBBERS
+    );
+
+  return Buffer;
+}
+
+/**
+  Set Buffer to Value for Length bytes with ZMM registers.
+
+  @param  Buffer   The memory to set.
+  @param  Length   The number of bytes to set, at least 256.
+  @param  Value    The value of the set operation.
+
+  @return Buffer.
+
+**/
+VOID *
+EFIAPI
+InternalMemSetMemAvx512 (
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length,
+  IN      UINT8  Value
+  )
+{
+  UINTN   Destination;
+  UINTN   End;
+  UINT64  Pattern;
+
+  Destination = (UINTN)Buffer;
+  Pattern     = 0x0101010101010101ULL * Value;
+
+  __asm__ __volatile__ (
+    "vpbroadcastq %[Pattern], %%zmm0         \n\t" // zmm0 <- Value in every byte
+    "leaq     (%[Dest],%[Length]), %[End]    \n\t" // End <- end of Buffer
+    "vmovdqu64 %%zmm0, (%[Dest])             \n\t"
+    "vmovdqu64 %%zmm0, -64(%[End])           \n\t"
+    "addq     $64, %[Dest]                   \n\t"
+    "andq     $-64, %[Dest]                  \n\t" // Dest <- first aligned vector after Buffer
+    "movq     %[End], %[Length]              \n\t"
+    "subq     %[Dest], %[Length]             \n\t" // Length <- bytes left from Dest, more than 128
+    "cmpq     $256, %[Length]                \n\t"
+    "jbe      2f                             \n\t"
+    "1:                                      \n\t"
+    "vmovdqa64 %%zmm0, (%[Dest])             \n\t"
+    "vmovdqa64 %%zmm0, 64(%[Dest])           \n\t"
+    "vmovdqa64 %%zmm0, 128(%[Dest])          \n\t"
+    "vmovdqa64 %%zmm0, 192(%[Dest])          \n\t"
+    "addq     $256, %[Dest]                  \n\t"
+    "subq     $256, %[Length]                \n\t"
+    "cmpq     $256, %[Length]                \n\t"
+    "ja       1b                             \n\t"
+    "2:                                      \n\t"
+    "cmpq     $64, %[Length]                 \n\t"
+    "jbe      4f                             \n\t"
+    "3:                                      \n\t"
+    "vmovdqa64 %%zmm0, (%[Dest])             \n\t"
+    "addq     $64, %[Dest]                   \n\t"
+    "subq     $64, %[Length]                 \n\t"
+    "cmpq     $64, %[Length]                 \n\t"
+    "ja       3b                             \n\t"
+    "4:                                      \n\t"
+    "vzeroupper                              \n\t"
+    : [Dest] "+r" (Destination),
+    [Length] "+r" (Length),
+    [End] "=&r" (End)
+    : [Pattern] "r" (Pattern)
+    : MEM_LIB_CLOBBERS
+    );
+
+  return Buffer;
+}
+
+/**
+  Set Buffer to Value for Length bytes with ZMM registers and non-temporal
+  stores.
+
+  @param  Buffer   The memory to set.
+  @param  Length   The number of bytes to set, at least 256.
+  @param  Value    The value of the set operation.
+
+  @return Buffer.
+
+**/
+VOID *
+EFIAPI
+InternalMemSetMemAvx512NonTemporal (
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length,
+  IN      UINT8  Value
+  )
+{
+  UINTN   Destination;
+  UINTN   End;
+  UINT64  Pattern;
+
+  Destination = (UINTN)Buffer;
+  Pattern     = 0x0101010101010101ULL * Value;
+
+  __asm__ __volatile__ (
+    "vpbroadcastq %[Pattern], %%zmm0         \n\t" // zmm0 <- Value in every byte
+    "leaq     (%[Dest],%[Length]), %[End]    \n\t" // End <- end of Buffer
+    "vmovdqu64 %%zmm0, (%[Dest])             \n\t"
+    "vmovdqu64 %%zmm0, -64(%[End])           \n\t"
+    "addq     $64, %[Dest]                   \n\t"
+    "andq     $-64, %[Dest]                  \n\t" // Dest <- first aligned vector after Buffer
+    "movq     %[End], %[Length]              \n\t"
+    "subq     %[Dest], %[Length]             \n\t" // Length <- bytes left from Dest, more than 128
+    "cmpq     $256, %[Length]                \n\t"
+    "jbe      2f                             \n\t"
+    "1:                                      \n\t"
+    "vmovntdq %%zmm0, (%[Dest])              \n\t"
+    "vmovntdq %%zmm0, 64(%[Dest])            \n\t"
+    "vmovntdq %%zmm0, 128(%[Dest])           \n\t"
+    "vmovntdq %%zmm0, 192(%[Dest])           \n\t"
+    "addq     $256, %[Dest]                  \n\t"
+    "subq     $256, %[Length]                \n\t"
+    "cmpq     $256, %[Length]                \n\t"
+    "ja       1b                             \n\t"
+    "2:                                      \n\t"
+    "cmpq     $64, %[Length]                 \n\t"
+    "jbe      4f                             \n\t"
+    "3:                                      \n\t"
+    "vmovntdq %%zmm0, (%[Dest])              \n\t"
+    "addq     $64, %[Dest]                   \n\t"
+    "subq     $64, %[Length]                 \n\t"
+    "cmpq     $64, %[Length]                 \n\t"
+    "ja       3b                             \n\t"
+    "4:                                      \n\t"
+    "sfence                                  \n\t" // order the non-temporal stores
+    "vzeroupper                              \n\t"
+    : [Dest] "+r" (Destination),
+    [Length] "+r" (Length),
+    [End] "=&r" (End)
+    : [Pattern] "r" (Pattern)
+    : MEM_LIB_CLOBBERS
+    );
+
+  return Buffer;
+}
+
+/**
+  Compares two memory buffers of a given length with XMM registers.
+
+  @param  DestinationBuffer The first memory buffer.
+  @param  SourceBuffer      The second memory buffer.
+  @param  Length            The length of DestinationBuffer and SourceBuffer memory
+                            regions to compare. Must be non-zero.
+
+  @return 0                 All Length bytes of the two buffers are identical.
+  @retval Non-zero          The first mismatched byte in SourceBuffer subtracted from the first
+                            mismatched byte in DestinationBuffer.
+
+**/
+INTN
+EFIAPI
+InternalMemCompareMemSse (
+  IN      CONST VOID  *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  )
+{
+  INTN   Result;
+  UINTN  Offset;
+  UINTN  Scratch;
+
+  __asm__ __volatile__ (
+    "cmpq     $16, %[Length]                 \n\t"
+    "jb       4f                             \n\t"
+    "xorl     %k[Offset], %k[Offset]         \n\t" // Offset <- offset of the current vector
+    "subq     $16, %[Length]                 \n\t" // Length <- offset of the last vector
+    "1:                                      \n\t"
+    "movdqu   (%[Buffer1],%[Offset]), %%xmm0 \n\t"
+    "movdqu   (%[Buffer2],%[Offset]), %%xmm1 \n\t"
+    "pcmpeqb  %%xmm1, %%xmm0                 \n\t"
+    "pmovmskb %%xmm0, %k[Scratch]            \n\t"
+    "cmpl     $0xFFFF, %k[Scratch]           \n\t"
+    "jne      3f                             \n\t"
+    "addq     $16, %[Offset]                 \n\t"
+    "cmpq     %[Length], %[Offset]           \n\t"
+    "jb       1b                             \n\t"
+    "movq     %[Length], %[Offset]           \n\t"
+    "movdqu   (%[Buffer1],%[Offset]), %%xmm0 \n\t"
+    "movdqu   (%[Buffer2],%[Offset]), %%xmm1 \n\t"
+    "pcmpeqb  %%xmm1, %%xmm0                 \n\t"
+    "pmovmskb %%xmm0, %k[Scratch]            \n\t"
+    "cmpl     $0xFFFF, %k[Scratch]           \n\t"
+    "jne      3f                             \n\t"
+    "xorl     %k[Result], %k[Result]         \n\t"
+    "jmp      9f                             \n\t"
+    "3:                                      \n\t"
+    "notl     %k[Scratch]                    \n\t"
+    "bsfl     %k[Scratch], %k[Scratch]       \n\t" // Scratch <- index of the first mismatch
+    "addq     %[Scratch], %[Offset]          \n\t"
+    "movzbl   (%[Buffer1],%[Offset]), %k[Result] \n\t"
+    "movzbl   (%[Buffer2],%[Offset]), %k[Scratch] \n\t"
+    "subq     %[Scratch], %[Result]          \n\t"
+    "jmp      9f                             \n\t"
+    "4:                                      \n\t"
+    "xorl     %k[Offset], %k[Offset]         \n\t"
+    "5:                                      \n\t"
+    "movzbl   (%[Buffer1],%[Offset]), %k[Result] \n\t"
+    "movzbl   (%[Buffer2],%[Offset]), %k[Scratch] \n\t"
+    "subq     %[Scratch], %[Result]          \n\t"
+    "jnz      9f                             \n\t"
+    "incq     %[Offset]                      \n\t"
+    "cmpq     %[Length], %[Offset]           \n\t"
+    "jb       5b                             \n\t"
+    "9:                                      \n\t"
+    : [Result] "=&r" (Result),
+    [Offset] "=&r" (Offset),
+    [Scratch] "=&r" (Scratch),
+    [Length] "+r" (Length)
+    : [Buffer1] "r" (DestinationBuffer),
+    [Buffer2] "r" (SourceBuffer)
+    : MEM_LIB_CLOBBERS
+    );
+
+  return Result;
+}
+
+/**
+  Compares two memory buffers of a given length with YMM registers.
+
+  @param  DestinationBuffer The first memory buffer.
+  @param  SourceBuffer      The second memory buffer.
+  @param  Length            The length of DestinationBuffer and SourceBuffer memory
+                            regions to compare, at least 32.
+
+  @return 0                 All Length bytes of the two buffers are identical.
+  @retval Non-zero          The first mismatched byte in SourceBuffer subtracted from the first
+                            mismatched byte in DestinationBuffer.
+
+**/
+INTN
+EFIAPI
+InternalMemCompareMemAvx2 (
+  IN      CONST VOID  *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  )
+{
+  INTN   Result;
+  UINTN  Offset;
+  UINTN  Scratch;
+
+  __asm__ __volatile__ (
+    "xorl     %k[Offset], %k[Offset]         \n\t" // Offset <- offset of the current vector
+    "subq     $32, %[Length]                 \n\t" // Length <- offset of the last vector
+    "1:                                      \n\t"
+    "vmovdqu  (%[Buffer1],%[Offset]), %%ymm0 \n\t"
+    "vpcmpeqb (%[Buffer2],%[Offset]), %%ymm0, %%ymm0 \n\t"
+    "vpmovmskb %%ymm0, %k[Scratch]           \n\t"
+    "cmpl     $-1, %k[Scratch]               \n\t"
+    "jne      3f                             \n\t"
+    "addq     $32, %[Offset]                 \n\t"
+    "cmpq     %[Length], %[Offset]           \n\t"
+    "jb       1b                             \n\t"
+    "movq     %[Length], %[Offset]           \n\t"
+    "vmovdqu  (%[Buffer1],%[Offset]), %%ymm0 \n\t"
+    "vpcmpeqb (%[Buffer2],%[Offset]), %%ymm0, %%ymm0 \n\t"
+    "vpmovmskb %%ymm0, %k[Scratch]           \n\t"
+    "cmpl     $-1, %k[Scratch]               \n\t"
+    "jne      3f                             \n\t"
+    "xorl     %k[Result], %k[Result]         \n\t"
+    "jmp      9f                             \n\t"
+    "3:                                      \n\t"
+    "notl     %k[Scratch]                    \n\t"
+    "bsfl     %k[Scratch], %k[Scratch]       \n\t" // Scratch <- index of the first mismatch
+    "addq     %[Scratch], %[Offset]          \n\t"
+    "movzbl   (%[Buffer1],%[Offset]), %k[Result] \n\t"
+    "movzbl   (%[Buffer2],%[Offset]), %k[Scratch] \n\t"
+    "subq     %[Scratch], %[Result]          \n\t"
+    "9:                                      \n\t"
+    "vzeroupper                              \n\t"
+    : [Result] "=&r" (Result),
+    [Offset] "=&r" (Offset),
+    [Scratch] "=&r" (Scratch),
+    [Length] "+r" (Length)
+    : [Buffer1] "r" (DestinationBuffer),
+    [Buffer2] "r" (SourceBuffer)
+    : MEM_LIB_CLOBBERS
+    );
+
+  return Result;
+}
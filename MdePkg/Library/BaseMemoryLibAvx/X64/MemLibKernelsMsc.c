@@ -0,0 +1,155 @@
+/** @file
+  SSE2 and ERMS memory kernels for Microsoft toolchains.
+
+  Microsoft toolchains have no inline assembly for X64, so the XMM kernels
+  forward to the upstream SSE2 kernels and the AVX kernels are not built.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "../MemLibInternals.h"
+
+/**
+  Microsoft Visual Studio Function Prototypes for String Intrinsics.
+**/
+
+VOID
+__movsb (
+  UINT8        *Destination,
+  CONST UINT8  *Source,
+  UINTN        Count
+  );
+
+VOID
+__stosb (
+  UINT8  *Destination,
+  UINT8  Data,
+  UINTN  Count
+  );
+
+#pragma intrinsic(__movsb)
+#pragma intrinsic(__stosb)
+
+/**
+  Copy Length bytes from Source to Destination with XMM registers.
+
+  @param  DestinationBuffer The target of the copy request.
+  @param  SourceBuffer      The place to copy from.
+  @param  Length            The number of bytes to copy.
+
+  @return Destination.
+
+**/
+VOID *
+EFIAPI
+InternalMemCopyMemSse (
+  OUT     VOID        *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  )
+{
+  return InternalMemCopyMemSse2 (DestinationBuffer, SourceBuffer, Length);
+}
+
+/**
+  Copy Length bytes from Source to Destination with REP MOVSB.
+
+  @param  DestinationBuffer The target of the copy request.
+  @param  SourceBuffer      The place to copy from.
+  @param  Length            The number of bytes to copy.
+
+  @return Destination.
+
+**/
+VOID *
+EFIAPI
+InternalMemCopyMemErms (
+  OUT     VOID        *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  )
+{
+  __movsb (DestinationBuffer, SourceBuffer, Length);
+  return DestinationBuffer;
+}
+
+/**
+  Set Buffer to Value for Length bytes with XMM registers.
+
+  @param  Buffer   The memory to set.
+  @param  Length   The number of bytes to set.
+  @param  Value    The value of the set operation.
+
+  @return Buffer.
+
+**/
+VOID *
+EFIAPI
+InternalMemSetMemSse (
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length,
+  IN      UINT8  Value
+  )
+{
+  return InternalMemSetMemRepStos (Buffer, Length, Value);
+}
+
+/**
+  Set Buffer to Value for Length bytes with REP STOSB.
+
+  @param  Buffer   The memory to set.
+  @param  Length   The number of bytes to set.
+  @param  Value    The value of the set operation.
+
+  @return Buffer.
+
+**/
+VOID *
+EFIAPI
+InternalMemSetMemErms (
+  OUT     VOID   *Buffer,
+  IN      UINTN  Length,
+  IN      UINT8  Value
+  )
+{
+  __stosb (Buffer, Value, Length);
+  return Buffer;
+}
+
+/**
+  Compares two memory buffers of a given length.
+
+  @param  DestinationBuffer The first memory buffer.
+  @param  SourceBuffer      The second memory buffer.
+  @param  Length            The length of DestinationBuffer and SourceBuffer memory
+                            regions to compare. Must be non-zero.
+
+  @return 0                 All Length bytes of the two buffers are identical.
+  @retval Non-zero          The first mismatched byte in SourceBuffer subtracted from the first
+                            mismatched byte in DestinationBuffer.
+
+**/
+INTN
+EFIAPI
+InternalMemCompareMemSse (
+  IN      CONST VOID  *DestinationBuffer,
+  IN      CONST VOID  *SourceBuffer,
+  IN      UINTN       Length
+  )
+{
+  CONST UINT8  *Buffer1;
+  CONST UINT8  *Buffer2;
+  UINTN        Index;
+
+  Buffer1 = DestinationBuffer;
+  Buffer2 = SourceBuffer;
+  for (Index = 0; Index < Length; Index++) {
+    if (Buffer1[Index] != Buffer2[Index]) {
+      return (INTN)Buffer1[Index] - (INTN)Buffer2[Index];
+    }
+  }
+
+  return 0;
+}
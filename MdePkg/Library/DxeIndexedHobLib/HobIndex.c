@@ -0,0 +1,302 @@
+/** @file
+  HOB list index used by DxeIndexedHobLib.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <PiDxe.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/HobLib.h>
+#include <Library/MemoryAllocationLib.h>
+
+#include "HobIndex.h"
+
+/**
+  Compares two GUIDs for ordering purposes.
+
+  @param[in] Guid1  The first GUID.
+  @param[in] Guid2  The second GUID.
+
+  @retval <0  Guid1 is ordered before Guid2.
+  @retval 0   Guid1 equals Guid2.
+  @retval >0  Guid1 is ordered after Guid2.
+**/
+STATIC
+INTN
+InternalCompareGuidOrder (
+  IN CONST EFI_GUID  *Guid1,
+  IN CONST EFI_GUID  *Guid2
+  )
+{
+  return CompareMem (Guid1, Guid2, sizeof (EFI_GUID));
+}
+
+/**
+  Orders two GUID HOB index entries by name and then by address.
+
+  @param[in] Buffer1  The first HOB_INDEX_GUID_ENTRY.
+  @param[in] Buffer2  The second HOB_INDEX_GUID_ENTRY.
+
+  @retval <0  Buffer1 is ordered before Buffer2.
+  @retval 0   Buffer1 equals Buffer2.
+  @retval >0  Buffer1 is ordered after Buffer2.
+**/
+STATIC
+INTN
+EFIAPI
+InternalCompareGuidEntry (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  CONST HOB_INDEX_GUID_ENTRY  *Entry1;
+  CONST HOB_INDEX_GUID_ENTRY  *Entry2;
+  INTN                        Result;
+
+  Entry1 = (CONST HOB_INDEX_GUID_ENTRY *)Buffer1;
+  Entry2 = (CONST HOB_INDEX_GUID_ENTRY *)Buffer2;
+
+  Result = InternalCompareGuidOrder (&Entry1->Name, &Entry2->Name);
+  if (Result != 0) {
+    return Result;
+  }
+
+  if ((UINTN)Entry1->Hob < (UINTN)Entry2->Hob) {
+    return -1;
+  }
+
+  return (UINTN)Entry1->Hob > (UINTN)Entry2->Hob ? 1 : 0;
+}
+
+/**
+  Checks whether a HOB pointer lies within the indexed HOB list.
+
+  @param[in] Index  The HOB list index.
+  @param[in] Hob    The HOB pointer to check.
+
+  @retval TRUE   Hob lies within the indexed HOB list.
+  @retval FALSE  Hob lies outside the indexed HOB list or Index is empty.
+**/
+STATIC
+BOOLEAN
+InternalIsHobIndexed (
+  IN CONST HOB_INDEX  *Index,
+  IN CONST VOID       *Hob
+  )
+{
+  return Index->HobList != NULL
+         && (UINTN)Hob >= (UINTN)Index->HobList
+         && (UINTN)Hob <= (UINTN)Index->HobEnd;
+}
+
+VOID *
+HobIndexWalkNextHob (
+  IN UINT16      Type,
+  IN CONST VOID  *HobStart
+  )
+{
+  EFI_PEI_HOB_POINTERS  Hob;
+
+  ASSERT (HobStart != NULL);
+
+  Hob.Raw = (UINT8 *)HobStart;
+  //
+  // Parse the HOB list until end of list or matching type is found.
+  //
+  while (!END_OF_HOB_LIST (Hob)) {
+    if (Hob.Header->HobType == Type) {
+      return Hob.Raw;
+    }
+
+    Hob.Raw = GET_NEXT_HOB (Hob);
+  }
+
+  return NULL;
+}
+
+VOID *
+HobIndexWalkNextGuidHob (
+  IN CONST EFI_GUID  *Guid,
+  IN CONST VOID      *HobStart
+  )
+{
+  EFI_PEI_HOB_POINTERS  GuidHob;
+
+  GuidHob.Raw = (UINT8 *)HobStart;
+  while ((GuidHob.Raw = HobIndexWalkNextHob (EFI_HOB_TYPE_GUID_EXTENSION, GuidHob.Raw)) != NULL) {
+    if (CompareGuid (Guid, &GuidHob.Guid->Name)) {
+      break;
+    }
+
+    GuidHob.Raw = GET_NEXT_HOB (GuidHob);
+  }
+
+  return GuidHob.Raw;
+}
+
+RETURN_STATUS
+HobIndexBuild (
+  IN  CONST VOID  *HobList,
+  OUT HOB_INDEX   *Index
+  )
+{
+  EFI_PEI_HOB_POINTERS  Hob;
+  UINTN                 GuidHobCount;
+  UINTN                 EntryIndex;
+  HOB_INDEX_GUID_ENTRY  SwapEntry;
+
+  ASSERT (HobList != NULL);
+  ASSERT (Index != NULL);
+
+  ZeroMem (Index, sizeof (*Index));
+
+  //
+  // Record the first HOB of every type and count the GUID HOBs.
+  //
+  GuidHobCount = 0;
+  for (Hob.Raw = (UINT8 *)HobList; !END_OF_HOB_LIST (Hob); Hob.Raw = GET_NEXT_HOB (Hob)) {
+    if ((Hob.Header->HobType < HOB_INDEX_TYPE_COUNT)
+        && (Index->FirstHobOfType[Hob.Header->HobType] == NULL))
+    {
+      Index->FirstHobOfType[Hob.Header->HobType] = Hob.Raw;
+    }
+
+    if (Hob.Header->HobType == EFI_HOB_TYPE_GUID_EXTENSION) {
+      ++GuidHobCount;
+    }
+  }
+
+  if (GuidHobCount > 0) {
+    Index->GuidHobs = AllocatePool (GuidHobCount * sizeof (*Index->GuidHobs));
+    if (Index->GuidHobs == NULL) {
+      ZeroMem (Index->FirstHobOfType, sizeof (Index->FirstHobOfType));
+      return RETURN_OUT_OF_RESOURCES;
+    }
+
+    EntryIndex = 0;
+    for (Hob.Raw = (UINT8 *)HobList; !END_OF_HOB_LIST (Hob); Hob.Raw = GET_NEXT_HOB (Hob)) {
+      if (Hob.Header->HobType == EFI_HOB_TYPE_GUID_EXTENSION) {
+        CopyGuid (&Index->GuidHobs[EntryIndex].Name, &Hob.Guid->Name);
+        Index->GuidHobs[EntryIndex].Hob = Hob.Raw;
+        ++EntryIndex;
+      }
+    }
+
+    ASSERT (EntryIndex == GuidHobCount);
+
+    QuickSort (
+      Index->GuidHobs,
+      GuidHobCount,
+      sizeof (*Index->GuidHobs),
+      InternalCompareGuidEntry,
+      &SwapEntry
+      );
+  }
+
+  Index->HobList      = (UINT8 *)HobList;
+  Index->HobEnd       = Hob.Raw;
+  Index->GuidHobCount = GuidHobCount;
+
+  return RETURN_SUCCESS;
+}
+
+VOID
+HobIndexFree (
+  IN OUT HOB_INDEX  *Index
+  )
+{
+  ASSERT (Index != NULL);
+
+  if (Index->GuidHobs != NULL) {
+    FreePool (Index->GuidHobs);
+  }
+
+  ZeroMem (Index, sizeof (*Index));
+}
+
+VOID *
+HobIndexGetNextHob (
+  IN CONST HOB_INDEX  *Index,
+  IN UINT16           Type,
+  IN CONST VOID       *HobStart
+  )
+{
+  EFI_PEI_HOB_POINTERS  Hob;
+
+  ASSERT (Index != NULL);
+  ASSERT (HobStart != NULL);
+
+  //
+  // Only lookups from the start of the list are indexed.  The slot is only
+  // trusted while the recorded HOB still has the requested type, as HOBs may
+  // be marked unused after the index was built.
+  //
+  if ((HobStart == Index->HobList) && (Type < HOB_INDEX_TYPE_COUNT)) {
+    Hob.Raw = Index->FirstHobOfType[Type];
+    if ((Hob.Raw == NULL) || (Hob.Header->HobType == Type)) {
+      return Hob.Raw;
+    }
+  }
+
+  return HobIndexWalkNextHob (Type, HobStart);
+}
+
+VOID *
+HobIndexGetNextGuidHob (
+  IN CONST HOB_INDEX  *Index,
+  IN CONST EFI_GUID   *Guid,
+  IN CONST VOID       *HobStart
+  )
+{
+  EFI_PEI_HOB_POINTERS  Hob;
+  UINTN                 Low;
+  UINTN                 High;
+  UINTN                 Middle;
+  INTN                  Result;
+
+  ASSERT (Index != NULL);
+  ASSERT (Guid != NULL);
+  ASSERT (HobStart != NULL);
+
+  if (!InternalIsHobIndexed (Index, HobStart)) {
+    return HobIndexWalkNextGuidHob (Guid, HobStart);
+  }
+
+  //
+  // Find the first entry that is not ordered before (Guid, HobStart).
+  //
+  Low  = 0;
+  High = Index->GuidHobCount;
+  while (Low < High) {
+    Middle = Low + (High - Low) / 2;
+    Result = InternalCompareGuidOrder (&Index->GuidHobs[Middle].Name, Guid);
+    if ((Result < 0)
+        || ((Result == 0) && ((UINTN)Index->GuidHobs[Middle].Hob < (UINTN)HobStart)))
+    {
+      Low = Middle + 1;
+    } else {
+      High = Middle;
+    }
+  }
+
+  //
+  // Skip HOBs that have been marked unused since the index was built.
+  //
+  for ( ; Low < Index->GuidHobCount; ++Low) {
+    if (!CompareGuid (&Index->GuidHobs[Low].Name, Guid)) {
+      break;
+    }
+
+    Hob.Raw = Index->GuidHobs[Low].Hob;
+    if (Hob.Header->HobType == EFI_HOB_TYPE_GUID_EXTENSION) {
+      return Hob.Raw;
+    }
+  }
+
+  return NULL;
+}
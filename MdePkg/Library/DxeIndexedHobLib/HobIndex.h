@@ -0,0 +1,146 @@
+/** @file
+  Internal definitions of the HOB list index used by DxeIndexedHobLib.
+
+  The index is built once over a read-only HOB list and answers the lookups
+  made by GetFirstHob(), GetNextHob(), GetFirstGuidHob() and GetNextGuidHob()
+  without walking the whole list.  Any query the index cannot answer falls
+  back to the linear walk, so the results are identical to DxeHobLib.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef HOB_INDEX_H_
+#define HOB_INDEX_H_
+
+#include <PiDxe.h>
+
+///
+/// HOB types below this value get a first-instance slot in the index.
+///
+#define HOB_INDEX_TYPE_COUNT  16
+
+typedef struct {
+  EFI_GUID    Name;
+  VOID        *Hob;
+} HOB_INDEX_GUID_ENTRY;
+
+typedef struct {
+  ///
+  /// The first HOB of the indexed list, or NULL when the index is empty.
+  ///
+  UINT8                   *HobList;
+  ///
+  /// The END_OF_HOB_LIST HOB of the indexed list.
+  ///
+  UINT8                   *HobEnd;
+  ///
+  /// The first HOB of every type below HOB_INDEX_TYPE_COUNT.
+  ///
+  VOID                    *FirstHobOfType[HOB_INDEX_TYPE_COUNT];
+  ///
+  /// GUID HOBs sorted by name and, for equal names, by address.
+  ///
+  UINTN                   GuidHobCount;
+  HOB_INDEX_GUID_ENTRY    *GuidHobs;
+} HOB_INDEX;
+
+/**
+  Builds the index of a HOB list.
+
+  The HOB list must not be extended while the index is in use.  HOBs that are
+  marked as EFI_HOB_TYPE_UNUSED after the index was built are detected during
+  lookup and skipped.
+
+  @param[in]  HobList  The first HOB of the HOB list.
+  @param[out] Index    The index to initialise.
+
+  @retval RETURN_SUCCESS           The index was built.
+  @retval RETURN_OUT_OF_RESOURCES  The GUID HOB table could not be allocated.
+                                   Index is left empty and all lookups use
+                                   the linear walk.
+**/
+RETURN_STATUS
+HobIndexBuild (
+  IN  CONST VOID  *HobList,
+  OUT HOB_INDEX   *Index
+  );
+
+/**
+  Releases the resources of a HOB list index and leaves it empty.
+
+  @param[in,out] Index  The index to release.
+**/
+VOID
+HobIndexFree (
+  IN OUT HOB_INDEX  *Index
+  );
+
+/**
+  Returns the next instance of a HOB type from the starting HOB.
+
+  The semantics are identical to GetNextHob().
+
+  @param[in] Index     The index of the HOB list HobStart belongs to.
+  @param[in] Type      The HOB type to return.
+  @param[in] HobStart  The starting HOB pointer to search from.
+
+  @return The next instance of a HOB type from the starting HOB.
+**/
+VOID *
+HobIndexGetNextHob (
+  IN CONST HOB_INDEX  *Index,
+  IN UINT16           Type,
+  IN CONST VOID       *HobStart
+  );
+
+/**
+  Returns the next instance of the matched GUID HOB from the starting HOB.
+
+  The semantics are identical to GetNextGuidHob().
+
+  @param[in] Index     The index of the HOB list HobStart belongs to.
+  @param[in] Guid      The GUID to match with in the HOB list.
+  @param[in] HobStart  The starting HOB pointer to search from.
+
+  @return The next instance of the matched GUID HOB from the starting HOB.
+**/
+VOID *
+HobIndexGetNextGuidHob (
+  IN CONST HOB_INDEX  *Index,
+  IN CONST EFI_GUID   *Guid,
+  IN CONST VOID       *HobStart
+  );
+
+/**
+  Returns the next instance of a HOB type from the starting HOB by walking the
+  HOB list.
+
+  @param[in] Type      The HOB type to return.
+  @param[in] HobStart  The starting HOB pointer to search from.
+
+  @return The next instance of a HOB type from the starting HOB.
+**/
+VOID *
+HobIndexWalkNextHob (
+  IN UINT16      Type,
+  IN CONST VOID  *HobStart
+  );
+
+/**
+  Returns the next instance of the matched GUID HOB from the starting HOB by
+  walking the HOB list.
+
+  @param[in] Guid      The GUID to match with in the HOB list.
+  @param[in] HobStart  The starting HOB pointer to search from.
+
+  @return The next instance of the matched GUID HOB from the starting HOB.
+**/
+VOID *
+HobIndexWalkNextGuidHob (
+  IN CONST EFI_GUID  *Guid,
+  IN CONST VOID      *HobStart
+  );
+
+#endif // HOB_INDEX_H_
@@ -0,0 +1,599 @@
+/** @file
+  Unit tests and benchmark of the QuickSort() and SortByUint64Key() APIs in
+  BaseLib.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UnitTestLib.h>
+
+#define UNIT_TEST_APP_NAME     "BaseLib Sort Unit Test Application"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+///
+/// Number of elements sorted by the benchmark.
+///
+#define SORT_BENCHMARK_COUNT  20000
+
+typedef enum {
+  SortPatternSorted,
+  SortPatternReversed,
+  SortPatternRandom,
+  SortPatternEqual,
+  SortPatternOrganPipe,
+  SortPatternFewUnique,
+  SortPatternNearlySorted,
+  SortPatternMax
+} SORT_PATTERN;
+
+GLOBAL_REMOVE_IF_UNREFERENCED CONST CHAR8  *mSortPatternNames[SortPatternMax] = {
+  "sorted",
+  "reversed",
+  "random",
+  "equal",
+  "organ pipe",
+  "few unique",
+  "nearly sorted"
+};
+
+///
+/// Element sizes covering the UINT32, UINT64, UINTN and byte swap paths.
+///
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINTN  mSortElementSizes[] = { 4, 8, 24, 13 };
+
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINTN  mSortCounts[] = { 0, 1, 2, 3, 16, 17, 100, 1000, 5000 };
+
+UINTN   mCompareCount;
+UINT32  mRandomState;
+
+/**
+  Return the next value of a deterministic pseudo random sequence.
+
+  @return A pseudo random number.
+**/
+UINT32
+SortTestRandom (
+  VOID
+  )
+{
+  mRandomState = mRandomState * 1103515245 + 12345;
+  return mRandomState >> 8;
+}
+
+/**
+  Generate the key of an element of a test pattern.
+
+  @param[in] Pattern  The test pattern.
+  @param[in] Index    The index of the element.
+  @param[in] Count    The number of elements.
+
+  @return The key.
+**/
+UINT64
+SortTestKey (
+  IN SORT_PATTERN  Pattern,
+  IN UINTN         Index,
+  IN UINTN         Count
+  )
+{
+  switch (Pattern) {
+    case SortPatternSorted:
+      return LShiftU64 (Index, 12);
+    case SortPatternReversed:
+      return LShiftU64 (Count - Index, 12);
+    case SortPatternRandom:
+      return LShiftU64 (SortTestRandom (), 20) ^ SortTestRandom ();
+    case SortPatternEqual:
+      return 0x1000;
+    case SortPatternOrganPipe:
+      return (Index < Count / 2) ? Index : Count - Index;
+    case SortPatternFewUnique:
+      return SortTestRandom () % 4;
+    default:
+      return ((Index % 97) == 0) ? SortTestRandom () : LShiftU64 (Index, 12);
+  }
+}
+
+/**
+  Fill a buffer with elements of a test pattern.
+
+  The key of each element is stored at offset 0, or at offset 1 for elements
+  whose size is not a multiple of 4. The bytes after the key hold the index of
+  the element, so the sort order of equal keys can be checked.
+
+  @param[out] Buffer       The buffer to fill.
+  @param[in]  Count        The number of elements.
+  @param[in]  ElementSize  The size of an element.
+  @param[in]  Pattern      The test pattern.
+**/
+VOID
+SortTestFill (
+  OUT UINT8         *Buffer,
+  IN  UINTN         Count,
+  IN  UINTN         ElementSize,
+  IN  SORT_PATTERN  Pattern
+  )
+{
+  UINTN   Index;
+  UINT64  Key;
+  UINTN   KeyOffset;
+  UINTN   KeySize;
+
+  KeyOffset = ((ElementSize % 4) == 0) ? 0 : 1;
+  KeySize   = MIN (ElementSize - KeyOffset, sizeof (UINT64));
+
+  mRandomState = 0x5EED;
+  for (Index = 0; Index < Count; Index++) {
+    SetMem (Buffer + Index * ElementSize, ElementSize, 0);
+    Key = SortTestKey (Pattern, Index, Count);
+    CopyMem (Buffer + Index * ElementSize + KeyOffset, &Key, KeySize);
+    if (ElementSize >= KeyOffset + KeySize + sizeof (UINT32)) {
+      WriteUnaligned32 ((UINT32 *)(Buffer + Index * ElementSize + KeyOffset + KeySize), (UINT32)Index);
+    }
+  }
+}
+
+/**
+  Read the key of an element filled by SortTestFill().
+
+  @param[in] Element      The element.
+  @param[in] ElementSize  The size of the element.
+
+  @return The key.
+**/
+UINT64
+SortTestReadKey (
+  IN CONST VOID  *Element,
+  IN UINTN       ElementSize
+  )
+{
+  UINT64  Key;
+  UINTN   KeyOffset;
+
+  KeyOffset = ((ElementSize % 4) == 0) ? 0 : 1;
+  Key       = 0;
+  CopyMem (&Key, (CONST UINT8 *)Element + KeyOffset, MIN (ElementSize - KeyOffset, sizeof (UINT64)));
+  return Key;
+}
+
+/**
+  Compare two keys.
+
+  @param[in] Key1  The first key.
+  @param[in] Key2  The second key.
+
+  @retval 0   Key1 is equal to Key2.
+  @retval -1  Key1 is less than Key2.
+  @retval 1   Key1 is greater than Key2.
+**/
+INTN
+SortTestCompareKeys (
+  IN UINT64  Key1,
+  IN UINT64  Key2
+  )
+{
+  mCompareCount++;
+  if (Key1 < Key2) {
+    return -1;
+  }
+
+  return (Key1 > Key2) ? 1 : 0;
+}
+
+/**
+  Compare the keys of two 4-byte elements and count the comparison.
+
+  @param[in] Buffer1  The first element.
+  @param[in] Buffer2  The second element.
+
+  @return The result of SortTestCompareKeys().
+**/
+INTN
+EFIAPI
+SortTestCompare4 (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  return SortTestCompareKeys (SortTestReadKey (Buffer1, 4), SortTestReadKey (Buffer2, 4));
+}
+
+/**
+  Compare the keys of two 8-byte elements and count the comparison.
+
+  @param[in] Buffer1  The first element.
+  @param[in] Buffer2  The second element.
+
+  @return The result of SortTestCompareKeys().
+**/
+INTN
+EFIAPI
+SortTestCompare8 (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  return SortTestCompareKeys (SortTestReadKey (Buffer1, 8), SortTestReadKey (Buffer2, 8));
+}
+
+/**
+  Compare the keys of two 24-byte elements and count the comparison.
+
+  @param[in] Buffer1  The first element.
+  @param[in] Buffer2  The second element.
+
+  @return The result of SortTestCompareKeys().
+**/
+INTN
+EFIAPI
+SortTestCompare24 (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  return SortTestCompareKeys (SortTestReadKey (Buffer1, 24), SortTestReadKey (Buffer2, 24));
+}
+
+/**
+  Compare the keys of two 13-byte elements and count the comparison.
+
+  @param[in] Buffer1  The first element.
+  @param[in] Buffer2  The second element.
+
+  @return The result of SortTestCompareKeys().
+**/
+INTN
+EFIAPI
+SortTestCompare13 (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  return SortTestCompareKeys (SortTestReadKey (Buffer1, 13), SortTestReadKey (Buffer2, 13));
+}
+
+/**
+  Return the comparison function for an element size.
+
+  @param[in] ElementSize  The size of an element.
+
+  @return The comparison function.
+**/
+BASE_SORT_COMPARE
+SortTestGetCompare (
+  IN UINTN  ElementSize
+  )
+{
+  switch (ElementSize) {
+    case 4:
+      return SortTestCompare4;
+    case 8:
+      return SortTestCompare8;
+    case 24:
+      return SortTestCompare24;
+    default:
+      return SortTestCompare13;
+  }
+}
+
+/**
+  Check that a buffer is sorted and holds the same elements as the reference.
+
+  @param[in] Buffer       The sorted buffer.
+  @param[in] Reference    The unsorted elements.
+  @param[in] Count        The number of elements.
+  @param[in] ElementSize  The size of an element.
+
+  @retval TRUE   The buffer is a sorted permutation of Reference.
+  @retval FALSE  The buffer is not sorted or has different elements.
+**/
+BOOLEAN
+SortTestIsSortedPermutation (
+  IN CONST UINT8  *Buffer,
+  IN CONST UINT8  *Reference,
+  IN UINTN        Count,
+  IN UINTN        ElementSize
+  )
+{
+  UINTN   Index;
+  UINTN   Offset;
+  UINT64  SumBuffer;
+  UINT64  SumReference;
+
+  for (Index = 1; Index < Count; Index++) {
+    if (SortTestReadKey (Buffer + (Index - 1) * ElementSize, ElementSize) > SortTestReadKey (Buffer + Index * ElementSize, ElementSize)) {
+      return FALSE;
+    }
+  }
+
+  //
+  // Every element carries its index, so equal byte sums are a cheap check
+  // that no element got lost or duplicated.
+  //
+  SumBuffer    = 0;
+  SumReference = 0;
+  for (Offset = 0; Offset < Count * ElementSize; Offset++) {
+    SumBuffer    += MultU64x32 (Buffer[Offset], (UINT32)(Offset % ElementSize) + 1);
+    SumReference += MultU64x32 (Reference[Offset], (UINT32)(Offset % ElementSize) + 1);
+  }
+
+  return (BOOLEAN)(SumBuffer == SumReference);
+}
+
+/**
+  Sort all test patterns of all sizes with QuickSort() and check the result.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+QuickSortPatternTest (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN         SizeIndex;
+  UINTN         CountIndex;
+  UINTN         Count;
+  UINTN         ElementSize;
+  SORT_PATTERN  Pattern;
+  UINT8         *Reference;
+  UINT8         *Buffer;
+  UINT8         Element[24];
+
+  Reference = AllocatePool (5000 * 24);
+  Buffer    = AllocatePool (5000 * 24 + 1);
+  UT_ASSERT_NOT_NULL (Reference);
+  UT_ASSERT_NOT_NULL (Buffer);
+
+  for (SizeIndex = 0; SizeIndex < ARRAY_SIZE (mSortElementSizes); SizeIndex++) {
+    ElementSize = mSortElementSizes[SizeIndex];
+    for (CountIndex = 0; CountIndex < ARRAY_SIZE (mSortCounts); CountIndex++) {
+      Count = mSortCounts[CountIndex];
+      for (Pattern = 0; Pattern < SortPatternMax; Pattern++) {
+        SortTestFill (Reference, Count, ElementSize, Pattern);
+
+        //
+        // Also sort a misaligned copy so that the byte swap path is used for
+        // every element size.
+        //
+        CopyMem (Buffer, Reference, Count * ElementSize);
+        QuickSort (Buffer, Count, ElementSize, SortTestGetCompare (ElementSize), Element);
+        UT_ASSERT_TRUE (SortTestIsSortedPermutation (Buffer, Reference, Count, ElementSize));
+
+        CopyMem (Buffer + 1, Reference, Count * ElementSize);
+        QuickSort (Buffer + 1, Count, ElementSize, SortTestGetCompare (ElementSize), Element);
+        UT_ASSERT_TRUE (SortTestIsSortedPermutation (Buffer + 1, Reference, Count, ElementSize));
+      }
+    }
+  }
+
+  FreePool (Reference);
+  FreePool (Buffer);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Sort all test patterns with SortByUint64Key() and check that the result is
+  sorted and that equal keys kept their order.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+SortByUint64KeyTest (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN         SizeIndex;
+  UINTN         CountIndex;
+  UINTN         Count;
+  UINTN         ElementSize;
+  UINTN         KeyOffset;
+  UINTN         Index;
+  SORT_PATTERN  Pattern;
+  UINT8         *Reference;
+  UINT8         *Buffer;
+  UINT8         *Scratch;
+  UINT32        PreviousTag;
+  UINT32        Tag;
+
+  Reference = AllocatePool (5000 * 24);
+  Buffer    = AllocatePool (5000 * 24);
+  Scratch   = AllocatePool (5000 * 24);
+  UT_ASSERT_NOT_NULL (Reference);
+  UT_ASSERT_NOT_NULL (Buffer);
+  UT_ASSERT_NOT_NULL (Scratch);
+
+  //
+  // Only elements that hold a full key and a tag after it.
+  //
+  for (SizeIndex = 0; SizeIndex < ARRAY_SIZE (mSortElementSizes); SizeIndex++) {
+    ElementSize = mSortElementSizes[SizeIndex];
+    KeyOffset   = ((ElementSize % 4) == 0) ? 0 : 1;
+    if (ElementSize < KeyOffset + sizeof (UINT64) + sizeof (UINT32)) {
+      continue;
+    }
+
+    for (CountIndex = 0; CountIndex < ARRAY_SIZE (mSortCounts); CountIndex++) {
+      Count = mSortCounts[CountIndex];
+      for (Pattern = 0; Pattern < SortPatternMax; Pattern++) {
+        SortTestFill (Reference, Count, ElementSize, Pattern);
+        CopyMem (Buffer, Reference, Count * ElementSize);
+
+        SortByUint64Key (Buffer, Count, ElementSize, KeyOffset, Scratch);
+        UT_ASSERT_TRUE (SortTestIsSortedPermutation (Buffer, Reference, Count, ElementSize));
+
+        PreviousTag = 0;
+        for (Index = 1; Index < Count; Index++) {
+          Tag = ReadUnaligned32 ((UINT32 *)(Buffer + Index * ElementSize + KeyOffset + sizeof (UINT64)));
+          if (SortTestReadKey (Buffer + (Index - 1) * ElementSize, ElementSize) == SortTestReadKey (Buffer + Index * ElementSize, ElementSize)) {
+            UT_ASSERT_TRUE (Tag > PreviousTag);
+          }
+
+          PreviousTag = Tag;
+        }
+      }
+    }
+  }
+
+  FreePool (Reference);
+  FreePool (Buffer);
+  FreePool (Scratch);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Count the comparisons QuickSort() needs for each test pattern and check that
+  none of them degrades to quadratic behavior.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+QuickSortBenchmark (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  SORT_PATTERN  Pattern;
+  UINT64        *Buffer;
+  UINT64        *Scratch;
+  UINT64        Element;
+  UINTN         Limit;
+
+  Buffer  = AllocatePool (SORT_BENCHMARK_COUNT * sizeof (UINT64));
+  Scratch = AllocatePool (SORT_BENCHMARK_COUNT * sizeof (UINT64));
+  UT_ASSERT_NOT_NULL (Buffer);
+  UT_ASSERT_NOT_NULL (Scratch);
+
+  //
+  // 2 * n * log2 (n) is far below the n * n / 2 comparisons of a quicksort
+  // with a fixed pivot on sorted input.
+  //
+  Limit = 2 * SORT_BENCHMARK_COUNT * (HighBitSet32 (SORT_BENCHMARK_COUNT) + 1);
+
+  for (Pattern = 0; Pattern < SortPatternMax; Pattern++) {
+    SortTestFill ((UINT8 *)Buffer, SORT_BENCHMARK_COUNT, sizeof (UINT64), Pattern);
+    mCompareCount = 0;
+    QuickSort (Buffer, SORT_BENCHMARK_COUNT, sizeof (UINT64), SortTestCompare8, &Element);
+    UT_LOG_INFO ("QuickSort: %d %a elements: %Lu comparisons\n", SORT_BENCHMARK_COUNT, mSortPatternNames[Pattern], (UINT64)mCompareCount);
+    DEBUG ((DEBUG_INFO, "QuickSort: %d %a elements: %Lu comparisons\n", SORT_BENCHMARK_COUNT, mSortPatternNames[Pattern], (UINT64)mCompareCount));
+    UT_ASSERT_TRUE (mCompareCount <= Limit);
+
+    SortTestFill ((UINT8 *)Buffer, SORT_BENCHMARK_COUNT, sizeof (UINT64), Pattern);
+    SortByUint64Key (Buffer, SORT_BENCHMARK_COUNT, sizeof (UINT64), 0, Scratch);
+    UT_ASSERT_TRUE (SortTestIsSortedPermutation ((UINT8 *)Buffer, (UINT8 *)Buffer, SORT_BENCHMARK_COUNT, sizeof (UINT64)));
+  }
+
+  FreePool (Buffer);
+  FreePool (Scratch);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the
+  sort APIs of BaseLib and run the unit tests.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Fw;
+  UNIT_TEST_SUITE_HANDLE      SortTests;
+
+  Fw = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  //
+  // Start setting up the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Fw, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  //
+  // Populate the Sort Unit Test Suite.
+  //
+  Status = CreateUnitTestSuite (&SortTests, Fw, "Sort", "BaseLib.Sort", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for SortTests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  // --------------Suite-----------Description--------------Class Name----------Function--------Pre---Post-------------------Context-----------
+  AddTestCase (SortTests, "QuickSort sorts all patterns and element sizes", "QuickSortPatterns", QuickSortPatternTest, NULL, NULL, NULL);
+  AddTestCase (SortTests, "SortByUint64Key sorts stably", "SortByUint64Key", SortByUint64KeyTest, NULL, NULL, NULL);
+  AddTestCase (SortTests, "QuickSort comparison count benchmark", "QuickSortBenchmark", QuickSortBenchmark, NULL, NULL, NULL);
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Fw);
+
+EXIT:
+  if (Fw) {
+    FreeUnitTestFramework (Fw);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+**/
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  return UnitTestingEntry ();
+}
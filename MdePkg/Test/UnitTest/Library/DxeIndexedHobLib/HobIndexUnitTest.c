@@ -0,0 +1,509 @@
+/** @file
+  Unit tests of the HOB list index used by DxeIndexedHobLib.
+
+  Every lookup answered by the index is compared against the linear walk of
+  the same HOB list.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <PiDxe.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/HobLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UnitTestLib.h>
+
+#include "../../../../Library/DxeIndexedHobLib/HobIndex.h"
+
+#define UNIT_TEST_NAME     "DxeIndexedHobLib HOB index unit tests"
+#define UNIT_TEST_VERSION  "1.0"
+
+#define TEST_HOB_LIST_SIZE   SIZE_64KB
+#define TEST_HOB_COUNT       768
+#define TEST_GUID_COUNT      8
+#define TEST_GUID_DATA_SIZE  24
+
+typedef struct {
+  UINT64       *Buffer;
+  UINT8        *HobList;
+  HOB_INDEX    Index;
+} HOB_INDEX_TEST_CONTEXT;
+
+STATIC CONST EFI_GUID  mTestGuids[TEST_GUID_COUNT] = {
+  { 0x9a3c4b20, 0x1f2e, 0x4d5c, { 0x8b, 0x7a, 0x69, 0x58, 0x47, 0x36, 0x25, 0x14 }
+  },
+  { 0x0b1c2d3e, 0x4f50, 0x6172, { 0x83, 0x94, 0xa5, 0xb6, 0xc7, 0xd8, 0xe9, 0xfa }
+  },
+  { 0xfedcba98, 0x7654, 0x3210, { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef }
+  },
+  { 0x9a3c4b20, 0x1f2e, 0x4d5c, { 0x8b, 0x7a, 0x69, 0x58, 0x47, 0x36, 0x25, 0x15 }
+  },
+  { 0x00000000, 0x0000, 0x0000, { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 }
+  },
+  { 0x5e6f7081, 0x92a3, 0xb4c5, { 0xd6, 0xe7, 0xf8, 0x09, 0x1a, 0x2b, 0x3c, 0x4d }
+  },
+  { 0xffffffff, 0xffff, 0xffff, { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe }
+  },
+  { 0x12345678, 0x9abc, 0xdef0, { 0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc, 0xde, 0xf0 }
+  }
+};
+
+///
+/// A GUID that is never added to the test HOB list.
+///
+STATIC CONST EFI_GUID  mAbsentGuid = {
+  0x6b8f1d3a, 0x2c4e, 0x4f60, { 0x91, 0xa2, 0xb3, 0xc4, 0xd5, 0xe6, 0xf7, 0x08 }
+};
+
+STATIC UINT32  mRandomSeed;
+
+/**
+  Returns a deterministic pseudo-random number.
+
+  @return The next pseudo-random number.
+**/
+STATIC
+UINT32
+TestRandom (
+  VOID
+  )
+{
+  mRandomSeed = mRandomSeed * 1103515245 + 12345;
+  return mRandomSeed >> 8;
+}
+
+/**
+  Appends a HOB to the test HOB list.
+
+  @param[in,out] Hob        The HOB pointer to append at.  Advanced past the new HOB.
+  @param[in]     HobType    The type of the new HOB.
+  @param[in]     HobLength  The length of the new HOB.
+
+  @return The new HOB.
+**/
+STATIC
+VOID *
+TestAppendHob (
+  IN OUT EFI_PEI_HOB_POINTERS  *Hob,
+  IN     UINT16                HobType,
+  IN     UINT16                HobLength
+  )
+{
+  VOID  *NewHob;
+
+  NewHob = Hob->Raw;
+  ZeroMem (NewHob, HobLength);
+  Hob->Header->HobType   = HobType;
+  Hob->Header->HobLength = HobLength;
+  Hob->Raw              += HobLength;
+  return NewHob;
+}
+
+/**
+  Builds a HOB list of PHIT, resource, memory allocation, FV and GUID HOBs.
+  Every GUID is used by multiple HOBs.
+
+  @param[out] Buffer  The buffer to build the HOB list in.
+**/
+STATIC
+VOID
+TestBuildHobList (
+  OUT UINT64  *Buffer
+  )
+{
+  EFI_PEI_HOB_POINTERS  Hob;
+  EFI_HOB_GUID_TYPE     *GuidHob;
+  UINTN                 Index;
+  UINT32                Kind;
+
+  mRandomSeed = 0x4F424821;
+
+  Hob.Raw = (UINT8 *)Buffer;
+  TestAppendHob (&Hob, EFI_HOB_TYPE_HANDOFF, sizeof (EFI_HOB_HANDOFF_INFO_TABLE));
+
+  for (Index = 0; Index < TEST_HOB_COUNT; ++Index) {
+    Kind = TestRandom () % 8;
+    switch (Kind) {
+      case 0:
+        TestAppendHob (&Hob, EFI_HOB_TYPE_RESOURCE_DESCRIPTOR, sizeof (EFI_HOB_RESOURCE_DESCRIPTOR));
+        break;
+      case 1:
+        TestAppendHob (&Hob, EFI_HOB_TYPE_MEMORY_ALLOCATION, sizeof (EFI_HOB_MEMORY_ALLOCATION));
+        break;
+      case 2:
+        TestAppendHob (&Hob, EFI_HOB_TYPE_FV, sizeof (EFI_HOB_FIRMWARE_VOLUME));
+        break;
+      default:
+        GuidHob = TestAppendHob (
+                    &Hob,
+                    EFI_HOB_TYPE_GUID_EXTENSION,
+                    sizeof (EFI_HOB_GUID_TYPE) + TEST_GUID_DATA_SIZE
+                    );
+        CopyGuid (&GuidHob->Name, &mTestGuids[TestRandom () % TEST_GUID_COUNT]);
+        break;
+    }
+  }
+
+  TestAppendHob (&Hob, EFI_HOB_TYPE_END_OF_HOB_LIST, sizeof (EFI_HOB_GENERIC_HEADER));
+  ASSERT ((UINTN)(Hob.Raw - (UINT8 *)Buffer) <= TEST_HOB_LIST_SIZE);
+}
+
+/**
+  Compares all indexed GUID lookups for a GUID against the linear walk.
+
+  @param[in]  Index    The HOB list index.
+  @param[in]  HobList  The indexed HOB list.
+  @param[in]  Guid     The GUID to look up.
+  @param[out] Count    The number of matching HOBs.
+
+  @retval UNIT_TEST_PASSED             All lookups matched.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  A lookup did not match.
+**/
+STATIC
+UNIT_TEST_STATUS
+TestCompareGuidLookups (
+  IN  CONST HOB_INDEX  *Index,
+  IN  CONST VOID       *HobList,
+  IN  CONST EFI_GUID   *Guid,
+  OUT UINTN            *Count
+  )
+{
+  EFI_PEI_HOB_POINTERS  Indexed;
+  EFI_PEI_HOB_POINTERS  Walked;
+  EFI_PEI_HOB_POINTERS  Hob;
+
+  *Count = 0;
+
+  //
+  // Chained lookups, as done by callers iterating over all instances.
+  //
+  Indexed.Raw = HobIndexGetNextGuidHob (Index, Guid, HobList);
+  Walked.Raw  = HobIndexWalkNextGuidHob (Guid, HobList);
+  while (Walked.Raw != NULL) {
+    UT_ASSERT_EQUAL ((UINTN)Indexed.Raw, (UINTN)Walked.Raw);
+    ++(*Count);
+    Indexed.Raw = HobIndexGetNextGuidHob (Index, Guid, GET_NEXT_HOB (Indexed));
+    Walked.Raw  = HobIndexWalkNextGuidHob (Guid, GET_NEXT_HOB (Walked));
+  }
+
+  UT_ASSERT_EQUAL ((UINTN)Indexed.Raw, 0);
+
+  //
+  // Lookups starting from every HOB, including HobStart itself matching.
+  //
+  for (Hob.Raw = (UINT8 *)HobList; !END_OF_HOB_LIST (Hob); Hob.Raw = GET_NEXT_HOB (Hob)) {
+    UT_ASSERT_EQUAL (
+      (UINTN)HobIndexGetNextGuidHob (Index, Guid, Hob.Raw),
+      (UINTN)HobIndexWalkNextGuidHob (Guid, Hob.Raw)
+      );
+  }
+
+  UT_ASSERT_EQUAL (
+    (UINTN)HobIndexGetNextGuidHob (Index, Guid, Hob.Raw),
+    (UINTN)HobIndexWalkNextGuidHob (Guid, Hob.Raw)
+    );
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Compares indexed type lookups from the start of the list against the linear
+  walk.
+
+  @param[in] Index    The HOB list index.
+  @param[in] HobList  The indexed HOB list.
+
+  @retval UNIT_TEST_PASSED             All lookups matched.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  A lookup did not match.
+**/
+STATIC
+UNIT_TEST_STATUS
+TestCompareTypeLookups (
+  IN CONST HOB_INDEX  *Index,
+  IN CONST VOID       *HobList
+  )
+{
+  UINT16  Type;
+
+  for (Type = 0; Type <= HOB_INDEX_TYPE_COUNT; ++Type) {
+    UT_ASSERT_EQUAL (
+      (UINTN)HobIndexGetNextHob (Index, Type, HobList),
+      (UINTN)HobIndexWalkNextHob (Type, HobList)
+      );
+  }
+
+  UT_ASSERT_EQUAL (
+    (UINTN)HobIndexGetNextHob (Index, EFI_HOB_TYPE_UNUSED, HobList),
+    (UINTN)HobIndexWalkNextHob (EFI_HOB_TYPE_UNUSED, HobList)
+    );
+  UT_ASSERT_EQUAL ((UINTN)HobIndexGetNextHob (Index, EFI_HOB_TYPE_END_OF_HOB_LIST, HobList), 0);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Builds the test HOB list and its index.
+
+  @param[in] Context  The HOB_INDEX_TEST_CONTEXT.
+
+  @retval UNIT_TEST_PASSED                      The HOB list was indexed.
+  @retval UNIT_TEST_ERROR_PREREQUISITE_NOT_MET  The HOB list could not be set up.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestSetup (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  HOB_INDEX_TEST_CONTEXT  *TestContext;
+  RETURN_STATUS           Status;
+
+  TestContext         = (HOB_INDEX_TEST_CONTEXT *)Context;
+  TestContext->Buffer = AllocatePool (TEST_HOB_LIST_SIZE);
+  if (TestContext->Buffer == NULL) {
+    return UNIT_TEST_ERROR_PREREQUISITE_NOT_MET;
+  }
+
+  TestBuildHobList (TestContext->Buffer);
+  TestContext->HobList = (UINT8 *)TestContext->Buffer;
+
+  Status = HobIndexBuild (TestContext->HobList, &TestContext->Index);
+  if (RETURN_ERROR (Status)) {
+    FreePool (TestContext->Buffer);
+    return UNIT_TEST_ERROR_PREREQUISITE_NOT_MET;
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Releases the test HOB list and its index.
+
+  @param[in] Context  The HOB_INDEX_TEST_CONTEXT.
+**/
+STATIC
+VOID
+EFIAPI
+TestCleanup (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  HOB_INDEX_TEST_CONTEXT  *TestContext;
+
+  TestContext = (HOB_INDEX_TEST_CONTEXT *)Context;
+  HobIndexFree (&TestContext->Index);
+  FreePool (TestContext->Buffer);
+}
+
+/**
+  Checks that GUID and type lookups through the index match the linear walk.
+
+  @param[in] Context  The HOB_INDEX_TEST_CONTEXT.
+
+  @retval UNIT_TEST_PASSED             All lookups matched.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  A lookup did not match.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestIndexMatchesWalk (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  HOB_INDEX_TEST_CONTEXT  *TestContext;
+  UNIT_TEST_STATUS        Status;
+  UINTN                   GuidIndex;
+  UINTN                   Count;
+  UINTN                   Total;
+
+  TestContext = (HOB_INDEX_TEST_CONTEXT *)Context;
+
+  Total = 0;
+  for (GuidIndex = 0; GuidIndex < TEST_GUID_COUNT; ++GuidIndex) {
+    Status = TestCompareGuidLookups (&TestContext->Index, TestContext->HobList, &mTestGuids[GuidIndex], &Count);
+    if (Status != UNIT_TEST_PASSED) {
+      return Status;
+    }
+
+    UT_ASSERT_NOT_EQUAL (Count, 0);
+    Total += Count;
+  }
+
+  UT_ASSERT_EQUAL (Total, TestContext->Index.GuidHobCount);
+
+  Status = TestCompareGuidLookups (&TestContext->Index, TestContext->HobList, &mAbsentGuid, &Count);
+  if (Status != UNIT_TEST_PASSED) {
+    return Status;
+  }
+
+  UT_ASSERT_EQUAL (Count, 0);
+
+  return TestCompareTypeLookups (&TestContext->Index, TestContext->HobList);
+}
+
+/**
+  Checks that HOBs marked unused after the index was built are skipped.
+
+  @param[in] Context  The HOB_INDEX_TEST_CONTEXT.
+
+  @retval UNIT_TEST_PASSED             All lookups matched.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  A lookup did not match.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestIndexSkipsUnusedHobs (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  HOB_INDEX_TEST_CONTEXT  *TestContext;
+  EFI_PEI_HOB_POINTERS    Hob;
+  UNIT_TEST_STATUS        Status;
+  UINTN                   GuidIndex;
+  UINTN                   Count;
+
+  TestContext = (HOB_INDEX_TEST_CONTEXT *)Context;
+
+  //
+  // Mark the first instance of every GUID, the first FV HOB and every third
+  // HOB unused.
+  //
+  for (GuidIndex = 0; GuidIndex < TEST_GUID_COUNT; ++GuidIndex) {
+    Hob.Raw = HobIndexWalkNextGuidHob (&mTestGuids[GuidIndex], TestContext->HobList);
+    if (Hob.Raw != NULL) {
+      Hob.Header->HobType = EFI_HOB_TYPE_UNUSED;
+    }
+  }
+
+  Hob.Raw = HobIndexWalkNextHob (EFI_HOB_TYPE_FV, TestContext->HobList);
+  UT_ASSERT_NOT_NULL (Hob.Raw);
+  Hob.Header->HobType = EFI_HOB_TYPE_UNUSED;
+
+  GuidIndex = 0;
+  for (Hob.Raw = GET_NEXT_HOB (TestContext->HobList); !END_OF_HOB_LIST (Hob); Hob.Raw = GET_NEXT_HOB (Hob)) {
+    if ((++GuidIndex % 3) == 0) {
+      Hob.Header->HobType = EFI_HOB_TYPE_UNUSED;
+    }
+  }
+
+  for (GuidIndex = 0; GuidIndex < TEST_GUID_COUNT; ++GuidIndex) {
+    Status = TestCompareGuidLookups (&TestContext->Index, TestContext->HobList, &mTestGuids[GuidIndex], &Count);
+    if (Status != UNIT_TEST_PASSED) {
+      return Status;
+    }
+  }
+
+  return TestCompareTypeLookups (&TestContext->Index, TestContext->HobList);
+}
+
+/**
+  Checks that lookups starting outside of the indexed HOB list walk the list
+  they were given.
+
+  @param[in] Context  The HOB_INDEX_TEST_CONTEXT.
+
+  @retval UNIT_TEST_PASSED             All lookups matched.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  A lookup did not match.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestIndexForeignHobList (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  HOB_INDEX_TEST_CONTEXT  *TestContext;
+  UINT64                  *Copy;
+  UINTN                   GuidIndex;
+  UINTN                   Count;
+  UNIT_TEST_STATUS        Status;
+
+  TestContext = (HOB_INDEX_TEST_CONTEXT *)Context;
+
+  Copy = AllocateCopyPool (TEST_HOB_LIST_SIZE, TestContext->Buffer);
+  UT_ASSERT_NOT_NULL (Copy);
+
+  Status = UNIT_TEST_PASSED;
+  for (GuidIndex = 0; GuidIndex < TEST_GUID_COUNT && Status == UNIT_TEST_PASSED; ++GuidIndex) {
+    Status = TestCompareGuidLookups (&TestContext->Index, Copy, &mTestGuids[GuidIndex], &Count);
+  }
+
+  if (Status == UNIT_TEST_PASSED) {
+    Status = TestCompareTypeLookups (&TestContext->Index, Copy);
+  }
+
+  FreePool (Copy);
+  return Status;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the HOB list
+  index and run the unit tests.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      HobIndexTests;
+  HOB_INDEX_TEST_CONTEXT      TestContext;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_NAME, UNIT_TEST_VERSION));
+
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_NAME, gEfiCallerBaseName, UNIT_TEST_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&HobIndexTests, Framework, "HOB Index Tests", "HobIndex", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for HOB Index Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  AddTestCase (HobIndexTests, "Indexed lookups match the linear walk", "MatchesWalk", TestIndexMatchesWalk, TestSetup, TestCleanup, &TestContext);
+  AddTestCase (HobIndexTests, "HOBs marked unused are skipped", "SkipsUnused", TestIndexSkipsUnusedHobs, TestSetup, TestCleanup, &TestContext);
+  AddTestCase (HobIndexTests, "Lookups outside the indexed list walk", "ForeignList", TestIndexForeignHobList, TestSetup, TestCleanup, &TestContext);
+
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework != NULL) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+
+  @param Argc  Number of arguments.
+  @param Argv  Array of arguments.
+
+  @return Test application exit code.
+**/
+INT32
+main (
+  INT32  Argc,
+  CHAR8  *Argv[]
+  )
+{
+  return UnitTestingEntry ();
+}
@@ -0,0 +1,429 @@
+/** @file
+  The DNS cache shared by all DNSv4 and DNSv6 instances.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "DnsImpl.h"
+
+/**
+  Check whether two host names are the same. Host names are case insensitive.
+
+  @param  HostName1          The first host name.
+  @param  HostName2          The second host name.
+
+  @retval TRUE               The host names are the same.
+  @retval FALSE              The host names are different.
+
+**/
+STATIC
+BOOLEAN
+DnsCacheMatchHostName (
+  IN CONST CHAR16  *HostName1,
+  IN CONST CHAR16  *HostName2
+  )
+{
+  while ((*HostName1 != L'\0') && (CharToUpper (*HostName1) == CharToUpper (*HostName2))) {
+    HostName1++;
+    HostName2++;
+  }
+
+  return (BOOLEAN)(CharToUpper (*HostName1) == CharToUpper (*HostName2));
+}
+
+/**
+  Update Dns4 cache to shared list of caches of all DNSv4 instances.
+
+  @param  Dns4CacheList      All Dns4 cache list.
+  @param  DeleteFlag         If FALSE, this function is to add one entry to the DNS Cache.
+                             If TRUE, this function will delete matching DNS Cache entry.
+  @param  Override           If TRUE, the matching DNS cache entry will be overwritten with the supplied parameter.
+                             If FALSE, EFI_ACCESS_DENIED will be returned if the entry to be added is already exists.
+  @param  DnsCacheEntry      Entry Pointer to DNS Cache entry.
+
+  @retval EFI_SUCCESS        Update Dns4 cache successfully.
+  @retval Others             Failed to update Dns4 cache.
+
+**/
+EFI_STATUS
+EFIAPI
+UpdateDns4Cache (
+  IN LIST_ENTRY            *Dns4CacheList,
+  IN BOOLEAN               DeleteFlag,
+  IN BOOLEAN               Override,
+  IN EFI_DNS4_CACHE_ENTRY  DnsCacheEntry
+  )
+{
+  DNS4_CACHE  *NewDnsCache;
+  DNS4_CACHE  *Item;
+  LIST_ENTRY  *Entry;
+  LIST_ENTRY  *Next;
+
+  NewDnsCache = NULL;
+  Item        = NULL;
+
+  //
+  // Search the database for the matching EFI_DNS_CACHE_ENTRY
+  //
+  NET_LIST_FOR_EACH_SAFE (Entry, Next, Dns4CacheList) {
+    Item = NET_LIST_USER_STRUCT (Entry, DNS4_CACHE, AllCacheLink);
+    if (DnsCacheMatchHostName (DnsCacheEntry.HostName, Item->DnsCache.HostName) && \
+        (CompareMem (DnsCacheEntry.IpAddress, Item->DnsCache.IpAddress, sizeof (EFI_IPv4_ADDRESS)) == 0))
+    {
+      //
+      // This is the Dns cache entry
+      //
+      if (DeleteFlag) {
+        //
+        // Delete matching DNS Cache entry
+        //
+        RemoveEntryList (&Item->AllCacheLink);
+
+        FreePool (Item->DnsCache.HostName);
+        FreePool (Item->DnsCache.IpAddress);
+        FreePool (Item);
+
+        return EFI_SUCCESS;
+      } else if (Override) {
+        //
+        // Update this one
+        //
+        Item->DnsCache.Timeout = DnsCacheEntry.Timeout;
+
+        return EFI_SUCCESS;
+      } else {
+        return EFI_ACCESS_DENIED;
+      }
+    }
+  }
+
+  //
+  // Add new one
+  //
+  NewDnsCache = AllocatePool (sizeof (DNS4_CACHE));
+  if (NewDnsCache == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  InitializeListHead (&NewDnsCache->AllCacheLink);
+
+  NewDnsCache->DnsCache.HostName = AllocatePool (StrSize (DnsCacheEntry.HostName));
+  if (NewDnsCache->DnsCache.HostName == NULL) {
+    FreePool (NewDnsCache);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  CopyMem (NewDnsCache->DnsCache.HostName, DnsCacheEntry.HostName, StrSize (DnsCacheEntry.HostName));
+
+  NewDnsCache->DnsCache.IpAddress = AllocatePool (sizeof (EFI_IPv4_ADDRESS));
+  if (NewDnsCache->DnsCache.IpAddress == NULL) {
+    FreePool (NewDnsCache->DnsCache.HostName);
+    FreePool (NewDnsCache);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  CopyMem (NewDnsCache->DnsCache.IpAddress, DnsCacheEntry.IpAddress, sizeof (EFI_IPv4_ADDRESS));
+
+  NewDnsCache->DnsCache.Timeout = DnsCacheEntry.Timeout;
+
+  InsertTailList (Dns4CacheList, &NewDnsCache->AllCacheLink);
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Update Dns6 cache to shared list of caches of all DNSv6 instances.
+
+  @param  Dns6CacheList      All Dns6 cache list.
+  @param  DeleteFlag         If FALSE, this function is to add one entry to the DNS Cache.
+                             If TRUE, this function will delete matching DNS Cache entry.
+  @param  Override           If TRUE, the matching DNS cache entry will be overwritten with the supplied parameter.
+                             If FALSE, EFI_ACCESS_DENIED will be returned if the entry to be added is already exists.
+  @param  DnsCacheEntry      Entry Pointer to DNS Cache entry.
+
+  @retval EFI_SUCCESS        Update Dns6 cache successfully.
+  @retval Others             Failed to update Dns6 cache.
+**/
+EFI_STATUS
+EFIAPI
+UpdateDns6Cache (
+  IN LIST_ENTRY            *Dns6CacheList,
+  IN BOOLEAN               DeleteFlag,
+  IN BOOLEAN               Override,
+  IN EFI_DNS6_CACHE_ENTRY  DnsCacheEntry
+  )
+{
+  DNS6_CACHE  *NewDnsCache;
+  DNS6_CACHE  *Item;
+  LIST_ENTRY  *Entry;
+  LIST_ENTRY  *Next;
+
+  NewDnsCache = NULL;
+  Item        = NULL;
+
+  //
+  // Search the database for the matching EFI_DNS_CACHE_ENTRY
+  //
+  NET_LIST_FOR_EACH_SAFE (Entry, Next, Dns6CacheList) {
+    Item = NET_LIST_USER_STRUCT (Entry, DNS6_CACHE, AllCacheLink);
+    if (DnsCacheMatchHostName (DnsCacheEntry.HostName, Item->DnsCache.HostName) && \
+        (CompareMem (DnsCacheEntry.IpAddress, Item->DnsCache.IpAddress, sizeof (EFI_IPv6_ADDRESS)) == 0))
+    {
+      //
+      // This is the Dns cache entry
+      //
+      if (DeleteFlag) {
+        //
+        // Delete matching DNS Cache entry
+        //
+        RemoveEntryList (&Item->AllCacheLink);
+
+        FreePool (Item->DnsCache.HostName);
+        FreePool (Item->DnsCache.IpAddress);
+        FreePool (Item);
+
+        return EFI_SUCCESS;
+      } else if (Override) {
+        //
+        // Update this one
+        //
+        Item->DnsCache.Timeout = DnsCacheEntry.Timeout;
+
+        return EFI_SUCCESS;
+      } else {
+        return EFI_ACCESS_DENIED;
+      }
+    }
+  }
+
+  //
+  // Add new one
+  //
+  NewDnsCache = AllocatePool (sizeof (DNS6_CACHE));
+  if (NewDnsCache == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  InitializeListHead (&NewDnsCache->AllCacheLink);
+
+  NewDnsCache->DnsCache.HostName = AllocatePool (StrSize (DnsCacheEntry.HostName));
+  if (NewDnsCache->DnsCache.HostName == NULL) {
+    FreePool (NewDnsCache);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  CopyMem (NewDnsCache->DnsCache.HostName, DnsCacheEntry.HostName, StrSize (DnsCacheEntry.HostName));
+
+  NewDnsCache->DnsCache.IpAddress = AllocatePool (sizeof (EFI_IPv6_ADDRESS));
+  if (NewDnsCache->DnsCache.IpAddress == NULL) {
+    FreePool (NewDnsCache->DnsCache.HostName);
+    FreePool (NewDnsCache);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  CopyMem (NewDnsCache->DnsCache.IpAddress, DnsCacheEntry.IpAddress, sizeof (EFI_IPv6_ADDRESS));
+
+  NewDnsCache->DnsCache.Timeout = DnsCacheEntry.Timeout;
+
+  InsertTailList (Dns6CacheList, &NewDnsCache->AllCacheLink);
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Look up the addresses of a host in the Dns4 cache.
+
+  @param  Dns4CacheList      All Dns4 cache list.
+  @param  HostName           The host name to look up.
+  @param  H2AData            On success, the addresses of the host. The caller is
+                             responsible to free H2AData and H2AData->IpList.
+
+  @retval EFI_SUCCESS        The addresses of the host are returned.
+  @retval EFI_NOT_FOUND      The cache has no address for the host.
+  @retval EFI_OUT_OF_RESOURCES  Failed to allocate memory.
+
+**/
+EFI_STATUS
+Dns4CacheLookup (
+  IN  LIST_ENTRY             *Dns4CacheList,
+  IN  CHAR16                 *HostName,
+  OUT DNS_HOST_TO_ADDR_DATA  **H2AData
+  )
+{
+  LIST_ENTRY  *Entry;
+  DNS4_CACHE  *Item;
+  UINT32      Index;
+
+  Index = 0;
+  NET_LIST_FOR_EACH (Entry, Dns4CacheList) {
+    Item = NET_LIST_USER_STRUCT (Entry, DNS4_CACHE, AllCacheLink);
+    if (DnsCacheMatchHostName (HostName, Item->DnsCache.HostName)) {
+      Index++;
+    }
+  }
+
+  if (Index == 0) {
+    return EFI_NOT_FOUND;
+  }
+
+  *H2AData = AllocatePool (sizeof (DNS_HOST_TO_ADDR_DATA));
+  if (*H2AData == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  (*H2AData)->IpCount = Index;
+  (*H2AData)->IpList  = AllocatePool (sizeof (EFI_IPv4_ADDRESS) * Index);
+  if ((*H2AData)->IpList == NULL) {
+    FreePool (*H2AData);
+    *H2AData = NULL;
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Index = 0;
+  NET_LIST_FOR_EACH (Entry, Dns4CacheList) {
+    Item = NET_LIST_USER_STRUCT (Entry, DNS4_CACHE, AllCacheLink);
+    if (DnsCacheMatchHostName (HostName, Item->DnsCache.HostName)) {
+      CopyMem ((*H2AData)->IpList + Index, Item->DnsCache.IpAddress, sizeof (EFI_IPv4_ADDRESS));
+      Index++;
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Look up the addresses of a host in the Dns6 cache.
+
+  @param  Dns6CacheList      All Dns6 cache list.
+  @param  HostName           The host name to look up.
+  @param  H2AData            On success, the addresses of the host. The caller is
+                             responsible to free H2AData and H2AData->IpList.
+
+  @retval EFI_SUCCESS        The addresses of the host are returned.
+  @retval EFI_NOT_FOUND      The cache has no address for the host.
+  @retval EFI_OUT_OF_RESOURCES  Failed to allocate memory.
+
+**/
+EFI_STATUS
+Dns6CacheLookup (
+  IN  LIST_ENTRY              *Dns6CacheList,
+  IN  CHAR16                  *HostName,
+  OUT DNS6_HOST_TO_ADDR_DATA  **H2AData
+  )
+{
+  LIST_ENTRY  *Entry;
+  DNS6_CACHE  *Item;
+  UINT32      Index;
+
+  Index = 0;
+  NET_LIST_FOR_EACH (Entry, Dns6CacheList) {
+    Item = NET_LIST_USER_STRUCT (Entry, DNS6_CACHE, AllCacheLink);
+    if (DnsCacheMatchHostName (HostName, Item->DnsCache.HostName)) {
+      Index++;
+    }
+  }
+
+  if (Index == 0) {
+    return EFI_NOT_FOUND;
+  }
+
+  *H2AData = AllocatePool (sizeof (DNS6_HOST_TO_ADDR_DATA));
+  if (*H2AData == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  (*H2AData)->IpCount = Index;
+  (*H2AData)->IpList  = AllocatePool (sizeof (EFI_IPv6_ADDRESS) * Index);
+  if ((*H2AData)->IpList == NULL) {
+    FreePool (*H2AData);
+    *H2AData = NULL;
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Index = 0;
+  NET_LIST_FOR_EACH (Entry, Dns6CacheList) {
+    Item = NET_LIST_USER_STRUCT (Entry, DNS6_CACHE, AllCacheLink);
+    if (DnsCacheMatchHostName (HostName, Item->DnsCache.HostName)) {
+      CopyMem ((*H2AData)->IpList + Index, Item->DnsCache.IpAddress, sizeof (EFI_IPv6_ADDRESS));
+      Index++;
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Age the entries of the Dns4 cache by one second and remove the expired ones.
+
+  @param  Dns4CacheList      All Dns4 cache list.
+
+  @return The number of entries removed.
+
+**/
+UINTN
+Dns4CacheAge (
+  IN LIST_ENTRY  *Dns4CacheList
+  )
+{
+  LIST_ENTRY  *Entry;
+  LIST_ENTRY  *Next;
+  DNS4_CACHE  *Item;
+  UINTN       Expired;
+
+  Expired = 0;
+
+  NET_LIST_FOR_EACH_SAFE (Entry, Next, Dns4CacheList) {
+    Item = NET_LIST_USER_STRUCT (Entry, DNS4_CACHE, AllCacheLink);
+    if (Item->DnsCache.Timeout > 1) {
+      Item->DnsCache.Timeout--;
+      continue;
+    }
+
+    RemoveEntryList (&Item->AllCacheLink);
+    FreePool (Item->DnsCache.HostName);
+    FreePool (Item->DnsCache.IpAddress);
+    FreePool (Item);
+    Expired++;
+  }
+
+  return Expired;
+}
+
+/**
+  Age the entries of the Dns6 cache by one second and remove the expired ones.
+
+  @param  Dns6CacheList      All Dns6 cache list.
+
+  @return The number of entries removed.
+
+**/
+UINTN
+Dns6CacheAge (
+  IN LIST_ENTRY  *Dns6CacheList
+  )
+{
+  LIST_ENTRY  *Entry;
+  LIST_ENTRY  *Next;
+  DNS6_CACHE  *Item;
+  UINTN       Expired;
+
+  Expired = 0;
+
+  NET_LIST_FOR_EACH_SAFE (Entry, Next, Dns6CacheList) {
+    Item = NET_LIST_USER_STRUCT (Entry, DNS6_CACHE, AllCacheLink);
+    if (Item->DnsCache.Timeout > 1) {
+      Item->DnsCache.Timeout--;
+      continue;
+    }
+
+    RemoveEntryList (&Item->AllCacheLink);
+    FreePool (Item->DnsCache.HostName);
+    FreePool (Item->DnsCache.IpAddress);
+    FreePool (Item);
+    Expired++;
+  }
+
+  return Expired;
+}
@@ -0,0 +1,55 @@
+/** @file
+  Implementation of the EDKII DNS Diagnostics Protocol.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "DnsImpl.h"
+
+/**
+  Get the counters of the DNS cache.
+
+  @param[in]  This                Pointer to the EDKII_DNS_DIAGNOSTICS_PROTOCOL instance.
+  @param[out] Statistics          Pointer to the buffer to receive the counters.
+
+  @retval EFI_SUCCESS             The counters are returned.
+  @retval EFI_INVALID_PARAMETER   This or Statistics is NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+DnsGetCacheStatistics (
+  IN  EDKII_DNS_DIAGNOSTICS_PROTOCOL  *This,
+  OUT EDKII_DNS_CACHE_STATISTICS      *Statistics
+  )
+{
+  LIST_ENTRY  *Entry;
+  EFI_TPL     OldTpl;
+
+  if ((This == NULL) || (Statistics == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  //
+  // The cache is updated at TPL_CALLBACK.
+  //
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+
+  CopyMem (Statistics, &mDriverData->Statistics, sizeof (EDKII_DNS_CACHE_STATISTICS));
+
+  Statistics->Dns4CacheEntries = 0;
+  NET_LIST_FOR_EACH (Entry, &mDriverData->Dns4CacheList) {
+    Statistics->Dns4CacheEntries++;
+  }
+
+  Statistics->Dns6CacheEntries = 0;
+  NET_LIST_FOR_EACH (Entry, &mDriverData->Dns6CacheList) {
+    Statistics->Dns6CacheEntries++;
+  }
+
+  gBS->RestoreTPL (OldTpl);
+
+  return EFI_SUCCESS;
+}
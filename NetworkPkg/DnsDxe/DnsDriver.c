@@ -36,6 +36,10 @@ EFI_SERVICE_BINDING_PROTOCOL  mDns6ServiceBinding = {
   Dns6ServiceBindingDestroyChild
 };
 
+EDKII_DNS_DIAGNOSTICS_PROTOCOL  mDnsDiagnostics = {
+  DnsGetCacheStatistics
+};
+
 DNS_DRIVER_DATA  *mDriverData = NULL;
 
 /**
@@ -362,6 +366,12 @@ DnsUnload (
     return Status;
   }
 
+  gBS->UninstallProtocolInterface (
+         ImageHandle,
+         &gEdkiiDnsDiagnosticsProtocolGuid,
+         &mDnsDiagnostics
+         );
+
   //
   // Free mDriverData.
   //
@@ -493,6 +503,16 @@ DnsDriverEntryPoint (
   InitializeListHead (&mDriverData->Dns6CacheList);
   InitializeListHead (&mDriverData->Dns6ServerList);
 
+  //
+  // Report the counters of the DNS cache. The cache works without it.
+  //
+  gBS->InstallProtocolInterface (
+         &ImageHandle,
+         &gEdkiiDnsDiagnosticsProtocolGuid,
+         EFI_NATIVE_INTERFACE,
+         &mDnsDiagnostics
+         );
+
   return Status;
 
 Error4:
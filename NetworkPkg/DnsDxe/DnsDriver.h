@@ -32,13 +32,18 @@ typedef struct _DNS_INSTANCE DNS_INSTANCE;
 #define DNS_INSTANCE_SIGNATURE  SIGNATURE_32 ('D', 'N', 'S', 'I')
 
 struct _DNS_DRIVER_DATA {
-  EFI_EVENT     Timer;                 /// Ticking timer for DNS cache update.
+  EFI_EVENT                     Timer; /// Ticking timer for DNS cache update.
 
-  LIST_ENTRY    Dns4CacheList;
-  LIST_ENTRY    Dns4ServerList;
+  LIST_ENTRY                    Dns4CacheList;
+  LIST_ENTRY                    Dns4ServerList;
 
-  LIST_ENTRY    Dns6CacheList;
-  LIST_ENTRY    Dns6ServerList;
+  LIST_ENTRY                    Dns6CacheList;
+  LIST_ENTRY                    Dns6ServerList;
+
+  ///
+  /// Counters reported by the DNS Diagnostics Protocol.
+  ///
+  EDKII_DNS_CACHE_STATISTICS    Statistics;
 };
 
 struct _DNS_SERVICE {
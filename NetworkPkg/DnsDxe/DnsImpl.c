@@ -743,205 +743,6 @@ Dns6ConfigUdp (
   return Status;
 }
 
-/**
-  Update Dns4 cache to shared list of caches of all DNSv4 instances.
-
-  @param  Dns4CacheList      All Dns4 cache list.
-  @param  DeleteFlag         If FALSE, this function is to add one entry to the DNS Cache.
-                             If TRUE, this function will delete matching DNS Cache entry.
-  @param  Override           If TRUE, the matching DNS cache entry will be overwritten with the supplied parameter.
-                             If FALSE, EFI_ACCESS_DENIED will be returned if the entry to be added is already exists.
-  @param  DnsCacheEntry      Entry Pointer to DNS Cache entry.
-
-  @retval EFI_SUCCESS        Update Dns4 cache successfully.
-  @retval Others             Failed to update Dns4 cache.
-
-**/
-EFI_STATUS
-EFIAPI
-UpdateDns4Cache (
-  IN LIST_ENTRY            *Dns4CacheList,
-  IN BOOLEAN               DeleteFlag,
-  IN BOOLEAN               Override,
-  IN EFI_DNS4_CACHE_ENTRY  DnsCacheEntry
-  )
-{
-  DNS4_CACHE  *NewDnsCache;
-  DNS4_CACHE  *Item;
-  LIST_ENTRY  *Entry;
-  LIST_ENTRY  *Next;
-
-  NewDnsCache = NULL;
-  Item        = NULL;
-
-  //
-  // Search the database for the matching EFI_DNS_CACHE_ENTRY
-  //
-  NET_LIST_FOR_EACH_SAFE (Entry, Next, Dns4CacheList) {
-    Item = NET_LIST_USER_STRUCT (Entry, DNS4_CACHE, AllCacheLink);
-    if ((StrCmp (DnsCacheEntry.HostName, Item->DnsCache.HostName) == 0) && \
-        (CompareMem (DnsCacheEntry.IpAddress, Item->DnsCache.IpAddress, sizeof (EFI_IPv4_ADDRESS)) == 0))
-    {
-      //
-      // This is the Dns cache entry
-      //
-      if (DeleteFlag) {
-        //
-        // Delete matching DNS Cache entry
-        //
-        RemoveEntryList (&Item->AllCacheLink);
-
-        FreePool (Item->DnsCache.HostName);
-        FreePool (Item->DnsCache.IpAddress);
-        FreePool (Item);
-
-        return EFI_SUCCESS;
-      } else if (Override) {
-        //
-        // Update this one
-        //
-        Item->DnsCache.Timeout = DnsCacheEntry.Timeout;
-
-        return EFI_SUCCESS;
-      } else {
-        return EFI_ACCESS_DENIED;
-      }
-    }
-  }
-
-  //
-  // Add new one
-  //
-  NewDnsCache = AllocatePool (sizeof (DNS4_CACHE));
-  if (NewDnsCache == NULL) {
-    return EFI_OUT_OF_RESOURCES;
-  }
-
-  InitializeListHead (&NewDnsCache->AllCacheLink);
-
-  NewDnsCache->DnsCache.HostName = AllocatePool (StrSize (DnsCacheEntry.HostName));
-  if (NewDnsCache->DnsCache.HostName == NULL) {
-    FreePool (NewDnsCache);
-    return EFI_OUT_OF_RESOURCES;
-  }
-
-  CopyMem (NewDnsCache->DnsCache.HostName, DnsCacheEntry.HostName, StrSize (DnsCacheEntry.HostName));
-
-  NewDnsCache->DnsCache.IpAddress = AllocatePool (sizeof (EFI_IPv4_ADDRESS));
-  if (NewDnsCache->DnsCache.IpAddress == NULL) {
-    FreePool (NewDnsCache->DnsCache.HostName);
-    FreePool (NewDnsCache);
-    return EFI_OUT_OF_RESOURCES;
-  }
-
-  CopyMem (NewDnsCache->DnsCache.IpAddress, DnsCacheEntry.IpAddress, sizeof (EFI_IPv4_ADDRESS));
-
-  NewDnsCache->DnsCache.Timeout = DnsCacheEntry.Timeout;
-
-  InsertTailList (Dns4CacheList, &NewDnsCache->AllCacheLink);
-
-  return EFI_SUCCESS;
-}
-
-/**
-  Update Dns6 cache to shared list of caches of all DNSv6 instances.
-
-  @param  Dns6CacheList      All Dns6 cache list.
-  @param  DeleteFlag         If FALSE, this function is to add one entry to the DNS Cache.
-                             If TRUE, this function will delete matching DNS Cache entry.
-  @param  Override           If TRUE, the matching DNS cache entry will be overwritten with the supplied parameter.
-                             If FALSE, EFI_ACCESS_DENIED will be returned if the entry to be added is already exists.
-  @param  DnsCacheEntry      Entry Pointer to DNS Cache entry.
-
-  @retval EFI_SUCCESS        Update Dns6 cache successfully.
-  @retval Others             Failed to update Dns6 cache.
-**/
-EFI_STATUS
-EFIAPI
-UpdateDns6Cache (
-  IN LIST_ENTRY            *Dns6CacheList,
-  IN BOOLEAN               DeleteFlag,
-  IN BOOLEAN               Override,
-  IN EFI_DNS6_CACHE_ENTRY  DnsCacheEntry
-  )
-{
-  DNS6_CACHE  *NewDnsCache;
-  DNS6_CACHE  *Item;
-  LIST_ENTRY  *Entry;
-  LIST_ENTRY  *Next;
-
-  NewDnsCache = NULL;
-  Item        = NULL;
-
-  //
-  // Search the database for the matching EFI_DNS_CACHE_ENTRY
-  //
-  NET_LIST_FOR_EACH_SAFE (Entry, Next, Dns6CacheList) {
-    Item = NET_LIST_USER_STRUCT (Entry, DNS6_CACHE, AllCacheLink);
-    if ((StrCmp (DnsCacheEntry.HostName, Item->DnsCache.HostName) == 0) && \
-        (CompareMem (DnsCacheEntry.IpAddress, Item->DnsCache.IpAddress, sizeof (EFI_IPv6_ADDRESS)) == 0))
-    {
-      //
-      // This is the Dns cache entry
-      //
-      if (DeleteFlag) {
-        //
-        // Delete matching DNS Cache entry
-        //
-        RemoveEntryList (&Item->AllCacheLink);
-
-        FreePool (Item->DnsCache.HostName);
-        FreePool (Item->DnsCache.IpAddress);
-        FreePool (Item);
-
-        return EFI_SUCCESS;
-      } else if (Override) {
-        //
-        // Update this one
-        //
-        Item->DnsCache.Timeout = DnsCacheEntry.Timeout;
-
-        return EFI_SUCCESS;
-      } else {
-        return EFI_ACCESS_DENIED;
-      }
-    }
-  }
-
-  //
-  // Add new one
-  //
-  NewDnsCache = AllocatePool (sizeof (DNS6_CACHE));
-  if (NewDnsCache == NULL) {
-    return EFI_OUT_OF_RESOURCES;
-  }
-
-  InitializeListHead (&NewDnsCache->AllCacheLink);
-
-  NewDnsCache->DnsCache.HostName = AllocatePool (StrSize (DnsCacheEntry.HostName));
-  if (NewDnsCache->DnsCache.HostName == NULL) {
-    FreePool (NewDnsCache);
-    return EFI_OUT_OF_RESOURCES;
-  }
-
-  CopyMem (NewDnsCache->DnsCache.HostName, DnsCacheEntry.HostName, StrSize (DnsCacheEntry.HostName));
-
-  NewDnsCache->DnsCache.IpAddress = AllocatePool (sizeof (EFI_IPv6_ADDRESS));
-  if (NewDnsCache->DnsCache.IpAddress == NULL) {
-    FreePool (NewDnsCache->DnsCache.HostName);
-    FreePool (NewDnsCache);
-    return EFI_OUT_OF_RESOURCES;
-  }
-
-  CopyMem (NewDnsCache->DnsCache.IpAddress, DnsCacheEntry.IpAddress, sizeof (EFI_IPv6_ADDRESS));
-
-  NewDnsCache->DnsCache.Timeout = DnsCacheEntry.Timeout;
-
-  InsertTailList (Dns6CacheList, &NewDnsCache->AllCacheLink);
-
-  return EFI_SUCCESS;
-}
-
 /**
   Add Dns4 ServerIp to common list of addresses of all configured DNSv4 server.
 
@@ -1142,10 +943,11 @@ ParseDnsResponse (
   DNS4_TOKEN_ENTRY  *Dns4TokenEntry;
   DNS6_TOKEN_ENTRY  *Dns6TokenEntry;
 
-  UINT32  IpCount;
-  UINT32  RRCount;
-  UINT32  AnswerSectionNum;
-  UINT32  CNameTtl;
+  UINT32   IpCount;
+  UINT32   RRCount;
+  UINT32   AnswerSectionNum;
+  UINT32   CNameTtl;
+  BOOLEAN  CNameFound;
 
   EFI_IPv4_ADDRESS  *HostAddr4;
   EFI_IPv6_ADDRESS  *HostAddr6;
@@ -1169,6 +971,7 @@ ParseDnsResponse (
   RRCount          = 0;
   AnswerSectionNum = 0;
   CNameTtl         = 0;
+  CNameFound       = FALSE;
 
   HostAddr4 = NULL;
   HostAddr6 = NULL;
@@ -1417,6 +1220,13 @@ ParseDnsResponse (
     AnswerSection->Ttl        = NTOHL (AnswerSection->Ttl);
     AnswerSection->DataLength = NTOHS (AnswerSection->DataLength);
 
+    //
+    // A TTL with the most significant bit set is treated as zero (RFC 2181).
+    //
+    if (AnswerSection->Ttl > MAX_INT32) {
+      AnswerSection->Ttl = 0;
+    }
+
     //
     // Check whether the remaining packet length is available or not.
     //
@@ -1532,13 +1342,21 @@ ParseDnsResponse (
 
           CopyMem (Dns4CacheEntry->IpAddress, AnswerData, sizeof (EFI_IPv4_ADDRESS));
 
-          if ((CNameTtl != 0) && (AnswerSection->Ttl != 0)) {
+          //
+          // The address is only valid as long as the alias that led to it.
+          //
+          if (CNameFound) {
             Dns4CacheEntry->Timeout = MIN (CNameTtl, AnswerSection->Ttl);
           } else {
-            Dns4CacheEntry->Timeout = MAX (CNameTtl, AnswerSection->Ttl);
+            Dns4CacheEntry->Timeout = AnswerSection->Ttl;
           }
 
-          UpdateDns4Cache (&mDriverData->Dns4CacheList, FALSE, TRUE, *Dns4CacheEntry);
+          //
+          // An answer with a zero TTL is only valid for this query.
+          //
+          if (Dns4CacheEntry->Timeout != 0) {
+            UpdateDns4Cache (&mDriverData->Dns4CacheList, FALSE, TRUE, *Dns4CacheEntry);
+          }
 
           //
           // Free allocated CacheEntry pool.
@@ -1594,13 +1412,21 @@ ParseDnsResponse (
 
           CopyMem (Dns6CacheEntry->IpAddress, AnswerData, sizeof (EFI_IPv6_ADDRESS));
 
-          if ((CNameTtl != 0) && (AnswerSection->Ttl != 0)) {
+          //
+          // The address is only valid as long as the alias that led to it.
+          //
+          if (CNameFound) {
             Dns6CacheEntry->Timeout = MIN (CNameTtl, AnswerSection->Ttl);
           } else {
-            Dns6CacheEntry->Timeout = MAX (CNameTtl, AnswerSection->Ttl);
+            Dns6CacheEntry->Timeout = AnswerSection->Ttl;
           }
 
-          UpdateDns6Cache (&mDriverData->Dns6CacheList, FALSE, TRUE, *Dns6CacheEntry);
+          //
+          // An answer with a zero TTL is only valid for this query.
+          //
+          if (Dns6CacheEntry->Timeout != 0) {
+            UpdateDns6Cache (&mDriverData->Dns6CacheList, FALSE, TRUE, *Dns6CacheEntry);
+          }
 
           //
           // Free allocated CacheEntry pool.
@@ -1623,7 +1449,10 @@ ParseDnsResponse (
           // record in the response and restart the query at the domain name specified in the data field of the
           // CNAME record. So, just record the TTL value of the CNAME, then skip to parse the next record.
           //
-          CNameTtl = AnswerSection->Ttl;
+          // A chain of aliases is only valid as long as its shortest-lived link.
+          //
+          CNameTtl   = CNameFound ? MIN (CNameTtl, AnswerSection->Ttl) : AnswerSection->Ttl;
+          CNameFound = TRUE;
           break;
         default:
           Status = EFI_UNSUPPORTED;
@@ -2221,55 +2050,6 @@ DnsOnTimerUpdate (
   IN VOID       *Context
   )
 {
-  LIST_ENTRY  *Entry;
-  LIST_ENTRY  *Next;
-  DNS4_CACHE  *Item4;
-  DNS6_CACHE  *Item6;
-
-  Item4 = NULL;
-  Item6 = NULL;
-
-  //
-  // Iterate through all the DNS4 cache list.
-  //
-  NET_LIST_FOR_EACH_SAFE (Entry, Next, &mDriverData->Dns4CacheList) {
-    Item4 = NET_LIST_USER_STRUCT (Entry, DNS4_CACHE, AllCacheLink);
-    Item4->DnsCache.Timeout--;
-  }
-
-  Entry = mDriverData->Dns4CacheList.ForwardLink;
-  while (Entry != &mDriverData->Dns4CacheList) {
-    Item4 = NET_LIST_USER_STRUCT (Entry, DNS4_CACHE, AllCacheLink);
-    if (Item4->DnsCache.Timeout == 0) {
-      RemoveEntryList (&Item4->AllCacheLink);
-      FreePool (Item4->DnsCache.HostName);
-      FreePool (Item4->DnsCache.IpAddress);
-      FreePool (Item4);
-      Entry = mDriverData->Dns4CacheList.ForwardLink;
-    } else {
-      Entry = Entry->ForwardLink;
-    }
-  }
-
-  //
-  // Iterate through all the DNS6 cache list.
-  //
-  NET_LIST_FOR_EACH_SAFE (Entry, Next, &mDriverData->Dns6CacheList) {
-    Item6 = NET_LIST_USER_STRUCT (Entry, DNS6_CACHE, AllCacheLink);
-    Item6->DnsCache.Timeout--;
-  }
-
-  Entry = mDriverData->Dns6CacheList.ForwardLink;
-  while (Entry != &mDriverData->Dns6CacheList) {
-    Item6 = NET_LIST_USER_STRUCT (Entry, DNS6_CACHE, AllCacheLink);
-    if (Item6->DnsCache.Timeout == 0) {
-      RemoveEntryList (&Item6->AllCacheLink);
-      FreePool (Item6->DnsCache.HostName);
-      FreePool (Item6->DnsCache.IpAddress);
-      FreePool (Item6);
-      Entry = mDriverData->Dns6CacheList.ForwardLink;
-    } else {
-      Entry = Entry->ForwardLink;
-    }
-  }
+  mDriverData->Statistics.ExpiredEntries += Dns4CacheAge (&mDriverData->Dns4CacheList);
+  mDriverData->Statistics.ExpiredEntries += Dns6CacheAge (&mDriverData->Dns6CacheList);
 }
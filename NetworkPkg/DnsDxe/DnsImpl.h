@@ -44,6 +44,8 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include <Protocol/Ip4Config2.h>
 
+#include <Protocol/DnsDiagnostics.h>
+
 #include "DnsDriver.h"
 #include "DnsDhcp.h"
 
@@ -67,6 +69,8 @@ extern EFI_DRIVER_BINDING_PROTOCOL   gDns6DriverBinding;
 extern EFI_SERVICE_BINDING_PROTOCOL  mDns6ServiceBinding;
 extern EFI_DNS6_PROTOCOL             mDns6Protocol;
 
+extern EDKII_DNS_DIAGNOSTICS_PROTOCOL  mDnsDiagnostics;
+
 //
 // DNS related
 //
@@ -515,6 +519,89 @@ UpdateDns6Cache (
   IN EFI_DNS6_CACHE_ENTRY  DnsCacheEntry
   );
 
+/**
+  Look up the addresses of a host in the Dns4 cache.
+
+  @param  Dns4CacheList      All Dns4 cache list.
+  @param  HostName           The host name to look up.
+  @param  H2AData            On success, the addresses of the host. The caller is
+                             responsible to free H2AData and H2AData->IpList.
+
+  @retval EFI_SUCCESS        The addresses of the host are returned.
+  @retval EFI_NOT_FOUND      The cache has no address for the host.
+  @retval EFI_OUT_OF_RESOURCES  Failed to allocate memory.
+
+**/
+EFI_STATUS
+Dns4CacheLookup (
+  IN  LIST_ENTRY             *Dns4CacheList,
+  IN  CHAR16                 *HostName,
+  OUT DNS_HOST_TO_ADDR_DATA  **H2AData
+  );
+
+/**
+  Look up the addresses of a host in the Dns6 cache.
+
+  @param  Dns6CacheList      All Dns6 cache list.
+  @param  HostName           The host name to look up.
+  @param  H2AData            On success, the addresses of the host. The caller is
+                             responsible to free H2AData and H2AData->IpList.
+
+  @retval EFI_SUCCESS        The addresses of the host are returned.
+  @retval EFI_NOT_FOUND      The cache has no address for the host.
+  @retval EFI_OUT_OF_RESOURCES  Failed to allocate memory.
+
+**/
+EFI_STATUS
+Dns6CacheLookup (
+  IN  LIST_ENTRY              *Dns6CacheList,
+  IN  CHAR16                  *HostName,
+  OUT DNS6_HOST_TO_ADDR_DATA  **H2AData
+  );
+
+/**
+  Age the entries of the Dns4 cache by one second and remove the expired ones.
+
+  @param  Dns4CacheList      All Dns4 cache list.
+
+  @return The number of entries removed.
+
+**/
+UINTN
+Dns4CacheAge (
+  IN LIST_ENTRY  *Dns4CacheList
+  );
+
+/**
+  Age the entries of the Dns6 cache by one second and remove the expired ones.
+
+  @param  Dns6CacheList      All Dns6 cache list.
+
+  @return The number of entries removed.
+
+**/
+UINTN
+Dns6CacheAge (
+  IN LIST_ENTRY  *Dns6CacheList
+  );
+
+/**
+  Get the counters of the DNS cache.
+
+  @param[in]  This                Pointer to the EDKII_DNS_DIAGNOSTICS_PROTOCOL instance.
+  @param[out] Statistics          Pointer to the buffer to receive the counters.
+
+  @retval EFI_SUCCESS             The counters are returned.
+  @retval EFI_INVALID_PARAMETER   This or Statistics is NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+DnsGetCacheStatistics (
+  IN  EDKII_DNS_DIAGNOSTICS_PROTOCOL  *This,
+  OUT EDKII_DNS_CACHE_STATISTICS      *Statistics
+  );
+
 /**
   Add Dns4 ServerIp to common list of addresses of all configured DNSv4 server.
 
@@ -342,11 +342,6 @@ Dns4HostNameToIp (
 
   EFI_DNS4_CONFIG_DATA  *ConfigData;
 
-  UINTN       Index;
-  DNS4_CACHE  *Item;
-  LIST_ENTRY  *Entry;
-  LIST_ENTRY  *Next;
-
   CHAR8  *QueryName;
 
   DNS4_TOKEN_ENTRY  *TokenEntry;
@@ -355,7 +350,6 @@ Dns4HostNameToIp (
   EFI_TPL  OldTpl;
 
   Status     = EFI_SUCCESS;
-  Item       = NULL;
   QueryName  = NULL;
   TokenEntry = NULL;
   Packet     = NULL;
@@ -405,40 +399,13 @@ Dns4HostNameToIp (
   // Check cache
   //
   if (ConfigData->EnableDnsCache) {
-    Index = 0;
-    NET_LIST_FOR_EACH_SAFE (Entry, Next, &mDriverData->Dns4CacheList) {
-      Item = NET_LIST_USER_STRUCT (Entry, DNS4_CACHE, AllCacheLink);
-      if (StrCmp (HostName, Item->DnsCache.HostName) == 0) {
-        Index++;
-      }
+    Status = Dns4CacheLookup (&mDriverData->Dns4CacheList, HostName, &Token->RspData.H2AData);
+    if (Status == EFI_OUT_OF_RESOURCES) {
+      goto ON_EXIT;
     }
 
-    if (Index != 0) {
-      Token->RspData.H2AData = AllocatePool (sizeof (DNS_HOST_TO_ADDR_DATA));
-      if (Token->RspData.H2AData == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        goto ON_EXIT;
-      }
-
-      Token->RspData.H2AData->IpCount = (UINT32)Index;
-      Token->RspData.H2AData->IpList  = AllocatePool (sizeof (EFI_IPv4_ADDRESS) * Index);
-      if (Token->RspData.H2AData->IpList == NULL) {
-        if (Token->RspData.H2AData != NULL) {
-          FreePool (Token->RspData.H2AData);
-        }
-
-        Status = EFI_OUT_OF_RESOURCES;
-        goto ON_EXIT;
-      }
-
-      Index = 0;
-      NET_LIST_FOR_EACH_SAFE (Entry, Next, &mDriverData->Dns4CacheList) {
-        Item = NET_LIST_USER_STRUCT (Entry, DNS4_CACHE, AllCacheLink);
-        if (((UINT32)Index < Token->RspData.H2AData->IpCount) && (StrCmp (HostName, Item->DnsCache.HostName) == 0)) {
-          CopyMem ((Token->RspData.H2AData->IpList) + Index, Item->DnsCache.IpAddress, sizeof (EFI_IPv4_ADDRESS));
-          Index++;
-        }
-      }
+    if (!EFI_ERROR (Status)) {
+      mDriverData->Statistics.Dns4CacheHits++;
 
       Token->Status = EFI_SUCCESS;
 
@@ -450,6 +417,8 @@ Dns4HostNameToIp (
       Status = Token->Status;
       goto ON_EXIT;
     }
+
+    mDriverData->Statistics.Dns4CacheMisses++;
   }
 
   //
@@ -1188,11 +1157,6 @@ Dns6HostNameToIp (
 
   EFI_DNS6_CONFIG_DATA  *ConfigData;
 
-  UINTN       Index;
-  DNS6_CACHE  *Item;
-  LIST_ENTRY  *Entry;
-  LIST_ENTRY  *Next;
-
   CHAR8  *QueryName;
 
   DNS6_TOKEN_ENTRY  *TokenEntry;
@@ -1201,7 +1165,6 @@ Dns6HostNameToIp (
   EFI_TPL  OldTpl;
 
   Status     = EFI_SUCCESS;
-  Item       = NULL;
   QueryName  = NULL;
   TokenEntry = NULL;
   Packet     = NULL;
@@ -1251,40 +1214,13 @@ Dns6HostNameToIp (
   // Check cache
   //
   if (ConfigData->EnableDnsCache) {
-    Index = 0;
-    NET_LIST_FOR_EACH_SAFE (Entry, Next, &mDriverData->Dns6CacheList) {
-      Item = NET_LIST_USER_STRUCT (Entry, DNS6_CACHE, AllCacheLink);
-      if (StrCmp (HostName, Item->DnsCache.HostName) == 0) {
-        Index++;
-      }
+    Status = Dns6CacheLookup (&mDriverData->Dns6CacheList, HostName, &Token->RspData.H2AData);
+    if (Status == EFI_OUT_OF_RESOURCES) {
+      goto ON_EXIT;
     }
 
-    if (Index != 0) {
-      Token->RspData.H2AData = AllocatePool (sizeof (DNS6_HOST_TO_ADDR_DATA));
-      if (Token->RspData.H2AData == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        goto ON_EXIT;
-      }
-
-      Token->RspData.H2AData->IpCount = (UINT32)Index;
-      Token->RspData.H2AData->IpList  = AllocatePool (sizeof (EFI_IPv6_ADDRESS) * Index);
-      if (Token->RspData.H2AData->IpList == NULL) {
-        if (Token->RspData.H2AData != NULL) {
-          FreePool (Token->RspData.H2AData);
-        }
-
-        Status = EFI_OUT_OF_RESOURCES;
-        goto ON_EXIT;
-      }
-
-      Index = 0;
-      NET_LIST_FOR_EACH_SAFE (Entry, Next, &mDriverData->Dns6CacheList) {
-        Item = NET_LIST_USER_STRUCT (Entry, DNS6_CACHE, AllCacheLink);
-        if (((UINT32)Index < Token->RspData.H2AData->IpCount) && (StrCmp (HostName, Item->DnsCache.HostName) == 0)) {
-          CopyMem ((Token->RspData.H2AData->IpList) + Index, Item->DnsCache.IpAddress, sizeof (EFI_IPv6_ADDRESS));
-          Index++;
-        }
-      }
+    if (!EFI_ERROR (Status)) {
+      mDriverData->Statistics.Dns6CacheHits++;
 
       Token->Status = EFI_SUCCESS;
 
@@ -1296,6 +1232,8 @@ Dns6HostNameToIp (
       Status = Token->Status;
       goto ON_EXIT;
     }
+
+    mDriverData->Statistics.Dns6CacheMisses++;
   }
 
   //
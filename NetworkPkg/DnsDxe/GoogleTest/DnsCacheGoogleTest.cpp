@@ -0,0 +1,233 @@
+/** @file
+  Tests for the DNS cache in DnsCache.c.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <gtest/gtest.h>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/BaseMemoryLib.h>
+  #include <Library/MemoryAllocationLib.h>
+  #include "../DnsImpl.h"
+}
+
+////////////////////////////////////////////////////////////////////////
+// Dns4Cache Tests
+////////////////////////////////////////////////////////////////////////
+
+class Dns4CacheTest : public ::testing::Test {
+protected:
+  LIST_ENTRY        CacheList;
+  EFI_IPv4_ADDRESS  Address1;
+  EFI_IPv4_ADDRESS  Address2;
+
+  virtual void
+  SetUp (
+    )
+  {
+    InitializeListHead (&CacheList);
+    EFI_IP4 (Address1) = 0x0100000A;
+    EFI_IP4 (Address2) = 0x0200000A;
+  }
+
+  virtual void
+  TearDown (
+    )
+  {
+    //
+    // A zero timeout removes every entry on the next aging.
+    //
+    while (!IsListEmpty (&CacheList)) {
+      NET_LIST_USER_STRUCT (CacheList.ForwardLink, DNS4_CACHE, AllCacheLink)->DnsCache.Timeout = 0;
+      Dns4CacheAge (&CacheList);
+    }
+  }
+
+  EFI_STATUS
+  Add (
+    CHAR16            *HostName,
+    EFI_IPv4_ADDRESS  *Address,
+    UINT32            Timeout
+    )
+  {
+    EFI_DNS4_CACHE_ENTRY  Entry;
+
+    Entry.HostName  = HostName;
+    Entry.IpAddress = Address;
+    Entry.Timeout   = Timeout;
+    return UpdateDns4Cache (&CacheList, FALSE, TRUE, Entry);
+  }
+};
+
+// Test Description:
+// A cached host is found regardless of the case of its name.
+TEST_F (Dns4CacheTest, LookupIgnoresCase) {
+  DNS_HOST_TO_ADDR_DATA  *H2AData;
+
+  ASSERT_EQ (Add ((CHAR16 *)L"boot.example.com", &Address1, 60), EFI_SUCCESS);
+  ASSERT_EQ (Dns4CacheLookup (&CacheList, (CHAR16 *)L"Boot.EXAMPLE.com", &H2AData), EFI_SUCCESS);
+  ASSERT_EQ (H2AData->IpCount, 1U);
+  EXPECT_EQ (EFI_IP4 (H2AData->IpList[0]), EFI_IP4 (Address1));
+
+  FreePool (H2AData->IpList);
+  FreePool (H2AData);
+}
+
+// Test Description:
+// All the addresses of a host are returned, and other hosts miss.
+TEST_F (Dns4CacheTest, LookupReturnsAllAddresses) {
+  DNS_HOST_TO_ADDR_DATA  *H2AData;
+
+  ASSERT_EQ (Add ((CHAR16 *)L"boot.example.com", &Address1, 60), EFI_SUCCESS);
+  ASSERT_EQ (Add ((CHAR16 *)L"boot.example.com", &Address2, 60), EFI_SUCCESS);
+  ASSERT_EQ (Dns4CacheLookup (&CacheList, (CHAR16 *)L"boot.example.com", &H2AData), EFI_SUCCESS);
+  ASSERT_EQ (H2AData->IpCount, 2U);
+  EXPECT_EQ (EFI_IP4 (H2AData->IpList[0]), EFI_IP4 (Address1));
+  EXPECT_EQ (EFI_IP4 (H2AData->IpList[1]), EFI_IP4 (Address2));
+
+  FreePool (H2AData->IpList);
+  FreePool (H2AData);
+
+  EXPECT_EQ (Dns4CacheLookup (&CacheList, (CHAR16 *)L"boot.example.org", &H2AData), EFI_NOT_FOUND);
+  EXPECT_EQ (Dns4CacheLookup (&CacheList, (CHAR16 *)L"boot.example.co", &H2AData), EFI_NOT_FOUND);
+}
+
+// Test Description:
+// Overriding a cached address refreshes its timeout instead of adding a duplicate.
+TEST_F (Dns4CacheTest, OverrideRefreshesTimeout) {
+  ASSERT_EQ (Add ((CHAR16 *)L"boot.example.com", &Address1, 1), EFI_SUCCESS);
+  ASSERT_EQ (Add ((CHAR16 *)L"BOOT.example.com", &Address1, 3), EFI_SUCCESS);
+
+  EXPECT_EQ (Dns4CacheAge (&CacheList), 0U);
+  EXPECT_EQ (Dns4CacheAge (&CacheList), 0U);
+  EXPECT_EQ (Dns4CacheAge (&CacheList), 1U);
+  EXPECT_TRUE (IsListEmpty (&CacheList));
+}
+
+// Test Description:
+// An entry lives for exactly its timeout in seconds.
+TEST_F (Dns4CacheTest, AgeRemovesExpiredEntries) {
+  DNS_HOST_TO_ADDR_DATA  *H2AData;
+
+  ASSERT_EQ (Add ((CHAR16 *)L"boot.example.com", &Address1, 2), EFI_SUCCESS);
+  ASSERT_EQ (Add ((CHAR16 *)L"boot.example.com", &Address2, 5), EFI_SUCCESS);
+
+  EXPECT_EQ (Dns4CacheAge (&CacheList), 0U);
+  EXPECT_EQ (Dns4CacheAge (&CacheList), 1U);
+
+  ASSERT_EQ (Dns4CacheLookup (&CacheList, (CHAR16 *)L"boot.example.com", &H2AData), EFI_SUCCESS);
+  ASSERT_EQ (H2AData->IpCount, 1U);
+  EXPECT_EQ (EFI_IP4 (H2AData->IpList[0]), EFI_IP4 (Address2));
+
+  FreePool (H2AData->IpList);
+  FreePool (H2AData);
+}
+
+// Test Description:
+// An entry with a zero timeout must not wrap around and live forever.
+TEST_F (Dns4CacheTest, AgeRemovesZeroTimeout) {
+  DNS_HOST_TO_ADDR_DATA  *H2AData;
+
+  ASSERT_EQ (Add ((CHAR16 *)L"boot.example.com", &Address1, 0), EFI_SUCCESS);
+
+  EXPECT_EQ (Dns4CacheAge (&CacheList), 1U);
+  EXPECT_EQ (Dns4CacheLookup (&CacheList, (CHAR16 *)L"boot.example.com", &H2AData), EFI_NOT_FOUND);
+}
+
+////////////////////////////////////////////////////////////////////////
+// Dns6Cache Tests
+////////////////////////////////////////////////////////////////////////
+
+class Dns6CacheTest : public ::testing::Test {
+protected:
+  LIST_ENTRY        CacheList;
+  EFI_IPv6_ADDRESS  Address1;
+  EFI_IPv6_ADDRESS  Address2;
+
+  virtual void
+  SetUp (
+    )
+  {
+    InitializeListHead (&CacheList);
+    ZeroMem (&Address1, sizeof (Address1));
+    ZeroMem (&Address2, sizeof (Address2));
+    Address1.Addr[0]  = 0xFD;
+    Address1.Addr[15] = 0x01;
+    Address2.Addr[0]  = 0xFD;
+    Address2.Addr[15] = 0x02;
+  }
+
+  virtual void
+  TearDown (
+    )
+  {
+    while (!IsListEmpty (&CacheList)) {
+      NET_LIST_USER_STRUCT (CacheList.ForwardLink, DNS6_CACHE, AllCacheLink)->DnsCache.Timeout = 0;
+      Dns6CacheAge (&CacheList);
+    }
+  }
+
+  EFI_STATUS
+  Add (
+    CHAR16            *HostName,
+    EFI_IPv6_ADDRESS  *Address,
+    UINT32            Timeout
+    )
+  {
+    EFI_DNS6_CACHE_ENTRY  Entry;
+
+    Entry.HostName  = HostName;
+    Entry.IpAddress = Address;
+    Entry.Timeout   = Timeout;
+    return UpdateDns6Cache (&CacheList, FALSE, TRUE, Entry);
+  }
+};
+
+// Test Description:
+// A cached host is found regardless of the case of its name.
+TEST_F (Dns6CacheTest, LookupIgnoresCase) {
+  DNS6_HOST_TO_ADDR_DATA  *H2AData;
+
+  ASSERT_EQ (Add ((CHAR16 *)L"boot.example.com", &Address1, 60), EFI_SUCCESS);
+  ASSERT_EQ (Dns6CacheLookup (&CacheList, (CHAR16 *)L"BOOT.example.COM", &H2AData), EFI_SUCCESS);
+  ASSERT_EQ (H2AData->IpCount, 1U);
+  EXPECT_EQ (CompareMem (&H2AData->IpList[0], &Address1, sizeof (Address1)), 0);
+
+  FreePool (H2AData->IpList);
+  FreePool (H2AData);
+
+  EXPECT_EQ (Dns6CacheLookup (&CacheList, (CHAR16 *)L"boot.example.org", &H2AData), EFI_NOT_FOUND);
+}
+
+// Test Description:
+// An entry lives for exactly its timeout in seconds.
+TEST_F (Dns6CacheTest, AgeRemovesExpiredEntries) {
+  DNS6_HOST_TO_ADDR_DATA  *H2AData;
+
+  ASSERT_EQ (Add ((CHAR16 *)L"boot.example.com", &Address1, 2), EFI_SUCCESS);
+  ASSERT_EQ (Add ((CHAR16 *)L"boot.example.com", &Address2, 5), EFI_SUCCESS);
+
+  EXPECT_EQ (Dns6CacheAge (&CacheList), 0U);
+  EXPECT_EQ (Dns6CacheAge (&CacheList), 1U);
+
+  ASSERT_EQ (Dns6CacheLookup (&CacheList, (CHAR16 *)L"boot.example.com", &H2AData), EFI_SUCCESS);
+  ASSERT_EQ (H2AData->IpCount, 1U);
+  EXPECT_EQ (CompareMem (&H2AData->IpList[0], &Address2, sizeof (Address2)), 0);
+
+  FreePool (H2AData->IpList);
+  FreePool (H2AData);
+}
+
+// Test Description:
+// An entry with a zero timeout must not wrap around and live forever.
+TEST_F (Dns6CacheTest, AgeRemovesZeroTimeout) {
+  DNS6_HOST_TO_ADDR_DATA  *H2AData;
+
+  ASSERT_EQ (Add ((CHAR16 *)L"boot.example.com", &Address1, 0), EFI_SUCCESS);
+
+  EXPECT_EQ (Dns6CacheAge (&CacheList), 1U);
+  EXPECT_EQ (Dns6CacheLookup (&CacheList, (CHAR16 *)L"boot.example.com", &H2AData), EFI_NOT_FOUND);
+}
@@ -0,0 +1,258 @@
+/** @file
+  Tests for the response parsing in DnsImpl.c.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <gtest/gtest.h>
+#include <vector>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/BaseMemoryLib.h>
+  #include <Library/MemoryAllocationLib.h>
+  #include <Library/UefiBootServicesTableLib.h>
+  #include "../DnsImpl.h"
+
+  //
+  // Defined by DnsDriver.c, which is not part of this test.
+  //
+  DNS_DRIVER_DATA  *mDriverData;
+}
+
+//
+// The query for the A records of www.example.com.
+//
+static const UINT8  mQuery[] = {
+  0x12, 0x34, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  3,    'w',  'w',  'w',  7,    'e',  'x',  'a',  'm',  'p',  'l',  'e',
+  3,    'c',  'o',  'm',  0,
+  0x00, 0x01, 0x00, 0x01
+};
+
+static
+EFI_TPL
+EFIAPI
+FakeRaiseTpl (
+  IN EFI_TPL  NewTpl
+  )
+{
+  return TPL_APPLICATION;
+}
+
+static
+VOID
+EFIAPI
+FakeRestoreTpl (
+  IN EFI_TPL  OldTpl
+  )
+{
+}
+
+static
+EFI_STATUS
+EFIAPI
+FakeFreePool (
+  IN VOID  *Buffer
+  )
+{
+  FreePool (Buffer);
+  return EFI_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////
+// ParseDnsResponse Tests
+////////////////////////////////////////////////////////////////////////
+
+class ParseDnsResponseTest : public ::testing::Test {
+protected:
+  DNS_DRIVER_DATA            DriverData;
+  DNS_SERVICE                Service;
+  DNS_INSTANCE               Instance;
+  DNS4_TOKEN_ENTRY           TokenEntry;
+  EFI_DNS4_COMPLETION_TOKEN  Token;
+  EFI_BOOT_SERVICES          BootServices;
+  EFI_BOOT_SERVICES          *OriginalBootServices;
+  std::vector<UINT8>         Response;
+
+  virtual void
+  SetUp (
+    )
+  {
+    NET_BUF  *Packet;
+
+    ZeroMem (&DriverData, sizeof (DriverData));
+    ZeroMem (&Service, sizeof (Service));
+    ZeroMem (&Instance, sizeof (Instance));
+    ZeroMem (&TokenEntry, sizeof (TokenEntry));
+    ZeroMem (&Token, sizeof (Token));
+    ZeroMem (&BootServices, sizeof (BootServices));
+
+    InitializeListHead (&DriverData.Dns4CacheList);
+    InitializeListHead (&DriverData.Dns6CacheList);
+    mDriverData = &DriverData;
+
+    BootServices.RaiseTPL   = FakeRaiseTpl;
+    BootServices.RestoreTPL = FakeRestoreTpl;
+    BootServices.FreePool   = FakeFreePool;
+    OriginalBootServices    = gBS;
+    gBS                     = &BootServices;
+
+    Service.IpVersion = IP_VERSION_4;
+    Instance.Service  = &Service;
+    NetMapInit (&Instance.Dns4TxTokens);
+    NetMapInit (&Instance.Dns6TxTokens);
+
+    TokenEntry.QueryHostName = (CHAR16 *)L"www.example.com";
+    TokenEntry.Token         = &Token;
+
+    Packet = NetbufAlloc (sizeof (mQuery));
+    ASSERT_NE (Packet, nullptr);
+    CopyMem (NetbufAllocSpace (Packet, sizeof (mQuery), NET_BUF_TAIL), mQuery, sizeof (mQuery));
+    ASSERT_EQ (NetMapInsertTail (&Instance.Dns4TxTokens, &TokenEntry, Packet), EFI_SUCCESS);
+  }
+
+  virtual void
+  TearDown (
+    )
+  {
+    NET_MAP_ITEM  *Item;
+
+    while (!IsListEmpty (&DriverData.Dns4CacheList)) {
+      NET_LIST_USER_STRUCT (DriverData.Dns4CacheList.ForwardLink, DNS4_CACHE, AllCacheLink)->DnsCache.Timeout = 0;
+      Dns4CacheAge (&DriverData.Dns4CacheList);
+    }
+
+    while (!NetMapIsEmpty (&Instance.Dns4TxTokens)) {
+      Item = NET_LIST_HEAD (&Instance.Dns4TxTokens.Used, NET_MAP_ITEM, Link);
+      NetbufFree ((NET_BUF *)Item->Value);
+      NetMapRemoveItem (&Instance.Dns4TxTokens, Item, NULL);
+    }
+
+    NetMapClean (&Instance.Dns4TxTokens);
+    NetMapClean (&Instance.Dns6TxTokens);
+
+    if (Token.RspData.H2AData != NULL) {
+      FreePool (Token.RspData.H2AData->IpList);
+      FreePool (Token.RspData.H2AData);
+    }
+
+    gBS = OriginalBootServices;
+  }
+
+  VOID
+  AddAnswer (
+    UINT16        Type,
+    UINT32        Ttl,
+    const UINT8  *Data,
+    UINT16        DataLength
+    )
+  {
+    const UINT8  Fixed[] = {
+      0xC0,                         0x0C,
+      (UINT8)(Type >> 8),           (UINT8)Type,
+      0x00,                         0x01,
+      (UINT8)(Ttl >> 24),           (UINT8)(Ttl >> 16),
+      (UINT8)(Ttl >> 8),            (UINT8)Ttl,
+      (UINT8)(DataLength >> 8),     (UINT8)DataLength
+    };
+
+    Response.insert (Response.end (), Fixed, Fixed + sizeof (Fixed));
+    Response.insert (Response.end (), Data, Data + DataLength);
+    Response[7]++;
+  }
+
+  //
+  // Answer the query with www.example.com aliased to cdn.example.com,
+  // which has the address 192.0.2.1.
+  //
+  EFI_STATUS
+  Parse (
+    BOOLEAN  WithCName,
+    UINT32   CNameTtl,
+    UINT32   AddressTtl
+    )
+  {
+    const UINT8  Alias[]   = { 3, 'c', 'd', 'n', 0xC0, 0x10 };
+    const UINT8  Address[] = { 192, 0, 2, 1 };
+    BOOLEAN      Completed;
+
+    Response.assign (mQuery, mQuery + sizeof (mQuery));
+    Response[2] = 0x81;
+    Response[3] = 0x80;
+
+    if (WithCName) {
+      AddAnswer (DNS_TYPE_CNAME, CNameTtl, Alias, sizeof (Alias));
+    }
+
+    AddAnswer (DNS_TYPE_A, AddressTtl, Address, sizeof (Address));
+
+    return ParseDnsResponse (&Instance, Response.data (), (UINT32)Response.size (), &Completed);
+  }
+
+  UINTN
+  CacheCount (
+    )
+  {
+    LIST_ENTRY  *Entry;
+    UINTN       Count;
+
+    Count = 0;
+    NET_LIST_FOR_EACH (Entry, &DriverData.Dns4CacheList) {
+      Count++;
+    }
+
+    return Count;
+  }
+
+  UINT32
+  CachedTimeout (
+    )
+  {
+    return NET_LIST_USER_STRUCT (DriverData.Dns4CacheList.ForwardLink, DNS4_CACHE, AllCacheLink)->DnsCache.Timeout;
+  }
+};
+
+// Test Description:
+// An answer without an alias is cached for its own TTL.
+TEST_F (ParseDnsResponseTest, AnswerKeepsItsTtl) {
+  ASSERT_EQ (Parse (FALSE, 0, 600), EFI_SUCCESS);
+  ASSERT_EQ (Token.RspData.H2AData->IpCount, 1U);
+  ASSERT_EQ (CacheCount (), 1U);
+  EXPECT_EQ (CachedTimeout (), 600U);
+}
+
+// Test Description:
+// An answer behind an alias is not cached longer than the alias.
+TEST_F (ParseDnsResponseTest, CNameTtlCapsAnswerTtl) {
+  ASSERT_EQ (Parse (TRUE, 300, 600), EFI_SUCCESS);
+  ASSERT_EQ (CacheCount (), 1U);
+  EXPECT_EQ (CachedTimeout (), 300U);
+}
+
+// Test Description:
+// An alias does not extend the TTL of the answer behind it.
+TEST_F (ParseDnsResponseTest, AnswerTtlCapsCNameTtl) {
+  ASSERT_EQ (Parse (TRUE, 300, 60), EFI_SUCCESS);
+  ASSERT_EQ (CacheCount (), 1U);
+  EXPECT_EQ (CachedTimeout (), 60U);
+}
+
+// Test Description:
+// An answer with a zero TTL behind a long-lived alias is returned,
+// but not cached.
+TEST_F (ParseDnsResponseTest, ZeroTtlAnswerAfterCNameIsNotCached) {
+  ASSERT_EQ (Parse (TRUE, 300, 0), EFI_SUCCESS);
+  ASSERT_EQ (Token.RspData.H2AData->IpCount, 1U);
+  EXPECT_EQ (EFI_IP4 (Token.RspData.H2AData->IpList[0]), 0x010200C0U);
+  EXPECT_EQ (CacheCount (), 0U);
+}
+
+// Test Description:
+// An answer behind an alias with a zero TTL is returned, but not cached.
+TEST_F (ParseDnsResponseTest, ZeroTtlCNameIsNotCached) {
+  ASSERT_EQ (Parse (TRUE, 0, 300), EFI_SUCCESS);
+  ASSERT_EQ (Token.RspData.H2AData->IpCount, 1U);
+  EXPECT_EQ (CacheCount (), 0U);
+}
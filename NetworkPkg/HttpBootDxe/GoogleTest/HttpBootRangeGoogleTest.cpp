@@ -0,0 +1,89 @@
+/** @file
+  Tests for the range requests in HttpBootRange.c.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <gtest/gtest.h>
+
+extern "C" {
+  #include <Uefi.h>
+  #include "../HttpBootDxe.h"
+
+  //
+  // Defined by HttpBootClient.c, which is not part of this test.
+  //
+  EFI_STATUS
+  HttpBootOpenHttpIo (
+    IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+    OUT    HTTP_IO                 *HttpIo
+    )
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  EFI_STATUS
+  HttpBootCreateRequestHeader (
+    IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+    IN     UINTN                   ExtraCount,
+    OUT    HTTP_IO_HEADER          **HttpIoHeader
+    )
+  {
+    return EFI_UNSUPPORTED;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////
+// HttpBootRangeCheckContentRange Tests
+////////////////////////////////////////////////////////////////////////
+
+// Test Description:
+// The header of the requested range is accepted.
+TEST (HttpBootRangeCheckContentRangeTest, ExactRangeIsAccepted) {
+  EXPECT_TRUE (HttpBootRangeCheckContentRange ("bytes 0-4194303/10485760", 0, 4194303, 10485760));
+  EXPECT_TRUE (HttpBootRangeCheckContentRange ("bytes 8388608-10485759/10485760", 8388608, 10485759, 10485760));
+}
+
+// Test Description:
+// A range that starts elsewhere would be received at the wrong offset.
+TEST (HttpBootRangeCheckContentRangeTest, WrongFirstIsRejected) {
+  EXPECT_FALSE (HttpBootRangeCheckContentRange ("bytes 0-4194303/10485760", 4096, 4194303, 10485760));
+  EXPECT_FALSE (HttpBootRangeCheckContentRange ("bytes 4096-4194303/10485760", 0, 4194303, 10485760));
+}
+
+// Test Description:
+// A range that ends elsewhere would not fill the chunk.
+TEST (HttpBootRangeCheckContentRangeTest, WrongLastIsRejected) {
+  EXPECT_FALSE (HttpBootRangeCheckContentRange ("bytes 0-1048575/10485760", 0, 4194303, 10485760));
+  EXPECT_FALSE (HttpBootRangeCheckContentRange ("bytes 0-10485759/10485760", 0, 4194303, 10485760));
+}
+
+// Test Description:
+// A different file size means that the file changed since the HEAD request.
+TEST (HttpBootRangeCheckContentRangeTest, WrongFileSizeIsRejected) {
+  EXPECT_FALSE (HttpBootRangeCheckContentRange ("bytes 0-4194303/10485761", 0, 4194303, 10485760));
+}
+
+// Test Description:
+// A server that does not know the size of the file still sends the range.
+TEST (HttpBootRangeCheckContentRangeTest, UnknownFileSizeIsAccepted) {
+  EXPECT_TRUE (HttpBootRangeCheckContentRange ("bytes 0-4194303/*", 0, 4194303, 10485760));
+  EXPECT_FALSE (HttpBootRangeCheckContentRange ("bytes 4096-4194303/*", 0, 4194303, 10485760));
+}
+
+// Test Description:
+// Only byte ranges are understood.
+TEST (HttpBootRangeCheckContentRangeTest, MissingUnitIsRejected) {
+  EXPECT_FALSE (HttpBootRangeCheckContentRange ("0-4194303/10485760", 0, 4194303, 10485760));
+  EXPECT_FALSE (HttpBootRangeCheckContentRange ("bytes=0-4194303/10485760", 0, 4194303, 10485760));
+  EXPECT_FALSE (HttpBootRangeCheckContentRange ("items 0-4194303/10485760", 0, 4194303, 10485760));
+}
+
+// Test Description:
+// Malformed ranges are rejected.
+TEST (HttpBootRangeCheckContentRangeTest, MalformedRangeIsRejected) {
+  EXPECT_FALSE (HttpBootRangeCheckContentRange ("bytes */10485760", 0, 4194303, 10485760));
+  EXPECT_FALSE (HttpBootRangeCheckContentRange ("bytes 0/10485760", 0, 4194303, 10485760));
+  EXPECT_FALSE (HttpBootRangeCheckContentRange ("bytes 0-4194303", 0, 4194303, 10485760));
+  EXPECT_FALSE (HttpBootRangeCheckContentRange ("", 0, 4194303, 10485760));
+}
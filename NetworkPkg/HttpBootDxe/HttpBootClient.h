@@ -14,6 +14,13 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define HTTP_USER_AGENT_EFI_HTTP_BOOT          "UefiHttpBoot/1.0"
 #define HTTP_BOOT_AUTHENTICATION_INFO_MAX_LEN  255
 
+//
+// Parameters of the boot file download with range requests.
+//
+#define HTTP_BOOT_RANGE_CHUNK_SIZE       SIZE_4MB
+#define HTTP_BOOT_RANGE_MAX_CONNECTIONS  16
+#define HTTP_BOOT_RANGE_MAX_RETRY        3
+
 //
 // Record the data length and start address of a data block.
 //
@@ -72,6 +79,22 @@ HttpBootDiscoverBootInfo (
   IN OUT HTTP_BOOT_PRIVATE_DATA  *Private
   );
 
+/**
+  Create and configure a HttpIo for the file download.
+
+  @param[in]    Private        The pointer to the driver's private data.
+  @param[out]   HttpIo         The HttpIo to create.
+
+  @retval EFI_SUCCESS          Successfully created.
+  @retval Others               Failed to create HttpIo.
+
+**/
+EFI_STATUS
+HttpBootOpenHttpIo (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  OUT    HTTP_IO                 *HttpIo
+  );
+
 /**
   Create a HttpIo instance for the file download.
 
@@ -86,6 +109,26 @@ HttpBootCreateHttpIo (
   IN     HTTP_BOOT_PRIVATE_DATA  *Private
   );
 
+/**
+  Build the HTTP header for a request of the boot file.
+
+  @param[in]       Private         The pointer to the driver's private data.
+  @param[in]       ExtraCount      The number of header fields to reserve for the caller.
+  @param[out]      HttpIoHeader    The HTTP header, to free with HttpIoFreeHeader().
+
+  @retval EFI_SUCCESS              The header is built.
+  @retval EFI_OUT_OF_RESOURCES     Could not allocate needed resources.
+  @retval EFI_UNSUPPORTED          The authentication scheme is not supported.
+  @retval Others                   Unexpected error happened.
+
+**/
+EFI_STATUS
+HttpBootCreateRequestHeader (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN     UINTN                   ExtraCount,
+  OUT    HTTP_IO_HEADER          **HttpIoHeader
+  );
+
 /**
   This function download the boot file by using UEFI HTTP protocol.
 
@@ -120,6 +163,53 @@ HttpBootGetBootFile (
   OUT HTTP_BOOT_IMAGE_TYPE       *ImageType
   );
 
+/**
+  Check the "Content-Range" header of a partial response against the
+  requested range.
+
+  @param[in]  Header           The value of the "Content-Range" header.
+  @param[in]  First            The first byte requested.
+  @param[in]  Last             The last byte requested.
+  @param[in]  FileSize         The size of the boot file.
+
+  @retval TRUE                 The response carries exactly the requested range.
+  @retval FALSE                The response does not match the request.
+
+**/
+BOOLEAN
+HttpBootRangeCheckContentRange (
+  IN CONST CHAR8  *Header,
+  IN UINTN        First,
+  IN UINTN        Last,
+  IN UINTN        FileSize
+  );
+
+/**
+  Download the boot file into the caller's buffer over several HTTP connections,
+  each requesting a different range of the file.
+
+  @param[in]       Private         The pointer to the driver's private data.
+  @param[in, out]  BufferSize      On input the size of Buffer in bytes. On output with a return
+                                   code of EFI_SUCCESS, the amount of data transferred to
+                                   Buffer.
+  @param[out]      Buffer          The memory buffer to transfer the file to.
+  @param[out]      ImageType       The image type of the downloaded file.
+
+  @retval EFI_SUCCESS              The file was loaded.
+  @retval EFI_UNSUPPORTED          The file cannot be downloaded with range requests.
+  @retval EFI_OUT_OF_RESOURCES     Could not allocate needed resources.
+  @retval EFI_TIMEOUT              A part of the file could not be downloaded.
+  @retval Others                   Unexpected error happened.
+
+**/
+EFI_STATUS
+HttpBootGetBootFileByRange (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN OUT UINTN                   *BufferSize,
+  OUT UINT8                      *Buffer,
+  OUT HTTP_BOOT_IMAGE_TYPE       *ImageType
+  );
+
 /**
   Clean up all cached data.
 
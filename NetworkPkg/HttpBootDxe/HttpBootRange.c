@@ -0,0 +1,641 @@
+/** @file
+  Download the boot file over several HTTP connections with range requests.
+
+  The boot file is split into chunks, every connection requests one chunk at a
+  time with a "Range" header and the body is received directly into the caller
+  provided buffer. A chunk whose connection fails or times out is handed back
+  and requested again from the last received byte on a new connection.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "HttpBootDxe.h"
+
+typedef enum {
+  HttpBootRangeChunkPending,
+  HttpBootRangeChunkActive,
+  HttpBootRangeChunkDone
+} HTTP_BOOT_RANGE_CHUNK_STATE;
+
+//
+// A part of the boot file requested with a single range request.
+//
+typedef struct {
+  UINTN                          Offset;
+  UINTN                          Length;
+  UINTN                          Received;
+  UINTN                          Retries;
+  HTTP_BOOT_RANGE_CHUNK_STATE    State;
+} HTTP_BOOT_RANGE_CHUNK;
+
+typedef enum {
+  HttpBootRangeConnectionIdle,
+  HttpBootRangeConnectionHeader,      // Waiting for the response header.
+  HttpBootRangeConnectionBody         // Waiting for the response body.
+} HTTP_BOOT_RANGE_CONNECTION_STATE;
+
+typedef struct {
+  HTTP_IO                             HttpIo;
+  BOOLEAN                             Opened;
+  BOOLEAN                             Unavailable;  // The connection could not be opened.
+  HTTP_BOOT_RANGE_CONNECTION_STATE    State;
+  HTTP_BOOT_RANGE_CHUNK               *Chunk;
+  EFI_HTTP_RESPONSE_DATA              Response;
+} HTTP_BOOT_RANGE_CONNECTION;
+
+//
+// Shared state of a ranged download.
+//
+typedef struct {
+  HTTP_BOOT_PRIVATE_DATA        *Private;
+  UINT8                         *Buffer;
+  EFI_HTTP_REQUEST_DATA         RequestData;
+  HTTP_IO_HEADER                *Header;
+  HTTP_BOOT_RANGE_CHUNK         *Chunks;
+  UINTN                         ChunkCount;
+  UINTN                         DoneCount;
+  HTTP_BOOT_RANGE_CONNECTION    *Connections;
+  UINTN                         ConnectionCount;
+  UINTN                         UnavailableCount;
+} HTTP_BOOT_RANGE_CONTEXT;
+
+/**
+  Check the "Content-Range" header of a partial response against the
+  requested range. A complete length of "*", which the server sends when it
+  does not know the size of the file, is accepted.
+
+  @param[in]  Header           The value of the "Content-Range" header.
+  @param[in]  First            The first byte requested.
+  @param[in]  Last             The last byte requested.
+  @param[in]  FileSize         The size of the boot file.
+
+  @retval TRUE                 The response carries exactly the requested range.
+  @retval FALSE                The response does not match the request.
+
+**/
+BOOLEAN
+HttpBootRangeCheckContentRange (
+  IN CONST CHAR8  *Header,
+  IN UINTN        First,
+  IN UINTN        Last,
+  IN UINTN        FileSize
+  )
+{
+  CHAR8  *EndPointer;
+  UINTN  Value;
+
+  //
+  // Content-Range: bytes <First>-<Last>/<FileSize>
+  //
+  if (AsciiStrnCmp (Header, "bytes ", 6) != 0) {
+    return FALSE;
+  }
+
+  Header += 6;
+  if (RETURN_ERROR (AsciiStrDecimalToUintnS (Header, &EndPointer, &Value)) ||
+      (Value != First) || (*EndPointer != '-'))
+  {
+    return FALSE;
+  }
+
+  if (RETURN_ERROR (AsciiStrDecimalToUintnS (EndPointer + 1, &EndPointer, &Value)) ||
+      (Value != Last) || (*EndPointer != '/'))
+  {
+    return FALSE;
+  }
+
+  if (AsciiStrCmp (EndPointer + 1, "*") == 0) {
+    return TRUE;
+  }
+
+  if (RETURN_ERROR (AsciiStrDecimalToUintnS (EndPointer + 1, &EndPointer, &Value)) ||
+      (Value != FileSize))
+  {
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+  Queue a response token on the connection and start its timeout timer.
+
+  @param[in]  Connection       The connection to receive on.
+  @param[in]  RecvMsgHeader    TRUE to receive the response header, FALSE to
+                               receive the next part of the body.
+  @param[in]  BodyLength       The length of Body in bytes.
+  @param[in]  Body             The buffer to receive the body into.
+
+  @retval EFI_SUCCESS          The response token is queued.
+  @retval Others               Failed to queue the response token.
+
+**/
+EFI_STATUS
+HttpBootRangeQueueResponse (
+  IN HTTP_BOOT_RANGE_CONNECTION  *Connection,
+  IN BOOLEAN                     RecvMsgHeader,
+  IN UINTN                       BodyLength,
+  IN VOID                        *Body
+  )
+{
+  EFI_STATUS  Status;
+  HTTP_IO     *HttpIo;
+
+  HttpIo = &Connection->HttpIo;
+
+  HttpIo->RspToken.Status                 = EFI_NOT_READY;
+  HttpIo->RspToken.Message->Data.Response = RecvMsgHeader ? &Connection->Response : NULL;
+  HttpIo->RspToken.Message->HeaderCount   = 0;
+  HttpIo->RspToken.Message->Headers       = NULL;
+  HttpIo->RspToken.Message->BodyLength    = BodyLength;
+  HttpIo->RspToken.Message->Body          = Body;
+  HttpIo->IsRxDone                        = FALSE;
+
+  Status = gBS->SetTimer (HttpIo->TimeoutEvent, TimerRelative, HttpIo->Timeout * TICKS_PER_MS);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = HttpIo->Http->Response (HttpIo->Http, &HttpIo->RspToken);
+  if (EFI_ERROR (Status)) {
+    gBS->SetTimer (HttpIo->TimeoutEvent, TimerCancel, 0);
+  }
+
+  return Status;
+}
+
+/**
+  Drop the connection after a failure and hand its chunk back, so that the
+  rest of the chunk is requested again on a new connection.
+
+  @param[in]  Connection       The failed connection.
+
+  @retval EFI_SUCCESS          The chunk will be requested again.
+  @retval EFI_TIMEOUT          The chunk failed too many times in a row.
+
+**/
+EFI_STATUS
+HttpBootRangeRetry (
+  IN HTTP_BOOT_RANGE_CONNECTION  *Connection
+  )
+{
+  HTTP_BOOT_RANGE_CHUNK  *Chunk;
+
+  if (Connection->Opened) {
+    HttpIoDestroyIo (&Connection->HttpIo);
+    Connection->Opened = FALSE;
+  }
+
+  //
+  // Run the DPC of the cancelled tokens before the connection is reused.
+  //
+  DispatchDpc ();
+
+  Chunk             = Connection->Chunk;
+  Connection->Chunk = NULL;
+  Connection->State = HttpBootRangeConnectionIdle;
+  if (Chunk == NULL) {
+    return EFI_SUCCESS;
+  }
+
+  Chunk->State = HttpBootRangeChunkPending;
+  Chunk->Retries++;
+  DEBUG ((
+    DEBUG_WARN,
+    "HttpBootRangeRetry: chunk at 0x%Lx failed after 0x%Lx bytes, retry %Lu\n",
+    (UINT64)Chunk->Offset,
+    (UINT64)Chunk->Received,
+    (UINT64)Chunk->Retries
+    ));
+
+  if (Chunk->Retries > HTTP_BOOT_RANGE_MAX_RETRY) {
+    return EFI_TIMEOUT;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Request the next pending chunk on an idle connection.
+
+  A connection that cannot be opened is left out of the download, the other
+  connections take over its chunks.
+
+  @param[in]  Range            The ranged download.
+  @param[in]  Connection       The idle connection.
+
+  @retval EFI_SUCCESS          The request is sent, no chunk is pending or
+                               the connection could not be opened.
+  @retval EFI_UNSUPPORTED      No connection could be opened.
+  @retval Others               The request failed.
+
+**/
+EFI_STATUS
+HttpBootRangeRequest (
+  IN HTTP_BOOT_RANGE_CONTEXT     *Range,
+  IN HTTP_BOOT_RANGE_CONNECTION  *Connection
+  )
+{
+  EFI_STATUS             Status;
+  HTTP_BOOT_RANGE_CHUNK  *Chunk;
+  UINTN                  Index;
+  CHAR8                  RangeValue[64];
+
+  Chunk = NULL;
+  for (Index = 0; Index < Range->ChunkCount; Index++) {
+    if (Range->Chunks[Index].State == HttpBootRangeChunkPending) {
+      Chunk = &Range->Chunks[Index];
+      break;
+    }
+  }
+
+  if (Chunk == NULL) {
+    return EFI_SUCCESS;
+  }
+
+  if (!Connection->Opened) {
+    //
+    // The server or the HTTP stack does not take another connection. This is
+    // no fault of the chunk, so it does not count as a retry.
+    //
+    Status = HttpBootOpenHttpIo (Range->Private, &Connection->HttpIo);
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_WARN, "HttpBootRangeRequest: cannot open a connection - %r\n", Status));
+      Connection->Unavailable = TRUE;
+      Range->UnavailableCount++;
+      if (Range->UnavailableCount == Range->ConnectionCount) {
+        return EFI_UNSUPPORTED;
+      }
+
+      return EFI_SUCCESS;
+    }
+
+    Connection->Opened = TRUE;
+  }
+
+  Chunk->State      = HttpBootRangeChunkActive;
+  Connection->Chunk = Chunk;
+
+  AsciiSPrint (
+    RangeValue,
+    sizeof (RangeValue),
+    "bytes=%Lu-%Lu",
+    (UINT64)(Chunk->Offset + Chunk->Received),
+    (UINT64)(Chunk->Offset + Chunk->Length - 1)
+    );
+  Status = HttpIoSetHeader (Range->Header, HTTP_HEADER_RANGE, RangeValue);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = HttpIoSendRequest (
+             &Connection->HttpIo,
+             &Range->RequestData,
+             Range->Header->HeaderCount,
+             Range->Header->Headers,
+             0,
+             NULL
+             );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = HttpBootRangeQueueResponse (Connection, TRUE, 0, NULL);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Connection->State = HttpBootRangeConnectionHeader;
+  return EFI_SUCCESS;
+}
+
+/**
+  Handle a completed response token of a connection.
+
+  @param[in]  Range            The ranged download.
+  @param[in]  Connection       The connection whose response token completed.
+
+  @retval EFI_SUCCESS          The response is handled.
+  @retval EFI_UNSUPPORTED      The server did not answer with the requested range.
+  @retval EFI_ABORTED          The user aborted the download.
+  @retval Others               The response failed.
+
+**/
+EFI_STATUS
+HttpBootRangeResponse (
+  IN HTTP_BOOT_RANGE_CONTEXT     *Range,
+  IN HTTP_BOOT_RANGE_CONNECTION  *Connection
+  )
+{
+  EFI_STATUS                       Status;
+  HTTP_IO                          *HttpIo;
+  EFI_HTTP_MESSAGE                 *Message;
+  HTTP_BOOT_RANGE_CHUNK            *Chunk;
+  EFI_HTTP_HEADER                  *ContentRange;
+  EFI_HTTP_BOOT_CALLBACK_PROTOCOL  *HttpBootCallback;
+  BOOLEAN                          Partial;
+
+  HttpIo  = &Connection->HttpIo;
+  Message = HttpIo->RspToken.Message;
+  Chunk   = Connection->Chunk;
+
+  HttpIo->IsRxDone = FALSE;
+  gBS->SetTimer (HttpIo->TimeoutEvent, TimerCancel, 0);
+
+  if ((HttpIo->RspToken.Status != EFI_SUCCESS) && (HttpIo->RspToken.Status != EFI_HTTP_ERROR)) {
+    Status = HttpIo->RspToken.Status;
+    goto ON_EXIT;
+  }
+
+  if (HttpIo->Callback != NULL) {
+    Status = HttpIo->Callback (HttpIoResponse, Message, HttpIo->Context);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  if (Connection->State == HttpBootRangeConnectionHeader) {
+    //
+    // Only a partial response with the requested range can be received into
+    // the buffer, anything else makes the caller fall back to a single GET.
+    //
+    Partial = FALSE;
+    if ((HttpIo->RspToken.Status == EFI_SUCCESS) &&
+        (Connection->Response.StatusCode == HTTP_STATUS_206_PARTIAL_CONTENT))
+    {
+      ContentRange = HttpFindHeader (Message->HeaderCount, Message->Headers, HTTP_HEADER_CONTENT_RANGE);
+      Partial      = (ContentRange != NULL) &&
+                     HttpBootRangeCheckContentRange (
+                       ContentRange->FieldValue,
+                       Chunk->Offset + Chunk->Received,
+                       Chunk->Offset + Chunk->Length - 1,
+                       Range->Private->BootFileSize
+                       );
+    }
+
+    if (Message->Headers != NULL) {
+      HttpFreeHeaderFields (Message->Headers, Message->HeaderCount);
+      Message->Headers     = NULL;
+      Message->HeaderCount = 0;
+    }
+
+    if (!Partial) {
+      DEBUG ((DEBUG_INFO, "HttpBootRangeResponse: range request not honoured, status %d\n", Connection->Response.StatusCode));
+      return EFI_UNSUPPORTED;
+    }
+
+    Connection->State = HttpBootRangeConnectionBody;
+  } else {
+    HttpBootCallback = Range->Private->HttpBootCallback;
+    if ((HttpBootCallback != NULL) && (Message->BodyLength != 0)) {
+      Status = HttpBootCallback->Callback (
+                                   HttpBootCallback,
+                                   HttpBootHttpEntityBody,
+                                   TRUE,
+                                   (UINT32)Message->BodyLength,
+                                   Message->Body
+                                   );
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+    }
+
+    //
+    // Only failures in a row without any progress give up on the chunk.
+    //
+    Chunk->Received += Message->BodyLength;
+    if (Message->BodyLength != 0) {
+      Chunk->Retries = 0;
+    }
+
+    if (Chunk->Received == Chunk->Length) {
+      Chunk->State      = HttpBootRangeChunkDone;
+      Connection->Chunk = NULL;
+      Connection->State = HttpBootRangeConnectionIdle;
+      Range->DoneCount++;
+      return EFI_SUCCESS;
+    }
+  }
+
+  //
+  // Receive the rest of the chunk straight into the caller's buffer.
+  //
+  Status = HttpBootRangeQueueResponse (
+             Connection,
+             FALSE,
+             Chunk->Length - Chunk->Received,
+             Range->Buffer + Chunk->Offset + Chunk->Received
+             );
+
+ON_EXIT:
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "HttpBootRangeResponse: %r\n", Status));
+    Status = HttpBootRangeRetry (Connection);
+  }
+
+  return Status;
+}
+
+/**
+  Move one connection of the ranged download forward.
+
+  @param[in]  Range            The ranged download.
+  @param[in]  Connection       The connection.
+
+  @retval EFI_SUCCESS          The connection is making progress.
+  @retval Others               The download has to stop.
+
+**/
+EFI_STATUS
+HttpBootRangeProcess (
+  IN HTTP_BOOT_RANGE_CONTEXT     *Range,
+  IN HTTP_BOOT_RANGE_CONNECTION  *Connection
+  )
+{
+  EFI_STATUS  Status;
+  HTTP_IO     *HttpIo;
+
+  HttpIo = &Connection->HttpIo;
+
+  if (Connection->Unavailable) {
+    return EFI_SUCCESS;
+  }
+
+  if (Connection->State == HttpBootRangeConnectionIdle) {
+    //
+    // A failure before the chunk is taken means that no connection is left.
+    //
+    Status = HttpBootRangeRequest (Range, Connection);
+    if (EFI_ERROR (Status) && (Connection->Chunk != NULL)) {
+      DEBUG ((DEBUG_WARN, "HttpBootRangeRequest: %r\n", Status));
+      Status = HttpBootRangeRetry (Connection);
+    }
+
+    return Status;
+  }
+
+  if (HttpIo->IsRxDone) {
+    return HttpBootRangeResponse (Range, Connection);
+  }
+
+  if (!EFI_ERROR (gBS->CheckEvent (HttpIo->TimeoutEvent))) {
+    //
+    // Nothing received within the timeout, cancel the response token and
+    // retry the rest of the chunk on a new connection.
+    //
+    HttpIo->Http->Cancel (HttpIo->Http, &HttpIo->RspToken);
+    DEBUG ((DEBUG_WARN, "HttpBootRangeProcess: %r\n", EFI_TIMEOUT));
+    return HttpBootRangeRetry (Connection);
+  }
+
+  HttpIo->Http->Poll (HttpIo->Http);
+  return EFI_SUCCESS;
+}
+
+/**
+  Download the boot file into the caller's buffer over several HTTP connections,
+  each requesting a different range of the file.
+
+  The server must have announced "Accept-Ranges: bytes" in the response to the
+  HEAD request, which also set the boot file size. EFI_UNSUPPORTED is returned
+  when the download cannot be split or no connection can be opened, so that
+  the caller can fall back to HttpBootGetBootFile().
+
+  @param[in]       Private         The pointer to the driver's private data.
+  @param[in, out]  BufferSize      On input the size of Buffer in bytes. On output with a return
+                                   code of EFI_SUCCESS, the amount of data transferred to
+                                   Buffer.
+  @param[out]      Buffer          The memory buffer to transfer the file to.
+  @param[out]      ImageType       The image type of the downloaded file.
+
+  @retval EFI_SUCCESS              The file was loaded.
+  @retval EFI_UNSUPPORTED          The file cannot be downloaded with range requests.
+  @retval EFI_OUT_OF_RESOURCES     Could not allocate needed resources.
+  @retval EFI_TIMEOUT              A part of the file could not be downloaded.
+  @retval Others                   Unexpected error happened.
+
+**/
+EFI_STATUS
+HttpBootGetBootFileByRange (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN OUT UINTN                   *BufferSize,
+  OUT UINT8                      *Buffer,
+  OUT HTTP_BOOT_IMAGE_TYPE       *ImageType
+  )
+{
+  EFI_STATUS               Status;
+  HTTP_BOOT_RANGE_CONTEXT  Range;
+  UINTN                    UrlSize;
+  UINTN                    Index;
+
+  ASSERT (Private != NULL);
+
+  if ((BufferSize == NULL) || (Buffer == NULL) || (ImageType == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  //
+  // Files served from the cache, files of unknown size and files too small to
+  // be split are downloaded with a single request.
+  //
+  if (!Private->AcceptRanges || !IsListEmpty (&Private->CacheList) ||
+      (PcdGet32 (PcdHttpBootRangeConnections) <= 1) ||
+      (Private->BootFileSize < 2 * HTTP_BOOT_RANGE_CHUNK_SIZE) ||
+      (*BufferSize < Private->BootFileSize))
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  ZeroMem (&Range, sizeof (Range));
+  Range.Private = Private;
+  Range.Buffer  = Buffer;
+
+  UrlSize = AsciiStrSize (Private->BootFileUri);
+
+  Range.RequestData.Method = HttpMethodGet;
+  Range.RequestData.Url    = AllocatePool (UrlSize * sizeof (CHAR16));
+  if (Range.RequestData.Url == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  AsciiStrToUnicodeStrS (Private->BootFileUri, Range.RequestData.Url, UrlSize);
+
+  Status = HttpBootCreateRequestHeader (Private, 1, &Range.Header);
+  if (EFI_ERROR (Status)) {
+    goto ON_EXIT;
+  }
+
+  //
+  // Split the file into chunks.
+  //
+  Range.ChunkCount = (Private->BootFileSize + HTTP_BOOT_RANGE_CHUNK_SIZE - 1) / HTTP_BOOT_RANGE_CHUNK_SIZE;
+  Range.Chunks     = AllocateZeroPool (Range.ChunkCount * sizeof (HTTP_BOOT_RANGE_CHUNK));
+  if (Range.Chunks == NULL) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto ON_EXIT;
+  }
+
+  for (Index = 0; Index < Range.ChunkCount; Index++) {
+    Range.Chunks[Index].Offset = Index * HTTP_BOOT_RANGE_CHUNK_SIZE;
+    Range.Chunks[Index].Length = MIN (HTTP_BOOT_RANGE_CHUNK_SIZE, Private->BootFileSize - Range.Chunks[Index].Offset);
+    Range.Chunks[Index].State  = HttpBootRangeChunkPending;
+  }
+
+  Range.ConnectionCount = MIN (PcdGet32 (PcdHttpBootRangeConnections), HTTP_BOOT_RANGE_MAX_CONNECTIONS);
+  Range.ConnectionCount = MIN (Range.ConnectionCount, Range.ChunkCount);
+  Range.Connections     = AllocateZeroPool (Range.ConnectionCount * sizeof (HTTP_BOOT_RANGE_CONNECTION));
+  if (Range.Connections == NULL) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto ON_EXIT;
+  }
+
+  DEBUG ((
+    DEBUG_INFO,
+    "HttpBootGetBootFileByRange: 0x%Lx bytes in %Lu chunks over %Lu connections\n",
+    (UINT64)Private->BootFileSize,
+    (UINT64)Range.ChunkCount,
+    (UINT64)Range.ConnectionCount
+    ));
+
+  //
+  // Keep every connection busy until all chunks are received.
+  //
+  Status = EFI_SUCCESS;
+  while (Range.DoneCount < Range.ChunkCount) {
+    for (Index = 0; Index < Range.ConnectionCount; Index++) {
+      Status = HttpBootRangeProcess (&Range, &Range.Connections[Index]);
+      if (EFI_ERROR (Status)) {
+        goto ON_EXIT;
+      }
+    }
+  }
+
+  *BufferSize = Private->BootFileSize;
+  *ImageType  = Private->ImageType;
+
+ON_EXIT:
+  if (Range.Connections != NULL) {
+    for (Index = 0; Index < Range.ConnectionCount; Index++) {
+      if (Range.Connections[Index].Opened) {
+        HttpIoDestroyIo (&Range.Connections[Index].HttpIo);
+      }
+    }
+
+    DispatchDpc ();
+    FreePool (Range.Connections);
+  }
+
+  if (Range.Chunks != NULL) {
+    FreePool (Range.Chunks);
+  }
+
+  if (Range.Header != NULL) {
+    HttpIoFreeHeader (Range.Header);
+  }
+
+  FreePool (Range.RequestData.Url);
+
+  return Status;
+}
@@ -1023,7 +1023,7 @@ HttpResponseWorker (
       HttpInstance->NextMsg     = NULL;
       HttpInstance->CacheOffset = 0;
       SizeofHeaders             = HdrLen;
-      BufferSize                = HttpInstance->CacheLen;
+      BufferSize                = HdrLen;
 
       //
       // Check whether we cached the whole HTTP headers.
@@ -1089,7 +1089,8 @@ HttpResponseWorker (
       }
 
       CopyMem (HttpInstance->CacheBody, EndofHeader, BodyLen);
-      HttpInstance->CacheLen = BodyLen;
+      HttpInstance->CacheLen    = BodyLen;
+      HttpInstance->CacheOffset = 0;
     }
 
     //
@@ -1411,23 +1412,23 @@ HttpResponseWorker (
       HttpMsg->BodyLength = HttpInstance->NextMsg - (CHAR8 *)HttpMsg->Body;
     }
 
-    HttpInstance->CacheLen = Fragment.Len - HttpMsg->BodyLength;
-    if (HttpInstance->CacheLen != 0) {
+    if (Fragment.Len > HttpMsg->BodyLength) {
       if (HttpInstance->CacheBody != NULL) {
         FreePool (HttpInstance->CacheBody);
       }
 
-      HttpInstance->CacheBody = AllocateZeroPool (HttpInstance->CacheLen);
-      if (HttpInstance->CacheBody == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        goto Error2;
-      }
-
-      CopyMem (HttpInstance->CacheBody, Fragment.Bulk + HttpMsg->BodyLength, HttpInstance->CacheLen);
-      HttpInstance->CacheOffset = 0;
+      //
+      // Keep the rest of the fragment as the cache instead of copying it, the
+      // data starts at CacheOffset.
+      //
       if (HttpInstance->NextMsg != NULL) {
-        HttpInstance->NextMsg = HttpInstance->CacheBody;
+        HttpInstance->NextMsg = (CHAR8 *)Fragment.Bulk + HttpMsg->BodyLength;
       }
+
+      HttpInstance->CacheBody   = (CHAR8 *)Fragment.Bulk;
+      HttpInstance->CacheLen    = Fragment.Len;
+      HttpInstance->CacheOffset = HttpMsg->BodyLength;
+      Fragment.Bulk             = NULL;
     }
 
     if (Fragment.Bulk != NULL) {
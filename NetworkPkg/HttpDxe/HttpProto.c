@@ -926,6 +926,11 @@ HttpCleanProtocol (
   }
 
   TlsCloseTxRxEvent (HttpInstance);
+
+  if (HttpInstance->TlsRxBuffer != NULL) {
+    FreePool (HttpInstance->TlsRxBuffer);
+    HttpInstance->TlsRxBuffer = NULL;
+  }
 }
 
 /**
@@ -196,6 +196,14 @@ typedef struct _HTTP_PROTOCOL {
   EFI_TCP6_RECEIVE_DATA             Tcp6TlsRxData;
   BOOLEAN                           TlsIsRxDone;
 
+  //
+  // TlsRxBuffer holds the data received from TCP which is not processed yet,
+  // from TlsRxHead to TlsRxTail.
+  //
+  UINT8                             *TlsRxBuffer;
+  UINT32                            TlsRxHead;
+  UINT32                            TlsRxTail;
+
   BOOLEAN                           ConnectionClose;
 } HTTP_PROTOCOL;
 
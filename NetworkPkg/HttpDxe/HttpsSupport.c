@@ -873,140 +873,203 @@ ON_EXIT:
 }
 
 /**
-  Receive the Packet by processing the associated HTTPS token.
+  Receive more data from TCP into the receive buffer of the HTTP instance.
+
+  The data not processed yet is moved to the start of the buffer first, the
+  data received is appended to it.
 
   @param[in, out]   HttpInstance    Pointer to HTTP_PROTOCOL structure.
-  @param[in]        Packet          The packet to transmit.
   @param[in]        Timeout         The time to wait for connection done.
 
-  @retval EFI_SUCCESS            The Packet is received.
-  @retval EFI_INVALID_PARAMETER  HttpInstance is NULL or Packet is NULL.
+  @retval EFI_SUCCESS            Some data is received.
+  @retval EFI_INVALID_PARAMETER  The receive token is not initialized.
   @retval EFI_OUT_OF_RESOURCES   Can't allocate memory resources.
   @retval EFI_TIMEOUT            The operation is time out.
   @retval Others                 Other error as indicated.
 
 **/
+STATIC
 EFI_STATUS
-EFIAPI
-TlsCommonReceive (
+TlsFillRxBuffer (
   IN OUT HTTP_PROTOCOL  *HttpInstance,
-  IN     NET_BUF        *Packet,
   IN     EFI_EVENT      Timeout
   )
 {
   EFI_TCP4_RECEIVE_DATA  *Tcp4RxData;
   EFI_TCP6_RECEIVE_DATA  *Tcp6RxData;
   EFI_STATUS             Status;
-  NET_FRAGMENT           *Fragment;
-  UINT32                 FragmentCount;
-  UINT32                 CurrentFragment;
+  UINT32                 Length;
 
   Tcp4RxData = NULL;
   Tcp6RxData = NULL;
 
-  if ((HttpInstance == NULL) || (Packet == NULL)) {
-    return EFI_INVALID_PARAMETER;
+  if (HttpInstance->TlsRxBuffer == NULL) {
+    HttpInstance->TlsRxBuffer = AllocatePool (HTTPS_RX_BUFFER_SIZE);
+    if (HttpInstance->TlsRxBuffer == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    HttpInstance->TlsRxHead = 0;
+    HttpInstance->TlsRxTail = 0;
   }
 
-  FragmentCount = Packet->BlockOpNum;
-  Fragment      = AllocatePool (FragmentCount * sizeof (NET_FRAGMENT));
-  if (Fragment == NULL) {
-    Status = EFI_OUT_OF_RESOURCES;
-    goto ON_EXIT;
+  if (HttpInstance->TlsRxHead != 0) {
+    CopyMem (
+      HttpInstance->TlsRxBuffer,
+      HttpInstance->TlsRxBuffer + HttpInstance->TlsRxHead,
+      HttpInstance->TlsRxTail - HttpInstance->TlsRxHead
+      );
+    HttpInstance->TlsRxTail -= HttpInstance->TlsRxHead;
+    HttpInstance->TlsRxHead  = 0;
   }
 
+  ASSERT (HttpInstance->TlsRxTail < HTTPS_RX_BUFFER_SIZE);
+  Length = HTTPS_RX_BUFFER_SIZE - HttpInstance->TlsRxTail;
+
   //
-  // Build the fragment table.
+  // TCP completes the receive request as soon as some data is available.
   //
-  NetbufBuildExt (Packet, Fragment, &FragmentCount);
-
   if (!HttpInstance->LocalAddressIsIPv6) {
     Tcp4RxData = HttpInstance->Tcp4TlsRxToken.Packet.RxData;
     if (Tcp4RxData == NULL) {
       return EFI_INVALID_PARAMETER;
     }
 
-    Tcp4RxData->FragmentCount = 1;
+    Tcp4RxData->FragmentCount                   = 1;
+    Tcp4RxData->DataLength                      = Length;
+    Tcp4RxData->FragmentTable[0].FragmentLength = Length;
+    Tcp4RxData->FragmentTable[0].FragmentBuffer = HttpInstance->TlsRxBuffer + HttpInstance->TlsRxTail;
+    Status                                      = HttpInstance->Tcp4->Receive (HttpInstance->Tcp4, &HttpInstance->Tcp4TlsRxToken);
   } else {
     Tcp6RxData = HttpInstance->Tcp6TlsRxToken.Packet.RxData;
     if (Tcp6RxData == NULL) {
       return EFI_INVALID_PARAMETER;
     }
 
-    Tcp6RxData->FragmentCount = 1;
+    Tcp6RxData->FragmentCount                   = 1;
+    Tcp6RxData->DataLength                      = Length;
+    Tcp6RxData->FragmentTable[0].FragmentLength = Length;
+    Tcp6RxData->FragmentTable[0].FragmentBuffer = HttpInstance->TlsRxBuffer + HttpInstance->TlsRxTail;
+    Status                                      = HttpInstance->Tcp6->Receive (HttpInstance->Tcp6, &HttpInstance->Tcp6TlsRxToken);
   }
 
-  CurrentFragment = 0;
-  Status          = EFI_SUCCESS;
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
 
-  while (CurrentFragment < FragmentCount) {
+  while (!HttpInstance->TlsIsRxDone && ((Timeout == NULL) || EFI_ERROR (gBS->CheckEvent (Timeout)))) {
+    //
+    // Poll until some data is received or an error occurs.
+    //
     if (!HttpInstance->LocalAddressIsIPv6) {
-      Tcp4RxData->DataLength                      = Fragment[CurrentFragment].Len;
-      Tcp4RxData->FragmentTable[0].FragmentLength = Fragment[CurrentFragment].Len;
-      Tcp4RxData->FragmentTable[0].FragmentBuffer = Fragment[CurrentFragment].Bulk;
-      Status                                      = HttpInstance->Tcp4->Receive (HttpInstance->Tcp4, &HttpInstance->Tcp4TlsRxToken);
+      HttpInstance->Tcp4->Poll (HttpInstance->Tcp4);
     } else {
-      Tcp6RxData->DataLength                      = Fragment[CurrentFragment].Len;
-      Tcp6RxData->FragmentTable[0].FragmentLength = Fragment[CurrentFragment].Len;
-      Tcp6RxData->FragmentTable[0].FragmentBuffer = Fragment[CurrentFragment].Bulk;
-      Status                                      = HttpInstance->Tcp6->Receive (HttpInstance->Tcp6, &HttpInstance->Tcp6TlsRxToken);
+      HttpInstance->Tcp6->Poll (HttpInstance->Tcp6);
     }
+  }
 
+  if (!HttpInstance->TlsIsRxDone) {
+    //
+    // Timeout occurs, cancel the receive request.
+    //
+    if (!HttpInstance->LocalAddressIsIPv6) {
+      HttpInstance->Tcp4->Cancel (HttpInstance->Tcp4, &HttpInstance->Tcp4TlsRxToken.CompletionToken);
+    } else {
+      HttpInstance->Tcp6->Cancel (HttpInstance->Tcp6, &HttpInstance->Tcp6TlsRxToken.CompletionToken);
+    }
+
+    return EFI_TIMEOUT;
+  } else {
+    HttpInstance->TlsIsRxDone = FALSE;
+  }
+
+  if (!HttpInstance->LocalAddressIsIPv6) {
+    Status = HttpInstance->Tcp4TlsRxToken.CompletionToken.Status;
     if (EFI_ERROR (Status)) {
-      goto ON_EXIT;
+      return Status;
     }
 
-    while (!HttpInstance->TlsIsRxDone && ((Timeout == NULL) || EFI_ERROR (gBS->CheckEvent (Timeout)))) {
-      //
-      // Poll until some data is received or an error occurs.
-      //
-      if (!HttpInstance->LocalAddressIsIPv6) {
-        HttpInstance->Tcp4->Poll (HttpInstance->Tcp4);
-      } else {
-        HttpInstance->Tcp6->Poll (HttpInstance->Tcp6);
-      }
+    HttpInstance->TlsRxTail += Tcp4RxData->FragmentTable[0].FragmentLength;
+  } else {
+    Status = HttpInstance->Tcp6TlsRxToken.CompletionToken.Status;
+    if (EFI_ERROR (Status)) {
+      return Status;
     }
 
-    if (!HttpInstance->TlsIsRxDone) {
-      //
-      // Timeout occurs, cancel the receive request.
-      //
-      if (!HttpInstance->LocalAddressIsIPv6) {
-        HttpInstance->Tcp4->Cancel (HttpInstance->Tcp4, &HttpInstance->Tcp4TlsRxToken.CompletionToken);
-      } else {
-        HttpInstance->Tcp6->Cancel (HttpInstance->Tcp6, &HttpInstance->Tcp6TlsRxToken.CompletionToken);
-      }
+    HttpInstance->TlsRxTail += Tcp6RxData->FragmentTable[0].FragmentLength;
+  }
 
-      Status = EFI_TIMEOUT;
-      goto ON_EXIT;
-    } else {
-      HttpInstance->TlsIsRxDone = FALSE;
-    }
+  return EFI_SUCCESS;
+}
 
-    if (!HttpInstance->LocalAddressIsIPv6) {
-      Status = HttpInstance->Tcp4TlsRxToken.CompletionToken.Status;
-      if (EFI_ERROR (Status)) {
-        goto ON_EXIT;
-      }
+/**
+  Receive the Packet by processing the associated HTTPS token.
 
-      Fragment[CurrentFragment].Len -= Tcp4RxData->FragmentTable[0].FragmentLength;
-      if (Fragment[CurrentFragment].Len == 0) {
-        CurrentFragment++;
-      } else {
-        Fragment[CurrentFragment].Bulk += Tcp4RxData->FragmentTable[0].FragmentLength;
-      }
-    } else {
-      Status = HttpInstance->Tcp6TlsRxToken.CompletionToken.Status;
+  @param[in, out]   HttpInstance    Pointer to HTTP_PROTOCOL structure.
+  @param[in]        Packet          The packet to transmit.
+  @param[in]        Timeout         The time to wait for connection done.
+
+  @retval EFI_SUCCESS            The Packet is received.
+  @retval EFI_INVALID_PARAMETER  HttpInstance is NULL or Packet is NULL.
+  @retval EFI_OUT_OF_RESOURCES   Can't allocate memory resources.
+  @retval EFI_TIMEOUT            The operation is time out.
+  @retval Others                 Other error as indicated.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsCommonReceive (
+  IN OUT HTTP_PROTOCOL  *HttpInstance,
+  IN     NET_BUF        *Packet,
+  IN     EFI_EVENT      Timeout
+  )
+{
+  EFI_STATUS    Status;
+  NET_FRAGMENT  *Fragment;
+  UINT32        FragmentCount;
+  UINT32        CurrentFragment;
+  UINT32        Length;
+
+  if ((HttpInstance == NULL) || (Packet == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  FragmentCount = Packet->BlockOpNum;
+  Fragment      = AllocatePool (FragmentCount * sizeof (NET_FRAGMENT));
+  if (Fragment == NULL) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto ON_EXIT;
+  }
+
+  //
+  // Build the fragment table.
+  //
+  NetbufBuildExt (Packet, Fragment, &FragmentCount);
+
+  CurrentFragment = 0;
+  Status          = EFI_SUCCESS;
+
+  //
+  // Fill the fragments from the receive buffer, which is refilled from TCP
+  // when it runs empty.
+  //
+  while (CurrentFragment < FragmentCount) {
+    if ((HttpInstance->TlsRxBuffer == NULL) || (HttpInstance->TlsRxHead == HttpInstance->TlsRxTail)) {
+      Status = TlsFillRxBuffer (HttpInstance, Timeout);
       if (EFI_ERROR (Status)) {
         goto ON_EXIT;
       }
+    }
 
-      Fragment[CurrentFragment].Len -= Tcp6RxData->FragmentTable[0].FragmentLength;
-      if (Fragment[CurrentFragment].Len == 0) {
-        CurrentFragment++;
-      } else {
-        Fragment[CurrentFragment].Bulk += Tcp6RxData->FragmentTable[0].FragmentLength;
-      }
+    Length = MIN (Fragment[CurrentFragment].Len, HttpInstance->TlsRxTail - HttpInstance->TlsRxHead);
+    CopyMem (Fragment[CurrentFragment].Bulk, HttpInstance->TlsRxBuffer + HttpInstance->TlsRxHead, Length);
+    HttpInstance->TlsRxHead += Length;
+
+    Fragment[CurrentFragment].Len -= Length;
+    if (Fragment[CurrentFragment].Len == 0) {
+      CurrentFragment++;
+    } else {
+      Fragment[CurrentFragment].Bulk += Length;
     }
   }
 
@@ -1019,6 +1082,104 @@ ON_EXIT:
   return Status;
 }
 
+/**
+  Receive the complete TLS records available in the receive buffer.
+
+  At least one record is received. If it is an application data record, the
+  application data records following it in the receive buffer are received
+  with it, so that they are decrypted together.
+
+  @param[in, out]      HttpInstance    Pointer to HTTP_PROTOCOL structure.
+  @param[out]          Records         The received TLS records. They remain valid
+                                       until the next receive.
+  @param[out]          RecordsSize     The size of the received TLS records.
+  @param[in]           Timeout         The time to wait for connection done.
+
+  @retval EFI_SUCCESS          The TLS records are received.
+  @retval EFI_OUT_OF_RESOURCES Can't allocate memory resources.
+  @retval EFI_PROTOCOL_ERROR   An unexpected TLS packet was received.
+  @retval Others               Other errors as indicated.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsReceiveRecords (
+  IN OUT HTTP_PROTOCOL  *HttpInstance,
+  OUT UINT8             **Records,
+  OUT UINTN             *RecordsSize,
+  IN     EFI_EVENT      Timeout
+  )
+{
+  EFI_STATUS         Status;
+  TLS_RECORD_HEADER  *RecordHeader;
+  UINT32             Available;
+  UINT32             Size;
+  UINT32             Length;
+
+  //
+  // Receive until the first record is complete.
+  //
+  while (TRUE) {
+    Available = 0;
+    if (HttpInstance->TlsRxBuffer != NULL) {
+      Available = HttpInstance->TlsRxTail - HttpInstance->TlsRxHead;
+    }
+
+    if (Available >= TLS_RECORD_HEADER_LENGTH) {
+      RecordHeader = (TLS_RECORD_HEADER *)(HttpInstance->TlsRxBuffer + HttpInstance->TlsRxHead);
+      if (!(((RecordHeader->ContentType == TlsContentTypeHandshake) ||
+             (RecordHeader->ContentType == TlsContentTypeAlert) ||
+             (RecordHeader->ContentType == TlsContentTypeChangeCipherSpec) ||
+             (RecordHeader->ContentType == TlsContentTypeApplicationData)) &&
+            (RecordHeader->Version.Major == 0x03) && /// Major versions are same.
+            ((RecordHeader->Version.Minor == TLS10_PROTOCOL_VERSION_MINOR) ||
+             (RecordHeader->Version.Minor == TLS11_PROTOCOL_VERSION_MINOR) ||
+             (RecordHeader->Version.Minor == TLS12_PROTOCOL_VERSION_MINOR)) &&
+            (SwapBytes16 (RecordHeader->Length) <= TLS_CIPHERTEXT_RECORD_MAX_PAYLOAD_LENGTH)))
+      {
+        return EFI_PROTOCOL_ERROR;
+      }
+
+      if (Available >= TLS_RECORD_HEADER_LENGTH + SwapBytes16 (RecordHeader->Length)) {
+        break;
+      }
+    }
+
+    Status = TlsFillRxBuffer (HttpInstance, Timeout);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  Size = TLS_RECORD_HEADER_LENGTH + SwapBytes16 (RecordHeader->Length);
+
+  //
+  // Take the complete application data records following it, up to the
+  // first record of another type.
+  //
+  if (RecordHeader->ContentType == TlsContentTypeApplicationData) {
+    while (Available - Size >= TLS_RECORD_HEADER_LENGTH) {
+      RecordHeader = (TLS_RECORD_HEADER *)(HttpInstance->TlsRxBuffer + HttpInstance->TlsRxHead + Size);
+      Length       = TLS_RECORD_HEADER_LENGTH + SwapBytes16 (RecordHeader->Length);
+      if ((RecordHeader->ContentType != TlsContentTypeApplicationData) ||
+          (RecordHeader->Version.Major != 0x03) ||
+          (SwapBytes16 (RecordHeader->Length) > TLS_CIPHERTEXT_RECORD_MAX_PAYLOAD_LENGTH) ||
+          (Available - Size < Length))
+      {
+        break;
+      }
+
+      Size += Length;
+    }
+  }
+
+  *Records                 = HttpInstance->TlsRxBuffer + HttpInstance->TlsRxHead;
+  *RecordsSize             = Size;
+  HttpInstance->TlsRxHead += Size;
+
+  return EFI_SUCCESS;
+}
+
 /**
   Receive one TLS PDU. An TLS PDU contains an TLS record header and its
   corresponding record data. These two parts will be put into two blocks of buffers in the
@@ -1193,6 +1354,12 @@ TlsConnectSession (
   Pdu       = NULL;
   BufferIn  = NULL;
 
+  //
+  // Drop the data left over from an earlier connection.
+  //
+  HttpInstance->TlsRxHead = 0;
+  HttpInstance->TlsRxTail = 0;
+
   //
   // Initialize TLS state.
   //
@@ -1589,6 +1756,15 @@ TlsProcessMessage (
     goto ON_EXIT;
   }
 
+  //
+  // A single processed fragment is handed to the caller as is.
+  //
+  if (FragmentCount == 1) {
+    Fragment->Len  = FragmentTable->FragmentLength;
+    Fragment->Bulk = FragmentTable->FragmentBuffer;
+    goto ON_EXIT;
+  }
+
   //
   // Calculate the size according to FragmentTable.
   //
@@ -1648,7 +1824,7 @@ ON_EXIT:
 }
 
 /**
-  Receive one fragment decrypted from one TLS record.
+  Receive one fragment decrypted from the TLS records received.
 
   @param[in]           HttpInstance    Pointer to HTTP_PROTOCOL structure.
   @param[in, out]      Fragment        The received Fragment.
@@ -1669,11 +1845,14 @@ HttpsReceive (
   )
 {
   EFI_STATUS         Status;
-  NET_BUF            *Pdu;
+  UINT8              *Records;
+  UINTN              RecordsSize;
   TLS_RECORD_HEADER  RecordHeader;
   UINT8              *BufferIn;
   UINTN              BufferInSize;
   NET_FRAGMENT       TempFragment;
+  UINT32             Offset;
+  UINT16             Length;
   UINT8              *BufferOut;
   UINTN              BufferOutSize;
   NET_BUF            *PacketOut;
@@ -1682,7 +1861,8 @@ HttpsReceive (
   UINTN              GetSessionDataBufferSize;
 
   Status                   = EFI_SUCCESS;
-  Pdu                      = NULL;
+  Records                  = NULL;
+  RecordsSize              = 0;
   BufferIn                 = NULL;
   BufferInSize             = 0;
   BufferOut                = NULL;
@@ -1693,29 +1873,28 @@ HttpsReceive (
   GetSessionDataBufferSize = 0;
 
   //
-  // Receive only one TLS record
+  // Receive one TLS record, or a batch of application data records.
   //
-  Status = TlsReceiveOnePdu (HttpInstance, &Pdu, Timeout);
+  Status = TlsReceiveRecords (HttpInstance, &Records, &RecordsSize, Timeout);
   if (EFI_ERROR (Status)) {
     return Status;
   }
 
-  BufferInSize = Pdu->TotalSize;
-  BufferIn     = AllocateZeroPool (BufferInSize);
-  if (BufferIn == NULL) {
-    Status = EFI_OUT_OF_RESOURCES;
-    NetbufFree (Pdu);
-    return Status;
-  }
-
-  NetbufCopy (Pdu, 0, (UINT32)BufferInSize, BufferIn);
-
-  NetbufFree (Pdu);
-
   //
   // Handle Receive data.
   //
-  RecordHeader = *(TLS_RECORD_HEADER *)BufferIn;
+  RecordHeader = *(TLS_RECORD_HEADER *)Records;
+  if (RecordHeader.ContentType != TlsContentTypeApplicationData) {
+    //
+    // Other records are handled from a copy of their own.
+    //
+    BufferInSize = RecordsSize;
+    BufferIn     = AllocateCopyPool (BufferInSize, Records);
+    if (BufferIn == NULL) {
+      Status = EFI_OUT_OF_RESOURCES;
+      return Status;
+    }
+  }
 
   if ((RecordHeader.ContentType == TlsContentTypeApplicationData) &&
       (RecordHeader.Version.Major == 0x03) &&
@@ -1725,18 +1904,16 @@ HttpsReceive (
       )
   {
     //
-    // Decrypt Packet.
+    // Decrypt Packet. The records are read straight from the receive buffer,
+    // the plain text is returned in a buffer allocated by the TLS driver.
     //
     Status = TlsProcessMessage (
                HttpInstance,
-               BufferIn,
-               BufferInSize,
+               Records,
+               RecordsSize,
                EfiTlsDecrypt,
                &TempFragment
                );
-
-    FreePool (BufferIn);
-
     if (EFI_ERROR (Status)) {
       if (Status == EFI_ABORTED) {
         //
@@ -1807,23 +1984,23 @@ HttpsReceive (
     }
 
     //
-    // Parsing buffer.
+    // Parsing buffer. Strip the record headers in place, the buffer in
+    // TempFragment is returned to the caller. Each decrypted record header
+    // carries the length of its plain text in host byte order.
     //
-    ASSERT (((TLS_RECORD_HEADER *)(TempFragment.Bulk))->ContentType == TlsContentTypeApplicationData);
-
-    BufferInSize = ((TLS_RECORD_HEADER *)(TempFragment.Bulk))->Length;
-    BufferIn     = AllocateZeroPool (BufferInSize);
-    if (BufferIn == NULL) {
-      Status = EFI_OUT_OF_RESOURCES;
-      return Status;
-    }
+    BufferIn     = TempFragment.Bulk;
+    BufferInSize = 0;
+    Offset       = 0;
+    while (Offset < TempFragment.Len) {
+      ASSERT (((TLS_RECORD_HEADER *)(BufferIn + Offset))->ContentType == TlsContentTypeApplicationData);
 
-    CopyMem (BufferIn, TempFragment.Bulk + TLS_RECORD_HEADER_LENGTH, BufferInSize);
+      Length = ((TLS_RECORD_HEADER *)(BufferIn + Offset))->Length;
+      ASSERT (Offset + TLS_RECORD_HEADER_LENGTH + Length <= TempFragment.Len);
 
-    //
-    // Free the buffer in TempFragment.
-    //
-    FreePool (TempFragment.Bulk);
+      CopyMem (BufferIn + BufferInSize, BufferIn + Offset + TLS_RECORD_HEADER_LENGTH, Length);
+      BufferInSize += Length;
+      Offset       += TLS_RECORD_HEADER_LENGTH + Length;
+    }
   } else if ((RecordHeader.ContentType == TlsContentTypeAlert) &&
              (RecordHeader.Version.Major == 0x03) &&
              ((RecordHeader.Version.Minor == TLS10_PROTOCOL_VERSION_MINOR) ||
@@ -14,6 +14,12 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #define HTTPS_FLAG  "https://"
 
+//
+// The size of the buffer for the data received from TCP, which holds a few
+// TLS records of the maximum size.
+//
+#define HTTPS_RX_BUFFER_SIZE  (4 * (TLS_RECORD_HEADER_LENGTH + TLS_CIPHERTEXT_RECORD_MAX_PAYLOAD_LENGTH))
+
 /**
   Check whether the Url is from Https.
 
@@ -146,6 +152,34 @@ TlsCommonReceive (
   IN     EFI_EVENT      Timeout
   );
 
+/**
+  Receive the complete TLS records available in the receive buffer.
+
+  At least one record is received. If it is an application data record, the
+  application data records following it in the receive buffer are received
+  with it, so that they are decrypted together.
+
+  @param[in, out]      HttpInstance    Pointer to HTTP_PROTOCOL structure.
+  @param[out]          Records         The received TLS records. They remain valid
+                                       until the next receive.
+  @param[out]          RecordsSize     The size of the received TLS records.
+  @param[in]           Timeout         The time to wait for connection done.
+
+  @retval EFI_SUCCESS          The TLS records are received.
+  @retval EFI_OUT_OF_RESOURCES Can't allocate memory resources.
+  @retval EFI_PROTOCOL_ERROR   An unexpected TLS packet was received.
+  @retval Others               Other errors as indicated.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsReceiveRecords (
+  IN OUT HTTP_PROTOCOL  *HttpInstance,
+  OUT UINT8             **Records,
+  OUT UINTN             *RecordsSize,
+  IN     EFI_EVENT      Timeout
+  );
+
 /**
   Receive one TLS PDU. An TLS PDU contains an TLS record header and its
   corresponding record data. These two parts will be put into two blocks of buffers in the
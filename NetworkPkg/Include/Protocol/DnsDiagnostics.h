@@ -0,0 +1,82 @@
+/** @file
+  This file defines the EDKII DNS Diagnostics Protocol interface.
+
+  The protocol is installed by DnsDxe on its image handle. It reports the
+  counters of the DNS cache shared by all DNSv4 and DNSv6 instances.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef EDKII_DNS_DIAGNOSTICS_H_
+#define EDKII_DNS_DIAGNOSTICS_H_
+
+#define EDKII_DNS_DIAGNOSTICS_PROTOCOL_GUID \
+  { \
+    0x5a94f0c3, 0x0fde, 0x4a63, {0x88, 0x75, 0xe2, 0xcd, 0xbc, 0x15, 0x50, 0x6a} \
+  }
+
+typedef struct _EDKII_DNS_DIAGNOSTICS_PROTOCOL EDKII_DNS_DIAGNOSTICS_PROTOCOL;
+
+///
+/// The counters of the DNS cache.
+///
+typedef struct {
+  ///
+  /// The number of DNSv4 host name lookups answered from the cache.
+  ///
+  UINT64    Dns4CacheHits;
+  ///
+  /// The number of DNSv4 host name lookups sent to the DNS server because the
+  /// cache had no address for the host.
+  ///
+  UINT64    Dns4CacheMisses;
+  ///
+  /// The number of DNSv6 host name lookups answered from the cache.
+  ///
+  UINT64    Dns6CacheHits;
+  ///
+  /// The number of DNSv6 host name lookups sent to the DNS server because the
+  /// cache had no address for the host.
+  ///
+  UINT64    Dns6CacheMisses;
+  ///
+  /// The number of cache entries removed because their TTL expired.
+  ///
+  UINT64    ExpiredEntries;
+  ///
+  /// The number of entries currently in the DNSv4 cache.
+  ///
+  UINT64    Dns4CacheEntries;
+  ///
+  /// The number of entries currently in the DNSv6 cache.
+  ///
+  UINT64    Dns6CacheEntries;
+} EDKII_DNS_CACHE_STATISTICS;
+
+/**
+  Get the counters of the DNS cache.
+
+  @param[in]  This                Pointer to the EDKII_DNS_DIAGNOSTICS_PROTOCOL instance.
+  @param[out] Statistics          Pointer to the buffer to receive the counters.
+
+  @retval EFI_SUCCESS             The counters are returned.
+  @retval EFI_INVALID_PARAMETER   This or Statistics is NULL.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_DNS_DIAGNOSTICS_GET_CACHE_STATISTICS)(
+  IN  EDKII_DNS_DIAGNOSTICS_PROTOCOL  *This,
+  OUT EDKII_DNS_CACHE_STATISTICS      *Statistics
+  );
+
+///
+/// EDKII DNS Diagnostics Protocol reports the cache counters of DnsDxe.
+///
+struct _EDKII_DNS_DIAGNOSTICS_PROTOCOL {
+  EDKII_DNS_DIAGNOSTICS_GET_CACHE_STATISTICS    GetCacheStatistics;
+};
+
+extern EFI_GUID  gEdkiiDnsDiagnosticsProtocolGuid;
+
+#endif /* EDKII_DNS_DIAGNOSTICS_H_ */
@@ -0,0 +1,123 @@
+/** @file
+  This file defines the EDKII MNP Diagnostics Protocol interface.
+
+  The protocol is installed by MnpDxe on each MNP service handle, next to the
+  Managed Network Service Binding Protocol. It reports the receive counters of
+  the underlying device and of each MNP child instance created on the service.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef EDKII_MNP_DIAGNOSTICS_H_
+#define EDKII_MNP_DIAGNOSTICS_H_
+
+#define EDKII_MNP_DIAGNOSTICS_PROTOCOL_GUID \
+  { \
+    0x62a21b44, 0x6285, 0x4c0a, {0xb4, 0x93, 0x9d, 0x54, 0x15, 0x77, 0xb7, 0x9d} \
+  }
+
+typedef struct _EDKII_MNP_DIAGNOSTICS_PROTOCOL EDKII_MNP_DIAGNOSTICS_PROTOCOL;
+
+///
+/// The counters of the network device, shared by all MNP services on it.
+///
+typedef struct {
+  ///
+  /// The number of frames received from the Simple Network Protocol.
+  ///
+  UINT64    ReceivedPackets;
+  ///
+  /// The number of times the system poll timer fired.
+  ///
+  UINT64    PollCount;
+  ///
+  /// The number of system polls that received a full batch of frames.
+  ///
+  UINT64    FullBatchCount;
+  ///
+  /// The number of receive attempts skipped for lack of a free receive buffer.
+  ///
+  UINT64    NoBufferCount;
+  ///
+  /// The current period of the system poll timer, in 100ns units.
+  ///
+  UINT64    PollInterval;
+} EDKII_MNP_DEVICE_STATISTICS;
+
+///
+/// The counters of one MNP child instance.
+///
+typedef struct {
+  ///
+  /// The number of packets matching the receive filters of the instance.
+  ///
+  UINT64    ReceivedPackets;
+  ///
+  /// The number of packets handed to the receive tokens of the instance.
+  ///
+  UINT64    DeliveredPackets;
+  ///
+  /// The number of packets dropped because the receive queue was full.
+  ///
+  UINT64    DroppedPackets;
+  ///
+  /// The number of packets dropped because the receive queue timeout expired.
+  ///
+  UINT64    TimedOutPackets;
+  ///
+  /// The number of packets transmitted by the instance.
+  ///
+  UINT64    TransmittedPackets;
+  ///
+  /// The number of packets currently waiting for a receive token.
+  ///
+  UINT64    QueuedPackets;
+} EDKII_MNP_INSTANCE_STATISTICS;
+
+/**
+  Get the counters of the network device the MNP service runs on.
+
+  @param[in]  This                Pointer to the EDKII_MNP_DIAGNOSTICS_PROTOCOL instance.
+  @param[out] Statistics          Pointer to the buffer to receive the counters.
+
+  @retval EFI_SUCCESS             The counters are returned.
+  @retval EFI_INVALID_PARAMETER   This or Statistics is NULL.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_MNP_DIAGNOSTICS_GET_DEVICE_STATISTICS)(
+  IN  EDKII_MNP_DIAGNOSTICS_PROTOCOL  *This,
+  OUT EDKII_MNP_DEVICE_STATISTICS     *Statistics
+  );
+
+/**
+  Get the counters of an MNP child instance of the MNP service.
+
+  @param[in]  This                Pointer to the EDKII_MNP_DIAGNOSTICS_PROTOCOL instance.
+  @param[in]  ChildHandle         The handle of the MNP child instance.
+  @param[out] Statistics          Pointer to the buffer to receive the counters.
+
+  @retval EFI_SUCCESS             The counters are returned.
+  @retval EFI_INVALID_PARAMETER   This, ChildHandle or Statistics is NULL.
+  @retval EFI_NOT_FOUND           ChildHandle is not a child of the MNP service.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_MNP_DIAGNOSTICS_GET_INSTANCE_STATISTICS)(
+  IN  EDKII_MNP_DIAGNOSTICS_PROTOCOL  *This,
+  IN  EFI_HANDLE                      ChildHandle,
+  OUT EDKII_MNP_INSTANCE_STATISTICS   *Statistics
+  );
+
+///
+/// EDKII MNP Diagnostics Protocol reports the receive counters of MnpDxe.
+///
+struct _EDKII_MNP_DIAGNOSTICS_PROTOCOL {
+  EDKII_MNP_DIAGNOSTICS_GET_DEVICE_STATISTICS      GetDeviceStatistics;
+  EDKII_MNP_DIAGNOSTICS_GET_INSTANCE_STATISTICS    GetInstanceStatistics;
+};
+
+extern EFI_GUID  gEdkiiMnpDiagnosticsProtocolGuid;
+
+#endif /* EDKII_MNP_DIAGNOSTICS_H_ */
@@ -14,6 +14,11 @@ EFI_SERVICE_BINDING_PROTOCOL  mMnpServiceBindingProtocol = {
   MnpServiceBindingDestroyChild
 };
 
+EDKII_MNP_DIAGNOSTICS_PROTOCOL  mMnpDiagnosticsProtocol = {
+  MnpGetDeviceStatistics,
+  MnpGetInstanceStatistics
+};
+
 EFI_MANAGED_NETWORK_PROTOCOL  mMnpProtocolTemplate = {
   MnpGetModeData,
   MnpConfigure,
@@ -721,6 +726,7 @@ MnpCreateServiceData (
   // Copy the ServiceBinding structure.
   //
   CopyMem (&MnpServiceData->ServiceBinding, &mMnpServiceBindingProtocol, sizeof (EFI_SERVICE_BINDING_PROTOCOL));
+  CopyMem (&MnpServiceData->Diagnostics, &mMnpDiagnosticsProtocol, sizeof (EDKII_MNP_DIAGNOSTICS_PROTOCOL));
 
   //
   // Initialize the lists.
@@ -776,12 +782,14 @@ MnpCreateServiceData (
   MnpServiceData->Priority      = Priority;
 
   //
-  // Install the MNP Service Binding Protocol
+  // Install the MNP Service Binding Protocol and the MNP Diagnostics Protocol
   //
   Status = gBS->InstallMultipleProtocolInterfaces (
                   &MnpServiceHandle,
                   &gEfiManagedNetworkServiceBindingProtocolGuid,
                   &MnpServiceData->ServiceBinding,
+                  &gEdkiiMnpDiagnosticsProtocolGuid,
+                  &MnpServiceData->Diagnostics,
                   NULL
                   );
 
@@ -811,12 +819,14 @@ MnpDestroyServiceData (
   EFI_STATUS  Status;
 
   //
-  // Uninstall the MNP Service Binding Protocol
+  // Uninstall the MNP Service Binding Protocol and the MNP Diagnostics Protocol
   //
   Status = gBS->UninstallMultipleProtocolInterfaces (
                   MnpServiceData->ServiceHandle,
                   &gEfiManagedNetworkServiceBindingProtocolGuid,
                   &MnpServiceData->ServiceBinding,
+                  &gEdkiiMnpDiagnosticsProtocolGuid,
+                  &MnpServiceData->Diagnostics,
                   NULL
                   );
   if (EFI_ERROR (Status)) {
@@ -1273,6 +1283,7 @@ MnpStart (
     }
 
     MnpDeviceData->EnableSystemPoll = EnableSystemPoll;
+    MnpDeviceData->PollInterval     = MNP_SYS_POLL_INTERVAL;
   }
 
   //
@@ -0,0 +1,107 @@
+/** @file
+  Implementation of the EDKII MNP Diagnostics Protocol.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "MnpImpl.h"
+
+/**
+  Get the counters of the network device the MNP service runs on.
+
+  @param[in]  This                Pointer to the EDKII_MNP_DIAGNOSTICS_PROTOCOL instance.
+  @param[out] Statistics          Pointer to the buffer to receive the counters.
+
+  @retval EFI_SUCCESS             The counters are returned.
+  @retval EFI_INVALID_PARAMETER   This or Statistics is NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+MnpGetDeviceStatistics (
+  IN  EDKII_MNP_DIAGNOSTICS_PROTOCOL  *This,
+  OUT EDKII_MNP_DEVICE_STATISTICS     *Statistics
+  )
+{
+  MNP_SERVICE_DATA  *MnpServiceData;
+  MNP_DEVICE_DATA   *MnpDeviceData;
+  EFI_TPL           OldTpl;
+
+  if ((This == NULL) || (Statistics == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  MnpServiceData = MNP_SERVICE_DATA_FROM_DIAGNOSTICS (This);
+  MnpDeviceData  = MnpServiceData->MnpDeviceData;
+  NET_CHECK_SIGNATURE (MnpDeviceData, MNP_DEVICE_DATA_SIGNATURE);
+
+  //
+  // The counters are updated at TPL_NOTIFY at most.
+  //
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+
+  CopyMem (Statistics, &MnpDeviceData->Statistics, sizeof (EDKII_MNP_DEVICE_STATISTICS));
+  Statistics->PollInterval = MnpDeviceData->EnableSystemPoll ? MnpDeviceData->PollInterval : 0;
+
+  gBS->RestoreTPL (OldTpl);
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Get the counters of an MNP child instance of the MNP service.
+
+  @param[in]  This                Pointer to the EDKII_MNP_DIAGNOSTICS_PROTOCOL instance.
+  @param[in]  ChildHandle         The handle of the MNP child instance.
+  @param[out] Statistics          Pointer to the buffer to receive the counters.
+
+  @retval EFI_SUCCESS             The counters are returned.
+  @retval EFI_INVALID_PARAMETER   This, ChildHandle or Statistics is NULL.
+  @retval EFI_NOT_FOUND           ChildHandle is not a child of the MNP service.
+
+**/
+EFI_STATUS
+EFIAPI
+MnpGetInstanceStatistics (
+  IN  EDKII_MNP_DIAGNOSTICS_PROTOCOL  *This,
+  IN  EFI_HANDLE                      ChildHandle,
+  OUT EDKII_MNP_INSTANCE_STATISTICS   *Statistics
+  )
+{
+  MNP_SERVICE_DATA   *MnpServiceData;
+  MNP_INSTANCE_DATA  *Instance;
+  LIST_ENTRY         *Entry;
+  EFI_STATUS         Status;
+  EFI_TPL            OldTpl;
+
+  if ((This == NULL) || (ChildHandle == NULL) || (Statistics == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  MnpServiceData = MNP_SERVICE_DATA_FROM_DIAGNOSTICS (This);
+  Status         = EFI_NOT_FOUND;
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+
+  //
+  // Only look up the children of this service, the MNP protocol on the handle
+  // may be produced by another driver.
+  //
+  NET_LIST_FOR_EACH (Entry, &MnpServiceData->ChildrenList) {
+    Instance = NET_LIST_USER_STRUCT (Entry, MNP_INSTANCE_DATA, InstEntry);
+    NET_CHECK_SIGNATURE (Instance, MNP_INSTANCE_DATA_SIGNATURE);
+
+    if (Instance->Handle == ChildHandle) {
+      CopyMem (Statistics, &Instance->Statistics, sizeof (EDKII_MNP_INSTANCE_STATISTICS));
+      Statistics->QueuedPackets = Instance->RcvdPacketQueueSize;
+      Status                    = EFI_SUCCESS;
+      break;
+    }
+  }
+
+  gBS->RestoreTPL (OldTpl);
+
+  return Status;
+}
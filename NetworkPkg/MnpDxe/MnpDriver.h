@@ -15,6 +15,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Protocol/SimpleNetwork.h>
 #include <Protocol/ServiceBinding.h>
 #include <Protocol/VlanConfig.h>
+#include <Protocol/MnpDiagnostics.h>
 
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
@@ -69,6 +70,10 @@ typedef struct {
 
   EFI_EVENT                      PollTimer;
   BOOLEAN                        EnableSystemPoll;
+  //
+  // The current period of the PollTimer, adapted to the received packet rate.
+  //
+  UINT64                         PollInterval;
 
   EFI_EVENT                      TimeoutCheckTimer;
   EFI_EVENT                      MediaDetectTimer;
@@ -85,6 +90,8 @@ typedef struct {
   UINT32                         BufferLength;
   UINT32                         PaddingSize;
   NET_BUF                        *RxNbufCache;
+
+  EDKII_MNP_DEVICE_STATISTICS    Statistics;
 } MNP_DEVICE_DATA;
 
 #define MNP_DEVICE_DATA_FROM_THIS(a) \
@@ -98,22 +105,23 @@ typedef struct {
 #define MNP_SERVICE_DATA_SIGNATURE  SIGNATURE_32 ('M', 'n', 'p', 'S')
 
 typedef struct {
-  UINT32                          Signature;
+  UINT32                            Signature;
 
-  LIST_ENTRY                      Link;
+  LIST_ENTRY                        Link;
 
-  MNP_DEVICE_DATA                 *MnpDeviceData;
-  EFI_HANDLE                      ServiceHandle;
-  EFI_SERVICE_BINDING_PROTOCOL    ServiceBinding;
-  EFI_DEVICE_PATH_PROTOCOL        *DevicePath;
+  MNP_DEVICE_DATA                   *MnpDeviceData;
+  EFI_HANDLE                        ServiceHandle;
+  EFI_SERVICE_BINDING_PROTOCOL      ServiceBinding;
+  EDKII_MNP_DIAGNOSTICS_PROTOCOL    Diagnostics;
+  EFI_DEVICE_PATH_PROTOCOL          *DevicePath;
 
-  LIST_ENTRY                      ChildrenList;
-  UINTN                           ChildrenNumber;
+  LIST_ENTRY                        ChildrenList;
+  UINTN                             ChildrenNumber;
 
-  UINT32                          Mtu;
+  UINT32                            Mtu;
 
-  UINT16                          VlanId;
-  UINT8                           Priority;
+  UINT16                            VlanId;
+  UINT8                             Priority;
 } MNP_SERVICE_DATA;
 
 #define MNP_SERVICE_DATA_FROM_THIS(a) \
@@ -132,6 +140,14 @@ typedef struct {
   MNP_SERVICE_DATA_SIGNATURE \
   )
 
+#define MNP_SERVICE_DATA_FROM_DIAGNOSTICS(a) \
+  CR ( \
+  (a), \
+  MNP_SERVICE_DATA, \
+  Diagnostics, \
+  MNP_SERVICE_DATA_SIGNATURE \
+  )
+
 /**
   Test to see if this driver supports ControllerHandle. This service
   is called by the EFI boot service ConnectController(). In
@@ -14,6 +14,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define NET_ETHER_FCS_SIZE  4
 
 #define MNP_SYS_POLL_INTERVAL        (10 * TICKS_PER_MS)    // 10 milliseconds
+#define MNP_SYS_POLL_INTERVAL_MIN    (1 * TICKS_PER_MS)     // 1 millisecond
 #define MNP_TIMEOUT_CHECK_INTERVAL   (50 * TICKS_PER_MS)    // 50 milliseconds
 #define MNP_MEDIA_DETECT_INTERVAL    (500 * TICKS_PER_MS)   // 500 milliseconds
 #define MNP_TX_TIMEOUT_TIME          (500 * TICKS_PER_MS)   // 500 milliseconds
@@ -25,6 +26,11 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #define MNP_MAX_RCVD_PACKET_QUE_SIZE  256
 
+//
+// The maximum number of packets received from Snp in one poll.
+//
+#define MNP_RECEIVE_BATCH_SIZE  32
+
 #define MNP_RECEIVE_UNICAST    0x01
 #define MNP_RECEIVE_BROADCAST  0x02
 
@@ -66,6 +72,8 @@ typedef struct {
   EFI_MANAGED_NETWORK_CONFIG_DATA    ConfigData;
 
   UINT8                              ReceiveFilter;
+
+  EDKII_MNP_INSTANCE_STATISTICS      Statistics;
 } MNP_INSTANCE_DATA;
 
 typedef struct {
@@ -430,6 +438,24 @@ MnpReceivePacket (
   IN OUT MNP_DEVICE_DATA  *MnpDeviceData
   );
 
+/**
+  Receive and deliver the packets pending in Snp, up to MNP_RECEIVE_BATCH_SIZE
+  packets.
+
+  @param[in, out]  MnpDeviceData        Pointer to the mnp device context data.
+  @param[out]      Received             The number of packets received.
+
+  @retval EFI_SUCCESS           At least one packet is received.
+  @retval Others                No packet is received, the error returned by
+                                MnpReceivePacket().
+
+**/
+EFI_STATUS
+MnpReceivePackets (
+  IN OUT MNP_DEVICE_DATA  *MnpDeviceData,
+  OUT    UINTN            *Received
+  );
+
 /**
   Allocate a free NET_BUF from MnpDeviceData->FreeNbufQue. If there is none
   in the queue, first try to allocate some and add them into the queue, then
@@ -895,4 +921,41 @@ MnpConfigReceiveFilters (
   IN MNP_DEVICE_DATA  *MnpDeviceData
   );
 
+/**
+  Get the counters of the network device the MNP service runs on.
+
+  @param[in]  This                Pointer to the EDKII_MNP_DIAGNOSTICS_PROTOCOL instance.
+  @param[out] Statistics          Pointer to the buffer to receive the counters.
+
+  @retval EFI_SUCCESS             The counters are returned.
+  @retval EFI_INVALID_PARAMETER   This or Statistics is NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+MnpGetDeviceStatistics (
+  IN  EDKII_MNP_DIAGNOSTICS_PROTOCOL  *This,
+  OUT EDKII_MNP_DEVICE_STATISTICS     *Statistics
+  );
+
+/**
+  Get the counters of an MNP child instance of the MNP service.
+
+  @param[in]  This                Pointer to the EDKII_MNP_DIAGNOSTICS_PROTOCOL instance.
+  @param[in]  ChildHandle         The handle of the MNP child instance.
+  @param[out] Statistics          Pointer to the buffer to receive the counters.
+
+  @retval EFI_SUCCESS             The counters are returned.
+  @retval EFI_INVALID_PARAMETER   This, ChildHandle or Statistics is NULL.
+  @retval EFI_NOT_FOUND           ChildHandle is not a child of the MNP service.
+
+**/
+EFI_STATUS
+EFIAPI
+MnpGetInstanceStatistics (
+  IN  EDKII_MNP_DIAGNOSTICS_PROTOCOL  *This,
+  IN  EFI_HANDLE                      ChildHandle,
+  OUT EDKII_MNP_INSTANCE_STATISTICS   *Statistics
+  );
+
 #endif
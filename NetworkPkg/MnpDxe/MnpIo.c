@@ -352,6 +352,7 @@ MnpInstanceDeliverPacket (
   //
   NetListRemoveHead (&Instance->RcvdPacketQueue);
   Instance->RcvdPacketQueueSize--;
+  Instance->Statistics.DeliveredPackets++;
 
   RxData  = &RxDataWrap->RxData;
   SnpMode = MnpDeviceData->Snp->Mode;
@@ -496,6 +497,7 @@ MnpQueueRcvdPacket (
     //
     MnpRecycleRxData (NULL, (VOID *)OldRxDataWrap);
     Instance->RcvdPacketQueueSize--;
+    Instance->Statistics.DroppedPackets++;
   }
 
   //
@@ -508,6 +510,7 @@ MnpQueueRcvdPacket (
   //
   InsertTailList (&Instance->RcvdPacketQueue, &RxDataWrap->WrapEntry);
   Instance->RcvdPacketQueueSize++;
+  Instance->Statistics.ReceivedPackets++;
 }
 
 /**
@@ -860,6 +863,7 @@ MnpReceivePacket (
       //
       // No available buffer in the buffer pool.
       //
+      MnpDeviceData->Statistics.NoBufferCount++;
       return EFI_DEVICE_ERROR;
     }
 
@@ -903,6 +907,8 @@ MnpReceivePacket (
     return EFI_DEVICE_ERROR;
   }
 
+  MnpDeviceData->Statistics.ReceivedPackets++;
+
   Trimmed = 0;
   if (Nbuf->TotalSize != BufLen) {
     //
@@ -954,6 +960,7 @@ MnpReceivePacket (
     MnpDeviceData->RxNbufCache = Nbuf;
     if (Nbuf == NULL) {
       DEBUG ((DEBUG_ERROR, "MnpReceivePacket: Alloc packet for receiving cache failed.\n"));
+      MnpDeviceData->Statistics.NoBufferCount++;
       return EFI_DEVICE_ERROR;
     }
 
@@ -985,6 +992,90 @@ EXIT:
   return Status;
 }
 
+/**
+  Receive and deliver the packets pending in Snp, up to MNP_RECEIVE_BATCH_SIZE
+  packets.
+
+  @param[in, out]  MnpDeviceData        Pointer to the mnp device context data.
+  @param[out]      Received             The number of packets received.
+
+  @retval EFI_SUCCESS           At least one packet is received.
+  @retval Others                No packet is received, the error returned by
+                                MnpReceivePacket().
+
+**/
+EFI_STATUS
+MnpReceivePackets (
+  IN OUT MNP_DEVICE_DATA  *MnpDeviceData,
+  OUT    UINTN            *Received
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Count;
+
+  Status = EFI_NOT_READY;
+  for (Count = 0; Count < MNP_RECEIVE_BATCH_SIZE; Count++) {
+    Status = MnpReceivePacket (MnpDeviceData);
+
+    //
+    // Dispatch the DPC queued by the NotifyFunction of rx token's events, so
+    // that the receivers queue their tokens again before the next packet.
+    //
+    DispatchDpc ();
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+  }
+
+  *Received = Count;
+
+  return (Count > 0) ? EFI_SUCCESS : Status;
+}
+
+/**
+  Adapt the period of the system poll timer to the number of packets received
+  by the last poll.
+
+  A full batch means more packets are pending in Snp, so the period is halved
+  down to MNP_SYS_POLL_INTERVAL_MIN. An empty poll doubles it back up to
+  MNP_SYS_POLL_INTERVAL.
+
+  @param[in, out]  MnpDeviceData        Pointer to the mnp device context data.
+  @param[in]       Received             The number of packets received.
+
+**/
+STATIC
+VOID
+MnpUpdatePollInterval (
+  IN OUT MNP_DEVICE_DATA  *MnpDeviceData,
+  IN     UINTN            Received
+  )
+{
+  EFI_STATUS  Status;
+  UINT64      PollInterval;
+
+  PollInterval = MnpDeviceData->PollInterval;
+  if (Received == MNP_RECEIVE_BATCH_SIZE) {
+    MnpDeviceData->Statistics.FullBatchCount++;
+    PollInterval = MAX (PollInterval / 2, MNP_SYS_POLL_INTERVAL_MIN);
+  } else if (Received == 0) {
+    PollInterval = MIN (PollInterval * 2, MNP_SYS_POLL_INTERVAL);
+  }
+
+  if (PollInterval == MnpDeviceData->PollInterval) {
+    return;
+  }
+
+  Status = gBS->SetTimer (MnpDeviceData->PollTimer, TimerPeriodic, PollInterval);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "MnpUpdatePollInterval: gBS->SetTimer for PollTimer failed, %r.\n", Status));
+    return;
+  }
+
+  MnpDeviceData->PollInterval = PollInterval;
+}
+
 /**
   Remove the received packets if timeout occurs.
 
@@ -1044,6 +1135,7 @@ MnpCheckPacketTimeout (
           DEBUG ((DEBUG_WARN, "MnpCheckPacketTimeout: Received packet timeout.\n"));
           MnpRecycleRxData (NULL, RxDataWrap);
           Instance->RcvdPacketQueueSize--;
+          Instance->Statistics.TimedOutPackets++;
         }
       }
 
@@ -1099,17 +1191,19 @@ MnpSystemPoll (
   )
 {
   MNP_DEVICE_DATA  *MnpDeviceData;
+  UINTN            Received;
 
   MnpDeviceData = (MNP_DEVICE_DATA *)Context;
   NET_CHECK_SIGNATURE (MnpDeviceData, MNP_DEVICE_DATA_SIGNATURE);
 
+  MnpDeviceData->Statistics.PollCount++;
+
   //
   // Try to receive packets from Snp.
   //
-  MnpReceivePacket (MnpDeviceData);
+  MnpReceivePackets (MnpDeviceData, &Received);
 
-  //
-  // Dispatch the DPC queued by the NotifyFunction of rx token's events.
-  //
-  DispatchDpc ();
+  if (MnpDeviceData->EnableSystemPoll) {
+    MnpUpdatePollInterval (MnpDeviceData, Received);
+  }
 }
@@ -553,6 +553,9 @@ MnpTransmit (
   //  OK, send the packet synchronously.
   //
   Status = MnpSyncSendPacket (MnpServiceData, PktBuf, PktLen, Token);
+  if (!EFI_ERROR (Status)) {
+    Instance->Statistics.TransmittedPackets++;
+  }
 
 ON_EXIT:
   gBS->RestoreTPL (OldTpl);
@@ -756,6 +759,7 @@ MnpPoll (
   EFI_STATUS         Status;
   MNP_INSTANCE_DATA  *Instance;
   EFI_TPL            OldTpl;
+  UINTN              Received;
 
   if (This == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -771,14 +775,9 @@ MnpPoll (
   }
 
   //
-  // Try to receive packets.
-  //
-  Status = MnpReceivePacket (Instance->MnpServiceData->MnpDeviceData);
-
-  //
-  // Dispatch the DPC queued by the NotifyFunction of rx token's events.
+  // Try to receive the pending packets.
   //
-  DispatchDpc ();
+  Status = MnpReceivePackets (Instance->MnpServiceData->MnpDeviceData, &Received);
 
 ON_EXIT:
   gBS->RestoreTPL (OldTpl);
@@ -117,7 +117,7 @@ struct _MTFTP4_PROTOCOL {
   UINT16                    WindowSize;
 
   //
-  // Record the total received and saved block number.
+  // Record the total received block number.
   //
   UINT64                    TotalBlock;
 
@@ -126,6 +126,12 @@ struct _MTFTP4_PROTOCOL {
   //
   UINT64                    AckedBlock;
 
+  //
+  // Whether the hole in front of the blocks received out of order has been
+  // reported to the server.
+  //
+  BOOLEAN                   HoleAcked;
+
   //
   // The server's communication end point: IP and two ports. one for
   // initial request, one for its selected port.
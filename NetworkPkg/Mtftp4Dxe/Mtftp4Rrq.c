@@ -250,24 +250,51 @@ Mtftp4RrqHandleData (
   EFI_STATUS  Status;
   UINT16      BlockNum;
   INTN        Expected;
+  BOOLEAN     HoleFilled;
 
   *Completed = FALSE;
   Status     = EFI_SUCCESS;
+  HoleFilled = FALSE;
   BlockNum   = NTOHS (Packet->Data.Block);
   Expected   = Mtftp4GetNextBlockNum (&Instance->Blocks);
 
   ASSERT (Expected >= 0);
 
   //
-  // If we are active (Master) and received an unexpected packet, transmit
-  // the ACK for the block we received, then restart receiving the
-  // expected one. If we are passive (Slave), save the block.
+  // If we are active (Master) and received an unexpected packet, keep it
+  // if it belongs to the current window and the user provided a buffer, so
+  // that it isn't needed again once the missing blocks arrive. A CheckPacket
+  // callback that streams the data must see the blocks in order, so they
+  // are dropped otherwise. Transmit the ACK for the block before the hole
+  // once, then let the unexpected packets count towards the window as the
+  // expected ones do. If we are passive (Slave), save the block.
   //
   if (Instance->Master && (Expected != BlockNum)) {
-    //
-    // If Expected is 0, (UINT16) (Expected - 1) is also the expected Ack number (65535).
-    //
-    return Mtftp4RrqSendAck (Instance, (UINT16)(Expected - 1));
+    Instance->TotalBlock++;
+
+    if ((BlockNum > Expected) && (BlockNum - Expected < Instance->WindowSize)) {
+      if (Instance->Token->Buffer != NULL) {
+        Status = Mtftp4RrqSaveBlock (Instance, Packet, Len);
+
+        if (EFI_ERROR (Status)) {
+          return Status;
+        }
+      }
+
+      if (!Instance->HoleAcked) {
+        Instance->HoleAcked = TRUE;
+        return Mtftp4RrqSendAck (Instance, (UINT16)(Expected - 1));
+      }
+    }
+
+    if (Instance->TotalBlock - Instance->AckedBlock >= Instance->WindowSize) {
+      //
+      // If Expected is 0, (UINT16) (Expected - 1) is also the expected Ack number (65535).
+      //
+      return Mtftp4RrqSendAck (Instance, (UINT16)(Expected - 1));
+    }
+
+    return EFI_SUCCESS;
   }
 
   Status = Mtftp4RrqSaveBlock (Instance, Packet, Len);
@@ -277,7 +304,7 @@ Mtftp4RrqHandleData (
   }
 
   //
-  // Record the total received and saved block number.
+  // Record the total received block number.
   //
   Instance->TotalBlock++;
 
@@ -308,11 +335,17 @@ Mtftp4RrqHandleData (
       BlockNum   = Instance->LastBlock;
       *Completed = TRUE;
     } else {
-      BlockNum = (UINT16)(Expected - 1);
+      //
+      // If the block filled a hole and joined the blocks saved after it,
+      // ACK at once so that the server skips them.
+      //
+      HoleFilled = Instance->HoleAcked && (BlockNum != (UINT16)(Expected - 1));
+      BlockNum   = (UINT16)(Expected - 1);
     }
 
-    if ((Instance->WindowSize == (Instance->TotalBlock - Instance->AckedBlock)) || (Expected < 0)) {
-      Status = Mtftp4RrqSendAck (Instance, BlockNum);
+    if ((Instance->TotalBlock - Instance->AckedBlock >= Instance->WindowSize) || HoleFilled || (Expected < 0)) {
+      Instance->HoleAcked = FALSE;
+      Status              = Mtftp4RrqSendAck (Instance, BlockNum);
     }
   }
 
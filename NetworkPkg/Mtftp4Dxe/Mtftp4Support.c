@@ -225,6 +225,16 @@ Mtftp4RemoveBlockNum (
 
       return EFI_SUCCESS;
     } else {
+      //
+      // The block is received out of order, it belongs to the same round
+      // as the hole it is taken from.
+      //
+      *BlockCounter = Num;
+
+      if (Range->Round > 0) {
+        *BlockCounter += Range->Bound +  MultU64x32 ((UINTN)(Range->Round - 1), (UINT32)(Range->Bound + 1)) + 1;
+      }
+
       if (Range->End == Num) {
         Range->End--;
       } else {
@@ -234,7 +244,9 @@ Mtftp4RemoveBlockNum (
           return EFI_OUT_OF_RESOURCES;
         }
 
-        Range->End = Num - 1;
+        NewRange->Round = Range->Round;
+        NewRange->Bound = Range->Bound;
+        Range->End      = Num - 1;
         NetListInsertAfter (&Range->Link, &NewRange->Link);
       }
 
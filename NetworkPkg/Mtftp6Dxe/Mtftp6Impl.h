@@ -77,7 +77,7 @@ struct _MTFTP6_INSTANCE {
   UINT16                    WindowSize;
 
   //
-  // Record the total received and saved block number.
+  // Record the total received block number.
   //
   UINT64                    TotalBlock;
 
@@ -86,6 +86,12 @@ struct _MTFTP6_INSTANCE {
   //
   UINT64                    AckedBlock;
 
+  //
+  // Whether the hole in front of the blocks received out of order has been
+  // reported to the server.
+  //
+  BOOLEAN                   HoleAcked;
+
   EFI_IPv6_ADDRESS          ServerIp;
   UINT16                    ServerCmdPort;
   UINT16                    ServerDataPort;
@@ -220,20 +220,46 @@ Mtftp6RrqHandleData (
   EFI_STATUS  Status;
   UINT16      BlockNum;
   INTN        Expected;
+  BOOLEAN     HoleFilled;
 
   *IsCompleted = FALSE;
   Status       = EFI_SUCCESS;
+  HoleFilled   = FALSE;
   BlockNum     = NTOHS (Packet->Data.Block);
   Expected     = Mtftp6GetNextBlockNum (&Instance->BlkList);
 
   ASSERT (Expected >= 0);
 
   //
-  // If we are active (Master) and received an unexpected packet, transmit
-  // the ACK for the block we received, then restart receiving the
-  // expected one. If we are passive (Slave), save the block.
+  // If we are active (Master) and received an unexpected packet, keep it
+  // if it belongs to the current window and the user provided a buffer, so
+  // that it isn't needed again once the missing blocks arrive. A CheckPacket
+  // callback that streams the data must see the blocks in order, so they
+  // are dropped otherwise. Transmit the ACK for the block before the hole
+  // once, then let the unexpected packets count towards the window as the
+  // expected ones do. If we are passive (Slave), save the block.
   //
   if (Instance->IsMaster && (Expected != BlockNum)) {
+    Instance->TotalBlock++;
+
+    if ((BlockNum > Expected) && (BlockNum - Expected < Instance->WindowSize)) {
+      if (Instance->Token->Buffer != NULL) {
+        Status = Mtftp6RrqSaveBlock (Instance, Packet, Len, UdpPacket);
+
+        if (EFI_ERROR (Status)) {
+          return Status;
+        }
+      }
+
+      if (!Instance->HoleAcked) {
+        Instance->HoleAcked = TRUE;
+      } else if (Instance->TotalBlock - Instance->AckedBlock < Instance->WindowSize) {
+        return EFI_SUCCESS;
+      }
+    } else if (Instance->TotalBlock - Instance->AckedBlock < Instance->WindowSize) {
+      return EFI_SUCCESS;
+    }
+
     //
     // Free the received packet before send new packet in ReceiveNotify,
     // since the udpio might need to be reconfigured.
@@ -254,7 +280,7 @@ Mtftp6RrqHandleData (
   }
 
   //
-  // Record the total received and saved block number.
+  // Record the total received block number.
   //
   Instance->TotalBlock++;
 
@@ -284,7 +310,12 @@ Mtftp6RrqHandleData (
       BlockNum     = Instance->LastBlk;
       *IsCompleted = TRUE;
     } else {
-      BlockNum = (UINT16)(Expected - 1);
+      //
+      // If the block filled a hole and joined the blocks saved after it,
+      // ACK at once so that the server skips them.
+      //
+      HoleFilled = Instance->HoleAcked && (BlockNum != (UINT16)(Expected - 1));
+      BlockNum   = (UINT16)(Expected - 1);
     }
 
     //
@@ -294,8 +325,9 @@ Mtftp6RrqHandleData (
     NetbufFree (*UdpPacket);
     *UdpPacket = NULL;
 
-    if ((Instance->WindowSize == (Instance->TotalBlock - Instance->AckedBlock)) || (Expected < 0)) {
-      Status = Mtftp6RrqSendAck (Instance, BlockNum);
+    if ((Instance->TotalBlock - Instance->AckedBlock >= Instance->WindowSize) || HoleFilled || (Expected < 0)) {
+      Instance->HoleAcked = FALSE;
+      Status              = Mtftp6RrqSendAck (Instance, BlockNum);
     }
   }
 
@@ -337,7 +369,7 @@ Mtftp6RrqOackValid (
   // return the timeout matches that requested.
   //
   if ((((ReplyInfo->BitMap & MTFTP6_OPT_BLKSIZE_BIT) != 0) && (ReplyInfo->BlkSize > RequestInfo->BlkSize)) ||
-      (((ReplyInfo->BitMap & MTFTP6_OPT_WINDOWSIZE_BIT) != 0) && (ReplyInfo->BlkSize > RequestInfo->BlkSize)) ||
+      (((ReplyInfo->BitMap & MTFTP6_OPT_WINDOWSIZE_BIT) != 0) && (ReplyInfo->WindowSize > RequestInfo->WindowSize)) ||
       (((ReplyInfo->BitMap & MTFTP6_OPT_TIMEOUT_BIT) != 0) && (ReplyInfo->Timeout != RequestInfo->Timeout))
       )
   {
@@ -226,6 +226,16 @@ Mtftp6RemoveBlockNum (
 
       return EFI_SUCCESS;
     } else {
+      //
+      // The block is received out of order, it belongs to the same round
+      // as the hole it is taken from.
+      //
+      *BlockCounter = Num;
+
+      if (Range->Round > 0) {
+        *BlockCounter += Range->Bound +  MultU64x32 (Range->Round - 1, (UINT32)(Range->Bound + 1)) + 1;
+      }
+
       if (Range->End == Num) {
         Range->End--;
       } else {
@@ -235,7 +245,9 @@ Mtftp6RemoveBlockNum (
           return EFI_OUT_OF_RESOURCES;
         }
 
-        Range->End = Num - 1;
+        NewRange->Round = Range->Round;
+        NewRange->Bound = Range->Bound;
+        Range->End      = Num - 1;
         NetListInsertAfter (&Range->Link, &NewRange->Link);
       }
 
@@ -958,6 +970,7 @@ Mtftp6OperationClean (
   Instance->WindowSize     = 1;
   Instance->TotalBlock     = 0;
   Instance->AckedBlock     = 0;
+  Instance->HoleAcked      = FALSE;
   Instance->LastBlk        = 0;
   Instance->PacketToLive   = 0;
   Instance->MaxRetry       = 0;
@@ -0,0 +1,427 @@
+/** @file
+  Tests for the SACK support in TcpOption.c and TcpSack.c.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <gtest/gtest.h>
+#include <vector>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/DebugLib.h>
+  #include "../TcpMain.h"
+}
+
+////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////
+
+#define TEST_MSS       1000
+#define TEST_ISS       1000
+#define TEST_SEGMENTS  10
+
+////////////////////////////////////////////////////////////////////////
+// Symbol Definitions
+// These functions are not directly under test - but required to compile
+////////////////////////////////////////////////////////////////////////
+UINT32  mTcpTick = 1000;
+
+static std::vector<TCP_SEQNO>  mRetransmitted;
+
+INTN
+TcpRetransmit (
+  IN TCP_CB     *Tcb,
+  IN TCP_SEQNO  Seq
+  )
+{
+  mRetransmitted.push_back (Seq);
+  return 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+// TcpSackOption Tests
+////////////////////////////////////////////////////////////////////////
+
+class TcpSackOptionTest : public ::testing::Test {
+protected:
+  TCP_CB    Tcb;
+  SOCKET    Sk;
+  NET_BUF   *Nbuf;
+  UINT8     Packet[sizeof (TCP_HEAD) + 40];
+
+  virtual void
+  SetUp (
+    )
+  {
+    ZeroMem (&Tcb, sizeof (Tcb));
+    ZeroMem (&Sk, sizeof (Sk));
+    InitializeListHead (&Tcb.SndQue);
+    InitializeListHead (&Tcb.RcvQue);
+
+    Sk.RcvBuffer.HighWater = TCP_RCV_BUF_SIZE;
+    Tcb.Sk                 = &Sk;
+    Tcb.RcvMss             = TEST_MSS;
+    Tcb.RcvNxt             = TEST_ISS;
+
+    Nbuf = NetbufAlloc (TCP_MAX_HEAD + TEST_MSS);
+    ASSERT_NE (Nbuf, nullptr);
+    NetbufReserve (Nbuf, TCP_MAX_HEAD);
+  }
+
+  virtual void
+  TearDown (
+    )
+  {
+    NetbufFreeList (&Tcb.RcvQue);
+    NetbufFree (Nbuf);
+  }
+
+  // Queue an out-of-order segment, the queue is kept sorted by the caller.
+  void
+  QueueSegment (
+    TCP_SEQNO  Seq,
+    TCP_SEQNO  End
+    )
+  {
+    NET_BUF  *Seg;
+
+    Seg = NetbufAlloc (End - Seq);
+    ASSERT_NE (Seg, nullptr);
+    TCPSEG_NETBUF (Seg)->Seq = Seq;
+    TCPSEG_NETBUF (Seg)->End = End;
+    InsertTailList (&Tcb.RcvQue, &Seg->List);
+  }
+
+  // Build a TCP header followed by the options.
+  TCP_HEAD *
+  BuildHead (
+    CONST UINT8  *Options,
+    UINT8        Len
+    )
+  {
+    TCP_HEAD  *Head;
+
+    ZeroMem (Packet, sizeof (Packet));
+    Head          = (TCP_HEAD *)Packet;
+    Head->HeadLen = (UINT8)((sizeof (TCP_HEAD) + Len) >> 2);
+    CopyMem (Head + 1, Options, Len);
+    return Head;
+  }
+
+  UINT32
+  GetUint32 (
+    UINT32  Offset
+    )
+  {
+    return NTOHL (*(UINT32 *)NetbufGetByte (Nbuf, Offset, NULL));
+  }
+};
+
+// Test Description:
+// The SACK permitted option is parsed along with the other SYN options.
+TEST_F (TcpSackOptionTest, ParseSackPermitted) {
+  CONST UINT8  Options[] = { 2, 4, 0x05, 0xb4, 1, 1, 4, 2 };
+  TCP_OPTION   Option;
+
+  ASSERT_EQ (TcpParseOption (BuildHead (Options, sizeof (Options)), &Option), 0);
+  EXPECT_TRUE (TCP_FLG_ON (Option.Flag, TCP_OPTION_RCVD_SACK_PERM));
+  EXPECT_TRUE (TCP_FLG_ON (Option.Flag, TCP_OPTION_RCVD_MSS));
+  EXPECT_EQ (Option.Mss, 1460);
+}
+
+// Test Description:
+// The blocks of a SACK option are parsed in order.
+TEST_F (TcpSackOptionTest, ParseSackBlocks) {
+  CONST UINT8  Options[] = {
+    1, 1, 5, 18,
+    0, 0, 0x0b, 0xb8, 0, 0, 0x0f, 0xa0,
+    0, 0, 0x03, 0xe8, 0, 0, 0x07, 0xd0
+  };
+  TCP_OPTION   Option;
+
+  ASSERT_EQ (TcpParseOption (BuildHead (Options, sizeof (Options)), &Option), 0);
+  ASSERT_TRUE (TCP_FLG_ON (Option.Flag, TCP_OPTION_RCVD_SACK));
+  ASSERT_EQ (Option.SackCount, 2);
+  EXPECT_EQ (Option.SackBlock[0].Left, 3000U);
+  EXPECT_EQ (Option.SackBlock[0].Right, 4000U);
+  EXPECT_EQ (Option.SackBlock[1].Left, 1000U);
+  EXPECT_EQ (Option.SackBlock[1].Right, 2000U);
+}
+
+// Test Description:
+// A SACK option whose length isn't a whole number of blocks is illegal.
+TEST_F (TcpSackOptionTest, ParseMalformedSack) {
+  CONST UINT8  Partial[]   = { 1, 1, 5, 6, 0, 0, 0, 0 };
+  CONST UINT8  Empty[]     = { 1, 1, 5, 2 };
+  CONST UINT8  Truncated[] = { 1, 1, 5, 10, 0, 0, 0, 0 };
+  CONST UINT8  BadPerm[]   = { 1, 4, 3, 0 };
+  TCP_OPTION   Option;
+
+  EXPECT_EQ (TcpParseOption (BuildHead (Partial, sizeof (Partial)), &Option), -1);
+  EXPECT_EQ (TcpParseOption (BuildHead (Empty, sizeof (Empty)), &Option), -1);
+  EXPECT_EQ (TcpParseOption (BuildHead (Truncated, sizeof (Truncated)), &Option), -1);
+  EXPECT_EQ (TcpParseOption (BuildHead (BadPerm, sizeof (BadPerm)), &Option), -1);
+}
+
+// Test Description:
+// The active open advertises SACK unless it is disabled.
+TEST_F (TcpSackOptionTest, SynAdvertisesSackPermitted) {
+  NET_BUF  *Syn;
+
+  TCPSEG_NETBUF (Nbuf)->Flag = TCP_FLG_SYN;
+  ASSERT_EQ (TcpSynBuildOption (&Tcb, Nbuf), 24);
+  EXPECT_EQ (GetUint32 (4), (UINT32)TCP_OPTION_SACK_PERM_FAST);
+
+  Syn = NetbufAlloc (TCP_MAX_HEAD);
+  ASSERT_NE (Syn, nullptr);
+  NetbufReserve (Syn, TCP_MAX_HEAD);
+  TCPSEG_NETBUF (Syn)->Flag = TCP_FLG_SYN;
+  TCP_SET_FLG (Tcb.CtrlFlag, TCP_CTRL_NO_SACK);
+  EXPECT_EQ (TcpSynBuildOption (&Tcb, Syn), 20);
+  NetbufFree (Syn);
+}
+
+// Test Description:
+// The SYN-ACK only permits SACK when the peer permitted it.
+TEST_F (TcpSackOptionTest, SynAckFollowsPeer) {
+  TCPSEG_NETBUF (Nbuf)->Flag = TCP_FLG_SYN | TCP_FLG_ACK;
+  EXPECT_EQ (TcpSynBuildOption (&Tcb, Nbuf), 4);
+}
+
+// Test Description:
+// An ACK reports the most recent segment first, then the other
+// out-of-order data, and fits in the option space with timestamps.
+TEST_F (TcpSackOptionTest, AckReportsOutOfOrderData) {
+  TCP_SET_FLG (Tcb.CtrlFlag, TCP_CTRL_RCVD_SACK);
+  TCP_SET_FLG (Tcb.CtrlFlag, TCP_CTRL_SND_TS);
+
+  QueueSegment (2000, 2500);
+  QueueSegment (2500, 3000);
+  QueueSegment (4000, 4500);
+  QueueSegment (6000, 6500);
+  QueueSegment (8000, 8500);
+  Tcb.RcvSackSeq = 4000;
+
+  TCPSEG_NETBUF (Nbuf)->Flag = TCP_FLG_ACK;
+  ASSERT_EQ (TcpBuildOption (&Tcb, Nbuf), 40);
+
+  EXPECT_EQ (GetUint32 (0), (UINT32)(TCP_OPTION_SACK_FAST | 26));
+  EXPECT_EQ (GetUint32 (4), 4000U);
+  EXPECT_EQ (GetUint32 (8), 4500U);
+  EXPECT_EQ (GetUint32 (12), 2000U);
+  EXPECT_EQ (GetUint32 (16), 3000U);
+  EXPECT_EQ (GetUint32 (20), 6000U);
+  EXPECT_EQ (GetUint32 (24), 6500U);
+  EXPECT_EQ (GetUint32 (28), (UINT32)TCP_OPTION_TS_FAST);
+}
+
+// Test Description:
+// When the most recent segment is no longer queued, the blocks are
+// reported in sequence order and still fill the option.
+TEST_F (TcpSackOptionTest, AckFillsBlocksWithoutRecentSegment) {
+  TCP_SACK_BLOCK  Block[3];
+
+  QueueSegment (2000, 2500);
+  QueueSegment (4000, 4500);
+  QueueSegment (6000, 6500);
+  QueueSegment (8000, 8500);
+  Tcb.RcvSackSeq = TEST_ISS;
+
+  ASSERT_EQ (TcpGetSackBlocks (&Tcb, Block, 3), 3);
+  EXPECT_EQ (Block[0].Left, 2000U);
+  EXPECT_EQ (Block[0].Right, 2500U);
+  EXPECT_EQ (Block[1].Left, 4000U);
+  EXPECT_EQ (Block[1].Right, 4500U);
+  EXPECT_EQ (Block[2].Left, 6000U);
+  EXPECT_EQ (Block[2].Right, 6500U);
+}
+
+// Test Description:
+// Data segments don't carry SACK blocks, so that they fit in SndMss.
+TEST_F (TcpSackOptionTest, DataSegmentHasNoSack) {
+  UINT8  *Data;
+
+  TCP_SET_FLG (Tcb.CtrlFlag, TCP_CTRL_RCVD_SACK);
+  QueueSegment (2000, 3000);
+  Tcb.RcvSackSeq = 2000;
+
+  Data = NetbufAllocSpace (Nbuf, 100, NET_BUF_TAIL);
+  ASSERT_NE (Data, nullptr);
+  EXPECT_EQ (TcpBuildOption (&Tcb, Nbuf), 0);
+}
+
+////////////////////////////////////////////////////////////////////////
+// TcpSackRecovery Tests
+////////////////////////////////////////////////////////////////////////
+
+// Emulate a sender with a full window of TEST_SEGMENTS segments in
+// flight, and feed it the ACKs of a peer that lost some of them.
+class TcpSackRecoveryTest : public ::testing::Test {
+protected:
+  TCP_CB  Tcb;
+
+  virtual void
+  SetUp (
+    )
+  {
+    NET_BUF  *Seg;
+    UINT32   Index;
+
+    ZeroMem (&Tcb, sizeof (Tcb));
+    InitializeListHead (&Tcb.SndQue);
+    InitializeListHead (&Tcb.RcvQue);
+    TCP_SET_FLG (Tcb.CtrlFlag, TCP_CTRL_RCVD_SACK);
+
+    Tcb.SndMss       = TEST_MSS;
+    Tcb.SndUna       = TEST_ISS;
+    Tcb.SndNxt       = TEST_ISS + TEST_SEGMENTS * TEST_MSS;
+    Tcb.CWnd         = TEST_SEGMENTS * TEST_MSS;
+    Tcb.Ssthresh     = 0xffffffff;
+    Tcb.CongestState = TCP_CONGEST_OPEN;
+
+    for (Index = 0; Index < TEST_SEGMENTS; Index++) {
+      Seg = NetbufAlloc (TEST_MSS);
+      ASSERT_NE (Seg, nullptr);
+      TCPSEG_NETBUF (Seg)->Seq = TEST_ISS + Index * TEST_MSS;
+      TCPSEG_NETBUF (Seg)->End = TEST_ISS + (Index + 1) * TEST_MSS;
+      InsertTailList (&Tcb.SndQue, &Seg->List);
+    }
+
+    mRetransmitted.clear ();
+  }
+
+  virtual void
+  TearDown (
+    )
+  {
+    NetbufFreeList (&Tcb.SndQue);
+  }
+
+  // Receive an ACK with the given SACK blocks.
+  BOOLEAN
+  ReceiveAck (
+    TCP_SEQNO       Ack,
+    TCP_SACK_BLOCK  *Blocks,
+    UINT8           Count
+    )
+  {
+    TCP_SEG     Seg;
+    TCP_OPTION  Option;
+
+    ZeroMem (&Seg, sizeof (Seg));
+    ZeroMem (&Option, sizeof (Option));
+    Seg.Ack          = Ack;
+    Option.Flag      = TCP_OPTION_RCVD_SACK;
+    Option.SackCount = Count;
+    CopyMem (Option.SackBlock, Blocks, Count * sizeof (TCP_SACK_BLOCK));
+
+    return TcpSackUpdateScoreboard (&Tcb, &Seg, &Option);
+  }
+
+  void
+  Recover (
+    TCP_SEQNO  Ack
+    )
+  {
+    TCP_SEG  Seg;
+
+    ZeroMem (&Seg, sizeof (Seg));
+    Seg.Ack = Ack;
+    TcpSackRecover (&Tcb, &Seg);
+  }
+};
+
+// Test Description:
+// Only the new SACK information counts, and blocks below the
+// cumulative ACK or beyond SND.NXT are ignored.
+TEST_F (TcpSackRecoveryTest, ScoreboardTracksNewSacks) {
+  TCP_SACK_BLOCK  Block[]   = {
+    { 2000, 3000 }
+  };
+  TCP_SACK_BLOCK  Invalid[] = {
+    { 500,  1000  },
+    { 3000, 12000 }
+  };
+
+  EXPECT_TRUE (ReceiveAck (TEST_ISS, Block, 1));
+  EXPECT_FALSE (ReceiveAck (TEST_ISS, Block, 1));
+  EXPECT_FALSE (ReceiveAck (TEST_ISS, Invalid, 2));
+  EXPECT_FALSE (TcpSackIsLost (&Tcb, TEST_ISS));
+}
+
+// Test Description:
+// A single lost segment is detected from three SACKed segments
+// above it and retransmitted once, while the pipe keeps the
+// sender within the reduced congestion window.
+TEST_F (TcpSackRecoveryTest, SingleLoss) {
+  TCP_SACK_BLOCK  Block[] = {
+    { 2000, 5000 }
+  };
+
+  ASSERT_TRUE (ReceiveAck (TEST_ISS, Block, 1));
+  ASSERT_TRUE (TcpSackIsLost (&Tcb, TEST_ISS));
+
+  Recover (TEST_ISS);
+  EXPECT_EQ (Tcb.CongestState, TCP_CONGEST_RECOVER);
+  EXPECT_EQ (Tcb.CWnd, 5000U);
+  EXPECT_EQ (Tcb.Recover, Tcb.SndNxt);
+  ASSERT_EQ (mRetransmitted.size (), 1U);
+  EXPECT_EQ (mRetransmitted[0], (TCP_SEQNO)TEST_ISS);
+
+  //
+  // Six segments are in flight above the SACKed ones, plus the
+  // retransmission.
+  //
+  EXPECT_EQ (Tcb.Pipe, 7000U);
+}
+
+// Test Description:
+// Several holes in one window are all repaired within one recovery,
+// which NewReno needs one round trip per hole for.
+TEST_F (TcpSackRecoveryTest, MultipleLosses) {
+  TCP_SACK_BLOCK  Block[] = {
+    { 7000, 11000 },
+    { 2000, 6000  }
+  };
+
+  ASSERT_TRUE (ReceiveAck (TEST_ISS, Block, 2));
+
+  Recover (TEST_ISS);
+  ASSERT_EQ (mRetransmitted.size (), 2U);
+  EXPECT_EQ (mRetransmitted[0], 1000U);
+  EXPECT_EQ (mRetransmitted[1], 6000U);
+  EXPECT_EQ (Tcb.HighRxt, 7000U);
+  EXPECT_EQ (Tcb.Pipe, 2000U);
+
+  //
+  // The cumulative ACK of the first retransmission doesn't
+  // retransmit anything again.
+  //
+  Recover (6000);
+  EXPECT_EQ (mRetransmitted.size (), 2U);
+  EXPECT_EQ (Tcb.CongestState, TCP_CONGEST_RECOVER);
+
+  //
+  // The full ACK ends the recovery.
+  //
+  Recover (Tcb.Recover);
+  EXPECT_EQ (Tcb.CongestState, TCP_CONGEST_OPEN);
+  EXPECT_EQ (Tcb.CWnd, Tcb.Ssthresh);
+}
+
+// Test Description:
+// The SACK information is forgotten after a retransmission timeout.
+TEST_F (TcpSackRecoveryTest, ClearScoreboard) {
+  TCP_SACK_BLOCK  Block[] = {
+    { 2000, 11000 }
+  };
+
+  ASSERT_TRUE (ReceiveAck (TEST_ISS, Block, 1));
+  ASSERT_TRUE (TcpSackIsLost (&Tcb, TEST_ISS));
+
+  TcpSackClearScoreboard (&Tcb);
+  EXPECT_FALSE (TcpSackIsLost (&Tcb, TEST_ISS));
+  EXPECT_EQ (TcpSackGetPipe (&Tcb, TEST_ISS), (UINT32)(TEST_SEGMENTS * TEST_MSS));
+}
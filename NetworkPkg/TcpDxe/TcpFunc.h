@@ -657,6 +657,89 @@ Tcp6RefreshNeighbor (
   IN UINT32          Timeout
   );
 
+//
+// Functions in TcpSack.c
+//
+
+/**
+  Clear the SACK scoreboard. The SACK information is ignored
+  after a retransmission timeout, as suggested in RFC2018,
+  because the peer may have discarded the out-of-order data.
+
+  @param[in, out]  Tcb     Pointer to the TCP_CB of this TCP instance.
+
+**/
+VOID
+TcpSackClearScoreboard (
+  IN OUT TCP_CB  *Tcb
+  );
+
+/**
+  Update the SACK scoreboard with the SACK blocks of a received
+  segment.
+
+  @param[in, out]  Tcb     Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Seg     Pointer to the received segment.
+  @param[in]       Option  Pointer to the options of the received segment.
+
+  @retval TRUE         The segment SACKed data that wasn't SACKed before.
+  @retval FALSE        No new data is SACKed.
+
+**/
+BOOLEAN
+TcpSackUpdateScoreboard (
+  IN OUT TCP_CB      *Tcb,
+  IN     TCP_SEG     *Seg,
+  IN     TCP_OPTION  *Option
+  );
+
+/**
+  Check whether the data starting from Seq is considered lost
+  according to the SACK scoreboard.
+
+  @param[in]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]  Seq      The sequence number of the data.
+
+  @retval TRUE         The data is considered lost.
+  @retval FALSE        The data may still be in flight, or the peer
+                       doesn't support SACK.
+
+**/
+BOOLEAN
+TcpSackIsLost (
+  IN TCP_CB     *Tcb,
+  IN TCP_SEQNO  Seq
+  );
+
+/**
+  Estimate the number of bytes outstanding in the network, as
+  the SetPipe () of RFC6675.
+
+  @param[in]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]  Ack      The highest cumulative ACK received.
+
+  @return The estimated number of bytes in the network.
+
+**/
+UINT32
+TcpSackGetPipe (
+  IN TCP_CB     *Tcb,
+  IN TCP_SEQNO  Ack
+  );
+
+/**
+  SACK based loss recovery defined in RFC6675.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Seg      Segment that triggers the loss recovery.
+
+**/
+VOID
+TcpSackRecover (
+  IN OUT TCP_CB   *Tcb,
+  IN     TCP_SEG  *Seg
+  );
+
 //
 // Functions in TcpDispatcher.c
 //
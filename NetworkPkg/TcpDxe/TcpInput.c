@@ -725,6 +725,7 @@ TcpInput (
   UINT16      Checksum;
   INT32       Usable;
   EFI_STATUS  Status;
+  BOOLEAN     NewSacked;
 
   ASSERT ((Version == IP_VERSION_4) || (Version == IP_VERSION_6));
 
@@ -1213,13 +1214,25 @@ TcpInput (
     TcpSetTimer (Tcb, TCP_TIMER_REXMIT, Tcb->Rto);
   }
 
+  //
+  // Update the SACK scoreboard. A duplicate ack only counts
+  // when it SACKs new data, as specified in RFC6675.
+  //
+  NewSacked = FALSE;
+  if (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_RCVD_SACK)) {
+    NewSacked = TcpSackUpdateScoreboard (Tcb, Seg, &Option);
+  }
+
   //
   // Count duplicate acks.
   //
   if ((Seg->Ack == Tcb->SndUna) &&
       (Tcb->SndUna != Tcb->SndNxt) &&
       (Seg->Wnd == Tcb->SndWnd) &&
-      (0 == Len))
+      (0 == Len) &&
+      (!TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_RCVD_SACK) ||
+       !TCP_FLG_ON (Option.Flag, TCP_OPTION_RCVD_SACK) ||
+       NewSacked))
   {
     Tcb->DupAck++;
   } else {
@@ -1229,7 +1242,7 @@ TcpInput (
   //
   // Congestion avoidance, fast recovery and fast retransmission.
   //
-  if (((Tcb->CongestState == TCP_CONGEST_OPEN) && (Tcb->DupAck < 3)) ||
+  if (((Tcb->CongestState == TCP_CONGEST_OPEN) && (Tcb->DupAck < 3) && !TcpSackIsLost (Tcb, Seg->Ack)) ||
       (Tcb->CongestState == TCP_CONGEST_LOSS))
   {
     if (TCP_SEQ_GT (Seg->Ack, Tcb->SndUna)) {
@@ -1245,6 +1258,8 @@ TcpInput (
     if (Tcb->CongestState == TCP_CONGEST_LOSS) {
       TcpFastLossRecover (Tcb, Seg);
     }
+  } else if (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_RCVD_SACK)) {
+    TcpSackRecover (Tcb, Seg);
   } else {
     TcpFastRecover (Tcb, Seg);
   }
@@ -1477,6 +1492,14 @@ StepSix:
       goto RESET_THEN_DROP;
     }
 
+    //
+    // Remember the out-of-order segment, to report it in the
+    // first SACK block.
+    //
+    if (TCP_SEQ_GT (Seg->Seq, Tcb->RcvNxt)) {
+      Tcb->RcvSackSeq = Seg->Seq;
+    }
+
     if (TcpQueueData (Tcb, Nbuf) == 0) {
       DEBUG (
         (DEBUG_ERROR,
@@ -160,6 +160,28 @@ TcpSynBuildOption (
     TcpPutUint32 (Data, TCP_OPTION_WS_FAST | TcpComputeScale (Tcb));
   }
 
+  //
+  // Build SACK permitted option, only when SACK isn't
+  // disabled by the application, and either we are doing
+  // active open or we have received it from peer.
+  //
+  if (!TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_NO_SACK) &&
+      (!TCP_FLG_ON (TCPSEG_NETBUF (Nbuf)->Flag, TCP_FLG_ACK) ||
+       TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_RCVD_SACK))
+      )
+  {
+    Data = NetbufAllocSpace (
+             Nbuf,
+             TCP_OPTION_SACK_PERM_ALIGNED_LEN,
+             NET_BUF_HEAD
+             );
+
+    ASSERT (Data != NULL);
+
+    Len += TCP_OPTION_SACK_PERM_ALIGNED_LEN;
+    TcpPutUint32 (Data, TCP_OPTION_SACK_PERM_FAST);
+  }
+
   //
   // Build the MSS option.
   //
@@ -172,6 +194,100 @@ TcpSynBuildOption (
   return Len;
 }
 
+/**
+  Get the SACK blocks that describe the out-of-order data on the
+  reassemble queue, as specified in RFC2018.
+
+  The first block contains the segment received most recently,
+  the others follow in sequence order.
+
+  @param[in]   Tcb       Pointer to the TCP_CB of this TCP instance.
+  @param[out]  Block     Pointer to the buffer to store the blocks.
+  @param[in]   MaxCount  The maximum number of blocks to get.
+
+  @return                The number of blocks stored in Block.
+
+**/
+UINT8
+TcpGetSackBlocks (
+  IN  TCP_CB          *Tcb,
+  OUT TCP_SACK_BLOCK  *Block,
+  IN  UINT8           MaxCount
+  )
+{
+  LIST_ENTRY      *Entry;
+  TCP_SEG         *Seg;
+  TCP_SACK_BLOCK  Sack;
+  TCP_SACK_BLOCK  Spare;
+  UINT8           Count;
+  BOOLEAN         Found;
+  BOOLEAN         HasSpare;
+
+  ASSERT ((Tcb != NULL) && (Block != NULL) && (MaxCount > 0));
+
+  //
+  // Block[0] is reserved for the most recent segment.
+  //
+  Count    = 1;
+  Found    = FALSE;
+  HasSpare = FALSE;
+  Entry    = Tcb->RcvQue.ForwardLink;
+
+  while (Entry != &Tcb->RcvQue) {
+    Seg        = TCPSEG_NETBUF (NET_LIST_USER_STRUCT (Entry, NET_BUF, List));
+    Sack.Left  = Seg->Seq;
+    Sack.Right = Seg->End;
+
+    //
+    // Merge the contiguous segments into one block.
+    //
+    for (Entry = Entry->ForwardLink; Entry != &Tcb->RcvQue; Entry = Entry->ForwardLink) {
+      Seg = TCPSEG_NETBUF (NET_LIST_USER_STRUCT (Entry, NET_BUF, List));
+      if (Seg->Seq != Sack.Right) {
+        break;
+      }
+
+      Sack.Right = Seg->End;
+    }
+
+    if (TCP_SEQ_LEQ (Sack.Left, Tcb->RcvNxt)) {
+      continue;
+    }
+
+    if (!Found &&
+        TCP_SEQ_LEQ (Sack.Left, Tcb->RcvSackSeq) &&
+        TCP_SEQ_LT (Tcb->RcvSackSeq, Sack.Right))
+    {
+      CopyMem (&Block[0], &Sack, sizeof (TCP_SACK_BLOCK));
+      Found = TRUE;
+    } else if (Count < MaxCount) {
+      CopyMem (&Block[Count], &Sack, sizeof (TCP_SACK_BLOCK));
+      Count++;
+    } else if (!HasSpare) {
+      //
+      // Keep the next block in case Block[0] is not needed.
+      //
+      CopyMem (&Spare, &Sack, sizeof (TCP_SACK_BLOCK));
+      HasSpare = TRUE;
+    }
+  }
+
+  if (!Found) {
+    //
+    // The most recent segment was delivered or trimmed,
+    // report the blocks in sequence order.
+    //
+    Count--;
+    CopyMem (&Block[0], &Block[1], Count * sizeof (TCP_SACK_BLOCK));
+    if (HasSpare) {
+      CopyMem (&Block[Count], &Spare, sizeof (TCP_SACK_BLOCK));
+      Count++;
+    }
+  }
+
+  return Count;
+}
+
 /**
   Build the TCP option in synchronized states.
 
@@ -187,11 +303,17 @@ TcpBuildOption (
   IN NET_BUF  *Nbuf
   )
 {
-  UINT8   *Data;
-  UINT16  Len;
+  UINT8           *Data;
+  UINT16          Len;
+  UINT32          DataLen;
+  TCP_SACK_BLOCK  Block[TCP_OPTION_MAX_SACK];
+  UINT8           MaxCount;
+  UINT8           Count;
+  UINT8           Index;
 
   ASSERT ((Tcb != NULL) && (Nbuf != NULL) && (Nbuf->Tcp == NULL));
-  Len = 0;
+  Len     = 0;
+  DataLen = Nbuf->TotalSize;
 
   //
   // Build the Timestamp option.
@@ -214,6 +336,40 @@ TcpBuildOption (
     TcpPutUint32 (Data + 8, Tcb->TsRecent);
   }
 
+  //
+  // Build the SACK option if there is out-of-order data. It is
+  // only added to the segments without data, so that the data
+  // segments still fit in SndMss, whose computation only counts
+  // the timestamp option.
+  //
+  if (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_RCVD_SACK) &&
+      !TCP_FLG_ON (TCPSEG_NETBUF (Nbuf)->Flag, TCP_FLG_RST) &&
+      (DataLen == 0) &&
+      !IsListEmpty (&Tcb->RcvQue)
+      )
+  {
+    MaxCount = (UINT8)((40 - Len - TCP_OPTION_SACK_ALIGNED_LEN) / TCP_OPTION_SACK_BLOCK_LEN);
+    MaxCount = MIN (MaxCount, TCP_OPTION_MAX_SACK);
+    Count    = TcpGetSackBlocks (Tcb, Block, MaxCount);
+
+    if (Count != 0) {
+      Data = NetbufAllocSpace (
+               Nbuf,
+               TCP_OPTION_SACK_ALIGNED_LEN + Count * TCP_OPTION_SACK_BLOCK_LEN,
+               NET_BUF_HEAD
+               );
+
+      ASSERT (Data != NULL);
+      Len += TCP_OPTION_SACK_ALIGNED_LEN + Count * TCP_OPTION_SACK_BLOCK_LEN;
+
+      TcpPutUint32 (Data, TCP_OPTION_SACK_FAST | (2 + Count * TCP_OPTION_SACK_BLOCK_LEN));
+      for (Index = 0; Index < Count; Index++) {
+        TcpPutUint32 (Data + 4 + Index * TCP_OPTION_SACK_BLOCK_LEN, Block[Index].Left);
+        TcpPutUint32 (Data + 8 + Index * TCP_OPTION_SACK_BLOCK_LEN, Block[Index].Right);
+      }
+    }
+  }
+
   return Len;
 }
 
@@ -239,6 +395,7 @@ TcpParseOption (
   UINT8  Cur;
   UINT8  Type;
   UINT8  Len;
+  UINT8  Index;
 
   ASSERT ((Tcp != NULL) && (Option != NULL));
 
@@ -311,6 +468,39 @@ TcpParseOption (
         Cur += TCP_OPTION_TS_LEN;
         break;
 
+      case TCP_OPTION_SACK_PERM:
+        Len = Head[Cur + 1];
+
+        if ((Len != TCP_OPTION_SACK_PERM_LEN) || (TotalLen - Cur < TCP_OPTION_SACK_PERM_LEN)) {
+          return -1;
+        }
+
+        TCP_SET_FLG (Option->Flag, TCP_OPTION_RCVD_SACK_PERM);
+
+        Cur += TCP_OPTION_SACK_PERM_LEN;
+        break;
+
+      case TCP_OPTION_SACK:
+        Len = Head[Cur + 1];
+
+        if ((TotalLen - Cur < Len) || (Len < 2 + TCP_OPTION_SACK_BLOCK_LEN) ||
+            ((Len - 2) % TCP_OPTION_SACK_BLOCK_LEN != 0) ||
+            ((Len - 2) / TCP_OPTION_SACK_BLOCK_LEN > TCP_OPTION_MAX_SACK))
+        {
+          return -1;
+        }
+
+        Option->SackCount = (UINT8)((Len - 2) / TCP_OPTION_SACK_BLOCK_LEN);
+        for (Index = 0; Index < Option->SackCount; Index++) {
+          Option->SackBlock[Index].Left  = TcpGetUint32 (&Head[Cur + 2 + Index * TCP_OPTION_SACK_BLOCK_LEN]);
+          Option->SackBlock[Index].Right = TcpGetUint32 (&Head[Cur + 6 + Index * TCP_OPTION_SACK_BLOCK_LEN]);
+        }
+
+        TCP_SET_FLG (Option->Flag, TCP_OPTION_RCVD_SACK);
+
+        Cur = (UINT8)(Cur + Len);
+        break;
+
       case TCP_OPTION_NOP:
         Cur++;
         break;
@@ -173,6 +173,7 @@ TcpDataToSend (
   UINT32  Len;
   UINT32  Left;
   UINT32  Limit;
+  UINT32  CWndLimit;
 
   Sk = Tcb->Sk;
   ASSERT (Sk != NULL);
@@ -182,13 +183,20 @@ TcpDataToSend (
   // and congestion window. The right edge of send
   // window is defined as SND.WL2 + SND.WND. The right
   // edge of congestion window is defined as SND.UNA +
-  // CWND.
+  // CWND. During the SACK based loss recovery, it is
+  // SND.NXT + CWND - PIPE as specified in RFC6675.
   //
   Win   = 0;
   Limit = Tcb->SndWl2 + Tcb->SndWnd;
 
-  if (TCP_SEQ_GT (Limit, Tcb->SndUna + Tcb->CWnd)) {
-    Limit = Tcb->SndUna + Tcb->CWnd;
+  if (TCP_IN_SACK_RECOVERY (Tcb)) {
+    CWndLimit = Tcb->SndNxt + ((Tcb->CWnd > Tcb->Pipe) ? (Tcb->CWnd - Tcb->Pipe) : 0);
+  } else {
+    CWndLimit = Tcb->SndUna + Tcb->CWnd;
+  }
+
+  if (TCP_SEQ_GT (Limit, CWndLimit)) {
+    Limit = CWndLimit;
   }
 
   if (TCP_SEQ_GT (Limit, Tcb->SndNxt)) {
@@ -902,6 +910,10 @@ TcpToSendData (
 
     Sent += TCP_SUB_SEQ (End, Seq);
 
+    if (TCP_IN_SACK_RECOVERY (Tcb)) {
+      Tcb->Pipe += TCP_SUB_SEQ (End, Seq);
+    }
+
     //
     // All the buffers in the SndQue are headless.
     //
@@ -70,6 +70,8 @@
 #define TCP_CTRL_TIMER_ON      0x1000   ///< At least one of the timer is on.
 #define TCP_CTRL_RTT_ON        0x2000   ///< The RTT measurement is on.
 #define TCP_CTRL_ACK_NOW       0x4000   ///< Send the ACK now, don't delay.
+#define TCP_CTRL_NO_SACK       0x8000   ///< Disable SACK option.
+#define TCP_CTRL_RCVD_SACK     0x10000  ///< Received a SACK-permitted option in syn.
 
 //
 // Timer related values
@@ -172,6 +174,12 @@
 // Check whether Flag is on
 //
 #define TCP_FLG_ON(Value, Flag)  ((BOOLEAN) (((Value) & (Flag)) != 0))
+
+//
+// Check whether the SACK based loss recovery of RFC6675 is in progress
+//
+#define TCP_IN_SACK_RECOVERY(Tcb) \
+  (TCP_FLG_ON ((Tcb)->CtrlFlag, TCP_CTRL_RCVD_SACK) && ((Tcb)->CongestState == TCP_CONGEST_RECOVER))
 //
 // Set and Clear operation on a Flag
 //
@@ -208,12 +216,13 @@
 /// TCP segmentation data.
 ///
 typedef struct _TCP_SEG {
-  TCP_SEQNO    Seq;  ///< Starting sequence number.
-  TCP_SEQNO    End;  ///< The sequence of the last byte + 1, include SYN/FIN. End-Seq = SEG.LEN.
-  TCP_SEQNO    Ack;  ///< ACK field in the segment.
-  UINT8        Flag; ///< TCP header flags.
-  UINT16       Urg;  ///< Valid if URG flag is set.
-  UINT32       Wnd;  ///< TCP window size field.
+  TCP_SEQNO    Seq;    ///< Starting sequence number.
+  TCP_SEQNO    End;    ///< The sequence of the last byte + 1, include SYN/FIN. End-Seq = SEG.LEN.
+  TCP_SEQNO    Ack;    ///< ACK field in the segment.
+  UINT8        Flag;   ///< TCP header flags.
+  UINT16       Urg;    ///< Valid if URG flag is set.
+  UINT32       Wnd;    ///< TCP window size field.
+  BOOLEAN      Sacked; ///< The peer has SACKed the segment, valid on the SndQue.
 } TCP_SEG;
 
 ///
@@ -306,6 +315,14 @@ struct _TCP_CONTROL_BLOCK {
   UINT8               LossTimes;    ///< Number of retxmit timeouts in a row.
   TCP_SEQNO           LossRecover;  ///< Recover point for retxmit.
 
+  //
+  // RFC2018 and RFC6675 variables.
+  // Selective acknowledgment + SACK based loss recovery.
+  //
+  TCP_SEQNO           HighRxt;     ///< Highest sequence retransmitted in recovery.
+  UINT32              Pipe;        ///< Estimated bytes outstanding in the network.
+  TCP_SEQNO           RcvSackSeq;  ///< Seq of the last out-of-order segment received.
+
   //
   // RFC7323
   // Addressing Window Retraction for TCP Window Scale Option.
@@ -0,0 +1,426 @@
+/** @file
+  Implementation of the SACK scoreboard and the SACK based loss
+  recovery of RFC6675.
+
+  The scoreboard is kept on the segments of the SndQue: a segment
+  is marked as SACKed once the peer reports a SACK block that
+  covers it. Each segment on the SndQue is sent as one TCP segment,
+  so the segments are also the unit of the loss detection.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "TcpMain.h"
+
+//
+// DupThresh of RFC6675.
+//
+#define TCP_SACK_DUP_THRESH  3
+
+/**
+  Check whether the segment is considered lost, as the
+  IsLost () of RFC6675.
+
+  @param[in]  Tcb          Pointer to the TCP_CB of this TCP instance.
+  @param[in]  SackedCount  The number of SACKed segments above the segment.
+  @param[in]  SackedBytes  The number of SACKed bytes above the segment.
+
+  @retval TRUE         The segment is considered lost.
+  @retval FALSE        The segment may still be in flight.
+
+**/
+STATIC
+BOOLEAN
+TcpSackLost (
+  IN TCP_CB  *Tcb,
+  IN UINT32  SackedCount,
+  IN UINT32  SackedBytes
+  )
+{
+  return (BOOLEAN)((SackedCount >= TCP_SACK_DUP_THRESH) ||
+                   (SackedBytes > (TCP_SACK_DUP_THRESH - 1) * (UINT32)Tcb->SndMss));
+}
+
+/**
+  Clear the SACK scoreboard. The SACK information is ignored
+  after a retransmission timeout, as suggested in RFC2018,
+  because the peer may have discarded the out-of-order data.
+
+  @param[in, out]  Tcb     Pointer to the TCP_CB of this TCP instance.
+
+**/
+VOID
+TcpSackClearScoreboard (
+  IN OUT TCP_CB  *Tcb
+  )
+{
+  LIST_ENTRY  *Entry;
+  TCP_SEG     *Sent;
+
+  NET_LIST_FOR_EACH (Entry, &Tcb->SndQue) {
+    Sent         = TCPSEG_NETBUF (NET_LIST_USER_STRUCT (Entry, NET_BUF, List));
+    Sent->Sacked = FALSE;
+  }
+}
+
+/**
+  Update the SACK scoreboard with the SACK blocks of a received
+  segment.
+
+  @param[in, out]  Tcb     Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Seg     Pointer to the received segment.
+  @param[in]       Option  Pointer to the options of the received segment.
+
+  @retval TRUE         The segment SACKed data that wasn't SACKed before.
+  @retval FALSE        No new data is SACKed.
+
+**/
+BOOLEAN
+TcpSackUpdateScoreboard (
+  IN OUT TCP_CB      *Tcb,
+  IN     TCP_SEG     *Seg,
+  IN     TCP_OPTION  *Option
+  )
+{
+  LIST_ENTRY      *Entry;
+  NET_BUF         *Node;
+  TCP_SEG         *Sent;
+  TCP_SACK_BLOCK  *Block;
+  UINT8           Index;
+  BOOLEAN         NewSacked;
+
+  ASSERT ((Tcb != NULL) && (Seg != NULL) && (Option != NULL));
+
+  NewSacked = FALSE;
+
+  if (!TCP_FLG_ON (Option->Flag, TCP_OPTION_RCVD_SACK)) {
+    return FALSE;
+  }
+
+  for (Index = 0; Index < Option->SackCount; Index++) {
+    Block = &Option->SackBlock[Index];
+
+    //
+    // Ignore the blocks that aren't between SEG.ACK and SND.NXT,
+    // including the blocks reporting duplicated data.
+    //
+    if (!TCP_SEQ_LT (Block->Left, Block->Right) ||
+        TCP_SEQ_LT (Block->Left, Seg->Ack) ||
+        TCP_SEQ_GT (Block->Right, Tcb->SndNxt))
+    {
+      continue;
+    }
+
+    NET_LIST_FOR_EACH (Entry, &Tcb->SndQue) {
+      Node = NET_LIST_USER_STRUCT (Entry, NET_BUF, List);
+      Sent = TCPSEG_NETBUF (Node);
+
+      if (TCP_SEQ_GEQ (Sent->Seq, Block->Right)) {
+        break;
+      }
+
+      if (!Sent->Sacked &&
+          TCP_SEQ_LEQ (Block->Left, Sent->Seq) &&
+          TCP_SEQ_LEQ (Sent->End, Block->Right))
+      {
+        Sent->Sacked = TRUE;
+        NewSacked    = TRUE;
+      }
+    }
+  }
+
+  return NewSacked;
+}
+
+/**
+  Check whether the data starting from Seq is considered lost
+  according to the SACK scoreboard.
+
+  @param[in]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]  Seq      The sequence number of the data.
+
+  @retval TRUE         The data is considered lost.
+  @retval FALSE        The data may still be in flight, or the peer
+                       doesn't support SACK.
+
+**/
+BOOLEAN
+TcpSackIsLost (
+  IN TCP_CB     *Tcb,
+  IN TCP_SEQNO  Seq
+  )
+{
+  LIST_ENTRY  *Entry;
+  TCP_SEG     *Sent;
+  UINT32      SackedCount;
+  UINT32      SackedBytes;
+
+  if (!TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_RCVD_SACK)) {
+    return FALSE;
+  }
+
+  SackedCount = 0;
+  SackedBytes = 0;
+
+  NET_LIST_FOR_EACH (Entry, &Tcb->SndQue) {
+    Sent = TCPSEG_NETBUF (NET_LIST_USER_STRUCT (Entry, NET_BUF, List));
+
+    if (TCP_SEQ_LEQ (Sent->End, Seq)) {
+      continue;
+    }
+
+    if (TCP_SEQ_LEQ (Sent->Seq, Seq) && Sent->Sacked) {
+      return FALSE;
+    }
+
+    if (TCP_SEQ_GT (Sent->Seq, Seq) && Sent->Sacked) {
+      SackedCount++;
+      SackedBytes += TCP_SUB_SEQ (Sent->End, Sent->Seq);
+    }
+  }
+
+  return TcpSackLost (Tcb, SackedCount, SackedBytes);
+}
+
+/**
+  Estimate the number of bytes outstanding in the network, as
+  the SetPipe () of RFC6675.
+
+  @param[in]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]  Ack      The highest cumulative ACK received.
+
+  @return The estimated number of bytes in the network.
+
+**/
+UINT32
+TcpSackGetPipe (
+  IN TCP_CB     *Tcb,
+  IN TCP_SEQNO  Ack
+  )
+{
+  LIST_ENTRY  *Entry;
+  TCP_SEG     *Sent;
+  UINT32      SackedCount;
+  UINT32      SackedBytes;
+  UINT32      Pipe;
+  UINT32      Len;
+
+  SackedCount = 0;
+  SackedBytes = 0;
+  Pipe        = 0;
+
+  //
+  // Walk the SndQue backward, so that the SACKed data above
+  // each segment is known when the segment is visited.
+  //
+  for (Entry = Tcb->SndQue.BackLink; Entry != &Tcb->SndQue; Entry = Entry->BackLink) {
+    Sent = TCPSEG_NETBUF (NET_LIST_USER_STRUCT (Entry, NET_BUF, List));
+
+    if (TCP_SEQ_LEQ (Sent->End, Ack)) {
+      break;
+    }
+
+    Len = TCP_SUB_SEQ (Sent->End, TCP_SEQ_LT (Sent->Seq, Ack) ? Ack : Sent->Seq);
+
+    if (Sent->Sacked) {
+      SackedCount++;
+      SackedBytes += Len;
+      continue;
+    }
+
+    if (!TcpSackLost (Tcb, SackedCount, SackedBytes)) {
+      Pipe += Len;
+    }
+
+    if (TCP_SEQ_LEQ (Sent->End, Tcb->HighRxt)) {
+      Pipe += Len;
+    }
+  }
+
+  return Pipe;
+}
+
+/**
+  Find the next lost segment to retransmit, as the rule (1) of
+  the NextSeg () of RFC6675.
+
+  @param[in]   Tcb     Pointer to the TCP_CB of this TCP instance.
+  @param[in]   Ack     The highest cumulative ACK received.
+  @param[out]  Seq     The sequence number to retransmit from.
+  @param[out]  End     The end of the segment to retransmit.
+
+  @retval TRUE         A lost segment is found.
+  @retval FALSE        No segment above HighRxt is considered lost.
+
+**/
+STATIC
+BOOLEAN
+TcpSackNextSeg (
+  IN  TCP_CB     *Tcb,
+  IN  TCP_SEQNO  Ack,
+  OUT TCP_SEQNO  *Seq,
+  OUT TCP_SEQNO  *End
+  )
+{
+  LIST_ENTRY  *Entry;
+  TCP_SEG     *Sent;
+  UINT32      SackedCount;
+  UINT32      SackedBytes;
+  BOOLEAN     Found;
+
+  SackedCount = 0;
+  SackedBytes = 0;
+  Found       = FALSE;
+
+  //
+  // The lowest lost segment is the last one found by the
+  // backward walk.
+  //
+  for (Entry = Tcb->SndQue.BackLink; Entry != &Tcb->SndQue; Entry = Entry->BackLink) {
+    Sent = TCPSEG_NETBUF (NET_LIST_USER_STRUCT (Entry, NET_BUF, List));
+
+    if (TCP_SEQ_LEQ (Sent->End, Ack) || TCP_SEQ_LEQ (Sent->End, Tcb->HighRxt)) {
+      break;
+    }
+
+    if (Sent->Sacked) {
+      SackedCount++;
+      SackedBytes += TCP_SUB_SEQ (Sent->End, Sent->Seq);
+      continue;
+    }
+
+    if (TcpSackLost (Tcb, SackedCount, SackedBytes)) {
+      *Seq  = Sent->Seq;
+      *End  = Sent->End;
+      Found = TRUE;
+    }
+  }
+
+  if (Found) {
+    if (TCP_SEQ_LT (*Seq, Tcb->HighRxt)) {
+      *Seq = Tcb->HighRxt;
+    }
+
+    if (TCP_SEQ_LT (*Seq, Ack)) {
+      *Seq = Ack;
+    }
+  }
+
+  return Found;
+}
+
+/**
+  Retransmit the lost segments while the congestion window
+  allows, as the step (C) of the loss recovery of RFC6675.
+  New data is sent by TcpToSendData when no segment is lost.
+
+  @param[in, out]  Tcb     Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Ack     The highest cumulative ACK received.
+
+**/
+STATIC
+VOID
+TcpSackRetransmit (
+  IN OUT TCP_CB     *Tcb,
+  IN     TCP_SEQNO  Ack
+  )
+{
+  TCP_SEQNO  Seq;
+  TCP_SEQNO  End;
+  UINT32     Len;
+
+  while ((Tcb->CWnd > Tcb->Pipe) && (Tcb->CWnd - Tcb->Pipe >= Tcb->SndMss)) {
+    if (!TcpSackNextSeg (Tcb, Ack, &Seq, &End)) {
+      break;
+    }
+
+    if (TcpRetransmit (Tcb, Seq) != 0) {
+      break;
+    }
+
+    Len          = MIN (TCP_SUB_SEQ (End, Seq), Tcb->SndMss);
+    Tcb->HighRxt = Seq + Len;
+    Tcb->Pipe   += Len;
+  }
+}
+
+/**
+  SACK based loss recovery defined in RFC6675.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Seg      Segment that triggers the loss recovery.
+
+**/
+VOID
+TcpSackRecover (
+  IN OUT TCP_CB   *Tcb,
+  IN     TCP_SEG  *Seg
+  )
+{
+  UINT32  FlightSize;
+  UINT32  Len;
+
+  FlightSize = TCP_SUB_SEQ (Tcb->SndNxt, Tcb->SndUna);
+
+  if (Tcb->CongestState != TCP_CONGEST_RECOVER) {
+    //
+    // Enter the loss recovery: reduce the congestion window,
+    // and retransmit the first segment presumed dropped.
+    //
+    Tcb->Ssthresh = MAX (FlightSize >> 1, (UINT32)(2 * Tcb->SndMss));
+    Tcb->CWnd     = Tcb->Ssthresh;
+    Tcb->Recover  = Tcb->SndNxt;
+    Tcb->HighRxt  = Seg->Ack;
+
+    Tcb->CongestState = TCP_CONGEST_RECOVER;
+    TCP_CLEAR_FLG (Tcb->CtrlFlag, TCP_CTRL_RTT_ON);
+
+    DEBUG (
+      (DEBUG_NET,
+       "TcpSackRecover: enter loss recovery for TCB %p, recover point is %d\n",
+       Tcb,
+       Tcb->Recover)
+      );
+
+    Tcb->Pipe = TcpSackGetPipe (Tcb, Seg->Ack);
+
+    if (TcpRetransmit (Tcb, Seg->Ack) == 0) {
+      Len          = MIN (TCP_SUB_SEQ (Tcb->SndNxt, Seg->Ack), Tcb->SndMss);
+      Tcb->HighRxt = Seg->Ack + Len;
+      Tcb->Pipe   += Len;
+    }
+
+    TcpSackRetransmit (Tcb, Seg->Ack);
+    return;
+  }
+
+  if (TCP_SEQ_GEQ (Seg->Ack, Tcb->Recover)) {
+    //
+    // Full ACK: deflate the congestion window,
+    // and exit the loss recovery.
+    //
+    Tcb->CWnd         = MIN (Tcb->Ssthresh, FlightSize + Tcb->SndMss);
+    Tcb->CongestState = TCP_CONGEST_OPEN;
+
+    DEBUG (
+      (DEBUG_NET,
+       "TcpSackRecover: received a full ACK(%d) for TCB %p, exit loss recovery\n",
+       Seg->Ack,
+       Tcb)
+      );
+    return;
+  }
+
+  //
+  // During the loss recovery, every ACK updates the pipe and
+  // triggers the retransmission of the lost segments.
+  //
+  if (TCP_SEQ_LT (Tcb->HighRxt, Seg->Ack)) {
+    Tcb->HighRxt = Seg->Ack;
+  }
+
+  Tcb->Pipe = TcpSackGetPipe (Tcb, Seg->Ack);
+  TcpSackRetransmit (Tcb, Seg->Ack);
+}
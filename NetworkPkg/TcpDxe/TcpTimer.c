@@ -216,6 +216,7 @@ TcpRexmitTimeout (
   }
 
   TcpBackoffRto (Tcb);
+  TcpSackClearScoreboard (Tcb);
   TcpRetransmit (Tcb, Tcb->SndUna);
   TcpSetTimer (Tcb, TCP_TIMER_REXMIT, Tcb->Rto);
 
@@ -55,6 +55,13 @@ struct _TLS_SERVICE {
   // created for the connections.
   //
   VOID                            *TlsCtx;
+
+  //
+  // Sessions of verified connections which later connections to the same host
+  // may resume, most recently saved first.
+  //
+  LIST_ENTRY                      SessionCache;
+  UINTN                           SessionCacheCount;
 };
 
 struct _TLS_INSTANCE {
@@ -76,6 +83,20 @@ struct _TLS_INSTANCE {
   // per established connection.
   //
   VOID                              *TlsConn;
+
+  //
+  // Host name and flags set by EfiTlsVerifyHost, the key of the session in
+  // the session cache of the service.
+  //
+  CHAR8                             *HostName;
+  UINT32                            VerifyFlags;
+
+  //
+  // Hash of the TLS configuration data set on the instance. The session cache
+  // is not used when the configuration could not be hashed.
+  //
+  UINT8                             ConfigDigest[SHA256_DIGEST_SIZE];
+  BOOLEAN                           ConfigUnknown;
 };
 
 #define TLS_SERVICE_FROM_THIS(a)   \
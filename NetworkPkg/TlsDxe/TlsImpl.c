@@ -210,20 +210,20 @@ TlsDecryptPacket (
   UINT16             ThisPlainMessageSize;
   UINT8              *BufferOut;
   UINT32             BufferOutSize;
-  UINT32             RecordCount;
+  BOOLEAN            BufferInAllocated;
   INTN               Ret;
 
-  Status           = EFI_SUCCESS;
-  BytesCopied      = 0;
-  BufferIn         = NULL;
-  BufferInSize     = 0;
-  BufferInPtr      = NULL;
-  RecordHeaderIn   = NULL;
-  TempRecordHeader = NULL;
-  BufferOut        = NULL;
-  BufferOutSize    = 0;
-  RecordCount      = 0;
-  Ret              = 0;
+  Status            = EFI_SUCCESS;
+  BytesCopied       = 0;
+  BufferIn          = NULL;
+  BufferInSize      = 0;
+  BufferInPtr       = NULL;
+  RecordHeaderIn    = NULL;
+  TempRecordHeader  = NULL;
+  BufferOut         = NULL;
+  BufferOutSize     = 0;
+  BufferInAllocated = FALSE;
+  Ret               = 0;
 
   //
   // Calculate the size according to the fragment table.
@@ -232,46 +232,60 @@ TlsDecryptPacket (
     BufferInSize += (*FragmentTable)[Index].FragmentLength;
   }
 
-  //
-  // Allocate buffer for processing data
-  //
-  BufferIn = AllocateZeroPool (BufferInSize);
-  if (BufferIn == NULL) {
-    Status = EFI_OUT_OF_RESOURCES;
-    goto ERROR;
-  }
+  if (*FragmentCount == 1) {
+    //
+    // A single fragment, usually a batch of records received back to back,
+    // is passed to TLS without a copy. The plain text goes to a new buffer.
+    //
+    BufferIn = (*FragmentTable)[0].FragmentBuffer;
+  } else {
+    //
+    // Allocate buffer for processing data
+    //
+    BufferIn = AllocatePool (BufferInSize);
+    if (BufferIn == NULL) {
+      Status = EFI_OUT_OF_RESOURCES;
+      goto ERROR;
+    }
 
-  //
-  // Copy all TLS plain record header and payload to BufferIn
-  //
-  for (Index = 0; Index < *FragmentCount; Index++) {
-    CopyMem (
-      (BufferIn + BytesCopied),
-      (*FragmentTable)[Index].FragmentBuffer,
-      (*FragmentTable)[Index].FragmentLength
-      );
-    BytesCopied += (*FragmentTable)[Index].FragmentLength;
+    BufferInAllocated = TRUE;
+
+    //
+    // Copy all TLS plain record header and payload to BufferIn
+    //
+    for (Index = 0; Index < *FragmentCount; Index++) {
+      CopyMem (
+        (BufferIn + BytesCopied),
+        (*FragmentTable)[Index].FragmentBuffer,
+        (*FragmentTable)[Index].FragmentLength
+        );
+      BytesCopied += (*FragmentTable)[Index].FragmentLength;
+    }
   }
 
   //
-  // Count TLS record number.
+  // Check the TLS records.
   //
   BufferInPtr = BufferIn;
   while ((UINTN)BufferInPtr < (UINTN)BufferIn + BufferInSize) {
     RecordHeaderIn = (TLS_RECORD_HEADER *)BufferInPtr;
-    if ((RecordHeaderIn->ContentType != TlsContentTypeApplicationData) || (NTOHS (RecordHeaderIn->Length) > TLS_CIPHERTEXT_RECORD_MAX_PAYLOAD_LENGTH)) {
+    if (((UINTN)BufferIn + BufferInSize - (UINTN)BufferInPtr < TLS_RECORD_HEADER_LENGTH) ||
+        (RecordHeaderIn->ContentType != TlsContentTypeApplicationData) ||
+        (NTOHS (RecordHeaderIn->Length) > TLS_CIPHERTEXT_RECORD_MAX_PAYLOAD_LENGTH) ||
+        ((UINTN)BufferIn + BufferInSize - (UINTN)BufferInPtr < TLS_RECORD_HEADER_LENGTH + NTOHS (RecordHeaderIn->Length)))
+    {
       Status = EFI_INVALID_PARAMETER;
       goto ERROR;
     }
 
     BufferInPtr += TLS_RECORD_HEADER_LENGTH + NTOHS (RecordHeaderIn->Length);
-    RecordCount++;
   }
 
   //
-  // Allocate enough buffer to hold TLS Plaintext.
+  // The plain text of a record is never longer than its cipher text, so the
+  // size of the records bounds the size of the plain text records.
   //
-  BufferOut = AllocateZeroPool (RecordCount * (TLS_RECORD_HEADER_LENGTH + TLS_PLAINTEXT_RECORD_MAX_PAYLOAD_LENGTH));
+  BufferOut = AllocatePool (BufferInSize);
   if (BufferOut == NULL) {
     Status = EFI_OUT_OF_RESOURCES;
     goto ERROR;
@@ -295,7 +309,7 @@ TlsDecryptPacket (
     }
 
     Ret = 0;
-    Ret = TlsRead (TlsInstance->TlsConn, (UINT8 *)(TempRecordHeader + 1), TLS_PLAINTEXT_RECORD_MAX_PAYLOAD_LENGTH);
+    Ret = TlsRead (TlsInstance->TlsConn, (UINT8 *)(TempRecordHeader + 1), MIN (ThisCipherMessageSize, TLS_PLAINTEXT_RECORD_MAX_PAYLOAD_LENGTH));
 
     if (Ret > 0) {
       ThisPlainMessageSize = (UINT16)Ret;
@@ -316,7 +330,10 @@ TlsDecryptPacket (
     TempRecordHeader = (TLS_RECORD_HEADER *)((UINT8 *)TempRecordHeader + TLS_RECORD_HEADER_LENGTH + ThisPlainMessageSize);
   }
 
-  FreePool (BufferIn);
+  if (BufferInAllocated) {
+    FreePool (BufferIn);
+  }
+
   BufferIn = NULL;
 
   //
@@ -336,7 +353,7 @@ TlsDecryptPacket (
 
 ERROR:
 
-  if (BufferIn != NULL) {
+  if (BufferInAllocated && (BufferIn != NULL)) {
     FreePool (BufferIn);
     BufferIn = NULL;
   }
@@ -348,3 +365,288 @@ ERROR:
 
   return Status;
 }
+
+/**
+  Find the session cached for a host.
+
+  @param[in]  Service             The TLS service data.
+  @param[in]  HostName            The host name of the session.
+
+  @return The cache entry of the host, or NULL if no session is cached for it.
+
+**/
+STATIC
+TLS_SESSION_CACHE_ENTRY *
+TlsSessionCacheFind (
+  IN TLS_SERVICE  *Service,
+  IN CONST CHAR8  *HostName
+  )
+{
+  LIST_ENTRY               *Entry;
+  TLS_SESSION_CACHE_ENTRY  *CacheEntry;
+
+  NET_LIST_FOR_EACH (Entry, &Service->SessionCache) {
+    CacheEntry = NET_LIST_USER_STRUCT (Entry, TLS_SESSION_CACHE_ENTRY, Link);
+    if (AsciiStriCmp (CacheEntry->HostName, HostName) == 0) {
+      return CacheEntry;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Check whether a cached session was saved with the verification settings and
+  the TLS configuration of the TLS instance.
+
+  @param[in]  TlsInstance         The pointer to the TLS instance.
+  @param[in]  CacheEntry          The cache entry of the host of TlsInstance.
+
+  @retval TRUE                    The session may be resumed by TlsInstance.
+  @retval FALSE                   The session was saved with other settings.
+
+**/
+STATIC
+BOOLEAN
+TlsSessionCacheMatch (
+  IN TLS_INSTANCE             *TlsInstance,
+  IN TLS_SESSION_CACHE_ENTRY  *CacheEntry
+  )
+{
+  return (BOOLEAN)((CacheEntry->VerifyMethod == TlsGetVerify (TlsInstance->TlsConn)) &&
+                   (CacheEntry->VerifyFlags == TlsInstance->VerifyFlags) &&
+                   (CompareMem (CacheEntry->ConfigDigest, TlsInstance->ConfigDigest, SHA256_DIGEST_SIZE) == 0));
+}
+
+/**
+  Remove an entry from the session cache and release it.
+
+  @param[in]  Service             The TLS service data.
+  @param[in]  CacheEntry          The cache entry to remove.
+
+**/
+STATIC
+VOID
+TlsSessionCacheRemove (
+  IN TLS_SERVICE              *Service,
+  IN TLS_SESSION_CACHE_ENTRY  *CacheEntry
+  )
+{
+  ASSERT (Service->SessionCacheCount > 0);
+
+  RemoveEntryList (&CacheEntry->Link);
+  Service->SessionCacheCount--;
+
+  FreePool (CacheEntry->HostName);
+  FreePool (CacheEntry->Data);
+  FreePool (CacheEntry);
+}
+
+/**
+  Record TLS configuration data set on the TLS instance, so that sessions
+  saved with a different configuration are not resumed.
+
+  @param[in]  TlsInstance         The pointer to the TLS instance.
+  @param[in]  DataType            The type of the configuration data.
+  @param[in]  Data                The configuration data.
+  @param[in]  DataSize            The size of Data in bytes.
+
+**/
+VOID
+TlsSessionCacheUpdateConfig (
+  IN TLS_INSTANCE              *TlsInstance,
+  IN EFI_TLS_CONFIG_DATA_TYPE  DataType,
+  IN CONST VOID                *Data,
+  IN UINTN                     DataSize
+  )
+{
+  VOID     *HashContext;
+  BOOLEAN  Result;
+
+  if (TlsInstance->ConfigUnknown) {
+    return;
+  }
+
+  HashContext = AllocatePool (Sha256GetContextSize ());
+  if (HashContext == NULL) {
+    TlsInstance->ConfigUnknown = TRUE;
+    return;
+  }
+
+  //
+  // Chain the data to the hash of the configuration set before.
+  //
+  Result = Sha256Init (HashContext) &&
+           Sha256Update (HashContext, TlsInstance->ConfigDigest, SHA256_DIGEST_SIZE) &&
+           Sha256Update (HashContext, &DataType, sizeof (DataType)) &&
+           Sha256Update (HashContext, Data, DataSize) &&
+           Sha256Final (HashContext, TlsInstance->ConfigDigest);
+  if (!Result) {
+    TlsInstance->ConfigUnknown = TRUE;
+  }
+
+  FreePool (HashContext);
+}
+
+/**
+  Resume the session cached for the host of the TLS instance, if any.
+
+  A cached session saved with different verification settings or TLS
+  configuration is dropped instead. It must be called before the handshake of
+  the TLS instance starts.
+
+  @param[in]  TlsInstance         The pointer to the TLS instance.
+
+**/
+VOID
+TlsSessionCacheRestore (
+  IN TLS_INSTANCE  *TlsInstance
+  )
+{
+  TLS_SESSION_CACHE_ENTRY  *CacheEntry;
+  EFI_STATUS               Status;
+
+  if ((TlsInstance->HostName == NULL) || TlsInstance->ConfigUnknown) {
+    return;
+  }
+
+  CacheEntry = TlsSessionCacheFind (TlsInstance->Service, TlsInstance->HostName);
+  if (CacheEntry == NULL) {
+    return;
+  }
+
+  if (!TlsSessionCacheMatch (TlsInstance, CacheEntry)) {
+    DEBUG ((DEBUG_INFO, "TlsSessionCacheRestore: Drop the session of %a, the TLS settings changed\n", CacheEntry->HostName));
+    TlsSessionCacheRemove (TlsInstance->Service, CacheEntry);
+    return;
+  }
+
+  //
+  // The server may still refuse to resume the session, the handshake then
+  // falls back to a full one.
+  //
+  Status = TlsSetResumptionData (TlsInstance->TlsConn, CacheEntry->Data, CacheEntry->DataSize);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "TlsSessionCacheRestore: Drop the session of %a - %r\n", CacheEntry->HostName, Status));
+    TlsSessionCacheRemove (TlsInstance->Service, CacheEntry);
+  }
+}
+
+/**
+  Save the session of the TLS instance in the session cache, so that later
+  connections to the same host can resume it.
+
+  Only the sessions of connections whose host was verified are saved. A failed
+  session drops the session cached for its host.
+
+  @param[in]  TlsInstance         The pointer to the TLS instance.
+
+**/
+VOID
+TlsSessionCacheSave (
+  IN TLS_INSTANCE  *TlsInstance
+  )
+{
+  TLS_SERVICE              *Service;
+  TLS_SESSION_CACHE_ENTRY  *CacheEntry;
+  EFI_STATUS               Status;
+  VOID                     *Data;
+  UINTN                    DataSize;
+
+  if ((TlsInstance->HostName == NULL) || TlsInstance->ConfigUnknown) {
+    return;
+  }
+
+  Service    = TlsInstance->Service;
+  CacheEntry = TlsSessionCacheFind (Service, TlsInstance->HostName);
+
+  if ((TlsInstance->TlsSessionState != EfiTlsSessionDataTransferring) &&
+      (TlsInstance->TlsSessionState != EfiTlsSessionClosing))
+  {
+    if ((TlsInstance->TlsSessionState == EfiTlsSessionError) && (CacheEntry != NULL)) {
+      TlsSessionCacheRemove (Service, CacheEntry);
+    }
+
+    return;
+  }
+
+  //
+  // With TLS 1.3 the session is only resumable once the server has sent a
+  // ticket, which may arrive after the handshake.
+  //
+  DataSize = 0;
+  Status   = TlsGetResumptionData (TlsInstance->TlsConn, NULL, &DataSize);
+  if (Status != EFI_BUFFER_TOO_SMALL) {
+    return;
+  }
+
+  Data = AllocatePool (DataSize);
+  if (Data == NULL) {
+    return;
+  }
+
+  Status = TlsGetResumptionData (TlsInstance->TlsConn, Data, &DataSize);
+  if (EFI_ERROR (Status)) {
+    FreePool (Data);
+    return;
+  }
+
+  if (CacheEntry != NULL) {
+    RemoveEntryList (&CacheEntry->Link);
+    FreePool (CacheEntry->Data);
+  } else {
+    if (Service->SessionCacheCount >= TLS_SESSION_CACHE_MAX) {
+      //
+      // Evict the least recently saved session.
+      //
+      TlsSessionCacheRemove (
+        Service,
+        NET_LIST_USER_STRUCT (Service->SessionCache.BackLink, TLS_SESSION_CACHE_ENTRY, Link)
+        );
+    }
+
+    CacheEntry = AllocateZeroPool (sizeof (TLS_SESSION_CACHE_ENTRY));
+    if (CacheEntry == NULL) {
+      FreePool (Data);
+      return;
+    }
+
+    CacheEntry->HostName = AllocateCopyPool (AsciiStrSize (TlsInstance->HostName), TlsInstance->HostName);
+    if (CacheEntry->HostName == NULL) {
+      FreePool (CacheEntry);
+      FreePool (Data);
+      return;
+    }
+
+    Service->SessionCacheCount++;
+  }
+
+  CacheEntry->VerifyMethod = TlsGetVerify (TlsInstance->TlsConn);
+  CacheEntry->VerifyFlags  = TlsInstance->VerifyFlags;
+  CopyMem (CacheEntry->ConfigDigest, TlsInstance->ConfigDigest, SHA256_DIGEST_SIZE);
+  CacheEntry->Data     = Data;
+  CacheEntry->DataSize = DataSize;
+  InsertHeadList (&Service->SessionCache, &CacheEntry->Link);
+}
+
+/**
+  Release all the sessions in the session cache of the TLS service.
+
+  @param[in]  Service             The TLS service data.
+
+**/
+VOID
+TlsSessionCacheFree (
+  IN TLS_SERVICE  *Service
+  )
+{
+  LIST_ENTRY  *Entry;
+  LIST_ENTRY  *NextEntry;
+
+  NET_LIST_FOR_EACH_SAFE (Entry, NextEntry, &Service->SessionCache) {
+    TlsSessionCacheRemove (
+      Service,
+      NET_LIST_USER_STRUCT (Entry, TLS_SESSION_CACHE_ENTRY, Link)
+      );
+  }
+}
@@ -40,6 +40,26 @@ extern EFI_SERVICE_BINDING_PROTOCOL    mTlsServiceBinding;
 extern EFI_TLS_PROTOCOL                mTlsProtocol;
 extern EFI_TLS_CONFIGURATION_PROTOCOL  mTlsConfigurationProtocol;
 
+//
+// The maximum number of hosts whose sessions are kept in the session cache.
+//
+#define TLS_SESSION_CACHE_MAX  16
+
+///
+/// A session saved in the session cache of the TLS service. It is only
+/// resumed by a connection with the same verification settings and TLS
+/// configuration as the one that saved it.
+///
+typedef struct {
+  LIST_ENTRY    Link;
+  CHAR8         *HostName;
+  UINT32        VerifyMethod;
+  UINT32        VerifyFlags;
+  UINT8         ConfigDigest[SHA256_DIGEST_SIZE];
+  VOID          *Data;
+  UINTN         DataSize;
+} TLS_SESSION_CACHE_ENTRY;
+
 /**
   Encrypt the message listed in fragment.
 
@@ -86,6 +106,65 @@ TlsDecryptPacket (
   IN     UINT32                 *FragmentCount
   );
 
+/**
+  Record TLS configuration data set on the TLS instance, so that sessions
+  saved with a different configuration are not resumed.
+
+  @param[in]  TlsInstance         The pointer to the TLS instance.
+  @param[in]  DataType            The type of the configuration data.
+  @param[in]  Data                The configuration data.
+  @param[in]  DataSize            The size of Data in bytes.
+
+**/
+VOID
+TlsSessionCacheUpdateConfig (
+  IN TLS_INSTANCE              *TlsInstance,
+  IN EFI_TLS_CONFIG_DATA_TYPE  DataType,
+  IN CONST VOID                *Data,
+  IN UINTN                     DataSize
+  );
+
+/**
+  Resume the session cached for the host of the TLS instance, if any.
+
+  A cached session saved with different verification settings or TLS
+  configuration is dropped instead. It must be called before the handshake of
+  the TLS instance starts.
+
+  @param[in]  TlsInstance         The pointer to the TLS instance.
+
+**/
+VOID
+TlsSessionCacheRestore (
+  IN TLS_INSTANCE  *TlsInstance
+  );
+
+/**
+  Save the session of the TLS instance in the session cache, so that later
+  connections to the same host can resume it.
+
+  Only the sessions of connections whose host was verified are saved. A failed
+  session drops the session cached for its host.
+
+  @param[in]  TlsInstance         The pointer to the TLS instance.
+
+**/
+VOID
+TlsSessionCacheSave (
+  IN TLS_INSTANCE  *TlsInstance
+  );
+
+/**
+  Release all the sessions in the session cache of the TLS service.
+
+  @param[in]  Service             The TLS service data.
+
+**/
+VOID
+TlsSessionCacheFree (
+  IN TLS_SERVICE  *Service
+  );
+
 /**
   Set TLS session data.
 
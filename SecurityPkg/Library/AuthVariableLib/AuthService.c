@@ -169,6 +169,15 @@ EFI_SIGNATURE_ITEM  mSupportSigItem[] = {
   { EFI_CERT_X509_SHA512_GUID,    0, 80            }
 };
 
+//
+// SHA-256 digests of the signer certificates that chained up to a certificate
+// in KEK, oldest replaced first. A signer in this list only needs its signature
+// checked, see VerifyTimeBasedPayload().
+//
+UINT8  mKekSignerCache[KEK_SIGNER_CACHE_SIZE][SHA256_DIGEST_SIZE];
+UINTN  mKekSignerCacheCount = 0;
+UINTN  mKekSignerCacheNext  = 0;
+
 /**
   Finds variable in storage blocks of volatile and non-volatile storage areas.
 
@@ -1918,6 +1927,86 @@ CleanCertsFromDb (
   return Status;
 }
 
+/**
+  Forget the signers that verified against KEK, as PK or KEK may change.
+
+**/
+VOID
+FlushKekSignerCache (
+  VOID
+  )
+{
+  mKekSignerCacheCount = 0;
+  mKekSignerCacheNext  = 0;
+}
+
+/**
+  Compute the digest that identifies a signer in the KEK signer cache.
+
+  @param[in]  SignerCert      The DER encoded signer certificate.
+  @param[in]  SignerCertSize  The size of SignerCert, in bytes.
+  @param[out] Digest          The SHA-256 digest of SignerCert.
+
+  @retval TRUE   The digest is computed.
+  @retval FALSE  The digest could not be computed.
+**/
+BOOLEAN
+GetKekSignerDigest (
+  IN  UINT8  *SignerCert,
+  IN  UINTN  SignerCertSize,
+  OUT UINT8  Digest[SHA256_DIGEST_SIZE]
+  )
+{
+  return Sha256Init (mHashSha256Ctx) &&
+         Sha256Update (mHashSha256Ctx, SignerCert, SignerCertSize) &&
+         Sha256Final (mHashSha256Ctx, Digest);
+}
+
+/**
+  Check whether a signer verified against KEK before.
+
+  @param[in]  Digest  The digest of the signer, see GetKekSignerDigest().
+
+  @retval TRUE   The signer is in the cache.
+  @retval FALSE  The signer is not in the cache.
+**/
+BOOLEAN
+IsKekSignerCached (
+  IN UINT8  Digest[SHA256_DIGEST_SIZE]
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < mKekSignerCacheCount; Index++) {
+    if (CompareMem (mKekSignerCache[Index], Digest, SHA256_DIGEST_SIZE) == 0) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/**
+  Remember that a signer verified against KEK.
+
+  @param[in]  Digest  The digest of the signer, see GetKekSignerDigest().
+**/
+VOID
+AddKekSigner (
+  IN UINT8  Digest[SHA256_DIGEST_SIZE]
+  )
+{
+  if (IsKekSignerCached (Digest)) {
+    return;
+  }
+
+  CopyMem (mKekSignerCache[mKekSignerCacheNext], Digest, SHA256_DIGEST_SIZE);
+  mKekSignerCacheNext = (mKekSignerCacheNext + 1) % KEK_SIGNER_CACHE_SIZE;
+  if (mKekSignerCacheCount < KEK_SIGNER_CACHE_SIZE) {
+    mKekSignerCacheCount++;
+  }
+}
+
 /**
   Find hash algorithm index.
 
@@ -2019,6 +2108,8 @@ VerifyTimeBasedPayload (
   UINT8                          ShaDigest[SHA_DIGEST_SIZE_MAX];
   EFI_CERT_DATA                  *CertDataPtr;
   UINT8                          HashAlgId;
+  UINT8                          SignerDigest[SHA256_DIGEST_SIZE];
+  BOOLEAN                        SignerDigestValid;
 
   //
   // 1. TopLevelCert is the top-level issuer certificate in signature Signer Cert Chain
@@ -2034,6 +2125,8 @@ VerifyTimeBasedPayload (
   CertsInCertDb = NULL;
   CertDataPtr   = NULL;
 
+  SignerDigestValid = FALSE;
+
   //
   // When the attribute EFI_VARIABLE_TIME_BASED_AUTHENTICATED_WRITE_ACCESS is
   // set, then the Data buffer shall begin with an instance of a complete (and serialized)
@@ -2257,6 +2350,37 @@ VerifyTimeBasedPayload (
       return Status;
     }
 
+    //
+    // A single signer whose certificate chained up to KEK before is trusted
+    // by itself, so only the signature is checked. The whole KEK database is
+    // tried otherwise, and when the signature does not verify that way.
+    //
+    if (Pkcs7GetSigners (
+          SigData,
+          SigDataSize,
+          &SignerCerts,
+          &CertStackSize,
+          &TopLevelCert,
+          &TopLevelCertSize
+          ) &&
+        (SignerCerts[0] == 1))
+    {
+      SignerDigestValid = GetKekSignerDigest (TopLevelCert, TopLevelCertSize, SignerDigest);
+      if (SignerDigestValid && IsKekSignerCached (SignerDigest)) {
+        VerifyStatus = Pkcs7Verify (
+                         SigData,
+                         SigDataSize,
+                         TopLevelCert,
+                         TopLevelCertSize,
+                         NewData,
+                         NewDataSize
+                         );
+        if (VerifyStatus) {
+          goto Exit;
+        }
+      }
+    }
+
     //
     // Ready to verify Pkcs7 SignedData. Go through KEK Signature Database to find out X.509 CertList.
     //
@@ -2285,6 +2409,10 @@ VerifyTimeBasedPayload (
                            NewDataSize
                            );
           if (VerifyStatus) {
+            if (SignerDigestValid) {
+              AddKekSigner (SignerDigest);
+            }
+
             goto Exit;
           }
 
@@ -2407,7 +2535,7 @@ VerifyTimeBasedPayload (
 
 Exit:
 
-  if ((AuthVarType == AuthVarTypePk) || (AuthVarType == AuthVarTypePriv)) {
+  if ((AuthVarType == AuthVarTypePk) || (AuthVarType == AuthVarTypeKek) || (AuthVarType == AuthVarTypePriv)) {
     if (TopLevelCert != NULL) {
       Pkcs7FreeSigners (TopLevelCert);
     }
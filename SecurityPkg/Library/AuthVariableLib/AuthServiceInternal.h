@@ -33,6 +33,11 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #define TWO_BYTE_ENCODE  0x82
 
+///
+/// Number of signers remembered to have verified against KEK.
+///
+#define KEK_SIGNER_CACHE_SIZE  8
+
 ///
 /// Struct to record signature requirement defined by UEFI spec.
 /// For SigHeaderSize and SigDataSize, ((UINT32) ~0) means NO exact length requirement for this field.
@@ -92,6 +97,9 @@ extern UINT32  mMaxCertDbSize;
 extern UINT32  mPlatformMode;
 extern UINT8   mVendorKeyState;
 
+extern UINT8  mKekSignerCache[KEK_SIGNER_CACHE_SIZE][SHA256_DIGEST_SIZE];
+extern UINTN  mKekSignerCacheCount;
+
 extern VOID  *mHashSha256Ctx;
 extern VOID  *mHashSha384Ctx;
 extern VOID  *mHashSha512Ctx;
@@ -367,4 +375,13 @@ AuthServiceInternalUpdateVariableWithTimeStamp (
   IN EFI_TIME  *TimeStamp
   );
 
+/**
+  Forget the signers that verified against KEK, as PK or KEK may change.
+
+**/
+VOID
+FlushKekSignerCache (
+  VOID
+  );
+
 #endif
@@ -0,0 +1,1324 @@
+/** @file
+  Unit tests of the cache of the signers that verified against KEK.
+
+  The tests replay signed db and dbx updates against an in-memory variable
+  store. AuthService.c calls TestPkcs7Verify() instead of Pkcs7Verify(), see
+  the INF, so that the tests can count the signature verifications.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UnitTestLib.h>
+
+#include "../AuthServiceInternal.h"
+
+#define UNIT_TEST_NAME     "AuthVariableLibKekSignerCacheTest"
+#define UNIT_TEST_VERSION  "1.0"
+
+#define TEST_VARIABLE_COUNT       16
+#define TEST_REPEATED_WRITE_COUNT  8
+#define TEST_VARIABLE_NAME_SIZE   32
+#define TEST_MAX_VARIABLE_SIZE    SIZE_32KB
+#define TEST_DBX_ATTRIBUTES       (EFI_VARIABLE_NON_VOLATILE |                          \
+                                   EFI_VARIABLE_BOOTSERVICE_ACCESS |                    \
+                                   EFI_VARIABLE_RUNTIME_ACCESS |                        \
+                                   EFI_VARIABLE_TIME_BASED_AUTHENTICATED_WRITE_ACCESS | \
+                                   EFI_VARIABLE_APPEND_WRITE)
+#define TEST_KEK_ATTRIBUTES       (EFI_VARIABLE_NON_VOLATILE |       \
+                                   EFI_VARIABLE_BOOTSERVICE_ACCESS | \
+                                   EFI_VARIABLE_RUNTIME_ACCESS |     \
+                                   EFI_VARIABLE_TIME_BASED_AUTHENTICATED_WRITE_ACCESS)
+
+typedef struct {
+  BOOLEAN     InUse;
+  CHAR16      Name[TEST_VARIABLE_NAME_SIZE];
+  EFI_GUID    Guid;
+  UINT32      Attributes;
+  UINT8       *Data;
+  UINTN       DataSize;
+  EFI_TIME    TimeStamp;
+} TEST_VARIABLE;
+
+TEST_VARIABLE  mTestVariables[TEST_VARIABLE_COUNT];
+UINT8          mTestScratchBuffer[TEST_MAX_VARIABLE_SIZE];
+UINTN          mTestPkcs7VerifyCount;
+
+//
+// The CA that issued the dbx signer, it is in KEK.
+//
+UINT8  mTestKekCaCert[] = {
+  0x30, 0x82, 0x03, 0x16, 0x30, 0x82, 0x01, 0xfe, 0xa0, 0x03, 0x02, 0x01, 0x02, 0x02, 0x14, 0x53,
+  0x9e, 0xf6, 0x49, 0x78, 0xd6, 0x03, 0x49, 0x85, 0xad, 0x4c, 0x67, 0x77, 0x8f, 0xe0, 0xab, 0x7c,
+  0x7c, 0x55, 0xd1, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b,
+  0x05, 0x00, 0x30, 0x22, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x17, 0x41,
+  0x75, 0x74, 0x68, 0x56, 0x61, 0x72, 0x69, 0x61, 0x62, 0x6c, 0x65, 0x4c, 0x69, 0x62, 0x20, 0x54,
+  0x65, 0x73, 0x74, 0x20, 0x63, 0x61, 0x30, 0x20, 0x17, 0x0d, 0x32, 0x36, 0x31, 0x30, 0x31, 0x39,
+  0x30, 0x39, 0x32, 0x35, 0x32, 0x31, 0x5a, 0x18, 0x0f, 0x32, 0x31, 0x32, 0x36, 0x30, 0x39, 0x32,
+  0x35, 0x30, 0x39, 0x32, 0x35, 0x32, 0x31, 0x5a, 0x30, 0x22, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03,
+  0x55, 0x04, 0x03, 0x0c, 0x17, 0x41, 0x75, 0x74, 0x68, 0x56, 0x61, 0x72, 0x69, 0x61, 0x62, 0x6c,
+  0x65, 0x4c, 0x69, 0x62, 0x20, 0x54, 0x65, 0x73, 0x74, 0x20, 0x63, 0x61, 0x30, 0x82, 0x01, 0x22,
+  0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03,
+  0x82, 0x01, 0x0f, 0x00, 0x30, 0x82, 0x01, 0x0a, 0x02, 0x82, 0x01, 0x01, 0x00, 0xe9, 0xc6, 0xcd,
+  0x33, 0x57, 0x67, 0x04, 0x5b, 0xc5, 0x01, 0xb5, 0x77, 0xb6, 0xd9, 0x17, 0x60, 0xe0, 0x2f, 0x33,
+  0xb7, 0x3b, 0xd7, 0xc4, 0x2e, 0x16, 0x0d, 0x02, 0xe0, 0xb7, 0x8d, 0xec, 0xd9, 0x05, 0xd6, 0x93,
+  0x44, 0xfa, 0x45, 0xb4, 0x67, 0x65, 0x8c, 0x99, 0x79, 0x38, 0x04, 0x10, 0xf6, 0xc5, 0x43, 0xa6,
+  0x73, 0x2c, 0x51, 0x54, 0xc5, 0xb3, 0xb5, 0xe4, 0x37, 0x1a, 0x82, 0xf0, 0x2b, 0x9c, 0x3f, 0x8c,
+  0x2d, 0x1f, 0xf2, 0x6e, 0x43, 0x8c, 0xc8, 0x53, 0xf2, 0x84, 0xcf, 0xeb, 0x20, 0x18, 0x37, 0x30,
+  0x90, 0xc3, 0xa0, 0x17, 0xf2, 0x5c, 0x03, 0x96, 0xc7, 0x35, 0xfc, 0x3f, 0x3a, 0xcd, 0x9e, 0x6e,
+  0x1b, 0xe6, 0x74, 0x36, 0x31, 0xd2, 0x07, 0xd6, 0x20, 0x62, 0x7f, 0xa6, 0xe5, 0x8c, 0x6f, 0x2b,
+  0x3d, 0x4b, 0xc1, 0x28, 0x0a, 0xcc, 0xfb, 0x36, 0x65, 0x4b, 0xd9, 0x8a, 0x5f, 0xa2, 0x91, 0xcb,
+  0xb4, 0xd7, 0x38, 0x74, 0xbb, 0x2b, 0x43, 0x40, 0x30, 0x8d, 0x4f, 0xd7, 0xe0, 0x55, 0x4a, 0xad,
+  0xf3, 0x3e, 0x5c, 0x33, 0xb4, 0xbd, 0x2c, 0x44, 0xd7, 0x5f, 0xa4, 0xec, 0xb4, 0x05, 0x64, 0x1e,
+  0xc2, 0xa6, 0x08, 0x50, 0xba, 0x8a, 0xa1, 0x42, 0xda, 0x06, 0xca, 0x48, 0xc3, 0xa1, 0x0a, 0x87,
+  0x3b, 0x1e, 0x4b, 0x42, 0xe9, 0x6d, 0x75, 0xe4, 0x5e, 0xb1, 0x21, 0x18, 0x7a, 0x16, 0xe6, 0x63,
+  0xae, 0x51, 0x1b, 0x97, 0x25, 0xb2, 0xe2, 0x64, 0xe2, 0x14, 0xec, 0xb1, 0x14, 0xb0, 0xc1, 0x27,
+  0xd7, 0xff, 0x04, 0x0a, 0x5c, 0x40, 0xa1, 0xf5, 0x55, 0xa4, 0x59, 0x6e, 0xe1, 0x80, 0xe6, 0x2a,
+  0xbd, 0xfe, 0x58, 0x6c, 0x1e, 0x06, 0x9a, 0xda, 0x4e, 0x87, 0xcd, 0x61, 0x5e, 0x07, 0x52, 0x79,
+  0xec, 0x6b, 0xd3, 0x3e, 0x19, 0xdc, 0x5c, 0x7f, 0xf3, 0x0e, 0x71, 0xac, 0xd1, 0x02, 0x03, 0x01,
+  0x00, 0x01, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06, 0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff,
+  0x04, 0x05, 0x30, 0x03, 0x01, 0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01,
+  0xff, 0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d, 0x0e, 0x04, 0x16,
+  0x04, 0x14, 0xac, 0x90, 0x7f, 0xbd, 0x5a, 0x37, 0x81, 0x6b, 0xde, 0x11, 0x17, 0xfa, 0x36, 0xb4,
+  0x68, 0x14, 0x69, 0xc0, 0x2e, 0x48, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d,
+  0x01, 0x01, 0x0b, 0x05, 0x00, 0x03, 0x82, 0x01, 0x01, 0x00, 0x48, 0x26, 0x82, 0xe5, 0x64, 0xea,
+  0xd7, 0xe9, 0x21, 0x91, 0xad, 0x8c, 0x4b, 0x48, 0x4b, 0x55, 0xdb, 0x25, 0x2d, 0x9d, 0x3a, 0xae,
+  0xce, 0x20, 0x04, 0xe6, 0x3c, 0xa3, 0xdd, 0x48, 0x62, 0x03, 0x92, 0x49, 0x95, 0xab, 0xac, 0x34,
+  0x52, 0x10, 0xad, 0x43, 0xde, 0x44, 0x86, 0xe6, 0x07, 0xbd, 0x5f, 0xe1, 0x43, 0x44, 0x63, 0x18,
+  0xd3, 0xe7, 0x52, 0x31, 0x0e, 0xa4, 0x00, 0x3f, 0x51, 0xec, 0x23, 0x25, 0xd7, 0xb3, 0xa7, 0x59,
+  0xea, 0x21, 0x60, 0x4d, 0x8f, 0xe6, 0xd8, 0x05, 0x9c, 0xda, 0xd7, 0xfe, 0xc3, 0xd5, 0x5f, 0x21,
+  0xa9, 0xb8, 0x3c, 0xb8, 0x49, 0x7b, 0xbb, 0x7d, 0x00, 0xf6, 0xde, 0x5f, 0x70, 0x79, 0xac, 0x87,
+  0x8b, 0x91, 0xa3, 0x71, 0x8a, 0x47, 0x40, 0x8d, 0x17, 0xd1, 0x44, 0x4f, 0xa7, 0x47, 0xe1, 0xe3,
+  0xc0, 0x67, 0x3b, 0x01, 0x2c, 0x94, 0x9f, 0xe9, 0x50, 0x9c, 0x1c, 0x7a, 0xc3, 0xb6, 0x11, 0xba,
+  0xb7, 0xda, 0xfc, 0x1b, 0x51, 0x8b, 0x3c, 0x7c, 0xa6, 0x99, 0xc1, 0x0a, 0x81, 0xa2, 0x7a, 0x49,
+  0x03, 0x2e, 0xd0, 0x5d, 0x21, 0xbe, 0x8a, 0xed, 0x99, 0x09, 0x8f, 0x4f, 0x99, 0x72, 0xa0, 0x0d,
+  0x2d, 0x79, 0x3e, 0x74, 0xde, 0xe2, 0x2e, 0x81, 0x39, 0x17, 0x39, 0x25, 0x5c, 0x0f, 0xab, 0xa6,
+  0x72, 0x79, 0xc2, 0x21, 0x45, 0xb2, 0x60, 0x76, 0xc4, 0xcd, 0xf5, 0x0e, 0x82, 0x9a, 0x00, 0x58,
+  0xa8, 0x1a, 0xe4, 0x49, 0x5e, 0x10, 0xaa, 0x24, 0x5b, 0x0b, 0x24, 0x66, 0x5f, 0xae, 0x0b, 0xcb,
+  0xd8, 0x85, 0xb1, 0x58, 0x61, 0x17, 0x39, 0x80, 0xb7, 0x31, 0x8c, 0xb9, 0x07, 0x97, 0x54, 0xef,
+  0xad, 0xef, 0x8e, 0x2e, 0xd4, 0xb4, 0xfe, 0xb8, 0x4f, 0xa2, 0x46, 0xe4, 0x7a, 0xf5, 0xb1, 0x77,
+  0x6a, 0x1c, 0xf1, 0xa5, 0x49, 0xbc, 0x4a, 0xd6, 0x1a, 0x49,
+};
+
+//
+// An unrelated self-signed certificate, it is PK and the first KEK entry.
+//
+UINT8  mTestOtherCert[] = {
+  0x30, 0x82, 0x03, 0x1c, 0x30, 0x82, 0x02, 0x04, 0xa0, 0x03, 0x02, 0x01, 0x02, 0x02, 0x14, 0x76,
+  0x37, 0x3f, 0xa5, 0xb6, 0x44, 0xc1, 0x5b, 0x59, 0xb6, 0x58, 0x31, 0x1a, 0xd5, 0xa4, 0x17, 0x1a,
+  0x61, 0xd1, 0xce, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b,
+  0x05, 0x00, 0x30, 0x25, 0x31, 0x23, 0x30, 0x21, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x1a, 0x41,
+  0x75, 0x74, 0x68, 0x56, 0x61, 0x72, 0x69, 0x61, 0x62, 0x6c, 0x65, 0x4c, 0x69, 0x62, 0x20, 0x54,
+  0x65, 0x73, 0x74, 0x20, 0x6f, 0x74, 0x68, 0x65, 0x72, 0x30, 0x20, 0x17, 0x0d, 0x32, 0x36, 0x31,
+  0x30, 0x31, 0x39, 0x30, 0x39, 0x32, 0x35, 0x32, 0x31, 0x5a, 0x18, 0x0f, 0x32, 0x31, 0x32, 0x36,
+  0x30, 0x39, 0x32, 0x35, 0x30, 0x39, 0x32, 0x35, 0x32, 0x31, 0x5a, 0x30, 0x25, 0x31, 0x23, 0x30,
+  0x21, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x1a, 0x41, 0x75, 0x74, 0x68, 0x56, 0x61, 0x72, 0x69,
+  0x61, 0x62, 0x6c, 0x65, 0x4c, 0x69, 0x62, 0x20, 0x54, 0x65, 0x73, 0x74, 0x20, 0x6f, 0x74, 0x68,
+  0x65, 0x72, 0x30, 0x82, 0x01, 0x22, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d,
+  0x01, 0x01, 0x01, 0x05, 0x00, 0x03, 0x82, 0x01, 0x0f, 0x00, 0x30, 0x82, 0x01, 0x0a, 0x02, 0x82,
+  0x01, 0x01, 0x00, 0xbf, 0x68, 0x33, 0x8d, 0x10, 0xcf, 0x1c, 0xda, 0xd4, 0xc7, 0x48, 0xa4, 0xef,
+  0xc1, 0x38, 0x9e, 0xee, 0x36, 0x24, 0x89, 0x25, 0x96, 0xa3, 0x58, 0x2e, 0xa6, 0x08, 0x3e, 0x86,
+  0xd4, 0xb6, 0x7e, 0x21, 0x7f, 0x27, 0x18, 0x38, 0xb9, 0xa0, 0x20, 0x55, 0x10, 0x26, 0xc0, 0x24,
+  0x01, 0x96, 0x2f, 0xa4, 0x5a, 0xa4, 0x0f, 0xe0, 0x7d, 0x3f, 0x58, 0x44, 0x9b, 0x45, 0x05, 0xb1,
+  0x6e, 0xd0, 0xe4, 0xf1, 0x69, 0x76, 0x11, 0xbb, 0xa0, 0x13, 0x7d, 0xbf, 0xdb, 0x30, 0xce, 0x15,
+  0x18, 0xe4, 0xaf, 0x3f, 0x7b, 0x79, 0xa0, 0xe5, 0x01, 0x23, 0x56, 0xe1, 0xcc, 0x21, 0x81, 0x33,
+  0xa5, 0x10, 0x54, 0x14, 0x09, 0x17, 0x73, 0xd6, 0x09, 0xbe, 0x7d, 0xa0, 0x10, 0xc4, 0x21, 0x7d,
+  0x1e, 0x97, 0x76, 0x62, 0xf0, 0x51, 0x9c, 0x37, 0x8b, 0x58, 0x9d, 0x1b, 0x69, 0xc9, 0xa6, 0xef,
+  0x61, 0xe4, 0x72, 0xc8, 0x48, 0x29, 0xb4, 0x7e, 0xd4, 0x94, 0x29, 0x80, 0x72, 0xa7, 0xa4, 0x15,
+  0x7c, 0xc6, 0x6a, 0xf8, 0xf3, 0x1f, 0x62, 0x08, 0x9a, 0xdd, 0xc9, 0xfd, 0xca, 0x08, 0x31, 0x84,
+  0xbb, 0x15, 0x54, 0x30, 0x33, 0xa6, 0x93, 0xaf, 0x12, 0x27, 0x8a, 0x01, 0x57, 0x71, 0x05, 0x92,
+  0x8a, 0xf6, 0x59, 0x80, 0xe1, 0x6e, 0xb5, 0x14, 0x35, 0xcc, 0xad, 0xc1, 0xe2, 0xc5, 0x6d, 0x90,
+  0xcb, 0x45, 0x1c, 0x87, 0x0d, 0x53, 0x88, 0x9b, 0xf7, 0xee, 0xb6, 0xa3, 0xd3, 0x52, 0xfb, 0xf2,
+  0x3f, 0x81, 0x39, 0xbf, 0xcf, 0x63, 0xfb, 0xab, 0x20, 0x6b, 0x47, 0x62, 0x20, 0x68, 0x39, 0x96,
+  0xf9, 0xa7, 0x6a, 0x2e, 0x40, 0xad, 0x27, 0xad, 0x06, 0xeb, 0x08, 0x2b, 0x10, 0xdd, 0x72, 0x6c,
+  0x45, 0xe6, 0x45, 0xaf, 0x51, 0x43, 0x91, 0x61, 0x0d, 0x7e, 0x43, 0xb2, 0x6b, 0x46, 0x78, 0x0b,
+  0xae, 0x82, 0x27, 0x02, 0x03, 0x01, 0x00, 0x01, 0xa3, 0x42, 0x30, 0x40, 0x30, 0x0f, 0x06, 0x03,
+  0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01, 0x01, 0xff, 0x30, 0x0e, 0x06,
+  0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff, 0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30, 0x1d, 0x06,
+  0x03, 0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04, 0x14, 0xdf, 0x72, 0x94, 0x1b, 0xf8, 0x49, 0xf1, 0xf4,
+  0xd5, 0x55, 0xa5, 0x83, 0x57, 0x42, 0xbf, 0xea, 0xa0, 0xc6, 0x9e, 0xde, 0x30, 0x0d, 0x06, 0x09,
+  0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x03, 0x82, 0x01, 0x01, 0x00,
+  0xbb, 0xf1, 0xc8, 0x1b, 0xd2, 0x14, 0xe8, 0x4a, 0xb1, 0xeb, 0x81, 0xaa, 0xa9, 0x82, 0x60, 0x5d,
+  0xb4, 0x76, 0x3e, 0x51, 0x8f, 0xd9, 0x8a, 0x6d, 0x8c, 0x1f, 0x60, 0xa3, 0x51, 0xa9, 0xb0, 0xaa,
+  0xe8, 0x7c, 0x23, 0xf7, 0x64, 0xfa, 0xbb, 0xdb, 0x38, 0xea, 0x7c, 0x3b, 0x01, 0x62, 0x43, 0x5d,
+  0x45, 0x84, 0x49, 0xb2, 0xa4, 0xa3, 0x5c, 0xc0, 0x11, 0x4e, 0xcf, 0x50, 0xae, 0xff, 0x33, 0x7f,
+  0xf2, 0x54, 0x8d, 0x53, 0xb6, 0x2d, 0xc8, 0x2e, 0xf4, 0xeb, 0xaa, 0x34, 0x22, 0x20, 0xaf, 0x25,
+  0xd1, 0x23, 0xe7, 0x67, 0x8b, 0x1c, 0xe0, 0x47, 0x72, 0xe4, 0x46, 0x6f, 0x4b, 0xf6, 0x04, 0xdf,
+  0x50, 0x5d, 0xe5, 0x60, 0x6b, 0x41, 0xd9, 0xa1, 0x4c, 0x83, 0x0c, 0xb7, 0x98, 0x92, 0x2b, 0x6d,
+  0xc7, 0x44, 0x14, 0x47, 0x6d, 0x94, 0xc7, 0xd7, 0xda, 0x80, 0x18, 0xe1, 0x5a, 0xb8, 0xa1, 0xe3,
+  0x68, 0x48, 0x39, 0xca, 0xd2, 0xbc, 0x27, 0x41, 0x3d, 0x23, 0xb9, 0xe4, 0x1d, 0xc6, 0x1e, 0xe1,
+  0xf1, 0x6c, 0x83, 0x82, 0x87, 0x18, 0x91, 0xc9, 0x40, 0x2e, 0xa8, 0x8a, 0xc6, 0xeb, 0xe8, 0xdc,
+  0xdd, 0x95, 0x48, 0x59, 0xe4, 0x16, 0x9b, 0xb3, 0x9a, 0xb4, 0x1a, 0x78, 0xda, 0xa0, 0x4c, 0x30,
+  0xd4, 0xb6, 0xf6, 0x03, 0xdc, 0x88, 0x70, 0x04, 0xb5, 0xab, 0xbc, 0x9b, 0x07, 0x22, 0xda, 0x6a,
+  0xd7, 0x94, 0xaf, 0xd1, 0x5b, 0xd8, 0xd9, 0x25, 0x59, 0x6c, 0xad, 0xf6, 0x35, 0x6d, 0xe0, 0xed,
+  0x2f, 0xfb, 0x7f, 0xd9, 0x53, 0x63, 0xf6, 0x1d, 0x0a, 0x41, 0x93, 0x55, 0x12, 0x42, 0xbb, 0xa1,
+  0xff, 0xd5, 0xcc, 0xf6, 0x2a, 0x32, 0x44, 0xcc, 0xbb, 0xce, 0x31, 0xea, 0x4b, 0x79, 0xaf, 0xcd,
+  0xdf, 0x08, 0xbb, 0x69, 0x97, 0x59, 0x8b, 0xea, 0xe9, 0x8a, 0xd1, 0x9e, 0x19, 0x2e, 0x4c, 0x27,
+};
+
+//
+// An EFI_VARIABLE_AUTHENTICATION_2 appending a SHA-256 digest to dbx, signed
+// by a certificate the KEK CA issued.
+//
+UINT8  mTestDbxUpdate1[] = {
+  0xea, 0x07, 0x0a, 0x13, 0x0c, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xfd, 0x04, 0x00, 0x00, 0x00, 0x02, 0xf1, 0x0e, 0x9d, 0xd2, 0xaf, 0x4a, 0xdf, 0x68, 0xee, 0x49,
+  0x8a, 0xa9, 0x34, 0x7d, 0x37, 0x56, 0x65, 0xa7, 0x30, 0x82, 0x04, 0xe1, 0x06, 0x09, 0x2a, 0x86,
+  0x48, 0x86, 0xf7, 0x0d, 0x01, 0x07, 0x02, 0xa0, 0x82, 0x04, 0xd2, 0x30, 0x82, 0x04, 0xce, 0x02,
+  0x01, 0x01, 0x31, 0x0f, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02,
+  0x01, 0x05, 0x00, 0x30, 0x0b, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x07, 0x01,
+  0xa0, 0x82, 0x03, 0x40, 0x30, 0x82, 0x03, 0x3c, 0x30, 0x82, 0x02, 0x24, 0xa0, 0x03, 0x02, 0x01,
+  0x02, 0x02, 0x14, 0x78, 0x5e, 0x06, 0x6e, 0x66, 0x44, 0x26, 0x76, 0x3f, 0x31, 0x47, 0x2f, 0x1e,
+  0x8c, 0x1d, 0x7d, 0x7c, 0x95, 0x06, 0x58, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7,
+  0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x30, 0x22, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03, 0x55, 0x04,
+  0x03, 0x0c, 0x17, 0x41, 0x75, 0x74, 0x68, 0x56, 0x61, 0x72, 0x69, 0x61, 0x62, 0x6c, 0x65, 0x4c,
+  0x69, 0x62, 0x20, 0x54, 0x65, 0x73, 0x74, 0x20, 0x63, 0x61, 0x30, 0x20, 0x17, 0x0d, 0x32, 0x36,
+  0x31, 0x30, 0x31, 0x39, 0x30, 0x39, 0x32, 0x35, 0x32, 0x31, 0x5a, 0x18, 0x0f, 0x32, 0x31, 0x32,
+  0x36, 0x30, 0x39, 0x32, 0x35, 0x30, 0x39, 0x32, 0x35, 0x32, 0x31, 0x5a, 0x30, 0x2a, 0x31, 0x28,
+  0x30, 0x26, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x1f, 0x41, 0x75, 0x74, 0x68, 0x56, 0x61, 0x72,
+  0x69, 0x61, 0x62, 0x6c, 0x65, 0x4c, 0x69, 0x62, 0x20, 0x54, 0x65, 0x73, 0x74, 0x20, 0x64, 0x62,
+  0x78, 0x20, 0x73, 0x69, 0x67, 0x6e, 0x65, 0x72, 0x30, 0x82, 0x01, 0x22, 0x30, 0x0d, 0x06, 0x09,
+  0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03, 0x82, 0x01, 0x0f, 0x00,
+  0x30, 0x82, 0x01, 0x0a, 0x02, 0x82, 0x01, 0x01, 0x00, 0x96, 0xce, 0xf0, 0x72, 0x31, 0x0f, 0x44,
+  0xa1, 0xaa, 0xe4, 0x14, 0xd5, 0x7f, 0x62, 0x09, 0x48, 0x21, 0x1d, 0xc8, 0xbf, 0x0d, 0xba, 0x5a,
+  0x93, 0x95, 0x75, 0x40, 0x6a, 0x6f, 0x85, 0x51, 0x0f, 0x66, 0xcb, 0xf1, 0xa3, 0x3b, 0xdb, 0x54,
+  0x44, 0x93, 0x25, 0x9f, 0x53, 0xaf, 0xcf, 0x9e, 0x67, 0x73, 0xba, 0x03, 0x6a, 0xda, 0xaa, 0x8e,
+  0xaf, 0x43, 0x35, 0xfd, 0xaf, 0x49, 0x81, 0x9e, 0x21, 0xbd, 0x77, 0xd6, 0x1d, 0xb9, 0xe0, 0xbb,
+  0xfd, 0xab, 0x01, 0x67, 0x8a, 0x56, 0xea, 0x68, 0x13, 0x7f, 0x3e, 0x7c, 0x2a, 0x74, 0xb6, 0x53,
+  0xce, 0x0e, 0x71, 0xdc, 0xf5, 0x93, 0x84, 0x27, 0x8d, 0x63, 0xef, 0xd4, 0x5c, 0x2b, 0x57, 0xaf,
+  0x1d, 0x6e, 0x8b, 0xc6, 0x3a, 0x4a, 0x01, 0x1f, 0x15, 0xc8, 0x28, 0xab, 0xb1, 0x67, 0x1d, 0x37,
+  0xe6, 0x98, 0x53, 0x80, 0x8d, 0xd4, 0xfc, 0xbb, 0x11, 0xf6, 0xf8, 0x84, 0x6c, 0x81, 0x1d, 0xd9,
+  0xbe, 0xb5, 0x76, 0xa3, 0xb8, 0xa2, 0x78, 0xf5, 0x56, 0x04, 0xd6, 0x85, 0x55, 0xa5, 0xd7, 0x89,
+  0x3f, 0x49, 0x2e, 0xf5, 0x55, 0xbd, 0x2b, 0x0c, 0x9f, 0x7d, 0x75, 0x70, 0x94, 0x32, 0xe5, 0xc1,
+  0x46, 0x86, 0x39, 0xf1, 0xbb, 0x7f, 0x35, 0x99, 0xdb, 0x2c, 0x91, 0x17, 0x1f, 0xd0, 0xed, 0x75,
+  0x7c, 0x7f, 0x66, 0x71, 0x4e, 0x16, 0x5c, 0xca, 0x25, 0x27, 0xbd, 0xa2, 0x5b, 0x3a, 0x92, 0x38,
+  0x19, 0xcf, 0x20, 0x26, 0x2e, 0x05, 0x18, 0x65, 0x1e, 0x8c, 0xf4, 0xed, 0x9b, 0xf5, 0xe6, 0x99,
+  0xec, 0x23, 0x07, 0x68, 0x73, 0x61, 0x83, 0xd8, 0xd9, 0xf2, 0xf1, 0xd2, 0x7d, 0x50, 0x31, 0x6d,
+  0xee, 0x8e, 0x3e, 0x47, 0x55, 0x6c, 0xac, 0xc2, 0xa3, 0xa0, 0x76, 0x6d, 0x31, 0x75, 0x9d, 0x40,
+  0x14, 0x9f, 0xcd, 0x0b, 0x37, 0x3b, 0xf0, 0x39, 0xf5, 0x02, 0x03, 0x01, 0x00, 0x01, 0xa3, 0x60,
+  0x30, 0x5e, 0x30, 0x0c, 0x06, 0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x02, 0x30, 0x00,
+  0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff, 0x04, 0x04, 0x03, 0x02, 0x07, 0x80,
+  0x30, 0x1f, 0x06, 0x03, 0x55, 0x1d, 0x23, 0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0xac, 0x90, 0x7f,
+  0xbd, 0x5a, 0x37, 0x81, 0x6b, 0xde, 0x11, 0x17, 0xfa, 0x36, 0xb4, 0x68, 0x14, 0x69, 0xc0, 0x2e,
+  0x48, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04, 0x14, 0x82, 0xe5, 0x23, 0x95,
+  0x69, 0x3a, 0x83, 0xcb, 0x1f, 0x7e, 0x48, 0xb2, 0x6c, 0xa6, 0x2d, 0x97, 0x12, 0x67, 0x81, 0x93,
+  0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x03,
+  0x82, 0x01, 0x01, 0x00, 0xc2, 0x0c, 0x19, 0x58, 0x71, 0xc4, 0x39, 0x00, 0x96, 0xcc, 0x77, 0x2b,
+  0x3f, 0xb9, 0x44, 0x81, 0xd1, 0xb1, 0xf6, 0x25, 0xda, 0x41, 0x02, 0xb0, 0x9b, 0x27, 0x75, 0x4d,
+  0x62, 0xa4, 0x57, 0x8e, 0xd5, 0x5d, 0xd3, 0x60, 0x1a, 0xab, 0x25, 0x4c, 0xf6, 0x2c, 0x83, 0xa6,
+  0x23, 0x2c, 0xb0, 0x2e, 0x8d, 0x72, 0xa1, 0xb0, 0x8d, 0x2e, 0x4c, 0xe6, 0x80, 0xd2, 0x22, 0x06,
+  0xaf, 0x70, 0x7e, 0x44, 0x41, 0x4b, 0x16, 0xf1, 0x78, 0x9e, 0xe2, 0x87, 0x52, 0x2d, 0xf0, 0x90,
+  0x55, 0xc0, 0x00, 0xf9, 0x92, 0x0e, 0x7d, 0x49, 0x55, 0x26, 0x1d, 0x06, 0x41, 0x67, 0x94, 0xe8,
+  0x1f, 0x73, 0x51, 0x7f, 0x79, 0x96, 0x67, 0xc1, 0x2e, 0xab, 0x02, 0x67, 0x38, 0x3c, 0xc7, 0xae,
+  0xc4, 0xdd, 0x51, 0x91, 0x0b, 0x5b, 0xe0, 0x27, 0x19, 0x42, 0xad, 0x6a, 0x67, 0xfd, 0xff, 0x0a,
+  0x55, 0xae, 0x82, 0x52, 0x2b, 0x77, 0x1b, 0x42, 0x8e, 0x6e, 0xc8, 0x3d, 0xb6, 0x35, 0x1e, 0x8f,
+  0xfe, 0xbc, 0x7f, 0x3c, 0xa4, 0x0f, 0x89, 0x21, 0x07, 0x3d, 0xe0, 0x95, 0xb0, 0xe3, 0x23, 0x7c,
+  0x4e, 0x56, 0x84, 0xe6, 0xa1, 0x79, 0x7e, 0xd6, 0xba, 0x84, 0x70, 0x55, 0x33, 0x66, 0xc3, 0x17,
+  0x55, 0x75, 0x76, 0x04, 0xd9, 0x2a, 0xaa, 0xc9, 0xfb, 0xbe, 0x20, 0xd0, 0xdc, 0xd4, 0xf0, 0x64,
+  0x20, 0xb9, 0x78, 0x57, 0x1f, 0xfb, 0x19, 0x4a, 0x01, 0x78, 0x4c, 0x03, 0xb1, 0xe7, 0xd2, 0x45,
+  0x2d, 0x31, 0x5f, 0x4d, 0x43, 0x6b, 0xbb, 0xf7, 0xf8, 0x64, 0xba, 0x23, 0x59, 0x3f, 0x96, 0xe2,
+  0x45, 0xca, 0x49, 0x35, 0xd8, 0xd5, 0xe8, 0xac, 0x61, 0xd5, 0x43, 0x22, 0xff, 0x2b, 0x6e, 0x19,
+  0xed, 0xf1, 0x84, 0x63, 0x4c, 0x2b, 0x8a, 0x6a, 0xd3, 0xa1, 0xeb, 0xef, 0xbc, 0x85, 0xe0, 0xff,
+  0xb9, 0x69, 0xfe, 0x02, 0x31, 0x82, 0x01, 0x65, 0x30, 0x82, 0x01, 0x61, 0x02, 0x01, 0x01, 0x30,
+  0x3a, 0x30, 0x22, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x17, 0x41, 0x75,
+  0x74, 0x68, 0x56, 0x61, 0x72, 0x69, 0x61, 0x62, 0x6c, 0x65, 0x4c, 0x69, 0x62, 0x20, 0x54, 0x65,
+  0x73, 0x74, 0x20, 0x63, 0x61, 0x02, 0x14, 0x78, 0x5e, 0x06, 0x6e, 0x66, 0x44, 0x26, 0x76, 0x3f,
+  0x31, 0x47, 0x2f, 0x1e, 0x8c, 0x1d, 0x7d, 0x7c, 0x95, 0x06, 0x58, 0x30, 0x0d, 0x06, 0x09, 0x60,
+  0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x01, 0x05, 0x00, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86,
+  0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x04, 0x82, 0x01, 0x00, 0x6e, 0x5b, 0x71,
+  0xcc, 0xc1, 0x5e, 0xfd, 0xba, 0xa0, 0x40, 0x03, 0x6c, 0x9e, 0x82, 0xe8, 0xca, 0xdf, 0x1f, 0x2c,
+  0x1b, 0x5f, 0x79, 0xb0, 0xfe, 0x59, 0x16, 0xa7, 0xde, 0x48, 0x1d, 0x6f, 0xe4, 0xc4, 0xc5, 0x62,
+  0x22, 0x8c, 0x55, 0x16, 0x71, 0xef, 0x8b, 0x62, 0xbb, 0xff, 0x12, 0xdc, 0x95, 0x2f, 0x35, 0x3a,
+  0x61, 0xaf, 0xaa, 0x94, 0x82, 0xf2, 0xb4, 0xbb, 0x9c, 0xbc, 0x0b, 0x1a, 0x1a, 0xd4, 0xbc, 0xc8,
+  0x76, 0x43, 0x92, 0x54, 0xcd, 0xbc, 0xa4, 0xc5, 0x86, 0xc5, 0xe3, 0x0f, 0x14, 0x0e, 0xb3, 0x5f,
+  0x61, 0x3c, 0x72, 0x08, 0xc2, 0x72, 0x34, 0xf8, 0x6b, 0x86, 0x16, 0xb3, 0xb3, 0xec, 0xfe, 0xc8,
+  0xc1, 0xf9, 0x33, 0x7e, 0x42, 0x0d, 0xaf, 0xda, 0xb7, 0xfa, 0xfe, 0xf5, 0x33, 0xd7, 0xac, 0xaf,
+  0x4e, 0xdf, 0x55, 0x22, 0xd9, 0xce, 0x10, 0xe6, 0x8d, 0xdf, 0xb6, 0xc7, 0x47, 0x3b, 0x6e, 0x6c,
+  0x03, 0x09, 0x35, 0xf9, 0x5f, 0xa2, 0x1f, 0x40, 0xf9, 0xee, 0x0a, 0xed, 0xfd, 0xcb, 0x5b, 0x38,
+  0xd5, 0x4a, 0x8a, 0xf6, 0xb6, 0xc0, 0xd9, 0xda, 0x22, 0xcc, 0xe9, 0x47, 0x53, 0x1f, 0xb8, 0x19,
+  0x76, 0x4b, 0x69, 0xb3, 0xe6, 0x48, 0x43, 0xe9, 0xd5, 0x1a, 0xbd, 0x21, 0x1a, 0x03, 0x17, 0x91,
+  0xff, 0x33, 0xb4, 0x97, 0xe1, 0x5d, 0xbf, 0xee, 0x3a, 0x2d, 0x95, 0x51, 0x32, 0xa2, 0x8b, 0xe7,
+  0xbe, 0xfc, 0xf7, 0x80, 0xc5, 0x6c, 0xaf, 0x7e, 0xb1, 0x2d, 0x76, 0x4b, 0xa1, 0xf6, 0xd7, 0xfd,
+  0x75, 0x1f, 0xc0, 0xa3, 0x3d, 0x24, 0xa6, 0xa5, 0x35, 0x16, 0xed, 0x60, 0x58, 0x28, 0x74, 0xc7,
+  0x1e, 0x02, 0x8a, 0xb6, 0x97, 0x1a, 0xa3, 0x37, 0x01, 0x57, 0x30, 0x50, 0x8c, 0x03, 0x13, 0x8a,
+  0x6b, 0xb1, 0x65, 0xd6, 0xf9, 0xa6, 0x4d, 0xcf, 0xad, 0x56, 0x5a, 0x5b, 0x64, 0x26, 0x16, 0xc4,
+  0xc1, 0x4c, 0x50, 0x92, 0x40, 0xac, 0xa9, 0x41, 0xf9, 0x36, 0x93, 0x43, 0x28, 0x4c, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 0xbd, 0x9a, 0xfa, 0x77, 0x59, 0x03, 0x32,
+  0x4d, 0xbd, 0x60, 0x28, 0xf4, 0xe7, 0x8f, 0x78, 0x4b, 0x13, 0x41, 0xf6, 0x10, 0xe2, 0x0b, 0xc4,
+  0x49, 0xe6, 0x98, 0x7e, 0xd1, 0x4e, 0x38, 0x43, 0x4d, 0x8b, 0xc1, 0x6e, 0xc0, 0x21, 0x15, 0xb1,
+  0x73, 0xdc, 0x63, 0x89, 0x43, 0xe8, 0x9e, 0x9a, 0x1c,
+};
+
+//
+// Another dbx append from the same signer.
+//
+UINT8  mTestDbxUpdate2[] = {
+  0xea, 0x07, 0x0a, 0x13, 0x0c, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xfd, 0x04, 0x00, 0x00, 0x00, 0x02, 0xf1, 0x0e, 0x9d, 0xd2, 0xaf, 0x4a, 0xdf, 0x68, 0xee, 0x49,
+  0x8a, 0xa9, 0x34, 0x7d, 0x37, 0x56, 0x65, 0xa7, 0x30, 0x82, 0x04, 0xe1, 0x06, 0x09, 0x2a, 0x86,
+  0x48, 0x86, 0xf7, 0x0d, 0x01, 0x07, 0x02, 0xa0, 0x82, 0x04, 0xd2, 0x30, 0x82, 0x04, 0xce, 0x02,
+  0x01, 0x01, 0x31, 0x0f, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02,
+  0x01, 0x05, 0x00, 0x30, 0x0b, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x07, 0x01,
+  0xa0, 0x82, 0x03, 0x40, 0x30, 0x82, 0x03, 0x3c, 0x30, 0x82, 0x02, 0x24, 0xa0, 0x03, 0x02, 0x01,
+  0x02, 0x02, 0x14, 0x78, 0x5e, 0x06, 0x6e, 0x66, 0x44, 0x26, 0x76, 0x3f, 0x31, 0x47, 0x2f, 0x1e,
+  0x8c, 0x1d, 0x7d, 0x7c, 0x95, 0x06, 0x58, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7,
+  0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x30, 0x22, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03, 0x55, 0x04,
+  0x03, 0x0c, 0x17, 0x41, 0x75, 0x74, 0x68, 0x56, 0x61, 0x72, 0x69, 0x61, 0x62, 0x6c, 0x65, 0x4c,
+  0x69, 0x62, 0x20, 0x54, 0x65, 0x73, 0x74, 0x20, 0x63, 0x61, 0x30, 0x20, 0x17, 0x0d, 0x32, 0x36,
+  0x31, 0x30, 0x31, 0x39, 0x30, 0x39, 0x32, 0x35, 0x32, 0x31, 0x5a, 0x18, 0x0f, 0x32, 0x31, 0x32,
+  0x36, 0x30, 0x39, 0x32, 0x35, 0x30, 0x39, 0x32, 0x35, 0x32, 0x31, 0x5a, 0x30, 0x2a, 0x31, 0x28,
+  0x30, 0x26, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x1f, 0x41, 0x75, 0x74, 0x68, 0x56, 0x61, 0x72,
+  0x69, 0x61, 0x62, 0x6c, 0x65, 0x4c, 0x69, 0x62, 0x20, 0x54, 0x65, 0x73, 0x74, 0x20, 0x64, 0x62,
+  0x78, 0x20, 0x73, 0x69, 0x67, 0x6e, 0x65, 0x72, 0x30, 0x82, 0x01, 0x22, 0x30, 0x0d, 0x06, 0x09,
+  0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03, 0x82, 0x01, 0x0f, 0x00,
+  0x30, 0x82, 0x01, 0x0a, 0x02, 0x82, 0x01, 0x01, 0x00, 0x96, 0xce, 0xf0, 0x72, 0x31, 0x0f, 0x44,
+  0xa1, 0xaa, 0xe4, 0x14, 0xd5, 0x7f, 0x62, 0x09, 0x48, 0x21, 0x1d, 0xc8, 0xbf, 0x0d, 0xba, 0x5a,
+  0x93, 0x95, 0x75, 0x40, 0x6a, 0x6f, 0x85, 0x51, 0x0f, 0x66, 0xcb, 0xf1, 0xa3, 0x3b, 0xdb, 0x54,
+  0x44, 0x93, 0x25, 0x9f, 0x53, 0xaf, 0xcf, 0x9e, 0x67, 0x73, 0xba, 0x03, 0x6a, 0xda, 0xaa, 0x8e,
+  0xaf, 0x43, 0x35, 0xfd, 0xaf, 0x49, 0x81, 0x9e, 0x21, 0xbd, 0x77, 0xd6, 0x1d, 0xb9, 0xe0, 0xbb,
+  0xfd, 0xab, 0x01, 0x67, 0x8a, 0x56, 0xea, 0x68, 0x13, 0x7f, 0x3e, 0x7c, 0x2a, 0x74, 0xb6, 0x53,
+  0xce, 0x0e, 0x71, 0xdc, 0xf5, 0x93, 0x84, 0x27, 0x8d, 0x63, 0xef, 0xd4, 0x5c, 0x2b, 0x57, 0xaf,
+  0x1d, 0x6e, 0x8b, 0xc6, 0x3a, 0x4a, 0x01, 0x1f, 0x15, 0xc8, 0x28, 0xab, 0xb1, 0x67, 0x1d, 0x37,
+  0xe6, 0x98, 0x53, 0x80, 0x8d, 0xd4, 0xfc, 0xbb, 0x11, 0xf6, 0xf8, 0x84, 0x6c, 0x81, 0x1d, 0xd9,
+  0xbe, 0xb5, 0x76, 0xa3, 0xb8, 0xa2, 0x78, 0xf5, 0x56, 0x04, 0xd6, 0x85, 0x55, 0xa5, 0xd7, 0x89,
+  0x3f, 0x49, 0x2e, 0xf5, 0x55, 0xbd, 0x2b, 0x0c, 0x9f, 0x7d, 0x75, 0x70, 0x94, 0x32, 0xe5, 0xc1,
+  0x46, 0x86, 0x39, 0xf1, 0xbb, 0x7f, 0x35, 0x99, 0xdb, 0x2c, 0x91, 0x17, 0x1f, 0xd0, 0xed, 0x75,
+  0x7c, 0x7f, 0x66, 0x71, 0x4e, 0x16, 0x5c, 0xca, 0x25, 0x27, 0xbd, 0xa2, 0x5b, 0x3a, 0x92, 0x38,
+  0x19, 0xcf, 0x20, 0x26, 0x2e, 0x05, 0x18, 0x65, 0x1e, 0x8c, 0xf4, 0xed, 0x9b, 0xf5, 0xe6, 0x99,
+  0xec, 0x23, 0x07, 0x68, 0x73, 0x61, 0x83, 0xd8, 0xd9, 0xf2, 0xf1, 0xd2, 0x7d, 0x50, 0x31, 0x6d,
+  0xee, 0x8e, 0x3e, 0x47, 0x55, 0x6c, 0xac, 0xc2, 0xa3, 0xa0, 0x76, 0x6d, 0x31, 0x75, 0x9d, 0x40,
+  0x14, 0x9f, 0xcd, 0x0b, 0x37, 0x3b, 0xf0, 0x39, 0xf5, 0x02, 0x03, 0x01, 0x00, 0x01, 0xa3, 0x60,
+  0x30, 0x5e, 0x30, 0x0c, 0x06, 0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x02, 0x30, 0x00,
+  0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff, 0x04, 0x04, 0x03, 0x02, 0x07, 0x80,
+  0x30, 0x1f, 0x06, 0x03, 0x55, 0x1d, 0x23, 0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0xac, 0x90, 0x7f,
+  0xbd, 0x5a, 0x37, 0x81, 0x6b, 0xde, 0x11, 0x17, 0xfa, 0x36, 0xb4, 0x68, 0x14, 0x69, 0xc0, 0x2e,
+  0x48, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04, 0x14, 0x82, 0xe5, 0x23, 0x95,
+  0x69, 0x3a, 0x83, 0xcb, 0x1f, 0x7e, 0x48, 0xb2, 0x6c, 0xa6, 0x2d, 0x97, 0x12, 0x67, 0x81, 0x93,
+  0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x03,
+  0x82, 0x01, 0x01, 0x00, 0xc2, 0x0c, 0x19, 0x58, 0x71, 0xc4, 0x39, 0x00, 0x96, 0xcc, 0x77, 0x2b,
+  0x3f, 0xb9, 0x44, 0x81, 0xd1, 0xb1, 0xf6, 0x25, 0xda, 0x41, 0x02, 0xb0, 0x9b, 0x27, 0x75, 0x4d,
+  0x62, 0xa4, 0x57, 0x8e, 0xd5, 0x5d, 0xd3, 0x60, 0x1a, 0xab, 0x25, 0x4c, 0xf6, 0x2c, 0x83, 0xa6,
+  0x23, 0x2c, 0xb0, 0x2e, 0x8d, 0x72, 0xa1, 0xb0, 0x8d, 0x2e, 0x4c, 0xe6, 0x80, 0xd2, 0x22, 0x06,
+  0xaf, 0x70, 0x7e, 0x44, 0x41, 0x4b, 0x16, 0xf1, 0x78, 0x9e, 0xe2, 0x87, 0x52, 0x2d, 0xf0, 0x90,
+  0x55, 0xc0, 0x00, 0xf9, 0x92, 0x0e, 0x7d, 0x49, 0x55, 0x26, 0x1d, 0x06, 0x41, 0x67, 0x94, 0xe8,
+  0x1f, 0x73, 0x51, 0x7f, 0x79, 0x96, 0x67, 0xc1, 0x2e, 0xab, 0x02, 0x67, 0x38, 0x3c, 0xc7, 0xae,
+  0xc4, 0xdd, 0x51, 0x91, 0x0b, 0x5b, 0xe0, 0x27, 0x19, 0x42, 0xad, 0x6a, 0x67, 0xfd, 0xff, 0x0a,
+  0x55, 0xae, 0x82, 0x52, 0x2b, 0x77, 0x1b, 0x42, 0x8e, 0x6e, 0xc8, 0x3d, 0xb6, 0x35, 0x1e, 0x8f,
+  0xfe, 0xbc, 0x7f, 0x3c, 0xa4, 0x0f, 0x89, 0x21, 0x07, 0x3d, 0xe0, 0x95, 0xb0, 0xe3, 0x23, 0x7c,
+  0x4e, 0x56, 0x84, 0xe6, 0xa1, 0x79, 0x7e, 0xd6, 0xba, 0x84, 0x70, 0x55, 0x33, 0x66, 0xc3, 0x17,
+  0x55, 0x75, 0x76, 0x04, 0xd9, 0x2a, 0xaa, 0xc9, 0xfb, 0xbe, 0x20, 0xd0, 0xdc, 0xd4, 0xf0, 0x64,
+  0x20, 0xb9, 0x78, 0x57, 0x1f, 0xfb, 0x19, 0x4a, 0x01, 0x78, 0x4c, 0x03, 0xb1, 0xe7, 0xd2, 0x45,
+  0x2d, 0x31, 0x5f, 0x4d, 0x43, 0x6b, 0xbb, 0xf7, 0xf8, 0x64, 0xba, 0x23, 0x59, 0x3f, 0x96, 0xe2,
+  0x45, 0xca, 0x49, 0x35, 0xd8, 0xd5, 0xe8, 0xac, 0x61, 0xd5, 0x43, 0x22, 0xff, 0x2b, 0x6e, 0x19,
+  0xed, 0xf1, 0x84, 0x63, 0x4c, 0x2b, 0x8a, 0x6a, 0xd3, 0xa1, 0xeb, 0xef, 0xbc, 0x85, 0xe0, 0xff,
+  0xb9, 0x69, 0xfe, 0x02, 0x31, 0x82, 0x01, 0x65, 0x30, 0x82, 0x01, 0x61, 0x02, 0x01, 0x01, 0x30,
+  0x3a, 0x30, 0x22, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x17, 0x41, 0x75,
+  0x74, 0x68, 0x56, 0x61, 0x72, 0x69, 0x61, 0x62, 0x6c, 0x65, 0x4c, 0x69, 0x62, 0x20, 0x54, 0x65,
+  0x73, 0x74, 0x20, 0x63, 0x61, 0x02, 0x14, 0x78, 0x5e, 0x06, 0x6e, 0x66, 0x44, 0x26, 0x76, 0x3f,
+  0x31, 0x47, 0x2f, 0x1e, 0x8c, 0x1d, 0x7d, 0x7c, 0x95, 0x06, 0x58, 0x30, 0x0d, 0x06, 0x09, 0x60,
+  0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x01, 0x05, 0x00, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86,
+  0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x04, 0x82, 0x01, 0x00, 0x70, 0x55, 0xbf,
+  0xc7, 0x66, 0x78, 0xf1, 0xa8, 0xe0, 0x89, 0x95, 0x12, 0x45, 0x2f, 0x01, 0xb1, 0x14, 0x35, 0x69,
+  0x27, 0x9c, 0x45, 0x3f, 0xb5, 0x1e, 0xd0, 0x25, 0x29, 0x96, 0x27, 0xc2, 0xee, 0xef, 0x63, 0xce,
+  0x8d, 0x16, 0x25, 0x9e, 0x3d, 0xc2, 0x9f, 0x35, 0xd9, 0x97, 0xcd, 0x21, 0x5c, 0xe9, 0x40, 0x2d,
+  0x12, 0xf1, 0x42, 0xed, 0x06, 0x13, 0xd2, 0x5b, 0xe0, 0xe7, 0xc7, 0xb9, 0xb3, 0xfe, 0x03, 0xfb,
+  0x61, 0x2f, 0x8f, 0xae, 0x47, 0x8e, 0x10, 0xf7, 0xa9, 0x71, 0xf1, 0xd4, 0x4d, 0x27, 0x5e, 0xaf,
+  0x5a, 0xaf, 0xe9, 0x5b, 0x89, 0xcf, 0xcb, 0x9d, 0x9f, 0x92, 0x4a, 0xac, 0x27, 0xb5, 0x5b, 0x69,
+  0xfb, 0x24, 0x22, 0x74, 0x41, 0x32, 0x6d, 0x1c, 0x27, 0xbd, 0xee, 0xf8, 0x80, 0x2a, 0x0d, 0xca,
+  0x28, 0xc2, 0x23, 0xba, 0x45, 0xf7, 0xb7, 0xae, 0x6d, 0x93, 0xf9, 0x1f, 0x76, 0xdc, 0x49, 0xe7,
+  0x6f, 0x5d, 0x9a, 0x84, 0x08, 0xed, 0x95, 0x6d, 0xc7, 0x2e, 0x65, 0xef, 0xc7, 0xa2, 0xee, 0x7c,
+  0xe6, 0x97, 0xd5, 0x8d, 0xb5, 0xc7, 0xa0, 0x30, 0x10, 0x16, 0xa1, 0x7d, 0x77, 0x5e, 0x25, 0xa9,
+  0x91, 0x73, 0x12, 0x01, 0xe7, 0xe8, 0x53, 0x10, 0x10, 0x72, 0xce, 0x22, 0x5d, 0xae, 0x8f, 0x44,
+  0xf2, 0x2f, 0x95, 0x30, 0x09, 0x40, 0x87, 0xef, 0x64, 0x71, 0xc4, 0x47, 0xef, 0x7e, 0x12, 0x89,
+  0x8a, 0x01, 0x7c, 0x44, 0xe0, 0x51, 0x16, 0xb0, 0x3d, 0x43, 0x39, 0x54, 0x1d, 0xcf, 0xf5, 0x96,
+  0x73, 0x31, 0x14, 0xb2, 0x16, 0x8d, 0x6e, 0x65, 0x77, 0x1b, 0x71, 0xab, 0xb9, 0xed, 0x10, 0x81,
+  0xa3, 0xd9, 0xe8, 0xea, 0xfc, 0x62, 0x78, 0x45, 0x36, 0x94, 0x77, 0xb3, 0x1b, 0xce, 0xd7, 0x00,
+  0x51, 0x89, 0xcc, 0x5e, 0xf4, 0x4b, 0xca, 0x45, 0xbe, 0x65, 0x84, 0x94, 0x81, 0x26, 0x16, 0xc4,
+  0xc1, 0x4c, 0x50, 0x92, 0x40, 0xac, 0xa9, 0x41, 0xf9, 0x36, 0x93, 0x43, 0x28, 0x4c, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 0xbd, 0x9a, 0xfa, 0x77, 0x59, 0x03, 0x32,
+  0x4d, 0xbd, 0x60, 0x28, 0xf4, 0xe7, 0x8f, 0x78, 0x4b, 0xdf, 0x74, 0xdf, 0xe8, 0x34, 0xfe, 0x31,
+  0x59, 0xee, 0x75, 0x51, 0x73, 0xb4, 0x36, 0x6a, 0x4b, 0x14, 0x2b, 0xa8, 0xb7, 0x70, 0xd2, 0xfd,
+  0x39, 0x33, 0xbe, 0xbd, 0xc2, 0xe6, 0x3b, 0x45, 0x71,
+};
+
+//
+// An EFI_VARIABLE_AUTHENTICATION_2 appending a SHA-256 digest to db, from the
+// dbx signer.
+//
+UINT8  mTestDbUpdate1[] = {
+  0xea, 0x07, 0x0a, 0x13, 0x0c, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xfd, 0x04, 0x00, 0x00, 0x00, 0x02, 0xf1, 0x0e, 0x9d, 0xd2, 0xaf, 0x4a, 0xdf, 0x68, 0xee, 0x49,
+  0x8a, 0xa9, 0x34, 0x7d, 0x37, 0x56, 0x65, 0xa7, 0x30, 0x82, 0x04, 0xe1, 0x06, 0x09, 0x2a, 0x86,
+  0x48, 0x86, 0xf7, 0x0d, 0x01, 0x07, 0x02, 0xa0, 0x82, 0x04, 0xd2, 0x30, 0x82, 0x04, 0xce, 0x02,
+  0x01, 0x01, 0x31, 0x0f, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02,
+  0x01, 0x05, 0x00, 0x30, 0x0b, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x07, 0x01,
+  0xa0, 0x82, 0x03, 0x40, 0x30, 0x82, 0x03, 0x3c, 0x30, 0x82, 0x02, 0x24, 0xa0, 0x03, 0x02, 0x01,
+  0x02, 0x02, 0x14, 0x78, 0x5e, 0x06, 0x6e, 0x66, 0x44, 0x26, 0x76, 0x3f, 0x31, 0x47, 0x2f, 0x1e,
+  0x8c, 0x1d, 0x7d, 0x7c, 0x95, 0x06, 0x58, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7,
+  0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x30, 0x22, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03, 0x55, 0x04,
+  0x03, 0x0c, 0x17, 0x41, 0x75, 0x74, 0x68, 0x56, 0x61, 0x72, 0x69, 0x61, 0x62, 0x6c, 0x65, 0x4c,
+  0x69, 0x62, 0x20, 0x54, 0x65, 0x73, 0x74, 0x20, 0x63, 0x61, 0x30, 0x20, 0x17, 0x0d, 0x32, 0x36,
+  0x31, 0x30, 0x31, 0x39, 0x30, 0x39, 0x32, 0x35, 0x32, 0x31, 0x5a, 0x18, 0x0f, 0x32, 0x31, 0x32,
+  0x36, 0x30, 0x39, 0x32, 0x35, 0x30, 0x39, 0x32, 0x35, 0x32, 0x31, 0x5a, 0x30, 0x2a, 0x31, 0x28,
+  0x30, 0x26, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x1f, 0x41, 0x75, 0x74, 0x68, 0x56, 0x61, 0x72,
+  0x69, 0x61, 0x62, 0x6c, 0x65, 0x4c, 0x69, 0x62, 0x20, 0x54, 0x65, 0x73, 0x74, 0x20, 0x64, 0x62,
+  0x78, 0x20, 0x73, 0x69, 0x67, 0x6e, 0x65, 0x72, 0x30, 0x82, 0x01, 0x22, 0x30, 0x0d, 0x06, 0x09,
+  0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03, 0x82, 0x01, 0x0f, 0x00,
+  0x30, 0x82, 0x01, 0x0a, 0x02, 0x82, 0x01, 0x01, 0x00, 0x96, 0xce, 0xf0, 0x72, 0x31, 0x0f, 0x44,
+  0xa1, 0xaa, 0xe4, 0x14, 0xd5, 0x7f, 0x62, 0x09, 0x48, 0x21, 0x1d, 0xc8, 0xbf, 0x0d, 0xba, 0x5a,
+  0x93, 0x95, 0x75, 0x40, 0x6a, 0x6f, 0x85, 0x51, 0x0f, 0x66, 0xcb, 0xf1, 0xa3, 0x3b, 0xdb, 0x54,
+  0x44, 0x93, 0x25, 0x9f, 0x53, 0xaf, 0xcf, 0x9e, 0x67, 0x73, 0xba, 0x03, 0x6a, 0xda, 0xaa, 0x8e,
+  0xaf, 0x43, 0x35, 0xfd, 0xaf, 0x49, 0x81, 0x9e, 0x21, 0xbd, 0x77, 0xd6, 0x1d, 0xb9, 0xe0, 0xbb,
+  0xfd, 0xab, 0x01, 0x67, 0x8a, 0x56, 0xea, 0x68, 0x13, 0x7f, 0x3e, 0x7c, 0x2a, 0x74, 0xb6, 0x53,
+  0xce, 0x0e, 0x71, 0xdc, 0xf5, 0x93, 0x84, 0x27, 0x8d, 0x63, 0xef, 0xd4, 0x5c, 0x2b, 0x57, 0xaf,
+  0x1d, 0x6e, 0x8b, 0xc6, 0x3a, 0x4a, 0x01, 0x1f, 0x15, 0xc8, 0x28, 0xab, 0xb1, 0x67, 0x1d, 0x37,
+  0xe6, 0x98, 0x53, 0x80, 0x8d, 0xd4, 0xfc, 0xbb, 0x11, 0xf6, 0xf8, 0x84, 0x6c, 0x81, 0x1d, 0xd9,
+  0xbe, 0xb5, 0x76, 0xa3, 0xb8, 0xa2, 0x78, 0xf5, 0x56, 0x04, 0xd6, 0x85, 0x55, 0xa5, 0xd7, 0x89,
+  0x3f, 0x49, 0x2e, 0xf5, 0x55, 0xbd, 0x2b, 0x0c, 0x9f, 0x7d, 0x75, 0x70, 0x94, 0x32, 0xe5, 0xc1,
+  0x46, 0x86, 0x39, 0xf1, 0xbb, 0x7f, 0x35, 0x99, 0xdb, 0x2c, 0x91, 0x17, 0x1f, 0xd0, 0xed, 0x75,
+  0x7c, 0x7f, 0x66, 0x71, 0x4e, 0x16, 0x5c, 0xca, 0x25, 0x27, 0xbd, 0xa2, 0x5b, 0x3a, 0x92, 0x38,
+  0x19, 0xcf, 0x20, 0x26, 0x2e, 0x05, 0x18, 0x65, 0x1e, 0x8c, 0xf4, 0xed, 0x9b, 0xf5, 0xe6, 0x99,
+  0xec, 0x23, 0x07, 0x68, 0x73, 0x61, 0x83, 0xd8, 0xd9, 0xf2, 0xf1, 0xd2, 0x7d, 0x50, 0x31, 0x6d,
+  0xee, 0x8e, 0x3e, 0x47, 0x55, 0x6c, 0xac, 0xc2, 0xa3, 0xa0, 0x76, 0x6d, 0x31, 0x75, 0x9d, 0x40,
+  0x14, 0x9f, 0xcd, 0x0b, 0x37, 0x3b, 0xf0, 0x39, 0xf5, 0x02, 0x03, 0x01, 0x00, 0x01, 0xa3, 0x60,
+  0x30, 0x5e, 0x30, 0x0c, 0x06, 0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x02, 0x30, 0x00,
+  0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff, 0x04, 0x04, 0x03, 0x02, 0x07, 0x80,
+  0x30, 0x1f, 0x06, 0x03, 0x55, 0x1d, 0x23, 0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0xac, 0x90, 0x7f,
+  0xbd, 0x5a, 0x37, 0x81, 0x6b, 0xde, 0x11, 0x17, 0xfa, 0x36, 0xb4, 0x68, 0x14, 0x69, 0xc0, 0x2e,
+  0x48, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04, 0x14, 0x82, 0xe5, 0x23, 0x95,
+  0x69, 0x3a, 0x83, 0xcb, 0x1f, 0x7e, 0x48, 0xb2, 0x6c, 0xa6, 0x2d, 0x97, 0x12, 0x67, 0x81, 0x93,
+  0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x03,
+  0x82, 0x01, 0x01, 0x00, 0xc2, 0x0c, 0x19, 0x58, 0x71, 0xc4, 0x39, 0x00, 0x96, 0xcc, 0x77, 0x2b,
+  0x3f, 0xb9, 0x44, 0x81, 0xd1, 0xb1, 0xf6, 0x25, 0xda, 0x41, 0x02, 0xb0, 0x9b, 0x27, 0x75, 0x4d,
+  0x62, 0xa4, 0x57, 0x8e, 0xd5, 0x5d, 0xd3, 0x60, 0x1a, 0xab, 0x25, 0x4c, 0xf6, 0x2c, 0x83, 0xa6,
+  0x23, 0x2c, 0xb0, 0x2e, 0x8d, 0x72, 0xa1, 0xb0, 0x8d, 0x2e, 0x4c, 0xe6, 0x80, 0xd2, 0x22, 0x06,
+  0xaf, 0x70, 0x7e, 0x44, 0x41, 0x4b, 0x16, 0xf1, 0x78, 0x9e, 0xe2, 0x87, 0x52, 0x2d, 0xf0, 0x90,
+  0x55, 0xc0, 0x00, 0xf9, 0x92, 0x0e, 0x7d, 0x49, 0x55, 0x26, 0x1d, 0x06, 0x41, 0x67, 0x94, 0xe8,
+  0x1f, 0x73, 0x51, 0x7f, 0x79, 0x96, 0x67, 0xc1, 0x2e, 0xab, 0x02, 0x67, 0x38, 0x3c, 0xc7, 0xae,
+  0xc4, 0xdd, 0x51, 0x91, 0x0b, 0x5b, 0xe0, 0x27, 0x19, 0x42, 0xad, 0x6a, 0x67, 0xfd, 0xff, 0x0a,
+  0x55, 0xae, 0x82, 0x52, 0x2b, 0x77, 0x1b, 0x42, 0x8e, 0x6e, 0xc8, 0x3d, 0xb6, 0x35, 0x1e, 0x8f,
+  0xfe, 0xbc, 0x7f, 0x3c, 0xa4, 0x0f, 0x89, 0x21, 0x07, 0x3d, 0xe0, 0x95, 0xb0, 0xe3, 0x23, 0x7c,
+  0x4e, 0x56, 0x84, 0xe6, 0xa1, 0x79, 0x7e, 0xd6, 0xba, 0x84, 0x70, 0x55, 0x33, 0x66, 0xc3, 0x17,
+  0x55, 0x75, 0x76, 0x04, 0xd9, 0x2a, 0xaa, 0xc9, 0xfb, 0xbe, 0x20, 0xd0, 0xdc, 0xd4, 0xf0, 0x64,
+  0x20, 0xb9, 0x78, 0x57, 0x1f, 0xfb, 0x19, 0x4a, 0x01, 0x78, 0x4c, 0x03, 0xb1, 0xe7, 0xd2, 0x45,
+  0x2d, 0x31, 0x5f, 0x4d, 0x43, 0x6b, 0xbb, 0xf7, 0xf8, 0x64, 0xba, 0x23, 0x59, 0x3f, 0x96, 0xe2,
+  0x45, 0xca, 0x49, 0x35, 0xd8, 0xd5, 0xe8, 0xac, 0x61, 0xd5, 0x43, 0x22, 0xff, 0x2b, 0x6e, 0x19,
+  0xed, 0xf1, 0x84, 0x63, 0x4c, 0x2b, 0x8a, 0x6a, 0xd3, 0xa1, 0xeb, 0xef, 0xbc, 0x85, 0xe0, 0xff,
+  0xb9, 0x69, 0xfe, 0x02, 0x31, 0x82, 0x01, 0x65, 0x30, 0x82, 0x01, 0x61, 0x02, 0x01, 0x01, 0x30,
+  0x3a, 0x30, 0x22, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x17, 0x41, 0x75,
+  0x74, 0x68, 0x56, 0x61, 0x72, 0x69, 0x61, 0x62, 0x6c, 0x65, 0x4c, 0x69, 0x62, 0x20, 0x54, 0x65,
+  0x73, 0x74, 0x20, 0x63, 0x61, 0x02, 0x14, 0x78, 0x5e, 0x06, 0x6e, 0x66, 0x44, 0x26, 0x76, 0x3f,
+  0x31, 0x47, 0x2f, 0x1e, 0x8c, 0x1d, 0x7d, 0x7c, 0x95, 0x06, 0x58, 0x30, 0x0d, 0x06, 0x09, 0x60,
+  0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x01, 0x05, 0x00, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86,
+  0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x04, 0x82, 0x01, 0x00, 0x31, 0x2e, 0xe0,
+  0xc6, 0x06, 0xb0, 0xdc, 0x9a, 0xda, 0xcc, 0xa2, 0xd5, 0xfa, 0xbf, 0x77, 0x1a, 0x82, 0xca, 0x64,
+  0x03, 0xc3, 0x0d, 0x4e, 0x07, 0x2b, 0x45, 0x7a, 0x64, 0x0a, 0x1c, 0xf0, 0x23, 0x89, 0xa9, 0x8f,
+  0xa7, 0xc7, 0x1e, 0xdb, 0x1e, 0x39, 0xf3, 0x33, 0x2f, 0x2a, 0x97, 0x86, 0xb9, 0xda, 0x5a, 0x1a,
+  0x44, 0x81, 0xbd, 0xd4, 0xdc, 0xbd, 0x20, 0xe6, 0x03, 0xe7, 0x9f, 0xc1, 0x34, 0x99, 0x34, 0x60,
+  0xd7, 0x50, 0x4d, 0xbe, 0xb8, 0xbe, 0x07, 0xd1, 0x3a, 0xd0, 0x7c, 0xee, 0x13, 0xe3, 0x11, 0xfc,
+  0x83, 0x33, 0x4f, 0x0a, 0xca, 0xfd, 0xe4, 0xfb, 0x41, 0xbe, 0x5c, 0x6a, 0x88, 0x58, 0x77, 0x5c,
+  0x1a, 0x54, 0xbe, 0x21, 0xb8, 0x76, 0x45, 0x18, 0x5f, 0x4b, 0xdc, 0xaf, 0x31, 0x77, 0x9b, 0xee,
+  0xe9, 0x17, 0x2c, 0x13, 0x19, 0x31, 0xdb, 0x47, 0x19, 0x6d, 0xc1, 0xe1, 0xcf, 0xa9, 0x83, 0xc3,
+  0x9b, 0x4a, 0x9c, 0x7a, 0x1a, 0x2b, 0x94, 0x7d, 0x40, 0x69, 0x55, 0xa1, 0x4b, 0x83, 0xab, 0x4b,
+  0x27, 0x71, 0x73, 0x36, 0x9c, 0x58, 0x07, 0x0c, 0xff, 0xf6, 0x5d, 0xeb, 0xb7, 0x41, 0xbb, 0x12,
+  0x18, 0xc6, 0x95, 0xe3, 0x8b, 0xb8, 0xcc, 0xbe, 0xb1, 0x48, 0xc7, 0x74, 0xa4, 0x55, 0x09, 0xe1,
+  0x61, 0xbf, 0x8a, 0xa5, 0x75, 0xca, 0x12, 0x46, 0x2b, 0x48, 0x37, 0x43, 0x79, 0xa6, 0xd0, 0x41,
+  0x61, 0x18, 0xb1, 0xe6, 0x69, 0xd8, 0xcb, 0x33, 0xf5, 0x30, 0xeb, 0xf3, 0x3d, 0x1f, 0x31, 0xf2,
+  0x94, 0x4a, 0x9b, 0xab, 0x89, 0x45, 0x7d, 0xca, 0x6a, 0xf7, 0xe6, 0x4b, 0x39, 0x20, 0x72, 0x28,
+  0xd3, 0x54, 0x18, 0x09, 0x89, 0x6b, 0x8e, 0x24, 0xd0, 0x2e, 0x9d, 0xc6, 0xe9, 0xa1, 0x44, 0xd0,
+  0xc6, 0x60, 0x49, 0x93, 0xd6, 0x88, 0x31, 0x9c, 0x00, 0x4c, 0x71, 0xb5, 0x39, 0x26, 0x16, 0xc4,
+  0xc1, 0x4c, 0x50, 0x92, 0x40, 0xac, 0xa9, 0x41, 0xf9, 0x36, 0x93, 0x43, 0x28, 0x4c, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 0xbd, 0x9a, 0xfa, 0x77, 0x59, 0x03, 0x32,
+  0x4d, 0xbd, 0x60, 0x28, 0xf4, 0xe7, 0x8f, 0x78, 0x4b, 0x08, 0x9e, 0xc7, 0x9b, 0x3b, 0x69, 0x44,
+  0xca, 0x22, 0x56, 0xe8, 0xae, 0xdf, 0x43, 0x73, 0x2e, 0x3b, 0xdd, 0x3f, 0x84, 0xc8, 0x7d, 0x80,
+  0x5c, 0xf1, 0x85, 0x0e, 0x5f, 0xfd, 0xd5, 0x99, 0xec,
+};
+
+//
+// Another db append from the same signer.
+//
+UINT8  mTestDbUpdate2[] = {
+  0xea, 0x07, 0x0a, 0x13, 0x0c, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xfd, 0x04, 0x00, 0x00, 0x00, 0x02, 0xf1, 0x0e, 0x9d, 0xd2, 0xaf, 0x4a, 0xdf, 0x68, 0xee, 0x49,
+  0x8a, 0xa9, 0x34, 0x7d, 0x37, 0x56, 0x65, 0xa7, 0x30, 0x82, 0x04, 0xe1, 0x06, 0x09, 0x2a, 0x86,
+  0x48, 0x86, 0xf7, 0x0d, 0x01, 0x07, 0x02, 0xa0, 0x82, 0x04, 0xd2, 0x30, 0x82, 0x04, 0xce, 0x02,
+  0x01, 0x01, 0x31, 0x0f, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02,
+  0x01, 0x05, 0x00, 0x30, 0x0b, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x07, 0x01,
+  0xa0, 0x82, 0x03, 0x40, 0x30, 0x82, 0x03, 0x3c, 0x30, 0x82, 0x02, 0x24, 0xa0, 0x03, 0x02, 0x01,
+  0x02, 0x02, 0x14, 0x78, 0x5e, 0x06, 0x6e, 0x66, 0x44, 0x26, 0x76, 0x3f, 0x31, 0x47, 0x2f, 0x1e,
+  0x8c, 0x1d, 0x7d, 0x7c, 0x95, 0x06, 0x58, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7,
+  0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x30, 0x22, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03, 0x55, 0x04,
+  0x03, 0x0c, 0x17, 0x41, 0x75, 0x74, 0x68, 0x56, 0x61, 0x72, 0x69, 0x61, 0x62, 0x6c, 0x65, 0x4c,
+  0x69, 0x62, 0x20, 0x54, 0x65, 0x73, 0x74, 0x20, 0x63, 0x61, 0x30, 0x20, 0x17, 0x0d, 0x32, 0x36,
+  0x31, 0x30, 0x31, 0x39, 0x30, 0x39, 0x32, 0x35, 0x32, 0x31, 0x5a, 0x18, 0x0f, 0x32, 0x31, 0x32,
+  0x36, 0x30, 0x39, 0x32, 0x35, 0x30, 0x39, 0x32, 0x35, 0x32, 0x31, 0x5a, 0x30, 0x2a, 0x31, 0x28,
+  0x30, 0x26, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x1f, 0x41, 0x75, 0x74, 0x68, 0x56, 0x61, 0x72,
+  0x69, 0x61, 0x62, 0x6c, 0x65, 0x4c, 0x69, 0x62, 0x20, 0x54, 0x65, 0x73, 0x74, 0x20, 0x64, 0x62,
+  0x78, 0x20, 0x73, 0x69, 0x67, 0x6e, 0x65, 0x72, 0x30, 0x82, 0x01, 0x22, 0x30, 0x0d, 0x06, 0x09,
+  0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03, 0x82, 0x01, 0x0f, 0x00,
+  0x30, 0x82, 0x01, 0x0a, 0x02, 0x82, 0x01, 0x01, 0x00, 0x96, 0xce, 0xf0, 0x72, 0x31, 0x0f, 0x44,
+  0xa1, 0xaa, 0xe4, 0x14, 0xd5, 0x7f, 0x62, 0x09, 0x48, 0x21, 0x1d, 0xc8, 0xbf, 0x0d, 0xba, 0x5a,
+  0x93, 0x95, 0x75, 0x40, 0x6a, 0x6f, 0x85, 0x51, 0x0f, 0x66, 0xcb, 0xf1, 0xa3, 0x3b, 0xdb, 0x54,
+  0x44, 0x93, 0x25, 0x9f, 0x53, 0xaf, 0xcf, 0x9e, 0x67, 0x73, 0xba, 0x03, 0x6a, 0xda, 0xaa, 0x8e,
+  0xaf, 0x43, 0x35, 0xfd, 0xaf, 0x49, 0x81, 0x9e, 0x21, 0xbd, 0x77, 0xd6, 0x1d, 0xb9, 0xe0, 0xbb,
+  0xfd, 0xab, 0x01, 0x67, 0x8a, 0x56, 0xea, 0x68, 0x13, 0x7f, 0x3e, 0x7c, 0x2a, 0x74, 0xb6, 0x53,
+  0xce, 0x0e, 0x71, 0xdc, 0xf5, 0x93, 0x84, 0x27, 0x8d, 0x63, 0xef, 0xd4, 0x5c, 0x2b, 0x57, 0xaf,
+  0x1d, 0x6e, 0x8b, 0xc6, 0x3a, 0x4a, 0x01, 0x1f, 0x15, 0xc8, 0x28, 0xab, 0xb1, 0x67, 0x1d, 0x37,
+  0xe6, 0x98, 0x53, 0x80, 0x8d, 0xd4, 0xfc, 0xbb, 0x11, 0xf6, 0xf8, 0x84, 0x6c, 0x81, 0x1d, 0xd9,
+  0xbe, 0xb5, 0x76, 0xa3, 0xb8, 0xa2, 0x78, 0xf5, 0x56, 0x04, 0xd6, 0x85, 0x55, 0xa5, 0xd7, 0x89,
+  0x3f, 0x49, 0x2e, 0xf5, 0x55, 0xbd, 0x2b, 0x0c, 0x9f, 0x7d, 0x75, 0x70, 0x94, 0x32, 0xe5, 0xc1,
+  0x46, 0x86, 0x39, 0xf1, 0xbb, 0x7f, 0x35, 0x99, 0xdb, 0x2c, 0x91, 0x17, 0x1f, 0xd0, 0xed, 0x75,
+  0x7c, 0x7f, 0x66, 0x71, 0x4e, 0x16, 0x5c, 0xca, 0x25, 0x27, 0xbd, 0xa2, 0x5b, 0x3a, 0x92, 0x38,
+  0x19, 0xcf, 0x20, 0x26, 0x2e, 0x05, 0x18, 0x65, 0x1e, 0x8c, 0xf4, 0xed, 0x9b, 0xf5, 0xe6, 0x99,
+  0xec, 0x23, 0x07, 0x68, 0x73, 0x61, 0x83, 0xd8, 0xd9, 0xf2, 0xf1, 0xd2, 0x7d, 0x50, 0x31, 0x6d,
+  0xee, 0x8e, 0x3e, 0x47, 0x55, 0x6c, 0xac, 0xc2, 0xa3, 0xa0, 0x76, 0x6d, 0x31, 0x75, 0x9d, 0x40,
+  0x14, 0x9f, 0xcd, 0x0b, 0x37, 0x3b, 0xf0, 0x39, 0xf5, 0x02, 0x03, 0x01, 0x00, 0x01, 0xa3, 0x60,
+  0x30, 0x5e, 0x30, 0x0c, 0x06, 0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x02, 0x30, 0x00,
+  0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff, 0x04, 0x04, 0x03, 0x02, 0x07, 0x80,
+  0x30, 0x1f, 0x06, 0x03, 0x55, 0x1d, 0x23, 0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0xac, 0x90, 0x7f,
+  0xbd, 0x5a, 0x37, 0x81, 0x6b, 0xde, 0x11, 0x17, 0xfa, 0x36, 0xb4, 0x68, 0x14, 0x69, 0xc0, 0x2e,
+  0x48, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04, 0x14, 0x82, 0xe5, 0x23, 0x95,
+  0x69, 0x3a, 0x83, 0xcb, 0x1f, 0x7e, 0x48, 0xb2, 0x6c, 0xa6, 0x2d, 0x97, 0x12, 0x67, 0x81, 0x93,
+  0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x03,
+  0x82, 0x01, 0x01, 0x00, 0xc2, 0x0c, 0x19, 0x58, 0x71, 0xc4, 0x39, 0x00, 0x96, 0xcc, 0x77, 0x2b,
+  0x3f, 0xb9, 0x44, 0x81, 0xd1, 0xb1, 0xf6, 0x25, 0xda, 0x41, 0x02, 0xb0, 0x9b, 0x27, 0x75, 0x4d,
+  0x62, 0xa4, 0x57, 0x8e, 0xd5, 0x5d, 0xd3, 0x60, 0x1a, 0xab, 0x25, 0x4c, 0xf6, 0x2c, 0x83, 0xa6,
+  0x23, 0x2c, 0xb0, 0x2e, 0x8d, 0x72, 0xa1, 0xb0, 0x8d, 0x2e, 0x4c, 0xe6, 0x80, 0xd2, 0x22, 0x06,
+  0xaf, 0x70, 0x7e, 0x44, 0x41, 0x4b, 0x16, 0xf1, 0x78, 0x9e, 0xe2, 0x87, 0x52, 0x2d, 0xf0, 0x90,
+  0x55, 0xc0, 0x00, 0xf9, 0x92, 0x0e, 0x7d, 0x49, 0x55, 0x26, 0x1d, 0x06, 0x41, 0x67, 0x94, 0xe8,
+  0x1f, 0x73, 0x51, 0x7f, 0x79, 0x96, 0x67, 0xc1, 0x2e, 0xab, 0x02, 0x67, 0x38, 0x3c, 0xc7, 0xae,
+  0xc4, 0xdd, 0x51, 0x91, 0x0b, 0x5b, 0xe0, 0x27, 0x19, 0x42, 0xad, 0x6a, 0x67, 0xfd, 0xff, 0x0a,
+  0x55, 0xae, 0x82, 0x52, 0x2b, 0x77, 0x1b, 0x42, 0x8e, 0x6e, 0xc8, 0x3d, 0xb6, 0x35, 0x1e, 0x8f,
+  0xfe, 0xbc, 0x7f, 0x3c, 0xa4, 0x0f, 0x89, 0x21, 0x07, 0x3d, 0xe0, 0x95, 0xb0, 0xe3, 0x23, 0x7c,
+  0x4e, 0x56, 0x84, 0xe6, 0xa1, 0x79, 0x7e, 0xd6, 0xba, 0x84, 0x70, 0x55, 0x33, 0x66, 0xc3, 0x17,
+  0x55, 0x75, 0x76, 0x04, 0xd9, 0x2a, 0xaa, 0xc9, 0xfb, 0xbe, 0x20, 0xd0, 0xdc, 0xd4, 0xf0, 0x64,
+  0x20, 0xb9, 0x78, 0x57, 0x1f, 0xfb, 0x19, 0x4a, 0x01, 0x78, 0x4c, 0x03, 0xb1, 0xe7, 0xd2, 0x45,
+  0x2d, 0x31, 0x5f, 0x4d, 0x43, 0x6b, 0xbb, 0xf7, 0xf8, 0x64, 0xba, 0x23, 0x59, 0x3f, 0x96, 0xe2,
+  0x45, 0xca, 0x49, 0x35, 0xd8, 0xd5, 0xe8, 0xac, 0x61, 0xd5, 0x43, 0x22, 0xff, 0x2b, 0x6e, 0x19,
+  0xed, 0xf1, 0x84, 0x63, 0x4c, 0x2b, 0x8a, 0x6a, 0xd3, 0xa1, 0xeb, 0xef, 0xbc, 0x85, 0xe0, 0xff,
+  0xb9, 0x69, 0xfe, 0x02, 0x31, 0x82, 0x01, 0x65, 0x30, 0x82, 0x01, 0x61, 0x02, 0x01, 0x01, 0x30,
+  0x3a, 0x30, 0x22, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x17, 0x41, 0x75,
+  0x74, 0x68, 0x56, 0x61, 0x72, 0x69, 0x61, 0x62, 0x6c, 0x65, 0x4c, 0x69, 0x62, 0x20, 0x54, 0x65,
+  0x73, 0x74, 0x20, 0x63, 0x61, 0x02, 0x14, 0x78, 0x5e, 0x06, 0x6e, 0x66, 0x44, 0x26, 0x76, 0x3f,
+  0x31, 0x47, 0x2f, 0x1e, 0x8c, 0x1d, 0x7d, 0x7c, 0x95, 0x06, 0x58, 0x30, 0x0d, 0x06, 0x09, 0x60,
+  0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x01, 0x05, 0x00, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86,
+  0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x04, 0x82, 0x01, 0x00, 0x2c, 0xdb, 0x14,
+  0xf5, 0xa4, 0xd2, 0x3b, 0xc2, 0xc6, 0x74, 0xd3, 0x48, 0x8a, 0x3e, 0xb9, 0x18, 0xcb, 0xd0, 0x3c,
+  0xa5, 0xf1, 0x3d, 0x81, 0xc2, 0xcd, 0x26, 0xf5, 0xa1, 0x57, 0xda, 0xfb, 0x50, 0x53, 0xf1, 0xa4,
+  0xef, 0xde, 0x63, 0x62, 0xbf, 0x9a, 0xa6, 0xf7, 0x01, 0x28, 0xf6, 0x93, 0x3d, 0x07, 0xe1, 0x1f,
+  0x2d, 0x01, 0x34, 0x88, 0x31, 0x1a, 0xc0, 0xd8, 0xf2, 0xa1, 0x2d, 0x1e, 0x64, 0x73, 0xde, 0x2d,
+  0x0f, 0x45, 0xb4, 0xba, 0x60, 0xb6, 0xde, 0xd3, 0x45, 0x39, 0x28, 0x70, 0xc0, 0x4b, 0x10, 0x38,
+  0xd3, 0xc0, 0xc2, 0x6a, 0x00, 0x30, 0xac, 0x71, 0xc0, 0xb8, 0xf5, 0x7e, 0x95, 0xc4, 0x0d, 0x21,
+  0x31, 0x40, 0xc2, 0x81, 0xa1, 0xa7, 0x11, 0xab, 0x19, 0x98, 0x9d, 0x6b, 0x49, 0xe4, 0xf1, 0x31,
+  0xf4, 0x04, 0xa2, 0x79, 0xb3, 0x11, 0x63, 0xde, 0x2f, 0x9e, 0x01, 0x29, 0xc5, 0x4a, 0xaa, 0xee,
+  0x93, 0x2c, 0xfe, 0x1b, 0x88, 0xca, 0xfc, 0x74, 0x6e, 0x18, 0xcf, 0x27, 0x22, 0x7b, 0xff, 0x6d,
+  0x46, 0x05, 0x38, 0x98, 0x04, 0x39, 0xcd, 0xf9, 0xb7, 0xcd, 0xa8, 0xd1, 0xd1, 0x6b, 0x89, 0x91,
+  0x3d, 0x0e, 0x7a, 0x3f, 0xf2, 0x2e, 0xb0, 0x84, 0x60, 0xe4, 0xcb, 0x83, 0x29, 0x23, 0x61, 0x25,
+  0xa0, 0x4c, 0x43, 0xbc, 0x61, 0x9f, 0xa7, 0xd6, 0x31, 0xdd, 0xe3, 0x8a, 0x1f, 0xc3, 0x1c, 0xa1,
+  0x36, 0x16, 0xc2, 0x9e, 0xa2, 0x4c, 0xf3, 0x09, 0x7b, 0x9f, 0xca, 0xef, 0x74, 0xaf, 0x90, 0x5f,
+  0x1c, 0x3e, 0x22, 0xae, 0xe6, 0x5b, 0x0d, 0xb4, 0x76, 0x20, 0x58, 0xd9, 0x4a, 0xd1, 0x8b, 0x32,
+  0x6e, 0xc4, 0xdb, 0x62, 0xa9, 0xf9, 0xa4, 0xc8, 0x9a, 0x2e, 0x03, 0xbc, 0x73, 0x3f, 0x87, 0x12,
+  0x20, 0x38, 0x7d, 0xa1, 0xc7, 0x28, 0x49, 0xb4, 0xef, 0xa0, 0x66, 0x4c, 0xc5, 0x26, 0x16, 0xc4,
+  0xc1, 0x4c, 0x50, 0x92, 0x40, 0xac, 0xa9, 0x41, 0xf9, 0x36, 0x93, 0x43, 0x28, 0x4c, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 0xbd, 0x9a, 0xfa, 0x77, 0x59, 0x03, 0x32,
+  0x4d, 0xbd, 0x60, 0x28, 0xf4, 0xe7, 0x8f, 0x78, 0x4b, 0x35, 0xd2, 0x42, 0x50, 0xac, 0x12, 0x7d,
+  0x3f, 0xba, 0xbf, 0x60, 0xcf, 0x86, 0x0f, 0x47, 0x87, 0x41, 0x39, 0xda, 0x24, 0xeb, 0xd1, 0x17,
+  0x03, 0x5a, 0x31, 0x98, 0x8e, 0xce, 0xf6, 0xcb, 0xcb,
+};
+
+#undef Pkcs7Verify
+
+BOOLEAN
+EFIAPI
+Pkcs7Verify (
+  IN  CONST UINT8  *P7Data,
+  IN  UINTN        P7Length,
+  IN  CONST UINT8  *TrustedCert,
+  IN  UINTN        CertLength,
+  IN  CONST UINT8  *InData,
+  IN  UINTN        DataLength
+  );
+
+/**
+  Count the signature verifications of AuthService.c, see Pkcs7Verify().
+
+  @param[in]  P7Data       The PKCS#7 signed data.
+  @param[in]  P7Length     The size of P7Data.
+  @param[in]  TrustedCert  The trusted certificate.
+  @param[in]  CertLength   The size of TrustedCert.
+  @param[in]  InData       The signed content.
+  @param[in]  DataLength   The size of InData.
+
+  @return  The result of Pkcs7Verify().
+**/
+BOOLEAN
+EFIAPI
+TestPkcs7Verify (
+  IN  CONST UINT8  *P7Data,
+  IN  UINTN        P7Length,
+  IN  CONST UINT8  *TrustedCert,
+  IN  UINTN        CertLength,
+  IN  CONST UINT8  *InData,
+  IN  UINTN        DataLength
+  )
+{
+  mTestPkcs7VerifyCount++;
+  return Pkcs7Verify (P7Data, P7Length, TrustedCert, CertLength, InData, DataLength);
+}
+
+/**
+  The platform is never operated by a physically present user in the tests.
+
+  @retval FALSE  The platform is not operated by a physically present user.
+**/
+BOOLEAN
+EFIAPI
+UserPhysicalPresent (
+  VOID
+  )
+{
+  return FALSE;
+}
+
+/**
+  The variable policy engine is always enabled in the tests.
+
+  @retval TRUE  The variable policy engine is enabled.
+**/
+BOOLEAN
+EFIAPI
+IsVariablePolicyEnabled (
+  VOID
+  )
+{
+  return TRUE;
+}
+
+/**
+  Find a variable of the test store.
+
+  @param[in]  VariableName  The name of the variable.
+  @param[in]  VendorGuid    The GUID of the variable.
+
+  @return  The variable, or NULL when it does not exist.
+**/
+TEST_VARIABLE *
+FindTestVariable (
+  IN CHAR16    *VariableName,
+  IN EFI_GUID  *VendorGuid
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < TEST_VARIABLE_COUNT; Index++) {
+    if (mTestVariables[Index].InUse &&
+        (StrCmp (mTestVariables[Index].Name, VariableName) == 0) &&
+        CompareGuid (&mTestVariables[Index].Guid, VendorGuid))
+    {
+      return &mTestVariables[Index];
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Describe a variable of the test store.
+
+  @param[in]  Variable          The variable.
+  @param[out] AuthVariableInfo  The description of the variable.
+**/
+VOID
+GetTestVariableInfo (
+  IN  TEST_VARIABLE       *Variable,
+  OUT AUTH_VARIABLE_INFO  *AuthVariableInfo
+  )
+{
+  AuthVariableInfo->VariableName = Variable->Name;
+  AuthVariableInfo->VendorGuid   = &Variable->Guid;
+  AuthVariableInfo->Attributes   = Variable->Attributes;
+  AuthVariableInfo->DataSize     = Variable->DataSize;
+  AuthVariableInfo->Data         = Variable->Data;
+  AuthVariableInfo->TimeStamp    = &Variable->TimeStamp;
+}
+
+/**
+  Delete a variable of the test store.
+
+  @param[in]  Variable  The variable.
+**/
+VOID
+DeleteTestVariable (
+  IN TEST_VARIABLE  *Variable
+  )
+{
+  if (Variable->Data != NULL) {
+    FreePool (Variable->Data);
+  }
+
+  ZeroMem (Variable, sizeof (*Variable));
+}
+
+/**
+  Set a variable of the test store, bypassing AuthVariableLib.
+
+  @param[in]  VariableName  The name of the variable.
+  @param[in]  VendorGuid    The GUID of the variable.
+  @param[in]  Attributes    The attributes of the variable.
+  @param[in]  Data          The new content, appended with EFI_VARIABLE_APPEND_WRITE.
+  @param[in]  DataSize      The size of Data, 0 deletes the variable.
+  @param[in]  TimeStamp     The time stamp of the variable, or NULL.
+
+  @retval EFI_SUCCESS           The variable is updated.
+  @retval EFI_OUT_OF_RESOURCES  The store is full.
+**/
+EFI_STATUS
+SetTestVariable (
+  IN CHAR16    *VariableName,
+  IN EFI_GUID  *VendorGuid,
+  IN UINT32    Attributes,
+  IN VOID      *Data,
+  IN UINTN     DataSize,
+  IN EFI_TIME  *TimeStamp OPTIONAL
+  )
+{
+  TEST_VARIABLE  *Variable;
+  UINT8          *NewData;
+  UINTN          OldSize;
+  UINTN          Index;
+
+  Variable = FindTestVariable (VariableName, VendorGuid);
+  if ((DataSize == 0) && ((Attributes & EFI_VARIABLE_APPEND_WRITE) == 0)) {
+    if (Variable != NULL) {
+      DeleteTestVariable (Variable);
+    }
+
+    return EFI_SUCCESS;
+  }
+
+  if (Variable == NULL) {
+    for (Index = 0; Index < TEST_VARIABLE_COUNT; Index++) {
+      if (!mTestVariables[Index].InUse) {
+        Variable = &mTestVariables[Index];
+        break;
+      }
+    }
+
+    if ((Variable == NULL) || (StrSize (VariableName) > sizeof (Variable->Name))) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    Variable->InUse = TRUE;
+    StrCpyS (Variable->Name, TEST_VARIABLE_NAME_SIZE, VariableName);
+    CopyGuid (&Variable->Guid, VendorGuid);
+  }
+
+  OldSize = 0;
+  if ((Attributes & EFI_VARIABLE_APPEND_WRITE) != 0) {
+    OldSize = Variable->DataSize;
+  }
+
+  NewData = AllocatePool (OldSize + DataSize);
+  if (NewData == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  CopyMem (NewData, Variable->Data, OldSize);
+  CopyMem (NewData + OldSize, Data, DataSize);
+  if (Variable->Data != NULL) {
+    FreePool (Variable->Data);
+  }
+
+  Variable->Data       = NewData;
+  Variable->DataSize   = OldSize + DataSize;
+  Variable->Attributes = Attributes & ~EFI_VARIABLE_APPEND_WRITE;
+  if (TimeStamp != NULL) {
+    CopyMem (&Variable->TimeStamp, TimeStamp, sizeof (EFI_TIME));
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Find a variable of the test store, see AUTH_VAR_LIB_FIND_VARIABLE.
+**/
+EFI_STATUS
+EFIAPI
+TestFindVariable (
+  IN  CHAR16              *VariableName,
+  IN  EFI_GUID            *VendorGuid,
+  OUT AUTH_VARIABLE_INFO  *AuthVariableInfo
+  )
+{
+  TEST_VARIABLE  *Variable;
+
+  Variable = FindTestVariable (VariableName, VendorGuid);
+  if (Variable == NULL) {
+    return EFI_NOT_FOUND;
+  }
+
+  GetTestVariableInfo (Variable, AuthVariableInfo);
+  return EFI_SUCCESS;
+}
+
+/**
+  Find the next variable of the test store, see AUTH_VAR_LIB_FIND_NEXT_VARIABLE.
+**/
+EFI_STATUS
+EFIAPI
+TestFindNextVariable (
+  IN  CHAR16              *VariableName,
+  IN  EFI_GUID            *VendorGuid,
+  OUT AUTH_VARIABLE_INFO  *AuthVariableInfo
+  )
+{
+  TEST_VARIABLE  *Variable;
+  UINTN          Index;
+
+  Index = 0;
+  if (VariableName[0] != L'\0') {
+    Variable = FindTestVariable (VariableName, VendorGuid);
+    if (Variable == NULL) {
+      return EFI_NOT_FOUND;
+    }
+
+    Index = (UINTN)(Variable - mTestVariables) + 1;
+  }
+
+  for ( ; Index < TEST_VARIABLE_COUNT; Index++) {
+    if (mTestVariables[Index].InUse) {
+      GetTestVariableInfo (&mTestVariables[Index], AuthVariableInfo);
+      return EFI_SUCCESS;
+    }
+  }
+
+  return EFI_NOT_FOUND;
+}
+
+/**
+  Update a variable of the test store, see AUTH_VAR_LIB_UPDATE_VARIABLE.
+**/
+EFI_STATUS
+EFIAPI
+TestUpdateVariable (
+  IN AUTH_VARIABLE_INFO  *AuthVariableInfo
+  )
+{
+  return SetTestVariable (
+           AuthVariableInfo->VariableName,
+           AuthVariableInfo->VendorGuid,
+           AuthVariableInfo->Attributes,
+           AuthVariableInfo->Data,
+           AuthVariableInfo->DataSize,
+           AuthVariableInfo->TimeStamp
+           );
+}
+
+/**
+  Get the scratch buffer of the test store, see AUTH_VAR_LIB_GET_SCRATCH_BUFFER.
+**/
+EFI_STATUS
+EFIAPI
+TestGetScratchBuffer (
+  IN OUT UINTN  *ScratchBufferSize,
+  OUT    VOID   **ScratchBuffer
+  )
+{
+  if (*ScratchBufferSize > sizeof (mTestScratchBuffer)) {
+    *ScratchBufferSize = sizeof (mTestScratchBuffer);
+    return EFI_UNSUPPORTED;
+  }
+
+  *ScratchBuffer = mTestScratchBuffer;
+  return EFI_SUCCESS;
+}
+
+/**
+  The test store never runs out of space, see AUTH_VAR_LIB_CHECK_REMAINING_SPACE.
+**/
+BOOLEAN
+EFIAPI
+TestCheckRemainingSpaceForConsistency (
+  IN UINT32  Attributes,
+  ...
+  )
+{
+  return TRUE;
+}
+
+/**
+  The tests run at boot time, see AUTH_VAR_LIB_AT_RUNTIME.
+**/
+BOOLEAN
+EFIAPI
+TestAtRuntime (
+  VOID
+  )
+{
+  return FALSE;
+}
+
+AUTH_VAR_LIB_CONTEXT_IN  mTestAuthVarLibContextIn = {
+  AUTH_VAR_LIB_CONTEXT_IN_STRUCT_VERSION,
+  sizeof (AUTH_VAR_LIB_CONTEXT_IN),
+  TEST_MAX_VARIABLE_SIZE,
+  TestFindVariable,
+  TestFindNextVariable,
+  TestUpdateVariable,
+  TestGetScratchBuffer,
+  TestCheckRemainingSpaceForConsistency,
+  TestAtRuntime
+};
+
+/**
+  Set KEK in the test store to a list of X.509 certificates, bypassing
+  AuthVariableLib.
+
+  @param[in]  WithCa  Whether the list holds the CA that issued the dbx signer.
+
+  @retval EFI_SUCCESS           KEK is updated.
+  @retval EFI_OUT_OF_RESOURCES  There is not enough memory.
+**/
+EFI_STATUS
+SetTestKek (
+  IN BOOLEAN  WithCa
+  )
+{
+  UINT8               *Certs[2];
+  UINTN               CertSizes[2];
+  UINTN               CertCount;
+  UINT8               *Kek;
+  UINTN               KekSize;
+  UINTN               Index;
+  EFI_SIGNATURE_LIST  *CertList;
+  EFI_STATUS          Status;
+
+  Certs[0]     = mTestOtherCert;
+  CertSizes[0] = sizeof (mTestOtherCert);
+  Certs[1]     = mTestKekCaCert;
+  CertSizes[1] = sizeof (mTestKekCaCert);
+  CertCount    = WithCa ? 2 : 1;
+
+  KekSize = 0;
+  for (Index = 0; Index < CertCount; Index++) {
+    KekSize += sizeof (EFI_SIGNATURE_LIST) + sizeof (EFI_GUID) + CertSizes[Index];
+  }
+
+  Kek = AllocateZeroPool (KekSize);
+  if (Kek == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  CertList = (EFI_SIGNATURE_LIST *)Kek;
+  for (Index = 0; Index < CertCount; Index++) {
+    CopyGuid (&CertList->SignatureType, &gEfiCertX509Guid);
+    CertList->SignatureSize     = (UINT32)(sizeof (EFI_GUID) + CertSizes[Index]);
+    CertList->SignatureListSize = (UINT32)sizeof (EFI_SIGNATURE_LIST) + CertList->SignatureSize;
+    CopyMem (
+      (UINT8 *)(CertList + 1) + sizeof (EFI_GUID),
+      Certs[Index],
+      CertSizes[Index]
+      );
+    CertList = (EFI_SIGNATURE_LIST *)((UINT8 *)CertList + CertList->SignatureListSize);
+  }
+
+  Status = SetTestVariable (
+             EFI_KEY_EXCHANGE_KEY_NAME,
+             &gEfiGlobalVariableGuid,
+             TEST_KEK_ATTRIBUTES,
+             Kek,
+             KekSize,
+             NULL
+             );
+  FreePool (Kek);
+  return Status;
+}
+
+/**
+  Restore the CA in KEK, delete db and dbx and forget the cached signers after every
+  test, which leaves the state InitializeTestAuthVariableLib() started with.
+
+  @param[in] Context  The unit test context.
+**/
+VOID
+EFIAPI
+ResetTestVariables (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  SetTestVariable (EFI_IMAGE_SECURITY_DATABASE, &gEfiImageSecurityDatabaseGuid, 0, NULL, 0, NULL);
+  SetTestVariable (EFI_IMAGE_SECURITY_DATABASE1, &gEfiImageSecurityDatabaseGuid, 0, NULL, 0, NULL);
+  SetTestKek (TRUE);
+  FlushKekSignerCache ();
+}
+
+/**
+  Append to dbx through AuthVariableLib.
+
+  @param[in]  Data      The EFI_VARIABLE_AUTHENTICATION_2 and the payload.
+  @param[in]  DataSize  The size of Data.
+
+  @return  The status of AuthVariableLibProcessVariable().
+**/
+EFI_STATUS
+AppendDbx (
+  IN VOID   *Data,
+  IN UINTN  DataSize
+  )
+{
+  return AuthVariableLibProcessVariable (
+           EFI_IMAGE_SECURITY_DATABASE1,
+           &gEfiImageSecurityDatabaseGuid,
+           Data,
+           DataSize,
+           TEST_DBX_ATTRIBUTES
+           );
+}
+
+/**
+  Append to db through AuthVariableLib.
+
+  @param[in]  Data      The EFI_VARIABLE_AUTHENTICATION_2 and the payload.
+  @param[in]  DataSize  The size of Data.
+
+  @return  The status of AuthVariableLibProcessVariable().
+**/
+EFI_STATUS
+AppendDb (
+  IN VOID   *Data,
+  IN UINTN  DataSize
+  )
+{
+  return AuthVariableLibProcessVariable (
+           EFI_IMAGE_SECURITY_DATABASE,
+           &gEfiImageSecurityDatabaseGuid,
+           Data,
+           DataSize,
+           TEST_DBX_ATTRIBUTES
+           );
+}
+
+/**
+  Check that a signer that chained up to KEK is remembered.
+
+  @param[in] Context  The unit test context.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestSignerIsCached (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+
+  UT_ASSERT_EQUAL (mKekSignerCacheCount, 0);
+
+  Status = AppendDbx (mTestDbxUpdate1, sizeof (mTestDbxUpdate1));
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_EQUAL (mKekSignerCacheCount, 1);
+
+  //
+  // The signer is only remembered once.
+  //
+  Status = AppendDbx (mTestDbxUpdate2, sizeof (mTestDbxUpdate2));
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_EQUAL (mKekSignerCacheCount, 1);
+
+  UT_ASSERT_NOT_NULL (FindTestVariable (EFI_IMAGE_SECURITY_DATABASE1, &gEfiImageSecurityDatabaseGuid));
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Check that a cached signer does not walk KEK again. The CA is removed from
+  KEK behind the back of AuthVariableLib, so only the cache can accept the
+  second update.
+
+  @param[in] Context  The unit test context.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestCachedSignerSkipsKek (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+
+  Status = AppendDbx (mTestDbxUpdate1, sizeof (mTestDbxUpdate1));
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  Status = SetTestKek (FALSE);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  Status = AppendDbx (mTestDbxUpdate2, sizeof (mTestDbxUpdate2));
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Check that the signature is still verified for a cached signer.
+
+  @param[in] Context  The unit test context.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestCachedSignerChecksSignature (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+  UINT8       *Update;
+
+  Status = AppendDbx (mTestDbxUpdate1, sizeof (mTestDbxUpdate1));
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  //
+  // Change the last byte of the revoked digest.
+  //
+  Update = AllocateCopyPool (sizeof (mTestDbxUpdate2), mTestDbxUpdate2);
+  UT_ASSERT_NOT_NULL (Update);
+  Update[sizeof (mTestDbxUpdate2) - 1] ^= 0xFF;
+
+  Status = AppendDbx (Update, sizeof (mTestDbxUpdate2));
+  FreePool (Update);
+  UT_ASSERT_STATUS_EQUAL (Status, EFI_SECURITY_VIOLATION);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Check that writing KEK forgets the cached signers, even when the write fails.
+
+  @param[in] Context  The unit test context.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestKekWriteFlushesCache (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+
+  Status = AppendDbx (mTestDbxUpdate1, sizeof (mTestDbxUpdate1));
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  Status = SetTestKek (FALSE);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  //
+  // The update is not signed by PK, so KEK does not change.
+  //
+  Status = AuthVariableLibProcessVariable (
+             EFI_KEY_EXCHANGE_KEY_NAME,
+             &gEfiGlobalVariableGuid,
+             mTestDbxUpdate2,
+             sizeof (mTestDbxUpdate2),
+             TEST_KEK_ATTRIBUTES
+             );
+  UT_ASSERT_TRUE (EFI_ERROR (Status));
+  UT_ASSERT_EQUAL (mKekSignerCacheCount, 0);
+
+  Status = AppendDbx (mTestDbxUpdate2, sizeof (mTestDbxUpdate2));
+  UT_ASSERT_STATUS_EQUAL (Status, EFI_SECURITY_VIOLATION);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Count the signature verifications of repeated db writes from one signer,
+  before and after PK and KEK writes. KEK holds an unrelated certificate
+  before the CA, so walking KEK takes two verifications, and a remembered
+  signer takes one.
+
+  @param[in] Context  The unit test context.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestCachedSignerVerifyCount (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  CHAR16      *KeyNames[2];
+  UINTN       Round;
+  UINTN       Index;
+  UINTN       WriteCount;
+  UINTN       TotalCount;
+  EFI_STATUS  Status;
+
+  KeyNames[0] = EFI_KEY_EXCHANGE_KEY_NAME;
+  KeyNames[1] = EFI_PLATFORM_KEY_NAME;
+  WriteCount  = 0;
+  TotalCount  = 0;
+
+  for (Round = 0; Round <= ARRAY_SIZE (KeyNames); Round++) {
+    if (Round > 0) {
+      //
+      // The update is not signed by PK, so the key does not change.
+      //
+      Status = AuthVariableLibProcessVariable (
+                 KeyNames[Round - 1],
+                 &gEfiGlobalVariableGuid,
+                 mTestDbUpdate2,
+                 sizeof (mTestDbUpdate2),
+                 TEST_KEK_ATTRIBUTES
+                 );
+      UT_ASSERT_TRUE (EFI_ERROR (Status));
+    }
+
+    mTestPkcs7VerifyCount = 0;
+    Status                = AppendDb (mTestDbUpdate1, sizeof (mTestDbUpdate1));
+    UT_ASSERT_NOT_EFI_ERROR (Status);
+    UT_ASSERT_EQUAL (mTestPkcs7VerifyCount, 2);
+    WriteCount++;
+    TotalCount += mTestPkcs7VerifyCount;
+
+    for (Index = 0; Index < TEST_REPEATED_WRITE_COUNT; Index++) {
+      mTestPkcs7VerifyCount = 0;
+      Status                = AppendDb (mTestDbUpdate2, sizeof (mTestDbUpdate2));
+      UT_ASSERT_NOT_EFI_ERROR (Status);
+      UT_ASSERT_EQUAL (mTestPkcs7VerifyCount, 1);
+      WriteCount++;
+      TotalCount += mTestPkcs7VerifyCount;
+    }
+  }
+
+  UT_LOG_INFO ("%d db writes took %d signature verifications, %d without the cache\n", WriteCount, TotalCount, WriteCount * 2);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize AuthVariableLib in user mode, with an unrelated certificate as PK.
+
+  @retval EFI_SUCCESS  AuthVariableLib is initialized.
+  @retval Others       AuthVariableLib could not be initialized.
+**/
+EFI_STATUS
+InitializeTestAuthVariableLib (
+  VOID
+  )
+{
+  EFI_STATUS                Status;
+  UINT8                     *Pk;
+  UINTN                     PkSize;
+  EFI_SIGNATURE_LIST        *CertList;
+  AUTH_VAR_LIB_CONTEXT_OUT  AuthVarLibContextOut;
+
+  PkSize = sizeof (EFI_SIGNATURE_LIST) + sizeof (EFI_GUID) + sizeof (mTestOtherCert);
+  Pk     = AllocateZeroPool (PkSize);
+  if (Pk == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  CertList = (EFI_SIGNATURE_LIST *)Pk;
+  CopyGuid (&CertList->SignatureType, &gEfiCertX509Guid);
+  CertList->SignatureListSize = (UINT32)PkSize;
+  CertList->SignatureSize     = (UINT32)(sizeof (EFI_GUID) + sizeof (mTestOtherCert));
+  CopyMem ((UINT8 *)(CertList + 1) + sizeof (EFI_GUID), mTestOtherCert, sizeof (mTestOtherCert));
+
+  Status = SetTestVariable (
+             EFI_PLATFORM_KEY_NAME,
+             &gEfiGlobalVariableGuid,
+             TEST_KEK_ATTRIBUTES,
+             Pk,
+             PkSize,
+             NULL
+             );
+  FreePool (Pk);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = SetTestKek (TRUE);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  return AuthVariableLibInitialize (&mTestAuthVarLibContextIn, &AuthVarLibContextOut);
+}
+
+/**
+  Unit test entry point.
+
+  @retval EFI_SUCCESS  The tests ran.
+  @retval Others       The test framework could not be initialized.
+**/
+EFI_STATUS
+EFIAPI
+UefiTestMain (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      KekSignerCacheTestSuite;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_NAME, UNIT_TEST_VERSION));
+
+  Status = InitializeTestAuthVariableLib ();
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed to initialize AuthVariableLib. Status = %r\n", UNIT_TEST_NAME, Status));
+    goto EXIT;
+  }
+
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_NAME, gEfiCallerBaseName, UNIT_TEST_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed in InitUnitTestFramework. Status = %r\n", UNIT_TEST_NAME, Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&KekSignerCacheTestSuite, Framework, "KekSignerCacheTestSuite", "SecurityPkg.AuthVariableLib.KekSignerCache", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed in CreateUnitTestSuite for KekSignerCacheTestSuite\n", UNIT_TEST_NAME));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  AddTestCase (KekSignerCacheTestSuite, "Signers that chain up to KEK are remembered", "SignerIsCached", TestSignerIsCached, NULL, ResetTestVariables, NULL);
+  AddTestCase (KekSignerCacheTestSuite, "Remembered signers do not walk KEK", "CachedSignerSkipsKek", TestCachedSignerSkipsKek, NULL, ResetTestVariables, NULL);
+  AddTestCase (KekSignerCacheTestSuite, "Remembered signers still have their signature checked", "CachedSignerChecksSignature", TestCachedSignerChecksSignature, NULL, ResetTestVariables, NULL);
+  AddTestCase (KekSignerCacheTestSuite, "Writing KEK forgets the signers", "KekWriteFlushesCache", TestKekWriteFlushesCache, NULL, ResetTestVariables, NULL);
+  AddTestCase (KekSignerCacheTestSuite, "Remembered signers take one signature verification", "CachedSignerVerifyCount", TestCachedSignerVerifyCount, NULL, ResetTestVariables, NULL);
+
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework != NULL) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+**/
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  return UefiTestMain ();
+}
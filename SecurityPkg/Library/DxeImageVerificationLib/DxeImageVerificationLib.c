@@ -9,7 +9,7 @@
   DxeImageVerificationLibImageRead() function will make sure the PE/COFF image content
   read is within the image buffer.
 
-  DxeImageVerificationHandler(), HashPeImageByType(), HashPeImage() function will accept
+  DxeImageVerificationHandler(), HashPeImageByType(), HashPeImage(), HashPeImages() function will accept
   untrusted PE/COFF image and validate its data structure within this image buffer before use.
 
 Copyright (c) 2009 - 2018, Intel Corporation. All rights reserved.<BR>
@@ -43,15 +43,6 @@ UINT8  mHashOidValue[] = {
   0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x03, // OBJ_sha512
 };
 
-//
-//  Support hash types
-//
-#define HASHALG_SHA256  0x00000000
-#define HASHALG_SHA384  0x00000001
-#define HASHALG_SHA512  0x00000002
-#define HASHALG_SHA1    0x00000003
-#define HASHALG_MAX     0x00000004
-
 HASH_TABLE mHash[] = {
   { L"SHA256", 32, &mHashOidValue[14], 9, &gEfiCertSha256Guid, Sha256GetContextSize, Sha256Init, Sha256Update, Sha256Final },
   { L"SHA384", 48, &mHashOidValue[23], 9, &gEfiCertSha384Guid, Sha384GetContextSize, Sha384Init, Sha384Update, Sha384Final },
@@ -61,6 +52,15 @@ HASH_TABLE mHash[] = {
 #endif
 };
 
+//
+// Types of the certificate hashes in dbx, with the algorithm of their digest
+//
+CERT_HASH_TYPE mCertHashTypes[] = {
+  { &gEfiCertX509Sha256Guid, HASHALG_SHA256 },
+  { &gEfiCertX509Sha384Guid, HASHALG_SHA384 },
+  { &gEfiCertX509Sha512Guid, HASHALG_SHA512 }
+};
+
 /**
   SecureBoot Hook for processing image verification.
 
@@ -283,33 +283,211 @@ Done:
   return Status;
 }
 
+//
+// Contexts of the algorithms HashPeImages() hashes an image with, NULL for
+// the algorithms it does not use.
+//
+typedef struct {
+  VOID    *Context[HASHALG_MAX];
+} MULTI_HASH_CONTEXT;
+
 /**
-  Recognize the Hash algorithm in PE/COFF Authenticode and calculate hash of
-  Pe/Coff image based on the authenticode image hashing in PE/COFF Specification
-  8.0 Appendix A
+  Hash data with every algorithm of a MULTI_HASH_CONTEXT.
 
-  Caution: This function may receive untrusted input.
-  PE/COFF image is external input, so this function will validate its data structure
-  within this image buffer before use.
+  The data is passed to the algorithms in blocks of IMAGE_HASH_BLOCK_SIZE
+  bytes, every algorithm hashes a block before the next block is read. The
+  data is therefore read from memory once, not once per algorithm.
 
-  @param[in]  AuthData            Pointer to the Authenticode Signature retrieved from signed image.
-  @param[in]  AuthDataSize        Size of the Authenticode Signature in bytes.
+  @param[in, out]  HashContext  The MULTI_HASH_CONTEXT.
+  @param[in]       Data         The data to hash.
+  @param[in]       DataLength   The size of the data, in bytes.
 
-  @retval EFI_UNSUPPORTED             Hash algorithm is not supported.
-  @retval EFI_SUCCESS                 Hash successfully.
+  An algorithm that fails to hash a block is dropped from the context, the
+  others go on.
 
+  @retval TRUE   An algorithm is left to hash the data.
+  @retval FALSE  Every algorithm failed to hash the data.
 **/
-EFI_STATUS
-HashPeImageByType (
+STATIC
+BOOLEAN
+EFIAPI
+MultiHashUpdate (
+  IN OUT VOID        *HashContext,
+  IN     CONST VOID  *Data,
+  IN     UINTN       DataLength
+  )
+{
+  MULTI_HASH_CONTEXT  *MultiContext;
+  CONST UINT8         *Block;
+  UINTN               BlockSize;
+  UINTN               Index;
+  BOOLEAN             Active;
+
+  MultiContext = (MULTI_HASH_CONTEXT *)HashContext;
+  Block        = (CONST UINT8 *)Data;
+
+  while (DataLength > 0) {
+    BlockSize = MIN (DataLength, IMAGE_HASH_BLOCK_SIZE);
+    Active    = FALSE;
+    for (Index = 0; Index < ARRAY_SIZE (mHash); Index++) {
+      if (MultiContext->Context[Index] == NULL) {
+        continue;
+      }
+
+      if (!mHash[Index].HashUpdate (MultiContext->Context[Index], Block, BlockSize)) {
+        FreePool (MultiContext->Context[Index]);
+        MultiContext->Context[Index] = NULL;
+        continue;
+      }
+
+      Active = TRUE;
+    }
+
+    if (!Active) {
+      return FALSE;
+    }
+
+    Block      += BlockSize;
+    DataLength -= BlockSize;
+  }
+
+  return TRUE;
+}
+
+/**
+  Calculate the Authenticode digests of an image with several hash algorithms
+  in one pass over the image.
+
+  The signatures of an image may use different algorithms and the digest of
+  an unsigned image is looked up with every algorithm. Hashing the image once
+  for all of them avoids reading it once per algorithm.
+
+  Notes: PE/COFF image has been checked by UefiImageLibLib UefiImageInitializeContext() in
+  its caller function DxeImageVerificationHandler().
+
+  @param[in]  ImageContext  The context of the image.
+  @param[in]  HashMask      Bit N requests the digest computed with mHash[N].
+  @param[out] Digests       The digests. Digests->ValidMask tells which ones
+                            were computed, an algorithm that fails does not
+                            drop the digests of the others.
+
+  @retval TRUE            Every requested digest is computed.
+  @retval FALSE           A requested digest could not be computed.
+**/
+BOOLEAN
+HashPeImages (
   IN  UEFI_IMAGE_LOADER_IMAGE_CONTEXT  *ImageContext,
-  IN  CONST UINT8                      *AuthData,
-  IN  UINTN                            AuthDataSize,
+  IN  UINT32                           HashMask,
+  OUT IMAGE_DIGESTS                    *Digests
+  )
+{
+  MULTI_HASH_CONTEXT  MultiContext;
+  BOOLEAN             Status;
+  UINTN               Index;
+  UINT32              RequestedMask;
+
+  ZeroMem (&MultiContext, sizeof (MultiContext));
+  Digests->ValidMask = 0;
+  RequestedMask      = 0;
+
+  for (Index = 0; Index < ARRAY_SIZE (mHash); Index++) {
+    if ((HashMask & (1U << Index)) == 0) {
+      continue;
+    }
+
+    if ((mHash[Index].GetContextSize == NULL) || (mHash[Index].HashInit == NULL) || (mHash[Index].HashUpdate == NULL) || (mHash[Index].HashFinal == NULL)) {
+      continue;
+    }
+
+    RequestedMask              |= 1U << Index;
+    MultiContext.Context[Index] = AllocatePool (mHash[Index].GetContextSize ());
+    if ((MultiContext.Context[Index] != NULL) && !mHash[Index].HashInit (MultiContext.Context[Index])) {
+      FreePool (MultiContext.Context[Index]);
+      MultiContext.Context[Index] = NULL;
+    }
+  }
+
+  //
+  // A failure to read the image leaves no valid digest, a failure of an
+  // algorithm only drops its context, see MultiHashUpdate().
+  //
+  Status = UefiImageHashImageDefault (ImageContext, &MultiContext, MultiHashUpdate);
+
+  for (Index = 0; Index < ARRAY_SIZE (mHash); Index++) {
+    if (MultiContext.Context[Index] == NULL) {
+      continue;
+    }
+
+    if (Status) {
+      ASSERT (mHash[Index].DigestLength <= MAX_DIGEST_SIZE);
+      ZeroMem (Digests->Digest[Index], MAX_DIGEST_SIZE);
+      if (mHash[Index].HashFinal (MultiContext.Context[Index], Digests->Digest[Index])) {
+        Digests->ValidMask |= 1U << Index;
+      }
+    }
+
+    FreePool (MultiContext.Context[Index]);
+  }
+
+  if (Digests->ValidMask != RequestedMask) {
+    DEBUG ((DEBUG_INFO, "DxeImageVerificationLib: Failed to hash this image with every algorithm.\n"));
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+  Get the Authenticode digest of an image for one hash algorithm.
+
+  The digest is taken from Digests when HashPeImages() computed it, the image
+  is hashed otherwise.
+
+  @param[in]  ImageContext     The context of the image.
+  @param[in]  Digests          The digests computed by HashPeImages(), or NULL.
+  @param[in]  HashAlg          The index of the algorithm in mHash.
+  @param[out] ImageDigest      The digest.
+  @param[out] ImageDigestSize  The size of the digest, in bytes.
+
+  @retval TRUE            Successfully hash image.
+  @retval FALSE           Fail in hash image.
+**/
+BOOLEAN
+GetPeImageDigest (
+  IN  UEFI_IMAGE_LOADER_IMAGE_CONTEXT  *ImageContext,
+  IN  CONST IMAGE_DIGESTS              *Digests OPTIONAL,
+  IN  UINTN                            HashAlg,
   OUT UINT8                            ImageDigest[MAX_DIGEST_SIZE],
-  OUT UINTN                            *ImageDigestSize,
-  OUT CONST EFI_GUID                   **CertType
+  OUT UINTN                            *ImageDigestSize
   )
 {
-  UINT8  Index;
+  if ((Digests != NULL) && ((Digests->ValidMask & (1U << HashAlg)) != 0)) {
+    CopyMem (ImageDigest, Digests->Digest[HashAlg], MAX_DIGEST_SIZE);
+    *ImageDigestSize = mHash[HashAlg].DigestLength;
+    return TRUE;
+  }
+
+  return HashPeImage (ImageContext, &mHash[HashAlg], ImageDigest, ImageDigestSize);
+}
+
+/**
+  Recognize the hash algorithm of a PE/COFF Authenticode signature.
+
+  @param[in]  AuthData      Pointer to the Authenticode Signature retrieved from signed image.
+  @param[in]  AuthDataSize  Size of the Authenticode Signature in bytes.
+  @param[out] HashAlg       The index of the algorithm in mHash.
+
+  @retval EFI_UNSUPPORTED             Hash algorithm is not supported.
+  @retval EFI_SUCCESS                 The algorithm is recognized.
+**/
+EFI_STATUS
+GetAuthenticodeHashAlg (
+  IN  CONST UINT8  *AuthData,
+  IN  UINTN        AuthDataSize,
+  OUT UINTN        *HashAlg
+  )
+{
+  UINTN  Index;
 
   //
   // Check the Hash algorithm in PE/COFF Authenticode.
@@ -330,24 +508,58 @@ HashPeImageByType (
     return EFI_UNSUPPORTED;
   }
 
-  for (Index = 0; Index < HASHALG_MAX; Index++) {
+  for (Index = 0; Index < ARRAY_SIZE (mHash); Index++) {
     if (AuthDataSize < 32 + mHash[Index].OidLength) {
       continue;
     }
 
     if (CompareMem (AuthData + 32, mHash[Index].OidValue, mHash[Index].OidLength) == 0) {
-      break;
+      *HashAlg = Index;
+      return EFI_SUCCESS;
     }
   }
 
-  if (Index == HASHALG_MAX) {
+  return EFI_UNSUPPORTED;
+}
+
+/**
+  Recognize the Hash algorithm in PE/COFF Authenticode and calculate hash of
+  Pe/Coff image based on the authenticode image hashing in PE/COFF Specification
+  8.0 Appendix A
+
+  Caution: This function may receive untrusted input.
+  PE/COFF image is external input, so this function will validate its data structure
+  within this image buffer before use.
+
+  @param[in]  AuthData            Pointer to the Authenticode Signature retrieved from signed image.
+  @param[in]  AuthDataSize        Size of the Authenticode Signature in bytes.
+  @param[in]  Digests             The digests computed by HashPeImages(), or NULL.
+
+  @retval EFI_UNSUPPORTED             Hash algorithm is not supported.
+  @retval EFI_SUCCESS                 Hash successfully.
+
+**/
+EFI_STATUS
+HashPeImageByType (
+  IN  UEFI_IMAGE_LOADER_IMAGE_CONTEXT  *ImageContext,
+  IN  CONST UINT8                      *AuthData,
+  IN  UINTN                            AuthDataSize,
+  IN  CONST IMAGE_DIGESTS              *Digests OPTIONAL,
+  OUT UINT8                            ImageDigest[MAX_DIGEST_SIZE],
+  OUT UINTN                            *ImageDigestSize,
+  OUT CONST EFI_GUID                   **CertType
+  )
+{
+  UINTN  Index;
+
+  if (EFI_ERROR (GetAuthenticodeHashAlg (AuthData, AuthDataSize, &Index))) {
     return EFI_UNSUPPORTED;
   }
 
   //
   // HASH PE Image based on Hash algorithm in PE/COFF Authenticode.
   //
-  if (!HashPeImage (ImageContext, &mHash[Index], ImageDigest, ImageDigestSize)) {
+  if (!GetPeImageDigest (ImageContext, Digests, Index, ImageDigest, ImageDigestSize)) {
     return EFI_UNSUPPORTED;
   }
 
@@ -515,8 +727,7 @@ AddImageExeInfo (
 
   @param[in]  Certificate       Pointer to X.509 Certificate that is searched for.
   @param[in]  CertSize          Size of X.509 Certificate.
-  @param[in]  SignatureList     Pointer to the Signature List in forbidden database.
-  @param[in]  SignatureListSize Size of Signature List.
+  @param[in]  Dbx               The forbidden database.
   @param[out] RevocationTime    Return the time that the certificate was revoked.
   @param[out] IsFound           Search result. Only valid if EFI_SUCCESS returned.
 
@@ -526,36 +737,27 @@ AddImageExeInfo (
 **/
 EFI_STATUS
 IsCertHashFoundInDbx (
-  IN  UINT8               *Certificate,
-  IN  UINTN               CertSize,
-  IN  EFI_SIGNATURE_LIST  *SignatureList,
-  IN  UINTN               SignatureListSize,
-  OUT EFI_TIME            *RevocationTime,
-  OUT BOOLEAN             *IsFound
+  IN  UINT8                     *Certificate,
+  IN  UINTN                     CertSize,
+  IN  CONST SIGNATURE_DATABASE  *Dbx,
+  OUT EFI_TIME                  *RevocationTime,
+  OUT BOOLEAN                   *IsFound
   )
 {
-  EFI_STATUS          Status;
-  EFI_SIGNATURE_LIST  *DbxList;
-  UINTN               DbxSize;
-  EFI_SIGNATURE_DATA  *CertHash;
-  UINTN               CertHashCount;
-  UINTN               Index;
-  UINT32              HashAlg;
-  VOID                *HashCtx;
-  UINT8               CertDigest[MAX_DIGEST_SIZE];
-  UINT8               *DbxCertHash;
-  UINTN               SiglistHeaderSize;
-  UINT8               *TBSCert;
-  UINTN               TBSCertSize;
+  EFI_STATUS                   Status;
+  UINTN                        Index;
+  UINT32                       HashAlg;
+  VOID                         *HashCtx;
+  UINT8                        CertDigest[MAX_DIGEST_SIZE];
+  UINT8                        *TBSCert;
+  UINTN                        TBSCertSize;
+  CONST SIGNATURE_INDEX_ENTRY  *Entry;
 
   Status   = EFI_ABORTED;
   *IsFound = FALSE;
-  DbxList  = SignatureList;
-  DbxSize  = SignatureListSize;
   HashCtx  = NULL;
-  HashAlg  = HASHALG_MAX;
 
-  if ((RevocationTime == NULL) || (DbxList == NULL)) {
+  if ((RevocationTime == NULL) || (Dbx == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
 
@@ -566,21 +768,8 @@ IsCertHashFoundInDbx (
     return Status;
   }
 
-  while ((DbxSize > 0) && (SignatureListSize >= DbxList->SignatureListSize)) {
-    //
-    // Determine Hash Algorithm of Certificate in the forbidden database.
-    //
-    if (CompareGuid (&DbxList->SignatureType, &gEfiCertX509Sha256Guid)) {
-      HashAlg = HASHALG_SHA256;
-    } else if (CompareGuid (&DbxList->SignatureType, &gEfiCertX509Sha384Guid)) {
-      HashAlg = HASHALG_SHA384;
-    } else if (CompareGuid (&DbxList->SignatureType, &gEfiCertX509Sha512Guid)) {
-      HashAlg = HASHALG_SHA512;
-    } else {
-      DbxSize -= DbxList->SignatureListSize;
-      DbxList  = (EFI_SIGNATURE_LIST *)((UINT8 *)DbxList + DbxList->SignatureListSize);
-      continue;
-    }
+  for (Index = 0; Index < ARRAY_SIZE (mCertHashTypes); Index++) {
+    HashAlg = mCertHashTypes[Index].HashAlg;
 
     //
     // Calculate the hash value of current TBSCertificate for comparision.
@@ -595,48 +784,34 @@ IsCertHashFoundInDbx (
       goto Done;
     }
 
-    if (EFI_ERROR(mHash[HashAlg].HashInit (HashCtx))) {
-      goto Done;
-    }
-
-    if (EFI_ERROR(mHash[HashAlg].HashUpdate (HashCtx, TBSCert, TBSCertSize))) {
-      goto Done;
-    }
-
-    if (EFI_ERROR(mHash[HashAlg].HashFinal (HashCtx, CertDigest))) {
+    if (!mHash[HashAlg].HashInit (HashCtx) ||
+        !mHash[HashAlg].HashUpdate (HashCtx, TBSCert, TBSCertSize) ||
+        !mHash[HashAlg].HashFinal (HashCtx, CertDigest))
+    {
       goto Done;
     }
 
     FreePool (HashCtx);
     HashCtx = NULL;
 
-    SiglistHeaderSize = sizeof (EFI_SIGNATURE_LIST) + DbxList->SignatureHeaderSize;
-    CertHash          = (EFI_SIGNATURE_DATA *)((UINT8 *)DbxList + SiglistHeaderSize);
-    CertHashCount     = (DbxList->SignatureListSize - SiglistHeaderSize) / DbxList->SignatureSize;
-    for (Index = 0; Index < CertHashCount; Index++) {
+    if (FindSignatureDigest (Dbx, mCertHashTypes[Index].SignatureType, CertDigest, mHash[HashAlg].DigestLength, &Entry) == EFI_SUCCESS) {
       //
-      // Iterate each Signature Data Node within this CertList for verify.
+      // Hash of Certificate is found in forbidden database.
       //
-      DbxCertHash = CertHash->SignatureData;
-      if (CompareMem (DbxCertHash, CertDigest, mHash[HashAlg].DigestLength) == 0) {
-        //
-        // Hash of Certificate is found in forbidden database.
-        //
-        Status   = EFI_SUCCESS;
-        *IsFound = TRUE;
+      *IsFound = TRUE;
 
-        //
-        // Return the revocation time.
-        //
-        CopyMem (RevocationTime, (EFI_TIME *)(DbxCertHash + mHash[HashAlg].DigestLength), sizeof (EFI_TIME));
-        goto Done;
+      //
+      // Return the revocation time. An entry without one revokes the
+      // certificate at all times.
+      //
+      if (Entry->List->SignatureSize >= sizeof (EFI_GUID) + mHash[HashAlg].DigestLength + sizeof (EFI_TIME)) {
+        CopyMem (RevocationTime, Entry->Data->SignatureData + mHash[HashAlg].DigestLength, sizeof (EFI_TIME));
+      } else {
+        ZeroMem (RevocationTime, sizeof (EFI_TIME));
       }
 
-      CertHash = (EFI_SIGNATURE_DATA *)((UINT8 *)CertHash + DbxList->SignatureSize);
+      break;
     }
-
-    DbxSize -= DbxList->SignatureListSize;
-    DbxList  = (EFI_SIGNATURE_LIST *)((UINT8 *)DbxList + DbxList->SignatureListSize);
   }
 
   Status = EFI_SUCCESS;
@@ -652,7 +827,7 @@ Done:
 /**
   Check whether signature is in specified database.
 
-  @param[in]  VariableName        Name of database variable that is searched in.
+  @param[in]  Database            The database that is searched in.
   @param[in]  Signature           Pointer to signature that is searched for.
   @param[in]  CertType            Pointer to hash algorithm.
   @param[in]  SignatureSize       Size of Signature.
@@ -664,91 +839,52 @@ Done:
 **/
 EFI_STATUS
 IsSignatureFoundInDatabase (
-  IN  CHAR16          *VariableName,
-  IN  UINT8           *Signature,
-  IN  CONST EFI_GUID  *CertType,
-  IN  UINTN           SignatureSize,
-  OUT BOOLEAN         *IsFound
+  IN  CONST SIGNATURE_DATABASE  *Database,
+  IN  UINT8                     *Signature,
+  IN  CONST EFI_GUID            *CertType,
+  IN  UINTN                     SignatureSize,
+  OUT BOOLEAN                   *IsFound
   )
 {
-  EFI_STATUS          Status;
-  EFI_SIGNATURE_LIST  *CertList;
-  EFI_SIGNATURE_DATA  *Cert;
-  UINTN               DataSize;
-  UINT8               *Data;
-  UINTN               Index;
-  UINTN               CertCount;
+  EFI_STATUS                   Status;
+  CONST SIGNATURE_INDEX_ENTRY  *Entry;
 
-  //
-  // Read signature database variable.
-  //
   *IsFound = FALSE;
-  Data     = NULL;
-  DataSize = 0;
-  Status   = gRT->GetVariable (VariableName, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, NULL);
-  if (Status != EFI_BUFFER_TOO_SMALL) {
-    if (Status == EFI_NOT_FOUND) {
+  if (EFI_ERROR (Database->Status)) {
+    if (Database->Status == EFI_NOT_FOUND) {
       //
       // No database, no need to search.
       //
-      Status = EFI_SUCCESS;
+      return EFI_SUCCESS;
     }
 
-    return Status;
+    return Database->Status;
   }
 
-  Data = (UINT8 *)AllocateZeroPool (DataSize);
-  if (Data == NULL) {
-    return EFI_OUT_OF_RESOURCES;
+  //
+  // Look up the signature among the sorted signatures of its type.
+  //
+  Status = FindSignatureDigest (Database, CertType, Signature, SignatureSize, &Entry);
+  if (Status == EFI_NOT_FOUND) {
+    return EFI_SUCCESS;
   }
 
-  Status = gRT->GetVariable (VariableName, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, Data);
   if (EFI_ERROR (Status)) {
-    goto Done;
+    return Status;
   }
 
   //
-  // Enumerate all signature data in SigDB to check if signature exists for executable.
+  // Find the signature in database.
   //
-  CertList = (EFI_SIGNATURE_LIST *)Data;
-  while ((DataSize > 0) && (DataSize >= CertList->SignatureListSize)) {
-    CertCount = (CertList->SignatureListSize - sizeof (EFI_SIGNATURE_LIST) - CertList->SignatureHeaderSize) / CertList->SignatureSize;
-    Cert      = (EFI_SIGNATURE_DATA *)((UINT8 *)CertList + sizeof (EFI_SIGNATURE_LIST) + CertList->SignatureHeaderSize);
-    if ((CertList->SignatureSize == sizeof (EFI_SIGNATURE_DATA) - 1 + SignatureSize) && (CompareGuid (&CertList->SignatureType, CertType))) {
-      for (Index = 0; Index < CertCount; Index++) {
-        if (CompareMem (Cert->SignatureData, Signature, SignatureSize) == 0) {
-          //
-          // Find the signature in database.
-          //
-          *IsFound = TRUE;
-          //
-          // Entries in UEFI_IMAGE_SECURITY_DATABASE that are used to validate image should be measured
-          //
-          if (StrCmp (VariableName, EFI_IMAGE_SECURITY_DATABASE) == 0) {
-            SecureBootHook (VariableName, &gEfiImageSecurityDatabaseGuid, CertList->SignatureSize, Cert);
-          }
-
-          break;
-        }
-
-        Cert = (EFI_SIGNATURE_DATA *)((UINT8 *)Cert + CertList->SignatureSize);
-      }
-
-      if (*IsFound) {
-        break;
-      }
-    }
-
-    DataSize -= CertList->SignatureListSize;
-    CertList  = (EFI_SIGNATURE_LIST *)((UINT8 *)CertList + CertList->SignatureListSize);
-  }
-
-Done:
-  if (Data != NULL) {
-    FreePool (Data);
+  *IsFound = TRUE;
+  //
+  // Entries in UEFI_IMAGE_SECURITY_DATABASE that are used to validate image should be measured
+  //
+  if (StrCmp (Database->VariableName, EFI_IMAGE_SECURITY_DATABASE) == 0) {
+    SecureBootHook (Database->VariableName, &gEfiImageSecurityDatabaseGuid, Entry->List->SignatureSize, (VOID *)Entry->Data);
   }
 
-  return Status;
+  return EFI_SUCCESS;
 }
 
 /**
@@ -812,6 +948,7 @@ IsTimeZero (
   @param[in]  AuthData        Pointer to the Authenticode signature retrieved from signed image.
   @param[in]  AuthDataSize    Size of the Authenticode signature in bytes.
   @param[in]  RevocationTime  The time that the certificate was revoked.
+  @param[in]  Dbt             The timestamp database.
 
   @retval TRUE      Timestamp signature is valid and signing time is no later than the
                     revocation time.
@@ -821,28 +958,26 @@ IsTimeZero (
 **/
 BOOLEAN
 PassTimestampCheck (
-  IN CONST UINT8  *AuthData,
-  IN UINTN        AuthDataSize,
-  IN EFI_TIME     *RevocationTime
+  IN CONST UINT8               *AuthData,
+  IN UINTN                     AuthDataSize,
+  IN EFI_TIME                  *RevocationTime,
+  IN CONST SIGNATURE_DATABASE  *Dbt
   )
 {
-  EFI_STATUS          Status;
-  BOOLEAN             VerifyStatus;
-  EFI_SIGNATURE_LIST  *CertList;
-  EFI_SIGNATURE_DATA  *Cert;
-  UINT8               *DbtData;
-  UINTN               DbtDataSize;
-  UINT8               *RootCert;
-  UINTN               RootCertSize;
-  UINTN               Index;
-  UINTN               CertCount;
-  EFI_TIME            SigningTime;
+  BOOLEAN                   VerifyStatus;
+  EFI_SIGNATURE_LIST        *CertList;
+  EFI_SIGNATURE_DATA        *Cert;
+  UINTN                     DbtDataSize;
+  UINT8                     *RootCert;
+  UINTN                     RootCertSize;
+  UINTN                     Index;
+  UINTN                     CertCount;
+  EFI_TIME                  SigningTime;
 
   //
   // Variable Initialization
   //
   VerifyStatus = FALSE;
-  DbtData      = NULL;
   CertList     = NULL;
   Cert         = NULL;
   RootCert     = NULL;
@@ -859,23 +994,12 @@ PassTimestampCheck (
   // RevocationTime is non-zero, the certificate should be considered to be revoked from that time and onwards.
   // Using the dbt to get the trusted TSA certificates.
   //
-  DbtDataSize = 0;
-  Status      = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE2, &gEfiImageSecurityDatabaseGuid, NULL, &DbtDataSize, NULL);
-  if (Status != EFI_BUFFER_TOO_SMALL) {
+  if (EFI_ERROR (Dbt->Status)) {
     goto Done;
   }
 
-  DbtData = (UINT8 *)AllocateZeroPool (DbtDataSize);
-  if (DbtData == NULL) {
-    goto Done;
-  }
-
-  Status = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE2, &gEfiImageSecurityDatabaseGuid, NULL, &DbtDataSize, (VOID *)DbtData);
-  if (EFI_ERROR (Status)) {
-    goto Done;
-  }
-
-  CertList = (EFI_SIGNATURE_LIST *)DbtData;
+  CertList    = (EFI_SIGNATURE_LIST *)Dbt->Data;
+  DbtDataSize = Dbt->DataSize;
   while ((DbtDataSize > 0) && (DbtDataSize >= CertList->SignatureListSize)) {
     if (CompareGuid (&CertList->SignatureType, &gEfiCertX509Guid)) {
       Cert      = (EFI_SIGNATURE_DATA *)((UINT8 *)CertList + sizeof (EFI_SIGNATURE_LIST) + CertList->SignatureHeaderSize);
@@ -908,10 +1032,6 @@ PassTimestampCheck (
   }
 
 Done:
-  if (DbtData != NULL) {
-    FreePool (DbtData);
-  }
-
   return VerifyStatus;
 }
 
@@ -921,6 +1041,7 @@ Done:
 
   @param[in]  AuthData      Pointer to the Authenticode signature retrieved from the signed image.
   @param[in]  AuthDataSize  Size of the Authenticode signature in bytes.
+  @param[in]  Databases     The security databases of this image verification.
 
   @retval TRUE              Image is forbidden by dbx.
   @retval FALSE             Image is not forbidden by dbx.
@@ -928,39 +1049,38 @@ Done:
 **/
 BOOLEAN
 IsForbiddenByDbx (
-  IN CONST UINT8            *AuthData,
-  IN UINTN                  AuthDataSize,
+  IN CONST UINT8                *AuthData,
+  IN UINTN                      AuthDataSize,
   UINT8                         ImageDigest[MAX_DIGEST_SIZE],
-  UINTN                         ImageDigestSize
+  UINTN                         ImageDigestSize,
+  IN CONST SIGNATURE_DATABASES  *Databases
   )
 {
-  EFI_STATUS          Status;
-  BOOLEAN             IsForbidden;
-  BOOLEAN             IsFound;
-  UINT8               *Data;
-  UINTN               DataSize;
-  EFI_SIGNATURE_LIST  *CertList;
-  UINTN               CertListSize;
-  EFI_SIGNATURE_DATA  *CertData;
-  UINT8               *RootCert;
-  UINTN               RootCertSize;
-  UINTN               CertCount;
-  UINTN               Index;
-  UINT8               *CertBuffer;
-  UINTN               BufferLength;
-  UINT8               *TrustedCert;
-  UINTN               TrustedCertLength;
-  UINT8               CertNumber;
-  UINT8               *CertPtr;
-  UINT8               *Cert;
-  UINTN               CertSize;
-  EFI_TIME            RevocationTime;
+  EFI_STATUS                Status;
+  BOOLEAN                   IsForbidden;
+  BOOLEAN                   IsFound;
+  CONST SIGNATURE_DATABASE  *Dbx;
+  EFI_SIGNATURE_LIST        *CertList;
+  UINTN                     CertListSize;
+  EFI_SIGNATURE_DATA        *CertData;
+  UINT8                     *RootCert;
+  UINTN                     RootCertSize;
+  UINTN                     CertCount;
+  UINTN                     Index;
+  UINT8                     *CertBuffer;
+  UINTN                     BufferLength;
+  UINT8                     *TrustedCert;
+  UINTN                     TrustedCertLength;
+  UINT8                     CertNumber;
+  UINT8                     *CertPtr;
+  UINT8                     *Cert;
+  UINTN                     CertSize;
+  EFI_TIME                  RevocationTime;
 
   //
   // Variable Initialization
   //
   IsForbidden       = TRUE;
-  Data              = NULL;
   CertList          = NULL;
   CertData          = NULL;
   RootCert          = NULL;
@@ -974,11 +1094,9 @@ IsForbiddenByDbx (
   //
   // The image will not be forbidden if dbx can't be got.
   //
-  DataSize = 0;
-  Status   = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE1, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, NULL);
-  ASSERT (EFI_ERROR (Status));
-  if (Status != EFI_BUFFER_TOO_SMALL) {
-    if (Status == EFI_NOT_FOUND) {
+  Dbx = Databases->Dbx;
+  if (EFI_ERROR (Dbx->Status)) {
+    if (Dbx->Status == EFI_NOT_FOUND) {
       //
       // Evidently not in dbx if the database doesn't exist.
       //
@@ -988,22 +1106,12 @@ IsForbiddenByDbx (
     return IsForbidden;
   }
 
-  Data = (UINT8 *)AllocateZeroPool (DataSize);
-  if (Data == NULL) {
-    return IsForbidden;
-  }
-
-  Status = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE1, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, (VOID *)Data);
-  if (EFI_ERROR (Status)) {
-    goto Done;
-  }
-
   //
   // Verify image signature with RAW X509 certificates in DBX database.
   // If passed, the image will be forbidden.
   //
-  CertList     = (EFI_SIGNATURE_LIST *)Data;
-  CertListSize = DataSize;
+  CertList     = (EFI_SIGNATURE_LIST *)Dbx->Data;
+  CertListSize = Dbx->DataSize;
   while ((CertListSize > 0) && (CertListSize >= CertList->SignatureListSize)) {
     if (CompareGuid (&CertList->SignatureType, &gEfiCertX509Guid)) {
       CertData  = (EFI_SIGNATURE_DATA *)((UINT8 *)CertList + sizeof (EFI_SIGNATURE_LIST) + CertList->SignatureHeaderSize);
@@ -1075,7 +1183,7 @@ IsForbiddenByDbx (
     //
     CertPtr = CertPtr + sizeof (UINT32) + CertSize;
 
-    Status = IsCertHashFoundInDbx (Cert, CertSize, (EFI_SIGNATURE_LIST *)Data, DataSize, &RevocationTime, &IsFound);
+    Status = IsCertHashFoundInDbx (Cert, CertSize, Dbx, &RevocationTime, &IsFound);
     if (EFI_ERROR (Status)) {
       //
       // Error in searching dbx. Consider it as 'found'. RevocationTime might
@@ -1087,7 +1195,7 @@ IsForbiddenByDbx (
       // Found Cert in dbx successfully. Check the timestamp signature and
       // signing time to determine if the image can be trusted.
       //
-      if (PassTimestampCheck (AuthData, AuthDataSize, &RevocationTime)) {
+      if (PassTimestampCheck (AuthData, AuthDataSize, &RevocationTime, Databases->Dbt)) {
         IsForbidden = FALSE;
         //
         // Pass DBT check. Continue to check other certs in image signer's cert list against DBX, DBT
@@ -1104,10 +1212,6 @@ IsForbiddenByDbx (
   IsForbidden = FALSE;
 
 Done:
-  if (Data != NULL) {
-    FreePool (Data);
-  }
-
   Pkcs7FreeSigners (CertBuffer);
   Pkcs7FreeSigners (TrustedCert);
 
@@ -1119,6 +1223,7 @@ Done:
 
   @param[in]  AuthData      Pointer to the Authenticode signature retrieved from signed image.
   @param[in]  AuthDataSize  Size of the Authenticode signature in bytes.
+  @param[in]  Databases     The security databases of this image verification.
 
   @retval TRUE         Image passed verification using certificate in db.
   @retval FALSE        Image didn't pass verification using certificate in db.
@@ -1126,32 +1231,31 @@ Done:
 **/
 BOOLEAN
 IsAllowedByDb (
-  IN  CONST UINT8  *AuthData,
-  IN  UINTN        AuthDataSize,
-  OUT UINT8        ImageDigest[MAX_DIGEST_SIZE],
-  OUT UINTN        ImageDigestSize
+  IN  CONST UINT8                *AuthData,
+  IN  UINTN                      AuthDataSize,
+  OUT UINT8                      ImageDigest[MAX_DIGEST_SIZE],
+  OUT UINTN                      ImageDigestSize,
+  IN  CONST SIGNATURE_DATABASES  *Databases
   )
 {
-  EFI_STATUS          Status;
-  BOOLEAN             VerifyStatus;
-  BOOLEAN             IsFound;
-  EFI_SIGNATURE_LIST  *CertList;
-  EFI_SIGNATURE_DATA  *CertData;
-  UINTN               DataSize;
-  UINT8               *Data;
-  UINT8               *RootCert;
-  UINTN               RootCertSize;
-  UINTN               Index;
-  UINTN               CertCount;
-  UINTN               DbxDataSize;
-  UINT8               *DbxData;
-  EFI_TIME            RevocationTime;
+  EFI_STATUS                Status;
+  BOOLEAN                   VerifyStatus;
+  BOOLEAN                   IsFound;
+  EFI_SIGNATURE_LIST        *CertList;
+  EFI_SIGNATURE_DATA        *CertData;
+  UINTN                     DataSize;
+  CONST SIGNATURE_DATABASE  *Db;
+  UINT8                     *RootCert;
+  UINTN                     RootCertSize;
+  UINTN                     Index;
+  UINTN                     CertCount;
+  CONST SIGNATURE_DATABASE  *Dbx;
+  EFI_TIME                  RevocationTime;
 
-  Data         = NULL;
   CertList     = NULL;
   CertData     = NULL;
   RootCert     = NULL;
-  DbxData      = NULL;
+  Dbx          = NULL;
   RootCertSize = 0;
   VerifyStatus = FALSE;
 
@@ -1159,58 +1263,33 @@ IsAllowedByDb (
   // Fetch 'db' content. If 'db' doesn't exist or encounters problem to get the
   // data, return not-allowed-by-db (FALSE).
   //
-  DataSize = 0;
-  Status   = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, NULL);
-  ASSERT (EFI_ERROR (Status));
-  if (Status != EFI_BUFFER_TOO_SMALL) {
-    return VerifyStatus;
-  }
-
-  Data = (UINT8 *)AllocateZeroPool (DataSize);
-  if (Data == NULL) {
+  Db = Databases->Db;
+  if (EFI_ERROR (Db->Status)) {
     return VerifyStatus;
   }
 
-  Status = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, (VOID *)Data);
-  if (EFI_ERROR (Status)) {
-    goto Done;
-  }
-
   //
   // Fetch 'dbx' content. If 'dbx' doesn't exist, continue to check 'db'.
   // If any other errors occurred, no need to check 'db' but just return
   // not-allowed-by-db (FALSE) to avoid bypass.
   //
-  DbxDataSize = 0;
-  Status      = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE1, &gEfiImageSecurityDatabaseGuid, NULL, &DbxDataSize, NULL);
-  ASSERT (EFI_ERROR (Status));
-  if (Status != EFI_BUFFER_TOO_SMALL) {
-    if (Status != EFI_NOT_FOUND) {
+  Dbx = Databases->Dbx;
+  if (EFI_ERROR (Dbx->Status)) {
+    if (Dbx->Status != EFI_NOT_FOUND) {
       goto Done;
     }
 
     //
     // 'dbx' does not exist. Continue to check 'db'.
     //
-  } else {
-    //
-    // 'dbx' exists. Get its content.
-    //
-    DbxData = (UINT8 *)AllocateZeroPool (DbxDataSize);
-    if (DbxData == NULL) {
-      goto Done;
-    }
-
-    Status = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE1, &gEfiImageSecurityDatabaseGuid, NULL, &DbxDataSize, (VOID *)DbxData);
-    if (EFI_ERROR (Status)) {
-      goto Done;
-    }
+    Dbx = NULL;
   }
 
   //
   // Find X509 certificate in Signature List to verify the signature in pkcs7 signed data.
   //
-  CertList = (EFI_SIGNATURE_LIST *)Data;
+  CertList = (EFI_SIGNATURE_LIST *)Db->Data;
+  DataSize = Db->DataSize;
   while ((DataSize > 0) && (DataSize >= CertList->SignatureListSize)) {
     if (CompareGuid (&CertList->SignatureType, &gEfiCertX509Guid)) {
       CertData  = (EFI_SIGNATURE_DATA *)((UINT8 *)CertList + sizeof (EFI_SIGNATURE_LIST) + CertList->SignatureHeaderSize);
@@ -1238,11 +1317,11 @@ IsAllowedByDb (
           //
           // The image is signed and its signature is found in 'db'.
           //
-          if (DbxData != NULL) {
+          if (Dbx != NULL) {
             //
             // Here We still need to check if this RootCert's Hash is revoked
             //
-            Status = IsCertHashFoundInDbx (RootCert, RootCertSize, (EFI_SIGNATURE_LIST *)DbxData, DbxDataSize, &RevocationTime, &IsFound);
+            Status = IsCertHashFoundInDbx (RootCert, RootCertSize, Dbx, &RevocationTime, &IsFound);
             if (EFI_ERROR (Status)) {
               //
               // Error in searching dbx. Consider it as 'found'. RevocationTime might
@@ -1253,7 +1332,7 @@ IsAllowedByDb (
               //
               // Check the timestamp signature and signing time to determine if the RootCert can be trusted.
               //
-              VerifyStatus = PassTimestampCheck (AuthData, AuthDataSize, &RevocationTime);
+              VerifyStatus = PassTimestampCheck (AuthData, AuthDataSize, &RevocationTime, Databases->Dbt);
               if (!VerifyStatus) {
                 DEBUG ((DEBUG_INFO, "DxeImageVerificationLib: Image is signed and signature is accepted by DB, but its root cert failed the timestamp check.\n"));
               }
@@ -1283,15 +1362,65 @@ Done:
     SecureBootHook (EFI_IMAGE_SECURITY_DATABASE, &gEfiImageSecurityDatabaseGuid, CertList->SignatureSize, CertData);
   }
 
-  if (Data != NULL) {
-    FreePool (Data);
-  }
+  return VerifyStatus;
+}
+
+/**
+  Get the hash algorithms of the Authenticode signatures of an image.
 
-  if (DbxData != NULL) {
-    FreePool (DbxData);
+  @param[in]  ImageContext  The context of the image.
+
+  @return Bit N is set if a signature uses mHash[N].
+**/
+UINT32
+GetSignatureHashMask (
+  IN UEFI_IMAGE_LOADER_IMAGE_CONTEXT  *ImageContext
+  )
+{
+  RETURN_STATUS                    Status;
+  CONST WIN_CERTIFICATE            *WinCertificate;
+  CONST WIN_CERTIFICATE_EFI_PKCS   *PkcsCertData;
+  CONST WIN_CERTIFICATE_UEFI_GUID  *WinCertUefiGuid;
+  CONST UINT8                      *AuthData;
+  UINTN                            AuthDataSize;
+  UINTN                            HashAlg;
+  UINT32                           HashMask;
+
+  HashMask = 0;
+  for (
+       Status = UefiImageGetFirstCertificate (ImageContext, &WinCertificate);
+       !RETURN_ERROR (Status);
+       Status = UefiImageGetNextCertificate (ImageContext, &WinCertificate)
+       )
+  {
+    if (WinCertificate->wCertificateType == WIN_CERT_TYPE_PKCS_SIGNED_DATA) {
+      PkcsCertData = (CONST WIN_CERTIFICATE_EFI_PKCS *)WinCertificate;
+      if (PkcsCertData->Hdr.dwLength <= sizeof (PkcsCertData->Hdr)) {
+        continue;
+      }
+
+      AuthData     = PkcsCertData->CertData;
+      AuthDataSize = PkcsCertData->Hdr.dwLength - sizeof (PkcsCertData->Hdr);
+    } else if (WinCertificate->wCertificateType == WIN_CERT_TYPE_EFI_GUID) {
+      WinCertUefiGuid = (CONST WIN_CERTIFICATE_UEFI_GUID *)WinCertificate;
+      if (!CompareGuid (&WinCertUefiGuid->CertType, &gEfiCertPkcs7Guid) ||
+          (WinCertUefiGuid->Hdr.dwLength <= OFFSET_OF (WIN_CERTIFICATE_UEFI_GUID, CertData)))
+      {
+        continue;
+      }
+
+      AuthData     = WinCertUefiGuid->CertData;
+      AuthDataSize = WinCertUefiGuid->Hdr.dwLength - OFFSET_OF (WIN_CERTIFICATE_UEFI_GUID, CertData);
+    } else {
+      continue;
+    }
+
+    if (!EFI_ERROR (GetAuthenticodeHashAlg (AuthData, AuthDataSize, &HashAlg))) {
+      HashMask |= 1U << HashAlg;
+    }
   }
 
-  return VerifyStatus;
+  return HashMask;
 }
 
 /**
@@ -1378,6 +1507,10 @@ DxeImageVerificationHandler (
   UINT8                            ImageDigest[MAX_DIGEST_SIZE];
   UINTN                            ImageDigestSize;
   CONST EFI_GUID                   *CertType;
+  IMAGE_VERIFICATION_CACHE_KEY     CacheKey;
+  IMAGE_DIGESTS                    Digests;
+  UINT32                           HashMask;
+  SIGNATURE_DATABASES              Databases;
 
   SignatureList     = NULL;
   SignatureListSize = 0;
@@ -1464,8 +1597,29 @@ DxeImageVerificationHandler (
     return EFI_ACCESS_DENIED;
   }
 
+  //
+  // Read db, dbx and dbt once, all the checks below use the same content.
+  //
+  LoadSignatureDatabases (&Databases);
+
   HashStatus = UefiImageGetFirstCertificate (ImageContext, &WinCertificate);
 
+  //
+  // Hash the image once with every algorithm the checks below use: all of
+  // them for an unsigned image, whose hash is looked up in db and dbx with
+  // every algorithm, and the ones of the signatures for a signed image.
+  //
+  if (HashStatus == RETURN_NOT_FOUND) {
+    HashMask = (1U << ARRAY_SIZE (mHash)) - 1;
+  } else {
+    HashMask = GetSignatureHashMask (ImageContext);
+    if (PcdGet32 (PcdImageVerificationCacheSize) != 0) {
+      HashMask |= 1U << HASHALG_SHA256;
+    }
+  }
+
+  HashPeImages (ImageContext, HashMask, &Digests);
+
   //
   // Start Image Validation.
   //
@@ -1481,14 +1635,14 @@ DxeImageVerificationHandler (
         continue;
       }
 
-      if (!HashPeImage (ImageContext, &mHash[HashAlg], ImageDigest, &ImageDigestSize)) {
+      if (!GetPeImageDigest (ImageContext, &Digests, HashAlg, ImageDigest, &ImageDigestSize)) {
         continue;
       }
 
       CertType = mHash[HashAlg].CertType;
 
       DbStatus = IsSignatureFoundInDatabase (
-                   EFI_IMAGE_SECURITY_DATABASE1,
+                   Databases.Dbx,
                    ImageDigest,
                    CertType,
                    ImageDigestSize,
@@ -1503,7 +1657,7 @@ DxeImageVerificationHandler (
       }
 
       DbStatus = IsSignatureFoundInDatabase (
-                   EFI_IMAGE_SECURITY_DATABASE,
+                   Databases.Db,
                    ImageDigest,
                    CertType,
                    ImageDigestSize,
@@ -1528,6 +1682,14 @@ DxeImageVerificationHandler (
     goto Failed;
   }
 
+  //
+  // An image that is loaded again with the same content and signatures, and
+  // with the same security databases, passes again.
+  //
+  if (ImageVerificationCacheLookup (ImageContext, &Digests, Databases.Generation, &CacheKey)) {
+    return EFI_SUCCESS;
+  }
+
   //
   // Verify the signature of the image, multiple signatures are allowed as per PE/COFF Section 4.7
   // "Attribute Certificate Table".
@@ -1574,7 +1736,15 @@ DxeImageVerificationHandler (
       continue;
     }
 
-    HashStatus = HashPeImageByType (ImageContext, AuthData, AuthDataSize, ImageDigest, &ImageDigestSize, &CertType);
+    HashStatus = HashPeImageByType (
+                   ImageContext,
+                   AuthData,
+                   AuthDataSize,
+                   &Digests,
+                   ImageDigest,
+                   &ImageDigestSize,
+                   &CertType
+                   );
     if (EFI_ERROR (HashStatus)) {
       continue;
     }
@@ -1582,7 +1752,7 @@ DxeImageVerificationHandler (
     //
     // Check the digital signature against the revoked certificate in forbidden database (dbx).
     //
-    if (IsForbiddenByDbx (AuthData, AuthDataSize, ImageDigest, ImageDigestSize)) {
+    if (IsForbiddenByDbx (AuthData, AuthDataSize, ImageDigest, ImageDigestSize, &Databases)) {
       Action     = EFI_IMAGE_EXECUTION_AUTH_SIG_FAILED;
       IsVerified = FALSE;
     }
@@ -1591,7 +1761,7 @@ DxeImageVerificationHandler (
     // Check the digital signature against the valid certificate in allowed database (db).
     //
     if (!IsVerified) {
-      if (IsAllowedByDb (AuthData, AuthDataSize, ImageDigest, ImageDigestSize)) {
+      if (IsAllowedByDb (AuthData, AuthDataSize, ImageDigest, ImageDigestSize, &Databases)) {
         IsVerified = TRUE;
       }
     }
@@ -1600,7 +1770,7 @@ DxeImageVerificationHandler (
     // Check the image's hash value.
     //
     DbStatus = IsSignatureFoundInDatabase (
-                 EFI_IMAGE_SECURITY_DATABASE1,
+                 Databases.Dbx,
                  ImageDigest,
                  CertType,
                  ImageDigestSize,
@@ -1615,7 +1785,7 @@ DxeImageVerificationHandler (
 
     if (!IsVerified) {
       DbStatus = IsSignatureFoundInDatabase (
-                   EFI_IMAGE_SECURITY_DATABASE,
+                   Databases.Db,
                    ImageDigest,
                    CertType,
                    ImageDigestSize,
@@ -1631,6 +1801,7 @@ DxeImageVerificationHandler (
   }
 
   if (IsVerified) {
+    ImageVerificationCacheInsert (&CacheKey);
     return EFI_SUCCESS;
   }
   if ((Action == EFI_IMAGE_EXECUTION_AUTH_SIG_FAILED) || (Action == EFI_IMAGE_EXECUTION_AUTH_SIG_FOUND)) {
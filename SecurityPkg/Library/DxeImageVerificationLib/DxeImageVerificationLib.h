@@ -10,6 +10,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #ifndef __IMAGEVERIFICATIONLIB_H__
 #define __IMAGEVERIFICATIONLIB_H__
 
+#include <PiDxe.h>
 #include <Library/UefiDriverEntryPoint.h>
 #include <Library/DebugLib.h>
 #include <Library/BaseMemoryLib.h>
@@ -63,6 +64,20 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 // Set max digest size as SHA512 Output (64 bytes) by far
 //
 #define MAX_DIGEST_SIZE  SHA512_DIGEST_SIZE
+
+//
+//  Support hash types
+//
+#define HASHALG_SHA256  0x00000000
+#define HASHALG_SHA384  0x00000001
+#define HASHALG_SHA512  0x00000002
+#define HASHALG_SHA1    0x00000003
+#define HASHALG_MAX     0x00000004
+
+//
+// Size of the blocks HashPeImages() passes to each hash algorithm in turn
+//
+#define IMAGE_HASH_BLOCK_SIZE  SIZE_16KB
 //
 //
 // PKCS7 Certificate definition
@@ -189,4 +204,177 @@ typedef struct {
   HASH_FINAL               HashFinal;
 } HASH_TABLE;
 
+//
+// A certificate hash signature type and the index of its algorithm in mHash
+//
+typedef struct {
+  CONST EFI_GUID    *SignatureType;
+  UINT32            HashAlg;
+} CERT_HASH_TYPE;
+
+//
+// Authenticode digests of an image, see HashPeImages()
+//
+typedef struct {
+  //
+  // Bit N is set if Digest[N] holds the digest computed with mHash[N]
+  //
+  UINT32    ValidMask;
+  UINT8     Digest[HASHALG_MAX][MAX_DIGEST_SIZE];
+} IMAGE_DIGESTS;
+
+//
+// Number of signature types whose entries SIGNATURE_DATABASE sorts by digest
+//
+#define SIGNATURE_INDEX_TYPE_COUNT  8
+
+//
+// An entry of a signature list that starts with a digest
+//
+typedef struct {
+  CONST EFI_SIGNATURE_LIST    *List;
+  CONST EFI_SIGNATURE_DATA    *Data;
+  UINTN                       DigestSize;
+} SIGNATURE_INDEX_ENTRY;
+
+//
+// Content of a security database variable, see LoadSignatureDatabases()
+//
+typedef struct {
+  //
+  // Name of the variable
+  //
+  CHAR16                   *VariableName;
+  //
+  // FALSE if the variable has to be parsed again
+  //
+  BOOLEAN                  Loaded;
+  //
+  // EFI_NOT_FOUND if the variable does not exist, or the error that prevented
+  // reading or indexing it
+  //
+  EFI_STATUS               Status;
+  //
+  // Content of the variable, also compared with the variable to notice a write
+  //
+  UINT8                    *Data;
+  UINTN                    DataSize;
+  //
+  // Entries of each indexed signature type, sorted by digest
+  //
+  SIGNATURE_INDEX_ENTRY    *Entries[SIGNATURE_INDEX_TYPE_COUNT];
+  UINTN                    EntryCount[SIGNATURE_INDEX_TYPE_COUNT];
+} SIGNATURE_DATABASE;
+
+//
+// The security databases an image is verified against
+//
+typedef struct {
+  CONST SIGNATURE_DATABASE    *Db;
+  CONST SIGNATURE_DATABASE    *Dbx;
+  CONST SIGNATURE_DATABASE    *Dbt;
+  //
+  // Changes whenever a database changed or could not be read
+  //
+  UINTN                       Generation;
+} SIGNATURE_DATABASES;
+
+//
+// Identifies a signed image and the security databases it was verified against
+//
+typedef struct {
+  //
+  // FALSE if the image must not be looked up or added to the cache
+  //
+  BOOLEAN    Valid;
+  //
+  // SHA-256 Authenticode digest of the image
+  //
+  UINT8      ImageDigest[SHA256_DIGEST_SIZE];
+  //
+  // SHA-256 digest of the certificate table of the image
+  //
+  UINT8      CertificateDigest[SHA256_DIGEST_SIZE];
+  //
+  // Generation of the databases the image is verified against
+  //
+  UINTN      DatabaseGeneration;
+} IMAGE_VERIFICATION_CACHE_KEY;
+
+/**
+  Get db, dbx and dbt for an image verification.
+
+  Every variable is read once per call, and parsed again only when it
+  changed. The returned databases stay valid until the next call.
+
+  @param[out] Databases  The databases and their generation.
+**/
+VOID
+LoadSignatureDatabases (
+  OUT SIGNATURE_DATABASES  *Databases
+  );
+
+/**
+  Look up a digest in a security database.
+
+  @param[in]  Database       The database.
+  @param[in]  SignatureType  The type of the signature lists to look in.
+  @param[in]  Digest         The digest.
+  @param[in]  DigestSize     The size of the digest, in bytes.
+  @param[out] Entry          The first entry with the digest, in the order of
+                             the variable.
+
+  @retval EFI_SUCCESS       The digest is found.
+  @retval EFI_NOT_FOUND     The digest is not found.
+  @retval EFI_UNSUPPORTED   The digests of SignatureType are not indexed, or
+                            DigestSize does not match SignatureType.
+**/
+EFI_STATUS
+FindSignatureDigest (
+  IN  CONST SIGNATURE_DATABASE     *Database,
+  IN  CONST EFI_GUID               *SignatureType,
+  IN  CONST UINT8                  *Digest,
+  IN  UINTN                        DigestSize,
+  OUT CONST SIGNATURE_INDEX_ENTRY  **Entry OPTIONAL
+  );
+
+/**
+  Check whether a signed image passed the signature checks before.
+
+  The key covers the Authenticode digest and the certificate table of the
+  image, so any change of the image that would change the result of the
+  checks misses the cache. The cache is flushed when db, dbx or dbt changed
+  since the last lookup.
+
+  @param[in]  ImageContext        The context of the image.
+  @param[in]  Digests             The Authenticode digests of the image, the
+                                  key uses the SHA-256 one.
+  @param[in]  DatabaseGeneration  The generation of the databases the image
+                                  is verified against, see
+                                  LoadSignatureDatabases().
+  @param[out] Key                 The key of the image, to pass to
+                                  ImageVerificationCacheInsert() once the
+                                  image passed the checks.
+
+  @retval TRUE   The image passed the signature checks before.
+  @retval FALSE  The image has to be verified.
+**/
+BOOLEAN
+ImageVerificationCacheLookup (
+  IN  UEFI_IMAGE_LOADER_IMAGE_CONTEXT  *ImageContext,
+  IN  CONST IMAGE_DIGESTS              *Digests,
+  IN  UINTN                            DatabaseGeneration,
+  OUT IMAGE_VERIFICATION_CACHE_KEY     *Key
+  );
+
+/**
+  Remember that a signed image passed the signature checks.
+
+  @param[in]  Key  The key returned by ImageVerificationCacheLookup().
+**/
+VOID
+ImageVerificationCacheInsert (
+  IN CONST IMAGE_VERIFICATION_CACHE_KEY  *Key
+  );
+
 #endif
@@ -0,0 +1,194 @@
+/** @file
+  Remember the signed images that passed verification, so that loading the
+  same image again does not verify its signatures again.
+
+  Caution: This file requires additional review when modified.
+  This library will have external input - PE/COFF image.
+  ImageVerificationCacheLookup() hashes the certificate table of the image,
+  which has been checked by UefiImageInitializeContext() before.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "DxeImageVerificationLib.h"
+
+typedef struct {
+  UINT8    ImageDigest[SHA256_DIGEST_SIZE];
+  UINT8    CertificateDigest[SHA256_DIGEST_SIZE];
+} IMAGE_VERIFICATION_CACHE_ENTRY;
+
+IMAGE_VERIFICATION_CACHE_ENTRY  *mImageVerificationCache          = NULL;
+UINTN                           mImageVerificationCacheCount      = 0;
+UINTN                           mImageVerificationCacheNext       = 0;
+UINTN                           mImageVerificationCacheGeneration = 0;
+
+/**
+  Compute the key of a signed image.
+
+  @param[in]  ImageContext  The context of the image.
+  @param[in]  Digests       The Authenticode digests of the image.
+  @param[out] Key           The key of the image.
+
+  @retval TRUE   The key is computed.
+  @retval FALSE  The key could not be computed.
+**/
+STATIC
+BOOLEAN
+ComputeCacheKey (
+  IN  UEFI_IMAGE_LOADER_IMAGE_CONTEXT  *ImageContext,
+  IN  CONST IMAGE_DIGESTS              *Digests,
+  OUT IMAGE_VERIFICATION_CACHE_KEY     *Key
+  )
+{
+  VOID                   *HashContext;
+  BOOLEAN                Result;
+  RETURN_STATUS          Status;
+  CONST WIN_CERTIFICATE  *WinCertificate;
+
+  if ((Digests->ValidMask & (1U << HASHALG_SHA256)) == 0) {
+    return FALSE;
+  }
+
+  CopyMem (Key->ImageDigest, Digests->Digest[HASHALG_SHA256], SHA256_DIGEST_SIZE);
+
+  HashContext = AllocatePool (Sha256GetContextSize ());
+  if (HashContext == NULL) {
+    return FALSE;
+  }
+
+  //
+  // The Authenticode digest does not cover the certificate table, which holds
+  // the signatures.
+  //
+  Result = Sha256Init (HashContext);
+  for (
+       Status = UefiImageGetFirstCertificate (ImageContext, &WinCertificate);
+       Result && !RETURN_ERROR (Status);
+       Status = UefiImageGetNextCertificate (ImageContext, &WinCertificate)
+       )
+  {
+    Result = Sha256Update (HashContext, WinCertificate, WinCertificate->dwLength);
+  }
+
+  //
+  // Do not remember images with a malformed certificate table.
+  //
+  if (Status != RETURN_NOT_FOUND) {
+    Result = FALSE;
+  }
+
+  Result = Result && Sha256Final (HashContext, Key->CertificateDigest);
+  FreePool (HashContext);
+
+  return Result;
+}
+
+/**
+  Check whether a signed image passed the signature checks before.
+
+  The key covers the Authenticode digest and the certificate table of the
+  image, so any change of the image that would change the result of the
+  checks misses the cache. The cache is flushed when db, dbx or dbt changed
+  since the last lookup.
+
+  @param[in]  ImageContext        The context of the image.
+  @param[in]  Digests             The Authenticode digests of the image, the
+                                  key uses the SHA-256 one.
+  @param[in]  DatabaseGeneration  The generation of the databases the image
+                                  is verified against, see
+                                  LoadSignatureDatabases().
+  @param[out] Key                 The key of the image, to pass to
+                                  ImageVerificationCacheInsert() once the
+                                  image passed the checks.
+
+  @retval TRUE   The image passed the signature checks before.
+  @retval FALSE  The image has to be verified.
+**/
+BOOLEAN
+ImageVerificationCacheLookup (
+  IN  UEFI_IMAGE_LOADER_IMAGE_CONTEXT  *ImageContext,
+  IN  CONST IMAGE_DIGESTS              *Digests,
+  IN  UINTN                            DatabaseGeneration,
+  OUT IMAGE_VERIFICATION_CACHE_KEY     *Key
+  )
+{
+  UINTN  Index;
+
+  ZeroMem (Key, sizeof (*Key));
+  if (PcdGet32 (PcdImageVerificationCacheSize) == 0) {
+    return FALSE;
+  }
+
+  Key->DatabaseGeneration = DatabaseGeneration;
+  Key->Valid              = ComputeCacheKey (ImageContext, Digests, Key);
+  if (!Key->Valid) {
+    return FALSE;
+  }
+
+  if (Key->DatabaseGeneration != mImageVerificationCacheGeneration) {
+    //
+    // The entries were verified against other databases.
+    //
+    if (mImageVerificationCacheCount != 0) {
+      DEBUG ((DEBUG_INFO, "DxeImageVerificationLib: Security databases changed, flush the verification cache.\n"));
+    }
+
+    mImageVerificationCacheCount      = 0;
+    mImageVerificationCacheNext       = 0;
+    mImageVerificationCacheGeneration = Key->DatabaseGeneration;
+    return FALSE;
+  }
+
+  for (Index = 0; Index < mImageVerificationCacheCount; Index++) {
+    if ((CompareMem (mImageVerificationCache[Index].ImageDigest, Key->ImageDigest, SHA256_DIGEST_SIZE) == 0) &&
+        (CompareMem (mImageVerificationCache[Index].CertificateDigest, Key->CertificateDigest, SHA256_DIGEST_SIZE) == 0))
+    {
+      DEBUG ((DEBUG_INFO, "DxeImageVerificationLib: Image passed verification before.\n"));
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/**
+  Remember that a signed image passed the signature checks.
+
+  @param[in]  Key  The key returned by ImageVerificationCacheLookup().
+**/
+VOID
+ImageVerificationCacheInsert (
+  IN CONST IMAGE_VERIFICATION_CACHE_KEY  *Key
+  )
+{
+  UINTN  CacheSize;
+
+  //
+  // Another lookup saw other databases since this image was looked up.
+  //
+  if (!Key->Valid ||
+      (Key->DatabaseGeneration != mImageVerificationCacheGeneration))
+  {
+    return;
+  }
+
+  CacheSize = PcdGet32 (PcdImageVerificationCacheSize);
+  if (mImageVerificationCache == NULL) {
+    mImageVerificationCache = AllocatePool (CacheSize * sizeof (IMAGE_VERIFICATION_CACHE_ENTRY));
+    if (mImageVerificationCache == NULL) {
+      return;
+    }
+  }
+
+  //
+  // Replace the oldest entry once the cache is full.
+  //
+  CopyMem (mImageVerificationCache[mImageVerificationCacheNext].ImageDigest, Key->ImageDigest, SHA256_DIGEST_SIZE);
+  CopyMem (mImageVerificationCache[mImageVerificationCacheNext].CertificateDigest, Key->CertificateDigest, SHA256_DIGEST_SIZE);
+  mImageVerificationCacheNext = (mImageVerificationCacheNext + 1) % CacheSize;
+  if (mImageVerificationCacheCount < CacheSize) {
+    mImageVerificationCacheCount++;
+  }
+}
@@ -0,0 +1,474 @@
+/** @file
+  Unit tests of the security databases kept by DxeImageVerificationLib, and of
+  the verification cache that depends on them.
+
+  The variables are written behind the back of the library, as a write through
+  a SetVariable() pointer cached by another driver or an MM handler would.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <PiDxe.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UnitTestLib.h>
+
+#include "../DxeImageVerificationLib.h"
+
+#define UNIT_TEST_NAME     "DxeImageVerificationLibSignatureDatabaseTest"
+#define UNIT_TEST_VERSION  "1.0"
+
+//
+// A database with a single SHA-256 signature
+//
+typedef struct {
+  EFI_SIGNATURE_LIST    List;
+  EFI_GUID              Owner;
+  UINT8                 Digest[SHA256_DIGEST_SIZE];
+} TEST_SIGNATURE_DATABASE;
+
+typedef struct {
+  CHAR16                     *Name;
+  BOOLEAN                    InUse;
+  TEST_SIGNATURE_DATABASE    Data;
+} TEST_VARIABLE;
+
+TEST_VARIABLE  mTestVariables[] = {
+  { EFI_IMAGE_SECURITY_DATABASE  },
+  { EFI_IMAGE_SECURITY_DATABASE1 },
+  { EFI_IMAGE_SECURITY_DATABASE2 }
+};
+
+//
+// Status returned by GetVariable() for an existing variable, if an error
+//
+EFI_STATUS  mTestGetVariableStatus = EFI_SUCCESS;
+
+EFI_RUNTIME_SERVICES  mTestRuntimeServices;
+EFI_RUNTIME_SERVICES  *gRT = &mTestRuntimeServices;
+
+/**
+  The test images have no certificate table.
+
+  @param[in, out] Context      Not used.
+  @param[out]     Certificate  Not used.
+
+  @retval RETURN_NOT_FOUND  There is no certificate.
+**/
+RETURN_STATUS
+UefiImageGetFirstCertificate (
+  IN OUT UEFI_IMAGE_LOADER_IMAGE_CONTEXT  *Context,
+  OUT    CONST WIN_CERTIFICATE            **Certificate
+  )
+{
+  return RETURN_NOT_FOUND;
+}
+
+/**
+  The test images have no certificate table.
+
+  @param[in, out] Context      Not used.
+  @param[in, out] Certificate  Not used.
+
+  @retval RETURN_NOT_FOUND  There is no certificate.
+**/
+RETURN_STATUS
+UefiImageGetNextCertificate (
+  IN OUT UEFI_IMAGE_LOADER_IMAGE_CONTEXT  *Context,
+  IN OUT CONST WIN_CERTIFICATE            **Certificate
+  )
+{
+  return RETURN_NOT_FOUND;
+}
+
+/**
+  GetVariable() over the test security databases.
+
+  @param[in]      VariableName  The name of the variable.
+  @param[in]      VendorGuid    The vendor GUID of the variable.
+  @param[out]     Attributes    Not set.
+  @param[in, out] DataSize      The size of Data, in bytes.
+  @param[out]     Data          The content of the variable.
+
+  @retval EFI_SUCCESS           The variable is returned.
+  @retval EFI_NOT_FOUND         The variable does not exist.
+  @retval EFI_BUFFER_TOO_SMALL  DataSize is too small.
+**/
+EFI_STATUS
+EFIAPI
+TestGetVariable (
+  IN     CHAR16    *VariableName,
+  IN     EFI_GUID  *VendorGuid,
+  OUT    UINT32    *Attributes OPTIONAL,
+  IN OUT UINTN     *DataSize,
+  OUT    VOID      *Data OPTIONAL
+  )
+{
+  UINTN  Index;
+
+  if (!CompareGuid (VendorGuid, &gEfiImageSecurityDatabaseGuid)) {
+    return EFI_NOT_FOUND;
+  }
+
+  for (Index = 0; Index < ARRAY_SIZE (mTestVariables); Index++) {
+    if (mTestVariables[Index].InUse && (StrCmp (VariableName, mTestVariables[Index].Name) == 0)) {
+      break;
+    }
+  }
+
+  if (Index == ARRAY_SIZE (mTestVariables)) {
+    return EFI_NOT_FOUND;
+  }
+
+  if (EFI_ERROR (mTestGetVariableStatus)) {
+    return mTestGetVariableStatus;
+  }
+
+  if (*DataSize < sizeof (mTestVariables[Index].Data)) {
+    *DataSize = sizeof (mTestVariables[Index].Data);
+    return EFI_BUFFER_TOO_SMALL;
+  }
+
+  *DataSize = sizeof (mTestVariables[Index].Data);
+  CopyMem (Data, &mTestVariables[Index].Data, *DataSize);
+  return EFI_SUCCESS;
+}
+
+/**
+  Write a security database with a single SHA-256 signature. The size of the
+  variable does not depend on the signature.
+
+  @param[in]  VariableName  The name of the variable.
+  @param[in]  Fill          The value of every byte of the digest.
+**/
+VOID
+SetTestDatabase (
+  IN CHAR16  *VariableName,
+  IN UINT8   Fill
+  )
+{
+  UINTN                    Index;
+  TEST_SIGNATURE_DATABASE  *Data;
+
+  for (Index = 0; Index < ARRAY_SIZE (mTestVariables); Index++) {
+    if (StrCmp (VariableName, mTestVariables[Index].Name) == 0) {
+      break;
+    }
+  }
+
+  ASSERT (Index < ARRAY_SIZE (mTestVariables));
+
+  Data = &mTestVariables[Index].Data;
+  ZeroMem (Data, sizeof (*Data));
+  CopyGuid (&Data->List.SignatureType, &gEfiCertSha256Guid);
+  Data->List.SignatureListSize = sizeof (*Data);
+  Data->List.SignatureSize     = sizeof (EFI_GUID) + SHA256_DIGEST_SIZE;
+  SetMem (Data->Digest, sizeof (Data->Digest), Fill);
+
+  mTestVariables[Index].InUse = TRUE;
+}
+
+/**
+  Delete the security databases and have GetVariable() succeed again.
+
+  @param[in]  Context  Not used.
+**/
+VOID
+EFIAPI
+ResetTestVariables (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < ARRAY_SIZE (mTestVariables); Index++) {
+    mTestVariables[Index].InUse = FALSE;
+  }
+
+  mTestGetVariableStatus = EFI_SUCCESS;
+}
+
+/**
+  Check whether a SHA-256 digest is in a security database.
+
+  @param[in]  VariableName  The name of the variable.
+  @param[in]  Fill          The value of every byte of the digest.
+
+  @retval TRUE   The digest is in the database.
+  @retval FALSE  The digest is not in the database, or the database could not
+                 be read.
+**/
+BOOLEAN
+IsTestDigestInDatabase (
+  IN CHAR16  *VariableName,
+  IN UINT8   Fill
+  )
+{
+  SIGNATURE_DATABASES       Databases;
+  CONST SIGNATURE_DATABASE  *Database;
+  UINT8                     Digest[SHA256_DIGEST_SIZE];
+
+  LoadSignatureDatabases (&Databases);
+  if (StrCmp (VariableName, Databases.Db->VariableName) == 0) {
+    Database = Databases.Db;
+  } else if (StrCmp (VariableName, Databases.Dbx->VariableName) == 0) {
+    Database = Databases.Dbx;
+  } else {
+    Database = Databases.Dbt;
+  }
+
+  if (EFI_ERROR (Database->Status)) {
+    return FALSE;
+  }
+
+  SetMem (Digest, sizeof (Digest), Fill);
+  return FindSignatureDigest (Database, &gEfiCertSha256Guid, Digest, sizeof (Digest), NULL) == EFI_SUCCESS;
+}
+
+/**
+  Look up the test image in the verification cache.
+
+  @param[out] Key  The key of the image.
+
+  @retval TRUE   The image passed the signature checks before.
+  @retval FALSE  The image has to be verified.
+**/
+BOOLEAN
+LookupTestImage (
+  OUT IMAGE_VERIFICATION_CACHE_KEY  *Key
+  )
+{
+  UEFI_IMAGE_LOADER_IMAGE_CONTEXT  ImageContext;
+  IMAGE_DIGESTS                    Digests;
+  SIGNATURE_DATABASES              Databases;
+
+  ZeroMem (&ImageContext, sizeof (ImageContext));
+  ZeroMem (&Digests, sizeof (Digests));
+  Digests.ValidMask = 1U << HASHALG_SHA256;
+  SetMem (Digests.Digest[HASHALG_SHA256], SHA256_DIGEST_SIZE, 0x5A);
+
+  LoadSignatureDatabases (&Databases);
+  return ImageVerificationCacheLookup (&ImageContext, &Digests, Databases.Generation, Key);
+}
+
+/**
+  A dbx written behind the back of the library is parsed again, even if its
+  size did not change.
+
+  @param[in]  Context  Not used.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestDbxUpdateReloadsDatabase (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  SetTestDatabase (EFI_IMAGE_SECURITY_DATABASE1, 0xA1);
+  UT_ASSERT_TRUE (IsTestDigestInDatabase (EFI_IMAGE_SECURITY_DATABASE1, 0xA1));
+  UT_ASSERT_FALSE (IsTestDigestInDatabase (EFI_IMAGE_SECURITY_DATABASE1, 0xB2));
+
+  SetTestDatabase (EFI_IMAGE_SECURITY_DATABASE1, 0xB2);
+  UT_ASSERT_FALSE (IsTestDigestInDatabase (EFI_IMAGE_SECURITY_DATABASE1, 0xA1));
+  UT_ASSERT_TRUE (IsTestDigestInDatabase (EFI_IMAGE_SECURITY_DATABASE1, 0xB2));
+
+  ResetTestVariables (NULL);
+  UT_ASSERT_FALSE (IsTestDigestInDatabase (EFI_IMAGE_SECURITY_DATABASE1, 0xB2));
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  A database that did not change is not parsed again.
+
+  @param[in]  Context  Not used.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestUnchangedDatabaseIsKept (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  SIGNATURE_DATABASES  Databases;
+  CONST UINT8          *Data;
+  UINTN                Generation;
+
+  SetTestDatabase (EFI_IMAGE_SECURITY_DATABASE, 0xC3);
+  SetTestDatabase (EFI_IMAGE_SECURITY_DATABASE1, 0xD4);
+
+  LoadSignatureDatabases (&Databases);
+  UT_ASSERT_NOT_EFI_ERROR (Databases.Dbx->Status);
+  Data       = Databases.Dbx->Data;
+  Generation = Databases.Generation;
+
+  LoadSignatureDatabases (&Databases);
+  UT_ASSERT_NOT_EFI_ERROR (Databases.Dbx->Status);
+  UT_ASSERT_TRUE (Databases.Dbx->Data == Data);
+  UT_ASSERT_EQUAL (Databases.Generation, Generation);
+
+  SetTestDatabase (EFI_IMAGE_SECURITY_DATABASE1, 0xE5);
+  LoadSignatureDatabases (&Databases);
+  UT_ASSERT_NOT_EQUAL (Databases.Generation, Generation);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  A dbx update flushes the verification cache.
+
+  @param[in]  Context  Not used.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestDbxUpdateFlushesCache (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  IMAGE_VERIFICATION_CACHE_KEY  Key;
+
+  SetTestDatabase (EFI_IMAGE_SECURITY_DATABASE, 0xC3);
+  SetTestDatabase (EFI_IMAGE_SECURITY_DATABASE1, 0xA1);
+
+  LookupTestImage (&Key);
+  ImageVerificationCacheInsert (&Key);
+  UT_ASSERT_TRUE (LookupTestImage (&Key));
+
+  SetTestDatabase (EFI_IMAGE_SECURITY_DATABASE1, 0xB2);
+  UT_ASSERT_FALSE (LookupTestImage (&Key));
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  An image verified while dbx is updated is not remembered.
+
+  @param[in]  Context  Not used.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestDbxUpdateDuringVerification (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  IMAGE_VERIFICATION_CACHE_KEY  Key;
+
+  SetTestDatabase (EFI_IMAGE_SECURITY_DATABASE, 0xC3);
+  SetTestDatabase (EFI_IMAGE_SECURITY_DATABASE1, 0xA1);
+
+  UT_ASSERT_FALSE (LookupTestImage (&Key));
+  SetTestDatabase (EFI_IMAGE_SECURITY_DATABASE1, 0xB2);
+  ImageVerificationCacheInsert (&Key);
+  UT_ASSERT_FALSE (LookupTestImage (&Key));
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  A database that cannot be read fails the lookups and keeps the verification
+  cache empty.
+
+  @param[in]  Context  Not used.
+
+  @retval UNIT_TEST_PASSED  The test passed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestReadErrorFailsClosed (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  SIGNATURE_DATABASES           Databases;
+  IMAGE_VERIFICATION_CACHE_KEY  Key;
+
+  SetTestDatabase (EFI_IMAGE_SECURITY_DATABASE, 0xC3);
+  SetTestDatabase (EFI_IMAGE_SECURITY_DATABASE1, 0xA1);
+
+  LookupTestImage (&Key);
+  ImageVerificationCacheInsert (&Key);
+  UT_ASSERT_TRUE (LookupTestImage (&Key));
+
+  mTestGetVariableStatus = EFI_DEVICE_ERROR;
+  LoadSignatureDatabases (&Databases);
+  UT_ASSERT_STATUS_EQUAL (Databases.Dbx->Status, EFI_DEVICE_ERROR);
+  UT_ASSERT_FALSE (LookupTestImage (&Key));
+  ImageVerificationCacheInsert (&Key);
+  UT_ASSERT_FALSE (LookupTestImage (&Key));
+
+  mTestGetVariableStatus = EFI_SUCCESS;
+  UT_ASSERT_TRUE (IsTestDigestInDatabase (EFI_IMAGE_SECURITY_DATABASE1, 0xA1));
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Unit test entry point.
+
+  @retval EFI_SUCCESS  The tests ran.
+  @retval Others       The test framework could not be initialized.
+**/
+EFI_STATUS
+EFIAPI
+UefiTestMain (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      SignatureDatabaseTestSuite;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_NAME, UNIT_TEST_VERSION));
+
+  mTestRuntimeServices.GetVariable = TestGetVariable;
+
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_NAME, gEfiCallerBaseName, UNIT_TEST_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed in InitUnitTestFramework. Status = %r\n", UNIT_TEST_NAME, Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&SignatureDatabaseTestSuite, Framework, "SignatureDatabaseTestSuite", "SecurityPkg.DxeImageVerificationLib.SignatureDatabase", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed in CreateUnitTestSuite for SignatureDatabaseTestSuite\n", UNIT_TEST_NAME));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  AddTestCase (SignatureDatabaseTestSuite, "A dbx update of the same size is noticed", "DbxUpdateReloadsDatabase", TestDbxUpdateReloadsDatabase, NULL, ResetTestVariables, NULL);
+  AddTestCase (SignatureDatabaseTestSuite, "An unchanged database is not parsed again", "UnchangedDatabaseIsKept", TestUnchangedDatabaseIsKept, NULL, ResetTestVariables, NULL);
+  AddTestCase (SignatureDatabaseTestSuite, "A dbx update flushes the verification cache", "DbxUpdateFlushesCache", TestDbxUpdateFlushesCache, NULL, ResetTestVariables, NULL);
+  AddTestCase (SignatureDatabaseTestSuite, "An image verified during a dbx update is not remembered", "DbxUpdateDuringVerification", TestDbxUpdateDuringVerification, NULL, ResetTestVariables, NULL);
+  AddTestCase (SignatureDatabaseTestSuite, "An unreadable database fails closed", "ReadErrorFailsClosed", TestReadErrorFailsClosed, NULL, ResetTestVariables, NULL);
+
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework != NULL) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+**/
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  return UefiTestMain ();
+}
@@ -0,0 +1,484 @@
+/** @file
+  Keep the content of db, dbx and dbt between image verifications, with the
+  digests they hold sorted per signature type.
+
+  Every variable is parsed once and its hash entries are sorted, so that the
+  image and certificate digests are looked up by binary search. The variables
+  are still read once per image verification, and parsed again when their
+  content differs from the copy kept, so that no write is missed, whichever
+  SetVariable() pointer or MM handler performed it.
+
+  Caution: This file requires additional review when modified.
+  This library will have external input - signature database content.
+  The signature lists are validated before they are indexed.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "DxeImageVerificationLib.h"
+
+typedef struct {
+  CONST EFI_GUID    *SignatureType;
+  UINTN             DigestSize;
+  //
+  // TRUE if the entries may hold a revocation time after the digest
+  //
+  BOOLEAN           CertHash;
+} SIGNATURE_INDEX_TYPE;
+
+STATIC CONST SIGNATURE_INDEX_TYPE  mSignatureIndexTypes[SIGNATURE_INDEX_TYPE_COUNT] = {
+  { &gEfiCertSha1Guid,       SHA1_DIGEST_SIZE,   FALSE },
+  { &gEfiCertSha224Guid,     28,                 FALSE },
+  { &gEfiCertSha256Guid,     SHA256_DIGEST_SIZE, FALSE },
+  { &gEfiCertSha384Guid,     SHA384_DIGEST_SIZE, FALSE },
+  { &gEfiCertSha512Guid,     SHA512_DIGEST_SIZE, FALSE },
+  { &gEfiCertX509Sha256Guid, SHA256_DIGEST_SIZE, TRUE  },
+  { &gEfiCertX509Sha384Guid, SHA384_DIGEST_SIZE, TRUE  },
+  { &gEfiCertX509Sha512Guid, SHA512_DIGEST_SIZE, TRUE  }
+};
+
+//
+// db, dbx and dbt, in this order
+//
+SIGNATURE_DATABASE  mSignatureDatabases[] = {
+  { EFI_IMAGE_SECURITY_DATABASE  },
+  { EFI_IMAGE_SECURITY_DATABASE1 },
+  { EFI_IMAGE_SECURITY_DATABASE2 }
+};
+
+UINTN  mSignatureDatabaseGeneration = 0;
+
+/**
+  Compare two entries of a signature index by digest, then by position in the
+  variable.
+
+  @param[in]  Buffer1  The first SIGNATURE_INDEX_ENTRY.
+  @param[in]  Buffer2  The second SIGNATURE_INDEX_ENTRY.
+
+  @retval <0  Buffer1 sorts before Buffer2.
+  @retval 0   Buffer1 and Buffer2 are the same entry.
+  @retval >0  Buffer1 sorts after Buffer2.
+**/
+STATIC
+INTN
+EFIAPI
+CompareSignatureIndexEntry (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  CONST SIGNATURE_INDEX_ENTRY  *Entry1;
+  CONST SIGNATURE_INDEX_ENTRY  *Entry2;
+  INTN                         Result;
+
+  Entry1 = (CONST SIGNATURE_INDEX_ENTRY *)Buffer1;
+  Entry2 = (CONST SIGNATURE_INDEX_ENTRY *)Buffer2;
+
+  ASSERT (Entry1->DigestSize == Entry2->DigestSize);
+  Result = CompareMem (Entry1->Data->SignatureData, Entry2->Data->SignatureData, Entry1->DigestSize);
+  if (Result != 0) {
+    return Result;
+  }
+
+  //
+  // Equal digests keep the order of the variable, so that a lookup returns
+  // the first one, as a walk over the variable would.
+  //
+  if ((UINTN)Entry1->Data < (UINTN)Entry2->Data) {
+    return -1;
+  }
+
+  return ((UINTN)Entry1->Data > (UINTN)Entry2->Data) ? 1 : 0;
+}
+
+/**
+  Get the index type of a signature list.
+
+  @param[in]  CertList  The signature list.
+
+  @return The index of the type in mSignatureIndexTypes, or
+          SIGNATURE_INDEX_TYPE_COUNT if the entries of the list are not indexed.
+**/
+STATIC
+UINTN
+GetSignatureIndexType (
+  IN CONST EFI_SIGNATURE_LIST  *CertList
+  )
+{
+  UINTN  Type;
+  UINTN  EntrySize;
+
+  for (Type = 0; Type < SIGNATURE_INDEX_TYPE_COUNT; Type++) {
+    if (CompareGuid (&CertList->SignatureType, mSignatureIndexTypes[Type].SignatureType)) {
+      break;
+    }
+  }
+
+  if (Type == SIGNATURE_INDEX_TYPE_COUNT) {
+    return SIGNATURE_INDEX_TYPE_COUNT;
+  }
+
+  //
+  // A hash list only matches with the exact size of the digest, a certificate
+  // hash list may be followed by the revocation time.
+  //
+  EntrySize = sizeof (EFI_GUID) + mSignatureIndexTypes[Type].DigestSize;
+  if (mSignatureIndexTypes[Type].CertHash ? (CertList->SignatureSize < EntrySize) : (CertList->SignatureSize != EntrySize)) {
+    return SIGNATURE_INDEX_TYPE_COUNT;
+  }
+
+  return Type;
+}
+
+/**
+  Walk the signature lists of a database and collect the entries to index.
+
+  @param[in, out] Database  The database. Entries is filled if not NULL, and
+                            EntryCount is set.
+
+  @retval EFI_SUCCESS            The lists were walked.
+  @retval EFI_SECURITY_VIOLATION A signature list is malformed.
+**/
+STATIC
+EFI_STATUS
+CollectSignatureIndexEntries (
+  IN OUT SIGNATURE_DATABASE  *Database
+  )
+{
+  CONST EFI_SIGNATURE_LIST  *CertList;
+  CONST UINT8               *Cert;
+  UINTN                     Remaining;
+  UINTN                     CertCount;
+  UINTN                     Index;
+  UINTN                     Type;
+  UINTN                     HeaderSize;
+
+  ZeroMem (Database->EntryCount, sizeof (Database->EntryCount));
+
+  CertList  = (CONST EFI_SIGNATURE_LIST *)Database->Data;
+  Remaining = Database->DataSize;
+  while (Remaining > 0) {
+    if ((Remaining < sizeof (EFI_SIGNATURE_LIST)) ||
+        (CertList->SignatureListSize < sizeof (EFI_SIGNATURE_LIST)) ||
+        (CertList->SignatureListSize > Remaining) ||
+        (CertList->SignatureHeaderSize > CertList->SignatureListSize - sizeof (EFI_SIGNATURE_LIST)) ||
+        (CertList->SignatureSize == 0))
+    {
+      return EFI_SECURITY_VIOLATION;
+    }
+
+    HeaderSize = sizeof (EFI_SIGNATURE_LIST) + CertList->SignatureHeaderSize;
+    Type       = GetSignatureIndexType (CertList);
+    if (Type < SIGNATURE_INDEX_TYPE_COUNT) {
+      CertCount = (CertList->SignatureListSize - HeaderSize) / CertList->SignatureSize;
+      Cert      = (CONST UINT8 *)CertList + HeaderSize;
+      for (Index = 0; Index < CertCount; Index++) {
+        if (Database->Entries[Type] != NULL) {
+          Database->Entries[Type][Database->EntryCount[Type]].List       = CertList;
+          Database->Entries[Type][Database->EntryCount[Type]].Data       = (CONST EFI_SIGNATURE_DATA *)Cert;
+          Database->Entries[Type][Database->EntryCount[Type]].DigestSize = mSignatureIndexTypes[Type].DigestSize;
+        }
+
+        Database->EntryCount[Type]++;
+        Cert += CertList->SignatureSize;
+      }
+    }
+
+    Remaining -= CertList->SignatureListSize;
+    CertList   = (CONST EFI_SIGNATURE_LIST *)((CONST UINT8 *)CertList + CertList->SignatureListSize);
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Drop the content of a database.
+
+  @param[in, out] Database  The database.
+**/
+STATIC
+VOID
+UnloadSignatureDatabase (
+  IN OUT SIGNATURE_DATABASE  *Database
+  )
+{
+  UINTN  Type;
+
+  if (Database->Data != NULL) {
+    FreePool (Database->Data);
+  }
+
+  for (Type = 0; Type < SIGNATURE_INDEX_TYPE_COUNT; Type++) {
+    if (Database->Entries[Type] != NULL) {
+      FreePool (Database->Entries[Type]);
+    }
+  }
+
+  Database->Loaded   = FALSE;
+  Database->Status   = EFI_NOT_FOUND;
+  Database->Data     = NULL;
+  Database->DataSize = 0;
+  ZeroMem (Database->Entries, sizeof (Database->Entries));
+  ZeroMem (Database->EntryCount, sizeof (Database->EntryCount));
+}
+
+/**
+  Sort the digests of the content of a database.
+
+  @param[in, out] Database  The database, with Data and DataSize set.
+
+  @retval EFI_SUCCESS    The digests are sorted.
+  @retval Others         The content could not be indexed.
+**/
+STATIC
+EFI_STATUS
+IndexSignatureDatabase (
+  IN OUT SIGNATURE_DATABASE  *Database
+  )
+{
+  EFI_STATUS             Status;
+  UINTN                  Type;
+  SIGNATURE_INDEX_ENTRY  Swap;
+
+  //
+  // Count the entries, then collect them.
+  //
+  Status = CollectSignatureIndexEntries (Database);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "DxeImageVerificationLib: Malformed signature list in %s.\n", Database->VariableName));
+    return Status;
+  }
+
+  for (Type = 0; Type < SIGNATURE_INDEX_TYPE_COUNT; Type++) {
+    if (Database->EntryCount[Type] != 0) {
+      Database->Entries[Type] = AllocatePool (Database->EntryCount[Type] * sizeof (SIGNATURE_INDEX_ENTRY));
+      if (Database->Entries[Type] == NULL) {
+        return EFI_OUT_OF_RESOURCES;
+      }
+    }
+  }
+
+  CollectSignatureIndexEntries (Database);
+
+  for (Type = 0; Type < SIGNATURE_INDEX_TYPE_COUNT; Type++) {
+    if (Database->EntryCount[Type] > 1) {
+      QuickSort (
+        Database->Entries[Type],
+        Database->EntryCount[Type],
+        sizeof (SIGNATURE_INDEX_ENTRY),
+        CompareSignatureIndexEntry,
+        &Swap
+        );
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Read a database variable.
+
+  @param[in]  VariableName  The name of the variable.
+  @param[out] Data          The content of the variable, to free with
+                            FreePool(), or NULL if it could not be read.
+  @param[out] DataSize      The size of Data, in bytes.
+
+  @retval EFI_SUCCESS    The variable is read.
+  @retval EFI_NOT_FOUND  The variable does not exist.
+  @retval Others         The variable could not be read.
+**/
+STATIC
+EFI_STATUS
+ReadSignatureDatabaseVariable (
+  IN  CHAR16  *VariableName,
+  OUT UINT8   **Data,
+  OUT UINTN   *DataSize
+  )
+{
+  EFI_STATUS  Status;
+
+  *Data     = NULL;
+  *DataSize = 0;
+  Status    = gRT->GetVariable (VariableName, &gEfiImageSecurityDatabaseGuid, NULL, DataSize, NULL);
+  if (Status == EFI_NOT_FOUND) {
+    return EFI_NOT_FOUND;
+  }
+
+  if (Status != EFI_BUFFER_TOO_SMALL) {
+    return EFI_ERROR (Status) ? Status : EFI_DEVICE_ERROR;
+  }
+
+  *Data = AllocatePool (*DataSize);
+  if (*Data == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // The variable may have grown since its size was read, which fails here.
+  //
+  Status = gRT->GetVariable (VariableName, &gEfiImageSecurityDatabaseGuid, NULL, DataSize, *Data);
+  if (EFI_ERROR (Status)) {
+    FreePool (*Data);
+    *Data = NULL;
+  }
+
+  return Status;
+}
+
+/**
+  Read a database variable, and sort its digests again if its content differs
+  from the content kept since the last call.
+
+  The generation is bumped whenever the database is parsed again or cannot
+  be read, so that the verification cache never outlives a change.
+
+  @param[in, out] Database  The database. Status is set to EFI_SUCCESS,
+                            EFI_NOT_FOUND if the variable does not exist, or
+                            the error that prevented reading or indexing it.
+**/
+STATIC
+VOID
+RevalidateSignatureDatabase (
+  IN OUT SIGNATURE_DATABASE  *Database
+  )
+{
+  EFI_STATUS  Status;
+  UINT8       *Data;
+  UINTN       DataSize;
+
+  Status = ReadSignatureDatabaseVariable (Database->VariableName, &Data, &DataSize);
+  if (EFI_ERROR (Status) && (Status != EFI_NOT_FOUND)) {
+    UnloadSignatureDatabase (Database);
+    mSignatureDatabaseGeneration++;
+    Database->Status = Status;
+    return;
+  }
+
+  //
+  // The parsed content is kept for the lookups, so compare with it rather
+  // than with a digest of it.
+  //
+  if (Database->Loaded &&
+      (Database->Status == Status) &&
+      (Database->DataSize == DataSize) &&
+      (CompareMem (Database->Data, Data, DataSize) == 0))
+  {
+    if (Data != NULL) {
+      FreePool (Data);
+    }
+
+    return;
+  }
+
+  UnloadSignatureDatabase (Database);
+  mSignatureDatabaseGeneration++;
+
+  Database->Data     = Data;
+  Database->DataSize = DataSize;
+  if (Status == EFI_SUCCESS) {
+    Status = IndexSignatureDatabase (Database);
+    if (EFI_ERROR (Status)) {
+      UnloadSignatureDatabase (Database);
+      Database->Status = Status;
+      return;
+    }
+  }
+
+  Database->Loaded = TRUE;
+  Database->Status = Status;
+}
+
+/**
+  Get db, dbx and dbt for an image verification.
+
+  Every variable is read once per call, and parsed again only when it
+  changed. The returned databases stay valid until the next call.
+
+  @param[out] Databases  The databases and their generation.
+**/
+VOID
+LoadSignatureDatabases (
+  OUT SIGNATURE_DATABASES  *Databases
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < ARRAY_SIZE (mSignatureDatabases); Index++) {
+    RevalidateSignatureDatabase (&mSignatureDatabases[Index]);
+  }
+
+  Databases->Db         = &mSignatureDatabases[0];
+  Databases->Dbx        = &mSignatureDatabases[1];
+  Databases->Dbt        = &mSignatureDatabases[2];
+  Databases->Generation = mSignatureDatabaseGeneration;
+}
+
+/**
+  Look up a digest in a security database.
+
+  @param[in]  Database       The database.
+  @param[in]  SignatureType  The type of the signature lists to look in.
+  @param[in]  Digest         The digest.
+  @param[in]  DigestSize     The size of the digest, in bytes.
+  @param[out] Entry          The first entry with the digest, in the order of
+                             the variable.
+
+  @retval EFI_SUCCESS       The digest is found.
+  @retval EFI_NOT_FOUND     The digest is not found.
+  @retval EFI_UNSUPPORTED   The digests of SignatureType are not indexed, or
+                            DigestSize does not match SignatureType.
+**/
+EFI_STATUS
+FindSignatureDigest (
+  IN  CONST SIGNATURE_DATABASE     *Database,
+  IN  CONST EFI_GUID               *SignatureType,
+  IN  CONST UINT8                  *Digest,
+  IN  UINTN                        DigestSize,
+  OUT CONST SIGNATURE_INDEX_ENTRY  **Entry OPTIONAL
+  )
+{
+  UINTN                        Type;
+  UINTN                        Low;
+  UINTN                        High;
+  UINTN                        Middle;
+  CONST SIGNATURE_INDEX_ENTRY  *Entries;
+
+  for (Type = 0; Type < SIGNATURE_INDEX_TYPE_COUNT; Type++) {
+    if (CompareGuid (SignatureType, mSignatureIndexTypes[Type].SignatureType)) {
+      break;
+    }
+  }
+
+  if ((Type == SIGNATURE_INDEX_TYPE_COUNT) || (DigestSize != mSignatureIndexTypes[Type].DigestSize)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Find the first entry that is not lower than the digest.
+  //
+  Entries = Database->Entries[Type];
+  Low     = 0;
+  High    = Database->EntryCount[Type];
+  while (Low < High) {
+    Middle = Low + (High - Low) / 2;
+    if (CompareMem (Entries[Middle].Data->SignatureData, Digest, DigestSize) < 0) {
+      Low = Middle + 1;
+    } else {
+      High = Middle;
+    }
+  }
+
+  if ((Low == Database->EntryCount[Type]) ||
+      (CompareMem (Entries[Low].Data->SignatureData, Digest, DigestSize) != 0))
+  {
+    return EFI_NOT_FOUND;
+  }
+
+  if (Entry != NULL) {
+    *Entry = &Entries[Low];
+  }
+
+  return EFI_SUCCESS;
+}
@@ -30,6 +30,12 @@ UINTN           mHashInterfaceCount = 0;
 UINT32  mSupportedHashMaskLast    = 0;
 UINT32  mSupportedHashMaskCurrent = 0;
 
+//
+// HashUpdate() passes large data to the hash interfaces in blocks of this
+// size, so that every bank hashes a block while it is still in the cache.
+//
+#define HASH_UPDATE_BLOCK_SIZE  SIZE_16KB
+
 /**
   Check mismatch of supported HashMask between modules
   that may link different HashInstanceLib instances.
@@ -112,6 +118,9 @@ HashUpdate (
   HASH_HANDLE  *HashCtx;
   UINTN        Index;
   UINT32       HashMask;
+  BOOLEAN      Active[HASH_COUNT];
+  UINT8        *Block;
+  UINTN        BlockSize;
 
   if (mHashInterfaceCount == 0) {
     return FALSE;
@@ -122,12 +131,28 @@ HashUpdate (
   HashCtx = (HASH_HANDLE *)HashHandle;
 
   for (Index = 0; Index < mHashInterfaceCount; Index++) {
-    HashMask = Tpm2GetHashMaskFromAlgo (&mHashInterface[Index].HashGuid);
-    if ((HashMask & PcdGet32 (PcdTpm2HashMask)) != 0) {
-      mHashInterface[Index].HashUpdate (HashCtx[Index], DataToHash, DataToHashLen);
-    }
+    HashMask      = Tpm2GetHashMaskFromAlgo (&mHashInterface[Index].HashGuid);
+    Active[Index] = (HashMask & PcdGet32 (PcdTpm2HashMask)) != 0;
   }
 
+  //
+  // Hash the data block by block with every bank, instead of bank by bank
+  // over the whole data, so that an image measured into several banks is
+  // read from memory once.
+  //
+  Block = (UINT8 *)DataToHash;
+  do {
+    BlockSize = MIN (DataToHashLen, HASH_UPDATE_BLOCK_SIZE);
+    for (Index = 0; Index < mHashInterfaceCount; Index++) {
+      if (Active[Index]) {
+        mHashInterface[Index].HashUpdate (HashCtx[Index], Block, BlockSize);
+      }
+    }
+
+    Block         += BlockSize;
+    DataToHashLen -= BlockSize;
+  } while (DataToHashLen > 0);
+
   return EFI_SUCCESS;
 }
 
@@ -141,4 +141,88 @@ PageTableParse (
   IN OUT UINTN           *MapCount
   );
 
+/**
+  Create or update page table to map multiple linear address ranges with specified attributes.
+
+  The ranges are applied in one pass over the array. Neighbouring ranges that continue each other
+  with the same attributes are merged, so each merged range costs one walk of the page table
+  instead of one walk per array entry.
+
+  @param[in, out] PageTable      The pointer to the page table to update, or pointer to NULL if a new page table is to be created.
+                                 If not pointer to NULL, the value it points to won't be changed in this function.
+  @param[in]      PagingMode     The paging mode.
+  @param[in]      Buffer         The free buffer to be used for page table creation/updating.
+  @param[in, out] BufferSize     The buffer size.
+                                 On return, the remaining buffer size.
+                                 The free buffer is used from the end so caller can supply the same Buffer pointer with an updated
+                                 BufferSize in the second call to this API.
+  @param[in]      Ranges         Pointer to an array of linear address ranges and their attributes.
+                                 The ranges must be sorted by LinearAddress and must not overlap. Entries with zero Length are ignored.
+                                 All non-reserved fields in IA32_MAP_ATTRIBUTE are supported to set in the page table.
+  @param[in]      RangeCount     The number of entries in Ranges.
+  @param[in]      Mask           The mask used for the attribute of all ranges. The corresponding field in the attribute is ignored
+                                 if that in Mask is 0.
+  @param[out]     IsModified     TRUE means page table is modified by software or hardware. FALSE means page table is not modified by software.
+                                 If the output IsModified is FALSE, there is possibility that the page table is changed by hardware. It is ok
+                                 because page table can be changed by hardware anytime, and caller don't need to Flush TLB.
+
+  @retval RETURN_UNSUPPORTED        PagingMode is not supported.
+  @retval RETURN_INVALID_PARAMETER  PageTable, BufferSize or Mask is NULL, or Ranges is NULL while RangeCount is not 0.
+  @retval RETURN_INVALID_PARAMETER  The ranges are not sorted, overlap, or are not aligned on 4KB.
+  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 0 but some other attributes are provided.
+  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, the attribute has Present set but some other attributes are not provided.
+  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, the attribute has Present clear but some other attributes are provided.
+  @retval RETURN_INVALID_PARAMETER  For present range, Mask->Bits.Present is 1, the attribute has Present clear but some other attributes are provided.
+  @retval RETURN_INVALID_PARAMETER  *BufferSize is not multiple of 4KB.
+  @retval RETURN_BUFFER_TOO_SMALL   The buffer is too small for page table creation/updating.
+                                    BufferSize is updated to indicate the expected buffer size.
+                                    The expected size is computed for every range against the page table before any range is applied,
+                                    so part of the buffer may remain unused on success.
+  @retval RETURN_SUCCESS            PageTable is created/updated successfully or all ranges have zero Length.
+**/
+RETURN_STATUS
+EFIAPI
+PageTableMapRanges (
+  IN OUT UINTN                 *PageTable  OPTIONAL,
+  IN     PAGING_MODE           PagingMode,
+  IN     VOID                  *Buffer,
+  IN OUT UINTN                 *BufferSize,
+  IN     CONST IA32_MAP_ENTRY  *Ranges,
+  IN     UINTN                 RangeCount,
+  IN     IA32_MAP_ATTRIBUTE    *Mask,
+  OUT    BOOLEAN               *IsModified   OPTIONAL
+  );
+
+/**
+  Compact the page table by replacing page tables that map a uniform region with
+  one 2M or 1G leaf entry.
+
+  A page table is replaced when all its 512 entries are present leaf entries with the same
+  attribute that map a physically contiguous region aligned on the size of the new leaf entry.
+  The mapping returned by PageTableParse() doesn't change, but the number of page table
+  entries walked by the hardware and by PageTableMap() decreases.
+
+  The caller must flush the TLB when IsModified is TRUE, and must not reuse the pages in
+  FreePageList before the TLB is flushed.
+
+  @param[in]      PageTable     The page table to compact.
+  @param[in]      PagingMode    The paging mode.
+  @param[in, out] FreePageList  Optional. On input, the head of a list of free pages, or NULL for an empty list.
+                                On output, the page tables that are no longer referenced are added to the head of the list.
+                                The first UINTN of every page in the list holds the address of the next page.
+                                When FreePageList is NULL, the unreferenced page tables are not touched.
+  @param[out]     IsModified    TRUE means page table is modified by software. FALSE means page table is not modified by software.
+
+  @retval RETURN_UNSUPPORTED        PagingMode is not supported.
+  @retval RETURN_SUCCESS            PageTable is compacted successfully or PageTable is 0.
+**/
+RETURN_STATUS
+EFIAPI
+PageTableCompact (
+  IN     UINTN        PageTable,
+  IN     PAGING_MODE  PagingMode,
+  IN OUT VOID         **FreePageList  OPTIONAL,
+  OUT    BOOLEAN      *IsModified     OPTIONAL
+  );
+
 #endif
@@ -0,0 +1,84 @@
+/** @file
+  This file declares EDKII MP work queue protocol.
+
+  The protocol extends EFI_MP_SERVICES_PROTOCOL with a work queue mode: the
+  caller passes an array of small tasks, and all enabled CPUs including the
+  BSP pull tasks from a shared queue until it is empty. This avoids one
+  StartupAllAPs() round trip per task when a large number of short, independent
+  operations has to be spread over many processors.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef EDKII_MP_WORK_QUEUE_PROTOCOL_H_
+#define EDKII_MP_WORK_QUEUE_PROTOCOL_H_
+
+#include <Protocol/MpService.h>
+
+#define EDKII_MP_WORK_QUEUE_PROTOCOL_GUID \
+  { \
+    0x7ce6deb1, 0x37cc, 0x400a, { 0xb1, 0x2b, 0x84, 0x9d, 0x97, 0xe1, 0xea, 0x32 } \
+  }
+
+typedef struct _EDKII_MP_WORK_QUEUE_PROTOCOL EDKII_MP_WORK_QUEUE_PROTOCOL;
+
+///
+/// One task of the work queue.
+///
+typedef struct {
+  ///
+  /// The function to run. It must be MP safe and must not call MP services.
+  ///
+  EFI_AP_PROCEDURE    Procedure;
+  ///
+  /// The parameter passed into Procedure.
+  ///
+  VOID                *Argument;
+} EDKII_MP_TASK;
+
+/**
+  Run an array of tasks on all enabled CPUs.
+
+  All enabled CPUs including the BSP take tasks from the array in an
+  unspecified order until every task has been taken, so each task runs exactly
+  once on one of the CPUs. The function returns once all tasks have finished
+  or the timeout expired.
+
+  @param[in]  This                   A pointer to the EDKII_MP_WORK_QUEUE_PROTOCOL instance.
+  @param[in]  Tasks                  The tasks to run.
+  @param[in]  TaskCount              The number of entries in Tasks.
+  @param[in]  TimeoutInMicroseconds  Indicates the time limit in microseconds for
+                                     APs to finish their tasks. Zero means
+                                     infinity. TimeoutInMicroseconds is ignored
+                                     for BSP.
+  @param[out] FailedCpuList          If not NULL and the timeout expired, the list
+                                     of APs that did not finish, terminated by
+                                     END_OF_CPU_LIST. The buffer is allocated by
+                                     the service and must be freed by the caller.
+
+  @retval EFI_SUCCESS             All tasks have finished before the timeout expired.
+  @retval EFI_DEVICE_ERROR        Caller processor is AP.
+  @retval EFI_NOT_READY           Any enabled APs are busy.
+  @retval EFI_TIMEOUT             The timeout expired before all enabled APs have finished.
+  @retval EFI_INVALID_PARAMETER   Tasks is NULL, TaskCount is zero or too large,
+                                  or a task has no Procedure.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_MP_WORK_QUEUE_STARTUP_ALL_CPUS)(
+  IN  EDKII_MP_WORK_QUEUE_PROTOCOL  *This,
+  IN  CONST EDKII_MP_TASK           *Tasks,
+  IN  UINTN                         TaskCount,
+  IN  UINTN                         TimeoutInMicroseconds,
+  OUT UINTN                         **FailedCpuList         OPTIONAL
+  );
+
+struct _EDKII_MP_WORK_QUEUE_PROTOCOL {
+  EDKII_MP_WORK_QUEUE_STARTUP_ALL_CPUS    StartupAllCPUs;
+};
+
+extern EFI_GUID  gEdkiiMpWorkQueueProtocolGuid;
+
+#endif
@@ -22,6 +22,10 @@ EFI_MP_SERVICES_PROTOCOL  mMpServicesTemplate = {
   WhoAmI
 };
 
+EDKII_MP_WORK_QUEUE_PROTOCOL  mMpWorkQueueTemplate = {
+  StartupAllCPUsWorkQueue
+};
+
 /**
   This service retrieves the number of logical processor in the platform
   and the number of those logical processors that are enabled on this boot.
@@ -512,6 +516,52 @@ WhoAmI (
   return MpInitLibWhoAmI (ProcessorNumber);
 }
 
+/**
+  Run an array of tasks on all enabled CPUs.
+
+  All enabled CPUs including the BSP take tasks from the array in an
+  unspecified order until every task has been taken, so each task runs exactly
+  once on one of the CPUs. The function returns once all tasks have finished
+  or the timeout expired.
+
+  @param[in]  This                   A pointer to the EDKII_MP_WORK_QUEUE_PROTOCOL instance.
+  @param[in]  Tasks                  The tasks to run.
+  @param[in]  TaskCount              The number of entries in Tasks.
+  @param[in]  TimeoutInMicroseconds  Indicates the time limit in microseconds for
+                                     APs to finish their tasks. Zero means
+                                     infinity. TimeoutInMicroseconds is ignored
+                                     for BSP.
+  @param[out] FailedCpuList          If not NULL and the timeout expired, the list
+                                     of APs that did not finish, terminated by
+                                     END_OF_CPU_LIST. The buffer is allocated by
+                                     the service and must be freed by the caller.
+
+  @retval EFI_SUCCESS             All tasks have finished before the timeout expired.
+  @retval EFI_DEVICE_ERROR        Caller processor is AP.
+  @retval EFI_NOT_READY           Any enabled APs are busy.
+  @retval EFI_TIMEOUT             The timeout expired before all enabled APs have finished.
+  @retval EFI_INVALID_PARAMETER   Tasks is NULL, TaskCount is zero or too large,
+                                  or a task has no Procedure.
+
+**/
+EFI_STATUS
+EFIAPI
+StartupAllCPUsWorkQueue (
+  IN  EDKII_MP_WORK_QUEUE_PROTOCOL  *This,
+  IN  CONST EDKII_MP_TASK           *Tasks,
+  IN  UINTN                         TaskCount,
+  IN  UINTN                         TimeoutInMicroseconds,
+  OUT UINTN                         **FailedCpuList         OPTIONAL
+  )
+{
+  return MpInitLibStartupAllCPUsWorkQueue (
+           Tasks,
+           TaskCount,
+           TimeoutInMicroseconds,
+           FailedCpuList
+           );
+}
+
 /**
   Initialize Multi-processor support.
 **/
@@ -538,6 +588,8 @@ InitializeMpSupport (
                   &mMpServiceHandle,
                   &gEfiMpServiceProtocolGuid,
                   &mMpServicesTemplate,
+                  &gEdkiiMpWorkQueueProtocolGuid,
+                  &mMpWorkQueueTemplate,
                   NULL
                   );
   ASSERT_EFI_ERROR (Status);
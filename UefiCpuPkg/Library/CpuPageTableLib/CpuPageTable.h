@@ -216,6 +216,20 @@ PageTableLibGetPleBMapAttribute (
   IN IA32_MAP_ATTRIBUTE                 *ParentMapAttribute
   );
 
+/**
+  Return the attribute of a 4K page table entry.
+
+  @param[in] Pte4K              Pointer to a 4K page table entry.
+  @param[in] ParentMapAttribute Pointer to the parent attribute.
+
+  @return Attribute of the 4K page table entry.
+**/
+UINT64
+PageTableLibGetPte4KMapAttribute (
+  IN IA32_PTE_4K         *Pte4K,
+  IN IA32_MAP_ATTRIBUTE  *ParentMapAttribute
+  );
+
 /**
   Return the attribute of a non-leaf page table entry.
 
@@ -230,4 +244,42 @@ PageTableLibGetPnleMapAttribute (
   IN IA32_MAP_ATTRIBUTE        *ParentMapAttribute
   );
 
+/**
+  Set the IA32_PDPTE_1G or IA32_PDE_2M.
+
+  @param[in] PleB      Pointer to PDPTE_1G or PDE_2M. Both share the same structure definition.
+  @param[in] Offset    The offset within the linear address range.
+  @param[in] Attribute The attribute of the linear address range.
+                       All non-reserved fields in IA32_MAP_ATTRIBUTE are supported to set in the page table.
+                       Page table entry is reset to 0 before set to the new attribute when a new physical base address is set.
+  @param[in] Mask      The mask used for attribute. The corresponding field in Attribute is ignored if that in Mask is 0.
+**/
+VOID
+PageTableLibSetPleB (
+  IN OUT volatile IA32_PAGE_LEAF_ENTRY_BIG_PAGESIZE  *PleB,
+  IN UINT64                                          Offset,
+  IN IA32_MAP_ATTRIBUTE                              *Attribute,
+  IN IA32_MAP_ATTRIBUTE                              *Mask
+  );
+
+/**
+  Return the number of leading entries of Ranges that can be applied as one contiguous
+  range by a single walk of the page table.
+
+  Two neighbouring entries are merged when the second one starts where the first one ends,
+  both in the linear and in the physical address space, and both have the same attributes.
+
+  @param[in]  Ranges      Pointer to an array of linear address ranges.
+  @param[in]  RangeCount  The number of entries in Ranges. Must not be 0.
+  @param[out] Length      Return the length of the merged linear address range.
+
+  @return The number of entries merged into the range starting at Ranges[0].
+**/
+UINTN
+PageTableLibMergeRanges (
+  IN     CONST IA32_MAP_ENTRY  *Ranges,
+  IN     UINTN                 RangeCount,
+  OUT    UINT64                *Length
+  );
+
 #endif
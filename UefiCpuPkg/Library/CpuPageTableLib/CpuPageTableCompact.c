@@ -0,0 +1,221 @@
+/** @file
+  This library implements CpuPageTableLib that are generic for IA32 family CPU.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "CpuPageTable.h"
+
+/**
+  Check if the 512 page table entries in the specified level can be replaced by one leaf entry
+  in the level above.
+
+  That is the case when all entries are present leaf entries with the same attribute, and they
+  map a physically contiguous region that is aligned on the region length of the level above.
+
+  @param[in]  PageTableBaseAddress The base address of the 512 page table entries in the specified level.
+  @param[in]  Level                Page level of the entries. Could be 2 or 1.
+  @param[in]  ParentMapAttribute   The mapping attribute of the parent entry.
+  @param[out] MapAttribute         Return the mapping attribute of the whole region when TRUE is returned.
+
+  @retval TRUE  The entries can be replaced by one leaf entry.
+  @retval FALSE The entries cannot be replaced by one leaf entry.
+**/
+BOOLEAN
+PageTableLibIsUniformTable (
+  IN     UINT64              PageTableBaseAddress,
+  IN     UINTN               Level,
+  IN     IA32_MAP_ATTRIBUTE  *ParentMapAttribute,
+  OUT    IA32_MAP_ATTRIBUTE  *MapAttribute
+  )
+{
+  IA32_PAGING_ENTRY   *PagingEntry;
+  IA32_MAP_ATTRIBUTE  EntryAttribute;
+  UINT64              RegionLength;
+  UINTN               Index;
+
+  ASSERT (Level == 1 || Level == 2);
+
+  PagingEntry  = (IA32_PAGING_ENTRY *)(UINTN)PageTableBaseAddress;
+  RegionLength = REGION_LENGTH (Level);
+
+  for (Index = 0; Index < 512; Index++) {
+    if ((PagingEntry[Index].Pce.Present == 0) || !IsPle (&PagingEntry[Index], Level)) {
+      return FALSE;
+    }
+
+    if (Level == 1) {
+      EntryAttribute.Uint64 = PageTableLibGetPte4KMapAttribute (&PagingEntry[Index].Pte4K, ParentMapAttribute);
+    } else {
+      EntryAttribute.Uint64 = PageTableLibGetPleBMapAttribute (&PagingEntry[Index].PleB, ParentMapAttribute);
+    }
+
+    if (Index == 0) {
+      MapAttribute->Uint64 = EntryAttribute.Uint64;
+      if ((IA32_MAP_ATTRIBUTE_PAGE_TABLE_BASE_ADDRESS (MapAttribute) & (REGION_LENGTH (Level + 1) - 1)) != 0) {
+        return FALSE;
+      }
+    } else if ((IA32_MAP_ATTRIBUTE_ATTRIBUTES (&EntryAttribute) != IA32_MAP_ATTRIBUTE_ATTRIBUTES (MapAttribute)) ||
+               (IA32_MAP_ATTRIBUTE_PAGE_TABLE_BASE_ADDRESS (&EntryAttribute)
+                != IA32_MAP_ATTRIBUTE_PAGE_TABLE_BASE_ADDRESS (MapAttribute) + MultU64x32 (RegionLength, (UINT32)Index)))
+    {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Recursively compact the non-leaf page table entries.
+
+  Page tables are visited bottom-up, so 4K pages merged into a 2M page can take part
+  in forming a 1G page in the same pass.
+
+  @param[in]      PageTableBaseAddress The base address of the 512 page table entries in the specified level.
+  @param[in]      Level                Page level. Could be 5, 4, 3, 2.
+  @param[in]      MaxLevel             Max page level.
+  @param[in]      MaxLeafLevel         Maximum level that can be a leaf entry. Could be 1, 2 or 3 (if Page 1G is supported).
+  @param[in]      ParentMapAttribute   The mapping attribute of the parent entries.
+  @param[in, out] FreePageList         Head of the list of page tables that are no longer referenced, or NULL.
+  @param[in, out] IsModified           Change IsModified to TRUE if page table is modified.
+**/
+VOID
+PageTableLibCompactPnle (
+  IN     UINT64              PageTableBaseAddress,
+  IN     UINTN               Level,
+  IN     UINTN               MaxLevel,
+  IN     UINTN               MaxLeafLevel,
+  IN     IA32_MAP_ATTRIBUTE  *ParentMapAttribute,
+  IN OUT VOID                **FreePageList OPTIONAL,
+  IN OUT BOOLEAN             *IsModified
+  )
+{
+  IA32_PAGING_ENTRY   *PagingEntry;
+  IA32_PAGING_ENTRY   LocalPagingEntry;
+  IA32_MAP_ATTRIBUTE  MapAttribute;
+  IA32_MAP_ATTRIBUTE  LeafAttribute;
+  IA32_MAP_ATTRIBUTE  AllOneMask;
+  UINT64              ChildPageTable;
+  UINTN               Index;
+  UINTN               PagingEntryNumber;
+
+  ASSERT (Level > 1);
+
+  AllOneMask.Uint64 = ~0ull;
+  PagingEntry       = (IA32_PAGING_ENTRY *)(UINTN)PageTableBaseAddress;
+  PagingEntryNumber = ((MaxLevel == 3) && (Level == 3)) ? MAX_PAE_PDPTE_NUM : 512;
+
+  for (Index = 0; Index < PagingEntryNumber; Index++) {
+    if ((PagingEntry[Index].Pce.Present == 0) || IsPle (&PagingEntry[Index], Level)) {
+      continue;
+    }
+
+    LocalPagingEntry.Uint64 = PagingEntry[Index].Uint64;
+    if ((MaxLevel == 3) && (Level == 3)) {
+      //
+      // PAE PDPTE doesn't have ReadWrite, UserSupervisor and Nx bits.
+      //
+      LocalPagingEntry.Pnle.Bits.ReadWrite      = 1;
+      LocalPagingEntry.Pnle.Bits.UserSupervisor = 1;
+      LocalPagingEntry.Pnle.Bits.Nx             = 0;
+    }
+
+    MapAttribute.Uint64 = PageTableLibGetPnleMapAttribute (&LocalPagingEntry.Pnle, ParentMapAttribute);
+    ChildPageTable      = IA32_PNLE_PAGE_TABLE_BASE_ADDRESS (&LocalPagingEntry.Pnle);
+
+    if (Level - 1 > 1) {
+      PageTableLibCompactPnle (ChildPageTable, Level - 1, MaxLevel, MaxLeafLevel, &MapAttribute, FreePageList, IsModified);
+    }
+
+    if ((Level > MaxLeafLevel) || !PageTableLibIsUniformTable (ChildPageTable, Level - 1, &MapAttribute, &LeafAttribute)) {
+      continue;
+    }
+
+    //
+    // The leaf attribute already includes the restrictions inherited from all parents,
+    // so it can be set to the new leaf entry as is.
+    //
+    LocalPagingEntry.Uint64 = 0;
+    PageTableLibSetPleB (&LocalPagingEntry.PleB, 0, &LeafAttribute, &AllOneMask);
+    PagingEntry[Index].Uint64 = LocalPagingEntry.Uint64;
+    *IsModified               = TRUE;
+
+    if (FreePageList != NULL) {
+      //
+      // Link the child page table after it's unreferenced. The link is 4KB aligned,
+      // so the first entry stays non-present for stale walks until TLB is flushed.
+      //
+      *(VOID **)(UINTN)ChildPageTable = *FreePageList;
+      *FreePageList                   = (VOID *)(UINTN)ChildPageTable;
+    }
+  }
+}
+
+/**
+  Compact the page table by replacing page tables that map a uniform region with
+  one 2M or 1G leaf entry.
+
+  A page table is replaced when all its 512 entries are present leaf entries with the same
+  attribute that map a physically contiguous region aligned on the size of the new leaf entry.
+  The mapping returned by PageTableParse() doesn't change, but the number of page table
+  entries walked by the hardware and by PageTableMap() decreases.
+
+  The caller must flush the TLB when IsModified is TRUE, and must not reuse the pages in
+  FreePageList before the TLB is flushed.
+
+  @param[in]      PageTable     The page table to compact.
+  @param[in]      PagingMode    The paging mode.
+  @param[in, out] FreePageList  Optional. On input, the head of a list of free pages, or NULL for an empty list.
+                                On output, the page tables that are no longer referenced are added to the head of the list.
+                                The first UINTN of every page in the list holds the address of the next page.
+                                When FreePageList is NULL, the unreferenced page tables are not touched.
+  @param[out]     IsModified    TRUE means page table is modified by software. FALSE means page table is not modified by software.
+
+  @retval RETURN_UNSUPPORTED        PagingMode is not supported.
+  @retval RETURN_SUCCESS            PageTable is compacted successfully or PageTable is 0.
+**/
+RETURN_STATUS
+EFIAPI
+PageTableCompact (
+  IN     UINTN        PageTable,
+  IN     PAGING_MODE  PagingMode,
+  IN OUT VOID         **FreePageList  OPTIONAL,
+  OUT    BOOLEAN      *IsModified     OPTIONAL
+  )
+{
+  IA32_MAP_ATTRIBUTE  NopAttribute;
+  BOOLEAN             LocalIsModified;
+  UINTN               MaxLevel;
+  UINTN               MaxLeafLevel;
+
+  if ((PagingMode == Paging32bit) || (PagingMode >= PagingModeMax)) {
+    //
+    // 32bit paging is never supported.
+    //
+    return RETURN_UNSUPPORTED;
+  }
+
+  if (IsModified == NULL) {
+    IsModified = &LocalIsModified;
+  }
+
+  *IsModified = FALSE;
+
+  if (PageTable == 0) {
+    return RETURN_SUCCESS;
+  }
+
+  NopAttribute.Uint64              = 0;
+  NopAttribute.Bits.Present        = 1;
+  NopAttribute.Bits.ReadWrite      = 1;
+  NopAttribute.Bits.UserSupervisor = 1;
+
+  MaxLeafLevel = (UINT8)PagingMode;
+  MaxLevel     = (UINT8)(PagingMode >> 8);
+  PageTableLibCompactPnle ((UINT64)PageTable, MaxLevel, MaxLevel, MaxLeafLevel, &NopAttribute, FreePageList, IsModified);
+
+  return RETURN_SUCCESS;
+}
@@ -643,7 +643,53 @@ PageTableLibMapInLevel (
 }
 
 /**
-  Create or update page table to map [LinearAddress, LinearAddress + Length) with specified attribute.
+  Return the number of leading entries of Ranges that can be applied as one contiguous
+  range by a single walk of the page table.
+
+  Two neighbouring entries are merged when the second one starts where the first one ends,
+  both in the linear and in the physical address space, and both have the same attributes.
+
+  @param[in]  Ranges      Pointer to an array of linear address ranges.
+  @param[in]  RangeCount  The number of entries in Ranges. Must not be 0.
+  @param[out] Length      Return the length of the merged linear address range.
+
+  @return The number of entries merged into the range starting at Ranges[0].
+**/
+UINTN
+PageTableLibMergeRanges (
+  IN     CONST IA32_MAP_ENTRY  *Ranges,
+  IN     UINTN                 RangeCount,
+  OUT    UINT64                *Length
+  )
+{
+  UINTN  Index;
+
+  ASSERT (RangeCount != 0);
+
+  *Length = Ranges[0].Length;
+  for (Index = 1; Index < RangeCount; Index++) {
+    if ((Ranges[Index].Length == 0) ||
+        (Ranges[0].LinearAddress + *Length != Ranges[Index].LinearAddress) ||
+        (IA32_MAP_ATTRIBUTE_PAGE_TABLE_BASE_ADDRESS (&Ranges[0].Attribute) + *Length
+         != IA32_MAP_ATTRIBUTE_PAGE_TABLE_BASE_ADDRESS (&Ranges[Index].Attribute)) ||
+        (IA32_MAP_ATTRIBUTE_ATTRIBUTES (&Ranges[0].Attribute) != IA32_MAP_ATTRIBUTE_ATTRIBUTES (&Ranges[Index].Attribute))
+        )
+    {
+      break;
+    }
+
+    *Length += Ranges[Index].Length;
+  }
+
+  return Index;
+}
+
+/**
+  Create or update page table to map multiple linear address ranges with specified attributes.
+
+  The ranges are applied in one pass over the array. Neighbouring ranges that continue each other
+  with the same attributes are merged, so each merged range costs one walk of the page table
+  instead of one walk per array entry.
 
   @param[in, out] PageTable      The pointer to the page table to update, or pointer to NULL if a new page table is to be created.
                                  If not pointer to NULL, the value it points to won't be changed in this function.
@@ -653,59 +699,60 @@ PageTableLibMapInLevel (
                                  On return, the remaining buffer size.
                                  The free buffer is used from the end so caller can supply the same Buffer pointer with an updated
                                  BufferSize in the second call to this API.
-  @param[in]      LinearAddress  The start of the linear address range.
-  @param[in]      Length         The length of the linear address range.
-  @param[in]      Attribute      The attribute of the linear address range.
+  @param[in]      Ranges         Pointer to an array of linear address ranges and their attributes.
+                                 The ranges must be sorted by LinearAddress and must not overlap. Entries with zero Length are ignored.
                                  All non-reserved fields in IA32_MAP_ATTRIBUTE are supported to set in the page table.
-                                 Page table entries that map the linear address range are reset to 0 before set to the new attribute
-                                 when a new physical base address is set.
-  @param[in]      Mask           The mask used for attribute. The corresponding field in Attribute is ignored if that in Mask is 0.
+  @param[in]      RangeCount     The number of entries in Ranges.
+  @param[in]      Mask           The mask used for the attribute of all ranges. The corresponding field in the attribute is ignored
+                                 if that in Mask is 0.
   @param[out]     IsModified     TRUE means page table is modified by software or hardware. FALSE means page table is not modified by software.
                                  If the output IsModified is FALSE, there is possibility that the page table is changed by hardware. It is ok
                                  because page table can be changed by hardware anytime, and caller don't need to Flush TLB.
 
   @retval RETURN_UNSUPPORTED        PagingMode is not supported.
-  @retval RETURN_INVALID_PARAMETER  PageTable, BufferSize, Attribute or Mask is NULL.
+  @retval RETURN_INVALID_PARAMETER  PageTable, BufferSize or Mask is NULL, or Ranges is NULL while RangeCount is not 0.
+  @retval RETURN_INVALID_PARAMETER  The ranges are not sorted, overlap, or are not aligned on 4KB.
   @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 0 but some other attributes are provided.
-  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 1 but some other attributes are not provided.
-  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 0 but some other attributes are provided.
-  @retval RETURN_INVALID_PARAMETER  For present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 0 but some other attributes are provided.
+  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, the attribute has Present set but some other attributes are not provided.
+  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, the attribute has Present clear but some other attributes are provided.
+  @retval RETURN_INVALID_PARAMETER  For present range, Mask->Bits.Present is 1, the attribute has Present clear but some other attributes are provided.
   @retval RETURN_INVALID_PARAMETER  *BufferSize is not multiple of 4KB.
   @retval RETURN_BUFFER_TOO_SMALL   The buffer is too small for page table creation/updating.
                                     BufferSize is updated to indicate the expected buffer size.
-                                    Caller may still get RETURN_BUFFER_TOO_SMALL with the new BufferSize.
-  @retval RETURN_SUCCESS            PageTable is created/updated successfully or the input Length is 0.
+                                    The expected size is computed for every range against the page table before any range is applied,
+                                    so part of the buffer may remain unused on success.
+  @retval RETURN_SUCCESS            PageTable is created/updated successfully or all ranges have zero Length.
 **/
 RETURN_STATUS
 EFIAPI
-PageTableMap (
-  IN OUT UINTN               *PageTable  OPTIONAL,
-  IN     PAGING_MODE         PagingMode,
-  IN     VOID                *Buffer,
-  IN OUT UINTN               *BufferSize,
-  IN     UINT64              LinearAddress,
-  IN     UINT64              Length,
-  IN     IA32_MAP_ATTRIBUTE  *Attribute,
-  IN     IA32_MAP_ATTRIBUTE  *Mask,
-  OUT    BOOLEAN             *IsModified   OPTIONAL
+PageTableMapRanges (
+  IN OUT UINTN                 *PageTable  OPTIONAL,
+  IN     PAGING_MODE           PagingMode,
+  IN     VOID                  *Buffer,
+  IN OUT UINTN                 *BufferSize,
+  IN     CONST IA32_MAP_ENTRY  *Ranges,
+  IN     UINTN                 RangeCount,
+  IN     IA32_MAP_ATTRIBUTE    *Mask,
+  OUT    BOOLEAN               *IsModified   OPTIONAL
   )
 {
   RETURN_STATUS       Status;
   IA32_PAGING_ENTRY   TopPagingEntry;
   INTN                RequiredSize;
   UINT64              MaxLinearAddress;
+  UINT64              RangeEnd;
+  UINT64              Length;
   IA32_PAGE_LEVEL     MaxLevel;
   IA32_PAGE_LEVEL     MaxLeafLevel;
   IA32_MAP_ATTRIBUTE  ParentAttribute;
+  IA32_MAP_ATTRIBUTE  Attribute;
   BOOLEAN             LocalIsModified;
   UINTN               Index;
+  UINTN               RangeIndex;
+  UINTN               MergedCount;
   IA32_PAGING_ENTRY   *PagingEntry;
   UINT8               BufferInStack[SIZE_4KB - 1 + MAX_PAE_PDPTE_NUM * sizeof (IA32_PAGING_ENTRY)];
 
-  if (Length == 0) {
-    return RETURN_SUCCESS;
-  }
-
   if ((PagingMode == Paging32bit) || (PagingMode >= PagingModeMax)) {
     //
     // 32bit paging is never supported.
@@ -713,7 +760,7 @@ PageTableMap (
     return RETURN_UNSUPPORTED;
   }
 
-  if ((PageTable == NULL) || (BufferSize == NULL) || (Attribute == NULL) || (Mask == NULL)) {
+  if ((PageTable == NULL) || (BufferSize == NULL) || (Mask == NULL) || ((Ranges == NULL) && (RangeCount != 0))) {
     return RETURN_INVALID_PARAMETER;
   }
 
@@ -724,34 +771,49 @@ PageTableMap (
     return RETURN_INVALID_PARAMETER;
   }
 
-  if (((UINTN)LinearAddress % SIZE_4KB != 0) || ((UINTN)Length % SIZE_4KB != 0)) {
-    //
-    // LinearAddress and Length should be multiple of 4K.
-    //
-    return RETURN_INVALID_PARAMETER;
-  }
-
   if ((*BufferSize != 0) && (Buffer == NULL)) {
     return RETURN_INVALID_PARAMETER;
   }
 
-  //
-  // If to map [LinearAddress, LinearAddress + Length] as non-present,
-  // all attributes except Present should not be provided.
-  //
-  if ((Attribute->Bits.Present == 0) && (Mask->Bits.Present == 1) && (Mask->Uint64 > 1)) {
-    return RETURN_INVALID_PARAMETER;
-  }
-
   MaxLeafLevel     = (IA32_PAGE_LEVEL)(UINT8)PagingMode;
   MaxLevel         = (IA32_PAGE_LEVEL)(UINT8)(PagingMode >> 8);
   MaxLinearAddress = (PagingMode == PagingPae) ? LShiftU64 (1, 32) : LShiftU64 (1, 12 + MaxLevel * 9);
 
-  if ((LinearAddress > MaxLinearAddress) || (Length > MaxLinearAddress - LinearAddress)) {
+  RangeEnd = 0;
+  for (RangeIndex = 0; RangeIndex < RangeCount; RangeIndex++) {
+    if (Ranges[RangeIndex].Length == 0) {
+      continue;
+    }
+
+    if (((UINTN)Ranges[RangeIndex].LinearAddress % SIZE_4KB != 0) || ((UINTN)Ranges[RangeIndex].Length % SIZE_4KB != 0)) {
+      //
+      // LinearAddress and Length should be multiple of 4K.
+      //
+      return RETURN_INVALID_PARAMETER;
+    }
+
     //
-    // Maximum linear address is (1 << 32), (1 << 48) or (1 << 57)
+    // If to map the range as non-present, all attributes except Present should not be provided.
     //
-    return RETURN_INVALID_PARAMETER;
+    if ((Ranges[RangeIndex].Attribute.Bits.Present == 0) && (Mask->Bits.Present == 1) && (Mask->Uint64 > 1)) {
+      return RETURN_INVALID_PARAMETER;
+    }
+
+    if ((Ranges[RangeIndex].LinearAddress > MaxLinearAddress) || (Ranges[RangeIndex].Length > MaxLinearAddress - Ranges[RangeIndex].LinearAddress)) {
+      //
+      // Maximum linear address is (1 << 32), (1 << 48) or (1 << 57)
+      //
+      return RETURN_INVALID_PARAMETER;
+    }
+
+    if (Ranges[RangeIndex].LinearAddress < RangeEnd) {
+      //
+      // The ranges should be sorted and should not overlap.
+      //
+      return RETURN_INVALID_PARAMETER;
+    }
+
+    RangeEnd = Ranges[RangeIndex].LinearAddress + Ranges[RangeIndex].Length;
   }
 
   TopPagingEntry.Uintn = *PageTable;
@@ -792,26 +854,38 @@ PageTableMap (
 
   //
   // Query the required buffer size without modifying the page table.
+  // The ranges don't overlap, so every range is checked against the same page table state it is
+  // applied to later. The sum of the sizes is an upper bound because page tables that a range
+  // creates and a following range shares are counted for both.
   //
   RequiredSize = 0;
-  Status       = PageTableLibMapInLevel (
-                   &TopPagingEntry,
-                   &ParentAttribute,
-                   FALSE,
-                   NULL,
-                   &RequiredSize,
-                   MaxLevel,
-                   MaxLeafLevel,
-                   LinearAddress,
-                   Length,
-                   0,
-                   Attribute,
-                   Mask,
-                   IsModified
-                   );
-  ASSERT (*IsModified == FALSE);
-  if (RETURN_ERROR (Status)) {
-    return Status;
+  for (RangeIndex = 0; RangeIndex < RangeCount; RangeIndex += MergedCount) {
+    if (Ranges[RangeIndex].Length == 0) {
+      MergedCount = 1;
+      continue;
+    }
+
+    MergedCount      = PageTableLibMergeRanges (&Ranges[RangeIndex], RangeCount - RangeIndex, &Length);
+    Attribute.Uint64 = Ranges[RangeIndex].Attribute.Uint64;
+    Status           = PageTableLibMapInLevel (
+                         &TopPagingEntry,
+                         &ParentAttribute,
+                         FALSE,
+                         NULL,
+                         &RequiredSize,
+                         MaxLevel,
+                         MaxLeafLevel,
+                         Ranges[RangeIndex].LinearAddress,
+                         Length,
+                         0,
+                         &Attribute,
+                         Mask,
+                         IsModified
+                         );
+    ASSERT (*IsModified == FALSE);
+    if (RETURN_ERROR (Status)) {
+      return Status;
+    }
   }
 
   RequiredSize = -RequiredSize;
@@ -828,23 +902,36 @@ PageTableMap (
   //
   // Update the page table when the supplied buffer is sufficient.
   //
-  Status = PageTableLibMapInLevel (
-             &TopPagingEntry,
-             &ParentAttribute,
-             TRUE,
-             Buffer,
-             (INTN *)BufferSize,
-             MaxLevel,
-             MaxLeafLevel,
-             LinearAddress,
-             Length,
-             0,
-             Attribute,
-             Mask,
-             IsModified
-             );
-
-  if (!RETURN_ERROR (Status)) {
+  Status = RETURN_SUCCESS;
+  for (RangeIndex = 0; RangeIndex < RangeCount; RangeIndex += MergedCount) {
+    if (Ranges[RangeIndex].Length == 0) {
+      MergedCount = 1;
+      continue;
+    }
+
+    MergedCount      = PageTableLibMergeRanges (&Ranges[RangeIndex], RangeCount - RangeIndex, &Length);
+    Attribute.Uint64 = Ranges[RangeIndex].Attribute.Uint64;
+    Status           = PageTableLibMapInLevel (
+                         &TopPagingEntry,
+                         &ParentAttribute,
+                         TRUE,
+                         Buffer,
+                         (INTN *)BufferSize,
+                         MaxLevel,
+                         MaxLeafLevel,
+                         Ranges[RangeIndex].LinearAddress,
+                         Length,
+                         0,
+                         &Attribute,
+                         Mask,
+                         IsModified
+                         );
+    if (RETURN_ERROR (Status)) {
+      break;
+    }
+  }
+
+  if (!RETURN_ERROR (Status) && (TopPagingEntry.Uintn != 0)) {
     PagingEntry = (IA32_PAGING_ENTRY *)(UINTN)(TopPagingEntry.Uintn & IA32_PE_BASE_ADDRESS_MASK_40);
 
     if (PagingMode == PagingPae) {
@@ -876,3 +963,75 @@ PageTableMap (
 
   return Status;
 }
+
+/**
+  Create or update page table to map [LinearAddress, LinearAddress + Length) with specified attribute.
+
+  @param[in, out] PageTable      The pointer to the page table to update, or pointer to NULL if a new page table is to be created.
+                                 If not pointer to NULL, the value it points to won't be changed in this function.
+  @param[in]      PagingMode     The paging mode.
+  @param[in]      Buffer         The free buffer to be used for page table creation/updating.
+  @param[in, out] BufferSize     The buffer size.
+                                 On return, the remaining buffer size.
+                                 The free buffer is used from the end so caller can supply the same Buffer pointer with an updated
+                                 BufferSize in the second call to this API.
+  @param[in]      LinearAddress  The start of the linear address range.
+  @param[in]      Length         The length of the linear address range.
+  @param[in]      Attribute      The attribute of the linear address range.
+                                 All non-reserved fields in IA32_MAP_ATTRIBUTE are supported to set in the page table.
+                                 Page table entries that map the linear address range are reset to 0 before set to the new attribute
+                                 when a new physical base address is set.
+  @param[in]      Mask           The mask used for attribute. The corresponding field in Attribute is ignored if that in Mask is 0.
+  @param[out]     IsModified     TRUE means page table is modified by software or hardware. FALSE means page table is not modified by software.
+                                 If the output IsModified is FALSE, there is possibility that the page table is changed by hardware. It is ok
+                                 because page table can be changed by hardware anytime, and caller don't need to Flush TLB.
+
+  @retval RETURN_UNSUPPORTED        PagingMode is not supported.
+  @retval RETURN_INVALID_PARAMETER  PageTable, BufferSize, Attribute or Mask is NULL.
+  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 0 but some other attributes are provided.
+  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 1 but some other attributes are not provided.
+  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 0 but some other attributes are provided.
+  @retval RETURN_INVALID_PARAMETER  For present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 0 but some other attributes are provided.
+  @retval RETURN_INVALID_PARAMETER  *BufferSize is not multiple of 4KB.
+  @retval RETURN_BUFFER_TOO_SMALL   The buffer is too small for page table creation/updating.
+                                    BufferSize is updated to indicate the expected buffer size.
+                                    Caller may still get RETURN_BUFFER_TOO_SMALL with the new BufferSize.
+  @retval RETURN_SUCCESS            PageTable is created/updated successfully or the input Length is 0.
+**/
+RETURN_STATUS
+EFIAPI
+PageTableMap (
+  IN OUT UINTN               *PageTable  OPTIONAL,
+  IN     PAGING_MODE         PagingMode,
+  IN     VOID                *Buffer,
+  IN OUT UINTN               *BufferSize,
+  IN     UINT64              LinearAddress,
+  IN     UINT64              Length,
+  IN     IA32_MAP_ATTRIBUTE  *Attribute,
+  IN     IA32_MAP_ATTRIBUTE  *Mask,
+  OUT    BOOLEAN             *IsModified   OPTIONAL
+  )
+{
+  IA32_MAP_ENTRY  Range;
+
+  if (Length == 0) {
+    return RETURN_SUCCESS;
+  }
+
+  if ((PagingMode == Paging32bit) || (PagingMode >= PagingModeMax)) {
+    //
+    // 32bit paging is never supported.
+    //
+    return RETURN_UNSUPPORTED;
+  }
+
+  if (Attribute == NULL) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  Range.LinearAddress    = LinearAddress;
+  Range.Length           = Length;
+  Range.Attribute.Uint64 = Attribute->Uint64;
+
+  return PageTableMapRanges (PageTable, PagingMode, Buffer, BufferSize, &Range, 1, Mask, IsModified);
+}
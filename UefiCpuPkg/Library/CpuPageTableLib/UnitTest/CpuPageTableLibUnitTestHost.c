@@ -821,6 +821,139 @@ TestCaseToCheckMapMaskAndAttr (
   return UNIT_TEST_PASSED;
 }
 
+/**
+  Check that PageTableMapRanges() merges neighbouring ranges, rejects unsorted ranges,
+  and that PageTableCompact() replaces a uniform 4K page table with a 2M page.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestCaseMapRangesAndCompact (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN               PageTable;
+  PAGING_MODE         PagingMode;
+  VOID                *Buffer;
+  UINTN               PageTableBufferSize;
+  IA32_MAP_ATTRIBUTE  MapAttribute;
+  IA32_MAP_ATTRIBUTE  MapMask;
+  IA32_MAP_ENTRY      Ranges[1024];
+  IA32_MAP_ENTRY      Map[2];
+  UINTN               MapCount;
+  UINTN               Index;
+  UINT64              Length;
+  RETURN_STATUS       Status;
+  BOOLEAN             IsModified;
+  VOID                *FreePageList;
+  IA32_PAGING_ENTRY   *PagingEntry;
+
+  PagingMode          = Paging4Level;
+  PageTable           = 0;
+  PageTableBufferSize = 0;
+  MapMask.Uint64      = MAX_UINT64;
+
+  //
+  // Map [0, 4M] as 1024 ranges of 4K. All of them continue each other, so they are merged into one range.
+  //
+  for (Index = 0; Index < ARRAY_SIZE (Ranges); Index++) {
+    Ranges[Index].LinearAddress            = Index * SIZE_4KB;
+    Ranges[Index].Length                   = SIZE_4KB;
+    Ranges[Index].Attribute.Uint64         = Index * SIZE_4KB;
+    Ranges[Index].Attribute.Bits.Present   = 1;
+    Ranges[Index].Attribute.Bits.ReadWrite = 1;
+  }
+
+  UT_ASSERT_EQUAL (PageTableLibMergeRanges (Ranges, ARRAY_SIZE (Ranges), &Length), ARRAY_SIZE (Ranges));
+  UT_ASSERT_EQUAL (Length, SIZE_4MB);
+
+  //
+  // Overlapping ranges are rejected.
+  //
+  Ranges[1].LinearAddress = 0;
+  Status                  = PageTableMapRanges (&PageTable, PagingMode, NULL, &PageTableBufferSize, Ranges, ARRAY_SIZE (Ranges), &MapMask, NULL);
+  UT_ASSERT_EQUAL (Status, RETURN_INVALID_PARAMETER);
+  Ranges[1].LinearAddress = SIZE_4KB;
+
+  Status = PageTableMapRanges (&PageTable, PagingMode, NULL, &PageTableBufferSize, Ranges, ARRAY_SIZE (Ranges), &MapMask, NULL);
+  UT_ASSERT_EQUAL (Status, RETURN_BUFFER_TOO_SMALL);
+  Buffer = AllocatePages (EFI_SIZE_TO_PAGES (PageTableBufferSize));
+  Status = PageTableMapRanges (&PageTable, PagingMode, Buffer, &PageTableBufferSize, Ranges, ARRAY_SIZE (Ranges), &MapMask, NULL);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+
+  //
+  // PML4, PDPT and PD are needed, and [0, 4M] is mapped by two 2M pages.
+  //
+  UT_ASSERT_EQUAL (PageTableBufferSize, 0);
+  MapCount = ARRAY_SIZE (Map);
+  Status   = PageTableParse (PageTable, PagingMode, Map, &MapCount);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (MapCount, 1);
+  UT_ASSERT_EQUAL (Map[0].Length, SIZE_4MB);
+
+  //
+  // Nothing to compact yet.
+  //
+  FreePageList = NULL;
+  Status       = PageTableCompact (PageTable, PagingMode, &FreePageList, &IsModified);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (IsModified, FALSE);
+  UT_ASSERT_EQUAL (FreePageList, NULL);
+
+  //
+  // Set [4K, 8K] to read-only and back. It splits the first 2M page into a page table of 4K pages
+  // that all have the same attribute again.
+  //
+  MapAttribute.Uint64         = SIZE_4KB;
+  MapAttribute.Bits.Present   = 1;
+  MapAttribute.Bits.ReadWrite = 0;
+  PageTableBufferSize         = 0;
+  Status                      = PageTableMap (&PageTable, PagingMode, NULL, &PageTableBufferSize, SIZE_4KB, SIZE_4KB, &MapAttribute, &MapMask, NULL);
+  UT_ASSERT_EQUAL (Status, RETURN_BUFFER_TOO_SMALL);
+  Buffer = AllocatePages (EFI_SIZE_TO_PAGES (PageTableBufferSize));
+  Status = PageTableMap (&PageTable, PagingMode, Buffer, &PageTableBufferSize, SIZE_4KB, SIZE_4KB, &MapAttribute, &MapMask, NULL);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  MapAttribute.Bits.ReadWrite = 1;
+  Status                      = PageTableMap (&PageTable, PagingMode, NULL, &PageTableBufferSize, SIZE_4KB, SIZE_4KB, &MapAttribute, &MapMask, NULL);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+
+  PagingEntry = (IA32_PAGING_ENTRY *)PageTable;
+  PagingEntry = (IA32_PAGING_ENTRY *)(UINTN)IA32_PNLE_PAGE_TABLE_BASE_ADDRESS (&PagingEntry[0].Pnle);
+  PagingEntry = (IA32_PAGING_ENTRY *)(UINTN)IA32_PNLE_PAGE_TABLE_BASE_ADDRESS (&PagingEntry[0].Pnle);
+  UT_ASSERT_EQUAL (IsPle (&PagingEntry[0], 2), FALSE);
+
+  //
+  // The page table of 4K pages is replaced by a 2M page and returned in FreePageList.
+  //
+  Status = PageTableCompact (PageTable, PagingMode, &FreePageList, &IsModified);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (IsModified, TRUE);
+  UT_ASSERT_EQUAL (FreePageList, Buffer);
+  UT_ASSERT_EQUAL (*(VOID **)FreePageList, NULL);
+  UT_ASSERT_EQUAL (IsPle (&PagingEntry[0], 2), TRUE);
+
+  MapCount = ARRAY_SIZE (Map);
+  Status   = PageTableParse (PageTable, PagingMode, Map, &MapCount);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (MapCount, 1);
+  UT_ASSERT_EQUAL (Map[0].LinearAddress, 0);
+  UT_ASSERT_EQUAL (Map[0].Length, SIZE_4MB);
+  UT_ASSERT_EQUAL (Map[0].Attribute.Uint64, Ranges[0].Attribute.Uint64);
+
+  return UNIT_TEST_PASSED;
+}
+
 /**
   Initialize the unit test framework, suite, and unit tests for the
   sample unit tests and run the unit tests.
@@ -871,6 +1004,7 @@ UefiTestMain (
   AddTestCase (ManualTestCase, "Check if the parent entry has different Nx attribute", "Manual Test Case6", TestCaseManualChangeNx, NULL, NULL, NULL);
   AddTestCase (ManualTestCase, "Check if the needed size is expected", "Manual Test Case7", TestCaseManualSizeNotMatch, NULL, NULL, NULL);
   AddTestCase (ManualTestCase, "Check MapMask when creating new page table or mapping not-present range", "Manual Test Case8", TestCaseToCheckMapMaskAndAttr, NULL, NULL, NULL);
+  AddTestCase (ManualTestCase, "Check batch map and page table compaction", "Manual Test Case9", TestCaseMapRangesAndCompact, NULL, NULL, NULL);
   //
   // Populate the Random Test Cases.
   //
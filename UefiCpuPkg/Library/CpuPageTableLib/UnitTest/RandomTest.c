@@ -18,6 +18,8 @@ IA32_MAP_ATTRIBUTE        mSupportedBit;
 extern UINTN              mNumberCount;
 extern UINT8              mNumbers[];
 UINTN                     mNumberIndex;
+UINTN                     mBatchRangeCount;
+UINTN                     mBatchWalkCount;
 UINT64                    AlignedTable[] = {
   ~((UINT64)SIZE_4KB - 1),
   ~((UINT64)SIZE_2MB - 1),
@@ -904,6 +906,184 @@ RecordAllocatePages (
   return Buffer;
 }
 
+/**
+  Compare the parsed map of a page table with the expected map.
+
+  @param[in]  PageTable     The pointer to the page table.
+  @param[in]  PagingMode    The paging mode.
+  @param[in]  ExpectedMap   Pointer to an array that describes the expected linear address ranges.
+  @param[in]  ExpectedCount The number of entries in ExpectedMap.
+
+  @retval  UNIT_TEST_PASSED        The page table is valid and maps ExpectedMap.
+**/
+UNIT_TEST_STATUS
+ComparePageTableWithMap (
+  IN     UINTN           PageTable,
+  IN     PAGING_MODE     PagingMode,
+  IN     IA32_MAP_ENTRY  *ExpectedMap,
+  IN     UINTN           ExpectedCount
+  )
+{
+  RETURN_STATUS     Status;
+  UNIT_TEST_STATUS  TestStatus;
+  IA32_MAP_ENTRY    *Map;
+  UINTN             MapCount;
+
+  TestStatus = IsPageTableValid (PageTable, PagingMode);
+  if (TestStatus != UNIT_TEST_PASSED) {
+    return TestStatus;
+  }
+
+  MapCount = 0;
+  Status   = PageTableParse (PageTable, PagingMode, NULL, &MapCount);
+  UT_ASSERT_EQUAL (MapCount, ExpectedCount);
+  if (MapCount != 0) {
+    UT_ASSERT_EQUAL (Status, RETURN_BUFFER_TOO_SMALL);
+    Map = AllocatePages (EFI_SIZE_TO_PAGES (MapCount * sizeof (IA32_MAP_ENTRY)));
+    ASSERT (Map != NULL);
+    Status = PageTableParse (PageTable, PagingMode, Map, &MapCount);
+    UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+    UT_ASSERT_MEM_EQUAL (Map, ExpectedMap, MapCount * sizeof (IA32_MAP_ENTRY));
+    FreePages (Map, EFI_SIZE_TO_PAGES (MapCount * sizeof (IA32_MAP_ENTRY)));
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Rebuild the page table with PageTableMapRanges() from its parsed map, then compact both
+  page tables with PageTableCompact(). The mapping should not change in either step.
+
+  The parsed map is split at random points before it's passed to PageTableMapRanges(), so
+  the number of page table walks is expected to drop back to the number of map entries.
+
+  @param[in]  PageTable      The pointer to the page table.
+  @param[in]  PagingMode     The paging mode.
+  @param[in]  PagesRecord    Used to record memory usage for page table.
+
+  @retval  UNIT_TEST_PASSED        The test is successful.
+**/
+UNIT_TEST_STATUS
+MapRangesAndCompactTest (
+  IN     UINTN                  PageTable,
+  IN     PAGING_MODE            PagingMode,
+  IN     ALLOCATE_PAGE_RECORDS  *PagesRecord
+  )
+{
+  RETURN_STATUS       Status;
+  UNIT_TEST_STATUS    TestStatus;
+  IA32_MAP_ENTRY      *Map;
+  UINTN               MapCount;
+  IA32_MAP_ENTRY      *Ranges;
+  UINTN               RangeCount;
+  UINTN               Index;
+  UINTN               WalkCount;
+  UINT64              Length;
+  UINT64              SplitLength;
+  IA32_MAP_ATTRIBUTE  Mask;
+  UINTN               NewPageTable;
+  UINTN               PageTableBufferSize;
+  VOID                *Buffer;
+  BOOLEAN             IsModified;
+  VOID                *FreePageList;
+  UINTN               FreePageCount;
+
+  MapCount = 0;
+  Status   = PageTableParse (PageTable, PagingMode, NULL, &MapCount);
+  if (MapCount == 0) {
+    return UNIT_TEST_PASSED;
+  }
+
+  UT_ASSERT_EQUAL (Status, RETURN_BUFFER_TOO_SMALL);
+  Map = AllocatePages (EFI_SIZE_TO_PAGES (MapCount * sizeof (IA32_MAP_ENTRY)));
+  ASSERT (Map != NULL);
+  Status = PageTableParse (PageTable, PagingMode, Map, &MapCount);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+
+  //
+  // Split some of the map entries in two.
+  //
+  Ranges = AllocatePages (EFI_SIZE_TO_PAGES (2 * MapCount * sizeof (IA32_MAP_ENTRY)));
+  ASSERT (Ranges != NULL);
+  RangeCount = 0;
+  for (Index = 0; Index < MapCount; Index++) {
+    SplitLength = Map[Index].Length;
+    if ((Map[Index].Length > SIZE_4KB) && RandomBoolean (50)) {
+      SplitLength = Random64 (1, Map[Index].Length / SIZE_4KB - 1) * SIZE_4KB;
+    }
+
+    CopyMem (&Ranges[RangeCount], &Map[Index], sizeof (IA32_MAP_ENTRY));
+    Ranges[RangeCount].Length = SplitLength;
+    RangeCount++;
+
+    if (SplitLength < Map[Index].Length) {
+      Ranges[RangeCount].LinearAddress    = Map[Index].LinearAddress + SplitLength;
+      Ranges[RangeCount].Length           = Map[Index].Length - SplitLength;
+      Ranges[RangeCount].Attribute.Uint64 = Map[Index].Attribute.Uint64 + SplitLength;
+      RangeCount++;
+    }
+  }
+
+  //
+  // Count the page table walks taken by PageTableMapRanges().
+  //
+  WalkCount = 0;
+  for (Index = 0; Index < RangeCount; Index += PageTableLibMergeRanges (&Ranges[Index], RangeCount - Index, &Length)) {
+    WalkCount++;
+  }
+
+  UT_ASSERT_EQUAL (WalkCount, MapCount);
+  mBatchRangeCount += RangeCount;
+  mBatchWalkCount  += WalkCount;
+
+  Mask.Uint64         = MAX_UINT64;
+  NewPageTable        = 0;
+  PageTableBufferSize = 0;
+  Status              = PageTableMapRanges (&NewPageTable, PagingMode, NULL, &PageTableBufferSize, Ranges, RangeCount, &Mask, NULL);
+  UT_ASSERT_EQUAL (Status, RETURN_BUFFER_TOO_SMALL);
+  Buffer = PagesRecord->AllocatePagesForPageTable (PagesRecord, EFI_SIZE_TO_PAGES (PageTableBufferSize));
+  UT_ASSERT_NOT_EQUAL (Buffer, NULL);
+  Status = PageTableMapRanges (&NewPageTable, PagingMode, Buffer, &PageTableBufferSize, Ranges, RangeCount, &Mask, &IsModified);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (IsModified, TRUE);
+
+  TestStatus = ComparePageTableWithMap (NewPageTable, PagingMode, Map, MapCount);
+  if (TestStatus != UNIT_TEST_PASSED) {
+    return TestStatus;
+  }
+
+  //
+  // Compact the new page table and collect the page tables that are no longer used.
+  //
+  FreePageList = NULL;
+  Status       = PageTableCompact (NewPageTable, PagingMode, &FreePageList, &IsModified);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  for (FreePageCount = 0; FreePageList != NULL; FreePageCount++) {
+    FreePageList = *(VOID **)FreePageList;
+  }
+
+  UT_ASSERT_EQUAL (IsModified, FreePageCount != 0);
+  TestStatus = ComparePageTableWithMap (NewPageTable, PagingMode, Map, MapCount);
+  if (TestStatus != UNIT_TEST_PASSED) {
+    return TestStatus;
+  }
+
+  //
+  // Compact the original page table, which may have restrictive attributes in non-leaf entries.
+  //
+  Status = PageTableCompact (PageTable, PagingMode, NULL, &IsModified);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  TestStatus = ComparePageTableWithMap (PageTable, PagingMode, Map, MapCount);
+  if (TestStatus != UNIT_TEST_PASSED) {
+    return TestStatus;
+  }
+
+  FreePages (Ranges, EFI_SIZE_TO_PAGES (2 * MapCount * sizeof (IA32_MAP_ENTRY)));
+  FreePages (Map, EFI_SIZE_TO_PAGES (MapCount * sizeof (IA32_MAP_ENTRY)));
+
+  return UNIT_TEST_PASSED;
+}
+
 /**
   The function is a whole Random test, it will call SingleMapEntryTest for ExpctedEntryNumber times
 
@@ -1003,6 +1183,11 @@ MultipleMapEntryTest (
     }
   }
 
+  TestStatus = MapRangesAndCompactTest (PageTable, PagingMode, PagesRecord);
+  if (TestStatus != UNIT_TEST_PASSED) {
+    return TestStatus;
+  }
+
   FreePages (
     MapEntrys,
     EFI_SIZE_TO_PAGES (1000*sizeof (MAP_ENTRY) + sizeof (MAP_ENTRYS))
@@ -1063,8 +1248,10 @@ TestCaseforRandomTest (
 
   mSupportedBit.Bits.Nx = 1;
 
-  mRandomOption = ((CPU_PAGE_TABLE_LIB_RANDOM_TEST_CONTEXT *)Context)->RandomOption;
-  mNumberIndex  = 0;
+  mRandomOption    = ((CPU_PAGE_TABLE_LIB_RANDOM_TEST_CONTEXT *)Context)->RandomOption;
+  mNumberIndex     = 0;
+  mBatchRangeCount = 0;
+  mBatchWalkCount  = 0;
 
   for (Index = 0; Index < ((CPU_PAGE_TABLE_LIB_RANDOM_TEST_CONTEXT *)Context)->TestCount; Index++) {
     Status = MultipleMapEntryTest (
@@ -1079,6 +1266,7 @@ TestCaseforRandomTest (
   }
 
   DEBUG ((DEBUG_INFO, "\n"));
+  DEBUG ((DEBUG_INFO, "PageTableMapRanges: %d ranges applied with %d page table walks\n", mBatchRangeCount, mBatchWalkCount));
 
   return UNIT_TEST_PASSED;
 }
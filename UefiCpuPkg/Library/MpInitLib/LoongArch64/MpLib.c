@@ -1301,6 +1301,106 @@ MpInitLibStartupAllCPUs (
            );
 }
 
+/**
+  Run tasks from a work queue on the calling CPU until the queue is empty.
+
+  @param[in,out] Buffer  The MP_WORK_QUEUE to run tasks from.
+**/
+VOID
+EFIAPI
+WorkQueueProcedure (
+  IN OUT VOID  *Buffer
+  )
+{
+  UINTN  ProcessorNumber;
+
+  MpInitLibWhoAmI (&ProcessorNumber);
+  MpWorkQueueRun ((MP_WORK_QUEUE *)Buffer, ProcessorNumber);
+}
+
+/**
+  This service runs an array of caller provided tasks on all enabled CPUs.
+
+  All enabled CPUs including the BSP take tasks from a shared queue until
+  every task has been taken, so each task runs exactly once on one of the
+  CPUs. This function blocks until all tasks have finished or the timeout
+  expired.
+
+  @param[in]  Tasks                   The tasks to run. See type EDKII_MP_TASK.
+  @param[in]  TaskCount               The number of entries in Tasks.
+  @param[in]  TimeoutInMicroseconds   Indicates the time limit in microseconds for
+                                      APs to finish their tasks. Zero means
+                                      infinity. TimeoutInMicroseconds is ignored
+                                      for BSP.
+  @param[out] FailedCpuList           If not NULL and the timeout expired, the
+                                      list of APs that did not finish, terminated
+                                      by END_OF_CPU_LIST. The buffer is allocated
+                                      by the service and must be freed by the
+                                      caller.
+
+  @retval EFI_SUCCESS             All tasks have finished before the timeout expired.
+  @retval EFI_DEVICE_ERROR        Caller processor is AP.
+  @retval EFI_NOT_READY           Any enabled APs are busy.
+  @retval EFI_NOT_READY           MP Initialize Library is not initialized.
+  @retval EFI_TIMEOUT             The timeout expired before all enabled APs have
+                                  finished.
+  @retval EFI_INVALID_PARAMETER   Tasks is NULL, TaskCount is zero or too large,
+                                  or a task has no Procedure.
+
+**/
+EFI_STATUS
+EFIAPI
+MpInitLibStartupAllCPUsWorkQueue (
+  IN  CONST EDKII_MP_TASK  *Tasks,
+  IN  UINTN                TaskCount,
+  IN  UINTN                TimeoutInMicroseconds,
+  OUT UINTN                **FailedCpuList         OPTIONAL
+  )
+{
+  EFI_STATUS     Status;
+  CPU_MP_DATA    *CpuMpData;
+  MP_WORK_QUEUE  WorkQueue;
+  UINT64         *Bitmaps;
+  UINTN          Index;
+
+  if (FailedCpuList != NULL) {
+    *FailedCpuList = NULL;
+  }
+
+  if ((Tasks == NULL) || (TaskCount == 0) || (TaskCount > MP_WORK_QUEUE_MAX_TASK_COUNT)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  for (Index = 0; Index < TaskCount; Index++) {
+    if (Tasks[Index].Procedure == NULL) {
+      return EFI_INVALID_PARAMETER;
+    }
+  }
+
+  CpuMpData = GetCpuMpData ();
+  Bitmaps   = AllocatePool (2 * MP_WORK_QUEUE_BITMAP_WORDS (CpuMpData->CpuCount) * sizeof (UINT64));
+  if (Bitmaps == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Completion is collected from the AP states by StartupAllCPUsWorker().
+  //
+  MpWorkQueueInitialize (&WorkQueue, Tasks, TaskCount, CpuMpData->CpuCount, Bitmaps);
+  Status = StartupAllCPUsWorker (
+             WorkQueueProcedure,
+             FALSE,
+             FALSE,
+             NULL,
+             TimeoutInMicroseconds,
+             &WorkQueue,
+             FailedCpuList
+             );
+
+  FreePool (Bitmaps);
+  return Status;
+}
+
 /**
   MP Initialize Library initialization.
 
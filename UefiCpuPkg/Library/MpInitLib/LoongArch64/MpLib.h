@@ -24,6 +24,8 @@
 #include <Library/TimerLib.h>
 #include <Library/HobLib.h>
 
+#include "../MpWorkQueue.h"
+
 #define WAKEUP_AP_SIGNAL  SIGNATURE_32 ('S', 'T', 'A', 'P')
 
 #define CPU_INIT_MP_LIB_HOB_GUID \
@@ -40,6 +40,7 @@
 
 #include <Guid/MicrocodePatchHob.h>
 #include "MpHandOff.h"
+#include "MpWorkQueue.h"
 
 #define WAKEUP_AP_SIGNAL  SIGNATURE_32 ('S', 'T', 'A', 'P')
 //
@@ -271,6 +272,7 @@ struct _CPU_MP_DATA {
   UINT64                           TotalTime;
   EFI_EVENT                        WaitEvent;
   UINTN                            **FailedCpuList;
+  MP_WORK_QUEUE                    *WorkQueue;
   BOOLEAN                          EnableExecuteDisableForSwitchContext;
 
   AP_INIT_STATE                    InitFlag;
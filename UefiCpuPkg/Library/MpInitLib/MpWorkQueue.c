@@ -0,0 +1,184 @@
+/** @file
+  Work queue used by MpInitLibStartupAllCPUsWorkQueue().
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <PiPei.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/SynchronizationLib.h>
+
+#include "MpWorkQueue.h"
+
+/**
+  Initialize a work queue.
+
+  @param[out] Queue      The queue to initialize.
+  @param[in]  Tasks      The tasks to hand out.
+  @param[in]  TaskCount  The number of entries in Tasks, at most
+                         MP_WORK_QUEUE_MAX_TASK_COUNT.
+  @param[in]  CpuCount   The number of CPUs in the system.
+  @param[in]  Bitmaps    Buffer of 2 * MP_WORK_QUEUE_BITMAP_WORDS (CpuCount)
+                         UINT64 words used for the expected and done bitmaps.
+**/
+VOID
+MpWorkQueueInitialize (
+  OUT MP_WORK_QUEUE        *Queue,
+  IN  CONST EDKII_MP_TASK  *Tasks,
+  IN  UINTN                TaskCount,
+  IN  UINTN                CpuCount,
+  IN  UINT64               *Bitmaps
+  )
+{
+  UINTN  Words;
+
+  ASSERT (Queue != NULL);
+  ASSERT (Tasks != NULL || TaskCount == 0);
+  ASSERT (TaskCount <= MP_WORK_QUEUE_MAX_TASK_COUNT);
+  ASSERT (CpuCount > 0);
+  ASSERT (Bitmaps != NULL);
+
+  Words = MP_WORK_QUEUE_BITMAP_WORDS (CpuCount);
+  ZeroMem (Bitmaps, 2 * Words * sizeof (UINT64));
+
+  Queue->Tasks        = Tasks;
+  Queue->TaskCount    = TaskCount;
+  Queue->NextTask     = 0;
+  Queue->CpuCount     = CpuCount;
+  Queue->ExpectedBits = Bitmaps;
+  Queue->DoneBits     = Bitmaps + Words;
+}
+
+/**
+  Mark a CPU as taking part in draining the queue.
+
+  Must be called before the CPU starts to run MpWorkQueueRun().
+
+  @param[in,out] Queue     The queue.
+  @param[in]     CpuIndex  The index of the CPU.
+**/
+VOID
+MpWorkQueueExpectCpu (
+  IN OUT MP_WORK_QUEUE  *Queue,
+  IN     UINTN          CpuIndex
+  )
+{
+  ASSERT (CpuIndex < Queue->CpuCount);
+
+  Queue->ExpectedBits[CpuIndex / 64] |= LShiftU64 (1, CpuIndex % 64);
+}
+
+/**
+  Take the next task from the queue.
+
+  @param[in,out] Queue      The queue.
+  @param[out]    TaskIndex  The index of the taken task.
+
+  @retval TRUE   A task was taken.
+  @retval FALSE  The queue is empty.
+**/
+BOOLEAN
+MpWorkQueueTakeTask (
+  IN OUT MP_WORK_QUEUE  *Queue,
+  OUT    UINTN          *TaskIndex
+  )
+{
+  UINT32  Next;
+
+  //
+  // Do not touch the counter once it has run past the end, so that it stays
+  // within TaskCount plus one failed claim per CPU.
+  //
+  if (Queue->NextTask >= Queue->TaskCount) {
+    return FALSE;
+  }
+
+  Next = InterlockedIncrement (&Queue->NextTask);
+  if (Next > Queue->TaskCount) {
+    return FALSE;
+  }
+
+  *TaskIndex = Next - 1;
+  return TRUE;
+}
+
+/**
+  Mark a CPU as done with the queue.
+
+  @param[in,out] Queue     The queue.
+  @param[in]     CpuIndex  The index of the CPU.
+**/
+VOID
+MpWorkQueueSetCpuDone (
+  IN OUT MP_WORK_QUEUE  *Queue,
+  IN     UINTN          CpuIndex
+  )
+{
+  volatile UINT64  *Word;
+  UINT64           Value;
+  UINT64           Bit;
+
+  ASSERT (CpuIndex < Queue->CpuCount);
+
+  Word = &Queue->DoneBits[CpuIndex / 64];
+  Bit  = LShiftU64 (1, CpuIndex % 64);
+  do {
+    Value = *Word;
+  } while (InterlockedCompareExchange64 ((UINT64 *)Word, Value, Value | Bit) != Value);
+}
+
+/**
+  Run tasks from the queue on the calling CPU until the queue is empty, then
+  mark the CPU as done.
+
+  @param[in,out] Queue     The queue.
+  @param[in]     CpuIndex  The index of the calling CPU.
+
+  @return The number of tasks run by the calling CPU.
+**/
+UINTN
+MpWorkQueueRun (
+  IN OUT MP_WORK_QUEUE  *Queue,
+  IN     UINTN          CpuIndex
+  )
+{
+  UINTN  TaskIndex;
+  UINTN  Count;
+
+  Count = 0;
+  while (MpWorkQueueTakeTask (Queue, &TaskIndex)) {
+    Queue->Tasks[TaskIndex].Procedure (Queue->Tasks[TaskIndex].Argument);
+    Count++;
+  }
+
+  MpWorkQueueSetCpuDone (Queue, CpuIndex);
+  return Count;
+}
+
+/**
+  Check whether all expected CPUs are done with the queue.
+
+  @param[in] Queue  The queue.
+
+  @retval TRUE   All expected CPUs are done, so every task has finished.
+  @retval FALSE  Some expected CPUs are still running tasks.
+**/
+BOOLEAN
+MpWorkQueueIsDone (
+  IN CONST MP_WORK_QUEUE  *Queue
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < MP_WORK_QUEUE_BITMAP_WORDS (Queue->CpuCount); Index++) {
+    if ((Queue->DoneBits[Index] & Queue->ExpectedBits[Index]) != Queue->ExpectedBits[Index]) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
@@ -0,0 +1,139 @@
+/** @file
+  Work queue used by MpInitLibStartupAllCPUsWorkQueue().
+
+  The queue hands out task indices to all participating CPUs with a single
+  atomic increment, so no lock is taken. Every CPU sets its own bit in the done
+  bitmap once the queue is empty, and the BSP only has to compare the done
+  bitmap with the bitmap of expected CPUs to know that all tasks finished.
+
+  The queue does not depend on CPU_MP_DATA, so it can be tested on the host.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef MP_WORK_QUEUE_H_
+#define MP_WORK_QUEUE_H_
+
+#include <Protocol/MpWorkQueue.h>
+
+///
+/// Number of UINT64 words of one CPU bitmap for CpuCount CPUs.
+///
+#define MP_WORK_QUEUE_BITMAP_WORDS(CpuCount)  (((CpuCount) + 63) / 64)
+
+///
+/// Largest number of tasks of one queue. The task counter is allowed to run
+/// past TaskCount by at most one claim per CPU.
+///
+#define MP_WORK_QUEUE_MAX_TASK_COUNT  MAX_INT32
+
+typedef struct {
+  CONST EDKII_MP_TASK    *Tasks;
+  UINTN                  TaskCount;
+  ///
+  /// Index of the next task to hand out. May exceed TaskCount.
+  ///
+  volatile UINT32        NextTask;
+  UINTN                  CpuCount;
+  ///
+  /// CPUs that take part in draining the queue.
+  ///
+  UINT64                 *ExpectedBits;
+  ///
+  /// CPUs that found the queue empty after running their tasks.
+  ///
+  volatile UINT64        *DoneBits;
+} MP_WORK_QUEUE;
+
+/**
+  Initialize a work queue.
+
+  @param[out] Queue      The queue to initialize.
+  @param[in]  Tasks      The tasks to hand out.
+  @param[in]  TaskCount  The number of entries in Tasks, at most
+                         MP_WORK_QUEUE_MAX_TASK_COUNT.
+  @param[in]  CpuCount   The number of CPUs in the system.
+  @param[in]  Bitmaps    Buffer of 2 * MP_WORK_QUEUE_BITMAP_WORDS (CpuCount)
+                         UINT64 words used for the expected and done bitmaps.
+**/
+VOID
+MpWorkQueueInitialize (
+  OUT MP_WORK_QUEUE        *Queue,
+  IN  CONST EDKII_MP_TASK  *Tasks,
+  IN  UINTN                TaskCount,
+  IN  UINTN                CpuCount,
+  IN  UINT64               *Bitmaps
+  );
+
+/**
+  Mark a CPU as taking part in draining the queue.
+
+  Must be called before the CPU starts to run MpWorkQueueRun().
+
+  @param[in,out] Queue     The queue.
+  @param[in]     CpuIndex  The index of the CPU.
+**/
+VOID
+MpWorkQueueExpectCpu (
+  IN OUT MP_WORK_QUEUE  *Queue,
+  IN     UINTN          CpuIndex
+  );
+
+/**
+  Take the next task from the queue.
+
+  @param[in,out] Queue      The queue.
+  @param[out]    TaskIndex  The index of the taken task.
+
+  @retval TRUE   A task was taken.
+  @retval FALSE  The queue is empty.
+**/
+BOOLEAN
+MpWorkQueueTakeTask (
+  IN OUT MP_WORK_QUEUE  *Queue,
+  OUT    UINTN          *TaskIndex
+  );
+
+/**
+  Mark a CPU as done with the queue.
+
+  @param[in,out] Queue     The queue.
+  @param[in]     CpuIndex  The index of the CPU.
+**/
+VOID
+MpWorkQueueSetCpuDone (
+  IN OUT MP_WORK_QUEUE  *Queue,
+  IN     UINTN          CpuIndex
+  );
+
+/**
+  Run tasks from the queue on the calling CPU until the queue is empty, then
+  mark the CPU as done.
+
+  @param[in,out] Queue     The queue.
+  @param[in]     CpuIndex  The index of the calling CPU.
+
+  @return The number of tasks run by the calling CPU.
+**/
+UINTN
+MpWorkQueueRun (
+  IN OUT MP_WORK_QUEUE  *Queue,
+  IN     UINTN          CpuIndex
+  );
+
+/**
+  Check whether all expected CPUs are done with the queue.
+
+  @param[in] Queue  The queue.
+
+  @retval TRUE   All expected CPUs are done, so every task has finished.
+  @retval FALSE  Some expected CPUs are still running tasks.
+**/
+BOOLEAN
+MpWorkQueueIsDone (
+  IN CONST MP_WORK_QUEUE  *Queue
+  );
+
+#endif
@@ -0,0 +1,332 @@
+/** @file
+  Unit tests of the work queue used by MpInitLibStartupAllCPUsWorkQueue().
+
+  The CPUs draining the queue are simulated on one host thread by letting them
+  take turns, one task at a time.
+
+  Copyright (c) 2026, Acidanthera. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <PiPei.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UnitTestLib.h>
+
+#include "../MpWorkQueue.h"
+
+#define UNIT_TEST_NAME     "MpInitLib work queue unit tests"
+#define UNIT_TEST_VERSION  "1.0"
+
+#define TEST_CPU_COUNT   130
+#define TEST_TASK_COUNT  1000
+
+typedef struct {
+  EDKII_MP_TASK    *Tasks;
+  UINTN            *RunCount;
+  UINT64           *Bitmaps;
+  MP_WORK_QUEUE    Queue;
+} MP_WORK_QUEUE_TEST_CONTEXT;
+
+/**
+  Test task procedure. Counts how often the task was run.
+
+  @param[in,out] Buffer  Pointer to the run counter of the task.
+**/
+VOID
+EFIAPI
+TestTaskProcedure (
+  IN OUT VOID  *Buffer
+  )
+{
+  (*(UINTN *)Buffer)++;
+}
+
+/**
+  Allocate the tasks and the queue of a test case.
+
+  @param[in] Context  The test context.
+
+  @retval UNIT_TEST_PASSED                    The setup succeeded.
+  @retval UNIT_TEST_ERROR_PREREQUISITE_NOT_MET  Out of memory.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestSetup (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  MP_WORK_QUEUE_TEST_CONTEXT  *TestContext;
+  UINTN                       Index;
+
+  TestContext           = (MP_WORK_QUEUE_TEST_CONTEXT *)Context;
+  TestContext->Tasks    = AllocatePool (TEST_TASK_COUNT * sizeof (EDKII_MP_TASK));
+  TestContext->RunCount = AllocateZeroPool (TEST_TASK_COUNT * sizeof (UINTN));
+  TestContext->Bitmaps  = AllocatePool (2 * MP_WORK_QUEUE_BITMAP_WORDS (TEST_CPU_COUNT) * sizeof (UINT64));
+  if ((TestContext->Tasks == NULL) || (TestContext->RunCount == NULL) || (TestContext->Bitmaps == NULL)) {
+    return UNIT_TEST_ERROR_PREREQUISITE_NOT_MET;
+  }
+
+  for (Index = 0; Index < TEST_TASK_COUNT; Index++) {
+    TestContext->Tasks[Index].Procedure = TestTaskProcedure;
+    TestContext->Tasks[Index].Argument  = &TestContext->RunCount[Index];
+  }
+
+  MpWorkQueueInitialize (
+    &TestContext->Queue,
+    TestContext->Tasks,
+    TEST_TASK_COUNT,
+    TEST_CPU_COUNT,
+    TestContext->Bitmaps
+    );
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Free the tasks and the queue of a test case.
+
+  @param[in] Context  The test context.
+**/
+STATIC
+VOID
+EFIAPI
+TestCleanup (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  MP_WORK_QUEUE_TEST_CONTEXT  *TestContext;
+
+  TestContext = (MP_WORK_QUEUE_TEST_CONTEXT *)Context;
+  if (TestContext->Tasks != NULL) {
+    FreePool (TestContext->Tasks);
+  }
+
+  if (TestContext->RunCount != NULL) {
+    FreePool (TestContext->RunCount);
+  }
+
+  if (TestContext->Bitmaps != NULL) {
+    FreePool (TestContext->Bitmaps);
+  }
+
+  ZeroMem (TestContext, sizeof (*TestContext));
+}
+
+/**
+  Let the CPUs take turns running one task each until the queue is empty, then
+  check that every task ran exactly once and that the queue reports completion
+  only once every expected CPU is done.
+
+  @param[in] Context  The test context.
+
+  @retval UNIT_TEST_PASSED             The test passed.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestEveryTaskRunsOnce (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  MP_WORK_QUEUE_TEST_CONTEXT  *TestContext;
+  MP_WORK_QUEUE               *Queue;
+  UINTN                       CpuIndex;
+  UINTN                       TaskIndex;
+  UINTN                       Taken;
+
+  TestContext = (MP_WORK_QUEUE_TEST_CONTEXT *)Context;
+  Queue       = &TestContext->Queue;
+
+  for (CpuIndex = 0; CpuIndex < TEST_CPU_COUNT; CpuIndex++) {
+    MpWorkQueueExpectCpu (Queue, CpuIndex);
+  }
+
+  Taken    = 0;
+  CpuIndex = 0;
+  while (MpWorkQueueTakeTask (Queue, &TaskIndex)) {
+    UT_ASSERT_TRUE (TaskIndex < TEST_TASK_COUNT);
+    Queue->Tasks[TaskIndex].Procedure (Queue->Tasks[TaskIndex].Argument);
+    Taken++;
+    UT_ASSERT_FALSE (MpWorkQueueIsDone (Queue));
+    CpuIndex = (CpuIndex + 1) % TEST_CPU_COUNT;
+  }
+
+  UT_ASSERT_EQUAL (Taken, TEST_TASK_COUNT);
+  for (TaskIndex = 0; TaskIndex < TEST_TASK_COUNT; TaskIndex++) {
+    UT_ASSERT_EQUAL (TestContext->RunCount[TaskIndex], 1);
+  }
+
+  //
+  // All tasks have run, but the queue is only done once every CPU has noticed
+  // that the queue is empty.
+  //
+  for (CpuIndex = TEST_CPU_COUNT; CpuIndex > 0; CpuIndex--) {
+    UT_ASSERT_FALSE (MpWorkQueueIsDone (Queue));
+    UT_ASSERT_EQUAL (MpWorkQueueRun (Queue, CpuIndex - 1), 0);
+  }
+
+  UT_ASSERT_TRUE (MpWorkQueueIsDone (Queue));
+
+  //
+  // The task counter moves past TaskCount by at most one failed claim.
+  //
+  UT_ASSERT_TRUE (Queue->NextTask <= TEST_TASK_COUNT + 1);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Check that CPUs which are not expected do not block completion, and that
+  their done bits do not stand in for the bits of expected CPUs.
+
+  @param[in] Context  The test context.
+
+  @retval UNIT_TEST_PASSED             The test passed.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestUnexpectedCpusIgnored (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  MP_WORK_QUEUE_TEST_CONTEXT  *TestContext;
+  MP_WORK_QUEUE               *Queue;
+  UINTN                       TaskIndex;
+
+  TestContext = (MP_WORK_QUEUE_TEST_CONTEXT *)Context;
+  Queue       = &TestContext->Queue;
+
+  //
+  // Only CPUs in the first and the last bitmap word take part.
+  //
+  MpWorkQueueExpectCpu (Queue, 0);
+  MpWorkQueueExpectCpu (Queue, TEST_CPU_COUNT - 1);
+
+  UT_ASSERT_EQUAL (MpWorkQueueRun (Queue, 0), TEST_TASK_COUNT);
+  UT_ASSERT_FALSE (MpWorkQueueIsDone (Queue));
+
+  MpWorkQueueSetCpuDone (Queue, 64);
+  UT_ASSERT_FALSE (MpWorkQueueIsDone (Queue));
+
+  UT_ASSERT_EQUAL (MpWorkQueueRun (Queue, TEST_CPU_COUNT - 1), 0);
+  UT_ASSERT_TRUE (MpWorkQueueIsDone (Queue));
+
+  for (TaskIndex = 0; TaskIndex < TEST_TASK_COUNT; TaskIndex++) {
+    UT_ASSERT_EQUAL (TestContext->RunCount[TaskIndex], 1);
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Check that an empty queue does not advance the task counter any further.
+
+  @param[in] Context  The test context.
+
+  @retval UNIT_TEST_PASSED             The test passed.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestEmptyQueueStaysBounded (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  MP_WORK_QUEUE_TEST_CONTEXT  *TestContext;
+  MP_WORK_QUEUE               *Queue;
+  UINTN                       TaskIndex;
+  UINTN                       Index;
+
+  TestContext = (MP_WORK_QUEUE_TEST_CONTEXT *)Context;
+  Queue       = &TestContext->Queue;
+
+  for (Index = 0; Index < TEST_TASK_COUNT; Index++) {
+    UT_ASSERT_TRUE (MpWorkQueueTakeTask (Queue, &TaskIndex));
+    UT_ASSERT_EQUAL (TaskIndex, Index);
+  }
+
+  for (Index = 0; Index < TEST_CPU_COUNT; Index++) {
+    UT_ASSERT_FALSE (MpWorkQueueTakeTask (Queue, &TaskIndex));
+  }
+
+  UT_ASSERT_EQUAL (Queue->NextTask, TEST_TASK_COUNT);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the work queue
+  and run the unit tests.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      WorkQueueTests;
+  MP_WORK_QUEUE_TEST_CONTEXT  TestContext;
+
+  Framework = NULL;
+  ZeroMem (&TestContext, sizeof (TestContext));
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_NAME, UNIT_TEST_VERSION));
+
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_NAME, gEfiCallerBaseName, UNIT_TEST_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&WorkQueueTests, Framework, "MP Work Queue Tests", "MpWorkQueue", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for MP Work Queue Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  AddTestCase (WorkQueueTests, "Every task runs exactly once", "RunsOnce", TestEveryTaskRunsOnce, TestSetup, TestCleanup, &TestContext);
+  AddTestCase (WorkQueueTests, "CPUs that are not expected are ignored", "UnexpectedCpus", TestUnexpectedCpusIgnored, TestSetup, TestCleanup, &TestContext);
+  AddTestCase (WorkQueueTests, "An empty queue stays bounded", "EmptyQueue", TestEmptyQueueStaysBounded, TestSetup, TestCleanup, &TestContext);
+
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework != NULL) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+
+  @param Argc  Number of arguments.
+  @param Argv  Array of arguments.
+
+  @return Test application exit code.
+**/
+INT32
+main (
+  INT32  Argc,
+  CHAR8  *Argv[]
+  )
+{
+  return UnitTestingEntry ();
+}
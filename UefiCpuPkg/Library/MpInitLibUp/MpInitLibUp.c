@@ -9,6 +9,7 @@
 #include <PiDxe.h>
 #include <Ppi/SecPlatformInformation.h>
 #include <Protocol/MpService.h>
+#include <Protocol/MpWorkQueue.h>
 #include <Library/DebugLib.h>
 #include <Library/LocalApicLib.h>
 #include <Library/HobLib.h>
@@ -448,3 +449,51 @@ MpInitLibStartupAllCPUs (
 
   return EFI_SUCCESS;
 }
+
+/**
+  This service runs an array of caller provided tasks on all enabled CPUs.
+
+  @param[in]  Tasks                   The tasks to run. See type EDKII_MP_TASK.
+  @param[in]  TaskCount               The number of entries in Tasks.
+  @param[in]  TimeoutInMicroseconds   Indicates the time limit in microseconds for
+                                      APs to finish their tasks. Zero means
+                                      infinity. TimeoutInMicroseconds is ignored
+                                      for BSP.
+  @param[out] FailedCpuList           Always set to NULL if not NULL.
+
+  @retval EFI_SUCCESS             CPU have finished all tasks.
+  @retval EFI_INVALID_PARAMETER   Tasks is NULL, TaskCount is zero, or a task
+                                  has no Procedure.
+
+**/
+EFI_STATUS
+EFIAPI
+MpInitLibStartupAllCPUsWorkQueue (
+  IN  CONST EDKII_MP_TASK  *Tasks,
+  IN  UINTN                TaskCount,
+  IN  UINTN                TimeoutInMicroseconds,
+  OUT UINTN                **FailedCpuList         OPTIONAL
+  )
+{
+  UINTN  Index;
+
+  if (FailedCpuList != NULL) {
+    *FailedCpuList = NULL;
+  }
+
+  if ((Tasks == NULL) || (TaskCount == 0)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  for (Index = 0; Index < TaskCount; Index++) {
+    if (Tasks[Index].Procedure == NULL) {
+      return EFI_INVALID_PARAMETER;
+    }
+  }
+
+  for (Index = 0; Index < TaskCount; Index++) {
+    Tasks[Index].Procedure (Tasks[Index].Argument);
+  }
+
+  return EFI_SUCCESS;
+}
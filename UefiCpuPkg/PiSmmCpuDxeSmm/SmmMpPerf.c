@@ -58,7 +58,13 @@ MigrateMpPerf (
     }
 
     for (MpProcecureId = 0; MpProcecureId < SMM_MP_PERF_PROCEDURE_ID (SmmMpProcedureMax); MpProcecureId++) {
-      if (mSmmMpProcedurePerformance[CpuIndex].Begin[MpProcecureId] != 0) {
+      //
+      // Skip procedures that were begun but not ended, e.g. when an AP gave up
+      // waiting for the BSP.
+      //
+      if ((mSmmMpProcedurePerformance[CpuIndex].Begin[MpProcecureId] != 0) &&
+          (mSmmMpProcedurePerformance[CpuIndex].End[MpProcecureId] != 0))
+      {
         PERF_START (NULL, gSmmMpPerfProcedureName[MpProcecureId], NULL, mSmmMpProcedurePerformance[CpuIndex].Begin[MpProcecureId]);
         PERF_END (NULL, gSmmMpPerfProcedureName[MpProcecureId], NULL, mSmmMpProcedurePerformance[CpuIndex].End[MpProcecureId]);
       }